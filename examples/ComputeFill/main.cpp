@@ -0,0 +1,143 @@
+#include <Atema/Core/Error.hpp>
+#include <Atema/Renderer/Buffer.hpp>
+#include <Atema/Renderer/CommandBuffer.hpp>
+#include <Atema/Renderer/CommandPool.hpp>
+#include <Atema/Renderer/ComputePipeline.hpp>
+#include <Atema/Renderer/DescriptorSet.hpp>
+#include <Atema/Renderer/DescriptorSetLayout.hpp>
+#include <Atema/Renderer/Renderer.hpp>
+#include <Atema/Renderer/Shader.hpp>
+#include <Atema/VulkanRenderer/VulkanRenderer.hpp>
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace at;
+
+// Fills a storage buffer with a compute shader, then reads it back on the CPU
+// This is the minimal use of ComputePipeline & CommandBuffer::dispatch (no window is needed)
+namespace
+{
+	constexpr uint32_t WorkgroupSize = 64;
+	constexpr uint32_t WorkgroupCount = 256;
+	constexpr uint32_t ValueCount = WorkgroupSize * WorkgroupCount;
+	constexpr uint32_t Multiplier = 3;
+
+	// The workgroup size must match WorkgroupSize
+	const std::string ShaderCode = R"(
+struct FillData
+{
+	uint multiplier;
+	uint values[];
+}
+
+external
+{
+	[set(0), binding(0), layout(std430)] FillData fillData;
+}
+
+[entry(compute), workgroup(vec3u(64, 1, 1))]
+void main()
+{
+	uint index = getGlobalInvocationId().x;
+
+	fillData.values[index] = index * fillData.multiplier;
+}
+)";
+
+	// Resources must be destroyed before the renderer
+	bool run()
+	{
+		// Buffer : multiplier followed by the values
+		const auto buffer = Buffer::create({ BufferUsage::Storage | BufferUsage::Map, sizeof(uint32_t) * (1 + ValueCount) });
+
+		{
+			auto data = static_cast<uint32_t*>(buffer->map());
+
+			data[0] = Multiplier;
+			std::memset(data + 1, 0, sizeof(uint32_t) * ValueCount);
+
+			buffer->unmap();
+		}
+
+		// Pipeline
+		DescriptorSetLayout::Settings descriptorSetLayoutSettings;
+		descriptorSetLayoutSettings.bindings =
+		{
+			{ DescriptorType::StorageBuffer, 0, 1, ShaderStage::Compute }
+		};
+
+		const auto descriptorSetLayout = DescriptorSetLayout::create(descriptorSetLayoutSettings);
+
+		const auto descriptorSet = descriptorSetLayout->createSet();
+		descriptorSet->update(0, *buffer);
+
+		ComputePipeline::Settings pipelineSettings;
+		pipelineSettings.descriptorSetLayouts = { descriptorSetLayout };
+		pipelineSettings.computeShader = Shader::create({ ShaderLanguage::Atsl, ShaderCode.c_str(), ShaderCode.size() });
+
+		const auto pipeline = ComputePipeline::create(pipelineSettings);
+
+		// Dispatch, then make the shader writes visible to the host
+		auto commandBuffer = Renderer::instance().getCommandPool(QueueType::Graphics)->createBuffer({ true });
+
+		commandBuffer->begin();
+
+		commandBuffer->bindPipeline(*pipeline);
+		commandBuffer->bindDescriptorSet(0, *descriptorSet);
+		commandBuffer->dispatch(WorkgroupCount);
+
+		commandBuffer->memoryBarrier(PipelineStage::ComputeShader, MemoryAccess::ShaderWrite, PipelineStage::Host, MemoryAccess::HostRead);
+
+		commandBuffer->end();
+
+		Renderer::instance().submitAndWait({ commandBuffer });
+
+		// Readback
+		size_t errorCount = 0;
+
+		{
+			const auto data = static_cast<const uint32_t*>(buffer->map());
+			const auto values = data + 1;
+
+			for (uint32_t i = 0; i < ValueCount; i++)
+			{
+				if (values[i] != i * Multiplier)
+				{
+					if (errorCount == 0)
+						std::cout << "First mismatch at index " << i << " : expected " << i * Multiplier << ", got " << values[i] << std::endl;
+
+					errorCount++;
+				}
+			}
+
+			buffer->unmap();
+		}
+
+		std::cout << ValueCount - errorCount << "/" << ValueCount << " values are correct" << std::endl;
+
+		return errorCount == 0;
+	}
+}
+
+// MAIN
+int main(int argc, char** argv)
+{
+	bool success = false;
+
+	try
+	{
+		Renderer::create<VulkanRenderer>({});
+
+		success = run();
+	}
+	catch (const std::exception& exception)
+	{
+		std::cout << exception.what() << std::endl;
+	}
+
+	Renderer::destroy();
+
+	return success ? 0 : 1;
+}
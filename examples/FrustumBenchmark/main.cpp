@@ -0,0 +1,118 @@
+#include <Atema/Core/Timer.hpp>
+#include <Atema/Math/Frustum.hpp>
+
+#include <iostream>
+#include <random>
+
+using namespace at;
+
+// Compares the batch frustum tests (SIMD when available) with the per element ones
+namespace
+{
+	constexpr size_t ElementCount = 100000;
+	constexpr size_t IterationCount = 100;
+
+	void printResult(const std::string& label, TimeStep timeStep, size_t checksum)
+	{
+		std::cout << label << " : " << timeStep.getMilliSeconds() / static_cast<float>(IterationCount) << " ms (checksum " << checksum << ")" << std::endl;
+	}
+}
+
+// MAIN
+int main(int argc, char** argv)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> sizeDistribution(0.1f, 10.0f);
+
+	const auto view = Matrix4f::createLookAt(Vector3f(0.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, 0.0f, 1.0f));
+	const auto projection = Matrix4f::createPerspective(Math::toRadians(70.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+
+	const Frustumf frustum(projection * view);
+
+	std::vector<AABBf> aabbs;
+	std::vector<Spheref> spheres;
+	AABBBatchf aabbBatch;
+	SphereBatchf sphereBatch;
+
+	aabbs.reserve(ElementCount);
+	spheres.reserve(ElementCount);
+	aabbBatch.reserve(ElementCount);
+	sphereBatch.reserve(ElementCount);
+
+	for (size_t i = 0; i < ElementCount; i++)
+	{
+		const Vector3f center(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+		const Vector3f halfSize(sizeDistribution(generator), sizeDistribution(generator), sizeDistribution(generator));
+
+		aabbs.emplace_back(center - halfSize, center + halfSize);
+		aabbBatch.add(center, halfSize);
+
+		spheres.emplace_back(center, halfSize.x);
+		sphereBatch.add(center, halfSize.x);
+	}
+
+	std::vector<IntersectionType> intersectionTypes;
+
+	std::cout << "ATEMA_SIMD : " << ATEMA_SIMD << ", " << ElementCount << " elements" << std::endl;
+
+	// AABBs
+	{
+		size_t checksum = 0;
+		Timer timer;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			for (const auto& aabb : aabbs)
+				checksum += static_cast<size_t>(frustum.getIntersectionType(aabb));
+		}
+
+		printResult("AABB (single)", timer.getStep(), checksum);
+	}
+
+	{
+		size_t checksum = 0;
+		Timer timer;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			frustum.getIntersectionTypes(aabbBatch, intersectionTypes);
+
+			for (const auto& intersectionType : intersectionTypes)
+				checksum += static_cast<size_t>(intersectionType);
+		}
+
+		printResult("AABB (batch)", timer.getStep(), checksum);
+	}
+
+	// Spheres
+	{
+		size_t checksum = 0;
+		Timer timer;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			for (const auto& sphere : spheres)
+				checksum += static_cast<size_t>(frustum.getIntersectionType(sphere));
+		}
+
+		printResult("Sphere (single)", timer.getStep(), checksum);
+	}
+
+	{
+		size_t checksum = 0;
+		Timer timer;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			frustum.getIntersectionTypes(sphereBatch, intersectionTypes);
+
+			for (const auto& intersectionType : intersectionTypes)
+				checksum += static_cast<size_t>(intersectionType);
+		}
+
+		printResult("Sphere (batch)", timer.getStep(), checksum);
+	}
+
+	return 0;
+}
@@ -0,0 +1,202 @@
+#include <Atema/Math/Matrix.hpp>
+#include <Atema/Math/Vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace at;
+
+// Checks that the SIMD paths of Matrix4f give the same results as the scalar ones
+// Matrix4d never uses SIMD instructions, so it is used as the scalar reference
+namespace
+{
+	constexpr size_t MatrixCount = 100000;
+
+	// Products & transforms only round differently
+	constexpr double Tolerance = 1e-4;
+	// Inverses amplify rounding errors with the condition number of the matrix, so the error is relative to the inverse's magnitude
+	constexpr double InverseTolerance = 1e-3;
+
+	struct CheckResult
+	{
+		size_t failureCount = 0;
+		double maxError = 0.0;
+
+		void add(double error, double tolerance)
+		{
+			maxError = std::max(maxError, error);
+
+			if (!(error <= tolerance))
+				failureCount++;
+		}
+
+		void print(const std::string& label) const
+		{
+			std::cout << label << " : " << (failureCount == 0 ? "OK" : "FAILED") << " (max error " << maxError << ", " << failureCount << " failures)" << std::endl;
+		}
+	};
+
+	Matrix4d toDouble(const Matrix4f& matrix)
+	{
+		Matrix4d result;
+
+		for (size_t col = 0; col < 4; col++)
+		{
+			for (size_t row = 0; row < 4; row++)
+				result[col][row] = static_cast<double>(matrix[col][row]);
+		}
+
+		return result;
+	}
+
+	double getMaxAbs(const Matrix4d& matrix)
+	{
+		double maxValue = 0.0;
+
+		for (size_t col = 0; col < 4; col++)
+		{
+			for (size_t row = 0; row < 4; row++)
+				maxValue = std::max(maxValue, std::abs(matrix[col][row]));
+		}
+
+		return maxValue;
+	}
+
+	double getError(const Matrix4f& value, const Matrix4d& reference)
+	{
+		double error = 0.0;
+
+		for (size_t col = 0; col < 4; col++)
+		{
+			for (size_t row = 0; row < 4; row++)
+				error = std::max(error, std::abs(static_cast<double>(value[col][row]) - reference[col][row]));
+		}
+
+		return error;
+	}
+
+	template <size_t N>
+	double getError(const Vector<N, float>& value, const Vector<N, double>& reference)
+	{
+		double error = 0.0;
+
+		for (size_t i = 0; i < N; i++)
+			error = std::max(error, std::abs(static_cast<double>(value[i]) - reference[i]));
+
+		return error;
+	}
+
+	Vector3d toDouble(const Vector3f& vector)
+	{
+		return { static_cast<double>(vector.x), static_cast<double>(vector.y), static_cast<double>(vector.z) };
+	}
+}
+
+// MAIN
+int main(int argc, char** argv)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	const auto createMatrix = [&]()
+	{
+		Matrix4f matrix;
+
+		for (size_t col = 0; col < 4; col++)
+		{
+			for (size_t row = 0; row < 4; row++)
+				matrix[col][row] = distribution(generator);
+		}
+
+		return matrix;
+	};
+
+	const auto createVector = [&]()
+	{
+		return Vector3f(distribution(generator), distribution(generator), distribution(generator));
+	};
+
+	std::cout << "ATEMA_SIMD : " << ATEMA_SIMD << ", " << MatrixCount << " random matrices" << std::endl;
+
+	CheckResult productResult;
+	CheckResult vectorResult;
+	CheckResult positionResult;
+	CheckResult batchResult;
+	CheckResult inverseResult;
+	size_t skippedInverseCount = 0;
+
+	std::vector<Vector3f> positions(4);
+	std::vector<Vector3f> vectors(4);
+
+	for (size_t i = 0; i < MatrixCount; i++)
+	{
+		const auto a = createMatrix();
+		const auto b = createMatrix();
+
+		const auto referenceA = toDouble(a);
+		const auto referenceB = toDouble(b);
+
+		// Product
+		productResult.add(getError(a * b, referenceA * referenceB), Tolerance);
+
+		// Matrix * Vector4
+		const Vector4f vector4(distribution(generator), distribution(generator), distribution(generator), distribution(generator));
+		const Vector4d referenceVector4(vector4.x, vector4.y, vector4.z, vector4.w);
+
+		vectorResult.add(getError(a * vector4, referenceA * referenceVector4), Tolerance);
+
+		// Single transforms
+		const auto position = createVector();
+		const auto vector = createVector();
+
+		positionResult.add(getError(a.transformPosition(position), referenceA.transformPosition(toDouble(position))), Tolerance);
+		positionResult.add(getError(a.transformVector(vector), referenceA.transformVector(toDouble(vector))), Tolerance);
+
+		// Batch transforms
+		for (size_t j = 0; j < positions.size(); j++)
+		{
+			positions[j] = createVector();
+			vectors[j] = createVector();
+		}
+
+		auto transformedPositions = positions;
+		auto transformedVectors = vectors;
+
+		a.transformPositions(transformedPositions.data(), transformedPositions.size());
+		a.transformVectors(transformedVectors.data(), transformedVectors.size());
+
+		for (size_t j = 0; j < positions.size(); j++)
+		{
+			batchResult.add(getError(transformedPositions[j], referenceA.transformPosition(toDouble(positions[j]))), Tolerance);
+			batchResult.add(getError(transformedVectors[j], referenceA.transformVector(toDouble(vectors[j]))), Tolerance);
+		}
+
+		// Inverse : ill-conditioned matrices can't be compared in float precision
+		const auto referenceInverse = Matrix4d::createInverse(referenceA);
+		const auto inverseMagnitude = getMaxAbs(referenceInverse);
+
+		if (!std::isfinite(inverseMagnitude) || inverseMagnitude > 1000.0)
+		{
+			skippedInverseCount++;
+			continue;
+		}
+
+		inverseResult.add(getError(Matrix4f::createInverse(a), referenceInverse) / inverseMagnitude, InverseTolerance);
+	}
+
+	productResult.print("Matrix * Matrix");
+	vectorResult.print("Matrix * Vector4");
+	positionResult.print("transformPosition/transformVector");
+	batchResult.print("transformPositions/transformVectors");
+	inverseResult.print("Inverse (relative error, " + std::to_string(skippedInverseCount) + " ill-conditioned matrices skipped)");
+
+	const bool success = productResult.failureCount == 0
+		&& vectorResult.failureCount == 0
+		&& positionResult.failureCount == 0
+		&& batchResult.failureCount == 0
+		&& inverseResult.failureCount == 0;
+
+	return success ? 0 : 1;
+}
@@ -0,0 +1,269 @@
+#include <Atema/Core/TaskManager.hpp>
+#include <Atema/Core/Timer.hpp>
+#include <Atema/Graphics/Loaders/MeshOptimizer.hpp>
+#include <Atema/Graphics/Loaders/ModelLoader.hpp>
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tinyobjloader/tiny_obj_loader.h>
+
+#include <iostream>
+
+using namespace at;
+
+namespace
+{
+	constexpr size_t IterationCount = 5;
+
+	struct MeshSource
+	{
+		std::vector<ModelLoader::StaticVertex> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	// Unindexed triangles, one mesh per shape, like ObjLoader before its processing
+	std::vector<MeshSource> loadMeshSources(const std::string& path)
+	{
+		tinyobj::ObjReader objReader;
+
+		objReader.ParseFromFile(path);
+
+		if (!objReader.Valid())
+		{
+			std::cout << "Can't load " << path << " : " << objReader.Error() << std::endl;
+			return {};
+		}
+
+		const auto& attrib = objReader.GetAttrib();
+
+		std::vector<MeshSource> meshSources;
+
+		for (const auto& shape : objReader.GetShapes())
+		{
+			auto& meshSource = meshSources.emplace_back();
+
+			for (const auto& index : shape.mesh.indices)
+			{
+				auto& vertex = meshSource.vertices.emplace_back();
+
+				vertex.position = { attrib.vertices[3 * index.vertex_index + 0], attrib.vertices[3 * index.vertex_index + 1], attrib.vertices[3 * index.vertex_index + 2] };
+
+				if (index.texcoord_index >= 0)
+					vertex.texCoords = { attrib.texcoords[2 * index.texcoord_index + 0], attrib.texcoords[2 * index.texcoord_index + 1] };
+
+				if (index.normal_index >= 0)
+					vertex.normal = { attrib.normals[3 * index.normal_index + 0], attrib.normals[3 * index.normal_index + 1], attrib.normals[3 * index.normal_index + 2] };
+
+				meshSource.indices.emplace_back(static_cast<uint32_t>(meshSource.indices.size()));
+			}
+		}
+
+		return meshSources;
+	}
+
+	void processMesh(const MeshSource& meshSource, size_t& checksum)
+	{
+		auto vertices = meshSource.vertices;
+		auto indices = meshSource.indices;
+
+		ModelLoader::removeDuplicates(vertices, indices);
+		ModelLoader::generateTangents(vertices, indices);
+
+		checksum += vertices.size();
+	}
+
+	// Statistics of all the meshes, weighted by their triangle & vertex count
+	struct ModelStatistics
+	{
+		size_t triangleCount = 0;
+		size_t vertexCount = 0;
+		float transformCount = 0.0f;
+
+		void add(const std::vector<uint32_t>& indices, size_t meshVertexCount)
+		{
+			const auto statistics = MeshOptimizer::getVertexCacheStatistics(indices, meshVertexCount);
+
+			triangleCount += indices.size() / 3;
+			vertexCount += meshVertexCount;
+			transformCount += statistics.acmr * static_cast<float>(indices.size() / 3);
+		}
+
+		void print(const std::string& label) const
+		{
+			std::cout << "\t" << label << " : ACMR " << transformCount / static_cast<float>(triangleCount) << ", ATVR " << transformCount / static_cast<float>(vertexCount) << std::endl;
+		}
+	};
+
+	void printResult(const std::string& label, TimeStep timeStep, size_t checksum)
+	{
+		std::cout << "\t" << label << " : " << timeStep.getMilliSeconds() / IterationCount << " ms (checksum " << checksum << ")" << std::endl;
+	}
+}
+
+// MAIN
+// Usage : ModelBenchmark path/to/sponza.obj path/to/tardis.obj ...
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage : " << argv[0] << " model.obj [model.obj ...]" << std::endl;
+		return 0;
+	}
+
+	std::cout << TaskManager::instance().getSize() << " worker threads" << std::endl;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const auto meshSources = loadMeshSources(argv[i]);
+
+		size_t vertexCount = 0;
+		for (const auto& meshSource : meshSources)
+			vertexCount += meshSource.vertices.size();
+
+		std::cout << argv[i] << " : " << meshSources.size() << " meshes, " << vertexCount << " unindexed vertices" << std::endl;
+
+		// Deduplication only
+		{
+			size_t checksum = 0;
+			Timer timer;
+
+			for (size_t iteration = 0; iteration < IterationCount; iteration++)
+			{
+				for (const auto& meshSource : meshSources)
+				{
+					auto vertices = meshSource.vertices;
+					auto indices = meshSource.indices;
+
+					ModelLoader::removeDuplicates(vertices, indices);
+
+					checksum += vertices.size();
+				}
+			}
+
+			printResult("Deduplication", timer.getStep(), checksum);
+		}
+
+		// Deduplication & tangents, one mesh after the other
+		{
+			size_t checksum = 0;
+			Timer timer;
+
+			for (size_t iteration = 0; iteration < IterationCount; iteration++)
+			{
+				for (const auto& meshSource : meshSources)
+					processMesh(meshSource, checksum);
+			}
+
+			printResult("Deduplication & tangents (single thread)", timer.getStep(), checksum);
+		}
+
+		// Deduplication & tangents, meshes spread across the workers like ObjLoader does
+		{
+			std::vector<size_t> checksums(meshSources.size(), 0);
+			Timer timer;
+
+			for (size_t iteration = 0; iteration < IterationCount; iteration++)
+			{
+				TaskManager::instance().parallelFor(meshSources.size(), [&](size_t meshIndex)
+					{
+						processMesh(meshSources[meshIndex], checksums[meshIndex]);
+					});
+			}
+
+			const auto timeStep = timer.getStep();
+
+			size_t checksum = 0;
+			for (const auto& meshChecksum : checksums)
+				checksum += meshChecksum;
+
+			printResult("Deduplication & tangents (parallel)", timeStep, checksum);
+		}
+
+		// Mesh optimization, with the vertex cache statistics before & after
+		{
+			std::vector<MeshSource> processedSources;
+			ModelStatistics sourceStatistics;
+
+			for (const auto& meshSource : meshSources)
+			{
+				auto& processedSource = processedSources.emplace_back(meshSource);
+
+				ModelLoader::removeDuplicates(processedSource.vertices, processedSource.indices);
+				ModelLoader::generateTangents(processedSource.vertices, processedSource.indices);
+
+				sourceStatistics.add(processedSource.indices, processedSource.vertices.size());
+			}
+
+			ModelStatistics optimizedStatistics;
+			size_t checksum = 0;
+			Timer timer;
+
+			for (size_t iteration = 0; iteration < IterationCount; iteration++)
+			{
+				for (const auto& processedSource : processedSources)
+				{
+					auto vertices = processedSource.vertices;
+					auto indices = processedSource.indices;
+
+					MeshOptimizer::optimize(vertices, indices);
+
+					checksum += vertices.size();
+
+					if (iteration == 0)
+						optimizedStatistics.add(indices, vertices.size());
+				}
+			}
+
+			printResult("Optimization", timer.getStep(), checksum);
+
+			sourceStatistics.print("Source order");
+			optimizedStatistics.print("Optimized order");
+		}
+
+		// Meshlet generation on the optimized meshes
+		{
+			std::vector<MeshSource> optimizedSources;
+
+			for (const auto& meshSource : meshSources)
+			{
+				auto& optimizedSource = optimizedSources.emplace_back(meshSource);
+
+				ModelLoader::removeDuplicates(optimizedSource.vertices, optimizedSource.indices);
+				MeshOptimizer::optimize(optimizedSource.vertices, optimizedSource.indices);
+			}
+
+			size_t checksum = 0;
+			Timer timer;
+
+			for (size_t iteration = 0; iteration < IterationCount; iteration++)
+			{
+				for (const auto& optimizedSource : optimizedSources)
+				{
+					auto indices = optimizedSource.indices;
+
+					checksum += MeshOptimizer::buildMeshlets(optimizedSource.vertices, indices).size();
+				}
+			}
+
+			printResult("Meshlets", timer.getStep(), checksum);
+
+			// One simplification halving the triangles, the first step of the LOD chain
+			checksum = 0;
+			Timer simplificationTimer;
+
+			for (size_t iteration = 0; iteration < IterationCount; iteration++)
+			{
+				for (const auto& optimizedSource : optimizedSources)
+				{
+					float error;
+					const auto targetIndexCount = optimizedSource.indices.size() / 6 * 3;
+
+					checksum += MeshOptimizer::simplify(optimizedSource.vertices, optimizedSource.indices, targetIndexCount, std::numeric_limits<float>::max(), error).size();
+				}
+			}
+
+			printResult("Simplification (LOD 1)", simplificationTimer.getStep(), checksum);
+		}
+	}
+
+	return 0;
+}
@@ -29,6 +29,9 @@
 struct GraphicsComponent
 {
 	at::Ptr<at::StaticModel> staticModel;
+
+	// Node of the RenderScene's TransformHierarchy driving the model's matrix
+	at::TransformHierarchy::Handle transformNode = at::TransformHierarchy::InvalidHandle;
 };
 
 #endif
@@ -27,6 +27,9 @@
 struct LightComponent
 {
 	at::Ptr<at::Light> light;
+
+	// Node of the RenderScene's TransformHierarchy driving the light's position (point & spot lights only)
+	at::TransformHierarchy::Handle transformNode = at::TransformHierarchy::InvalidHandle;
 };
 
 #endif
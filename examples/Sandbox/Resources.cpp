@@ -21,6 +21,8 @@
 
 #include "Resources.hpp"
 
+#include <Atema/Graphics/AssetLoader.hpp>
+#include <Atema/Graphics/Loaders/ModelCache.hpp>
 #include <Atema/Graphics/Loaders/ObjLoader.hpp>
 #include <Atema/Graphics/MaterialData.hpp>
 #include <Atema/Graphics/VertexFormat.hpp>
@@ -53,6 +55,65 @@ namespace
 
 		return z;
 	}
+
+	ModelLoader::Settings getLoaderSettings(const ResourceLoader::ModelSettings& modelSettings)
+	{
+		const auto vertexFormat = VertexFormat::create(DefaultVertexFormat::XYZ_UV_NT_Quantized);
+
+		ModelLoader::Settings loaderSettings(vertexFormat);
+		loaderSettings.flipTexCoords = true;
+		loaderSettings.optimizeMesh = true;
+		loaderSettings.buildMeshlets = true;
+		loaderSettings.lodCount = 4;
+		loaderSettings.vertexTransformation = modelSettings.vertexTransformation;
+		loaderSettings.textureDir = ResourcePath::textures();
+
+		return loaderSettings;
+	}
+
+	Ptr<Model> loadModelGeometry(const ResourceLoader::ModelSettings& modelSettings, ModelLoader::Settings& loaderSettings)
+	{
+		// Processed models are kept between runs
+		const auto cacheKey = ModelCache::getKey(modelSettings.modelPath, loaderSettings);
+		const auto cachePath = ResourcePath::cache() / "Models" / (modelSettings.modelPath.stem().string() + ".atmodel");
+
+		auto model = ModelCache::load(cachePath, cacheKey, loaderSettings);
+
+		if (!model)
+		{
+			std::vector<ModelLoader::MeshData> meshData;
+			loaderSettings.meshData = &meshData;
+
+			model = ObjLoader::load(modelSettings.modelPath, loaderSettings);
+
+			ModelCache::save(cachePath, cacheKey, *model, meshData);
+		}
+
+		return model;
+	}
+
+	void initializeMaterials(Model& model, const ResourceLoader::ModelSettings& modelSettings)
+	{
+		if (modelSettings.overrideMaterial)
+		{
+			for (auto& mesh : model.getMeshes())
+				mesh->setMaterialID(0);
+
+			*model.getMaterialData()[0] = *ResourceLoader::loadMaterialData(modelSettings.modelTexturePath, modelSettings.modelTextureExtension);
+
+			// The overriding material must still decode the quantized vertices
+			model.getMaterialData()[0]->set(MaterialData::QuantizedVertex, 1u);
+		}
+
+		// Decode the textures in parallel before the instances ask for them one by one
+		DefaultMaterials::loadTextures(model.getMaterialData());
+
+		for (auto& materialData : model.getMaterialData())
+		{
+			//model.addMaterialInstance(DefaultMaterials::getPhongInstance(*materialData));
+			model.addMaterialInstance(DefaultMaterials::getPBRInstance(*materialData));
+		}
+	}
 }
 
 std::filesystem::path ResourcePath::resources() noexcept
@@ -80,34 +141,41 @@ std::filesystem::path ResourcePath::textures() noexcept
 	return resources() / "Textures";
 }
 
-at::Ptr<at::Model> ResourceLoader::loadModel(const ModelSettings& modelSettings)
+std::filesystem::path ResourcePath::cache() noexcept
 {
-	const auto vertexFormat = VertexFormat::create(DefaultVertexFormat::XYZ_UV_NTB);
-
-	ModelLoader::Settings loaderSettings(vertexFormat);
-	loaderSettings.flipTexCoords = true;
-	loaderSettings.vertexTransformation = modelSettings.vertexTransformation;
-	loaderSettings.textureDir = ResourcePath::textures();
-
-	auto model = ObjLoader::load(modelSettings.modelPath, loaderSettings);
+	return resources() / "Cache";
+}
 
-	if (modelSettings.overrideMaterial)
-	{
-		for (auto& mesh : model->getMeshes())
-			mesh->setMaterialID(0);
+at::Ptr<at::Model> ResourceLoader::loadModel(const ModelSettings& modelSettings)
+{
+	auto loaderSettings = getLoaderSettings(modelSettings);
 
-		*model->getMaterialData()[0] = *loadMaterialData(modelSettings.modelTexturePath, modelSettings.modelTextureExtension);
-	}
+	auto model = loadModelGeometry(modelSettings, loaderSettings);
 
-	for (auto& materialData : model->getMaterialData())
-	{
-		//model->addMaterialInstance(DefaultMaterials::getPhongInstance(*materialData));
-		model->addMaterialInstance(DefaultMaterials::getPBRInstance(*materialData));
-	}
+	initializeMaterials(*model, modelSettings);
 
 	return model;
 }
 
+void ResourceLoader::loadModelAsync(const ModelSettings& modelSettings, const std::function<void(const at::Ptr<at::Model>&)>& callback)
+{
+	AssetLoader::instance().load<Model>([modelSettings](AssetLoader::UploadContext& context)
+		{
+			auto loaderSettings = getLoaderSettings(modelSettings);
+			loaderSettings.commandBuffer = context.commandBuffer;
+			loaderSettings.stagingBuffers = &context.stagingBuffers;
+
+			return loadModelGeometry(modelSettings, loaderSettings);
+		},
+		[modelSettings, callback](const Ptr<Model>& model)
+		{
+			// Materials use Graphics resources, they are created on this thread
+			initializeMaterials(*model, modelSettings);
+
+			callback(model);
+		});
+}
+
 at::Ptr<at::MaterialData> ResourceLoader::loadMaterialData(const std::filesystem::path& path, const std::string& extension)
 {
 	static const std::vector<MaterialTextureParameter> materialParameters =
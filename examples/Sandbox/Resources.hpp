@@ -26,6 +26,7 @@
 #include <Atema/Graphics/Model.hpp>
 
 #include <filesystem>
+#include <functional>
 
 struct ResourcePath
 {
@@ -34,6 +35,8 @@ struct ResourcePath
 	static std::filesystem::path models() noexcept;
 	static std::filesystem::path shaders() noexcept;
 	static std::filesystem::path textures() noexcept;
+	// Generated data that can be deleted at any time
+	static std::filesystem::path cache() noexcept;
 };
 
 struct ResourceLoader
@@ -50,6 +53,8 @@ struct ResourceLoader
 	};
 
 	static at::Ptr<at::Model> loadModel(const ModelSettings& modelSettings);
+	// Loads the model in the background (see AssetLoader), the callback is called once the model can be rendered
+	static void loadModelAsync(const ModelSettings& modelSettings, const std::function<void(const at::Ptr<at::Model>&)>& callback);
 
 	static at::Ptr<at::MaterialData> loadMaterialData(const std::filesystem::path& path, const std::string& extension);
 };
@@ -27,6 +27,7 @@
 #include <Atema/Graphics/Loaders/ObjLoader.hpp>
 #include <Atema/Renderer/RenderWindow.hpp>
 #include <Atema/Graphics/Primitive.hpp>
+#include <Atema/Shader/Spirv/SpirvShaderCache.hpp>
 
 #include "Components/GraphicsComponent.hpp"
 #include "Components/VelocityComponent.hpp"
@@ -147,8 +148,12 @@ SandboxApplication::SandboxApplication():
 	m_frameDuration(0.0f),
 	m_sceneType(Settings::SceneType::None)
 {
-	// Let default settings for now
 	Renderer::Settings settings;
+	// Compiled pipelines are kept between runs
+	settings.pipelineCachePath = ResourcePath::cache() / "Pipelines.bin";
+
+	if (Settings::instance().dumpShaders)
+		settings.shaderDumpPath = ResourcePath::cache() / "ShaderDumps";
 
 	Renderer::create<VulkanRenderer>(settings);
 
@@ -165,8 +170,27 @@ SandboxApplication::SandboxApplication():
 			onEvent(event);
 		});
 
+	// Compiled shaders are kept between runs
+	SpirvShaderCache::instance().setDirectory(ResourcePath::cache() / "Shaders");
+
+	// So are shader ASTs, to skip parsing at startup
+	// On the first run, the built-in libraries precompiled by ShaderBundleCompiler at build time are used instead
+	if (!Graphics::instance().loadShaderBundle(ResourcePath::cache() / "Shaders" / "Shaders.bundle"))
+		Graphics::instance().loadShaderBundle("Shaders.bundle");
+
 	Graphics::instance().initializeShaderLibraries(ShaderLibraryManager::instance());
 
+	// Material textures are block-compressed once, then loaded from the cache : the slower sharper filter is affordable
+	ImageLoader::Settings imageSettings;
+	imageSettings.compression = ImageLoader::Compression::HighQuality;
+	imageSettings.mipFilter = ImageLoader::MipFilter::Kaiser;
+	imageSettings.cacheDirectory = ResourcePath::cache() / "Textures";
+
+	Graphics::instance().setDefaultImageSettings(imageSettings);
+
+	// Only their finest levels are streamed, depending on the distance of the objects using them
+	TextureStreamer::instance().setEnabled(true);
+
 	// Create systems
 	auto sceneUpdateSystem = std::make_shared<SceneUpdateSystem>();
 	sceneUpdateSystem->setEntityManager(m_entityManager);
@@ -215,6 +239,9 @@ SandboxApplication::~SandboxApplication()
 	
 	m_window.reset();
 
+	// Shaders parsed during this run will be loaded directly next time
+	Graphics::instance().saveShaderBundle(ResourcePath::cache() / "Shaders" / "Shaders.bundle");
+
 	Renderer::destroy();
 }
 
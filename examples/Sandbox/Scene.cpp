@@ -35,6 +35,7 @@
 #include <Atema/Graphics/Loaders/DefaultImageLoader.hpp>
 #include <Atema/Graphics/Loaders/ImageLoader.hpp>
 #include <Atema/Graphics/Loaders/ModelLoader.hpp>
+#include <Atema/Graphics/Pipelines/EnvironmentCache.hpp>
 #include <Atema/Graphics/Pipelines/EnvironmentPipeline.hpp>
 #include <Atema/Renderer/Renderer.hpp>
 
@@ -289,24 +290,46 @@ void Scene::setSkyBox(const std::filesystem::path& texturePath, bool cubemap)
 {
 	Ptr<SkyBox> skyBox = std::make_shared<SkyBox>();
 
+	Image::Settings imageSettings;
+	imageSettings.format = ImageFormat::RGBA16_SFLOAT;
+	imageSettings.type = ImageType::CubeMap;
+	imageSettings.usages = ImageUsage::RenderTarget | ImageUsage::ShaderSampling | ImageUsage::TransferSrc;
+
+	Image::Settings irradianceSettings = imageSettings;
+	irradianceSettings.width = irradianceSettings.height = 64;
+	irradianceSettings.mipLevels = 1;
+
+	Image::Settings prefilteredSettings = imageSettings;
+	prefilteredSettings.width = prefilteredSettings.height = 1024;
+	prefilteredSettings.mipLevels = 5;
+
+	// Precomputed maps don't depend on the source image only, so the cache key also contains the output settings
+	const auto cacheKey = EnvironmentCache::getKey(texturePath, { irradianceSettings, prefilteredSettings });
+	const auto cachePath = ResourcePath::cache() / (texturePath.stem().string() + ".atenv");
+
+	std::vector<Ptr<Image>> cubemaps;
+	if (EnvironmentCache::load(cachePath, cacheKey, cubemaps))
+	{
+		skyBox->environmentMap = cubemaps[0];
+		skyBox->irradianceMap = cubemaps[1];
+		skyBox->prefilteredMap = cubemaps[2];
+
+		m_renderScene->setSkyBox(skyBox);
+
+		return;
+	}
+
 	ImageLoader::Settings imageLoaderSettings;
 	if (cubemap)
 		imageLoaderSettings.type = ImageType::CubeMap;
 
-	auto baseEnvironmentMap = DefaultImageLoader::load(texturePath, imageLoaderSettings);
+	// The environment map is read back to be cached
+	imageLoaderSettings.usages |= ImageUsage::TransferSrc;
 
-	Image::Settings imageSettings;
-	imageSettings.format = ImageFormat::RGBA16_SFLOAT;
-	imageSettings.type = ImageType::CubeMap;
-	imageSettings.usages = ImageUsage::RenderTarget | ImageUsage::ShaderSampling;
-
-	imageSettings.width = imageSettings.height = 64;
-	imageSettings.mipLevels = 1;
-	skyBox->irradianceMap = Image::create(imageSettings);
+	auto baseEnvironmentMap = DefaultImageLoader::load(texturePath, imageLoaderSettings);
 
-	imageSettings.width = imageSettings.height = 1024;
-	imageSettings.mipLevels = 5;
-	skyBox->prefilteredMap = Image::create(imageSettings);
+	skyBox->irradianceMap = Image::create(irradianceSettings);
+	skyBox->prefilteredMap = Image::create(prefilteredSettings);
 
 	Ptr<Image> environmentMap;
 	if (baseEnvironmentMap->getType() == ImageType::CubeMap)
@@ -317,7 +340,7 @@ void Scene::setSkyBox(const std::filesystem::path& texturePath, bool cubemap)
 	{
 		const Vector2u imageSize = baseEnvironmentMap->getSize();
 
-		imageSettings.usages |= ImageUsage::TransferSrc | ImageUsage::TransferDst;
+		imageSettings.usages |= ImageUsage::TransferDst;
 		imageSettings.width = imageSettings.height = std::min(imageSize.x, imageSize.y);
 		imageSettings.mipLevels = static_cast<uint32_t>(std::floor(std::log2(imageSettings.width))) + 1;
 		skyBox->environmentMap = Image::create(imageSettings);
@@ -357,5 +380,7 @@ void Scene::setSkyBox(const std::filesystem::path& texturePath, bool cubemap)
 
 	Renderer::instance().submitAndWait({ commandBuffer });
 
+	EnvironmentCache::save(cachePath, cacheKey, { skyBox->environmentMap, skyBox->irradianceMap, skyBox->prefilteredMap });
+
 	m_renderScene->setSkyBox(skyBox);
 }
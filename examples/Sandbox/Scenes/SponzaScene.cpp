@@ -27,6 +27,7 @@
 #include "../Components/VelocityComponent.hpp"
 #include "../Components/RandomMoveComponent.hpp"
 
+#include <Atema/Graphics/AssetLoader.hpp>
 #include <Atema/Graphics/DefaultMaterials.hpp>
 #include <Atema/Graphics/MaterialData.hpp>
 #include <Atema/Graphics/Model.hpp>
@@ -109,11 +110,15 @@ SponzaScene::SponzaScene() :
 
 SponzaScene::~SponzaScene()
 {
+	// The model callback captures this scene
+	AssetLoader::instance().waitForIdle();
 }
 
 void SponzaScene::update()
 {
-	updateModels();
+	// The main model is loaded asynchronously
+	if (m_model)
+		updateModels();
 }
 
 void SponzaScene::createModels()
@@ -121,9 +126,10 @@ void SponzaScene::createModels()
 	auto& entityManager = getEntityManager();
 
 	// Main objects
-	m_model = ResourceLoader::loadModel(getSponzaModelSettings());
-
-	updateModels();
+	ResourceLoader::loadModelAsync(getSponzaModelSettings(), [this](const Ptr<Model>& model)
+		{
+			m_model = model;
+		});
 
 	// Ground
 
@@ -37,6 +37,7 @@ Settings::Settings() :
 	enableDebugRenderer(false),
 	enableDebugGBuffer(false),
 	enableDebugShadowMaps(false),
+	dumpShaders(false),
 	metricsUpdateTime(1.0f),
 	enableBenchmarks(true)
 {
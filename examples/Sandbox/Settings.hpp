@@ -100,6 +100,10 @@ public:
 	bool enableDebugGBuffer;
 	bool enableDebugShadowMaps;
 
+	// Shaders (read once at startup)
+	// Serialize every compiled shader AST to the cache, to be checked by the ShaderValidation example
+	bool dumpShaders;
+
 	// Metrics
 	float metricsUpdateTime;
 	bool enableBenchmarks;
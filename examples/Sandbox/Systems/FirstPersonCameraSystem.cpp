@@ -193,7 +193,11 @@ void FirstPersonCameraSystem::rotate(at::Transform& transform, const at::Vector2
 
 	const auto delta = mousePosition - m_lastPosition;
 
-	transform.rotate({ 0.0f, delta.y * CameraScale, -delta.x * CameraScale });
+	// Yaw around the world up axis, pitch around the camera's own axis, so no roll is introduced
+	const Quaternionf yaw(Vector3f(0.0f, 0.0f, -delta.x * CameraScale));
+	const Quaternionf pitch(Vector3f(0.0f, delta.y * CameraScale, 0.0f));
+
+	transform.setRotation(yaw * transform.getRotation() * pitch);
 
 	m_lastPosition = mousePosition;
 }
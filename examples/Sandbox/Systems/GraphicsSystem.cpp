@@ -21,6 +21,7 @@
 
 #include "GraphicsSystem.hpp"
 
+#include <Atema/Graphics/AssetLoader.hpp>
 #include <Atema/Graphics/Graphics.hpp>
 #include <Atema/Window/WindowResizeEvent.hpp>
 #include <Atema/Graphics/DefaultLightingModels.hpp>
@@ -35,13 +36,6 @@
 
 using namespace at;
 
-namespace
-{
-	constexpr size_t targetThreadCount = 16;
-
-	const size_t threadCount = std::min(targetThreadCount, TaskManager::instance().getSize());
-}
-
 GraphicsSystem::GraphicsSystem(const Ptr<RenderWindow>& renderWindow) :
 	System(),
 	m_renderWindow(renderWindow),
@@ -150,6 +144,10 @@ GraphicsSystem::GraphicsSystem(const Ptr<RenderWindow>& renderWindow) :
 
 GraphicsSystem::~GraphicsSystem()
 {
+	AssetLoader::instance().clear();
+
+	TextureStreamer::instance().clear();
+
 	Renderer::instance().waitForIdle();
 
 	Graphics::instance().clear();
@@ -157,6 +155,9 @@ GraphicsSystem::~GraphicsSystem()
 
 void GraphicsSystem::update(TimeStep timeStep)
 {
+	// Finish pending asset uploads
+	AssetLoader::instance().update();
+
 	updateRenderables();
 
 	// Ensure the settings did not change
@@ -168,6 +169,9 @@ void GraphicsSystem::update(TimeStep timeStep)
 	// Start frame
 	updateFrame();
 
+	// Stream the texture levels requested by this frame
+	TextureStreamer::instance().update();
+
 	// Clear resources that have been unused for too long
 	Graphics::instance().clearUnused();
 }
@@ -187,11 +191,26 @@ void GraphicsSystem::onEntityAdded(at::EntityHandle entity)
 	auto& entityManager = getEntityManager();
 	auto& renderScene = m_frameRenderer.getRenderScene();
 
+	auto& transformHierarchy = renderScene.getTransformHierarchy();
+
+	const bool hasTransform = entityManager.hasComponent<Transform>(entity);
+
 	if (entityManager.hasComponent<GraphicsComponent>(entity))
 	{
 		auto& graphics = entityManager.getComponent<GraphicsComponent>(entity);
 
 		renderScene.addRenderable(*graphics.staticModel);
+
+		// The hierarchy updates the model matrix (and so its AABB) when the transform changes
+		if (hasTransform)
+		{
+			auto staticModel = graphics.staticModel.get();
+
+			graphics.transformNode = transformHierarchy.add(entityManager.getComponent<Transform>(entity), TransformHierarchy::InvalidHandle, [staticModel](const Matrix4f& matrix)
+				{
+					staticModel->setMatrix(matrix);
+				});
+		}
 	}
 
 	if (entityManager.hasComponent<LightComponent>(entity))
@@ -199,6 +218,41 @@ void GraphicsSystem::onEntityAdded(at::EntityHandle entity)
 		auto& light = entityManager.getComponent<LightComponent>(entity);
 
 		renderScene.addLight(*light.light);
+
+		if (hasTransform)
+		{
+			TransformHierarchy::Callback callback;
+
+			switch (light.light->getType())
+			{
+				case LightType::Point:
+				{
+					auto pointLight = static_cast<PointLight*>(light.light.get());
+
+					callback = [pointLight](const Matrix4f& matrix)
+					{
+						pointLight->setPosition({ matrix[3].x, matrix[3].y, matrix[3].z });
+					};
+
+					break;
+				}
+				case LightType::Spot:
+				{
+					auto spotLight = static_cast<SpotLight*>(light.light.get());
+
+					callback = [spotLight](const Matrix4f& matrix)
+					{
+						spotLight->setPosition({ matrix[3].x, matrix[3].y, matrix[3].z });
+					};
+
+					break;
+				}
+				default: ;
+			}
+
+			if (callback)
+				light.transformNode = transformHierarchy.add(entityManager.getComponent<Transform>(entity), TransformHierarchy::InvalidHandle, std::move(callback));
+		}
 	}
 }
 
@@ -211,6 +265,12 @@ void GraphicsSystem::onEntityRemoved(at::EntityHandle entity)
 	{
 		auto& graphics = entityManager.getComponent<GraphicsComponent>(entity);
 
+		if (graphics.transformNode != TransformHierarchy::InvalidHandle)
+		{
+			renderScene.getTransformHierarchy().remove(graphics.transformNode);
+			graphics.transformNode = TransformHierarchy::InvalidHandle;
+		}
+
 		renderScene.removeRenderable(*graphics.staticModel);
 
 		destroyAfterUse(std::move(graphics.staticModel));
@@ -220,6 +280,12 @@ void GraphicsSystem::onEntityRemoved(at::EntityHandle entity)
 	{
 		auto& light = entityManager.getComponent<LightComponent>(entity);
 
+		if (light.transformNode != TransformHierarchy::InvalidHandle)
+		{
+			renderScene.getTransformHierarchy().remove(light.transformNode);
+			light.transformNode = TransformHierarchy::InvalidHandle;
+		}
+
 		renderScene.removeLight(*light.light);
 
 		destroyAfterUse(std::move(light.light));
@@ -352,105 +418,34 @@ void GraphicsSystem::updateRenderables()
 {
 	ATEMA_BENCHMARK("Update renderables");
 
+	// Only the local transforms are copied here : matrices, AABBs & light positions are computed in parallel
+	// by the RenderScene's TransformHierarchy when the frame renderer updates the scene
+	auto& transformHierarchy = m_frameRenderer.getRenderScene().getTransformHierarchy();
+
 	// Graphics
 	{
 		auto entities = getEntityManager().getUnion<Transform, GraphicsComponent>();
 
-		auto& taskManager = TaskManager::instance();
-
-		std::vector<Ptr<Task>> tasks;
-		tasks.reserve(threadCount);
-
-		size_t firstIndex = 0;
-		const size_t size = entities.size() / threadCount;
-
-		for (size_t taskIndex = 0; taskIndex < threadCount; taskIndex++)
+		for (auto& entity : entities)
 		{
-			auto lastIndex = firstIndex + size;
-
-			if (taskIndex == threadCount - 1)
-			{
-				const auto remainingSize = entities.size() - lastIndex;
-
-				lastIndex += remainingSize;
-			}
-
-			auto task = taskManager.createTask([this, &entities, firstIndex, lastIndex](size_t threadIndex)
-				{
-					for (auto it = entities.begin() + firstIndex; it != entities.begin() + lastIndex; it++)
-					{
-						auto& transform = entities.get<Transform>(*it);
-						auto& graphics = entities.get<GraphicsComponent>(*it);
-
-						graphics.staticModel->setTransform(transform);
-					}
-				});
-
-			tasks.push_back(task);
+			auto& graphics = entities.get<GraphicsComponent>(entity);
 
-			firstIndex += size;
+			if (graphics.transformNode != TransformHierarchy::InvalidHandle)
+				transformHierarchy.setTransform(graphics.transformNode, entities.get<Transform>(entity));
 		}
-
-		for (auto& task : tasks)
-			task->wait();
 	}
 
 	// Lights
 	{
 		auto entities = getEntityManager().getUnion<Transform, LightComponent>();
 
-		auto& taskManager = TaskManager::instance();
-
-		std::vector<Ptr<Task>> tasks;
-		tasks.reserve(threadCount);
-
-		size_t firstIndex = 0;
-		const size_t size = entities.size() / threadCount;
-
-		for (size_t taskIndex = 0; taskIndex < threadCount; taskIndex++)
+		for (auto& entity : entities)
 		{
-			auto lastIndex = firstIndex + size;
-
-			if (taskIndex == threadCount - 1)
-			{
-				const auto remainingSize = entities.size() - lastIndex;
+			auto& light = entities.get<LightComponent>(entity);
 
-				lastIndex += remainingSize;
-			}
-
-			auto task = taskManager.createTask([this, &entities, firstIndex, lastIndex](size_t threadIndex)
-				{
-					for (auto it = entities.begin() + firstIndex; it != entities.begin() + lastIndex; it++)
-					{
-						auto& transform = entities.get<Transform>(*it);
-						auto& light = entities.get<LightComponent>(*it);
-
-						switch (light.light->getType())
-						{
-							case LightType::Point:
-							{
-								auto& pointLight = static_cast<PointLight&>(*light.light.get());
-								pointLight.setPosition(transform.getTranslation());
-								break;
-							}
-							case LightType::Spot:
-							{
-								auto& spotLight = static_cast<SpotLight&>(*light.light.get());
-								spotLight.setPosition(transform.getTranslation());
-								break;
-							}
-							default: ;
-						}
-					}
-				});
-
-			tasks.push_back(task);
-
-			firstIndex += size;
+			if (light.transformNode != TransformHierarchy::InvalidHandle)
+				transformHierarchy.setTransform(light.transformNode, entities.get<Transform>(entity));
 		}
-
-		for (auto& task : tasks)
-			task->wait();
 	}
 }
 
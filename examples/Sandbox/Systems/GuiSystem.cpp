@@ -21,7 +21,9 @@
 
 #include "GuiSystem.hpp"
 
+#include <Atema/Renderer/Renderer.hpp>
 #include <Atema/Renderer/UI/UiContext.hpp>
+#include <Atema/Shader/Spirv/SpirvShaderCache.hpp>
 
 #include "../Resources.hpp"
 #include "../Settings.hpp"
@@ -613,6 +615,20 @@ void GuiSystem::showOverlay()
 		ImGui::Text("%u fps", fps);
 		ImGui::Text("%.03f ms", frameTime * 1000.0f);
 
+		// Cumulated since the application started
+		const auto shaderStatistics = SpirvShaderCache::instance().getStatistics();
+
+		ImGui::Separator();
+
+		ImGui::Text("Shaders : %zu cached / %zu compiled", shaderStatistics.hits, shaderStatistics.misses);
+		ImGui::Text("Shader compilation : %.03f ms", shaderStatistics.compileTime.getMilliSeconds());
+		ImGui::Text("Shader cache loading : %.03f ms", shaderStatistics.loadTime.getMilliSeconds());
+
+		const auto pipelineStatistics = Renderer::instance().getPipelineStatistics();
+
+		ImGui::Text("Pipelines : %zu created (%zu KB cache loaded)", pipelineStatistics.count, pipelineStatistics.loadedCacheSize / 1024);
+		ImGui::Text("Pipeline creation : %.03f ms", pipelineStatistics.creationTime.getMilliSeconds());
+
 		if (m_stats.size() > 0)
 		{
 			ImGui::Separator();
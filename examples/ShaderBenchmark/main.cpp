@@ -0,0 +1,205 @@
+#include <Atema/Core/Timer.hpp>
+#include <Atema/Graphics/Graphics.hpp>
+#include <Atema/Shader/ShaderLibraryBundle.hpp>
+#include <Atema/Shader/ShaderLibraryManager.hpp>
+#include <Atema/Shader/UberShader.hpp>
+#include <Atema/Shader/Ast/Statement.hpp>
+#include <Atema/Shader/Atsl/AtslParser.hpp>
+#include <Atema/Shader/Atsl/AtslShaderWriter.hpp>
+#include <Atema/Shader/Atsl/AtslToAstConverter.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace at;
+
+// Measures the ATSL lexer & parser throughput on the built-in shader libraries, and the cost of loading them at startup
+// Additional ATSL files can be given as arguments (e.g. the Sandbox light pass shaders)
+namespace
+{
+	constexpr size_t IterationCount = 200;
+
+	const std::vector<std::string> BuiltInLibraries =
+	{
+		"Atema.PostProcess",
+		"Atema.CubemapPass"
+	};
+
+	void printResult(const std::string& label, TimeStep timeStep, size_t byteCount, size_t checksum)
+	{
+		const float megaBytes = static_cast<float>(byteCount * IterationCount) / (1024.0f * 1024.0f);
+
+		std::cout << label << " : " << megaBytes / timeStep.getSeconds() << " MB/s (checksum " << checksum << ")" << std::endl;
+	}
+}
+
+// MAIN
+int main(int argc, char** argv)
+{
+	std::vector<std::string> sources;
+
+	// Built-in libraries are stored as ASTs : write them back to ATSL
+	ShaderLibraryManager libraryManager;
+	Graphics::instance().initializeShaderLibraries(libraryManager);
+
+	for (const auto& libraryName : BuiltInLibraries)
+	{
+		std::stringstream stream;
+		AtslShaderWriter writer(stream);
+
+		libraryManager.getLibrary(libraryName)->accept(writer);
+
+		sources.emplace_back(stream.str());
+	}
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::ifstream file(argv[i]);
+
+		if (!file)
+		{
+			std::cout << "Can't open " << argv[i] << std::endl;
+			continue;
+		}
+
+		std::stringstream stream;
+		stream << file.rdbuf();
+
+		sources.emplace_back(stream.str());
+	}
+
+	size_t byteCount = 0;
+	for (const auto& source : sources)
+		byteCount += source.size();
+
+	std::cout << sources.size() << " sources, " << byteCount << " bytes" << std::endl;
+
+	// Lexer
+	{
+		size_t checksum = 0;
+		Timer timer;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			AtslParser parser;
+
+			for (const auto& source : sources)
+				checksum += parser.createTokens(source).size();
+		}
+
+		printResult("Lexer", timer.getStep(), byteCount, checksum);
+	}
+
+	// Parser (tokens are created once, only the AST conversion is measured)
+	{
+		AtslParser parser;
+
+		std::vector<std::vector<AtslToken>> tokens;
+		for (const auto& source : sources)
+			tokens.emplace_back(parser.createTokens(source));
+
+		size_t checksum = 0;
+		Timer timer;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			for (const auto& sourceTokens : tokens)
+			{
+				AtslToAstConverter converter;
+
+				checksum += converter.createAst(sourceTokens)->statements.size();
+			}
+		}
+
+		printResult("Parser", timer.getStep(), byteCount, checksum);
+	}
+
+	// Preprocessor (default options, allocates & clones a whole AST per instance)
+	{
+		std::vector<Ptr<UberShader>> uberShaders;
+		uberShaders.reserve(sources.size());
+
+		AtslParser parser;
+
+		for (const auto& source : sources)
+		{
+			AtslToAstConverter converter;
+
+			uberShaders.emplace_back(std::make_shared<UberShader>(converter.createAst(parser.createTokens(source))));
+		}
+
+		size_t checksum = 0;
+		Timer timer;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			for (const auto& uberShader : uberShaders)
+				checksum += uberShader->createInstance({}, &libraryManager)->getAst()->statements.size();
+		}
+
+		const auto timeStep = timer.getStep();
+
+		std::cout << "Preprocessor : " << static_cast<float>(uberShaders.size() * IterationCount) / timeStep.getSeconds() << " instances/s (checksum " << checksum << ")" << std::endl;
+	}
+
+	// Startup : parsing every source vs loading a precompiled bundle (file mapping included)
+	{
+		const auto bundlePath = std::filesystem::temp_directory_path() / "AtemaShaderBenchmark.bundle";
+
+		std::vector<Hash64> keys;
+
+		{
+			AtslParser parser;
+			ShaderLibraryBundle bundle;
+
+			for (const auto& source : sources)
+			{
+				AtslToAstConverter converter;
+
+				keys.emplace_back(ShaderLibraryBundle::getKey(source));
+				bundle.add(keys.back(), "Source" + std::to_string(keys.size()), *converter.createAst(parser.createTokens(source)));
+			}
+
+			bundle.save(bundlePath);
+		}
+
+		size_t parseChecksum = 0;
+		Timer timer;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			AtslParser parser;
+
+			for (const auto& source : sources)
+			{
+				AtslToAstConverter converter;
+
+				parseChecksum += converter.createAst(parser.createTokens(source))->statements.size();
+			}
+		}
+
+		const auto parseTime = timer.getStep();
+
+		size_t bundleChecksum = 0;
+
+		for (size_t iteration = 0; iteration < IterationCount; iteration++)
+		{
+			ShaderLibraryBundle bundle;
+			bundle.load(bundlePath);
+
+			for (const auto& key : keys)
+				bundleChecksum += bundle.getAst(key)->statements.size();
+		}
+
+		const auto bundleTime = timer.getStep();
+
+		std::filesystem::remove(bundlePath);
+
+		std::cout << "Startup (parse) : " << parseTime.getMilliSeconds() / IterationCount << " ms (checksum " << parseChecksum << ")" << std::endl;
+		std::cout << "Startup (bundle) : " << bundleTime.getMilliSeconds() / IterationCount << " ms (checksum " << bundleChecksum << ")" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,208 @@
+#include <Atema/Core/Error.hpp>
+#include <Atema/Graphics/Graphics.hpp>
+#include <Atema/Shader/Ast/AstRecursiveVisitor.hpp>
+#include <Atema/Shader/Ast/AstSerializer.hpp>
+#include <Atema/Shader/Loaders/AtslLoader.hpp>
+#include <Atema/Shader/ShaderLibraryManager.hpp>
+#include <Atema/Shader/Spirv/SpirvUtils.hpp>
+
+#include "GlslangShaderWriter.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+using namespace at;
+
+// Compiles shaders with the runtime SPIR-V writer (SpirvShaderWriter), then runs spirv-val on its output
+// Each shader is also compiled with glslang (GlslangShaderWriter, only built for this example) as a reference
+// Inputs are ATSL files, or AST files written by the renderer when Renderer::Settings::shaderDumpPath is set
+// Dumping the ASTs while running the Sandbox covers every built-in shader and every Sandbox shader, with the options actually used
+// Usage : ShaderValidation <files or directories...>
+namespace
+{
+	const std::filesystem::path OutputDirectory = "ShaderValidation";
+
+	struct EntryCollector : public AstConstRecursiveVisitor
+	{
+		void visit(const EntryFunctionDeclarationStatement& statement) override
+		{
+			stages.emplace(statement.stage);
+		}
+
+		std::set<AstShaderStage> stages;
+	};
+
+	struct ShaderSource
+	{
+		std::string name;
+		Ptr<const Statement> ast;
+	};
+
+	std::string getStageName(AstShaderStage stage)
+	{
+		switch (stage)
+		{
+			case AstShaderStage::Vertex: return "vert";
+			case AstShaderStage::Fragment: return "frag";
+			case AstShaderStage::Compute: return "comp";
+			default: return "unknown";
+		}
+	}
+
+	std::vector<uint8_t> readFile(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+			ATEMA_ERROR("Can't open " + path.string());
+
+		return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	// ATSL files may contain several stages and options : each stage is extracted with the default option values
+	void addAtslFile(const std::filesystem::path& path, std::vector<ShaderSource>& sources)
+	{
+		const auto uberShader = AtslLoader::load(path)->createInstance({}, &ShaderLibraryManager::instance());
+
+		EntryCollector entryCollector;
+		uberShader->getAst()->accept(entryCollector);
+
+		for (const auto stage : entryCollector.stages)
+			sources.push_back({ path.stem().string() + "." + getStageName(stage), uberShader->extractStage(stage)->getAst() });
+	}
+
+	// Dumps are already preprocessed and only contain one stage
+	void addAstFile(const std::filesystem::path& path, std::vector<ShaderSource>& sources)
+	{
+		const auto data = readFile(path);
+
+		AstDeserializer deserializer(data.data(), data.size());
+
+		sources.push_back({ path.stem().string(), deserializer.deserialize() });
+	}
+
+	void addPath(const std::filesystem::path& path, std::vector<ShaderSource>& sources)
+	{
+		if (std::filesystem::is_directory(path))
+		{
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(path))
+			{
+				if (entry.is_regular_file())
+					addPath(entry.path(), sources);
+			}
+
+			return;
+		}
+
+		try
+		{
+			if (path.extension() == ".ast")
+				addAstFile(path, sources);
+			else if (AtslLoader::isExtensionSupported(path.extension()))
+				addAtslFile(path, sources);
+		}
+		catch (const std::exception& exception)
+		{
+			// Libraries created at runtime (like the GBuffer ones) can't be resolved here : use AST dumps for these shaders
+			std::cout << "Skipped " << path.string() << " : " << exception.what() << std::endl;
+		}
+	}
+
+	template <typename Compiler>
+	bool compile(const ShaderSource& source, const std::string& compilerName, Compiler compiler)
+	{
+		try
+		{
+			compiler(*source.ast);
+		}
+		catch (const std::exception& exception)
+		{
+			std::cout << source.name << " : " << compilerName << " compilation failed : " << exception.what() << std::endl;
+
+			return false;
+		}
+
+		return true;
+	}
+}
+
+// MAIN
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage : ShaderValidation <files or directories...>" << std::endl;
+		return 1;
+	}
+
+	Graphics::instance().initializeShaderLibraries(ShaderLibraryManager::instance());
+
+	std::vector<ShaderSource> sources;
+
+	for (int i = 1; i < argc; i++)
+		addPath(argv[i], sources);
+
+	std::filesystem::create_directories(OutputDirectory);
+
+	const bool validatorFound = std::system("spirv-val --version") == 0;
+
+	if (!validatorFound)
+		std::cout << "spirv-val was not found in PATH : native modules are only compared to glslang compilation" << std::endl;
+
+	size_t failureCount = 0;
+
+	for (const auto& source : sources)
+	{
+		std::vector<uint32_t> nativeCode;
+		std::vector<uint32_t> glslangCode;
+
+		const bool nativeSuccess = compile(source, "native", [&](const Statement& ast)
+			{
+				spirv::compile(ast, nativeCode);
+			});
+
+		const bool glslangSuccess = compile(source, "glslang", [&](const Statement& ast)
+			{
+				GlslangShaderWriter writer;
+
+				ast.accept(writer);
+
+				writer.compile(glslangCode);
+			});
+
+		// Both backends must accept the shader
+		if (!nativeSuccess || !glslangSuccess)
+		{
+			failureCount++;
+			continue;
+		}
+
+		const auto path = OutputDirectory / (source.name + ".spv");
+
+		{
+			std::ofstream file(path, std::ios::binary);
+			file.write(reinterpret_cast<const char*>(nativeCode.data()), static_cast<std::streamsize>(nativeCode.size() * sizeof(uint32_t)));
+		}
+
+		if (validatorFound)
+		{
+			const auto command = "spirv-val --target-env vulkan1.1 \"" + path.string() + "\"";
+
+			if (std::system(command.c_str()) != 0)
+			{
+				std::cout << source.name << " : spirv-val failed on " << path.string() << std::endl;
+
+				failureCount++;
+				continue;
+			}
+		}
+
+		std::cout << source.name << " : OK (native " << nativeCode.size() * sizeof(uint32_t) << " bytes, glslang " << glslangCode.size() * sizeof(uint32_t) << " bytes)" << std::endl;
+	}
+
+	std::cout << sources.size() - failureCount << "/" << sources.size() << " shaders passed" << std::endl;
+
+	return failureCount == 0 ? 0 : 1;
+}
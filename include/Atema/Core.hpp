@@ -33,6 +33,7 @@
 #include <Atema/Core/Flags.hpp>
 #include <Atema/Core/Hash.hpp>
 #include <Atema/Core/IdManager.hpp>
+#include <Atema/Core/MappedFile.hpp>
 #include <Atema/Core/MemoryMapper.hpp>
 #include <Atema/Core/NonCopyable.hpp>
 #include <Atema/Core/Pointer.hpp>
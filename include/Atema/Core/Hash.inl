@@ -126,7 +126,7 @@ namespace at
 	template <typename T>
 	constexpr typename Hasher<HashFunction>::HashType Hasher<HashFunction>::hash(const T& object)
 	{
-		return HashOverload<T>::hash<Hasher<HashFunction>>(object);
+		return HashOverload<T>::template hash<Hasher<HashFunction>>(object);
 	}
 
 	template <typename HashFunction>
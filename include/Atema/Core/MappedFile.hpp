@@ -0,0 +1,56 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_CORE_MAPPEDFILE_HPP
+#define ATEMA_CORE_MAPPEDFILE_HPP
+
+#include <Atema/Core/Config.hpp>
+#include <Atema/Core/NonCopyable.hpp>
+#include <Atema/Core/Pointer.hpp>
+
+#include <filesystem>
+
+namespace at
+{
+	// Read-only view of a whole file, mapped in memory by the OS
+	// Pages are loaded on demand, so only the accessed parts are actually read
+	class ATEMA_CORE_API MappedFile : public NonCopyable
+	{
+	public:
+		MappedFile() = delete;
+		MappedFile(const std::filesystem::path& filePath);
+		~MappedFile();
+
+		// Returns false if the file could not be opened or is empty
+		bool isOpen() const noexcept;
+
+		// Returns nullptr if the file is not open
+		const void* getData() const noexcept;
+		size_t getSize() const noexcept;
+
+	private:
+		class Implementation;
+
+		UPtr<Implementation> m_impl;
+	};
+}
+
+#endif
@@ -64,6 +64,12 @@ namespace at
 		Ptr<Task> createTask(const std::function<void()>& function);
 		Ptr<Task> createTask(const std::function<void(size_t)>& function);
 
+		// Calls function(index) for each index in [0, count), spread across the worker threads
+		// The calling thread takes part in the work and returns once every index is processed
+		// Waiting workers are never required, so it can safely be called from inside a task
+		// The first exception thrown by function is rethrown on the calling thread
+		void parallelFor(size_t count, const std::function<void(size_t)>& function);
+
 	private:
 		TaskManager();
 		void initialize(size_t size);
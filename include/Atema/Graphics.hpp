@@ -25,6 +25,8 @@
 #include <Atema/Graphics/Config.hpp>
 #include <Atema/Graphics/AbstractFrameRenderer.hpp>
 #include <Atema/Graphics/AbstractRenderPass.hpp>
+#include <Atema/Graphics/AssetLoader.hpp>
+#include <Atema/Graphics/BoundingVolumeHierarchy.hpp>
 #include <Atema/Graphics/Camera.hpp>
 #include <Atema/Graphics/DebugRenderer.hpp>
 #include <Atema/Graphics/DefaultLightingModels.hpp>
@@ -44,8 +46,12 @@
 #include <Atema/Graphics/LightingModel.hpp>
 #include <Atema/Graphics/Loaders/DefaultImageLoader.hpp>
 #include <Atema/Graphics/Loaders/ImageLoader.hpp>
+#include <Atema/Graphics/Loaders/MeshOptimizer.hpp>
+#include <Atema/Graphics/Loaders/ModelCache.hpp>
 #include <Atema/Graphics/Loaders/ModelLoader.hpp>
 #include <Atema/Graphics/Loaders/ObjLoader.hpp>
+#include <Atema/Graphics/Loaders/TextureCache.hpp>
+#include <Atema/Graphics/Loaders/TextureCompressor.hpp>
 #include <Atema/Graphics/Material.hpp>
 #include <Atema/Graphics/MaterialData.hpp>
 #include <Atema/Graphics/MaterialParameters.hpp>
@@ -65,6 +71,7 @@
 #include <Atema/Graphics/Passes/SkyPass.hpp>
 #include <Atema/Graphics/Passes/ToneMappingPass.hpp>
 #include <Atema/Graphics/PerspectiveCamera.hpp>
+#include <Atema/Graphics/Pipelines/EnvironmentCache.hpp>
 #include <Atema/Graphics/Pipelines/EnvironmentPipeline.hpp>
 #include <Atema/Graphics/PointLight.hpp>
 #include <Atema/Graphics/Primitive.hpp>
@@ -83,6 +90,8 @@
 #include <Atema/Graphics/SpotLight.hpp>
 #include <Atema/Graphics/StaticModel.hpp>
 #include <Atema/Graphics/StaticRenderModel.hpp>
+#include <Atema/Graphics/TextureStreamer.hpp>
+#include <Atema/Graphics/TransformHierarchy.hpp>
 #include <Atema/Graphics/VertexBuffer.hpp>
 #include <Atema/Graphics/VertexFormat.hpp>
 #include <Atema/Graphics/VertexTypes.hpp>
@@ -0,0 +1,137 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ATEMA_GRAPHICS_ASSETLOADER_HPP
+#define ATEMA_GRAPHICS_ASSETLOADER_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Core/NonCopyable.hpp>
+#include <Atema/Core/Pointer.hpp>
+#include <Atema/Graphics/Loaders/ImageLoader.hpp>
+#include <Atema/Graphics/Loaders/ModelLoader.hpp>
+
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace at
+{
+	class Buffer;
+	class CommandBuffer;
+	class CommandPool;
+	class Fence;
+	class Model;
+
+	// Loads assets in the background
+	// Files are parsed & decoded on TaskManager workers, which also record the GPU uploads
+	// Uploads are then submitted in batches without waiting, and each asset is given to its callback once it is resident on the GPU
+	// Callbacks are always called from update() : loading & updating must be done from the same thread (typically the main thread)
+	class ATEMA_GRAPHICS_API AssetLoader : public NonCopyable
+	{
+	public:
+		// What a loader needs to record its uploads, as expected by ModelLoader::Settings or ImageLoader::Settings
+		struct UploadContext
+		{
+			// Already begun, it will be ended & submitted by the AssetLoader
+			Ptr<CommandBuffer> commandBuffer;
+			// Kept alive until the upload is finished
+			std::list<Ptr<Buffer>> stagingBuffers;
+		};
+
+		template <typename T>
+		using Loader = std::function<Ptr<T>(UploadContext&)>;
+		template <typename T>
+		using Callback = std::function<void(const Ptr<T>&)>;
+
+		AssetLoader();
+		~AssetLoader();
+
+		// Default AssetLoader instance
+		static AssetLoader& instance();
+
+		// Runs the loader on a worker, then gives the asset to the callback once its upload is finished
+		// The loader must record its GPU commands in the given context
+		// An exception thrown by the loader is rethrown by update()
+		template <typename T>
+		void load(const Loader<T>& loader, const Callback<T>& callback);
+
+		// Convenience versions using ObjLoader & DefaultImageLoader
+		// Settings::commandBuffer & Settings::stagingBuffers are overridden
+		void loadModel(const std::filesystem::path& path, const ModelLoader::Settings& settings, const Callback<Model>& callback);
+		void loadImage(const std::filesystem::path& path, const ImageLoader::Settings& settings, const Callback<Image>& callback);
+
+		// Submits the uploads recorded since the last call, and calls the callbacks of the assets whose upload is finished
+		// Must be called regularly, typically once per frame
+		void update();
+
+		// Waits for every asset to be loaded (calling update() until then)
+		void waitForIdle();
+
+		// Waits for every asset, then releases all GPU objects owned by the loader
+		// Must be called before destroying the Renderer
+		void clear();
+
+		// Number of assets whose callback was not called yet
+		size_t getPendingCount() const noexcept;
+
+	private:
+		struct Job
+		{
+			std::function<Ptr<void>(UploadContext&)> loader;
+			std::function<void(const Ptr<void>&)> callback;
+			Ptr<void> asset;
+			std::exception_ptr exception;
+			size_t threadIndex = 0;
+			UploadContext context;
+		};
+
+		// Uploads submitted together, tracked by a single fence
+		struct Batch
+		{
+			Ptr<Fence> fence;
+			std::vector<Ptr<Job>> jobs;
+		};
+
+		void push(std::function<Ptr<void>(UploadContext&)> loader, std::function<void(const Ptr<void>&)> callback);
+		void run(const Ptr<Job>& job, size_t threadIndex);
+		void release(Job& job);
+
+		std::atomic_size_t m_pendingCount;
+
+		// One pool per worker : a pool is only used by its thread, so command buffers are also released there
+		std::vector<Ptr<CommandPool>> m_commandPools;
+		std::vector<std::vector<Ptr<CommandBuffer>>> m_releasedCommandBuffers;
+
+		std::mutex m_mutex;
+		std::vector<Ptr<Job>> m_recordedJobs;
+
+		std::list<Batch> m_batches;
+	};
+}
+
+#include <Atema/Graphics/AssetLoader.inl>
+
+#endif
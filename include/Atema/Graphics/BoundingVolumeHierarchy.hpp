@@ -0,0 +1,136 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ATEMA_GRAPHICS_BOUNDINGVOLUMEHIERARCHY_HPP
+#define ATEMA_GRAPHICS_BOUNDINGVOLUMEHIERARCHY_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Core/IdManager.hpp>
+#include <Atema/Core/Pointer.hpp>
+#include <Atema/Math/AABB.hpp>
+#include <Atema/Math/Enums.hpp>
+#include <Atema/Math/Frustum.hpp>
+
+#include <vector>
+
+namespace at
+{
+	class Task;
+
+	// Binary AABB tree used to speed up spatial queries (frustum culling, etc)
+	// Elements are identified by a handle given when they are added
+	// Any modification is deferred until the next call to build, which either refits the modified branches or fully rebuilds the tree
+	template <typename T>
+	class BoundingVolumeHierarchy
+	{
+	public:
+		using Handle = size_t;
+
+		static constexpr Handle InvalidHandle = std::numeric_limits<Handle>::max();
+
+		// Maximum number of elements stored in a leaf
+		static constexpr size_t LeafSize = 4;
+
+		// Under this number of elements, the tree is always built on the calling thread
+		static constexpr size_t ParallelBuildThreshold = 1024;
+
+		BoundingVolumeHierarchy();
+		BoundingVolumeHierarchy(const BoundingVolumeHierarchy& other) = default;
+		BoundingVolumeHierarchy(BoundingVolumeHierarchy&& other) noexcept = default;
+		~BoundingVolumeHierarchy() = default;
+
+		Handle add(const T& value, const AABBf& aabb);
+		// Can be called concurrently for different handles : only the element itself is written, no shared list
+		// Updating the same handle several times before build refits it only once
+		void update(Handle handle, const AABBf& aabb);
+		void remove(Handle handle);
+
+		void clear();
+
+		// Applies pending modifications
+		// threadCount : Number of threads the build is allowed to use
+		// 0 means as much as possible
+		void build(size_t threadCount = 1);
+
+		// Calls callback(const T& value, IntersectionType intersectionType) for every element that is not outside the frustum
+		// If a whole branch is inside the frustum, its elements are reported as inside without being tested
+		template <typename Callback>
+		void query(const Frustumf& frustum, Callback&& callback) const;
+
+		size_t getSize() const noexcept;
+
+		// Returns true if some modifications were not applied yet
+		bool isDirty() const noexcept;
+
+		BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy& other) = default;
+		BoundingVolumeHierarchy& operator=(BoundingVolumeHierarchy&& other) noexcept = default;
+
+	private:
+		static constexpr uint32_t InvalidNode = std::numeric_limits<uint32_t>::max();
+
+		struct Element
+		{
+			T value;
+			AABBf aabb;
+			uint32_t node = InvalidNode;
+			bool valid = false;
+			// Per element, so concurrent updates never write to shared data
+			bool dirty = false;
+		};
+
+		// Nodes are stored in depth-first order : the left child of a node is always the next node
+		// Elements of a node's branch are contiguous in m_elementHandles
+		struct Node
+		{
+			AABBf aabb;
+			uint32_t parent;
+			uint32_t rightChild; // 0 for leaves
+			uint32_t firstElement;
+			uint32_t elementCount;
+		};
+
+		static size_t getNodeCount(size_t elementCount);
+
+		void rebuild(size_t threadCount);
+		void refit();
+		void buildNode(uint32_t nodeIndex, uint32_t parentIndex, size_t firstElement, size_t elementCount, size_t parallelDepth, std::vector<Ptr<Task>>* tasks);
+		void updateLeaf(Node& node);
+		void updateInternalNode(Node& node);
+
+		IdManager<Handle> m_idManager;
+		std::vector<Element> m_elements;
+		size_t m_size;
+
+		std::vector<Node> m_nodes;
+		std::vector<Handle> m_elementHandles;
+
+		bool m_rebuild;
+		// Filled during build from the dirty flags of the elements, so every handle appears once
+		// Only written by build, never by update
+		std::vector<Handle> m_dirtyElements;
+		size_t m_refitCount;
+	};
+}
+
+#include <Atema/Graphics/BoundingVolumeHierarchy.inl>
+
+#endif
@@ -0,0 +1,397 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ATEMA_GRAPHICS_BOUNDINGVOLUMEHIERARCHY_INL
+#define ATEMA_GRAPHICS_BOUNDINGVOLUMEHIERARCHY_INL
+
+#include <Atema/Graphics/BoundingVolumeHierarchy.hpp>
+#include <Atema/Core/Error.hpp>
+#include <Atema/Core/TaskManager.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace at
+{
+	template <typename T>
+	BoundingVolumeHierarchy<T>::BoundingVolumeHierarchy() :
+		m_size(0),
+		m_rebuild(false),
+		m_refitCount(0)
+	{
+	}
+
+	template <typename T>
+	typename BoundingVolumeHierarchy<T>::Handle BoundingVolumeHierarchy<T>::add(const T& value, const AABBf& aabb)
+	{
+		const auto handle = m_idManager.get();
+
+		if (handle >= m_elements.size())
+			m_elements.resize(handle + 1);
+
+		auto& element = m_elements[handle];
+		element.value = value;
+		element.aabb = aabb;
+		element.node = InvalidNode;
+		element.valid = true;
+
+		m_size++;
+
+		m_rebuild = true;
+
+		return handle;
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::update(Handle handle, const AABBf& aabb)
+	{
+		ATEMA_ASSERT(handle < m_elements.size() && m_elements[handle].valid, "Invalid handle");
+
+		auto& element = m_elements[handle];
+		element.aabb = aabb;
+
+		// Elements not yet in the tree will be inserted during the next rebuild
+		if (element.node != InvalidNode)
+			element.dirty = true;
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::remove(Handle handle)
+	{
+		ATEMA_ASSERT(handle < m_elements.size() && m_elements[handle].valid, "Invalid handle");
+
+		m_elements[handle] = Element();
+
+		m_idManager.release(handle);
+
+		m_size--;
+
+		m_rebuild = true;
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::clear()
+	{
+		m_idManager = IdManager<Handle>();
+		m_elements.clear();
+		m_size = 0;
+		m_nodes.clear();
+		m_elementHandles.clear();
+		m_rebuild = false;
+		m_dirtyElements.clear();
+		m_refitCount = 0;
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::build(size_t threadCount)
+	{
+		if (!m_rebuild)
+		{
+			m_dirtyElements.clear();
+
+			for (Handle handle = 0; handle < m_elements.size(); handle++)
+			{
+				if (m_elements[handle].dirty)
+					m_dirtyElements.emplace_back(handle);
+			}
+
+			// Refitting keeps the topology of the tree, so its quality decreases as elements move
+			// Once the tree was refitted as many times as it has elements, rebuild it from scratch
+			if (m_refitCount + m_dirtyElements.size() > m_size)
+				m_rebuild = true;
+		}
+
+		if (m_rebuild)
+			rebuild(threadCount);
+		else if (!m_dirtyElements.empty())
+			refit();
+	}
+
+	template <typename T>
+	template <typename Callback>
+	void BoundingVolumeHierarchy<T>::query(const Frustumf& frustum, Callback&& callback) const
+	{
+		if (m_nodes.empty())
+			return;
+
+		// Median splits keep the depth around log2(size / LeafSize)
+		std::array<uint32_t, 64> stack;
+		size_t stackSize = 0;
+
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const auto& node = m_nodes[stack[--stackSize]];
+
+			const auto intersectionType = frustum.getIntersectionType(node.aabb);
+
+			if (intersectionType == IntersectionType::Outside)
+				continue;
+
+			// The whole branch is visible : no need to test its elements
+			if (intersectionType == IntersectionType::Inside)
+			{
+				for (size_t i = node.firstElement; i < node.firstElement + node.elementCount; i++)
+					callback(m_elements[m_elementHandles[i]].value, IntersectionType::Inside);
+			}
+			// Leaf : test every element
+			else if (node.rightChild == 0)
+			{
+				for (size_t i = node.firstElement; i < node.firstElement + node.elementCount; i++)
+				{
+					const auto& element = m_elements[m_elementHandles[i]];
+
+					const auto elementIntersectionType = frustum.getIntersectionType(element.aabb);
+
+					if (elementIntersectionType != IntersectionType::Outside)
+						callback(element.value, elementIntersectionType);
+				}
+			}
+			// Internal node : test children
+			else
+			{
+				stack[stackSize++] = node.rightChild;
+				stack[stackSize++] = static_cast<uint32_t>(&node - m_nodes.data()) + 1;
+			}
+		}
+	}
+
+	template <typename T>
+	size_t BoundingVolumeHierarchy<T>::getSize() const noexcept
+	{
+		return m_size;
+	}
+
+	template <typename T>
+	bool BoundingVolumeHierarchy<T>::isDirty() const noexcept
+	{
+		if (m_rebuild)
+			return true;
+
+		return std::any_of(m_elements.begin(), m_elements.end(), [](const Element& element)
+			{
+				return element.dirty;
+			});
+	}
+
+	template <typename T>
+	size_t BoundingVolumeHierarchy<T>::getNodeCount(size_t elementCount)
+	{
+		// Splits are always done at the median, so the layout of a branch only depends on its element count
+		if (elementCount <= LeafSize)
+			return 1;
+
+		const auto leftCount = elementCount / 2;
+
+		return 1 + getNodeCount(leftCount) + getNodeCount(elementCount - leftCount);
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::rebuild(size_t threadCount)
+	{
+		m_rebuild = false;
+		m_dirtyElements.clear();
+		m_refitCount = 0;
+
+		m_elementHandles.clear();
+		m_elementHandles.reserve(m_size);
+
+		for (Handle handle = 0; handle < m_elements.size(); handle++)
+		{
+			auto& element = m_elements[handle];
+
+			element.dirty = false;
+
+			if (element.valid)
+				m_elementHandles.emplace_back(handle);
+		}
+
+		m_nodes.clear();
+
+		if (m_elementHandles.empty())
+			return;
+
+		m_nodes.resize(getNodeCount(m_elementHandles.size()));
+
+		const auto maxThreadCount = TaskManager::instance().getSize();
+		if (threadCount == 0 || threadCount > maxThreadCount)
+			threadCount = maxThreadCount;
+
+		if (threadCount <= 1 || m_elementHandles.size() < ParallelBuildThreshold)
+		{
+			buildNode(0, InvalidNode, 0, m_elementHandles.size(), 0, nullptr);
+		}
+		else
+		{
+			// The first levels are split on this thread, then each branch at parallelDepth is built by a task
+			size_t parallelDepth = 0;
+			while ((static_cast<size_t>(1) << parallelDepth) < threadCount)
+				parallelDepth++;
+
+			std::vector<Ptr<Task>> tasks;
+			tasks.reserve(static_cast<size_t>(1) << parallelDepth);
+
+			buildNode(0, InvalidNode, 0, m_elementHandles.size(), parallelDepth, &tasks);
+
+			for (auto& task : tasks)
+				task->wait();
+
+			// Nodes above parallelDepth were created before their children were built
+			// Children are always stored after their parent, so a reverse traversal updates them in the right order
+			for (auto it = m_nodes.rbegin(); it != m_nodes.rend(); ++it)
+			{
+				if (it->rightChild != 0 && it->aabb.min.x > it->aabb.max.x)
+					updateInternalNode(*it);
+			}
+		}
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::refit()
+	{
+		m_refitCount += m_dirtyElements.size();
+
+		for (const auto handle : m_dirtyElements)
+		{
+			auto& element = m_elements[handle];
+
+			element.dirty = false;
+
+			auto nodeIndex = element.node;
+
+			updateLeaf(m_nodes[nodeIndex]);
+
+			nodeIndex = m_nodes[nodeIndex].parent;
+
+			while (nodeIndex != InvalidNode)
+			{
+				auto& node = m_nodes[nodeIndex];
+
+				updateInternalNode(node);
+
+				nodeIndex = node.parent;
+			}
+		}
+
+		m_dirtyElements.clear();
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::buildNode(uint32_t nodeIndex, uint32_t parentIndex, size_t firstElement, size_t elementCount, size_t parallelDepth, std::vector<Ptr<Task>>* tasks)
+	{
+		auto& node = m_nodes[nodeIndex];
+		node.aabb = AABBf();
+		node.parent = parentIndex;
+		node.rightChild = 0;
+		node.firstElement = static_cast<uint32_t>(firstElement);
+		node.elementCount = static_cast<uint32_t>(elementCount);
+
+		if (elementCount <= LeafSize)
+		{
+			for (size_t i = firstElement; i < firstElement + elementCount; i++)
+				m_elements[m_elementHandles[i]].node = nodeIndex;
+
+			updateLeaf(node);
+
+			return;
+		}
+
+		// Split along the largest axis of the centers' bounds
+		AABBf centerAABB;
+		for (size_t i = firstElement; i < firstElement + elementCount; i++)
+			centerAABB.extend(m_elements[m_elementHandles[i]].aabb.getCenter());
+
+		const auto centerSize = centerAABB.getSize();
+
+		size_t axis = 0;
+		if (centerSize.y > centerSize[axis])
+			axis = 1;
+		if (centerSize.z > centerSize[axis])
+			axis = 2;
+
+		const auto leftCount = elementCount / 2;
+		const auto begin = m_elementHandles.begin() + firstElement;
+
+		std::nth_element(begin, begin + leftCount, begin + elementCount, [this, axis](Handle a, Handle b)
+			{
+				const auto& aabbA = m_elements[a].aabb;
+				const auto& aabbB = m_elements[b].aabb;
+
+				return aabbA.min[axis] + aabbA.max[axis] < aabbB.min[axis] + aabbB.max[axis];
+			});
+
+		const auto leftIndex = nodeIndex + 1;
+		const auto rightIndex = static_cast<uint32_t>(leftIndex + getNodeCount(leftCount));
+
+		node.rightChild = rightIndex;
+
+		const std::array<uint32_t, 2> childIndices = { leftIndex, rightIndex };
+		const std::array<size_t, 2> childFirstElements = { firstElement, firstElement + leftCount };
+		const std::array<size_t, 2> childElementCounts = { leftCount, elementCount - leftCount };
+
+		for (size_t i = 0; i < 2; i++)
+		{
+			const auto childIndex = childIndices[i];
+			const auto childFirstElement = childFirstElements[i];
+			const auto childElementCount = childElementCounts[i];
+
+			if (tasks && parallelDepth <= 1)
+			{
+				auto task = TaskManager::instance().createTask([this, childIndex, nodeIndex, childFirstElement, childElementCount]()
+					{
+						buildNode(childIndex, nodeIndex, childFirstElement, childElementCount, 0, nullptr);
+					});
+
+				tasks->emplace_back(std::move(task));
+			}
+			else
+			{
+				buildNode(childIndex, nodeIndex, childFirstElement, childElementCount, parallelDepth - 1, tasks);
+			}
+		}
+
+		// The AABB of the node will be updated once the tasks are finished
+		if (!tasks)
+			updateInternalNode(node);
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::updateLeaf(Node& node)
+	{
+		node.aabb = AABBf();
+
+		for (size_t i = node.firstElement; i < node.firstElement + node.elementCount; i++)
+			node.aabb.extend(m_elements[m_elementHandles[i]].aabb);
+	}
+
+	template <typename T>
+	void BoundingVolumeHierarchy<T>::updateInternalNode(Node& node)
+	{
+		const auto nodeIndex = static_cast<uint32_t>(&node - m_nodes.data());
+
+		node.aabb = m_nodes[nodeIndex + 1].aabb;
+		node.aabb.extend(m_nodes[node.rightChild].aabb);
+	}
+}
+
+#endif
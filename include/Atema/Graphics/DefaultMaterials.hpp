@@ -38,6 +38,15 @@ namespace at
 
 		static Ptr<Material> getPBR(const MaterialData& materialData);
 		static Ptr<MaterialInstance> getPBRInstance(const MaterialData& materialData);
+
+		// Loads the textures of every material at once, decoding them in parallel (see Graphics::getImages)
+		// Meant to be called just before creating the instances of a model's materials, which then find their textures loaded
+		// Does nothing if TextureStreamer is enabled : it already loads the textures on TaskManager workers
+		static void loadTextures(const std::vector<Ptr<MaterialData>>& materialData);
+
+		// Checks if the vertices follow DefaultVertexFormat::XYZ_UV_NT_Quantized (see MaterialData::QuantizedVertex)
+		// Works with the MaterialData given to the functions above, and with the metadata of the materials they return
+		static bool useQuantizedVertex(const MaterialData& materialData);
 	};
 }
 
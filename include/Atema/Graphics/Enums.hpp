@@ -59,6 +59,7 @@ namespace at
 	// XYZ : position
 	// UV : texture coordinates
 	// NTB : normal / tangent / bitangent
+	// Quantized : snorm16 position & unorm16 UV (dequantized per mesh), octahedral normal & tangent (with the bitangent sign)
 	enum class DefaultVertexFormat
 	{
 		XY,
@@ -77,7 +78,8 @@ namespace at
 		XYZ_UV,
 		XYZ_UV_N,
 		XYZ_UV_NT,
-		XYZ_UV_NTB
+		XYZ_UV_NTB,
+		XYZ_UV_NT_Quantized
 	};
 
 	enum class LightType
@@ -57,6 +57,12 @@ namespace at
 		void setExposure(float exposure);
 		void setGamma(float gamma);
 
+		// Maximum projected error of the LODs drawn in the GBuffer, in pixels (default : 1)
+		void setLodThreshold(float pixels);
+		// Maximum error of the LODs drawn in the shadow maps, in texels of each cascade (default : 2)
+		// Shadow maps tolerate coarser LODs than the GBuffer
+		void setShadowLodBias(float texels);
+
 		FrameRenderer& operator=(const FrameRenderer& other) = delete;
 		FrameRenderer& operator=(FrameRenderer&& other) noexcept = default;
 
@@ -110,6 +116,9 @@ namespace at
 		float m_exposure;
 		float m_gamma;
 
+		float m_lodThreshold;
+		float m_shadowLodBias;
+
 		// Shadows
 		std::unordered_map<const RenderLight*, Ptr<ShadowPassData>> m_shadowData;
 
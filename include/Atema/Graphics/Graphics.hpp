@@ -23,16 +23,21 @@
 #define ATEMA_GRAPHICS_GRAPHICS_HPP
 
 #include <Atema/Core/IdManager.hpp>
+#include <Atema/Core/TaskManager.hpp>
 #include <Atema/Graphics/Config.hpp>
 #include <Atema/Shader/UberShader.hpp>
 #include <Atema/Renderer/Sampler.hpp>
 #include <Atema/Renderer/Shader.hpp>
 #include <Atema/Renderer/GraphicsPipeline.hpp>
 #include <Atema/Graphics/Loaders/ImageLoader.hpp>
+#include <Atema/Shader/ShaderLibraryBundle.hpp>
 #include <Atema/Shader/ShaderLibraryManager.hpp>
 #include <Atema/Core/Signal.hpp>
 #include <Atema/Graphics/LightingModel.hpp>
 
+#include <atomic>
+#include <exception>
+
 namespace at
 {
 	class VertexBuffer;
@@ -62,6 +67,18 @@ namespace at
 		// Initializes ShaderLibraryManager with built-in shader libraries
 		void initializeShaderLibraries(ShaderLibraryManager& libraryManager);
 
+		// Loads precompiled ASTs (see ShaderLibraryBundle), usually before initializeShaderLibraries
+		// ATSL sources found in the bundle are not parsed anymore
+		// Returns false if the bundle does not exist or is outdated, in which case sources are parsed as usual
+		bool loadShaderBundle(const std::filesystem::path& path);
+		// Writes the loaded bundle along with the ASTs of every ATSL source that had to be parsed by this instance
+		// Does nothing if every source was found in the loaded bundle
+		void saveShaderBundle(const std::filesystem::path& path);
+
+		// Returns the AST of some ATSL code, taken from the loaded bundle when possible
+		// Used for built-in libraries, UberShaders created from strings or ATSL files and GBuffer libraries
+		UPtr<SequenceStatement> createShaderAst(const std::string& name, const std::string& atslCode);
+
 		void addLightingModel(const LightingModel& lightingModel);
 
 		const LightingModel& getLightingModel(const std::string& name) const;
@@ -115,12 +132,34 @@ namespace at
 
 		Ptr<GraphicsPipeline> getGraphicsPipeline(const GraphicsPipeline::Settings& settings);
 		
-		Ptr<Image> getImage(const std::filesystem::path& path, const ImageLoader::Settings& settings = {});
+		// Settings used by getImage when none are given, typically to compress the textures of every material
+		void setDefaultImageSettings(const ImageLoader::Settings& settings);
+		const ImageLoader::Settings& getDefaultImageSettings() const noexcept;
+
+		Ptr<Image> getImage(const std::filesystem::path& path);
+		Ptr<Image> getImage(const std::filesystem::path& path, const ImageLoader::Settings& settings);
+		// Same as getImage for several images : the missing ones are decoded in parallel (see DefaultImageLoader)
+		std::vector<Ptr<Image>> getImages(const std::vector<std::filesystem::path>& paths, const ImageLoader::Settings& settings);
 
 		Ptr<Sampler> getSampler(const Sampler::Settings& settings);
 
 		Ptr<Material> getMaterial(const UberShader& uberShader, const MaterialData& metaData = {});
 
+		// Asynchronous versions of the corresponding getters
+		// If the resource already exists it is returned immediately
+		// Otherwise its creation is scheduled once on TaskManager workers and nullptr is returned
+		// The user must call the method again later (typically on the next frame) until a valid resource is returned
+		// Dependencies (base UberShader, ShaderLibraryManager, shaders of the pipeline) must stay alive while the resource is pending
+		// Calling the synchronous getter on a pending resource waits for the worker instead of creating the resource twice
+		Ptr<UberShader> getUberShaderAsync(const UberShader& baseUberShader, const std::vector<UberShader::Option>& options, const ShaderLibraryManager* shaderLibraryManager = nullptr);
+		Ptr<Shader> getShaderAsync(const UberShader& uberShader);
+		Ptr<GraphicsPipeline> getGraphicsPipelineAsync(const GraphicsPipeline::Settings& settings);
+
+		// Returns true if some resources are being created asynchronously
+		bool isLoadingAsync() const;
+		// Waits for every pending asynchronous creation to be finished
+		void waitAsync();
+
 	private:
 		struct UberInstanceSettings
 		{
@@ -177,13 +216,58 @@ namespace at
 			ConnectionGuard connectionGuard;
 		};
 
+		template <typename T, typename Key>
+		struct AsyncLoad
+		{
+			using Loader = std::function<Ptr<T>()>;
+
+			// Hashes may collide : the key is compared on lookup
+			Key key;
+			Ptr<Task> task;
+			Ptr<T> resource;
+			std::exception_ptr exception;
+			std::atomic_bool finished{ false };
+			// Set by each lookup, reset by clearUnused
+			bool requested = true;
+			// Keeps source resources alive while the task is running
+			Ptr<const void> dependency;
+		};
+
+		template <typename T, typename Key>
+		using AsyncLoadMap = std::unordered_map<StdHash, Ptr<AsyncLoad<T, Key>>>;
+
+		// UberInstanceSettings only references the options, pending loads need their own copy
+		struct UberInstanceKey
+		{
+			const UberShader* uberShader;
+			const ShaderLibraryManager* shaderLibraryManager;
+			std::vector<UberShader::Option> options;
+		};
+
+		static bool isSameKey(const UberInstanceKey& key1, const UberInstanceKey& key2);
+		static bool isSameKey(const UberShader* key1, const UberShader* key2);
+		static bool isSameKey(const GraphicsPipeline::Settings& key1, const GraphicsPipeline::Settings& key2);
+
+		// Starts the asynchronous creation if needed and returns true once the resource is available
+		// If another resource with the same hash is pending, returns true so the caller creates the resource synchronously
+		template <typename T, typename Key>
+		static bool loadAsync(AsyncLoadMap<T, Key>& asyncLoads, StdHash hash, const Key& key, const Ptr<const void>& dependency, const typename AsyncLoad<T, Key>::Loader& loader);
+		// Removes a pending resource and returns it once created, or nullptr if there is no such resource
+		template <typename T, typename Key>
+		static Ptr<T> takeAsync(AsyncLoadMap<T, Key>& asyncLoads, StdHash hash, const Key& key);
+		template <typename T, typename Key>
+		static void waitAsyncLoads(AsyncLoadMap<T, Key>& asyncLoads);
+		// Removes the finished resources nobody requested since the last call (their owner was destroyed while they were created)
+		template <typename T, typename Key>
+		static void clearUnusedAsyncLoads(AsyncLoadMap<T, Key>& asyncLoads);
+
 		Ptr<UberShader> loadUberShader(const std::filesystem::path& path);
 		Ptr<UberShader> loadUberInstance(const UberInstanceSettings& settings);
 		Ptr<UberShader> loadUberStage(const UberStageSettings& settings);
 		Ptr<Shader> loadShader(const UberShader& uberShader);
 		Ptr<DescriptorSetLayout> loadDescriptorSetLayout(const DescriptorSetLayout::Settings& settings);
 		Ptr<GraphicsPipeline::Settings> loadGraphicsPipelineSettings(const GraphicsPipelineSettings& settings);
-		static Ptr<GraphicsPipeline> loadGraphicsPipeline(const GraphicsPipeline::Settings& settings);
+		Ptr<GraphicsPipeline> loadGraphicsPipeline(const GraphicsPipeline::Settings& settings);
 		static Ptr<Image> loadImage(const ImageSettings& settings);
 		static Ptr<Sampler> loadSampler(const Sampler::Settings& settings);
 		Ptr<Material> loadMaterial(const MaterialSettings& settings);
@@ -225,6 +309,16 @@ namespace at
 		std::unordered_map<Material*, Ptr<UberShader>> m_materialToUber;
 
 		std::unordered_map<const void*, Ptr<ResourceHandle>> m_resourceHandles;
+
+		ImageLoader::Settings m_defaultImageSettings;
+
+		AsyncLoadMap<UberShader, UberInstanceKey> m_asyncUberInstances;
+		AsyncLoadMap<Shader, const UberShader*> m_asyncShaders;
+		AsyncLoadMap<GraphicsPipeline, GraphicsPipeline::Settings> m_asyncGraphicsPipelines;
+
+		ShaderLibraryBundle m_shaderBundle;
+		// ASTs created from sources missing in m_shaderBundle, written by saveShaderBundle
+		ShaderLibraryBundle m_parsedShaderBundle;
 	};
 }
 
@@ -24,8 +24,10 @@
 
 #include <Atema/Graphics/Config.hpp>
 #include <Atema/Graphics/Loaders/ImageLoader.hpp>
+#include <Atema/Graphics/Loaders/TextureCache.hpp>
 
 #include <filesystem>
+#include <vector>
 
 namespace at
 {
@@ -33,6 +35,18 @@ namespace at
 	{
 		static Ptr<Image> load(const std::filesystem::path& path, const ImageLoader::Settings& settings);
 		static Ptr<Image> load(const uint8_t* data, size_t size, const ImageLoader::Settings& settings);
+		// Loads distinct images at once : files are decoded & their mip chains built on the CPU in parallel (see loadMipChain)
+		// Only the uploads stay on the calling thread, and the images are returned in the order of the paths
+		// Images the CPU path can't handle (HDR, unsupported settings or formats) are loaded one after the other like above
+		static std::vector<Ptr<Image>> load(const std::vector<std::filesystem::path>& paths, const ImageLoader::Settings& settings);
+		// Builds the mip chain of an 8 bit image on the CPU, compressed if the device supports the settings' compression
+		// The chain is taken from or saved to ImageLoader::Settings::cacheDirectory, if set
+		// Only the levels starting from firstMipLevel are returned, and only them are read from the cache
+		// Returns false if the format is not supported, for HDR images or if firstMipLevel is not a level of the chain
+		static bool loadMipChain(const std::filesystem::path& path, const ImageLoader::Settings& settings, ImageLoader::MipChain& mipChain, uint32_t firstMipLevel = 0);
+		// Same as above, only describing the whole chain
+		// The chain is built (and cached if possible) if it is not in the cache yet
+		static bool loadMipChainInfo(const std::filesystem::path& path, const ImageLoader::Settings& settings, TextureCache::Info& info);
 		static bool isExtensionSupported(const std::filesystem::path& extension);
 	};
 }
@@ -25,7 +25,9 @@
 #include <Atema/Graphics/Config.hpp>
 #include <Atema/Renderer/Image.hpp>
 
+#include <filesystem>
 #include <list>
+#include <vector>
 
 namespace at
 {
@@ -41,6 +43,37 @@ namespace at
 			RGB,
 			RGBA
 		};
+
+		// Block compression applied by the loaders to 8 bit images (see TextureCompressor)
+		// Mip levels are then generated on the CPU, and formats not supported by the device fall back to uncompressed ones
+		enum class Compression
+		{
+			None,
+			// BC4 (R), BC5 (RG), BC1 (RGB) & BC3 (RGBA)
+			Compact,
+			// BC4 (R), BC5 (RG) & BC7 (RGB & RGBA) : RGB images are twice as big as with Compact, with a better quality
+			HighQuality
+		};
+
+		// Filter used when mip levels are built on the CPU (see TextureCompressor)
+		enum class MipFilter
+		{
+			// Average of 2x2 pixels
+			Box,
+			// Kaiser-windowed sinc over 6x6 pixels : sharper levels, slower to build
+			Kaiser
+		};
+
+		// Image whose mip levels are already built, possibly block-compressed
+		// Level i has a size of max(width >> i, 1) x max(height >> i, 1) and starts at data[mipOffsets[i]]
+		struct MipChain
+		{
+			ImageFormat format = ImageFormat::RGBA8_UNORM;
+			uint32_t width = 0;
+			uint32_t height = 0;
+			std::vector<size_t> mipOffsets;
+			std::vector<uint8_t> data;
+		};
 		
 		struct Settings
 		{
@@ -57,6 +90,19 @@ namespace at
 			// - ImageUsage::TransferSrc will be added if mipLevels != 1
 			Flags<ImageUsage> usages = ImageUsage::ShaderSampling;
 
+			// Only used by loaders decoding files (see DefaultImageLoader)
+			Compression compression = Compression::None;
+
+			// Only used for mip levels built on the CPU (compressed images & DefaultImageLoader batches)
+			MipFilter mipFilter = MipFilter::Box;
+
+			// Color channels hold sRGB values (base color maps for example) : CPU mip levels are then filtered in linear space
+			// Alpha is always filtered as is, and the image format stays UNORM
+			bool srgb = false;
+
+			// Optional directory where compressed mip chains are kept between runs (see TextureCache)
+			std::filesystem::path cacheDirectory;
+
 			// Optional command buffer
 			// If valid:
 			//	- it will be used if there are staging buffers to copy to images (ie if image is not mappable)
@@ -78,6 +124,9 @@ namespace at
 		// Load specific images without limits for the channel color range
 		// Can be used to load HDR textures
 		static Ptr<Image> loadImage(const float* data, uint32_t width, uint32_t height, Format format, const Settings& settings);
+		// Uploads every level of the chain as is, without any GPU mip generation
+		// Settings::type must be ImageType::Image2D, Settings::mipLevels is ignored
+		static Ptr<Image> loadImage(const MipChain& mipChain, const Settings& settings);
 
 		static ImageFormat getSupportedColorFormat(Format format, Flags<ImageUsage> usages);
 		static ImageFormat getSupportedHDRFormat(Format format, Flags<ImageUsage> usages);
@@ -0,0 +1,83 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_GRAPHICS_MESHOPTIMIZER_HPP
+#define ATEMA_GRAPHICS_MESHOPTIMIZER_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Graphics/Loaders/ModelLoader.hpp>
+
+#include <vector>
+
+namespace at
+{
+	// Reorders triangles & vertices of indexed triangle lists to reduce the vertex processing cost on the GPU
+	// Every function keeps the rendered result identical (same triangles with the same winding)
+	struct ATEMA_GRAPHICS_API MeshOptimizer
+	{
+		struct VertexCacheStatistics
+		{
+			// Average cache miss ratio : transformed vertices per triangle (0.5 is optimal on big grids, 3 is the worst)
+			float acmr = 0.0f;
+
+			// Average transform to vertex ratio : transformed vertices per referenced vertex (1 is optimal)
+			float atvr = 0.0f;
+		};
+
+		// FIFO cache size used to compute the statistics & the overdraw clusters
+		static constexpr size_t DefaultCacheSize = 16;
+
+		// Meshlet limits, matching the usual mesh shader limits
+		static constexpr size_t DefaultMeshletVertexCount = 64;
+		static constexpr size_t DefaultMeshletTriangleCount = 124;
+
+		// Reorders triangles to maximize the post-transform vertex cache hits (Forsyth's linear-speed algorithm)
+		static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+		// Reorders clusters of triangles so the ones likely to occlude the others are drawn first
+		// Indices must already be optimized for the vertex cache : clusters are split where the cache is flushed, so the ACMR is barely changed
+		static void optimizeOverdraw(const std::vector<ModelLoader::StaticVertex>& vertices, std::vector<uint32_t>& indices);
+
+		// Reorders vertices by first use in the index buffer to improve the vertex fetch locality, and remaps the indices
+		// Unreferenced vertices are removed
+		static void optimizeVertexFetch(std::vector<ModelLoader::StaticVertex>& vertices, std::vector<uint32_t>& indices);
+
+		// Applies every optimization above, in order
+		static void optimize(std::vector<ModelLoader::StaticVertex>& vertices, std::vector<uint32_t>& indices);
+
+		// Splits the mesh into meshlets of at most maxVertexCount unique vertices & maxTriangleCount triangles
+		// Triangles are reordered so each meshlet is contiguous in the index buffer, vertices are left untouched
+		// Meshlets are grown from connected triangles to keep their bounds tight for the cluster culling
+		static std::vector<Meshlet> buildMeshlets(const std::vector<ModelLoader::StaticVertex>& vertices, std::vector<uint32_t>& indices, size_t maxVertexCount = DefaultMeshletVertexCount, size_t maxTriangleCount = DefaultMeshletTriangleCount);
+
+		// Simplifies the mesh with edge collapses ordered by their quadric error, onto existing vertices
+		// Returns the new indices, using the same vertices : the simplification stops once targetIndexCount is reached,
+		// or when the next collapse would move the surface further than maxError (mesh space)
+		// Vertices on borders & attribute seams are locked, so the outline & the texture mapping are preserved
+		// error receives the largest collapse error (distance to the original surface planes), in mesh space
+		static std::vector<uint32_t> simplify(const std::vector<ModelLoader::StaticVertex>& vertices, const std::vector<uint32_t>& indices, size_t targetIndexCount, float maxError, float& error);
+
+		// Simulates a FIFO post-transform cache of size cacheSize
+		static VertexCacheStatistics getVertexCacheStatistics(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize = DefaultCacheSize);
+	};
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ATEMA_GRAPHICS_MODELCACHE_HPP
+#define ATEMA_GRAPHICS_MODELCACHE_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Core/Hash.hpp>
+#include <Atema/Graphics/Loaders/ModelLoader.hpp>
+
+#include <filesystem>
+#include <vector>
+
+namespace at
+{
+	class Model;
+
+	// Binary container storing models as they are sent to the GPU : interleaved vertices & indices, AABBs and material data
+	// The file is memory mapped when loading, so each buffer is filled with a single copy and nothing is processed anymore
+	// A file is identified by a key, built from the source model and the loader settings
+	struct ATEMA_GRAPHICS_API ModelCache
+	{
+		// Hashes the content of the source file and every setting changing the loader output
+		// For OBJ files, the content of the material libraries and the timestamps of their textures are hashed too
+		static Hash64 getKey(const std::filesystem::path& sourcePath, const ModelLoader::Settings& settings);
+
+		// meshData must be the output of the loader (see ModelLoader::Settings::meshData), with one element per mesh of the model
+		// The file is written under a temporary name then renamed, so an interrupted save never leaves a partial file
+		static void save(const std::filesystem::path& path, Hash64 key, const Model& model, const std::vector<ModelLoader::MeshData>& meshData);
+
+		// Returns nullptr if the file does not exist, is incomplete or was saved with another key
+		// The settings must be the ones used to get the key (only the buffer related settings are used here)
+		static Ptr<Model> load(const std::filesystem::path& path, Hash64 key, const ModelLoader::Settings& settings);
+	};
+}
+
+#endif
@@ -23,8 +23,10 @@
 #define ATEMA_GRAPHICS_MESHLOADERSETTINGS_HPP
 
 #include <Atema/Graphics/Config.hpp>
+#include <Atema/Graphics/Mesh.hpp>
 #include <Atema/Graphics/VertexFormat.hpp>
 #include <Atema/Core/Pointer.hpp>
+#include <Atema/Math/AABB.hpp>
 #include <Atema/Math/Matrix.hpp>
 #include <Atema/Renderer/Enums.hpp>
 
@@ -35,7 +37,6 @@
 namespace at
 {
 	class CommandBuffer;
-	class Mesh;
 	class Buffer;
 
 	struct ATEMA_GRAPHICS_API ModelLoader
@@ -51,12 +52,28 @@ namespace at
 			bool operator==(const StaticVertex& other) const;
 		};
 
+		// Vertices & indices in their final layout, as copied to the GPU buffers
+		// Vertices follow Settings::getVertexFormat() and indices follow indexType
+		// quantization is required to decode the normalized components, if any
+		// meshlets is empty unless Settings::buildMeshlets is true, lods is empty unless several LODs were generated
+		struct MeshData
+		{
+			std::vector<uint8_t> vertices;
+			std::vector<uint8_t> indices;
+			IndexType indexType = IndexType::U32;
+			VertexQuantization quantization;
+			std::vector<Meshlet> meshlets;
+			std::vector<MeshLod> lods;
+			// See Mesh::getTexCoordsDensity
+			float texCoordsDensity = 0.0f;
+		};
+
 		class ATEMA_GRAPHICS_API Settings
 		{
 		public:
 			Settings() = delete;
 			// Vertex format is assigned to the vertex buffer
-			// Each vertex component must be at least 32-bits floating points components, except for Color and UserData
+			// Each vertex component must be made of floating points (16, 32 or 64 bits) or normalized integers, except for Color and UserData
 			// Each vertex component is filled as if it were an array of size N, N being VertexInput::getElementSize()
 			// Position is the only required component
 			// Position (XYZ if N = 3 / XYZW with W = 1 if N = 4)
@@ -64,6 +81,12 @@ namespace at
 			// Normal (XYZ if N = 3 / XYZW with W = 0 if N = 4)
 			// Tangent (XYZ if N = 3 / XYZW with W = 0 if N = 4)
 			// Bitangent (XYZ if N = 3 / XYZW with W = 0 if N = 4)
+			// Normalized components are encoded (see Mesh::getVertexQuantization() to decode them) :
+			// Position (snorm only) : relative to the mesh AABB center, divided by its largest half size
+			// TexCoords : mapped from the mesh UV range to [0,1] (unorm) or [-1,1] (snorm)
+			// Normal (snorm only) : octahedral encoding in XY
+			// Tangent (snorm only) : octahedral encoding in XY, bitangent sign in Z if N >= 3 (bitangent = sign * cross(normal, tangent))
+			// Bitangent can't be normalized, the quantized formats are expected to rebuild it from the tangent sign
 			Settings(const VertexFormat& vertexFormat);
 			Settings(const Settings& other) = default;
 			Settings(Settings&& other) noexcept = default;
@@ -90,6 +113,21 @@ namespace at
 			// If set, the loader will transform position/normal/tangent/bitangent components
 			std::optional<Matrix4f> vertexTransformation;
 
+			// Optional mesh optimization (see MeshOptimizer)
+			// If true, triangles are reordered for the vertex cache & overdraw, then vertices for the fetch locality
+			bool optimizeMesh = false;
+
+			// Optional meshlet generation (see MeshOptimizer::buildMeshlets & Mesh::getMeshlets)
+			// If true, triangles are grouped in small clusters that the render passes can cull individually
+			// Done after the mesh optimization, which only keeps its vertex fetch order
+			bool buildMeshlets = false;
+
+			// Optional levels of detail (see MeshOptimizer::simplify & Mesh::getLods)
+			// Number of LODs including the original mesh, each one targeting lodTriangleRatio times the triangles of the previous one
+			// The chain stops early when a mesh can't be simplified enough anymore
+			size_t lodCount = 1;
+			float lodTriangleRatio = 0.5f;
+
 			// Optional root for material textures
 			std::filesystem::path textureDir;
 
@@ -108,23 +146,35 @@ namespace at
 			// See 'commandBuffer' member for more details
 			std::list<Ptr<Buffer>>* stagingBuffers;
 
+			// Optional output list receiving the final data of every mesh created by the loader, in creation order
+			// It can be used to save models in a format that does not need any processing anymore (see ModelCache)
+			std::vector<MeshData>* meshData;
+
 		private:
 			void ensureVertexFormatValid() const;
 
 			VertexFormat m_vertexFormat;
 		};
 
-		// Generate tangents and bitangeants
-		// As they are coherent inside each triangle, the vertex count may be different
-		// Generated vertices are unique (no need to remove duplicates)
+		// Generate tangents and bitangeants on an indexed mesh, matching MikkTSpace (so normal maps baked with it are shaded correctly)
+		// Vertices are split when their triangles are not in the same fan with the same UV orientation (like mirrored UVs)
+		// The bitangent is sign * cross(normal, tangent), with the sign of the UV orientation
+		// Degenerate triangles (without any area) are removed
 		// Indices are considered to define triangles
 		static void generateTangents(std::vector<StaticVertex>& vertices, std::vector<uint32_t>& indices);
 
-		// Remove duplicate vertices and compute the new indices
+		// Remove duplicate vertices (bitwise identical) and remap the indices accordingly
 		static void removeDuplicates(std::vector<StaticVertex>& vertices, std::vector<uint32_t>& indices);
 
 		// Process vertices & indices if required by the settings, then creates a mesh
 		static Ptr<Mesh> loadMesh(std::vector<StaticVertex>& vertices, std::vector<uint32_t>& indices, const Settings& settings);
+
+		// Creates a mesh from data already in its final layout, without any processing
+		// vertexData contains vertexCount vertices following the vertex format of the settings
+		// indexData contains indexCount indices of type indexType (Settings::indexType is ignored)
+		// quantization is the one used to encode the vertices (see MeshData)
+		// Settings::meshData is ignored
+		static Ptr<Mesh> loadMesh(const void* vertexData, size_t vertexCount, const void* indexData, size_t indexCount, IndexType indexType, const AABBf& aabb, const VertexQuantization& quantization, const Settings& settings);
 	};
 }
 
@@ -0,0 +1,65 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_GRAPHICS_TEXTURECACHE_HPP
+#define ATEMA_GRAPHICS_TEXTURECACHE_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Core/Hash.hpp>
+#include <Atema/Graphics/Loaders/ImageLoader.hpp>
+
+#include <filesystem>
+
+namespace at
+{
+	// Binary container storing mip chains as they are uploaded, typically block-compressed by TextureCompressor
+	// It avoids decoding, filtering & compressing the source image again on later loads
+	// A file is identified by a key, built from the source image and the compression settings
+	struct ATEMA_GRAPHICS_API TextureCache
+	{
+		// Description of the stored mip chain
+		struct Info
+		{
+			ImageFormat format = ImageFormat::RGBA8_UNORM;
+			uint32_t width = 0;
+			uint32_t height = 0;
+			uint32_t mipLevels = 0;
+		};
+
+		// Hashes the content of the source file, the compression actually applied & the mip settings (levels, filter, sRGB)
+		static Hash64 getKey(const std::filesystem::path& sourcePath, ImageLoader::Compression compression, const ImageLoader::Settings& settings);
+
+		// File of a source image in cacheDirectory, different for every source path
+		static std::filesystem::path getPath(const std::filesystem::path& cacheDirectory, const std::filesystem::path& sourcePath);
+
+		static void save(const std::filesystem::path& path, Hash64 key, const ImageLoader::MipChain& mipChain);
+
+		// Reads the header only, returns false if the file does not exist or was saved with another key
+		static bool loadInfo(const std::filesystem::path& path, Hash64 key, Info& info);
+
+		// Reads the levels starting from firstMipLevel, which becomes the first level of mipChain
+		// Used to stream the finest levels only when they are needed (see TextureStreamer)
+		// Returns false if the file does not exist, is incomplete, was saved with another key or has less levels
+		static bool load(const std::filesystem::path& path, Hash64 key, ImageLoader::MipChain& mipChain, uint32_t firstMipLevel = 0);
+	};
+}
+
+#endif
@@ -0,0 +1,48 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_GRAPHICS_TEXTURECOMPRESSOR_HPP
+#define ATEMA_GRAPHICS_TEXTURECOMPRESSOR_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Graphics/Loaders/ImageLoader.hpp>
+
+namespace at
+{
+	// CPU encoder for block-compressed formats, meant to be run once per texture (see TextureCache)
+	// Endpoints are fitted along the principal axis of each 4x4 block, then every pixel takes its closest palette entry
+	struct ATEMA_GRAPHICS_API TextureCompressor
+	{
+		// Block-compressed format used for images with the given channels
+		// Returns the uncompressed 8 bit format of these channels (RGBA for RGB images) with Compression::None
+		static ImageFormat getFormat(ImageLoader::Compression compression, ImageLoader::Format format);
+
+		// Builds the mip chain of an image with 8 bit channels, then compresses every level
+		// mipLevels, mipFilter & srgb follow ImageLoader::Settings (mipLevels = 0 for a full chain)
+		static ImageLoader::MipChain compress(const uint8_t* data, uint32_t width, uint32_t height, ImageLoader::Format format, ImageLoader::Compression compression, uint32_t mipLevels = 0, ImageLoader::MipFilter mipFilter = ImageLoader::MipFilter::Box, bool srgb = false);
+
+		// Filters an image with 8 bit channels to the next mip level size (max(size / 2, 1))
+		// Rows are spread across TaskManager workers, and filtered with SIMD instructions when available
+		static std::vector<uint8_t> downsample(const uint8_t* data, uint32_t width, uint32_t height, ImageLoader::Format format, ImageLoader::MipFilter mipFilter = ImageLoader::MipFilter::Box, bool srgb = false);
+	};
+}
+
+#endif
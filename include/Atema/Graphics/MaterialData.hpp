@@ -48,6 +48,7 @@ namespace at
 		ATEMA_DEFINE_MATERIAL_DATA(Metalness)
 		ATEMA_DEFINE_MATERIAL_DATA(MetalnessMap)
 		ATEMA_DEFINE_MATERIAL_DATA(NormalMap)
+		ATEMA_DEFINE_MATERIAL_DATA(QuantizedVertex)
 		ATEMA_DEFINE_MATERIAL_DATA(Roughness)
 		ATEMA_DEFINE_MATERIAL_DATA(RoughnessMap)
 		ATEMA_DEFINE_MATERIAL_DATA(Shininess)
@@ -26,12 +26,65 @@
 #include <Atema/Graphics/Config.hpp>
 #include <Atema/Graphics/VertexFormat.hpp>
 #include <Atema/Math/AABB.hpp>
+#include <Atema/Math/Matrix.hpp>
+#include <Atema/Math/Sphere.hpp>
+
+#include <vector>
 
 namespace at
 {
 	class VertexBuffer;
 	class IndexBuffer;
 
+	// Transformation from the vertex components stored as normalized integers to their original values (see ModelLoader)
+	// The default values don't modify the components
+	struct ATEMA_GRAPHICS_API VertexQuantization
+	{
+		// position = positionOffset + positionScale * storedPosition
+		// The scale is uniform so normals & tangents don't need any correction
+		Vector3f positionOffset;
+		float positionScale = 1.0f;
+
+		// texCoords = texCoordsOffset + texCoordsScale * storedTexCoords
+		Vector2f texCoordsOffset;
+		Vector2f texCoordsScale = { 1.0f, 1.0f };
+
+		// Position dequantization as a matrix, to be combined with the model matrix
+		Matrix4f getPositionMatrix() const;
+	};
+
+	// Cluster of triangles stored contiguously in the index buffer of a mesh (see MeshOptimizer::buildMeshlets)
+	// Bounds are in mesh space, before any quantization
+	struct ATEMA_GRAPHICS_API Meshlet
+	{
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+
+		Spheref boundingSphere;
+
+		// Every front face normal is inside the cone of axis coneAxis
+		// coneCutoff is the sine of the cone half angle, 1 meaning the cone is too wide to be used
+		Vector3f coneAxis;
+		float coneCutoff = 1.0f;
+
+		// Returns true if every triangle is back-facing when viewed from viewPosition (in mesh space)
+		bool isBackFacing(const Vector3f& viewPosition) const noexcept;
+	};
+
+	// Level of detail sharing the vertex buffer of a mesh, stored contiguously in its index buffer (see MeshOptimizer::simplify)
+	struct ATEMA_GRAPHICS_API MeshLod
+	{
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+
+		// Meshlets of this LOD, if the mesh has meshlets
+		uint32_t firstMeshlet = 0;
+		uint32_t meshletCount = 0;
+
+		// Maximum distance to the original surface, in mesh space
+		float error = 0.0f;
+	};
+
 	class ATEMA_GRAPHICS_API Mesh
 	{
 	public:
@@ -45,6 +98,14 @@ namespace at
 		void setAABB(const AABBf& aabb);
 		// The ID refers to the material index in the parent model
 		void setMaterialID(size_t materialID);
+		void setVertexQuantization(const VertexQuantization& quantization);
+		// Meshlets must cover the whole index buffer (or every LOD), in order
+		void setMeshlets(const std::vector<Meshlet>& meshlets);
+		// LODs are sorted from the finest to the coarsest, the first one being the original mesh
+		// The triangle count becomes the one of the first LOD
+		void setLods(const std::vector<MeshLod>& lods);
+		// Average number of texture coordinate units per mesh space unit, 0 if unknown
+		void setTexCoordsDensity(float density);
 
 		const Ptr<VertexBuffer>& getVertexBuffer() const noexcept;
 		const Ptr<IndexBuffer>& getIndexBuffer() const noexcept;
@@ -52,6 +113,12 @@ namespace at
 		// The ID refers to the material index in the parent mesh
 		size_t getMaterialID() const noexcept;
 		size_t getTriangleCount() const noexcept;
+		const VertexQuantization& getVertexQuantization() const noexcept;
+		// Empty if the mesh was not split into meshlets
+		const std::vector<Meshlet>& getMeshlets() const noexcept;
+		// Empty if the mesh has no other LOD than the whole index buffer
+		const std::vector<MeshLod>& getLods() const noexcept;
+		float getTexCoordsDensity() const noexcept;
 
 		Mesh& operator=(const Mesh& other) = default;
 		Mesh& operator=(Mesh&& other) noexcept;
@@ -65,6 +132,14 @@ namespace at
 		size_t m_materialID;
 
 		size_t m_triangleCount;
+
+		VertexQuantization m_vertexQuantization;
+
+		std::vector<Meshlet> m_meshlets;
+
+		std::vector<MeshLod> m_lods;
+
+		float m_texCoordsDensity;
 	};
 }
 
@@ -28,6 +28,7 @@
 #include <Atema/Graphics/Renderable.hpp>
 #include <Atema/Renderer/Renderer.hpp>
 #include <Atema/Renderer/DepthStencil.hpp>
+#include <Atema/Math/Enums.hpp>
 
 #include <vector>
 #include <optional>
@@ -65,6 +66,9 @@ namespace at
 
 		const char* getName() const noexcept override;
 
+		// Maximum projected error of the selected LODs, in pixels (default : 1)
+		void setLodThreshold(float pixels);
+
 		FrameGraphPass& addToFrameGraph(FrameGraphBuilder& frameGraphBuilder, const Settings& settings);
 
 		void updateResources(CommandBuffer& commandBuffer) override;
@@ -81,13 +85,26 @@ namespace at
 	private:
 		void frustumCull();
 		void frustumCullElements(std::vector<RenderElement>& renderElements, size_t index, size_t count) const;
+		void selectLod(RenderElement& renderElement, const Matrix4f& matrix) const;
+		// Reports the texture size needed by the element to TextureStreamer
+		void requestTextures(const RenderElement& renderElement, const Matrix4f& matrix) const;
 		void sortElements();
 		void drawElements(CommandBuffer& commandBuffer, size_t index, size_t count);
 
 		RenderResourceManager* m_resourceManager;
 
 		size_t m_threadCount;
-		
+
+		float m_lodThreshold;
+		// Maximum world error of the LODs, per unit of distance to the camera (perspective) or constant (orthographic)
+		float m_lodMaxError;
+		bool m_lodDistanceDependent;
+		// Pixels covered by a world unit, at a distance of 1 with a perspective projection
+		float m_pixelsPerUnit;
+		bool m_textureStreaming;
+
+		std::vector<const RenderObject*> m_visibleRenderObjects;
+		std::vector<IntersectionType> m_renderObjectIntersections;
 		std::vector<RenderElement> m_renderElements;
 
 		Ptr<BufferAllocation> m_frameDataBuffer;
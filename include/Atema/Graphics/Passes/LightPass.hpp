@@ -104,7 +104,6 @@ namespace at
 		void createLightingModel(const std::string& name);
 		void createShaders();
 		void frustumCull();
-		void frustumCullElements(size_t index, size_t count, std::vector<const RenderLight*>& visibleLights) const;
 		void drawElements(CommandBuffer& commandBuffer, bool applyPostProcess, size_t directionalIndex, size_t directionalCount, size_t pointIndex, size_t pointCount, size_t spotIndex, size_t spotCount);
 
 		RenderResourceManager* m_resourceManager;
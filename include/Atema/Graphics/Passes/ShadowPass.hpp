@@ -65,6 +65,8 @@ namespace at
 
 		void setViewProjection(const Matrix4f& viewProjection);
 		void setFrustum(const Frustumf& frustum);
+		// Maximum world error of the selected LODs, whatever the distance (default : 0, the finest LOD)
+		void setLodError(float maxError);
 
 		FrameGraphPass& addToFrameGraph(FrameGraphBuilder& frameGraphBuilder, const Settings& settings);
 
@@ -90,12 +92,17 @@ namespace at
 
 		Ptr<DescriptorSetLayout> m_setLayout;
 		Ptr<GraphicsPipeline> m_pipeline;
+		// Used for DefaultVertexFormat::XYZ_UV_NT_Quantized
+		Ptr<GraphicsPipeline> m_quantizedPipeline;
 
 		Ptr<BufferAllocation> m_frameDataBuffer;
 		Ptr<DescriptorSet> m_frameDataDescriptorSet;
 
 		Matrix4f m_viewProjection;
 		Frustumf m_frustum;
+		float m_lodError;
+		std::vector<const RenderObject*> m_visibleRenderObjects;
+		std::vector<IntersectionType> m_renderObjectIntersections;
 		std::vector<RenderElement> m_renderElements;
 	};
 }
@@ -0,0 +1,54 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_GRAPHICS_ENVIRONMENTCACHE_HPP
+#define ATEMA_GRAPHICS_ENVIRONMENTCACHE_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Core/Hash.hpp>
+#include <Atema/Renderer/Image.hpp>
+
+#include <filesystem>
+#include <vector>
+
+namespace at
+{
+	// Binary container storing precomputed cubemaps (environment, irradiance & prefiltered maps) with all their mip levels
+	// It avoids decoding the source image and running EnvironmentPipeline again on later loads
+	// A file is identified by a key, built from the source image and the generation settings
+	struct ATEMA_GRAPHICS_API EnvironmentCache
+	{
+		// Hashes the content of the source file and the size, format & mip levels of every output
+		static Hash64 getKey(const std::filesystem::path& sourcePath, const std::vector<Image::Settings>& outputSettings);
+
+		// Reads the cubemaps back from the GPU and writes them to path, in the same order
+		// Every cubemap must have the flag ImageUsage::TransferSrc and be in the layout ImageLayout::ShaderRead
+		// The file is written under a temporary name then renamed, so an interrupted save never leaves a partial file
+		static void save(const std::filesystem::path& path, Hash64 key, const std::vector<Ptr<Image>>& cubemaps);
+
+		// Creates the cubemaps stored in path, in the same order they were saved, and leaves them in the layout ImageLayout::ShaderRead
+		// ImageUsage::TransferDst is always added to usages
+		// Returns false if the file does not exist, is incomplete or was saved with another key
+		static bool load(const std::filesystem::path& path, Hash64 key, std::vector<Ptr<Image>>& cubemaps, Flags<ImageUsage> usages = ImageUsage::ShaderSampling);
+	};
+}
+
+#endif
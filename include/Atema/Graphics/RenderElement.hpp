@@ -25,9 +25,11 @@
 #include <Atema/Graphics/Config.hpp>
 #include <Atema/Graphics/VertexBuffer.hpp>
 #include <Atema/Graphics/IndexBuffer.hpp>
+#include <Atema/Graphics/Mesh.hpp>
 #include <Atema/Graphics/ShaderBinding.hpp>
 #include <Atema/Graphics/RenderMaterial.hpp>
 #include <Atema/Math/AABB.hpp>
+#include <Atema/Math/Frustum.hpp>
 
 #include <vector>
 
@@ -41,12 +43,46 @@ namespace at
 		RenderElement(RenderElement&& other) noexcept = default;
 		~RenderElement() = default;
 
+		// Returns the coarsest LOD whose error, scaled by matrix, is below maxError
+		uint32_t getLodIndex(const Matrix4f& matrix, float maxError) const;
+		// Same as above, maxError being proportional to the distance between viewPosition & the transformed AABB
+		uint32_t getLodIndex(const Matrix4f& matrix, const Vector3f& viewPosition, float maxErrorPerDistance) const;
+		// Restricts the index range & the meshlets to the given LOD
+		// Must be called before cullMeshlets
+		void setLod(uint32_t lodIndex);
+
+		// Returns the texture size (for a UV range of 1) giving one texel per pixel, based on texCoordsDensity
+		// pixelsPerUnit is the number of pixels covered by a world unit
+		float getTextureSize(const Matrix4f& matrix, float pixelsPerUnit) const;
+		// Same as above, pixelsPerUnit being divided by the distance between viewPosition & the transformed AABB
+		float getTextureSize(const Matrix4f& matrix, const Vector3f& viewPosition, float pixelsPerUnit) const;
+
+		// Appends the parts of this element whose meshlets may be visible to renderElements
+		// Consecutive visible meshlets are merged in a single element, as are small gaps of culled ones
+		// matrix transforms the element to the space of the frustum & the view position
+		// Meshlets outside of the frustum are culled if frustum is not null
+		// Back-facing meshlets are culled if viewPosition is not null and the material discards back faces
+		// Elements without meshlets are appended as is
+		void cullMeshlets(std::vector<RenderElement>& renderElements, const Matrix4f& matrix, const Frustumf* frustum, const Vector3f* viewPosition) const;
+
 		RenderElement& operator=(const RenderElement& other) = default;
 		RenderElement& operator=(RenderElement&& other) noexcept = default;
 
 		AABBf aabb;
 		const VertexBuffer* vertexBuffer;
 		const IndexBuffer* indexBuffer;
+		// Range of the index buffer to draw
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		// Optional meshlets of the index range, in order (see Mesh::getMeshlets)
+		const Meshlet* meshlets;
+		uint32_t meshletCount;
+		// Optional LODs of the mesh (see Mesh::getLods), lodIndex being the one currently drawn
+		const MeshLod* lods;
+		uint32_t lodCount;
+		uint32_t lodIndex;
+		// See Mesh::getTexCoordsDensity
+		float texCoordsDensity;
 		const RenderMaterialInstance* renderMaterialInstance;
 		uint32_t transformSetIndex;
 		const DescriptorSet* transformDescriptorSet;
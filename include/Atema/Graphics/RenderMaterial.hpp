@@ -28,9 +28,11 @@
 #include <Atema/Core/IdManager.hpp>
 #include <Atema/Graphics/RenderResource.hpp>
 #include <Atema/Graphics/ShaderData.hpp>
+#include <Atema/Graphics/VertexFormat.hpp>
 #include <Atema/Core/Signal.hpp>
 
 #include <limits>
+#include <optional>
 #include <Atema/Shader/ShaderLibraryManager.hpp>
 #include <Atema/Shader/UberShader.hpp>
 
@@ -55,6 +57,13 @@ namespace at
 			std::vector<UberShader::Option> uberShaderOptions;
 			const ShaderLibraryManager* shaderLibraryManager = nullptr;
 			GraphicsPipeline::State pipelineState;
+			// If true, shaders & pipeline are compiled on TaskManager workers instead of stalling the calling thread
+			// The RenderMaterial can't be bound until isReady() returns true
+			bool asyncPipeline = false;
+			// If set, the vertex input follows this format instead of the types declared in the shader
+			// Required for formats the shaders can't express, like normalized integers
+			// Each component must match a shader input location, and the format must describe the whole vertex
+			std::optional<VertexFormat> vertexFormat;
 		};
 
 		struct Binding
@@ -71,6 +80,12 @@ namespace at
 
 		ID getID() const noexcept;
 
+		// Returns true when the pipeline is available (always the case when not using asynchronous compilation)
+		bool isReady() const noexcept;
+
+		// Returns true if the pipeline discards back faces, so they don't need to be drawn at all
+		bool isBackFaceCulled() const noexcept;
+
 		void bindTo(CommandBuffer& commandBuffer) const;
 
 		Ptr<RenderMaterialInstance> createInstance(const MaterialInstance& materialInstance);
@@ -90,13 +105,23 @@ namespace at
 		void updateResources() override;
 
 	private:
+		// Tries to get the pipeline from the pending asynchronous compilations
+		void updatePipeline();
+
 		Material* m_material;
 
 		ID m_id;
 
+		bool m_backFaceCulled;
+
 		std::vector<Ptr<DescriptorSetLayout>> m_descriptorSetLayouts;
 		Ptr<GraphicsPipeline> m_pipeline;
 
+		// Only used while the pipeline is being compiled asynchronously
+		GraphicsPipeline::Settings m_pipelineSettings;
+		Ptr<UberShader> m_vertexUberShader;
+		Ptr<UberShader> m_fragmentUberShader;
+
 		std::map<std::string, Binding> m_bindings;
 
 		MaterialParameters m_parameters;
@@ -123,6 +148,7 @@ namespace at
 		RenderMaterial::ID getID() const noexcept;
 
 		const RenderMaterial& getRenderMaterial() const noexcept;
+		const MaterialInstance& getMaterialInstance() const noexcept;
 
 		// The user needs to bind the RenderMaterial before calling this method
 		void bindTo(CommandBuffer& commandBuffer) const;
@@ -23,12 +23,14 @@
 #define ATEMA_GRAPHICS_RENDERDATA_HPP
 
 #include <Atema/Graphics/Config.hpp>
+#include <Atema/Graphics/BoundingVolumeHierarchy.hpp>
 #include <Atema/Graphics/Camera.hpp>
 #include <Atema/Graphics/Renderable.hpp>
 #include <Atema/Graphics/Light.hpp>
 #include <Atema/Graphics/RenderLight.hpp>
 #include <Atema/Graphics/RenderObject.hpp>
 #include <Atema/Graphics/SkyBox.hpp>
+#include <Atema/Graphics/TransformHierarchy.hpp>
 
 #include <vector>
 #include <unordered_map>
@@ -64,6 +66,12 @@ namespace at
 
 		void recompileMaterials();
 
+		// Updates the world matrices of the transform hierarchy, then applies pending bounds modifications to the spatial hierarchies
+		// Must be called every frame before the render passes query the scene
+		// threadCount : Number of threads the update is allowed to use
+		// 0 means as much as possible
+		void updateHierarchies(size_t threadCount = 0);
+
 		const Camera& getCamera() const noexcept;
 		const Ptr<SkyBox>& getSkyBox() const noexcept;
 		RenderMaterial& getRenderMaterial(Ptr<Material> material);
@@ -71,6 +79,15 @@ namespace at
 		const std::vector<Ptr<RenderObject>>& getRenderObjects() const noexcept;
 		const std::vector<Ptr<RenderLight>>& getRenderLights() const noexcept;
 
+		// Nodes may be bound to renderables (or anything else) using their callback
+		TransformHierarchy& getTransformHierarchy() noexcept;
+		const TransformHierarchy& getTransformHierarchy() const noexcept;
+		const BoundingVolumeHierarchy<const RenderObject*>& getRenderObjectHierarchy() const noexcept;
+		// Lights with a bounded volume of influence (point & spot lights)
+		const BoundingVolumeHierarchy<const RenderLight*>& getRenderLightHierarchy() const noexcept;
+		// Lights affecting the whole scene (directional lights)
+		const std::vector<const RenderLight*>& getGlobalRenderLights() const noexcept;
+
 		RenderScene& operator=(const RenderScene& other) = default;
 		RenderScene& operator=(RenderScene&& other) noexcept = default;
 
@@ -85,17 +102,30 @@ namespace at
 			Connection connection;
 		};
 
+		template <typename T>
+		struct HierarchyData
+		{
+			size_t index;
+			typename BoundingVolumeHierarchy<const T*>::Handle handle;
+			Connection connection;
+		};
+
 		AbstractFrameRenderer* m_frameRenderer;
 
 		const Camera* m_camera;
 
 		Ptr<SkyBox> m_skyBox;
 		
+		TransformHierarchy m_transformHierarchy;
+
 		std::vector<Ptr<RenderObject>> m_renderObjects;
-		std::unordered_map<const Renderable*, size_t> m_renderObjectIndices;
+		std::unordered_map<const Renderable*, HierarchyData<RenderObject>> m_renderObjectData;
+		BoundingVolumeHierarchy<const RenderObject*> m_renderObjectHierarchy;
 		
 		std::vector<Ptr<RenderLight>> m_renderLights;
-		std::unordered_map<const Light*, size_t> m_renderLightIndices;
+		std::unordered_map<const Light*, HierarchyData<RenderLight>> m_renderLightData;
+		BoundingVolumeHierarchy<const RenderLight*> m_renderLightHierarchy;
+		std::vector<const RenderLight*> m_globalRenderLights;
 
 		std::unordered_map<const Material*, RenderData<RenderMaterial>> m_renderMaterials;
 		std::unordered_map<const MaterialInstance*, RenderData<RenderMaterialInstance>> m_renderMaterialInstances;
@@ -25,8 +25,9 @@
 #include <Atema/Graphics/Config.hpp>
 #include <Atema/Graphics/RenderElement.hpp>
 #include <Atema/Graphics/RenderResource.hpp>
+#include <Atema/Core/Signal.hpp>
 #include <Atema/Math/AABB.hpp>
-#include <Atema/Math/Transform.hpp>
+#include <Atema/Math/Matrix.hpp>
 
 namespace at
 {
@@ -44,7 +45,8 @@ namespace at
 
 		virtual Ptr<RenderObject> createRenderObject(RenderScene& renderScene) = 0;
 
-		virtual const Transform& getTransform() const noexcept = 0;
+		// World matrix
+		virtual const Matrix4f& getMatrix() const noexcept = 0;
 
 		virtual const AABBf& getAABB() const noexcept = 0;
 
@@ -55,6 +57,9 @@ namespace at
 		Renderable& operator=(const Renderable& other) = default;
 		Renderable& operator=(Renderable&& other) noexcept = default;
 
+		// Must be emitted by derived classes every time the AABB changes
+		Signal<> onAABBUpdate;
+
 	private:
 		bool m_castShadows;
 	};
@@ -107,6 +107,7 @@ namespace at
 			Layout(StructLayout structLayout = StructLayout::Default);
 
 			size_t modelOffset;
+			size_t texCoordsQuantizationOffset;
 		};
 
 		TransformData() = default;
@@ -119,7 +120,10 @@ namespace at
 		size_t getByteSize(StructLayout structLayout) const noexcept override;
 		void copyTo(void* dstData, StructLayout structLayout = StructLayout::Default) const override;
 
+		// Includes the position dequantization of the mesh, if any (see VertexQuantization)
 		Matrix4f model;
+		// Texture coordinates dequantization of the mesh (XY : scale, ZW : offset)
+		Vector4f texCoordsQuantization = { 1.0f, 1.0f, 0.0f, 0.0f };
 
 		TransformData& operator=(const TransformData& other) = default;
 		TransformData& operator=(TransformData&& other) noexcept = default;
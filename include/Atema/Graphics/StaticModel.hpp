@@ -27,6 +27,7 @@
 #include <Atema/Graphics/Model.hpp>
 #include <Atema/Core/Pointer.hpp>
 #include <Atema/Math/AABB.hpp>
+#include <Atema/Math/Matrix.hpp>
 #include <Atema/Math/Transform.hpp>
 
 namespace at
@@ -34,7 +35,7 @@ namespace at
 	class ATEMA_GRAPHICS_API StaticModel : public Renderable
 	{
 	public:
-		StaticModel() = default;
+		StaticModel();
 		StaticModel(const StaticModel& other) = default;
 		StaticModel(StaticModel&& other) noexcept = default;
 		~StaticModel() = default;
@@ -42,10 +43,13 @@ namespace at
 		Ptr<RenderObject> createRenderObject(RenderScene& renderScene) override;
 
 		void setModel(const Ptr<Model>& model);
+		// World matrix, usually coming from a TransformHierarchy
+		void setMatrix(const Matrix4f& matrix);
+		// Convenience method for models without parent
 		void setTransform(const Transform& transform);
 
 		const Ptr<Model>& getModel() const noexcept;
-		const Transform& getTransform() const noexcept override;
+		const Matrix4f& getMatrix() const noexcept override;
 		const AABBf& getAABB() const noexcept override;
 
 		StaticModel& operator=(const StaticModel& other) = default;
@@ -58,7 +62,7 @@ namespace at
 		void updateAABB();
 
 		Ptr<Model> m_model;
-		Transform m_transform;
+		Matrix4f m_matrix;
 		AABBf m_aabb;
 
 		ConnectionGuard m_modelConnectionGuard;
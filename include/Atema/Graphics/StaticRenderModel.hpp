@@ -23,6 +23,7 @@
 #define ATEMA_GRAPHICS_STATICRENDERMODEL_HPP
 
 #include <Atema/Graphics/Config.hpp>
+#include <Atema/Graphics/Mesh.hpp>
 #include <Atema/Graphics/RenderObject.hpp>
 
 namespace at
@@ -55,10 +56,12 @@ namespace at
 		bool m_modelValid;
 		std::vector<RenderElement> m_renderElements;
 		std::vector<const RenderMaterialInstance*> m_renderMaterialInstances;
-		std::vector<Ptr<DescriptorSet>> m_transformDescriptorSets;
 
+		// One transform per RenderElement, because each mesh has its own vertex quantization
 		bool m_transformValid;
-		Ptr<BufferAllocation> m_transformBuffer;
+		std::vector<VertexQuantization> m_vertexQuantizations;
+		std::vector<Ptr<BufferAllocation>> m_transformBuffers;
+		std::vector<Ptr<DescriptorSet>> m_transformDescriptorSets;
 
 		ConnectionGuard m_connectionGuard;
 	};
@@ -0,0 +1,161 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_GRAPHICS_TEXTURESTREAMER_HPP
+#define ATEMA_GRAPHICS_TEXTURESTREAMER_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Core/Hash.hpp>
+#include <Atema/Core/NonCopyable.hpp>
+#include <Atema/Core/Pointer.hpp>
+#include <Atema/Core/Signal.hpp>
+#include <Atema/Graphics/Loaders/ImageLoader.hpp>
+#include <Atema/Graphics/Loaders/TextureCache.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace at
+{
+	class MaterialInstance;
+	class Sampler;
+
+	// Streams the finest mip levels of material textures, depending on the size they are seen with
+	// A texture starts with its coarsest levels (up to the resident size), which stay in memory until it is released
+	// The passes report the texture size needed by every visible element (see request), then update() :
+	// - loads the missing levels from the texture cache with AssetLoader, within the memory budget
+	// - evicts the least recently requested textures back to their resident levels when the budget is exceeded
+	// Material instances are given the new images by AssetLoader::update(), once they are resident on the GPU
+	class ATEMA_GRAPHICS_API TextureStreamer : public NonCopyable
+	{
+	public:
+		TextureStreamer();
+		~TextureStreamer();
+
+		// Default TextureStreamer instance
+		static TextureStreamer& instance();
+
+		// Disabled by default : DefaultMaterials then loads every texture entirely with Graphics::getImage
+		void setEnabled(bool enabled);
+		bool isEnabled() const noexcept;
+
+		// Memory the streamed images may use, resident levels excluded (default : 256 MB)
+		void setBudget(size_t byteSize);
+		size_t getBudget() const noexcept;
+
+		// Largest side of the resident levels (default : 64)
+		// Only applies to the textures registered afterwards
+		void setResidentSize(uint32_t size);
+		uint32_t getResidentSize() const noexcept;
+
+		// Memory currently used by the streamed images, including the ones being loaded
+		size_t getStreamedByteSize() const;
+
+		// Sets a texture parameter of materialInstance, whose finest levels are streamed
+		// settings.cacheDirectory is required : mip chains are built once, then read from the cache (see DefaultImageLoader::loadMipChain)
+		// Images that can't be streamed (HDR, not 2D, no cache directory) are loaded entirely with Graphics::getImage
+		void setParameter(MaterialInstance& materialInstance, const std::string& name, const std::filesystem::path& path, const Ptr<Sampler>& sampler, const ImageLoader::Settings& settings);
+
+		// Notifies that the textures of materialInstance are seen with the given size (see RenderElement::getTextureSize)
+		// The largest size requested since the last update is kept
+		// Can be called from several threads
+		void request(const MaterialInstance& materialInstance, float textureSize);
+
+		// Starts loading the levels requested since the last call, evicting other textures if needed
+		// Must be called once per frame, from the thread calling AssetLoader::update()
+		void update();
+
+		// Releases every texture, material instances keeping their current images
+		// Must be called before destroying the Renderer
+		void clear();
+
+	private:
+		struct Usage
+		{
+			MaterialInstance* materialInstance;
+			std::string name;
+			Ptr<Sampler> sampler;
+		};
+
+		struct Texture
+		{
+			StdHash hash = 0;
+			std::filesystem::path path;
+			ImageLoader::Settings settings;
+			TextureCache::Info info;
+
+			std::vector<Usage> usages;
+
+			Ptr<Image> residentImage;
+			uint32_t residentMipLevel = 0;
+
+			// Current image : residentImage if nothing is streamed, byteSize being 0 in this case
+			Ptr<Image> image;
+			uint32_t mipLevel = 0;
+			size_t byteSize = 0;
+
+			// Memory of the image being loaded, if any
+			bool loading = false;
+			size_t loadingByteSize = 0;
+
+			// Largest size requested since the last update
+			float requestedSize = 0.0f;
+			// Level needed when it was last requested, and the index of this update
+			uint32_t requestedMipLevel = 0;
+			uint64_t lastRequest = 0;
+		};
+
+		struct Instance
+		{
+			std::vector<Ptr<Texture>> textures;
+			ConnectionGuard connectionGuard;
+		};
+
+		Ptr<Texture> createTexture(const std::filesystem::path& path, const ImageLoader::Settings& settings) const;
+		uint32_t getMipLevel(const Texture& texture, float textureSize) const;
+		size_t getByteSize(const Texture& texture, uint32_t mipLevel) const;
+		void setImage(Texture& texture, const Ptr<Image>& image, uint32_t mipLevel, size_t byteSize);
+		void evict(Texture& texture);
+		void load(const Ptr<Texture>& texture, uint32_t mipLevel, size_t byteSize);
+		void onLoad(const WPtr<Texture>& texture, const Ptr<Image>& image, uint32_t mipLevel);
+		// Removes the usages of a material instance (only the ones named name if not null), and the textures not used anymore
+		void removeUsages(const MaterialInstance* materialInstance, const std::string* name);
+
+		mutable std::mutex m_mutex;
+
+		bool m_enabled;
+		size_t m_budget;
+		uint32_t m_residentSize;
+
+		size_t m_streamedByteSize;
+		size_t m_loadingByteSize;
+		size_t m_loadingCount;
+		uint64_t m_updateIndex;
+
+		std::unordered_map<StdHash, Ptr<Texture>> m_textures;
+		std::unordered_map<const MaterialInstance*, Instance> m_instances;
+	};
+}
+
+#endif
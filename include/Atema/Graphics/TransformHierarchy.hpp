@@ -0,0 +1,122 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_GRAPHICS_TRANSFORMHIERARCHY_HPP
+#define ATEMA_GRAPHICS_TRANSFORMHIERARCHY_HPP
+
+#include <Atema/Graphics/Config.hpp>
+#include <Atema/Core/IdManager.hpp>
+#include <Atema/Math/Matrix.hpp>
+#include <Atema/Math/Transform.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace at
+{
+	// Scene graph of local transforms, each node being relative to its parent
+	// Nodes are identified by a handle given when they are added
+	// World matrices are only recomputed during update, for the nodes that were modified (or whose parent was)
+	class ATEMA_GRAPHICS_API TransformHierarchy
+	{
+	public:
+		using Handle = size_t;
+
+		// Called during update with the new world matrix of a node, possibly from a worker thread
+		using Callback = std::function<void(const Matrix4f&)>;
+
+		static constexpr Handle InvalidHandle = std::numeric_limits<Handle>::max();
+
+		// Minimum number of nodes updated by a task
+		static constexpr size_t ParallelUpdateThreshold = 1024;
+
+		TransformHierarchy();
+		TransformHierarchy(const TransformHierarchy& other) = default;
+		TransformHierarchy(TransformHierarchy&& other) noexcept = default;
+		~TransformHierarchy() = default;
+
+		Handle add(const Transform& transform, Handle parent = InvalidHandle, Callback callback = nullptr);
+		// Removes the node and all its descendants
+		void remove(Handle handle);
+
+		void clear();
+
+		// The node keeps its local transform, so its world matrix changes
+		void setParent(Handle handle, Handle parent);
+		// Does nothing if the transform did not change
+		void setTransform(Handle handle, const Transform& transform);
+		void setCallback(Handle handle, Callback callback);
+
+		Handle getParent(Handle handle) const;
+		const Transform& getTransform(Handle handle) const;
+		// Returns the world matrix computed during the last update
+		const Matrix4f& getMatrix(Handle handle) const;
+
+		size_t getSize() const noexcept;
+
+		// Recomputes the world matrices of modified nodes and calls their callbacks
+		// Nodes are processed level by level (breadth-first), each level being split between tasks
+		// threadCount : Number of threads the update is allowed to use
+		// 0 means as much as possible
+		void update(size_t threadCount = 0);
+
+		TransformHierarchy& operator=(const TransformHierarchy& other) = default;
+		TransformHierarchy& operator=(TransformHierarchy&& other) noexcept = default;
+
+	private:
+		static constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+
+		// Topology, indexed by handle
+		struct Node
+		{
+			Handle parent = InvalidHandle;
+			Handle firstChild = InvalidHandle;
+			Handle nextSibling = InvalidHandle;
+			size_t index = InvalidIndex;
+			bool valid = false;
+		};
+
+		void attach(Handle handle, Handle parent);
+		void detach(Handle handle);
+		void removeNode(Handle handle);
+		void sort();
+		void updateRange(size_t begin, size_t end);
+
+		IdManager<Handle> m_idManager;
+		std::vector<Node> m_nodes;
+		size_t m_size;
+
+		// Node data, indexed by Node::index
+		// After each sort, nodes are stored in breadth-first order : parents are always processed before their children
+		std::vector<Handle> m_handles;
+		std::vector<size_t> m_parentIndices;
+		std::vector<Transform> m_transforms;
+		std::vector<Matrix4f> m_matrices;
+		std::vector<Callback> m_callbacks;
+		std::vector<uint8_t> m_dirty;
+
+		// Index of the first node of each level, followed by the total node count
+		std::vector<size_t> m_levelOffsets;
+		bool m_sort;
+	};
+}
+
+#endif
@@ -249,6 +249,24 @@ namespace at
 		// Default vertex input
 		static const std::vector<VertexInput>& getVertexInput();
 	};
+
+	// Components are stored as normalized integers (see ModelLoader for the encoding)
+	struct ATEMA_GRAPHICS_API Vertex_XYZ_UV_NT_Quantized
+	{
+		// XYZ : position relative to the mesh quantization, W : 1
+		Vector4<int16_t> position;
+		Vector2<uint16_t> texCoords;
+		// Octahedral encoding
+		Vector2<int16_t> normal;
+		// XY : octahedral encoding, Z : bitangent sign, W : unused
+		Vector4<int8_t> tangent;
+
+		// Default vertex format
+		static constexpr DefaultVertexFormat VertexFormat = DefaultVertexFormat::XYZ_UV_NT_Quantized;
+
+		// Default vertex input
+		static const std::vector<VertexInput>& getVertexInput();
+	};
 }
 
 #endif
\ No newline at end of file
@@ -31,6 +31,7 @@
 #include <Atema/Math/Plane.hpp>
 #include <Atema/Math/Quaternion.hpp>
 #include <Atema/Math/Rect.hpp>
+#include <Atema/Math/Simd.hpp>
 #include <Atema/Math/Sphere.hpp>
 #include <Atema/Math/Transform.hpp>
 #include <Atema/Math/Vector.hpp>
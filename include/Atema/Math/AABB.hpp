@@ -70,6 +70,41 @@ namespace at
 	using AABBf = AABB<float>;
 	using AABBd = AABB<double>;
 
+	// Structure of arrays storage of AABBs, using the center/half size representation
+	// Used by batch operations, like Frustum::getIntersectionTypes
+	template <typename T>
+	class AABBBatch
+	{
+	public:
+		AABBBatch() = default;
+		AABBBatch(const AABBBatch& other) = default;
+		AABBBatch(AABBBatch&& other) noexcept = default;
+		~AABBBatch() = default;
+
+		void reserve(size_t size);
+		void clear() noexcept;
+
+		void add(const AABB<T>& aabb);
+		void add(const Vector3<T>& center, const Vector3<T>& halfSize);
+
+		size_t getSize() const noexcept;
+
+		AABB<T> get(size_t index) const noexcept;
+
+		AABBBatch& operator=(const AABBBatch& other) = default;
+		AABBBatch& operator=(AABBBatch&& other) noexcept = default;
+
+		std::vector<T> centerX;
+		std::vector<T> centerY;
+		std::vector<T> centerZ;
+		std::vector<T> halfSizeX;
+		std::vector<T> halfSizeY;
+		std::vector<T> halfSizeZ;
+	};
+
+	using AABBBatchf = AABBBatch<float>;
+	using AABBBatchd = AABBBatch<double>;
+
 	template <typename T>
 	AABB<T> operator*(const Matrix3<T>& matrix, const AABB<T>& aabb);
 
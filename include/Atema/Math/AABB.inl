@@ -187,6 +187,62 @@ namespace at
 		return *this;
 	}
 
+	template <typename T>
+	void AABBBatch<T>::reserve(size_t size)
+	{
+		centerX.reserve(size);
+		centerY.reserve(size);
+		centerZ.reserve(size);
+		halfSizeX.reserve(size);
+		halfSizeY.reserve(size);
+		halfSizeZ.reserve(size);
+	}
+
+	template <typename T>
+	void AABBBatch<T>::clear() noexcept
+	{
+		centerX.clear();
+		centerY.clear();
+		centerZ.clear();
+		halfSizeX.clear();
+		halfSizeY.clear();
+		halfSizeZ.clear();
+	}
+
+	template <typename T>
+	void AABBBatch<T>::add(const AABB<T>& aabb)
+	{
+		const auto center = aabb.getCenter();
+
+		add(center, aabb.max - center);
+	}
+
+	template <typename T>
+	void AABBBatch<T>::add(const Vector3<T>& center, const Vector3<T>& halfSize)
+	{
+		centerX.emplace_back(center.x);
+		centerY.emplace_back(center.y);
+		centerZ.emplace_back(center.z);
+		halfSizeX.emplace_back(halfSize.x);
+		halfSizeY.emplace_back(halfSize.y);
+		halfSizeZ.emplace_back(halfSize.z);
+	}
+
+	template <typename T>
+	size_t AABBBatch<T>::getSize() const noexcept
+	{
+		return centerX.size();
+	}
+
+	template <typename T>
+	AABB<T> AABBBatch<T>::get(size_t index) const noexcept
+	{
+		const Vector3<T> center(centerX[index], centerY[index], centerZ[index]);
+		const Vector3<T> halfSize(halfSizeX[index], halfSizeY[index], halfSizeZ[index]);
+
+		return AABB<T>(center - halfSize, center + halfSize);
+	}
+
 	template <typename T>
 	AABB<T> operator*(const Matrix3<T>& matrix, const AABB<T>& aabb)
 	{
@@ -54,4 +54,27 @@
 #error Invalid clipspace Z range
 #endif
 
+// SIMD instruction set used by the batch operations : by default the best one enabled by compiler flags
+// Define ATEMA_SIMD to ATEMA_SIMD_NONE to force the scalar implementations
+#define ATEMA_SIMD_NONE 0
+#define ATEMA_SIMD_SSE 1
+#define ATEMA_SIMD_AVX 2
+#define ATEMA_SIMD_NEON 3
+
+#ifndef ATEMA_SIMD
+	#if defined(__AVX__)
+		#define ATEMA_SIMD ATEMA_SIMD_AVX
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define ATEMA_SIMD ATEMA_SIMD_SSE
+	#elif defined(__ARM_NEON) || defined(_M_ARM64)
+		#define ATEMA_SIMD ATEMA_SIMD_NEON
+	#else
+		#define ATEMA_SIMD ATEMA_SIMD_NONE
+	#endif
+#endif
+
+#if ATEMA_SIMD != ATEMA_SIMD_NONE && ATEMA_SIMD != ATEMA_SIMD_SSE && ATEMA_SIMD != ATEMA_SIMD_AVX && ATEMA_SIMD != ATEMA_SIMD_NEON
+#error Invalid SIMD instruction set
+#endif
+
 #endif
\ No newline at end of file
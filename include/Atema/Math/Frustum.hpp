@@ -29,6 +29,8 @@
 #include <Atema/Math/AABB.hpp>
 #include <Atema/Math/Sphere.hpp>
 
+#include <vector>
+
 namespace at
 {
 	enum class FrustumPlane
@@ -81,6 +83,11 @@ namespace at
 		IntersectionType getIntersectionType(const AABB<T>& aabb) const noexcept;
 		IntersectionType getIntersectionType(const Sphere<T>& sphere) const noexcept;
 
+		// Batch versions of getIntersectionType : intersectionTypes is resized to the batch size
+		// Multiple elements are tested at once if SIMD instructions are available (see ATEMA_SIMD)
+		void getIntersectionTypes(const AABBBatch<T>& aabbs, std::vector<IntersectionType>& intersectionTypes) const;
+		void getIntersectionTypes(const SphereBatch<T>& spheres, std::vector<IntersectionType>& intersectionTypes) const;
+
 		const std::array<Plane<T>, 6>& getPlanes() const noexcept;
 		const std::array<Vector3<T>, 8>& getCorners() const noexcept;
 
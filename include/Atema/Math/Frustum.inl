@@ -23,6 +23,9 @@
 #define ATEMA_MATH_FRUSTUM_INL
 
 #include <Atema/Math/Frustum.hpp>
+#include <Atema/Math/Simd.hpp>
+
+#include <type_traits>
 
 namespace at
 {
@@ -62,6 +65,171 @@ namespace at
 
 			return line.point - line.direction * t;
 		}
+
+		// Batch tests use the center/half size representation of the AABBs
+		// The projection of the half size on the plane normal gives the AABB 'radius' relatively to this plane
+		template <typename T>
+		IntersectionType getBoxIntersectionType(const std::array<Plane<T>, 6>& planes, const AABBBatch<T>& aabbs, size_t index) noexcept
+		{
+			IntersectionType intersectionType = IntersectionType::Inside;
+
+			for (const auto& plane : planes)
+			{
+				const auto& normal = plane.getNormal();
+
+				const T distance = normal.x * aabbs.centerX[index] + normal.y * aabbs.centerY[index] + normal.z * aabbs.centerZ[index] - plane.getDistanceToOrigin();
+				const T radius = std::abs(normal.x) * aabbs.halfSizeX[index] + std::abs(normal.y) * aabbs.halfSizeY[index] + std::abs(normal.z) * aabbs.halfSizeZ[index];
+
+				if (distance + radius < static_cast<T>(0))
+					return IntersectionType::Outside;
+				else if (distance - radius < static_cast<T>(0))
+					intersectionType = IntersectionType::Intersection;
+			}
+
+			return intersectionType;
+		}
+
+		template <typename T>
+		IntersectionType getSphereIntersectionType(const std::array<Plane<T>, 6>& planes, const SphereBatch<T>& spheres, size_t index) noexcept
+		{
+			IntersectionType intersectionType = IntersectionType::Inside;
+
+			const T radius = spheres.radius[index];
+
+			for (const auto& plane : planes)
+			{
+				const auto& normal = plane.getNormal();
+
+				const T distance = normal.x * spheres.centerX[index] + normal.y * spheres.centerY[index] + normal.z * spheres.centerZ[index] - plane.getDistanceToOrigin();
+
+				if (distance + radius < static_cast<T>(0))
+					return IntersectionType::Outside;
+				else if (distance - radius < static_cast<T>(0))
+					intersectionType = IntersectionType::Intersection;
+			}
+
+			return intersectionType;
+		}
+
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		// Plane components broadcasted to every SIMD lane
+		struct SimdPlanes
+		{
+			SimdPlanes(const std::array<Planef, 6>& planes) noexcept
+			{
+				for (size_t i = 0; i < planes.size(); i++)
+				{
+					const auto& normal = planes[i].getNormal();
+
+					normalX[i] = Simd::set(normal.x);
+					normalY[i] = Simd::set(normal.y);
+					normalZ[i] = Simd::set(normal.z);
+					absNormalX[i] = Simd::set(std::abs(normal.x));
+					absNormalY[i] = Simd::set(std::abs(normal.y));
+					absNormalZ[i] = Simd::set(std::abs(normal.z));
+					distance[i] = Simd::set(planes[i].getDistanceToOrigin());
+				}
+			}
+
+			Simd::Float normalX[6];
+			Simd::Float normalY[6];
+			Simd::Float normalZ[6];
+			Simd::Float absNormalX[6];
+			Simd::Float absNormalY[6];
+			Simd::Float absNormalZ[6];
+			Simd::Float distance[6];
+		};
+
+		inline void setIntersectionTypes(uint32_t outsideMask, uint32_t intersectionMask, IntersectionType* intersectionTypes) noexcept
+		{
+			for (size_t i = 0; i < Simd::FloatSize; i++)
+			{
+				const uint32_t bit = 1u << i;
+
+				if (outsideMask & bit)
+					intersectionTypes[i] = IntersectionType::Outside;
+				else if (intersectionMask & bit)
+					intersectionTypes[i] = IntersectionType::Intersection;
+				else
+					intersectionTypes[i] = IntersectionType::Inside;
+			}
+		}
+
+		// Tests Simd::FloatSize AABBs at a time and returns the number of processed AABBs
+		// The remaining ones (less than Simd::FloatSize) must be tested by the caller
+		inline size_t getBoxIntersectionTypes(const std::array<Planef, 6>& planes, const AABBBatchf& aabbs, IntersectionType* intersectionTypes) noexcept
+		{
+			const size_t size = aabbs.getSize() - aabbs.getSize() % Simd::FloatSize;
+
+			const SimdPlanes simdPlanes(planes);
+			const auto zero = Simd::set(0.0f);
+
+			for (size_t index = 0; index < size; index += Simd::FloatSize)
+			{
+				const auto centerX = Simd::load(aabbs.centerX.data() + index);
+				const auto centerY = Simd::load(aabbs.centerY.data() + index);
+				const auto centerZ = Simd::load(aabbs.centerZ.data() + index);
+				const auto halfSizeX = Simd::load(aabbs.halfSizeX.data() + index);
+				const auto halfSizeY = Simd::load(aabbs.halfSizeY.data() + index);
+				const auto halfSizeZ = Simd::load(aabbs.halfSizeZ.data() + index);
+
+				auto outside = zero;
+				auto intersection = zero;
+
+				for (size_t i = 0; i < planes.size(); i++)
+				{
+					auto distance = Simd::add(Simd::mul(simdPlanes.normalX[i], centerX), Simd::mul(simdPlanes.normalY[i], centerY));
+					distance = Simd::add(distance, Simd::mul(simdPlanes.normalZ[i], centerZ));
+					distance = Simd::sub(distance, simdPlanes.distance[i]);
+
+					auto radius = Simd::add(Simd::mul(simdPlanes.absNormalX[i], halfSizeX), Simd::mul(simdPlanes.absNormalY[i], halfSizeY));
+					radius = Simd::add(radius, Simd::mul(simdPlanes.absNormalZ[i], halfSizeZ));
+
+					outside = Simd::maskOr(outside, Simd::lessThan(Simd::add(distance, radius), zero));
+					intersection = Simd::maskOr(intersection, Simd::lessThan(Simd::sub(distance, radius), zero));
+				}
+
+				setIntersectionTypes(Simd::getMask(outside), Simd::getMask(intersection), intersectionTypes + index);
+			}
+
+			return size;
+		}
+
+		// Tests Simd::FloatSize spheres at a time and returns the number of processed spheres
+		// The remaining ones (less than Simd::FloatSize) must be tested by the caller
+		inline size_t getSphereIntersectionTypes(const std::array<Planef, 6>& planes, const SphereBatchf& spheres, IntersectionType* intersectionTypes) noexcept
+		{
+			const size_t size = spheres.getSize() - spheres.getSize() % Simd::FloatSize;
+
+			const SimdPlanes simdPlanes(planes);
+			const auto zero = Simd::set(0.0f);
+
+			for (size_t index = 0; index < size; index += Simd::FloatSize)
+			{
+				const auto centerX = Simd::load(spheres.centerX.data() + index);
+				const auto centerY = Simd::load(spheres.centerY.data() + index);
+				const auto centerZ = Simd::load(spheres.centerZ.data() + index);
+				const auto radius = Simd::load(spheres.radius.data() + index);
+
+				auto outside = zero;
+				auto intersection = zero;
+
+				for (size_t i = 0; i < planes.size(); i++)
+				{
+					auto distance = Simd::add(Simd::mul(simdPlanes.normalX[i], centerX), Simd::mul(simdPlanes.normalY[i], centerY));
+					distance = Simd::add(distance, Simd::mul(simdPlanes.normalZ[i], centerZ));
+					distance = Simd::sub(distance, simdPlanes.distance[i]);
+
+					outside = Simd::maskOr(outside, Simd::lessThan(Simd::add(distance, radius), zero));
+					intersection = Simd::maskOr(intersection, Simd::lessThan(Simd::sub(distance, radius), zero));
+				}
+
+				setIntersectionTypes(Simd::getMask(outside), Simd::getMask(intersection), intersectionTypes + index);
+			}
+
+			return size;
+		}
+#endif
 	}
 
 	template <typename T>
@@ -285,6 +453,42 @@ namespace at
 		return intersectionType;
 	}
 
+	template <typename T>
+	void Frustum<T>::getIntersectionTypes(const AABBBatch<T>& aabbs, std::vector<IntersectionType>& intersectionTypes) const
+	{
+		const auto size = aabbs.getSize();
+
+		intersectionTypes.resize(size);
+
+		size_t index = 0;
+
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		if constexpr (std::is_same_v<T, float>)
+			index = getBoxIntersectionTypes(m_planes, aabbs, intersectionTypes.data());
+#endif
+
+		for (; index < size; index++)
+			intersectionTypes[index] = getBoxIntersectionType(m_planes, aabbs, index);
+	}
+
+	template <typename T>
+	void Frustum<T>::getIntersectionTypes(const SphereBatch<T>& spheres, std::vector<IntersectionType>& intersectionTypes) const
+	{
+		const auto size = spheres.getSize();
+
+		intersectionTypes.resize(size);
+
+		size_t index = 0;
+
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		if constexpr (std::is_same_v<T, float>)
+			index = getSphereIntersectionTypes(m_planes, spheres, intersectionTypes.data());
+#endif
+
+		for (; index < size; index++)
+			intersectionTypes[index] = getSphereIntersectionType(m_planes, spheres, index);
+	}
+
 	template <typename T>
 	const std::array<Plane<T>, 6>& Frustum<T>::getPlanes() const noexcept
 	{
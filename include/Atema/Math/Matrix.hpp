@@ -163,6 +163,10 @@ namespace at
 		Vector3<T> transformPosition(const Vector3<T>& position) const;
 		Vector3<T> transformVector(const Vector3<T>& vector) const;
 
+		// Batch versions : transform in place 'count' elements separated by 'stride' bytes
+		void transformPositions(Vector3<T>* positions, size_t count, size_t stride = sizeof(Vector3<T>)) const;
+		void transformVectors(Vector3<T>* vectors, size_t count, size_t stride = sizeof(Vector3<T>)) const;
+
 		T getDeterminant() const noexcept;
 
 		bool isInvertible() const noexcept;
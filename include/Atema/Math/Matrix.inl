@@ -25,9 +25,163 @@
 #include <Atema/Math/Matrix.hpp>
 #include <Atema/Core/Error.hpp>
 #include <Atema/Math/Quaternion.hpp>
+#include <Atema/Math/Simd.hpp>
+
+#include <type_traits>
 
 namespace at
 {
+	namespace detail
+	{
+		template <size_t COL, size_t ROW, typename T>
+		constexpr bool IsSimdMatrix4 = ATEMA_SIMD != ATEMA_SIMD_NONE && COL == 4 && ROW == 4 && std::is_same_v<T, float>;
+
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		// SIMD implementations for 4x4 float matrices (stored as 4 contiguous columns)
+		// They perform the same operations in the same order as the scalar ones, so the results are identical
+
+		inline Simd::Float4 multiplyMatrix4(const Simd::Float4 (&columns)[4], Simd::Float4 vector) noexcept
+		{
+			auto result = Simd::mul4(columns[0], Simd::broadcast4<0>(vector));
+			result = Simd::add4(result, Simd::mul4(columns[1], Simd::broadcast4<1>(vector)));
+			result = Simd::add4(result, Simd::mul4(columns[2], Simd::broadcast4<2>(vector)));
+			result = Simd::add4(result, Simd::mul4(columns[3], Simd::broadcast4<3>(vector)));
+
+			return result;
+		}
+
+		inline void loadMatrix4(const float* matrix, Simd::Float4 (&columns)[4]) noexcept
+		{
+			for (size_t i = 0; i < 4; i++)
+				columns[i] = Simd::load4(matrix + i * 4);
+		}
+
+		inline void multiplyMatrix4(const float* matrix, const float* other, float* result) noexcept
+		{
+			Simd::Float4 columns[4];
+			loadMatrix4(matrix, columns);
+
+			for (size_t i = 0; i < 16; i += 4)
+				Simd::store4(result + i, multiplyMatrix4(columns, Simd::load4(other + i)));
+		}
+
+		inline void multiplyMatrix4Vector(const float* matrix, const float* vector, float* result) noexcept
+		{
+			Simd::Float4 columns[4];
+			loadMatrix4(matrix, columns);
+
+			Simd::store4(result, multiplyMatrix4(columns, Simd::load4(vector)));
+		}
+
+		inline void transposeMatrix4(const float* matrix, float* result) noexcept
+		{
+			Simd::Float4 columns[4];
+			loadMatrix4(matrix, columns);
+
+			Simd::transpose4(columns[0], columns[1], columns[2], columns[3]);
+
+			for (size_t i = 0; i < 4; i++)
+				Simd::store4(result + i * 4, columns[i]);
+		}
+
+		// Vector3 elements separated by 'stride' bytes, transformed in place with the given w component
+		inline void transformMatrix4(const float* matrix, float w, uint8_t* vectors, size_t count, size_t stride) noexcept
+		{
+			Simd::Float4 columns[4];
+			loadMatrix4(matrix, columns);
+
+			float result[4];
+
+			for (size_t i = 0; i < count; i++)
+			{
+				auto vector = reinterpret_cast<float*>(vectors + i * stride);
+
+				Simd::store4(result, multiplyMatrix4(columns, Simd::set4(vector[0], vector[1], vector[2], w)));
+
+				vector[0] = result[0];
+				vector[1] = result[1];
+				vector[2] = result[2];
+			}
+		}
+
+		// Factors used by the inverse : (c2[R1] * c3[R2] - c3[R1] * c2[R2]) twice, (c1[R1] * c3[R2] - c3[R1] * c1[R2]), (c1[R1] * c2[R2] - c2[R1] * c1[R2])
+		template <int R1, int R2>
+		inline Simd::Float4 getInverseFactor(const Simd::Float4 (&columns)[4]) noexcept
+		{
+			const auto a = Simd::shuffle4<R1, R1, R1, R1>(columns[2], columns[1]);
+			const auto d = Simd::shuffle4<R2, R2, R2, R2>(columns[2], columns[1]);
+
+			auto b = Simd::shuffle4<R2, R2, R2, R2>(columns[3], columns[2]);
+			b = Simd::shuffle4<0, 0, 0, 2>(b, b);
+
+			auto c = Simd::shuffle4<R1, R1, R1, R1>(columns[3], columns[2]);
+			c = Simd::shuffle4<0, 0, 0, 2>(c, c);
+
+			return Simd::sub4(Simd::mul4(a, b), Simd::mul4(c, d));
+		}
+
+		// (c1[R], c0[R], c0[R], c0[R])
+		template <int R>
+		inline Simd::Float4 getInverseVector(const Simd::Float4 (&columns)[4]) noexcept
+		{
+			const auto tmp = Simd::shuffle4<R, R, R, R>(columns[1], columns[0]);
+
+			return Simd::shuffle4<0, 2, 2, 2>(tmp, tmp);
+		}
+
+		// Writes the inverse and returns the determinant
+		inline float inverseMatrix4(const float* matrix, float* result) noexcept
+		{
+			Simd::Float4 columns[4];
+			loadMatrix4(matrix, columns);
+
+			const auto fac0 = getInverseFactor<2, 3>(columns);
+			const auto fac1 = getInverseFactor<1, 3>(columns);
+			const auto fac2 = getInverseFactor<1, 2>(columns);
+			const auto fac3 = getInverseFactor<0, 3>(columns);
+			const auto fac4 = getInverseFactor<0, 2>(columns);
+			const auto fac5 = getInverseFactor<0, 1>(columns);
+
+			const auto vec0 = getInverseVector<0>(columns);
+			const auto vec1 = getInverseVector<1>(columns);
+			const auto vec2 = getInverseVector<2>(columns);
+			const auto vec3 = getInverseVector<3>(columns);
+
+			const auto inv0 = Simd::add4(Simd::sub4(Simd::mul4(vec1, fac0), Simd::mul4(vec2, fac1)), Simd::mul4(vec3, fac2));
+			const auto inv1 = Simd::add4(Simd::sub4(Simd::mul4(vec0, fac0), Simd::mul4(vec2, fac3)), Simd::mul4(vec3, fac4));
+			const auto inv2 = Simd::add4(Simd::sub4(Simd::mul4(vec0, fac1), Simd::mul4(vec1, fac3)), Simd::mul4(vec3, fac5));
+			const auto inv3 = Simd::add4(Simd::sub4(Simd::mul4(vec0, fac2), Simd::mul4(vec1, fac4)), Simd::mul4(vec2, fac5));
+
+			const auto signA = Simd::set4(1.0f, -1.0f, 1.0f, -1.0f);
+			const auto signB = Simd::set4(-1.0f, 1.0f, -1.0f, 1.0f);
+
+			const Simd::Float4 inverse[4] =
+			{
+				Simd::mul4(inv0, signA),
+				Simd::mul4(inv1, signB),
+				Simd::mul4(inv2, signA),
+				Simd::mul4(inv3, signB)
+			};
+
+			const auto row01 = Simd::shuffle4<0, 0, 0, 0>(inverse[0], inverse[1]);
+			const auto row23 = Simd::shuffle4<0, 0, 0, 0>(inverse[2], inverse[3]);
+			const auto row0 = Simd::shuffle4<0, 2, 0, 2>(row01, row23);
+
+			float dot0[4];
+			Simd::store4(dot0, Simd::mul4(columns[0], row0));
+
+			const float determinant = (dot0[0] + dot0[1]) + (dot0[2] + dot0[3]);
+
+			const auto oneOverDeterminant = Simd::set4(1.0f / determinant);
+
+			for (size_t i = 0; i < 4; i++)
+				Simd::store4(result + i * 4, Simd::mul4(inverse[i], oneOverDeterminant));
+
+			return determinant;
+		}
+#endif
+	}
+
 	template <size_t COL, size_t ROW, typename T>
 	Matrix<COL, ROW, T>::Matrix()
 	{
@@ -62,6 +216,15 @@ namespace at
 	{
 		Matrix<ROW, COL, T> tmp;
 
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		if constexpr (detail::IsSimdMatrix4<COL, ROW, T>)
+		{
+			detail::transposeMatrix4(get(), tmp.get());
+
+			return tmp;
+		}
+#endif
+
 		for (size_t c = 0; c < COL; c++)
 			for (size_t r = 0; r < ROW; r++)
 				tmp[r][c] = this->m_columns[c][r];
@@ -97,12 +260,28 @@ namespace at
 	{
 		Matrix<OTHER_COL, ROW, T> tmp;
 
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		if constexpr (detail::IsSimdMatrix4<COL, ROW, T> && OTHER_COL == 4)
+		{
+			detail::multiplyMatrix4(get(), value.get(), tmp.get());
+
+			return tmp;
+		}
+#endif
+
 		for (size_t tmpCol = 0; tmpCol < OTHER_COL; tmpCol++)
 		{
+			const auto& valueColumn = value[tmpCol];
+			auto& tmpColumn = tmp[tmpCol];
+
 			for (size_t row = 0; row < ROW; row++)
 			{
-				for (size_t col = 0; col < COL; col++)
-					tmp[tmpCol][row] += this->m_columns[col][row] * value[tmpCol][col];
+				T result = this->m_columns[0].data[row] * valueColumn.data[0];
+
+				for (size_t col = 1; col < COL; col++)
+					result += this->m_columns[col].data[row] * valueColumn.data[col];
+
+				tmpColumn.data[row] = result;
 			}
 		}
 
@@ -114,12 +293,23 @@ namespace at
 	{
 		Vector<ROW, T> tmp;
 
-		for (size_t t_r = 0; t_r < ROW; t_r++)
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		if constexpr (detail::IsSimdMatrix4<COL, ROW, T>)
 		{
-			for (size_t t_c = 0; t_c < COL; t_c++)
-			{
-				tmp[t_r] += this->m_columns[t_c][t_r] * value[t_c];
-			}
+			detail::multiplyMatrix4Vector(get(), value.data.data(), tmp.data.data());
+
+			return tmp;
+		}
+#endif
+
+		for (size_t row = 0; row < ROW; row++)
+		{
+			T result = this->m_columns[0].data[row] * value.data[0];
+
+			for (size_t col = 1; col < COL; col++)
+				result += this->m_columns[col].data[row] * value.data[col];
+
+			tmp.data[row] = result;
 		}
 
 		return tmp;
@@ -244,13 +434,13 @@ namespace at
 	template <size_t COL, size_t ROW, typename T>
 	T* Matrix<COL, ROW, T>::get()
 	{
-		return this->m_data;
+		return this->m_data.data();
 	}
 
 	template <size_t COL, size_t ROW, typename T>
 	const T* Matrix<COL, ROW, T>::get() const
 	{
-		return this->m_data;
+		return this->m_data.data();
 	}
 
 	//----- Matrix2f -----//
@@ -371,7 +561,7 @@ namespace at
 	template <typename T>
 	Matrix2<T>& Matrix2<T>::inverse()
 	{
-		std::swap(*this, createInverse());
+		*this = createInverse();
 
 		return *this;
 	}
@@ -522,7 +712,7 @@ namespace at
 	template <typename T>
 	Matrix3<T>& Matrix3<T>::inverse()
 	{
-		std::swap(*this, createInverse());
+		*this = createInverse();
 
 		return *this;
 	}
@@ -613,7 +803,7 @@ namespace at
 	{
 		Vector4<T> tmp(position.x, position.y, position.z, static_cast<T>(1));
 
-		tmp = operator*(tmp);
+		tmp = Matrix<4, 4, T>::operator*(tmp);
 
 		return { tmp.x, tmp.y, tmp.z };
 	}
@@ -623,14 +813,60 @@ namespace at
 	{
 		Vector4<T> tmp(vector.x, vector.y, vector.z, static_cast<T>(0));
 
-		tmp = operator*(tmp);
+		tmp = Matrix<4, 4, T>::operator*(tmp);
 
 		return { tmp.x, tmp.y, tmp.z };
 	}
 
+	template <typename T>
+	void Matrix4<T>::transformPositions(Vector3<T>* positions, size_t count, size_t stride) const
+	{
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		if constexpr (detail::IsSimdMatrix4<4, 4, T>)
+		{
+			detail::transformMatrix4(this->get(), 1.0f, reinterpret_cast<uint8_t*>(positions), count, stride);
+
+			return;
+		}
+#endif
+
+		auto data = reinterpret_cast<uint8_t*>(positions);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			auto& position = *reinterpret_cast<Vector3<T>*>(data + i * stride);
+
+			position = transformPosition(position);
+		}
+	}
+
+	template <typename T>
+	void Matrix4<T>::transformVectors(Vector3<T>* vectors, size_t count, size_t stride) const
+	{
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		if constexpr (detail::IsSimdMatrix4<4, 4, T>)
+		{
+			detail::transformMatrix4(this->get(), 0.0f, reinterpret_cast<uint8_t*>(vectors), count, stride);
+
+			return;
+		}
+#endif
+
+		auto data = reinterpret_cast<uint8_t*>(vectors);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			auto& vector = *reinterpret_cast<Vector3<T>*>(data + i * stride);
+
+			vector = transformVector(vector);
+		}
+	}
+
 	template<typename T>
 	inline T Matrix4<T>::getDeterminant() const noexcept
 	{
+		const auto& m = *this;
+
 		T coef00 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
 		T coef02 = m[1][2] * m[3][3] - m[3][2] * m[1][3];
 		T coef03 = m[1][2] * m[2][3] - m[2][2] * m[1][3];
@@ -699,7 +935,7 @@ namespace at
 	template <typename T>
 	Matrix4<T> Matrix4<T>::createTranslation(const Vector3<T>& offset)
 	{
-		Matrix4<T> m = createIdentity();
+		Matrix4<T> m = Matrix<4, 4, T>::createIdentity();
 
 		m[3].x = offset.x;
 		m[3].y = offset.y;
@@ -774,7 +1010,7 @@ namespace at
 		s.normalize();
 		u = cross(s, f);
 
-		Matrix4<T> mat = createIdentity();
+		Matrix4<T> mat = Matrix<4, 4, T>::createIdentity();
 
 		mat[0][0] = s.x;
 		mat[1][0] = s.y;
@@ -851,6 +1087,19 @@ namespace at
 	template <typename T>
 	Matrix4<T> Matrix4<T>::createInverse(const Matrix4<T>& m)
 	{
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		if constexpr (detail::IsSimdMatrix4<4, 4, T>)
+		{
+			Matrix4<T> inverse;
+
+			const auto determinant = detail::inverseMatrix4(m.get(), inverse.get());
+
+			ATEMA_ASSERT(std::abs(determinant) > Math::Epsilon<T>, "The matrix must be invertible");
+
+			return inverse;
+		}
+#endif
+
 		T coef00 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
 		T coef02 = m[1][2] * m[3][3] - m[3][2] * m[1][3];
 		T coef03 = m[1][2] * m[2][3] - m[2][2] * m[1][3];
@@ -907,7 +1156,7 @@ namespace at
 		Vector4<T> dot0(m[0] * row0);
 		T dot1 = (dot0.x + dot0.y) + (dot0.z + dot0.w);
 
-		ATEMA_ASSERT(std::abs(getDeterminant()) > Math::Epsilon<T>, "The matrix must be invertible");
+		ATEMA_ASSERT(std::abs(dot1) > Math::Epsilon<T>, "The matrix must be invertible");
 
 		T oneOverDeterminant = static_cast<T>(1) / dot1;
 
@@ -923,7 +1172,7 @@ namespace at
 	template <typename T>
 	Matrix4<T>& Matrix4<T>::inverse()
 	{
-		std::swap(*this, createInverse());
+		*this = createInverse();
 
 		return *this;
 	}
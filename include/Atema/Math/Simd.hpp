@@ -0,0 +1,223 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ATEMA_MATH_SIMD_HPP
+#define ATEMA_MATH_SIMD_HPP
+
+#include <Atema/Math/Config.hpp>
+
+#include <cstdint>
+
+#if ATEMA_SIMD == ATEMA_SIMD_AVX
+#include <immintrin.h>
+#elif ATEMA_SIMD == ATEMA_SIMD_SSE
+#include <emmintrin.h>
+#elif ATEMA_SIMD == ATEMA_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// Thin wrapper over the float (and a few integer) intrinsics of the instruction set selected by ATEMA_SIMD
+// Only defined when a SIMD instruction set is available (ATEMA_SIMD != ATEMA_SIMD_NONE)
+namespace at
+{
+	namespace Simd
+	{
+		//----- Float4 : 4 floats, whatever the instruction set (AVX uses the SSE ones) -----//
+#if ATEMA_SIMD == ATEMA_SIMD_AVX || ATEMA_SIMD == ATEMA_SIMD_SSE
+
+		using Float4 = __m128;
+
+		inline Float4 load4(const float* values) noexcept { return _mm_loadu_ps(values); }
+		inline void store4(float* values, Float4 a) noexcept { _mm_storeu_ps(values, a); }
+		inline Float4 set4(float value) noexcept { return _mm_set1_ps(value); }
+		inline Float4 set4(float x, float y, float z, float w) noexcept { return _mm_setr_ps(x, y, z, w); }
+
+		inline Float4 add4(Float4 a, Float4 b) noexcept { return _mm_add_ps(a, b); }
+		inline Float4 sub4(Float4 a, Float4 b) noexcept { return _mm_sub_ps(a, b); }
+		inline Float4 mul4(Float4 a, Float4 b) noexcept { return _mm_mul_ps(a, b); }
+
+		inline float getX(Float4 a) noexcept { return _mm_cvtss_f32(a); }
+
+		// Returns (a[X], a[Y], b[Z], b[W])
+		template <int X, int Y, int Z, int W>
+		inline Float4 shuffle4(Float4 a, Float4 b) noexcept { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+		// Returns (a[Lane], a[Lane], a[Lane], a[Lane])
+		template <int Lane>
+		inline Float4 broadcast4(Float4 a) noexcept { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+
+		inline void transpose4(Float4& a, Float4& b, Float4& c, Float4& d) noexcept { _MM_TRANSPOSE4_PS(a, b, c, d); }
+
+#elif ATEMA_SIMD == ATEMA_SIMD_NEON
+
+		using Float4 = float32x4_t;
+
+		inline Float4 load4(const float* values) noexcept { return vld1q_f32(values); }
+		inline void store4(float* values, Float4 a) noexcept { vst1q_f32(values, a); }
+		inline Float4 set4(float value) noexcept { return vdupq_n_f32(value); }
+		inline Float4 set4(float x, float y, float z, float w) noexcept
+		{
+			const float values[4] = { x, y, z, w };
+
+			return vld1q_f32(values);
+		}
+
+		inline Float4 add4(Float4 a, Float4 b) noexcept { return vaddq_f32(a, b); }
+		inline Float4 sub4(Float4 a, Float4 b) noexcept { return vsubq_f32(a, b); }
+		inline Float4 mul4(Float4 a, Float4 b) noexcept { return vmulq_f32(a, b); }
+		inline float getX(Float4 a) noexcept { return vgetq_lane_f32(a, 0); }
+
+		// Returns (a[X], a[Y], b[Z], b[W])
+		template <int X, int Y, int Z, int W>
+		inline Float4 shuffle4(Float4 a, Float4 b) noexcept
+		{
+			Float4 result = vdupq_n_f32(vgetq_lane_f32(a, X));
+			result = vsetq_lane_f32(vgetq_lane_f32(a, Y), result, 1);
+			result = vsetq_lane_f32(vgetq_lane_f32(b, Z), result, 2);
+			result = vsetq_lane_f32(vgetq_lane_f32(b, W), result, 3);
+
+			return result;
+		}
+		// Returns (a[Lane], a[Lane], a[Lane], a[Lane])
+		template <int Lane>
+		inline Float4 broadcast4(Float4 a) noexcept { return vdupq_n_f32(vgetq_lane_f32(a, Lane)); }
+
+		inline void transpose4(Float4& a, Float4& b, Float4& c, Float4& d) noexcept
+		{
+			const float32x4x2_t ab = vtrnq_f32(a, b);
+			const float32x4x2_t cd = vtrnq_f32(c, d);
+
+			a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+			b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+			c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+			d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+		}
+
+#endif
+
+		//----- Float : widest float vector of the instruction set -----//
+#if ATEMA_SIMD == ATEMA_SIMD_AVX
+
+		using Float = __m256;
+
+		constexpr size_t FloatSize = 8;
+
+		inline Float load(const float* values) noexcept { return _mm256_loadu_ps(values); }
+		inline void store(float* values, Float a) noexcept { _mm256_storeu_ps(values, a); }
+		inline Float set(float value) noexcept { return _mm256_set1_ps(value); }
+
+		inline Float add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+		inline Float sub(Float a, Float b) noexcept { return _mm256_sub_ps(a, b); }
+		inline Float mul(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+		inline Float min(Float a, Float b) noexcept { return _mm256_min_ps(a, b); }
+		inline Float max(Float a, Float b) noexcept { return _mm256_max_ps(a, b); }
+
+		// Comparisons return a mask with all bits set in each lane where the condition is true
+		inline Float lessThan(Float a, Float b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		inline Float maskOr(Float a, Float b) noexcept { return _mm256_or_ps(a, b); }
+		// Returns one bit per lane (lane i => bit i)
+		inline uint32_t getMask(Float a) noexcept { return static_cast<uint32_t>(_mm256_movemask_ps(a)); }
+
+#elif ATEMA_SIMD == ATEMA_SIMD_SSE
+
+		using Float = __m128;
+
+		constexpr size_t FloatSize = 4;
+
+		inline Float load(const float* values) noexcept { return _mm_loadu_ps(values); }
+		inline void store(float* values, Float a) noexcept { _mm_storeu_ps(values, a); }
+		inline Float set(float value) noexcept { return _mm_set1_ps(value); }
+
+		inline Float add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+		inline Float sub(Float a, Float b) noexcept { return _mm_sub_ps(a, b); }
+		inline Float mul(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+		inline Float min(Float a, Float b) noexcept { return _mm_min_ps(a, b); }
+		inline Float max(Float a, Float b) noexcept { return _mm_max_ps(a, b); }
+
+		// Comparisons return a mask with all bits set in each lane where the condition is true
+		inline Float lessThan(Float a, Float b) noexcept { return _mm_cmplt_ps(a, b); }
+		inline Float maskOr(Float a, Float b) noexcept { return _mm_or_ps(a, b); }
+		// Returns one bit per lane (lane i => bit i)
+		inline uint32_t getMask(Float a) noexcept { return static_cast<uint32_t>(_mm_movemask_ps(a)); }
+
+#elif ATEMA_SIMD == ATEMA_SIMD_NEON
+
+		using Float = float32x4_t;
+
+		constexpr size_t FloatSize = 4;
+
+		inline Float load(const float* values) noexcept { return vld1q_f32(values); }
+		inline void store(float* values, Float a) noexcept { vst1q_f32(values, a); }
+		inline Float set(float value) noexcept { return vdupq_n_f32(value); }
+
+		inline Float add(Float a, Float b) noexcept { return vaddq_f32(a, b); }
+		inline Float sub(Float a, Float b) noexcept { return vsubq_f32(a, b); }
+		inline Float mul(Float a, Float b) noexcept { return vmulq_f32(a, b); }
+		inline Float min(Float a, Float b) noexcept { return vminq_f32(a, b); }
+		inline Float max(Float a, Float b) noexcept { return vmaxq_f32(a, b); }
+
+		// Comparisons return a mask with all bits set in each lane where the condition is true
+		inline Float lessThan(Float a, Float b) noexcept { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+		inline Float maskOr(Float a, Float b) noexcept { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+		// Returns one bit per lane (lane i => bit i)
+		inline uint32_t getMask(Float a) noexcept
+		{
+			const uint32x4_t signs = vshrq_n_u32(vreinterpretq_u32_f32(a), 31);
+
+			return vgetq_lane_u32(signs, 0)
+				| (vgetq_lane_u32(signs, 1) << 1)
+				| (vgetq_lane_u32(signs, 2) << 2)
+				| (vgetq_lane_u32(signs, 3) << 3);
+		}
+
+#endif
+
+		//----- Integers -----//
+#if ATEMA_SIMD == ATEMA_SIMD_AVX || ATEMA_SIMD == ATEMA_SIMD_SSE
+
+		// Adds 16 bytes of a & b after widening them : result[i] = a[i] + b[i]
+		inline void addWiden16(const uint8_t* a, const uint8_t* b, uint16_t* result) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i valuesA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+			const __m128i valuesB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(result), _mm_add_epi16(_mm_unpacklo_epi8(valuesA, zero), _mm_unpacklo_epi8(valuesB, zero)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(result + 8), _mm_add_epi16(_mm_unpackhi_epi8(valuesA, zero), _mm_unpackhi_epi8(valuesB, zero)));
+		}
+
+#elif ATEMA_SIMD == ATEMA_SIMD_NEON
+
+		// Adds 16 bytes of a & b after widening them : result[i] = a[i] + b[i]
+		inline void addWiden16(const uint8_t* a, const uint8_t* b, uint16_t* result) noexcept
+		{
+			const uint8x16_t valuesA = vld1q_u8(a);
+			const uint8x16_t valuesB = vld1q_u8(b);
+
+			vst1q_u16(result, vaddl_u8(vget_low_u8(valuesA), vget_low_u8(valuesB)));
+			vst1q_u16(result + 8, vaddl_u8(vget_high_u8(valuesA), vget_high_u8(valuesB)));
+		}
+
+#endif
+	}
+}
+
+#endif
@@ -25,6 +25,8 @@
 #include <Atema/Math/Config.hpp>
 #include <Atema/Math/Vector.hpp>
 
+#include <vector>
+
 namespace at
 {
 	template <typename T>
@@ -59,6 +61,39 @@ namespace at
 	using Sphereu = Sphere<unsigned>;
 	using Spheref = Sphere<float>;
 	using Sphered = Sphere<double>;
+
+	// Structure of arrays storage of spheres
+	// Used by batch operations, like Frustum::getIntersectionTypes
+	template <typename T>
+	class SphereBatch
+	{
+	public:
+		SphereBatch() = default;
+		SphereBatch(const SphereBatch& other) = default;
+		SphereBatch(SphereBatch&& other) noexcept = default;
+		~SphereBatch() = default;
+
+		void reserve(size_t size);
+		void clear() noexcept;
+
+		void add(const Sphere<T>& sphere);
+		void add(const Vector3<T>& center, T radius);
+
+		size_t getSize() const noexcept;
+
+		Sphere<T> get(size_t index) const noexcept;
+
+		SphereBatch& operator=(const SphereBatch& other) = default;
+		SphereBatch& operator=(SphereBatch&& other) noexcept = default;
+
+		std::vector<T> centerX;
+		std::vector<T> centerY;
+		std::vector<T> centerZ;
+		std::vector<T> radius;
+	};
+
+	using SphereBatchf = SphereBatch<float>;
+	using SphereBatchd = SphereBatch<double>;
 }
 
 #include <Atema/Math/Sphere.inl>
@@ -89,6 +89,51 @@ namespace at
 		
 		return AABB<T>(center - halfVector, center + halfVector);
 	}
+
+	template <typename T>
+	void SphereBatch<T>::reserve(size_t size)
+	{
+		centerX.reserve(size);
+		centerY.reserve(size);
+		centerZ.reserve(size);
+		radius.reserve(size);
+	}
+
+	template <typename T>
+	void SphereBatch<T>::clear() noexcept
+	{
+		centerX.clear();
+		centerY.clear();
+		centerZ.clear();
+		radius.clear();
+	}
+
+	template <typename T>
+	void SphereBatch<T>::add(const Sphere<T>& sphere)
+	{
+		add(sphere.center, sphere.radius);
+	}
+
+	template <typename T>
+	void SphereBatch<T>::add(const Vector3<T>& center, T radius)
+	{
+		centerX.emplace_back(center.x);
+		centerY.emplace_back(center.y);
+		centerZ.emplace_back(center.z);
+		this->radius.emplace_back(radius);
+	}
+
+	template <typename T>
+	size_t SphereBatch<T>::getSize() const noexcept
+	{
+		return centerX.size();
+	}
+
+	template <typename T>
+	Sphere<T> SphereBatch<T>::get(size_t index) const noexcept
+	{
+		return Sphere<T>(Vector3<T>(centerX[index], centerY[index], centerZ[index]), radius[index]);
+	}
 }
 
 #endif
\ No newline at end of file
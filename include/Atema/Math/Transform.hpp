@@ -24,40 +24,58 @@
 
 #include <Atema/Math/Config.hpp>
 #include <Atema/Math/Matrix.hpp>
+#include <Atema/Math/Quaternion.hpp>
 #include <Atema/Math/Vector.hpp>
 
 namespace at
 {
+	// Local transformation : translation, rotation & scale
+	// The matrix is rebuilt every time a component changes, so const accesses are thread-safe
 	class ATEMA_MATH_API Transform
 	{
 	public:
 		Transform();
+		Transform(const Vector3f& translation, const Quaternionf& rotation, const Vector3f& scale);
+		// rotation : Euler angles
 		Transform(const Vector3f& translation, const Vector3f& rotation, const Vector3f& scale);
+		Transform(const Transform& other) = default;
+		Transform(Transform&& other) noexcept = default;
 		~Transform();
 
 		Transform& translate(const Vector3f& translation);
+		// The rotation is applied after the current one
+		Transform& rotate(const Quaternionf& rotation);
+		// rotation : Euler angles
 		Transform& rotate(const Vector3f& rotation);
 		Transform& scale(const Vector3f& scale);
 
+		void set(const Vector3f& translation, const Quaternionf& rotation, const Vector3f& scale);
+		// rotation : Euler angles
 		void set(const Vector3f& translation, const Vector3f& rotation, const Vector3f& scale);
-		
+
 		void setTranslation(const Vector3f& translation);
+		void setRotation(const Quaternionf& rotation);
+		// rotation : Euler angles
 		void setRotation(const Vector3f& rotation);
 		void setScale(const Vector3f& scale);
 
 		const Vector3f& getTranslation() const noexcept;
-		const Vector3f& getRotation() const noexcept;
+		const Quaternionf& getRotation() const noexcept;
 		const Vector3f& getScale() const noexcept;
 
 		const Matrix4f& getMatrix() const noexcept;
 
+		Transform& operator=(const Transform& other) = default;
+		Transform& operator=(Transform&& other) noexcept = default;
+
 	private:
+		void updateMatrix();
+
 		Vector3f m_translation;
-		Vector3f m_rotation;
+		Quaternionf m_rotation;
 		Vector3f m_scale;
 
-		mutable bool m_transformValid;
-		mutable Matrix4f m_transform;
+		Matrix4f m_matrix;
 	};
 }
 
@@ -197,7 +197,7 @@ namespace at
 	template <typename ... Args>
 	Vector<N, T>::Vector(Args&&... args): Vector()
 	{
-		set(std::forward<Args>(args)...);
+		this->set(std::forward<Args>(args)...);
 	}
 
 	template <size_t N, typename T>
@@ -29,6 +29,7 @@
 #include <Atema/Renderer/Config.hpp>
 #include <Atema/Renderer/CommandBuffer.hpp>
 #include <Atema/Renderer/CommandPool.hpp>
+#include <Atema/Renderer/ComputePipeline.hpp>
 #include <Atema/Renderer/DepthStencil.hpp>
 #include <Atema/Renderer/DescriptorSet.hpp>
 #include <Atema/Renderer/DescriptorSetLayout.hpp>
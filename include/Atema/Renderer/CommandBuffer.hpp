@@ -38,6 +38,7 @@ namespace at
 	class Viewport;
 	class Buffer;
 	class CommandPool;
+	class ComputePipeline;
 	class DescriptorSet;
 	class Framebuffer;
 	class GraphicsPipeline;
@@ -68,6 +69,8 @@ namespace at
 
 		virtual void bindPipeline(const GraphicsPipeline& pipeline) = 0;
 
+		virtual void bindPipeline(const ComputePipeline& pipeline) = 0;
+
 		virtual void setViewport(const Viewport& viewport) = 0;
 		
 		virtual void setScissor(const Vector2i& position, const Vector2u& size) = 0;
@@ -79,6 +82,7 @@ namespace at
 		virtual void copyBuffer(const Buffer& srcBuffer, Buffer& dstBuffer, size_t size, size_t srcOffset = 0, size_t dstOffset = 0) = 0;
 
 		// Copy buffer data to an image
+		// For cubemaps, dstLayer is the array layer (6 per cubemap)
 		// dstLayout must either be ImageLayout::TransferDst or ImageLayout::General
 		virtual void copyBufferToImage(const Buffer& srcBuffer, Image& dstImage, ImageLayout dstLayout, size_t srcOffset = 0, uint32_t dstMipLevel = 0, uint32_t dstLayer = 0) = 0;
 
@@ -86,6 +90,11 @@ namespace at
 		// dstLayout must either be ImageLayout::TransferDst or ImageLayout::General
 		virtual void copyBufferToCubemap(const Buffer& srcBuffer, Image& dstImage, ImageLayout dstLayout, uint32_t dstMipLevel = 0) = 0;
 
+		// Copy an image layer to buffer data (tightly packed)
+		// For cubemaps, srcLayer is the array layer (6 per cubemap)
+		// srcLayout must either be ImageLayout::TransferSrc or ImageLayout::General
+		virtual void copyImageToBuffer(const Image& srcImage, ImageLayout srcLayout, Buffer& dstBuffer, size_t dstOffset = 0, uint32_t srcMipLevel = 0, uint32_t srcLayer = 0) = 0;
+
 		// Copy some image layers to another image layers
 		// srcLayout must either be ImageLayout::TransferSrc or ImageLayout::General
 		// dstLayout must either be ImageLayout::TransferDst or ImageLayout::General
@@ -107,6 +116,9 @@ namespace at
 
 		virtual void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) = 0;
 
+		// Dispatch compute workgroups, the pipeline must be bound outside of a render pass
+		virtual void dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) = 0;
+
 		void memoryBarrier(MemoryBarrier barrier);
 		virtual void memoryBarrier(Flags<PipelineStage> srcPipelineStages, Flags<MemoryAccess> srcMemoryAccesses, Flags<PipelineStage> dstPipelineStages, Flags<MemoryAccess> dstMemoryAccesses) = 0;
 
@@ -0,0 +1,77 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_RENDERER_COMPUTEPIPELINE_HPP
+#define ATEMA_RENDERER_COMPUTEPIPELINE_HPP
+
+#include <Atema/Renderer/Config.hpp>
+#include <Atema/Core/NonCopyable.hpp>
+#include <Atema/Core/Pointer.hpp>
+#include <Atema/Renderer/DescriptorSetLayout.hpp>
+
+#include <vector>
+
+namespace at
+{
+	class Shader;
+
+	class ATEMA_RENDERER_API ComputePipeline : public NonCopyable
+	{
+	public:
+		struct Settings
+		{
+			std::vector<Ptr<DescriptorSetLayout>> descriptorSetLayouts;
+
+			Ptr<Shader> computeShader;
+		};
+
+		virtual ~ComputePipeline();
+
+		static Ptr<ComputePipeline> create(const Settings& settings);
+
+		const std::vector<Ptr<DescriptorSetLayout>>& getDescriptorSetLayouts() const;
+
+	protected:
+		ComputePipeline();
+
+	private:
+		std::vector<Ptr<DescriptorSetLayout>> m_descriptorSetLayouts;
+	};
+
+	template <>
+	struct HashOverload<ComputePipeline::Settings>
+	{
+		template <typename Hasher>
+		static constexpr auto hash(const ComputePipeline::Settings& settings)
+		{
+			typename Hasher::HashType hash = 0;
+
+			for (const auto& descriptorSetLayout : settings.descriptorSetLayouts)
+				Hasher::hashCombine(hash, descriptorSetLayout.get());
+
+			Hasher::hashCombine(hash, settings.computeShader.get());
+
+			return hash;
+		}
+	};
+}
+
+#endif
@@ -151,6 +151,23 @@ namespace at
 		D24_UNORM_S8_UINT,
 		D32_SFLOAT_S8_UINT,
 
+		// Block-compressed color (4x4 pixel blocks, see Renderer::isCompressedImageFormat)
+		// Declared last so the values of the other formats, stored in cache files, don't change
+		BC1_RGB_UNORM,
+		BC1_RGB_SRGB,
+		BC1_RGBA_UNORM,
+		BC1_RGBA_SRGB,
+		BC3_UNORM,
+		BC3_SRGB,
+		BC4_UNORM,
+		BC4_SNORM,
+		BC5_UNORM,
+		BC5_SNORM,
+		BC6H_UFLOAT,
+		BC6H_SFLOAT,
+		BC7_UNORM,
+		BC7_SRGB,
+
 		_COUNT
 	};
 
@@ -516,7 +533,9 @@ namespace at
 		// The buffer can be used as a transfer destination
 		TransferDst	= 1 << 4,
 		// The buffer can be mapped
-		Map			= 1 << 5
+		Map			= 1 << 5,
+		// The buffer can be bound as a storage buffer
+		Storage		= 1 << 6
 	};
 
 	ATEMA_DECLARE_FLAGS(BufferUsage);
@@ -24,10 +24,12 @@
 
 #include <Atema/Renderer/Config.hpp>
 #include <Atema/Core/Pointer.hpp>
+#include <Atema/Core/TimeStep.hpp>
 #include <Atema/Window/Window.hpp>
 #include <Atema/Renderer/Buffer.hpp>
 #include <Atema/Renderer/CommandBuffer.hpp>
 #include <Atema/Renderer/CommandPool.hpp>
+#include <Atema/Renderer/ComputePipeline.hpp>
 #include <Atema/Renderer/DescriptorSetLayout.hpp>
 #include <Atema/Renderer/Fence.hpp>
 #include <Atema/Renderer/Image.hpp>
@@ -40,6 +42,7 @@
 #include <Atema/Renderer/Shader.hpp>
 #include <Atema/Renderer/Ui/UiContext.hpp>
 
+#include <filesystem>
 #include <optional>
 
 namespace at
@@ -52,6 +55,22 @@ namespace at
 		struct Settings
 		{
 			bool sampleShading = true;
+			// If not empty, the pipeline cache is loaded from this file and saved to it when the renderer is destroyed
+			// Cached data is discarded if it was created by another device or driver version
+			std::filesystem::path pipelineCachePath;
+			// If not empty, the AST of every shader compiled from AST or ATSL is serialized to this directory
+			// The ShaderValidation example can then check the SPIR-V writer against glslang with these files
+			std::filesystem::path shaderDumpPath;
+		};
+
+		struct PipelineStatistics
+		{
+			// Pipelines created since the renderer was initialized
+			size_t count = 0;
+			// Time spent creating these pipelines
+			TimeStep creationTime;
+			// Size of the data loaded from the pipeline cache file (0 if there was no valid file)
+			size_t loadedCacheSize = 0;
 		};
 
 		struct Limits
@@ -178,6 +197,9 @@ namespace at
 
 		static bool isStencilImageFormat(ImageFormat format);
 
+		// Block-compressed formats can't be rendered to nor blitted, and their mip levels must be uploaded
+		static bool isCompressedImageFormat(ImageFormat format);
+
 		const Hash getID() const noexcept;
 
 		virtual void initialize() = 0;
@@ -193,6 +215,10 @@ namespace at
 
 		virtual void waitForIdle() = 0;
 
+		// Writes the pipeline cache to Settings::pipelineCachePath, if any
+		virtual void savePipelineCache() = 0;
+		virtual PipelineStatistics getPipelineStatistics() const = 0;
+
 		// Returns the default command pool for a given queue command type
 		virtual Ptr<CommandPool> getCommandPool(QueueType queueType) = 0;
 		// Returns the default command pool for a given queue command type for the desired thread
@@ -207,6 +233,7 @@ namespace at
 		virtual Ptr<Shader> createShader(const Shader::Settings& settings) = 0;
 		virtual Ptr<DescriptorSetLayout> createDescriptorSetLayout(const DescriptorSetLayout::Settings& settings) = 0;
 		virtual Ptr<GraphicsPipeline> createGraphicsPipeline(const GraphicsPipeline::Settings& settings) = 0;
+		virtual Ptr<ComputePipeline> createComputePipeline(const ComputePipeline::Settings& settings) = 0;
 		virtual Ptr<CommandPool> createCommandPool(const CommandPool::Settings& settings) = 0;
 		virtual Ptr<Fence> createFence(const Fence::Settings& settings) = 0;
 		virtual Ptr<Semaphore> createSemaphore() = 0;
@@ -25,6 +25,7 @@
 #include <Atema/Renderer/Config.hpp>
 #include <Atema/Renderer/Enums.hpp>
 #include <Atema/Renderer/VertexInput.hpp>
+#include <Atema/Shader/Ast/Reflection.hpp>
 #include <Atema/Shader/Ast/Type.hpp>
 
 namespace at
@@ -33,13 +34,20 @@ namespace at
 
 	ATEMA_RENDERER_API DescriptorType getDefaultDescriptorType(const AstType& astVariableType);
 	ATEMA_RENDERER_API DescriptorType getDefaultDescriptorType(const AstArrayType::ComponentType& astVariableType);
+	// Takes the struct layout into account (std430 structs are storage buffers)
+	ATEMA_RENDERER_API DescriptorType getDefaultDescriptorType(const AstExternal& astExternal);
 	ATEMA_RENDERER_API uint32_t getDescriptorBindingCount(const AstType& astVariableType);
 
 	ATEMA_RENDERER_API size_t getByteSize(IndexType indexType);
 
+	// Byte size of a pixel, not valid for block-compressed formats
 	ATEMA_RENDERER_API size_t getByteSize(ImageFormat format);
+	// Byte size of width x height pixels, valid for any format
+	ATEMA_RENDERER_API size_t getByteSize(ImageFormat format, uint32_t width, uint32_t height);
+	// Byte size of a 4x4 block, only valid for block-compressed formats
+	ATEMA_RENDERER_API size_t getBlockByteSize(ImageFormat format);
 	ATEMA_RENDERER_API size_t getComponentCount(ImageFormat format);
-	// Only valid for color formats
+	// Only valid for uncompressed color formats
 	ATEMA_RENDERER_API ImageComponentType getComponentType(ImageFormat format);
 	// Only valid for color formats
 	// componentCount must be in the range [1,4]
@@ -39,6 +39,8 @@ namespace at
 
 		RGBA8_UINT,
 		RGBA8_SINT,
+		RGBA8_UNORM,
+		RGBA8_SNORM,
 
 		R16_UINT,
 		R16_SINT,
@@ -46,6 +48,8 @@ namespace at
 
 		RG16_UINT,
 		RG16_SINT,
+		RG16_UNORM,
+		RG16_SNORM,
 		RG16_SFLOAT,
 
 		RGB16_UINT,
@@ -54,6 +58,8 @@ namespace at
 
 		RGBA16_UINT,
 		RGBA16_SINT,
+		RGBA16_UNORM,
+		RGBA16_SNORM,
 		RGBA16_SFLOAT,
 
 		R32_UINT,
@@ -109,6 +115,9 @@ namespace at
 		// Checks if the elements are floating points
 		bool isFloatingPoint() const;
 
+		// Checks if the elements are normalized integers (UNORM/SNORM), read as floating points in [0,1]/[-1,1] by the shaders
+		bool isNormalized() const;
+
 		uint32_t binding;
 		uint32_t location;
 		VertexInputFormat format;
@@ -24,15 +24,19 @@
 
 #include <Atema/Shader/Config.hpp>
 #include <Atema/Shader/Enums.hpp>
+#include <Atema/Shader/ShaderLibraryBundle.hpp>
 #include <Atema/Shader/ShaderLibraryManager.hpp>
 #include <Atema/Shader/ShaderWriter.hpp>
 #include <Atema/Shader/UberShader.hpp>
 #include <Atema/Shader/Utils.hpp>
+#include <Atema/Shader/Ast/AstAllocator.hpp>
 #include <Atema/Shader/Ast/AstCloner.hpp>
 #include <Atema/Shader/Ast/AstEvaluator.hpp>
+#include <Atema/Shader/Ast/AstOptimizer.hpp>
 #include <Atema/Shader/Ast/AstPreprocessor.hpp>
 #include <Atema/Shader/Ast/AstRecursiveVisitor.hpp>
 #include <Atema/Shader/Ast/AstReflector.hpp>
+#include <Atema/Shader/Ast/AstSerializer.hpp>
 #include <Atema/Shader/Ast/AstUtils.hpp>
 #include <Atema/Shader/Ast/AstVisitor.hpp>
 #include <Atema/Shader/Ast/Constant.hpp>
@@ -49,6 +53,8 @@
 #include <Atema/Shader/Glsl/GlslShaderWriter.hpp>
 #include <Atema/Shader/Glsl/GlslUtils.hpp>
 #include <Atema/Shader/Loaders/AtslLoader.hpp>
+#include <Atema/Shader/Spirv/SpirvShaderCache.hpp>
 #include <Atema/Shader/Spirv/SpirvShaderWriter.hpp>
+#include <Atema/Shader/Spirv/SpirvUtils.hpp>
 
 #endif
\ No newline at end of file
@@ -0,0 +1,49 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_SHADER_AST_ASTALLOCATOR_HPP
+#define ATEMA_SHADER_AST_ASTALLOCATOR_HPP
+
+#include <Atema/Shader/Config.hpp>
+
+#include <cstddef>
+
+namespace at
+{
+	// Pooled memory used by every Statement & Expression node
+	// Blocks are grouped by size class and recycled through per-thread free lists
+	// Pages are kept until the application exits, so a node may be released by any thread
+	class ATEMA_SHADER_API AstAllocator
+	{
+	public:
+		AstAllocator() = delete;
+
+		// Sizes above MaxBlockSize fall back to the global allocator
+		static constexpr size_t BlockAlignment = 16;
+		static constexpr size_t MaxBlockSize = 256;
+		static constexpr size_t PageSize = 64 * 1024;
+
+		static void* allocate(size_t size);
+		static void release(void* ptr, size_t size) noexcept;
+	};
+}
+
+#endif
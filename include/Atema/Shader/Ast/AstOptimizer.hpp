@@ -0,0 +1,73 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_SHADER_AST_ASTOPTIMIZER_HPP
+#define ATEMA_SHADER_AST_ASTOPTIMIZER_HPP
+
+#include <Atema/Shader/Config.hpp>
+#include <Atema/Core/NonCopyable.hpp>
+#include <Atema/Shader/Ast/Statement.hpp>
+#include <Atema/Shader/Ast/Expression.hpp>
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace at
+{
+	// Optimizes an AST in place before code generation :
+	// - constant folding & propagation of const variables
+	// - dead code elimination (constant branches, unreachable statements, unused local variables)
+	// - removal of the functions, structs, global variables & externals not reachable from an entry function
+	class ATEMA_SHADER_API AstOptimizer : public NonCopyable
+	{
+	public:
+		AstOptimizer();
+		~AstOptimizer();
+
+		// Declarations are only removed if the AST contains an entry function (libraries are kept whole)
+		void optimize(SequenceStatement& ast);
+
+	private:
+		void process(UPtr<Statement>& statement);
+		void process(UPtr<Expression>& expression);
+		// Assigned expressions must stay variables, only their indices are processed
+		void processAssigned(UPtr<Expression>& expression);
+		// Branch & loop bodies stay valid statements, even if they become empty
+		void processBody(UPtr<Statement>& statement);
+		void processSequence(SequenceStatement& sequence);
+		void processFunction(FunctionDeclarationStatement& statement);
+
+		void removeUnusedVariables(SequenceStatement& sequence);
+		void removeUnusedDeclarations(SequenceStatement& ast);
+
+		void pushScope();
+		void popScope();
+		// Non constant variables are declared too, as they may hide a constant of an outer scope
+		void declareVariable(const std::string& name, std::optional<ConstantValue> value);
+		const ConstantValue* findConstant(const std::string& name) const;
+
+		std::vector<std::unordered_map<std::string, std::optional<ConstantValue>>> m_scopes;
+	};
+}
+
+#endif
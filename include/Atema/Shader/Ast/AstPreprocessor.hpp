@@ -47,6 +47,9 @@ namespace at
 
 		void clear();
 
+		// Overridden value, or default value declared in the visited option statements
+		std::optional<ConstantValue> getOptionValue(const std::string& optionName) const;
+
 		void visit(const OptionDeclarationStatement& statement) override;
 
 		UPtr<Statement> process(const Statement& statement);
@@ -62,8 +65,6 @@ namespace at
 		std::optional<ConstantValue> evaluate(Expression& expression);
 		std::optional<bool> evaluateCondition(Expression& expression);
 
-		std::optional<ConstantValue> getOptionValue(const std::string& optionName);
-		
 		AstType process(const AstType& type);
 
 		UPtr<Expression> createConstantIfPossible(UPtr<Expression>&& value);
@@ -0,0 +1,129 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_SHADER_AST_ASTSERIALIZER_HPP
+#define ATEMA_SHADER_AST_ASTSERIALIZER_HPP
+
+#include <Atema/Shader/Config.hpp>
+#include <Atema/Shader/Ast/Expression.hpp>
+#include <Atema/Shader/Ast/Statement.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace at
+{
+	// Binary representation of an AST, used to store precompiled shader libraries
+	// The format is only meant to be read by the same engine version (see AstSerializer::Version)
+	class ATEMA_SHADER_API AstSerializer
+	{
+	public:
+		// Must be incremented each time the AST structure or the binary format changes
+		static constexpr uint32_t Version = 1;
+
+		AstSerializer();
+		~AstSerializer();
+
+		// Appends the statement (and all its children) to the serialized data
+		void serialize(const Statement& statement);
+
+		const std::vector<uint8_t>& getData() const noexcept;
+
+		void clear();
+
+	private:
+		void write(const Statement* statement);
+		void write(const Expression* expression);
+
+#define ATEMA_MACROLIST_SHADERASTSTATEMENT(at_statement) void write(const at_statement ## Statement& statement);
+#include <Atema/Shader/Ast/StatementMacroList.hpp>
+
+#define ATEMA_MACROLIST_SHADERASTEXPRESSION(at_expression) void write(const at_expression ## Expression& expression);
+#include <Atema/Shader/Ast/ExpressionMacroList.hpp>
+
+		void write(const FunctionDeclarationStatement& statement, bool isEntry);
+		void write(const AstType& type);
+		void write(const AstArrayType::ComponentType& type);
+		void write(const ConstantValue& value);
+		void write(const std::string& str);
+
+		template <typename T>
+		void writeValue(T value);
+		template <size_t N, typename T>
+		void writeValue(const Vector<N, T>& value);
+		void writeSize(size_t size);
+
+		template <typename T>
+		bool writeSharedType(const T& type);
+		template <typename T>
+		bool writeConstant(const ConstantValue& value, ConstantType constantType);
+
+		std::vector<uint8_t> m_data;
+	};
+
+	class ATEMA_SHADER_API AstDeserializer
+	{
+	public:
+		AstDeserializer() = delete;
+		// The data must remain valid while deserializing
+		AstDeserializer(const void* data, size_t byteSize);
+		~AstDeserializer();
+
+		UPtr<Statement> deserialize();
+
+		// Remaining bytes to be read
+		size_t getRemainingSize() const noexcept;
+
+	private:
+		UPtr<Statement> readStatement();
+		UPtr<Expression> readExpression();
+
+		template <typename T>
+		UPtr<T> readStatement();
+
+#define ATEMA_MACROLIST_SHADERASTSTATEMENT(at_statement) void read(at_statement ## Statement& statement);
+#include <Atema/Shader/Ast/StatementMacroList.hpp>
+
+#define ATEMA_MACROLIST_SHADERASTEXPRESSION(at_expression) void read(at_expression ## Expression& expression);
+#include <Atema/Shader/Ast/ExpressionMacroList.hpp>
+
+		void readFunction(FunctionDeclarationStatement& statement);
+		AstType readType();
+		AstArrayType::ComponentType readComponentType();
+		template <typename T>
+		T readSharedType(uint8_t tag);
+		ConstantValue readConstant();
+		std::string readString();
+
+		template <typename T>
+		T readValue();
+		template <size_t N, typename T>
+		Vector<N, T> readVector();
+		size_t readSize();
+
+		void readBytes(void* data, size_t byteSize);
+
+		const uint8_t* m_data;
+		const uint8_t* m_end;
+	};
+}
+
+#endif
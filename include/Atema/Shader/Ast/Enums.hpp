@@ -78,13 +78,23 @@ namespace at
 
 		SetVertexPosition, // Arguments : position (vector4f)
 
-		GetFragmentCoordinates
+		GetFragmentCoordinates,
+
+		GetGlobalInvocationId,
+		GetLocalInvocationId,
+		GetWorkgroupId,
+		Barrier, // Synchronizes the invocations of a workgroup and their shared memory accesses
+
+		ImageLoad, // Arguments : image, coordinates (integer vector)
+		ImageStore // Arguments : image, coordinates (integer vector), value (vector4)
 	};
 
 	enum class VariableQualifier
 	{
 		None = 1 << 0,
-		Const = 1 << 1
+		Const = 1 << 1,
+		// Global variable shared by the invocations of a compute workgroup
+		Shared = 1 << 2
 	};
 
 	ATEMA_DECLARE_FLAGS(VariableQualifier);
@@ -92,7 +102,8 @@ namespace at
 	enum class AstShaderStage
 	{
 		Vertex = 1 << 0,
-		Fragment = 1 << 1
+		Fragment = 1 << 1,
+		Compute = 1 << 2
 	};
 
 	ATEMA_DECLARE_FLAGS(AstShaderStage);
@@ -100,6 +111,8 @@ namespace at
 	enum class StructLayout
 	{
 		Std140,
+		// Storage buffers
+		Std430,
 
 		_COUNT,
 
@@ -25,6 +25,7 @@
 #include <Atema/Shader/Config.hpp>
 #include <Atema/Core/NonCopyable.hpp>
 #include <Atema/Core/Pointer.hpp>
+#include <Atema/Shader/Ast/AstAllocator.hpp>
 #include <Atema/Shader/Ast/Constant.hpp>
 #include <Atema/Shader/Ast/Enums.hpp>
 #include <Atema/Shader/Ast/Type.hpp>
@@ -48,6 +49,10 @@ namespace at
 		Expression();
 		virtual ~Expression();
 
+		// Nodes are allocated from the AstAllocator pools
+		static void* operator new(size_t size);
+		static void operator delete(void* ptr, size_t size) noexcept;
+
 		virtual Expression::Type getType() const noexcept = 0;
 
 		virtual void accept(AstVisitor& visitor) = 0;
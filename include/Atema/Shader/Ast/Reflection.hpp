@@ -25,6 +25,7 @@
 #include <Atema/Shader/Config.hpp>
 #include <Atema/Shader/Ast/Type.hpp>
 #include <Atema/Shader/Ast/Constant.hpp>
+#include <Atema/Shader/Ast/Enums.hpp>
 
 #include <unordered_map>
 
@@ -67,10 +68,12 @@ namespace at
 	struct ATEMA_SHADER_API AstExternal : public AstVariable
 	{
 		AstExternal();
-		AstExternal(const std::string& name, const AstType& type, uint32_t set, uint32_t binding);
+		AstExternal(const std::string& name, const AstType& type, uint32_t set, uint32_t binding, StructLayout structLayout = StructLayout::Default);
 
 		uint32_t set;
 		uint32_t binding;
+		// Std430 structs are storage buffers
+		StructLayout structLayout;
 	};
 
 	class ATEMA_SHADER_API AstReflection
@@ -25,6 +25,8 @@
 #include <Atema/Shader/Config.hpp>
 #include <Atema/Core/NonCopyable.hpp>
 #include <Atema/Core/Pointer.hpp>
+#include <Atema/Math/Vector.hpp>
+#include <Atema/Shader/Ast/AstAllocator.hpp>
 #include <Atema/Shader/Ast/Enums.hpp>
 #include <Atema/Shader/Ast/Type.hpp>
 
@@ -49,6 +51,10 @@ namespace at
 		Statement();
 		virtual ~Statement();
 
+		// Nodes are allocated from the AstAllocator pools
+		static void* operator new(size_t size);
+		static void operator delete(void* ptr, size_t size) noexcept;
+
 		virtual Statement::Statement::Type getType() const noexcept = 0;
 
 		virtual void accept(AstVisitor& visitor) = 0;
@@ -246,6 +252,8 @@ namespace at
 		void accept(AstConstVisitor& visitor) const override;
 
 		AstShaderStage stage;
+		// Number of invocations per workgroup, used by compute shaders
+		Vector3u workgroupSize = { 1, 1, 1 };
 	};
 
 	// Misc
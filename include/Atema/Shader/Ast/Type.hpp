@@ -72,6 +72,32 @@ namespace at
 		AstPrimitiveType primitiveType;
 	};
 
+	enum class AstImageFormat
+	{
+		// Requires the format to be known by the pipeline when the image is read
+		Unknown,
+		Rgba8,
+		Rgba8Snorm,
+		Rgba16f,
+		Rgba32f,
+		Rg16f,
+		Rg32f,
+		R16f,
+		R32f,
+		Rgba32i,
+		Rgba32ui,
+		R32i,
+		R32ui
+	};
+
+	// Image accessed without a sampler (read & written by compute shaders)
+	struct AstStorageImageType
+	{
+		AstImageType imageType;
+		AstPrimitiveType primitiveType;
+		AstImageFormat format = AstImageFormat::Unknown;
+	};
+
 	struct AstStructType
 	{
 		std::string name;
@@ -79,7 +105,7 @@ namespace at
 
 	struct AstArrayType
 	{
-		using ComponentType = Variant<AstPrimitiveType, AstVectorType, AstMatrixType, AstSamplerType, AstStructType>;
+		using ComponentType = Variant<AstPrimitiveType, AstVectorType, AstMatrixType, AstSamplerType, AstStorageImageType, AstStructType>;
 
 		enum class SizeType
 		{
@@ -106,6 +132,7 @@ namespace at
 		AstVectorType,
 		AstMatrixType,
 		AstSamplerType,
+		AstStorageImageType,
 		AstStructType>;
 
 	ATEMA_SHADER_API bool isInOutType(const AstType& type);
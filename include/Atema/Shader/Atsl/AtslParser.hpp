@@ -23,33 +23,37 @@
 #define ATEMA_SHADER_ATSLPARSER_HPP
 
 #include <Atema/Shader/Config.hpp>
+#include <Atema/Core/Pointer.hpp>
+#include <Atema/Shader/Atsl/AtslToken.hpp>
 
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace at
 {
-	struct AtslToken;
-
 	class ATEMA_SHADER_API AtslParser
 	{
 	public:
 		AtslParser();
 		virtual ~AtslParser();
 
-		std::vector<AtslToken> createTokens(const std::string& code);
+		// Identifiers are interned by the parser : they remain valid as long as the parser is alive
+		std::vector<AtslToken> createTokens(std::string_view code);
 
 	private:
-		bool hasNext() const;
-		char getNext();
-		void gotoLastChar();
+		// Returns the token corresponding to a word (identifier, keyword or boolean value)
+		const AtslToken& getWordToken(std::string_view word);
+		std::string_view storeIdentifier(std::string_view identifier);
 
-		std::string_view m_code;
-		
-		size_t m_currentLine;
-		int m_currentColumn;
+		// Interned words, keywords and boolean values are registered at construction
+		std::unordered_map<std::string_view, AtslToken> m_words;
 
-		size_t m_currentIndex;
+		// Identifier storage, allocated by pages so the views never move
+		std::vector<UPtr<char[]>> m_identifierPages;
+		size_t m_identifierPageOffset;
+		size_t m_identifierPageSize;
 	};
 }
 
@@ -76,7 +76,7 @@ namespace at
 		struct Attribute
 		{
 			std::string name;
-			Variant<AtslBasicValue, AtslIdentifier, Ptr<Expression>> value;
+			Variant<AtslBasicValue, std::string, Ptr<Expression>> value;
 		};
 
 		void newLine();
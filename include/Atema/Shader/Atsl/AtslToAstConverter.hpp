@@ -65,7 +65,7 @@ namespace at
 		
 		bool hasAttribute(const AtslIdentifier& identifier) const;
 		const Attribute& getAttribute(const AtslIdentifier& identifier) const;
-		const AtslIdentifier& expectAttributeIdentifier(const AtslIdentifier& name) const;
+		const std::string& expectAttributeIdentifier(const AtslIdentifier& name) const;
 		bool expectAttributeBool(const AtslIdentifier& name) const;
 		int32_t expectAttributeInt(const AtslIdentifier& name) const;
 		float expectAttributeFloat(const AtslIdentifier& name) const;
@@ -26,6 +26,7 @@
 #include <Atema/Core/Variant.hpp>
 
 #include <string>
+#include <string_view>
 #include <ostream>
 
 namespace at
@@ -80,6 +81,7 @@ namespace at
 		Include,
 
 		Const,
+		Shared,
 
 		If,
 		Else,
@@ -96,7 +98,8 @@ namespace at
 		Discard,
 	};
 
-	using AtslIdentifier = std::string;
+	// Views an identifier interned by the AtslParser that created the token
+	using AtslIdentifier = std::string_view;
 
 	using AtslBasicValue = Variant<
 		bool,
@@ -115,7 +118,7 @@ namespace at
 		AtslToken() = delete;
 		AtslToken(AtslSymbol symbol);
 		AtslToken(AtslKeyword keyword);
-		AtslToken(const AtslIdentifier& identifier);
+		AtslToken(AtslIdentifier identifier);
 		AtslToken(bool value);
 		AtslToken(int32_t value);
 		AtslToken(uint32_t value);
@@ -123,7 +126,7 @@ namespace at
 
 		bool is(AtslSymbol symbol) const noexcept;
 		bool is(AtslKeyword keyword) const noexcept;
-		bool is(const AtslIdentifier& identifier) const noexcept;
+		bool is(AtslIdentifier identifier) const noexcept;
 		bool is(bool value) const noexcept;
 		bool is(int32_t value) const noexcept;
 		bool is(uint32_t value) const noexcept;
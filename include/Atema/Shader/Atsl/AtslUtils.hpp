@@ -55,6 +55,9 @@ namespace at::atsl
 	ATEMA_SHADER_API StructLayout getStructLayout(const std::string& str);
 	ATEMA_SHADER_API std::string getStructLayoutStr(StructLayout structLayout);
 
+	ATEMA_SHADER_API AstImageFormat getImageFormat(const std::string& str);
+	ATEMA_SHADER_API std::string getImageFormatStr(AstImageFormat format);
+
 	ATEMA_SHADER_API bool isExpressionDelimiter(AtslSymbol symbol);
 }
 
@@ -98,6 +98,7 @@ namespace at
 		void writeLayout(const Ptr<Expression>& location);
 		void writeLayout(const Ptr<Expression>& set, const Ptr<Expression>& binding);
 		void writeLayout(const Ptr<Expression>& set, const Ptr<Expression>& binding, StructLayout structLayout);
+		void writeLayout(const Ptr<Expression>& set, const Ptr<Expression>& binding, AstImageFormat format);
 		void writeType(AstType type);
 		void writeType(AstArrayType::ComponentType type);
 		void writeVariableDeclaration(AstType type, std::string name, Expression* value = nullptr);
@@ -114,6 +115,8 @@ namespace at
 		int m_indent;
 		std::unordered_map<std::string, UPtr<StructDeclarationStatement>> m_structDeclarations;
 		std::unordered_map<std::string, size_t> m_interfaceBlockCount;
+		// Storage buffers can end with a runtime array
+		bool m_isInStorageBlock;
 	};
 }
 
@@ -35,6 +35,8 @@ namespace at::glsl
 	ATEMA_SHADER_API std::string getArraySizeStr(const AstArrayType& type);
 
 	ATEMA_SHADER_API std::string getStructLayoutStr(StructLayout structLayout);
+
+	ATEMA_SHADER_API std::string getImageFormatStr(AstImageFormat format);
 }
 
 #endif
@@ -0,0 +1,90 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ATEMA_SHADER_SHADERLIBRARYBUNDLE_HPP
+#define ATEMA_SHADER_SHADERLIBRARYBUNDLE_HPP
+
+#include <Atema/Shader/Config.hpp>
+#include <Atema/Core/Hash.hpp>
+#include <Atema/Core/MappedFile.hpp>
+#include <Atema/Core/NonCopyable.hpp>
+#include <Atema/Core/Pointer.hpp>
+#include <Atema/Shader/Ast/Statement.hpp>
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace at
+{
+	// Precompiled ATSL sources, stored as serialized ASTs (see AstSerializer) and identified by the hash of their source
+	// A loaded bundle is memory mapped : an AST is only read when requested, straight from the mapped file
+	class ATEMA_SHADER_API ShaderLibraryBundle : public NonCopyable
+	{
+	public:
+		ShaderLibraryBundle();
+		~ShaderLibraryBundle();
+
+		// Stable across platforms & runs
+		static Hash64 getKey(const std::string& atslCode);
+
+		// Replaces the current content with the one of the file
+		// Returns false (and leaves the bundle empty) if the file does not exist, is incomplete or was written by another version
+		bool load(const std::filesystem::path& path);
+		void save(const std::filesystem::path& path) const;
+
+		// Serializes the AST immediately, the name is only informative
+		void add(Hash64 key, const std::string& name, const SequenceStatement& ast);
+		// Copies every entry of another bundle, the copies don't depend on its file
+		void add(const ShaderLibraryBundle& other);
+
+		bool contains(Hash64 key) const;
+
+		// Returns nullptr if the key is not in the bundle
+		UPtr<SequenceStatement> getAst(Hash64 key) const;
+
+		// Returns an empty string if the key is not in the bundle
+		const std::string& getName(Hash64 key) const;
+
+		size_t getSize() const noexcept;
+
+		void clear();
+
+	private:
+		struct Entry
+		{
+			std::string name;
+			// Either points to the mapped file or to ownedData
+			const uint8_t* data = nullptr;
+			size_t byteSize = 0;
+			std::vector<uint8_t> ownedData;
+		};
+
+		UPtr<MappedFile> m_file;
+		// Keeps the insertion order when saving
+		std::vector<Hash64> m_keys;
+		std::unordered_map<Hash64, Entry> m_entries;
+	};
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ATEMA_SHADER_SPIRVSHADERCACHE_HPP
+#define ATEMA_SHADER_SPIRVSHADERCACHE_HPP
+
+#include <Atema/Shader/Config.hpp>
+#include <Atema/Core/Hash.hpp>
+#include <Atema/Core/NonCopyable.hpp>
+#include <Atema/Core/TimeStep.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace at
+{
+	// Persistent cache of compiled SPIR-V modules, used by spirv::compile for both SPIR-V backends
+	// Entries are content-addressed : the key is a hash of the serialized AST and of the compiler settings
+	// The cache is disabled until a directory is set
+	// All methods are thread-safe
+	class ATEMA_SHADER_API SpirvShaderCache : public NonCopyable
+	{
+	public:
+		struct Statistics
+		{
+			size_t hits = 0;
+			size_t misses = 0;
+			size_t evictions = 0;
+
+			// Time spent compiling shaders that were not in the cache
+			TimeStep compileTime;
+			// Time spent reading shaders from the cache
+			TimeStep loadTime;
+		};
+
+		static SpirvShaderCache& instance();
+
+		void setDirectory(const std::filesystem::path& directory);
+		// Once the cache exceeds this size, least recently used entries are removed
+		// 0 means unlimited (default : 64 MB)
+		void setMaxSize(size_t byteSize);
+
+		std::filesystem::path getDirectory() const;
+		size_t getMaxSize() const;
+		size_t getSize() const;
+		bool isEnabled() const;
+
+		// Returns false (and counts a miss) if the entry does not exist or is invalid
+		bool load(Hash64 key, std::vector<uint32_t>& spirv);
+		// The file is written under a temporary name then renamed, so concurrent readers never see partial entries
+		void save(Hash64 key, const std::vector<uint32_t>& spirv, const TimeStep& compileTime);
+
+		// Removes every entry from the disk
+		void clear();
+
+		Statistics getStatistics() const;
+		void resetStatistics();
+
+	private:
+		SpirvShaderCache();
+
+		struct Entry
+		{
+			size_t size = 0;
+			std::filesystem::file_time_type lastUse;
+		};
+
+		std::filesystem::path getPath(Hash64 key) const;
+		void scanDirectory();
+		void evict();
+
+		mutable std::mutex m_mutex;
+		std::filesystem::path m_directory;
+		size_t m_maxSize;
+		size_t m_size;
+		std::unordered_map<Hash64, Entry> m_entries;
+		size_t m_tempFileCount;
+		Statistics m_statistics;
+	};
+}
+
+#endif
@@ -19,18 +19,27 @@
 	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+
 #ifndef ATEMA_SHADER_SPIRVSHADERWRITER_HPP
 #define ATEMA_SHADER_SPIRVSHADERWRITER_HPP
 
 #include <Atema/Shader/Config.hpp>
 #include <Atema/Shader/ShaderWriter.hpp>
-#include <Atema/Shader/Glsl/GlslShaderWriter.hpp>
+#include <Atema/Shader/Ast/AstPreprocessor.hpp>
 
-#include <sstream>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace at
 {
-	class ATEMA_SHADER_API SpirvShaderWriter : public GlslShaderWriter
+	// Emits a SPIR-V 1.0 module (Vulkan flavour) directly from the AST
+	// Options are resolved to constants and optional declarations are evaluated while writing
+	// Inherits NonCopyable to store unique pointers
+	class ATEMA_SHADER_API SpirvShaderWriter : public ShaderWriter, public NonCopyable
 	{
 	public:
 		struct Settings
@@ -45,15 +54,243 @@ namespace at
 		void compile(std::vector<uint32_t>& spirv);
 		void compile(std::ostream& ostream);
 
+		void visit(const ConditionalStatement& statement) override;
+		void visit(const ForLoopStatement& statement) override;
+		void visit(const WhileLoopStatement& statement) override;
+		void visit(const DoWhileLoopStatement& statement) override;
+		void visit(const VariableDeclarationStatement& statement) override;
+		void visit(const StructDeclarationStatement& statement) override;
+		void visit(const InputDeclarationStatement& statement) override;
+		void visit(const OutputDeclarationStatement& statement) override;
+		void visit(const ExternalDeclarationStatement& statement) override;
+		void visit(const OptionDeclarationStatement& statement) override;
+		void visit(const FunctionDeclarationStatement& statement) override;
 		void visit(const EntryFunctionDeclarationStatement& statement) override;
-		
+		void visit(const ExpressionStatement& statement) override;
+		void visit(const BreakStatement& statement) override;
+		void visit(const ContinueStatement& statement) override;
+		void visit(const ReturnStatement& statement) override;
+		void visit(const DiscardStatement& statement) override;
+		void visit(const SequenceStatement& statement) override;
+		void visit(const OptionalStatement& statement) override;
+		void visit(const IncludeStatement& statement) override;
+
+		void visit(const ConstantExpression& expression) override;
+		void visit(const VariableExpression& expression) override;
+		void visit(const AccessIndexExpression& expression) override;
+		void visit(const AccessIdentifierExpression& expression) override;
+		void visit(const AssignmentExpression& expression) override;
+		void visit(const UnaryExpression& expression) override;
+		void visit(const BinaryExpression& expression) override;
+		void visit(const FunctionCallExpression& expression) override;
+		void visit(const BuiltInFunctionCallExpression& expression) override;
+		void visit(const CastExpression& expression) override;
+		void visit(const SwizzleExpression& expression) override;
+		void visit(const TernaryExpression& expression) override;
+
 	private:
-		void compileSpirv(std::vector<uint32_t>& spirv);
+		// The same AST type may need several SPIR-V types depending on where it is used
+		enum class TypeLayout
+		{
+			// Logical type, used for function variables, private variables, inputs & outputs
+			None,
+			// Explicit std140 offsets & strides, used inside uniform blocks
+			Std140,
+			// Std140 struct decorated as a uniform block
+			Std140Block,
+			// Explicit std430 offsets & strides, used inside storage blocks
+			Std430,
+			// Std430 struct decorated as a storage block
+			Std430Block,
+			// Struct decorated as an input/output block
+			InterfaceBlock
+		};
+
+		// Result of an expression : either an intermediate value or a pointer to a variable (or a part of it)
+		struct Value
+		{
+			AstType type;
+			uint32_t id = 0;
+			TypeLayout layout = TypeLayout::None;
+
+			bool isPointer = false;
+			uint32_t storageClass = 0;
+
+			// Pointer to several components of a vector : the value can't be accessed with an access chain
+			std::vector<uint32_t> components;
+			size_t vectorSize = 0;
+		};
 
+		struct StructData
+		{
+			struct Member
+			{
+				std::string name;
+				AstType type;
+			};
+
+			std::vector<Member> members;
+		};
+
+		struct FunctionData
+		{
+			uint32_t id = 0;
+			AstType returnType;
+			std::vector<AstType> argumentTypes;
+			bool isDefined = false;
+			bool isCalled = false;
+		};
+
+		struct FunctionContext
+		{
+			AstType returnType;
+			std::vector<uint32_t> header;
+			// Function variables must be declared in the first block
+			std::vector<uint32_t> variables;
+			std::vector<uint32_t> body;
+			uint32_t currentLabel = 0;
+			bool isTerminated = false;
+		};
+
+		struct LoopContext
+		{
+			uint32_t mergeLabel = 0;
+			uint32_t continueLabel = 0;
+			bool isBreakReached = false;
+			bool isContinueReached = false;
+		};
+
+		// Module
+		void beginModule(const SequenceStatement& statement);
+		uint32_t createId();
+		void addCapability(uint32_t capability);
+		uint32_t getGlslInstructionSetId();
+		void writeInstruction(std::vector<uint32_t>& section, uint32_t opCode, const std::vector<uint32_t>& operands);
+		void writeName(uint32_t id, const std::string& name);
+		void writeMemberName(uint32_t id, uint32_t memberIndex, const std::string& name);
+		void writeDecoration(uint32_t id, uint32_t decoration, const std::vector<uint32_t>& operands = {});
+		void writeMemberDecoration(uint32_t id, uint32_t memberIndex, uint32_t decoration, const std::vector<uint32_t>& operands = {});
+		void writeFunction(std::vector<uint32_t>& section, const FunctionContext& function);
+
+		// Instructions inside the current function
+		void write(uint32_t opCode, const std::vector<uint32_t>& operands);
+		uint32_t writeResult(uint32_t opCode, uint32_t typeId, const std::vector<uint32_t>& operands);
+		void beginBlock(uint32_t label);
+		void writeBranch(uint32_t label);
+		void writeTerminator(uint32_t opCode, const std::vector<uint32_t>& operands = {});
+		bool isReachable() const;
+
+		// Types & constants
+		AstType resolveType(const AstType& type) const;
+		const StructData& getStruct(const std::string& name) const;
+		uint32_t getTypeId(const AstType& type, TypeLayout layout = TypeLayout::None);
+		uint32_t getImageTypeId(AstImageType imageType, AstPrimitiveType primitiveType, std::optional<AstImageFormat> storageFormat = std::nullopt);
+		uint32_t getPointerTypeId(uint32_t storageClass, uint32_t typeId);
+		uint32_t getFunctionTypeId(uint32_t returnTypeId, const std::vector<uint32_t>& argumentTypeIds);
+		static TypeLayout getMemberLayout(TypeLayout layout);
+		size_t getLayoutAlignment(const AstType& type, TypeLayout layout) const;
+		size_t getLayoutSize(const AstType& type, TypeLayout layout) const;
+		size_t getLayoutArrayStride(const AstArrayType& type, TypeLayout layout) const;
+		uint32_t getConstantId(const ConstantValue& value);
+		uint32_t getScalarConstantId(AstPrimitiveType type, uint32_t bits);
+		uint32_t getBoolConstantId(bool value);
+		uint32_t getIntConstantId(int32_t value);
+		uint32_t getUIntConstantId(uint32_t value);
+		uint32_t getFloatConstantId(float value);
+		Value getScalarConstant(AstPrimitiveType type, int value);
+
+		// Options & conditions
+		std::optional<ConstantValue> evaluateConstant(const Expression& expression);
+		bool evaluateCondition(const Expression* condition);
+		uint32_t evaluateDecorationIndex(const Expression& expression);
+
+		// Variables
+		void pushScope();
+		void popScope();
+		void addVariable(const std::string& name, const Value& value);
+		const Value& getVariable(const std::string& name) const;
+		Value createVariable(const std::string& name, const AstType& type, uint32_t storageClass, TypeLayout layout = TypeLayout::None);
+		Value createTemporary(const Value& value);
+		Value getBuiltInVariable(uint32_t builtIn, const AstType& type, uint32_t storageClass, const std::string& name);
+
+		// Values
+		Value evaluate(const Expression& expression);
+		Value evaluateValue(const Expression& expression);
+		uint32_t evaluateBool(const Expression& expression);
+		Value load(const Value& value);
+		Value removeLayout(const Value& value);
+		void store(const Value& pointer, const Value& value);
+		Value convert(const Value& value, const AstType& type);
+		Value convert(const Value& value, AstPrimitiveType primitiveType);
+		Value splat(const Value& value, size_t componentCount);
+		Value composite(const AstType& type, const std::vector<uint32_t>& constituents);
+		Value extract(const Value& value, const std::vector<uint32_t>& indices, const AstType& type);
+		Value construct(const AstType& type, const std::vector<Value>& arguments);
+		Value access(const Value& value, size_t index, uint32_t indexId, const AstType& type);
+		Value accessMember(const Value& value, const std::string& identifier);
+		Value accessIndex(const Value& value, const Value& index);
+		Value swizzle(const Value& value, const std::vector<uint32_t>& components);
+
+		// Operations
+		Value arithmetic(BinaryOperator op, Value left, Value right);
+		Value matrixArithmetic(BinaryOperator op, Value left, Value right);
+		Value comparison(BinaryOperator op, Value left, Value right);
+		Value bitwise(BinaryOperator op, Value left, Value right);
+		Value logical(BinaryOperator op, const Expression& left, const Expression& right);
+		Value select(uint32_t condition, const Expression& trueExpression, const Expression& falseExpression);
+
+		// Functions
+		FunctionData& declareFunction(const FunctionDeclarationStatement& statement);
+		Value callFunction(const std::string& name, const std::vector<Value>& arguments);
+		Value callBuiltInFunction(const std::string& name, const std::vector<Value>& arguments);
+		Value callComponentWise(const std::string& name, std::vector<Value> arguments, uint32_t floatInstruction, uint32_t intInstruction, uint32_t uintInstruction);
+		Value callExtendedInstruction(const AstType& type, uint32_t instruction, const std::vector<Value>& arguments);
+		Value sample(const std::vector<Value>& arguments, bool explicitLod);
+		Value querySize(const std::vector<Value>& arguments);
+		Value readImage(const std::vector<Value>& arguments);
+		Value writeImage(const std::vector<Value>& arguments);
+
+		// Control flow
+		void writeConditional(const ConditionalStatement& statement, size_t branchIndex);
+		void writeLoop(const Expression* condition, const Expression* increase, const Statement& statement, bool isDoWhile);
+
+		bool m_isSequenceProcessed;
 		std::optional<AstShaderStage> m_requestedStage;
 		bool m_entryFound;
 		AstShaderStage m_stage;
-		std::stringstream m_glslStream;
+		Vector3u m_workgroupSize;
+
+		AstPreprocessor m_preprocessor;
+		std::unordered_map<std::string, ConstantValue> m_options;
+		std::unordered_map<std::string, StructData> m_structs;
+		std::unordered_map<std::string, std::vector<FunctionData>> m_functions;
+		std::vector<std::unordered_map<std::string, Value>> m_scopes;
+		std::unordered_map<uint32_t, Value> m_builtInVariables;
+
+		uint32_t m_idBound;
+		std::set<uint32_t> m_capabilities;
+		uint32_t m_glslInstructionSetId;
+		uint32_t m_entryFunctionId;
+		std::vector<uint32_t> m_interfaceIds;
+		std::vector<uint32_t> m_names;
+		std::vector<uint32_t> m_annotations;
+		// Types, constants & global variables
+		std::vector<uint32_t> m_declarations;
+		std::vector<uint32_t> m_functionDefinitions;
+
+		std::unordered_map<std::string, uint32_t> m_typeIds;
+		std::unordered_map<std::string, uint32_t> m_constantIds;
+		std::unordered_map<uint32_t, ConstantValue> m_scalarConstants;
+		std::set<uint32_t> m_compositeConstants;
+
+		// Global variables initializers are written in a dedicated function called at the beginning of the entry
+		uint32_t m_globalInitializationId;
+		FunctionContext m_globalInitialization;
+		FunctionContext* m_function;
+		bool m_isInFunction;
+		std::vector<LoopContext> m_loops;
+
+		Value m_value;
 	};
 }
 
@@ -31,6 +31,10 @@
 #include <Atema/Shader/Ast/Constant.hpp>
 #include <Atema/Shader/Ast/AstReflector.hpp>
 
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+
 namespace at
 {
 	class ATEMA_SHADER_API UberShader
@@ -49,17 +53,42 @@ namespace at
 		UberShader(UPtr<SequenceStatement>&& ast);
 		~UberShader();
 
+		// Top level statements are only preprocessed once for each set of option values they depend on
 		Ptr<UberShader> createInstance(const std::vector<Option>& options, const ShaderLibraryManager* shaderLibraryManager = nullptr) const;
+		// Keeps the options that may change an instance of this shader or of its included libraries
+		// The result is sorted by name (the last value is kept for duplicates), so equivalent sets are equal
+		std::vector<Option> getRelevantOptions(const std::vector<Option>& options, const ShaderLibraryManager* shaderLibraryManager = nullptr) const;
 		Ptr<UberShader> extractStage(AstShaderStage stage) const;
 		const AstReflection& getReflection(AstShaderStage stage) const;
 
 		const Ptr<SequenceStatement>& getAst() const;
 
 	private:
+		struct StatementDependencies
+		{
+			// Identifiers that may be replaced by an option value
+			std::vector<std::string> identifiers;
+			// Included libraries depend on the library manager and on the previous includes
+			std::vector<std::string> libraries;
+		};
+
+		struct ProcessedStatement
+		{
+			std::vector<std::optional<ConstantValue>> optionValues;
+			UPtr<Statement> statement;
+		};
+
 		void initializeExtractor() const;
+		void initializeDependencies() const;
 
 		Ptr<SequenceStatement> m_ast;
 
+		// Option dependencies of each top level statement & the preprocessed versions already created
+		mutable std::mutex m_instanceMutex;
+		mutable bool m_dependenciesReady;
+		mutable std::vector<StatementDependencies> m_dependencies;
+		mutable std::vector<std::vector<ProcessedStatement>> m_processedStatements;
+
 		// The following do not modify the ast in any way, this is just for saving state
 		// So use ugly mutables to keep class methods const
 		mutable AstReflector m_astReflector;
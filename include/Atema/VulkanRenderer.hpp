@@ -27,6 +27,7 @@
 #include <Atema/VulkanRenderer/VulkanBuffer.hpp>
 #include <Atema/VulkanRenderer/VulkanCommandBuffer.hpp>
 #include <Atema/VulkanRenderer/VulkanCommandPool.hpp>
+#include <Atema/VulkanRenderer/VulkanComputePipeline.hpp>
 #include <Atema/VulkanRenderer/Vulkan.hpp>
 #include <Atema/VulkanRenderer/VulkanDescriptorPool.hpp>
 #include <Atema/VulkanRenderer/VulkanDescriptorSet.hpp>
@@ -36,6 +37,7 @@
 #include <Atema/VulkanRenderer/VulkanGraphicsPipeline.hpp>
 #include <Atema/VulkanRenderer/VulkanImage.hpp>
 #include <Atema/VulkanRenderer/VulkanImageView.hpp>
+#include <Atema/VulkanRenderer/VulkanPipelineCache.hpp>
 #include <Atema/VulkanRenderer/VulkanRenderer.hpp>
 #include <Atema/VulkanRenderer/VulkanRenderPass.hpp>
 #include <Atema/VulkanRenderer/VulkanSampler.hpp>
@@ -49,6 +49,8 @@ namespace at
 
 		void bindPipeline(const GraphicsPipeline& pipeline) override;
 
+		void bindPipeline(const ComputePipeline& pipeline) override;
+
 		void setViewport(const Viewport& viewport) override;
 
 		void setScissor(const Vector2i& position, const Vector2u& size) override;
@@ -63,6 +65,8 @@ namespace at
 
 		void copyBufferToCubemap(const Buffer& srcBuffer, Image& dstImage, ImageLayout dstLayout, uint32_t dstMipLevel) override;
 
+		void copyImageToBuffer(const Image& srcImage, ImageLayout srcLayout, Buffer& dstBuffer, size_t dstOffset, uint32_t srcMipLevel, uint32_t srcLayer) override;
+
 		void copyImage(const Image& srcImage, ImageLayout srcLayout, uint32_t srcLayer, uint32_t srcMipLevel, Image& dstImage, ImageLayout dstLayout, uint32_t dstLayer, uint32_t dstMipLevel, uint32_t layerCount) override;
 
 		void blitImage(const Image& srcImage, ImageLayout srcLayout, uint32_t srcLayer, uint32_t srcMipLevel, Image& dstImage, ImageLayout dstLayout, uint32_t dstLayer, uint32_t dstMipLevel, SamplerFilter filter, uint32_t layerCount) override;
@@ -77,6 +81,8 @@ namespace at
 
 		void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) override;
 
+		void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+
 		void memoryBarrier(Flags<PipelineStage> srcPipelineStages, Flags<MemoryAccess> srcMemoryAccesses, Flags<PipelineStage> dstPipelineStages, Flags<MemoryAccess> dstMemoryAccesses) override;
 
 		void bufferBarrier(const Buffer& buffer, Flags<PipelineStage> srcPipelineStages, Flags<PipelineStage> dstPipelineStages, Flags<MemoryAccess> srcMemoryAccesses, Flags<MemoryAccess> dstMemoryAccesses, size_t offset = 0, size_t size = 0) override;
@@ -106,6 +112,7 @@ namespace at
 		bool m_singleUse;
 		bool m_isSecondary;
 		bool m_secondaryBegan;
+		VkPipelineBindPoint m_currentPipelineBindPoint;
 		VkPipelineLayout m_currentPipelineLayout;
 		const VulkanRenderPass* m_currentRenderPass;
 		uint32_t m_currentSubpassIndex;
@@ -0,0 +1,76 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ATEMA_VULKANRENDERER_VULKANPIPELINECACHE_HPP
+#define ATEMA_VULKANRENDERER_VULKANPIPELINECACHE_HPP
+
+#include <Atema/VulkanRenderer/Config.hpp>
+#include <Atema/VulkanRenderer/Vulkan.hpp>
+#include <Atema/Core/NonCopyable.hpp>
+#include <Atema/Renderer/Renderer.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+namespace at
+{
+	// VkPipelineCache shared by every pipeline created by the renderer
+	// Vulkan pipeline caches are internally synchronized : pipelines can be created concurrently from any thread
+	// If a path is given, the cache is initialized from this file and can be saved back to it
+	// The file is ignored if it was created by another device or driver version
+	class ATEMA_VULKANRENDERER_API VulkanPipelineCache : public NonCopyable
+	{
+	public:
+		VulkanPipelineCache() = delete;
+		VulkanPipelineCache(const VulkanDevice& device, const std::filesystem::path& path = {});
+		~VulkanPipelineCache();
+
+		VkPipelineCache getHandle() const noexcept;
+
+		operator VkPipelineCache() const noexcept;
+
+		const std::filesystem::path& getPath() const noexcept;
+
+		// Writes the cache data to the file, if any
+		// The file is written under a temporary name then renamed, so a crash never leaves a partial cache
+		// Never throws, so it can be called from destructors : returns false if the data could not be saved
+		bool save() const noexcept;
+
+		// Called after each pipeline creation, for instrumentation purpose
+		void addPipeline(const TimeStep& creationTime);
+
+		Renderer::PipelineStatistics getStatistics() const;
+
+	private:
+		std::vector<uint8_t> load();
+
+		const VulkanDevice& m_device;
+		std::filesystem::path m_path;
+		VkPipelineCache m_pipelineCache;
+
+		mutable std::mutex m_mutex;
+		Renderer::PipelineStatistics m_statistics;
+	};
+}
+
+#endif
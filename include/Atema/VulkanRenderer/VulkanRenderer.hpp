@@ -28,6 +28,7 @@
 #include <Atema/VulkanRenderer/VulkanDevice.hpp>
 #include <Atema/VulkanRenderer/VulkanInstance.hpp>
 #include <Atema/VulkanRenderer/VulkanPhysicalDevice.hpp>
+#include <Atema/VulkanRenderer/VulkanPipelineCache.hpp>
 
 #include <vector>
 #include <array>
@@ -54,6 +55,9 @@ namespace at
 
 		void waitForIdle() override;
 
+		void savePipelineCache() override;
+		PipelineStatistics getPipelineStatistics() const override;
+
 		Ptr<CommandPool> getCommandPool(QueueType queueType) override;
 		Ptr<CommandPool> getCommandPool(QueueType queueType, size_t threadIndex) override;
 		
@@ -64,6 +68,7 @@ namespace at
 		Ptr<Shader> createShader(const Shader::Settings& settings) override;
 		Ptr<DescriptorSetLayout> createDescriptorSetLayout(const DescriptorSetLayout::Settings& settings) override;
 		Ptr<GraphicsPipeline> createGraphicsPipeline(const GraphicsPipeline::Settings& settings) override;
+		Ptr<ComputePipeline> createComputePipeline(const ComputePipeline::Settings& settings) override;
 		Ptr<CommandPool> createCommandPool(const CommandPool::Settings& settings) override;
 		Ptr<Fence> createFence(const Fence::Settings& settings) override;
 		Ptr<Semaphore> createSemaphore() override;
@@ -77,6 +82,7 @@ namespace at
 		const VulkanInstance& getInstance() const noexcept;
 		const VulkanPhysicalDevice& getPhysicalDevice() const noexcept;
 		const VulkanDevice& getDevice() const noexcept;
+		VulkanPipelineCache& getPipelineCache() const noexcept;
 
 	private:
 		bool checkValidationLayerSupport();
@@ -91,6 +97,7 @@ namespace at
 		UPtr<VulkanInstance> m_instance;
 		const VulkanPhysicalDevice* m_physicalDevice;
 		UPtr<VulkanDevice> m_device;
+		UPtr<VulkanPipelineCache> m_pipelineCache;
 		ImageSamples m_maxSamples;
 	};
 }
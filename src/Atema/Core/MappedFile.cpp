@@ -0,0 +1,177 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Core/MappedFile.hpp>
+#include <Atema/Core/Error.hpp>
+
+using namespace at;
+
+#if defined(ATEMA_SYSTEM_WINDOWS)
+
+#include <Atema/Core/Windows.hpp>
+
+class MappedFile::Implementation
+{
+public:
+	Implementation() = delete;
+
+	Implementation(const std::filesystem::path& filePath) :
+		m_file(INVALID_HANDLE_VALUE),
+		m_mapping(nullptr),
+		m_data(nullptr),
+		m_size(0)
+	{
+		m_file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (m_file == INVALID_HANDLE_VALUE)
+			return;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+			return;
+
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (!m_mapping)
+			return;
+
+		m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (m_data)
+			m_size = static_cast<size_t>(size.QuadPart);
+	}
+
+	~Implementation()
+	{
+		if (m_data)
+			UnmapViewOfFile(m_data);
+
+		if (m_mapping)
+			CloseHandle(m_mapping);
+
+		if (m_file != INVALID_HANDLE_VALUE)
+			CloseHandle(m_file);
+	}
+
+	const void* getData() const noexcept
+	{
+		return m_data;
+	}
+
+	size_t getSize() const noexcept
+	{
+		return m_size;
+	}
+
+private:
+	HANDLE m_file;
+	HANDLE m_mapping;
+	void* m_data;
+	size_t m_size;
+};
+
+#elif defined(ATEMA_SYSTEM_LINUX) || defined(ATEMA_SYSTEM_MACOS)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedFile::Implementation
+{
+public:
+	Implementation() = delete;
+
+	Implementation(const std::filesystem::path& filePath) :
+		m_data(nullptr),
+		m_size(0)
+	{
+		const int file = open(filePath.c_str(), O_RDONLY);
+
+		if (file < 0)
+			return;
+
+		struct stat fileStat;
+		if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+		{
+			void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+			if (data != MAP_FAILED)
+			{
+				m_data = data;
+				m_size = static_cast<size_t>(fileStat.st_size);
+			}
+		}
+
+		// The mapping stays valid after the file is closed
+		close(file);
+	}
+
+	~Implementation()
+	{
+		if (m_data)
+			munmap(m_data, m_size);
+	}
+
+	const void* getData() const noexcept
+	{
+		return m_data;
+	}
+
+	size_t getSize() const noexcept
+	{
+		return m_size;
+	}
+
+private:
+	void* m_data;
+	size_t m_size;
+};
+
+#else
+
+#error MappedFile implementation for current OS does not exist
+
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+{
+	m_impl = std::make_unique<Implementation>(filePath);
+}
+
+MappedFile::~MappedFile()
+{
+}
+
+bool MappedFile::isOpen() const noexcept
+{
+	return m_impl->getData() != nullptr;
+}
+
+const void* MappedFile::getData() const noexcept
+{
+	return m_impl->getData();
+}
+
+size_t MappedFile::getSize() const noexcept
+{
+	return m_impl->getSize();
+}
@@ -22,11 +22,63 @@
 #include <Atema/Core/TaskManager.hpp>
 #include <Atema/Core/Error.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <exception>
 
 using namespace at;
 using namespace std::chrono_literals;
 
+namespace
+{
+	struct ParallelForState
+	{
+		ParallelForState(size_t count, const std::function<void(size_t)>& function) :
+			count(count),
+			function(function),
+			nextIndex(0),
+			finishedCount(0)
+		{
+		}
+
+		// Processes indices until there is none left
+		void run()
+		{
+			size_t index;
+			while ((index = nextIndex++) < count)
+			{
+				try
+				{
+					function(index);
+				}
+				catch (...)
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+
+					if (!exception)
+						exception = std::current_exception();
+				}
+
+				if (++finishedCount == count)
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+
+					condition.notify_all();
+				}
+			}
+		}
+
+		const size_t count;
+		const std::function<void(size_t)> function;
+		std::atomic_size_t nextIndex;
+		std::atomic_size_t finishedCount;
+		std::exception_ptr exception;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+}
+
 // Task
 Task::Task(const std::function<void(size_t)>& function) :
 	m_function(function),
@@ -116,6 +168,39 @@ Ptr<Task> TaskManager::createTask(const std::function<void(size_t)>& function)
 	return task;
 }
 
+void TaskManager::parallelFor(size_t count, const std::function<void(size_t)>& function)
+{
+	if (count == 0)
+		return;
+
+	// Workers may start after the work is done, so they share the state ownership
+	auto state = std::make_shared<ParallelForState>(count, function);
+
+	const auto helperCount = std::min(count, getSize() + 1) - 1;
+
+	for (size_t i = 0; i < helperCount; i++)
+	{
+		createTask([state]()
+			{
+				state->run();
+			});
+	}
+
+	state->run();
+
+	{
+		std::unique_lock<std::mutex> lock(state->mutex);
+
+		state->condition.wait(lock, [&state]()
+			{
+				return state->finishedCount == state->count;
+			});
+	}
+
+	if (state->exception)
+		std::rethrow_exception(state->exception);
+}
+
 void TaskManager::initialize(size_t size)
 {
 	m_threads.reserve(size);
@@ -60,6 +60,12 @@ void AbstractFrameRenderer::initializeFrame()
 		m_updateFrameGraph = false;
 	}
 
+	{
+		ATEMA_BENCHMARK_TAG(_2, "Update hierarchies");
+
+		m_renderScene.updateHierarchies();
+	}
+
 	{
 		ATEMA_BENCHMARK_TAG(_2, "Begin frame");
 
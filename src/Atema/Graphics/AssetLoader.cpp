@@ -0,0 +1,241 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Atema/Graphics/AssetLoader.hpp>
+#include <Atema/Core/TaskManager.hpp>
+#include <Atema/Graphics/Model.hpp>
+#include <Atema/Graphics/Loaders/DefaultImageLoader.hpp>
+#include <Atema/Graphics/Loaders/ObjLoader.hpp>
+#include <Atema/Renderer/CommandBuffer.hpp>
+#include <Atema/Renderer/CommandPool.hpp>
+#include <Atema/Renderer/Fence.hpp>
+#include <Atema/Renderer/Renderer.hpp>
+
+#include <thread>
+
+using namespace at;
+
+AssetLoader::AssetLoader() :
+	m_pendingCount(0)
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+}
+
+AssetLoader& AssetLoader::instance()
+{
+	static AssetLoader s_instance;
+
+	return s_instance;
+}
+
+void AssetLoader::loadModel(const std::filesystem::path& path, const ModelLoader::Settings& settings, const Callback<Model>& callback)
+{
+	load<Model>([path, settings](UploadContext& context)
+		{
+			ModelLoader::Settings loaderSettings = settings;
+			loaderSettings.commandBuffer = context.commandBuffer;
+			loaderSettings.stagingBuffers = &context.stagingBuffers;
+
+			return ObjLoader::load(path, loaderSettings);
+		}, callback);
+}
+
+void AssetLoader::loadImage(const std::filesystem::path& path, const ImageLoader::Settings& settings, const Callback<Image>& callback)
+{
+	load<Image>([path, settings](UploadContext& context)
+		{
+			ImageLoader::Settings loaderSettings = settings;
+			loaderSettings.commandBuffer = context.commandBuffer;
+			loaderSettings.stagingBuffers = &context.stagingBuffers;
+
+			return DefaultImageLoader::load(path, loaderSettings);
+		}, callback);
+}
+
+void AssetLoader::update()
+{
+	std::vector<Ptr<Job>> recordedJobs;
+
+	{
+		std::lock_guard lockGuard(m_mutex);
+
+		std::swap(recordedJobs, m_recordedJobs);
+	}
+
+	std::exception_ptr exception;
+
+	// Submit every recorded upload at once
+	Batch newBatch;
+	std::vector<Ptr<CommandBuffer>> commandBuffers;
+
+	for (auto& job : recordedJobs)
+	{
+		if (job->exception)
+		{
+			// The commands may reference objects destroyed by the exception, they are never submitted
+			if (!exception)
+				exception = job->exception;
+
+			release(*job);
+		}
+		else
+		{
+			commandBuffers.emplace_back(job->context.commandBuffer);
+			newBatch.jobs.emplace_back(std::move(job));
+		}
+	}
+
+	if (!commandBuffers.empty())
+	{
+		newBatch.fence = Fence::create({});
+
+		Renderer::instance().submit(commandBuffers, {}, {}, newBatch.fence);
+
+		m_batches.emplace_back(std::move(newBatch));
+	}
+
+	// Batches share the same queue, so they finish in submission order
+	while (!m_batches.empty() && m_batches.front().fence->isSignaled())
+	{
+		auto batch = std::move(m_batches.front());
+
+		m_batches.pop_front();
+
+		for (auto& job : batch.jobs)
+		{
+			release(*job);
+
+			job->callback(job->asset);
+		}
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+void AssetLoader::waitForIdle()
+{
+	while (getPendingCount() > 0)
+	{
+		update();
+
+		if (!m_batches.empty())
+			m_batches.front().fence->wait();
+		else
+			std::this_thread::yield();
+	}
+}
+
+void AssetLoader::clear()
+{
+	waitForIdle();
+
+	// Workers are idle, pools can be used from this thread
+	m_releasedCommandBuffers.clear();
+	m_commandPools.clear();
+}
+
+size_t AssetLoader::getPendingCount() const noexcept
+{
+	return m_pendingCount;
+}
+
+void AssetLoader::push(std::function<Ptr<void>(UploadContext&)> loader, std::function<void(const Ptr<void>&)> callback)
+{
+	// Pools are created on first use, so the Renderer only needs to exist once assets are loaded
+	if (m_commandPools.empty())
+	{
+		const auto threadCount = TaskManager::instance().getSize();
+
+		CommandPool::Settings commandPoolSettings;
+		// Image loading generates mipmaps, which requires a graphics queue
+		commandPoolSettings.queueType = QueueType::Graphics;
+
+		m_commandPools.resize(threadCount);
+		m_releasedCommandBuffers.resize(threadCount);
+
+		for (auto& commandPool : m_commandPools)
+			commandPool = CommandPool::create(commandPoolSettings);
+	}
+
+	auto job = std::make_shared<Job>();
+	job->loader = std::move(loader);
+	job->callback = std::move(callback);
+
+	m_pendingCount++;
+
+	TaskManager::instance().createTask([this, job](size_t threadIndex)
+		{
+			run(job, threadIndex);
+		});
+}
+
+void AssetLoader::run(const Ptr<Job>& job, size_t threadIndex)
+{
+	// Command buffers of finished uploads are released by the thread owning their pool
+	std::vector<Ptr<CommandBuffer>> releasedCommandBuffers;
+
+	{
+		std::lock_guard lockGuard(m_mutex);
+
+		std::swap(releasedCommandBuffers, m_releasedCommandBuffers[threadIndex]);
+	}
+
+	releasedCommandBuffers.clear();
+
+	job->threadIndex = threadIndex;
+	job->context.commandBuffer = m_commandPools[threadIndex]->createBuffer({ true });
+
+	job->context.commandBuffer->begin();
+
+	try
+	{
+		job->asset = job->loader(job->context);
+	}
+	catch (...)
+	{
+		job->exception = std::current_exception();
+	}
+
+	job->context.commandBuffer->end();
+
+	std::lock_guard lockGuard(m_mutex);
+
+	m_recordedJobs.emplace_back(job);
+}
+
+void AssetLoader::release(Job& job)
+{
+	{
+		std::lock_guard lockGuard(m_mutex);
+
+		m_releasedCommandBuffers[job.threadIndex].emplace_back(std::move(job.context.commandBuffer));
+	}
+
+	job.context.stagingBuffers.clear();
+	job.loader = nullptr;
+
+	m_pendingCount--;
+}
@@ -40,9 +40,11 @@ namespace
 option
 {
 	uint LightingModel = 0;
+	bool QuantizedVertex = false;
 }
 
 include Atema.GBufferWrite;
+include Atema.VertexDecoding;
 
 struct FrameDataStruct
 {
@@ -55,6 +57,7 @@ struct FrameDataStruct
 struct TransformDataStruct
 {
 	mat4f model;
+	vec4f texCoordsQuantization;
 }
 
 external
@@ -71,6 +74,7 @@ input
 	[location(1)] vec2f inTexCoords;
 	[location(2)] vec3f inNormal;
 	[location(3)] vec3f inTangent;
+	[optional (!QuantizedVertex)]
 	[location(4)] vec3f inBitangent;
 }
 
@@ -85,16 +89,35 @@ output
 [entry(vertex)]
 void main()
 {
+	vec3f normal = inNormal;
+	vec3f tangent = inTangent;
+	vec3f bitangent;
+	vec2f texCoords = inTexCoords;
+	
+	// The position dequantization is already part of the model matrix
+	optional (QuantizedVertex)
+	{
+		normal = AtDecodeOctahedral(inNormal.xy);
+		tangent = AtDecodeOctahedral(inTangent.xy);
+		bitangent = cross(normal, tangent) * inTangent.z;
+		texCoords = inTexCoords * TransformData.texCoordsQuantization.xy + TransformData.texCoordsQuantization.zw;
+	}
+	
+	optional (!QuantizedVertex)
+	{
+		bitangent = inBitangent;
+	}
+	
 	vec4f worldPos = TransformData.model * vec4f(inPosition, 1.0);
-	vec3f worldNormal = normalize(TransformData.model * vec4f(inNormal, 0.0)).xyz;
-	vec3f worldTangent = normalize(TransformData.model * vec4f(inTangent, 0.0)).xyz;
-	vec3f worldBitangent = normalize(TransformData.model * vec4f(inBitangent, 0.0)).xyz;
+	vec3f worldNormal = normalize(TransformData.model * vec4f(normal, 0.0)).xyz;
+	vec3f worldTangent = normalize(TransformData.model * vec4f(tangent, 0.0)).xyz;
+	vec3f worldBitangent = normalize(TransformData.model * vec4f(bitangent, 0.0)).xyz;
 	
 	outPosition = worldPos.xyz;
 	
 	outTBN = mat3f(worldTangent, worldBitangent, worldNormal);
 	
-	outTexCoords = inTexCoords;
+	outTexCoords = texCoords;
 	
 	vec4f screenPosition = FrameData.proj * FrameData.view * worldPos;
 	
@@ -152,9 +175,11 @@ option
 {
 	uint LightingModel = 0;
 	bool UseAlphaMask = true;
+	bool QuantizedVertex = false;
 }
 
 include Atema.GBufferWrite;
+include Atema.VertexDecoding;
 
 struct FrameDataStruct
 {
@@ -167,6 +192,7 @@ struct FrameDataStruct
 struct TransformDataStruct
 {
 	mat4f model;
+	vec4f texCoordsQuantization;
 }
 
 external
@@ -183,6 +209,7 @@ input
 	[location(1)] vec2f inTexCoords;
 	[location(2)] vec3f inNormal;
 	[location(3)] vec3f inTangent;
+	[optional (!QuantizedVertex)]
 	[location(4)] vec3f inBitangent;
 }
 
@@ -199,16 +226,35 @@ output
 [entry(vertex)]
 void main()
 {
+	vec3f normal = inNormal;
+	vec3f tangent = inTangent;
+	vec3f bitangent;
+	vec2f texCoords = inTexCoords;
+	
+	// The position dequantization is already part of the model matrix
+	optional (QuantizedVertex)
+	{
+		normal = AtDecodeOctahedral(inNormal.xy);
+		tangent = AtDecodeOctahedral(inTangent.xy);
+		bitangent = cross(normal, tangent) * inTangent.z;
+		texCoords = inTexCoords * TransformData.texCoordsQuantization.xy + TransformData.texCoordsQuantization.zw;
+	}
+	
+	optional (!QuantizedVertex)
+	{
+		bitangent = inBitangent;
+	}
+	
 	vec4f worldPos = TransformData.model * vec4f(inPosition, 1.0);
-	vec3f worldNormal = normalize(TransformData.model * vec4f(inNormal, 0.0)).xyz;
-	vec3f worldTangent = normalize(TransformData.model * vec4f(inTangent, 0.0)).xyz;
-	vec3f worldBitangent = normalize(TransformData.model * vec4f(inBitangent, 0.0)).xyz;
+	vec3f worldNormal = normalize(TransformData.model * vec4f(normal, 0.0)).xyz;
+	vec3f worldTangent = normalize(TransformData.model * vec4f(tangent, 0.0)).xyz;
+	vec3f worldBitangent = normalize(TransformData.model * vec4f(bitangent, 0.0)).xyz;
 	
 	outPosition = worldPos.xyz;
 	
 	outTBN = mat3f(worldTangent, worldBitangent, worldNormal);
 	
-	outTexCoords = inTexCoords;
+	outTexCoords = texCoords;
 	
 	outTanViewDir = outTBN * (FrameData.cameraPosition - worldPos.xyz);
 	
@@ -377,9 +423,11 @@ option
 {
 	uint LightingModel = 0;
 	bool UseAlphaMask = true;
+	bool QuantizedVertex = false;
 }
 
 include Atema.GBufferWrite;
+include Atema.VertexDecoding;
 
 struct FrameDataStruct
 {
@@ -392,6 +440,7 @@ struct FrameDataStruct
 struct TransformDataStruct
 {
 	mat4f model;
+	vec4f texCoordsQuantization;
 }
 
 external
@@ -408,6 +457,7 @@ input
 	[location(1)] vec2f inTexCoords;
 	[location(2)] vec3f inNormal;
 	[location(3)] vec3f inTangent;
+	[optional (!QuantizedVertex)]
 	[location(4)] vec3f inBitangent;
 }
 
@@ -424,16 +474,35 @@ output
 [entry(vertex)]
 void main()
 {
+	vec3f normal = inNormal;
+	vec3f tangent = inTangent;
+	vec3f bitangent;
+	vec2f texCoords = inTexCoords;
+	
+	// The position dequantization is already part of the model matrix
+	optional (QuantizedVertex)
+	{
+		normal = AtDecodeOctahedral(inNormal.xy);
+		tangent = AtDecodeOctahedral(inTangent.xy);
+		bitangent = cross(normal, tangent) * inTangent.z;
+		texCoords = inTexCoords * TransformData.texCoordsQuantization.xy + TransformData.texCoordsQuantization.zw;
+	}
+	
+	optional (!QuantizedVertex)
+	{
+		bitangent = inBitangent;
+	}
+	
 	vec4f worldPos = TransformData.model * vec4f(inPosition, 1.0);
-	vec3f worldNormal = normalize(TransformData.model * vec4f(inNormal, 0.0)).xyz;
-	vec3f worldTangent = normalize(TransformData.model * vec4f(inTangent, 0.0)).xyz;
-	vec3f worldBitangent = normalize(TransformData.model * vec4f(inBitangent, 0.0)).xyz;
+	vec3f worldNormal = normalize(TransformData.model * vec4f(normal, 0.0)).xyz;
+	vec3f worldTangent = normalize(TransformData.model * vec4f(tangent, 0.0)).xyz;
+	vec3f worldBitangent = normalize(TransformData.model * vec4f(bitangent, 0.0)).xyz;
 	
 	outPosition = worldPos.xyz;
 	
 	outTBN = mat3f(worldTangent, worldBitangent, worldNormal);
 	
-	outTexCoords = inTexCoords;
+	outTexCoords = texCoords;
 	
 	outTanViewDir = outTBN * (FrameData.cameraPosition - worldPos.xyz);
 	
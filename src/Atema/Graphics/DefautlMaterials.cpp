@@ -23,6 +23,7 @@
 #include <Atema/Graphics/DefaultMaterials.hpp>
 #include <Atema/Graphics/Graphics.hpp>
 #include <Atema/Graphics/MaterialData.hpp>
+#include <Atema/Graphics/TextureStreamer.hpp>
 
 #include <optional>
 
@@ -812,6 +813,28 @@ MaterialFragmentParameters getMaterialFragmentParameters()
 				mapMemory<float>(dstData, offsets.alphaMaskThreshold) = AlphaMaskThreshold;
 		}
 	};
+
+	// Default image settings, color maps being filtered as sRGB values
+	ImageLoader::Settings getImageSettings(const std::string& textureName)
+	{
+		auto settings = Graphics::instance().getDefaultImageSettings();
+
+		if (textureName == MaterialData::BaseColorMap || textureName == MaterialData::EmissiveColorMap)
+			settings.srgb = true;
+
+		return settings;
+	}
+
+	// Textures are streamed if TextureStreamer is enabled, or loaded entirely
+	void setTexture(MaterialInstance& materialInstance, const std::string& name, const std::filesystem::path& path, const Ptr<Sampler>& sampler)
+	{
+		auto& textureStreamer = TextureStreamer::instance();
+
+		if (textureStreamer.isEnabled())
+			textureStreamer.setParameter(materialInstance, name, path, sampler, getImageSettings(name));
+		else
+			materialInstance.setParameter(name, Graphics::instance().getImage(path, getImageSettings(name)), sampler);
+	}
 }
 
 Ptr<Material> DefaultMaterials::getEmissive(const MaterialData& materialData)
@@ -828,6 +851,7 @@ Ptr<Material> DefaultMaterials::getEmissive(const MaterialData& materialData)
 	// Define shader options
 	const std::vector<UberShader::Option> shaderOptions =
 	{
+		{ "QuantizedVertex", useQuantizedVertex(materialData) }
 	};
 
 	// Get the raw shader
@@ -839,6 +863,9 @@ Ptr<Material> DefaultMaterials::getEmissive(const MaterialData& materialData)
 	MaterialData metaData;
 	metaData.set(MaterialData::LightingModel, "Emissive");
 
+	if (useQuantizedVertex(materialData))
+		metaData.set(MaterialData::QuantizedVertex, 1u);
+
 	return graphics.getMaterial(*uberShader, metaData);
 }
 
@@ -880,7 +907,8 @@ Ptr<Material> DefaultMaterials::getPhong(const MaterialData& materialData)
 		{ "MaterialRoughnessMapBinding", phongData.textureBindings.RoughnessMap },
 		{ "MaterialAlphaMaskMapBinding", phongData.textureBindings.AlphaMaskMap },
 		{ "MaterialStructBinding", phongData.structBinding },
-		{ "UseAlphaMask", phongData.textureBindings.AlphaMaskMap != DefaultPhongData::InvalidBinding }
+		{ "UseAlphaMask", phongData.textureBindings.AlphaMaskMap != DefaultPhongData::InvalidBinding },
+		{ "QuantizedVertex", useQuantizedVertex(materialData) }
 	};
 
 	// Get the raw shader
@@ -892,6 +920,9 @@ Ptr<Material> DefaultMaterials::getPhong(const MaterialData& materialData)
 	MaterialData metaData;
 	metaData.set(MaterialData::LightingModel, "Phong");
 
+	if (useQuantizedVertex(materialData))
+		metaData.set(MaterialData::QuantizedVertex, 1u);
+
 	return graphics.getMaterial(*uberShader, metaData);
 }
 
@@ -911,10 +942,7 @@ Ptr<MaterialInstance> DefaultMaterials::getPhongInstance(const MaterialData& mat
 
 #define ATEMA_PHONG_SET_TEXTURE(atTextureName) \
 	if (!phongData.atTextureName ## Path.empty()) \
-	{ \
-		const auto image = graphics.getImage(phongData.atTextureName ## Path); \
-		materialInstance->setParameter(#atTextureName, image, sampler); \
-	}
+		setTexture(*materialInstance, #atTextureName, phongData.atTextureName ## Path, sampler);
 
 	ATEMA_PHONG_SET_TEXTURE(BaseColorMap)
 	ATEMA_PHONG_SET_TEXTURE(NormalMap)
@@ -956,7 +984,8 @@ Ptr<Material> DefaultMaterials::getPBR(const MaterialData& materialData)
 		{ "MaterialRoughnessMapBinding", pbrData.textureBindings.RoughnessMap },
 		{ "MaterialAlphaMaskMapBinding", pbrData.textureBindings.AlphaMaskMap },
 		{ "MaterialStructBinding", pbrData.structBinding },
-		{ "UseAlphaMask", pbrData.textureBindings.AlphaMaskMap != DefaultPBRData::InvalidBinding }
+		{ "UseAlphaMask", pbrData.textureBindings.AlphaMaskMap != DefaultPBRData::InvalidBinding },
+		{ "QuantizedVertex", useQuantizedVertex(materialData) }
 	};
 
 	// Get the raw shader
@@ -968,6 +997,9 @@ Ptr<Material> DefaultMaterials::getPBR(const MaterialData& materialData)
 	MaterialData metaData;
 	metaData.set(MaterialData::LightingModel, "PBR");
 
+	if (useQuantizedVertex(materialData))
+		metaData.set(MaterialData::QuantizedVertex, 1u);
+
 	return graphics.getMaterial(*uberShader, metaData);
 }
 
@@ -987,10 +1019,7 @@ Ptr<MaterialInstance> DefaultMaterials::getPBRInstance(const MaterialData& mater
 
 #define ATEMA_PBR_SET_TEXTURE(atTextureName) \
 	if (!pbrData.atTextureName ## Path.empty()) \
-	{ \
-		const auto image = graphics.getImage(pbrData.atTextureName ## Path); \
-		materialInstance->setParameter(#atTextureName, image, sampler); \
-	}
+		setTexture(*materialInstance, #atTextureName, pbrData.atTextureName ## Path, sampler);
 
 	ATEMA_PBR_SET_TEXTURE(BaseColorMap)
 	ATEMA_PBR_SET_TEXTURE(NormalMap)
@@ -1008,3 +1037,49 @@ Ptr<MaterialInstance> DefaultMaterials::getPBRInstance(const MaterialData& mater
 
 	return materialInstance;
 }
+
+void DefaultMaterials::loadTextures(const std::vector<Ptr<MaterialData>>& materialData)
+{
+	if (TextureStreamer::instance().isEnabled())
+		return;
+
+	// Color maps don't share the settings of the other textures
+	std::vector<std::filesystem::path> colorPaths;
+	std::vector<std::filesystem::path> paths;
+
+	for (const auto& material : materialData)
+	{
+		for (const auto& parameter : material->getParameters())
+		{
+			if (!parameter.value.is<MaterialData::Texture>())
+				continue;
+
+			const auto& path = parameter.value.get<MaterialData::Texture>().path;
+
+			if (getImageSettings(parameter.name).srgb)
+				colorPaths.emplace_back(path);
+			else
+				paths.emplace_back(path);
+		}
+	}
+
+	auto& graphics = Graphics::instance();
+
+	graphics.getImages(colorPaths, getImageSettings(MaterialData::BaseColorMap));
+	graphics.getImages(paths, getImageSettings(MaterialData::NormalMap));
+}
+
+bool DefaultMaterials::useQuantizedVertex(const MaterialData& materialData)
+{
+	if (!materialData.exists(MaterialData::QuantizedVertex))
+		return false;
+
+	const auto& value = materialData.getValue(MaterialData::QuantizedVertex);
+
+	if (value.is<uint32_t>())
+		return value.get<uint32_t>() != 0;
+	else if (value.is<int32_t>())
+		return value.get<int32_t>() != 0;
+
+	return false;
+}
@@ -19,6 +19,7 @@
 	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#include <Atema/Graphics/DefaultMaterials.hpp>
 #include <Atema/Graphics/DirectionalLight.hpp>
 #include <Atema/Graphics/FrameRenderer.hpp>
 #include <Atema/Graphics/FrameGraphBuilder.hpp>
@@ -53,7 +54,9 @@ FrameRenderer::FrameRenderer() :
 	m_enableDebugShadowMaps(false),
 	m_enableToneMapping(true),
 	m_exposure(1.0f),
-	m_gamma(2.2f)
+	m_gamma(2.2f),
+	m_lodThreshold(1.0f),
+	m_shadowLodBias(2.0f)
 {
 	createGBuffer();
 }
@@ -74,6 +77,11 @@ Ptr<RenderMaterial> FrameRenderer::createRenderMaterial(Ptr<Material> material)
 	settings.material = material.get();
 	settings.id = materialID;
 	settings.shaderLibraryManager = &m_shaderLibraryManager;
+	// Scene materials can appear at any time : don't stall the frame while their pipeline compiles
+	settings.asyncPipeline = true;
+
+	if (DefaultMaterials::useQuantizedVertex(material->getMetaData()))
+		settings.vertexFormat = VertexFormat::create(DefaultVertexFormat::XYZ_UV_NT_Quantized);
 
 	settings.pipelineState.stencil = true;
 	settings.pipelineState.stencilFront.compareOperation = CompareOperation::Always;
@@ -147,6 +155,19 @@ void FrameRenderer::setGamma(float gamma)
 		m_toneMappingPass->setGamma(gamma);
 }
 
+void FrameRenderer::setLodThreshold(float pixels)
+{
+	m_lodThreshold = pixels;
+
+	if (m_gbufferPass)
+		m_gbufferPass->setLodThreshold(pixels);
+}
+
+void FrameRenderer::setShadowLodBias(float texels)
+{
+	m_shadowLodBias = texels;
+}
+
 void FrameRenderer::createFrameGraph()
 {
 	m_oldFrameGraphs.emplace_back(std::move(m_frameGraph));
@@ -454,6 +475,7 @@ void FrameRenderer::createPasses()
 	if (m_gbuffer)
 	{
 		m_gbufferPass = std::make_unique<GBufferPass>(renderResourceManager, ThreadCount);
+		m_gbufferPass->setLodThreshold(m_lodThreshold);
 
 		m_lightPass = std::make_unique<LightPass>(getRenderScene().getResourceManager(), *m_gbuffer, m_shaderLibraryManager, ThreadCount);
 		m_lightPass->setLightingModels(m_lightingModelNames);
@@ -677,6 +699,9 @@ void FrameRenderer::updateShadowData(RenderLight& renderLight, ShadowPassData& s
 
 				shadowPass.setFrustum(Frustumf(cullingProj * lightView));
 
+				// Farther cascades have bigger texels, so they use coarser LODs
+				shadowPass.setLodError(texelSizeWorldSpace * m_shadowLodBias);
+
 				previousDepth = depth;
 			}
 
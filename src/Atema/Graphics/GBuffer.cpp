@@ -20,10 +20,9 @@
 */
 
 #include <Atema/Graphics/GBuffer.hpp>
+#include <Atema/Graphics/Graphics.hpp>
 #include <Atema/Renderer/Utils.hpp>
 #include <Atema/Renderer/Renderer.hpp>
-#include <Atema/Shader/Atsl/AtslParser.hpp>
-#include <Atema/Shader/Atsl/AtslToAstConverter.hpp>
 
 #include <set>
 
@@ -572,15 +571,7 @@ void GBuffer::generateShaderLibraries(ShaderLibraryManager& shaderLibraryManager
 	}
 
 	for (const auto& [libName, lib] : shaderLibraries)
-	{
-		AtslParser parser;
-
-		AtslToAstConverter converter;
-
-		auto ast = converter.createAst(parser.createTokens(lib));
-
-		shaderLibraryManager.setLibrary(libName, std::move(ast));
-	}
+		shaderLibraryManager.setLibrary(libName, Graphics::instance().createShaderAst(libName, lib));
 }
 
 bool GBuffer::isCompatible(const LightingModel& lightingModel) const
@@ -31,10 +31,15 @@
 #include <Atema/Graphics/VertexBuffer.hpp>
 #include <Atema/Graphics/VertexTypes.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <map>
 #include <optional>
+#include <sstream>
+#include <unordered_set>
 
 using namespace at;
 
@@ -176,12 +181,29 @@ void main()
 	FaceBack = getCubemapFaceColor(CubemapBackIndex, normalize(uvwBack));
 	FaceBottom = getCubemapFaceColor(CubemapBottomIndex, normalize(uvwBottom));
 }
+)";
+
+	// Decoding of the quantized vertex components (see ModelLoader)
+	const char VertexDecodingShader[] = R"(
+// Unit vector from its octahedral encoding in [-1,1]
+vec3f AtDecodeOctahedral(vec2f value)
+{
+	float z = 1.0 - abs(value.x) - abs(value.y);
+	float t = max(-z, 0.0);
+	
+	// The lower hemisphere is folded over the diagonals
+	float x = value.x + ((value.x >= 0.0) ? -t : t);
+	float y = value.y + ((value.y >= 0.0) ? -t : t);
+	
+	return normalize(vec3f(x, y, z));
+}
 )";
 
 	const std::unordered_map<std::string, const char*> s_shaderLibraries =
 	{
 		{ "Atema.PostProcess", PostProcessShader },
 		{ "Atema.CubemapPass", CubemapPassShader },
+		{ "Atema.VertexDecoding", VertexDecodingShader },
 	};
 
 	struct SurfaceMaterialParameter
@@ -224,6 +246,68 @@ void main()
 		return BufferElementType::Int;
 	}
 
+	std::string readFile(const std::filesystem::path& path)
+	{
+		std::ifstream file(path);
+
+		if (!file.is_open())
+			ATEMA_ERROR("Failed to open file '" + path.string() + "'");
+
+		std::stringstream code;
+		code << file.rdbuf();
+
+		return code.str();
+	}
+
+	// Only the active member is hashed : the remaining bytes of the variant storage are undefined
+	void hashConstantValue(StdHash& hash, const ConstantValue& constantValue)
+	{
+		DefaultStdHasher::hashCombine(hash, getElementType(constantValue));
+
+		if (constantValue.is<bool>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<bool>());
+		else if (constantValue.is<int32_t>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<int32_t>());
+		else if (constantValue.is<uint32_t>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<uint32_t>());
+		else if (constantValue.is<float>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<float>());
+		else if (constantValue.is<Vector2i>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector2i>());
+		else if (constantValue.is<Vector2u>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector2u>());
+		else if (constantValue.is<Vector2f>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector2f>());
+		else if (constantValue.is<Vector3i>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector3i>());
+		else if (constantValue.is<Vector3u>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector3u>());
+		else if (constantValue.is<Vector3f>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector3f>());
+		else if (constantValue.is<Vector4i>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector4i>());
+		else if (constantValue.is<Vector4u>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector4u>());
+		else if (constantValue.is<Vector4f>())
+			DefaultStdHasher::hashCombine(hash, constantValue.get<Vector4f>());
+	}
+
+	template <typename T>
+	bool isSameBytes(const T& value1, const T& value2)
+	{
+		return std::memcmp(&value1, &value2, sizeof(T)) == 0;
+	}
+
+	Ptr<Shader> createShader(const UberShader& uberShader)
+	{
+		Shader::Settings settings;
+		settings.shaderLanguage = ShaderLanguage::Ast;
+		settings.shaderData = uberShader.getAst().get();
+		settings.shaderDataSize = 1;
+
+		return Shader::create(settings);
+	}
+
 	std::vector<Vertex_XYZ_UV> quadVertices =
 	{
 		{{ -1.0f, -1.0f, 0.0f }, { 0.0f, 0.0f }},
@@ -260,8 +344,11 @@ StdHash Graphics::UberInstanceSettings::hash(const UberInstanceSettings& setting
 	DefaultStdHasher::hashCombine(hash, settings.uberShader);
 	DefaultStdHasher::hashCombine(hash, settings.shaderLibraryManager);
 
-	for (const auto& kv : orderedOptions)
-		DefaultStdHasher::hashCombine(hash, *kv.second);
+	for (const auto& [name, value] : orderedOptions)
+	{
+		DefaultStdHasher::hashCombine(hash, name);
+		hashConstantValue(hash, *value);
+	}
 
 	return hash;
 }
@@ -291,6 +378,10 @@ StdHash Graphics::ImageSettings::hash(const ImageSettings& settings)
 	DefaultStdHasher::hashCombine(hash, settings.settings.samples);
 	DefaultStdHasher::hashCombine(hash, settings.settings.tiling);
 	DefaultStdHasher::hashCombine(hash, settings.settings.usages);
+	DefaultStdHasher::hashCombine(hash, settings.settings.compression);
+	DefaultStdHasher::hashCombine(hash, settings.settings.mipFilter);
+	DefaultStdHasher::hashCombine(hash, settings.settings.srgb);
+	DefaultStdHasher::hashCombine(hash, settings.settings.cacheDirectory);
 
 	return hash;
 }
@@ -348,7 +439,10 @@ Graphics::Graphics()
 			return loadGraphicsPipelineSettings(settings);
 		});
 
-	m_graphicsPipelineManager.addLoader(&loadGraphicsPipeline);
+	m_graphicsPipelineManager.addLoader([this](const GraphicsPipeline::Settings& settings)
+		{
+			return loadGraphicsPipeline(settings);
+		});
 
 	m_imageManager.addLoader(&loadImage);
 
@@ -414,6 +508,7 @@ Graphics::Graphics()
 
 Graphics::~Graphics()
 {
+	waitAsync();
 }
 
 Graphics& Graphics::instance()
@@ -431,12 +526,24 @@ void Graphics::setMaxUnusedCounter(uint32_t counter)
 
 void Graphics::clearUnused()
 {
+	// Pending resources keep their dependencies alive, so they are released first
+	clearUnusedAsyncLoads(m_asyncUberInstances);
+	clearUnusedAsyncLoads(m_asyncShaders);
+	clearUnusedAsyncLoads(m_asyncGraphicsPipelines);
+
 	for (auto& resourceManager : m_resourceManagers)
 		resourceManager->clearUnused();
 }
 
 void Graphics::clear()
 {
+	// Pending resources may depend on resources we are about to delete
+	waitAsync();
+
+	m_asyncUberInstances.clear();
+	m_asyncShaders.clear();
+	m_asyncGraphicsPipelines.clear();
+
 	m_lightingModels.clear();
 	m_lightingModelIDs.clear();
 
@@ -454,15 +561,48 @@ void Graphics::clear()
 void Graphics::initializeShaderLibraries(ShaderLibraryManager& libraryManager)
 {
 	for (const auto& [libName, lib] : s_shaderLibraries)
-	{
-		AtslParser parser;
+		libraryManager.setLibrary(libName, createShaderAst(libName, lib));
+}
+
+bool Graphics::loadShaderBundle(const std::filesystem::path& path)
+{
+	return m_shaderBundle.load(path);
+}
 
-		AtslToAstConverter converter;
+void Graphics::saveShaderBundle(const std::filesystem::path& path)
+{
+	if (m_parsedShaderBundle.getSize() == 0)
+		return;
 
-		auto ast = converter.createAst(parser.createTokens(lib));
+	// The loaded bundle may map the file being written : copy its entries first
+	ShaderLibraryBundle bundle;
+	bundle.add(m_shaderBundle);
+	bundle.add(m_parsedShaderBundle);
 
-		libraryManager.setLibrary(libName, std::move(ast));
-	}
+	m_shaderBundle.clear();
+	m_parsedShaderBundle.clear();
+
+	bundle.save(path);
+
+	m_shaderBundle.add(bundle);
+}
+
+UPtr<SequenceStatement> Graphics::createShaderAst(const std::string& name, const std::string& atslCode)
+{
+	const auto key = ShaderLibraryBundle::getKey(atslCode);
+
+	if (m_shaderBundle.contains(key))
+		return m_shaderBundle.getAst(key);
+
+	AtslParser parser;
+
+	AtslToAstConverter converter;
+
+	auto ast = converter.createAst(parser.createTokens(atslCode));
+
+	m_parsedShaderBundle.add(key, name, *ast);
+
+	return ast;
 }
 
 void Graphics::addLightingModel(const LightingModel& lightingModel)
@@ -604,13 +744,7 @@ Ptr<DescriptorSetLayout> Graphics::getLightShadowLayout()
 
 void Graphics::setUberShader(const std::string& identifier, const std::string& shaderCode)
 {
-	AtslParser parser;
-
-	AtslToAstConverter converter;
-
-	auto ast = converter.createAst(parser.createTokens(shaderCode));
-
-	auto uberShader = std::make_shared<UberShader>(std::move(ast));
+	auto uberShader = std::make_shared<UberShader>(createShaderAst(identifier, shaderCode));
 
 	m_uberShaderIdManager.set(identifier, uberShader);
 
@@ -636,7 +770,10 @@ Ptr<UberShader> Graphics::getUberShader(const std::filesystem::path& path)
 
 Ptr<UberShader> Graphics::getUberShader(const UberShader& baseUberShader, const std::vector<UberShader::Option>& options, const ShaderLibraryManager* shaderLibraryManager)
 {
-	return m_uberShaderOptionsManager.get({ &baseUberShader, shaderLibraryManager, options });
+	// Options the shader doesn't depend on would only create duplicate instances
+	const auto relevantOptions = baseUberShader.getRelevantOptions(options, shaderLibraryManager);
+
+	return m_uberShaderOptionsManager.get({ &baseUberShader, shaderLibraryManager, relevantOptions });
 }
 
 Ptr<UberShader> Graphics::getUberShader(const UberShader& baseUberShader, AstShaderStage shaderStage)
@@ -688,11 +825,55 @@ Ptr<GraphicsPipeline> Graphics::getGraphicsPipeline(const GraphicsPipeline::Sett
 	return m_graphicsPipelineManager.get(settings);
 }
 
+void Graphics::setDefaultImageSettings(const ImageLoader::Settings& settings)
+{
+	m_defaultImageSettings = settings;
+}
+
+const ImageLoader::Settings& Graphics::getDefaultImageSettings() const noexcept
+{
+	return m_defaultImageSettings;
+}
+
+Ptr<Image> Graphics::getImage(const std::filesystem::path& path)
+{
+	return getImage(path, m_defaultImageSettings);
+}
+
 Ptr<Image> Graphics::getImage(const std::filesystem::path& path, const ImageLoader::Settings& settings)
 {
 	return m_imageManager.get({ path, settings });
 }
 
+std::vector<Ptr<Image>> Graphics::getImages(const std::vector<std::filesystem::path>& paths, const ImageLoader::Settings& settings)
+{
+	// Distinct paths only, the same image would be decoded twice otherwise
+	std::vector<std::filesystem::path> missingPaths;
+	std::unordered_set<std::string> missingPathSet;
+
+	for (const auto& path : paths)
+	{
+		if (!m_imageManager.contains({ path, settings }) && missingPathSet.emplace(path.string()).second)
+			missingPaths.emplace_back(path);
+	}
+
+	const auto missingImages = DefaultImageLoader::load(missingPaths, settings);
+
+	for (size_t i = 0; i < missingPaths.size(); i++)
+	{
+		if (missingImages[i])
+			m_imageManager.set({ missingPaths[i], settings }, missingImages[i]);
+	}
+
+	std::vector<Ptr<Image>> images;
+	images.reserve(paths.size());
+
+	for (const auto& path : paths)
+		images.emplace_back(m_imageManager.get({ path, settings }));
+
+	return images;
+}
+
 Ptr<Sampler> Graphics::getSampler(const Sampler::Settings& settings)
 {
 	return m_samplerManager.get(settings);
@@ -703,9 +884,231 @@ Ptr<Material> Graphics::getMaterial(const UberShader& uberShader, const Material
 	return m_materialManager.get({ uberShader, metaData });
 }
 
+Ptr<UberShader> Graphics::getUberShaderAsync(const UberShader& baseUberShader, const std::vector<UberShader::Option>& options, const ShaderLibraryManager* shaderLibraryManager)
+{
+	const auto relevantOptions = baseUberShader.getRelevantOptions(options, shaderLibraryManager);
+
+	const UberInstanceSettings settings(&baseUberShader, shaderLibraryManager, relevantOptions);
+
+	if (m_uberShaderOptionsManager.contains(settings))
+		return m_uberShaderOptionsManager.get(settings);
+
+	Ptr<const void> dependency;
+
+	const auto it = m_uberShaders.find(&baseUberShader);
+	if (it != m_uberShaders.end())
+		dependency = it->second.lock();
+
+	// Options are copied : the task may outlive the caller's vector
+	auto loader = [&baseUberShader, shaderLibraryManager, relevantOptions]()
+	{
+		return baseUberShader.createInstance(relevantOptions, shaderLibraryManager);
+	};
+
+	// The loader will take the pending resource, see loadUberInstance
+	if (loadAsync(m_asyncUberInstances, UberInstanceSettings::hash(settings), UberInstanceKey{ &baseUberShader, shaderLibraryManager, relevantOptions }, dependency, loader))
+		return m_uberShaderOptionsManager.get(settings);
+
+	return nullptr;
+}
+
+Ptr<Shader> Graphics::getShaderAsync(const UberShader& uberShader)
+{
+	if (m_shaderManager.contains(&uberShader))
+		return m_shaderManager.get(&uberShader);
+
+	Ptr<const void> dependency;
+
+	const auto it = m_uberShaders.find(&uberShader);
+	if (it != m_uberShaders.end())
+		dependency = it->second.lock();
+
+	auto loader = [&uberShader]()
+	{
+		return createShader(uberShader);
+	};
+
+	if (loadAsync(m_asyncShaders, DefaultStdHasher::hash(&uberShader), &uberShader, dependency, loader))
+		return m_shaderManager.get(&uberShader);
+
+	return nullptr;
+}
+
+Ptr<GraphicsPipeline> Graphics::getGraphicsPipelineAsync(const GraphicsPipeline::Settings& settings)
+{
+	if (m_graphicsPipelineManager.contains(settings))
+		return m_graphicsPipelineManager.get(settings);
+
+	// Settings own their shaders & layouts, so copying them is enough to keep dependencies alive
+	auto loader = [settings]()
+	{
+		return GraphicsPipeline::create(settings);
+	};
+
+	if (loadAsync(m_asyncGraphicsPipelines, DefaultStdHasher::hash(settings), settings, nullptr, loader))
+		return m_graphicsPipelineManager.get(settings);
+
+	return nullptr;
+}
+
+bool Graphics::isLoadingAsync() const
+{
+	return !m_asyncUberInstances.empty() || !m_asyncShaders.empty() || !m_asyncGraphicsPipelines.empty();
+}
+
+void Graphics::waitAsync()
+{
+	waitAsyncLoads(m_asyncUberInstances);
+	waitAsyncLoads(m_asyncShaders);
+	waitAsyncLoads(m_asyncGraphicsPipelines);
+}
+
+bool Graphics::isSameKey(const UberInstanceKey& key1, const UberInstanceKey& key2)
+{
+	if (key1.uberShader != key2.uberShader || key1.shaderLibraryManager != key2.shaderLibraryManager || key1.options.size() != key2.options.size())
+		return false;
+
+	// Options are not ordered, see UberInstanceSettings::hash
+	for (const auto& option : key1.options)
+	{
+		const auto predicate = [&option](const UberShader::Option& other)
+		{
+			return other.name == option.name && other.value == option.value;
+		};
+
+		if (std::find_if(key2.options.begin(), key2.options.end(), predicate) == key2.options.end())
+			return false;
+	}
+
+	return true;
+}
+
+bool Graphics::isSameKey(const UberShader* key1, const UberShader* key2)
+{
+	return key1 == key2;
+}
+
+bool Graphics::isSameKey(const GraphicsPipeline::Settings& key1, const GraphicsPipeline::Settings& key2)
+{
+	const auto& state1 = key1.state;
+	const auto& state2 = key2.state;
+
+	// Same data as HashOverload<GraphicsPipeline::Settings>
+	return state1.vertexInput.inputs.size() == state2.vertexInput.inputs.size()
+		&& std::memcmp(state1.vertexInput.inputs.data(), state2.vertexInput.inputs.data(), state1.vertexInput.inputs.size() * sizeof(VertexInput)) == 0
+		&& isSameBytes(state1.inputAssembly, state2.inputAssembly)
+		&& isSameBytes(state1.rasterization, state2.rasterization)
+		&& isSameBytes(state1.multisample, state2.multisample)
+		&& isSameBytes(state1.colorBlend, state2.colorBlend)
+		&& isSameBytes(state1.depth, state2.depth)
+		&& state1.stencil == state2.stencil
+		&& isSameBytes(state1.stencilFront, state2.stencilFront)
+		&& isSameBytes(state1.stencilBack, state2.stencilBack)
+		&& key1.descriptorSetLayouts == key2.descriptorSetLayouts
+		&& key1.vertexShader == key2.vertexShader
+		&& key1.fragmentShader == key2.fragmentShader;
+}
+
+template <typename T, typename Key>
+bool Graphics::loadAsync(AsyncLoadMap<T, Key>& asyncLoads, StdHash hash, const Key& key, const Ptr<const void>& dependency, const typename AsyncLoad<T, Key>::Loader& loader)
+{
+	const auto it = asyncLoads.find(hash);
+
+	if (it != asyncLoads.end())
+	{
+		if (!isSameKey(it->second->key, key))
+			return true;
+
+		it->second->requested = true;
+
+		return it->second->finished;
+	}
+
+	auto asyncLoad = std::make_shared<AsyncLoad<T, Key>>();
+	asyncLoad->key = key;
+	asyncLoad->dependency = dependency;
+
+	// The AsyncLoad is always waited for before being destroyed, so a raw pointer is enough here
+	auto asyncLoadPtr = asyncLoad.get();
+
+	asyncLoad->task = TaskManager::instance().createTask([asyncLoadPtr, loader]()
+		{
+			// Exceptions can't cross threads : they are rethrown when the resource is taken
+			try
+			{
+				asyncLoadPtr->resource = loader();
+			}
+			catch (...)
+			{
+				asyncLoadPtr->exception = std::current_exception();
+			}
+
+			asyncLoadPtr->finished = true;
+		});
+
+	asyncLoads.emplace(hash, std::move(asyncLoad));
+
+	return false;
+}
+
+template <typename T, typename Key>
+Ptr<T> Graphics::takeAsync(AsyncLoadMap<T, Key>& asyncLoads, StdHash hash, const Key& key)
+{
+	const auto it = asyncLoads.find(hash);
+
+	if (it == asyncLoads.end() || !isSameKey(it->second->key, key))
+		return nullptr;
+
+	auto asyncLoad = std::move(it->second);
+
+	asyncLoads.erase(it);
+
+	asyncLoad->task->wait();
+
+	if (asyncLoad->exception)
+		std::rethrow_exception(asyncLoad->exception);
+
+	return std::move(asyncLoad->resource);
+}
+
+template <typename T, typename Key>
+void Graphics::waitAsyncLoads(AsyncLoadMap<T, Key>& asyncLoads)
+{
+	for (auto& [hash, asyncLoad] : asyncLoads)
+		asyncLoad->task->wait();
+}
+
+template <typename T, typename Key>
+void Graphics::clearUnusedAsyncLoads(AsyncLoadMap<T, Key>& asyncLoads)
+{
+	for (auto it = asyncLoads.begin(); it != asyncLoads.end();)
+	{
+		auto& asyncLoad = *it->second;
+
+		// Requested resources get another chance to be taken, running tasks are kept until they finish
+		if (asyncLoad.requested || !asyncLoad.finished)
+		{
+			asyncLoad.requested = false;
+			it++;
+			continue;
+		}
+
+		// The task may still be returning after setting the flag
+		asyncLoad.task->wait();
+
+		it = asyncLoads.erase(it);
+	}
+}
+
 Ptr<UberShader> Graphics::loadUberShader(const std::filesystem::path& path)
 {
-	auto uberShader = AtslLoader::load(path);
+	Ptr<UberShader> uberShader;
+
+	// ATSL files may be in the shader bundle too
+	if (AtslLoader::isExtensionSupported(path.extension()))
+		uberShader = std::make_shared<UberShader>(createShaderAst(path.string(), readFile(path)));
+	else
+		uberShader = AtslLoader::load(path);
 
 	m_uberShaders[uberShader.get()] = uberShader;
 
@@ -716,7 +1119,10 @@ Ptr<UberShader> Graphics::loadUberShader(const std::filesystem::path& path)
 
 Ptr<UberShader> Graphics::loadUberInstance(const UberInstanceSettings& settings)
 {
-	auto uberShader = settings.uberShader->createInstance(settings.options, settings.shaderLibraryManager);
+	auto uberShader = takeAsync(m_asyncUberInstances, UberInstanceSettings::hash(settings), UberInstanceKey{ settings.uberShader, settings.shaderLibraryManager, settings.options });
+
+	if (!uberShader)
+		uberShader = settings.uberShader->createInstance(settings.options, settings.shaderLibraryManager);
 
 	m_uberShaders[uberShader.get()] = uberShader;
 
@@ -750,12 +1156,10 @@ Ptr<UberShader> Graphics::loadUberStage(const UberStageSettings& settings)
 
 Ptr<Shader> Graphics::loadShader(const UberShader& uberShader)
 {
-	Shader::Settings settings;
-	settings.shaderLanguage = ShaderLanguage::Ast;
-	settings.shaderData = uberShader.getAst().get();
-	settings.shaderDataSize = 1;
+	auto shader = takeAsync(m_asyncShaders, DefaultStdHasher::hash(&uberShader), &uberShader);
 
-	auto shader = Shader::create(settings);
+	if (!shader)
+		shader = createShader(uberShader);
 
 	auto& resourceHandle = initializeResourceHandle(shader.get());
 
@@ -811,7 +1215,7 @@ Ptr<GraphicsPipeline::Settings> Graphics::loadGraphicsPipelineSettings(const Gra
 	{
 		auto& binding = bindings[external.set][external.binding];
 
-		binding.type = getDefaultDescriptorType(external.type);
+		binding.type = getDefaultDescriptorType(external);
 		binding.count = getDescriptorBindingCount(external.type);
 		binding.binding = external.binding;
 		binding.shaderStages = ShaderStage::Vertex;
@@ -827,7 +1231,7 @@ Ptr<GraphicsPipeline::Settings> Graphics::loadGraphicsPipelineSettings(const Gra
 		{
 			auto& binding = set[external.binding];
 
-			binding.type = getDefaultDescriptorType(external.type);
+			binding.type = getDefaultDescriptorType(external);
 			binding.count = getDescriptorBindingCount(external.type);
 			binding.binding = external.binding;
 			binding.shaderStages = ShaderStage::Fragment;
@@ -837,7 +1241,7 @@ Ptr<GraphicsPipeline::Settings> Graphics::loadGraphicsPipelineSettings(const Gra
 		{
 			auto& binding = it->second;
 
-			if (binding.type != getDefaultDescriptorType(external.type))
+			if (binding.type != getDefaultDescriptorType(external))
 				ATEMA_ERROR("DescriptorSetBinding (set " + std::to_string(external.set) + ", binding " + std::to_string(external.binding) + ") type must be the same in vertex & fragment shaders");
 
 			if (binding.count != getDescriptorBindingCount(external.type))
@@ -880,7 +1284,12 @@ Ptr<GraphicsPipeline::Settings> Graphics::loadGraphicsPipelineSettings(const Gra
 
 Ptr<GraphicsPipeline> Graphics::loadGraphicsPipeline(const GraphicsPipeline::Settings& settings)
 {
-	return GraphicsPipeline::create(settings);
+	auto graphicsPipeline = takeAsync(m_asyncGraphicsPipelines, DefaultStdHasher::hash(settings), settings);
+
+	if (!graphicsPipeline)
+		graphicsPipeline = GraphicsPipeline::create(settings);
+
+	return graphicsPipeline;
 }
 
 Ptr<Image> Graphics::loadImage(const ImageSettings& settings)
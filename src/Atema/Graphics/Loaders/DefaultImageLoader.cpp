@@ -20,6 +20,10 @@
 */
 
 #include <Atema/Graphics/Loaders/DefaultImageLoader.hpp>
+#include <Atema/Core/TaskManager.hpp>
+#include <Atema/Graphics/Loaders/TextureCache.hpp>
+#include <Atema/Graphics/Loaders/TextureCompressor.hpp>
+#include <Atema/Renderer/Renderer.hpp>
 #include <Atema/Renderer/Utils.hpp>
 
 #include <unordered_set>
@@ -74,6 +78,90 @@ namespace
 
 		return ImageLoader::Format::R;
 	}
+
+	// Mip chains built on the CPU are uploaded to single sampled 2D images with an optimal tiling
+	bool isMipChainSupported(const ImageLoader::Settings& settings)
+	{
+		return settings.type == ImageType::Image2D && settings.tiling == ImageTiling::Optimal && settings.samples == ImageSamples::S1;
+	}
+
+	bool isFormatSupported(ImageFormat format, const ImageLoader::Settings& settings)
+	{
+		const auto usages = settings.usages | ImageUsage::TransferDst;
+
+		return (Renderer::instance().getImageFormatOptimalUsages(format) & usages) == usages;
+	}
+
+	// Compression is only applied to 2D images, if the device can sample the resulting format
+	bool isCompressionSupported(ImageLoader::Format format, const ImageLoader::Settings& settings)
+	{
+		if (settings.compression == ImageLoader::Compression::None || settings.type != ImageType::Image2D)
+			return false;
+
+		return isFormatSupported(TextureCompressor::getFormat(settings.compression, format), settings);
+	}
+
+	// 8 bit image whose mip chain is built on the CPU
+	struct MipChainSource
+	{
+		ImageLoader::Format format = ImageLoader::Format::RGBA;
+		ImageLoader::Compression compression = ImageLoader::Compression::None;
+		// Empty if there is no cache directory
+		std::filesystem::path cachePath;
+		Hash64 cacheKey = 0;
+	};
+
+	// Returns false if the format is not supported or for HDR images
+	bool getMipChainSource(const std::filesystem::path& path, const ImageLoader::Settings& settings, MipChainSource& source)
+	{
+		if (!DefaultImageLoader::isExtensionSupported(path.extension()))
+			return false;
+
+		const auto filenameStr = path.string();
+		const auto filename = filenameStr.c_str();
+
+		int width, height, channels;
+
+		if (stbi_info(filename, &width, &height, &channels) != 1)
+			ATEMA_ERROR("Failed to load the image");
+
+		if (stbi_is_hdr(filename))
+			return false;
+
+		source.format = getLoaderFormat(channels);
+		source.compression = isCompressionSupported(source.format, settings) ? settings.compression : ImageLoader::Compression::None;
+
+		if (!settings.cacheDirectory.empty())
+		{
+			source.cachePath = TextureCache::getPath(settings.cacheDirectory, path);
+			source.cacheKey = TextureCache::getKey(path, source.compression, settings);
+		}
+
+		return true;
+	}
+
+	// Decodes the image & builds its mip chain, saving it to the cache if possible
+	ImageLoader::MipChain buildMipChain(const std::filesystem::path& path, const ImageLoader::Settings& settings, const MipChainSource& source)
+	{
+		const auto filenameStr = path.string();
+
+		int width, height, channels;
+
+		// Keep the source channels, the compressor handles each of them
+		stbi_uc* pixels = stbi_load(filenameStr.c_str(), &width, &height, &channels, 0);
+
+		if (!pixels)
+			ATEMA_ERROR("Failed to load the image");
+
+		auto mipChain = TextureCompressor::compress(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), source.format, source.compression, settings.mipLevels, settings.mipFilter, settings.srgb);
+
+		stbi_image_free(pixels);
+
+		if (!source.cachePath.empty())
+			TextureCache::save(source.cachePath, source.cacheKey, mipChain);
+
+		return mipChain;
+	}
 }
 
 Ptr<Image> DefaultImageLoader::load(const std::filesystem::path& path, const ImageLoader::Settings& settings)
@@ -92,8 +180,19 @@ Ptr<Image> DefaultImageLoader::load(const std::filesystem::path& path, const Ima
 
 	const auto loaderFormat = getLoaderFormat(channels);
 
+	const bool isHDR = stbi_is_hdr(filename);
+
+	// Compressed images are built on the CPU
+	if (!isHDR && isCompressionSupported(loaderFormat, settings))
+	{
+		ImageLoader::MipChain mipChain;
+
+		if (loadMipChain(path, settings, mipChain))
+			return ImageLoader::loadImage(mipChain, settings);
+	}
+
 	Ptr<Image> image;
-	if (stbi_is_hdr(filename))
+	if (isHDR)
 	{
 		const ImageFormat format = ImageLoader::getSupportedHDRFormat(loaderFormat, settings.usages);
 
@@ -126,6 +225,20 @@ Ptr<Image> DefaultImageLoader::load(const uint8_t* data, size_t size, const Imag
 
 	const auto loaderFormat = getLoaderFormat(channels);
 
+	if (isCompressionSupported(loaderFormat, settings))
+	{
+		stbi_uc* pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, channels);
+
+		if (!pixels)
+			ATEMA_ERROR("Failed to load the image");
+
+		const auto mipChain = TextureCompressor::compress(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), loaderFormat, settings.compression, settings.mipLevels, settings.mipFilter, settings.srgb);
+
+		stbi_image_free(pixels);
+
+		return ImageLoader::loadImage(mipChain, settings);
+	}
+
 	const ImageFormat format = ImageLoader::getSupportedColorFormat(loaderFormat, settings.usages);
 
 	stbi_uc* pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, getSTBIFormat(format));
@@ -137,6 +250,96 @@ Ptr<Image> DefaultImageLoader::load(const uint8_t* data, size_t size, const Imag
 	return image;
 }
 
+std::vector<Ptr<Image>> DefaultImageLoader::load(const std::vector<std::filesystem::path>& paths, const ImageLoader::Settings& settings)
+{
+	std::vector<ImageLoader::MipChain> mipChains(paths.size());
+	// Not a std::vector<bool> : every worker writes its own element
+	std::vector<uint8_t> mipChainsLoaded(paths.size(), 0);
+
+	if (isMipChainSupported(settings))
+	{
+		TaskManager::instance().parallelFor(paths.size(), [&](size_t index)
+			{
+				auto& mipChain = mipChains[index];
+
+				if (loadMipChain(paths[index], settings, mipChain) && isFormatSupported(mipChain.format, settings))
+					mipChainsLoaded[index] = 1;
+				else
+					mipChain = {};
+			});
+	}
+
+	std::vector<Ptr<Image>> images;
+	images.reserve(paths.size());
+
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		if (mipChainsLoaded[i])
+			images.emplace_back(ImageLoader::loadImage(mipChains[i], settings));
+		else
+			images.emplace_back(load(paths[i], settings));
+
+		// The pixels are not needed anymore once uploaded
+		mipChains[i] = {};
+	}
+
+	return images;
+}
+
+bool DefaultImageLoader::loadMipChain(const std::filesystem::path& path, const ImageLoader::Settings& settings, ImageLoader::MipChain& mipChain, uint32_t firstMipLevel)
+{
+	MipChainSource source;
+
+	if (!getMipChainSource(path, settings, source))
+		return false;
+
+	if (!source.cachePath.empty() && TextureCache::load(source.cachePath, source.cacheKey, mipChain, firstMipLevel))
+		return true;
+
+	auto newMipChain = buildMipChain(path, settings, source);
+
+	if (firstMipLevel >= newMipChain.mipOffsets.size())
+		return false;
+
+	// Remove the finest levels
+	if (firstMipLevel > 0)
+	{
+		const auto firstOffset = newMipChain.mipOffsets[firstMipLevel];
+
+		newMipChain.width = std::max(newMipChain.width >> firstMipLevel, 1u);
+		newMipChain.height = std::max(newMipChain.height >> firstMipLevel, 1u);
+		newMipChain.data.erase(newMipChain.data.begin(), newMipChain.data.begin() + static_cast<ptrdiff_t>(firstOffset));
+		newMipChain.mipOffsets.erase(newMipChain.mipOffsets.begin(), newMipChain.mipOffsets.begin() + firstMipLevel);
+
+		for (auto& mipOffset : newMipChain.mipOffsets)
+			mipOffset -= firstOffset;
+	}
+
+	mipChain = std::move(newMipChain);
+
+	return true;
+}
+
+bool DefaultImageLoader::loadMipChainInfo(const std::filesystem::path& path, const ImageLoader::Settings& settings, TextureCache::Info& info)
+{
+	MipChainSource source;
+
+	if (!getMipChainSource(path, settings, source))
+		return false;
+
+	if (!source.cachePath.empty() && TextureCache::loadInfo(source.cachePath, source.cacheKey, info))
+		return true;
+
+	const auto mipChain = buildMipChain(path, settings, source);
+
+	info.format = mipChain.format;
+	info.width = mipChain.width;
+	info.height = mipChain.height;
+	info.mipLevels = static_cast<uint32_t>(mipChain.mipOffsets.size());
+
+	return true;
+}
+
 bool DefaultImageLoader::isExtensionSupported(const std::filesystem::path& extension)
 {
 	return extensions.count(extension.string()) > 0;
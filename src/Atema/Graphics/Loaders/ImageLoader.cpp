@@ -19,7 +19,6 @@
 	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-#include <Atema/Graphics/Loaders/ImageLoader.hpp>
 #include <Atema/Graphics/Loaders/ImageLoader.hpp>
 #include <Atema/Renderer/Renderer.hpp>
 #include <Atema/Renderer/Utils.hpp>
@@ -68,6 +67,40 @@ namespace
 		return formats;
 	}
 
+	// Returns the command buffer recording the upload
+	Ptr<CommandBuffer> beginUpload(const ImageLoader::Settings& settings, const Ptr<Buffer>& stagingBuffer)
+	{
+		// Command buffer not provided by the user : we create one
+		if (!settings.commandBuffer)
+		{
+			CommandPool& commandPool = *Renderer::instance().getCommandPool(QueueType::Graphics);
+
+			auto commandBuffer = commandPool.createBuffer({ true });
+
+			commandBuffer->begin();
+
+			return commandBuffer;
+		}
+
+		// The command buffer is provided, so the user will be responsible to delete staging buffers once the command is executed
+		ATEMA_ASSERT(settings.stagingBuffers, "Invalid staging buffer list");
+
+		settings.stagingBuffers->emplace_back(stagingBuffer);
+
+		return settings.commandBuffer;
+	}
+
+	void endUpload(const ImageLoader::Settings& settings, const Ptr<CommandBuffer>& commandBuffer)
+	{
+		// We created our own command buffer, execute it right now, so we can delete staging buffers
+		if (!settings.commandBuffer)
+		{
+			commandBuffer->end();
+
+			Renderer::instance().submitAndWait({ commandBuffer });
+		}
+	}
+
 	template <typename T>
 	constexpr bool supportsHDR()
 	{
@@ -116,24 +149,7 @@ namespace
 
 		Ptr<Buffer> stagingBuffer = Buffer::create({ BufferUsage::TransferSrc | BufferUsage::Map, imageByteSize });
 
-		Ptr<CommandBuffer> commandBuffer = settings.commandBuffer;
-
-		// Command buffer not provided by the user : we create one
-		if (!settings.commandBuffer)
-		{
-			CommandPool& commandPool = *Renderer::instance().getCommandPool(QueueType::Graphics);
-
-			commandBuffer = commandPool.createBuffer({ true });
-
-			commandBuffer->begin();
-		}
-		// The command buffer is provided, so the user will be responsible to delete staging buffers once the command is executed
-		else
-		{
-			ATEMA_ASSERT(settings.stagingBuffers, "Invalid staging buffer list");
-
-			settings.stagingBuffers->emplace_back(stagingBuffer);
-		}
+		Ptr<CommandBuffer> commandBuffer = beginUpload(settings, stagingBuffer);
 
 		// Fill staging buffer
 		void* bufferData = stagingBuffer->map();
@@ -176,13 +192,7 @@ namespace
 			commandBuffer->createMipmaps(*image, PipelineStage::FragmentShader, MemoryAccess::ShaderRead, ImageLayout::ShaderRead);
 		}
 
-		// We created our own command buffer, execute it right now, so we can delete staging buffers
-		if (!settings.commandBuffer)
-		{
-			commandBuffer->end();
-
-			Renderer::instance().submitAndWait({ commandBuffer });
-		}
+		endUpload(settings, commandBuffer);
 
 		return image;
 	}
@@ -198,6 +208,44 @@ Ptr<Image> ImageLoader::loadImage(const float* data, uint32_t width, uint32_t he
 	return ::loadImage(data, width, height, format, settings);
 }
 
+Ptr<Image> ImageLoader::loadImage(const MipChain& mipChain, const Settings& settings)
+{
+	ATEMA_ASSERT(settings.type == ImageType::Image2D, "Mip chains only support 2D images");
+	ATEMA_ASSERT(mipChain.width > 0 && mipChain.height > 0 && !mipChain.mipOffsets.empty(), "Invalid mip chain");
+
+	// A single staging buffer & a single copy for each level
+	Ptr<Buffer> stagingBuffer = Buffer::create({ BufferUsage::TransferSrc | BufferUsage::Map, mipChain.data.size() });
+
+	Ptr<CommandBuffer> commandBuffer = beginUpload(settings, stagingBuffer);
+
+	void* bufferData = stagingBuffer->map();
+
+	memcpy(bufferData, mipChain.data.data(), mipChain.data.size());
+
+	stagingBuffer->unmap();
+
+	Image::Settings imageSettings;
+	imageSettings.format = mipChain.format;
+	imageSettings.type = ImageType::Image2D;
+	imageSettings.width = mipChain.width;
+	imageSettings.height = mipChain.height;
+	imageSettings.mipLevels = static_cast<uint32_t>(mipChain.mipOffsets.size());
+	imageSettings.usages = settings.usages | ImageUsage::TransferDst;
+
+	Ptr<Image> image = Image::create(imageSettings);
+
+	commandBuffer->imageBarrier(*image, ImageBarrier::InitializeTransferDst);
+
+	for (uint32_t mipLevel = 0; mipLevel < imageSettings.mipLevels; mipLevel++)
+		commandBuffer->copyBufferToImage(*stagingBuffer, *image, ImageLayout::TransferDst, mipChain.mipOffsets[mipLevel], mipLevel);
+
+	commandBuffer->imageBarrier(*image, ImageBarrier::TransferDstToFragmentShaderRead);
+
+	endUpload(settings, commandBuffer);
+
+	return image;
+}
+
 ImageFormat ImageLoader::getSupportedColorFormat(Format format, Flags<ImageUsage> usages)
 {
 	static ImageFormatArray s_formats = initializeFormats(colorComponentTypes);
@@ -0,0 +1,929 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Core/Error.hpp>
+#include <Atema/Graphics/Loaders/MeshOptimizer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using namespace at;
+
+namespace
+{
+	constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+	// Forsyth's algorithm parameters (LRU cache)
+	constexpr size_t ForsythCacheSize = 32;
+	constexpr float CacheDecayPower = 1.5f;
+	constexpr float LastTriangleScore = 0.75f;
+	constexpr float ValenceBoostScale = 2.0f;
+	constexpr float ValenceBoostPower = 0.5f;
+
+	// Precomputed scores for common valences
+	constexpr size_t ValenceTableSize = 32;
+
+	class VertexScorer
+	{
+	public:
+		VertexScorer()
+		{
+			for (size_t i = 0; i < ForsythCacheSize; i++)
+			{
+				// The 3 vertices of the last triangle have a fixed score, so we don't favor any winding
+				if (i < 3)
+					m_cacheScores[i] = LastTriangleScore;
+				else
+					m_cacheScores[i] = std::pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(ForsythCacheSize - 3), CacheDecayPower);
+			}
+
+			m_valenceScores[0] = 0.0f;
+			for (size_t i = 1; i < ValenceTableSize; i++)
+				m_valenceScores[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+		}
+
+		float getScore(uint32_t cachePosition, uint32_t remainingValence) const
+		{
+			// Vertices without any triangle left must not be favored
+			if (remainingValence == 0)
+				return -1.0f;
+
+			float score = cachePosition < ForsythCacheSize ? m_cacheScores[cachePosition] : 0.0f;
+
+			if (remainingValence < ValenceTableSize)
+				score += m_valenceScores[remainingValence];
+			else
+				score += ValenceBoostScale * std::pow(static_cast<float>(remainingValence), -ValenceBoostPower);
+
+			return score;
+		}
+
+	private:
+		std::array<float, ForsythCacheSize> m_cacheScores;
+		std::array<float, ValenceTableSize> m_valenceScores;
+	};
+
+	// Returns the triangles starting a new cluster for the overdraw optimization
+	// A cluster starts whenever a triangle misses its 3 vertices in a FIFO cache
+	std::vector<size_t> getClusterStarts(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize)
+	{
+		std::vector<size_t> clusterStarts;
+
+		std::vector<size_t> cacheTimestamps(vertexCount, 0);
+		size_t timestamp = cacheSize + 1;
+
+		const auto triangleCount = indices.size() / 3;
+
+		for (size_t triangleIndex = 0; triangleIndex < triangleCount; triangleIndex++)
+		{
+			size_t missCount = 0;
+
+			for (size_t corner = 0; corner < 3; corner++)
+			{
+				const auto index = indices[triangleIndex * 3 + corner];
+
+				if (timestamp - cacheTimestamps[index] > cacheSize)
+				{
+					cacheTimestamps[index] = timestamp++;
+					missCount++;
+				}
+			}
+
+			if (triangleIndex == 0 || missCount == 3)
+				clusterStarts.emplace_back(triangleIndex);
+		}
+
+		return clusterStarts;
+	}
+
+	// Triangles using each vertex, as compressed lists : triangles of vertex i are adjacency[offsets[i]] to adjacency[offsets[i + 1] - 1]
+	void buildTriangleAdjacency(const std::vector<uint32_t>& indices, size_t vertexCount, std::vector<uint32_t>& offsets, std::vector<uint32_t>& adjacency)
+	{
+		offsets.assign(vertexCount + 1, 0);
+		for (const auto& index : indices)
+			offsets[index + 1]++;
+
+		for (size_t i = 1; i < offsets.size(); i++)
+			offsets[i] += offsets[i - 1];
+
+		adjacency.resize(indices.size());
+
+		auto insertOffsets = offsets;
+
+		for (size_t i = 0; i < indices.size(); i++)
+			adjacency[insertOffsets[indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	// Sum of squared distances to planes, weighted by the triangle areas
+	// The plane equations (a, b, c, d) are accumulated in a symmetric 4x4 matrix
+	struct Quadric
+	{
+		float a2 = 0.0f, b2 = 0.0f, c2 = 0.0f, d2 = 0.0f;
+		float ab = 0.0f, ac = 0.0f, ad = 0.0f;
+		float bc = 0.0f, bd = 0.0f;
+		float cd = 0.0f;
+		float weight = 0.0f;
+
+		void addPlane(const Vector3f& normal, float distance, float planeWeight)
+		{
+			a2 += normal.x * normal.x * planeWeight;
+			b2 += normal.y * normal.y * planeWeight;
+			c2 += normal.z * normal.z * planeWeight;
+			d2 += distance * distance * planeWeight;
+			ab += normal.x * normal.y * planeWeight;
+			ac += normal.x * normal.z * planeWeight;
+			ad += normal.x * distance * planeWeight;
+			bc += normal.y * normal.z * planeWeight;
+			bd += normal.y * distance * planeWeight;
+			cd += normal.z * distance * planeWeight;
+			weight += planeWeight;
+		}
+
+		// Weighted mean of the squared distances between the point & the planes
+		float getError(const Vector3f& point) const
+		{
+			if (weight <= 0.0f)
+				return 0.0f;
+
+			const auto& x = point.x;
+			const auto& y = point.y;
+			const auto& z = point.z;
+
+			const float error =
+				a2 * x * x + b2 * y * y + c2 * z * z + d2
+				+ 2.0f * (ab * x * y + ac * x * z + ad * x + bc * y * z + bd * y + cd * z);
+
+			return std::max(error, 0.0f) / weight;
+		}
+
+		Quadric& operator+=(const Quadric& other)
+		{
+			a2 += other.a2; b2 += other.b2; c2 += other.c2; d2 += other.d2;
+			ab += other.ab; ac += other.ac; ad += other.ad;
+			bc += other.bc; bd += other.bd;
+			cd += other.cd;
+			weight += other.weight;
+
+			return *this;
+		}
+	};
+
+	struct Collapse
+	{
+		uint32_t from;
+		uint32_t to;
+		float error;
+	};
+
+	// Triangles thinner than this (twice their area over their squared longest edge) are considered degenerate
+	// This is scale independent, and far above the rounding errors of collinear positions
+	constexpr float MinTriangleShape = 1e-4f;
+
+	bool isTriangleDegenerate(const Vector3f& p1, const Vector3f& p2, const Vector3f& p3)
+	{
+		const auto doubleArea = cross(p2 - p1, p3 - p1).getNorm();
+		const auto maxSquaredEdge = std::max({ (p2 - p1).getSquaredNorm(), (p3 - p2).getSquaredNorm(), (p1 - p3).getSquaredNorm() });
+
+		return doubleArea <= MinTriangleShape * maxSquaredEdge;
+	}
+
+	// Returns true if moving 'from' onto 'to' flips or degenerates a triangle using 'from' (triangles using both vertices are removed instead)
+	bool isCollapseInvalid(const std::vector<Vector3f>& positions, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& adjacencyOffsets, const std::vector<uint32_t>& adjacency, uint32_t from, uint32_t to)
+	{
+		for (auto i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1]; i++)
+		{
+			const auto* triangle = &indices[adjacency[i] * 3];
+
+			if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+				continue;
+
+			Vector3f oldPositions[3];
+			Vector3f newPositions[3];
+
+			for (size_t corner = 0; corner < 3; corner++)
+			{
+				oldPositions[corner] = positions[triangle[corner]];
+				newPositions[corner] = triangle[corner] == from ? positions[to] : oldPositions[corner];
+			}
+
+			if (isTriangleDegenerate(newPositions[0], newPositions[1], newPositions[2]))
+				return true;
+
+			const auto oldNormal = cross(oldPositions[1] - oldPositions[0], oldPositions[2] - oldPositions[0]);
+			const auto newNormal = cross(newPositions[1] - newPositions[0], newPositions[2] - newPositions[0]);
+
+			if (oldNormal.dot(newNormal) <= 0.25f * oldNormal.getNorm() * newNormal.getNorm())
+				return true;
+		}
+
+		return false;
+	}
+
+	// Normal cones wider than this (minimum dot product with the axis) can't cull anything
+	constexpr float MinConeDot = 0.1f;
+
+	void computeMeshletBounds(Meshlet& meshlet, const std::vector<ModelLoader::StaticVertex>& vertices, const uint32_t* indices)
+	{
+		// Bounding sphere centered on the AABB
+		AABBf aabb;
+		for (uint32_t i = 0; i < meshlet.indexCount; i++)
+			aabb.extend(vertices[indices[i]].position);
+
+		const auto center = (aabb.min + aabb.max) / 2.0f;
+		float radius = 0.0f;
+
+		for (uint32_t i = 0; i < meshlet.indexCount; i++)
+			radius = std::max(radius, (vertices[indices[i]].position - center).getNorm());
+
+		meshlet.boundingSphere.set(center, radius);
+
+		// Normal cone, from the front face normals (same winding as the overdraw optimization)
+		const auto getNormal = [&vertices, indices](uint32_t firstIndex)
+		{
+			const auto& p1 = vertices[indices[firstIndex + 0]].position;
+			const auto& p2 = vertices[indices[firstIndex + 1]].position;
+			const auto& p3 = vertices[indices[firstIndex + 2]].position;
+
+			return cross(p2 - p1, p3 - p1);
+		};
+
+		Vector3f axis;
+		for (uint32_t i = 0; i < meshlet.indexCount; i += 3)
+		{
+			const auto normal = getNormal(i);
+
+			// Degenerate triangles don't have any orientation
+			if (normal.getSquaredNorm() > 0.0f)
+				axis += normal.getNormalized();
+		}
+
+		meshlet.coneAxis = {};
+		meshlet.coneCutoff = 1.0f;
+
+		if (axis.getSquaredNorm() <= 0.0f)
+			return;
+
+		axis.normalize();
+
+		float minDot = 1.0f;
+		for (uint32_t i = 0; i < meshlet.indexCount; i += 3)
+		{
+			const auto normal = getNormal(i);
+
+			if (normal.getSquaredNorm() > 0.0f)
+				minDot = std::min(minDot, normal.getNormalized().dot(axis));
+		}
+
+		if (minDot <= MinConeDot)
+			return;
+
+		meshlet.coneAxis = axis;
+		meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+	const auto triangleCount = indices.size() / 3;
+
+	if (triangleCount == 0)
+		return;
+
+	static const VertexScorer vertexScorer;
+
+	// Triangles adjacent to each vertex
+	// Emitted triangles are moved after the remaining ones, so the first 'valences[vertex]' triangles are the remaining ones
+	std::vector<uint32_t> valences(vertexCount, 0);
+	for (const auto& index : indices)
+		valences[index]++;
+
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (size_t i = 0; i < vertexCount; i++)
+		adjacencyOffsets[i + 1] = adjacencyOffsets[i] + valences[i];
+
+	std::vector<uint32_t> adjacency(indices.size());
+	{
+		std::vector<uint32_t> adjacencyCursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+		for (size_t i = 0; i < indices.size(); i++)
+			adjacency[adjacencyCursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	// Initial scores (empty cache)
+	std::vector<float> vertexScores(vertexCount);
+
+	for (size_t i = 0; i < vertexCount; i++)
+		vertexScores[i] = vertexScorer.getScore(InvalidIndex, valences[i]);
+
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<bool> emittedTriangles(triangleCount, false);
+
+	for (size_t triangleIndex = 0; triangleIndex < triangleCount; triangleIndex++)
+	{
+		const auto* triangle = &indices[triangleIndex * 3];
+
+		triangleScores[triangleIndex] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+	}
+
+	// LRU cache, with room for the vertices pushed out by the last triangle
+	std::array<uint32_t, ForsythCacheSize + 3> cache;
+	std::array<uint32_t, ForsythCacheSize + 3> newCache;
+	size_t cacheSize = 0;
+
+	std::vector<uint32_t> newIndices;
+	newIndices.reserve(indices.size());
+
+	size_t bestTriangle = static_cast<size_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+	size_t nextTriangle = 0;
+
+	for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+	{
+		// No candidate in the cache : take the next remaining triangle in the input order
+		if (bestTriangle == InvalidIndex)
+		{
+			while (emittedTriangles[nextTriangle])
+				nextTriangle++;
+
+			bestTriangle = nextTriangle;
+		}
+
+		const auto* triangle = &indices[bestTriangle * 3];
+
+		emittedTriangles[bestTriangle] = true;
+
+		size_t newCacheSize = 0;
+
+		for (size_t corner = 0; corner < 3; corner++)
+		{
+			const auto vertex = triangle[corner];
+
+			newIndices.emplace_back(vertex);
+
+			// Remove the triangle from the remaining adjacent triangles
+			auto* vertexTriangles = &adjacency[adjacencyOffsets[vertex]];
+			auto& valence = valences[vertex];
+
+			for (size_t i = 0; i < valence; i++)
+			{
+				if (vertexTriangles[i] == bestTriangle)
+				{
+					std::swap(vertexTriangles[i], vertexTriangles[valence - 1]);
+					break;
+				}
+			}
+
+			valence--;
+
+			newCache[newCacheSize++] = vertex;
+		}
+
+		// Previous cache entries move after the triangle vertices
+		for (size_t i = 0; i < cacheSize; i++)
+		{
+			const auto vertex = cache[i];
+
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+				newCache[newCacheSize++] = vertex;
+		}
+
+		// Update the scores of every vertex whose cache position or valence changed
+		bestTriangle = InvalidIndex;
+		float bestScore = -std::numeric_limits<float>::max();
+
+		for (size_t i = 0; i < newCacheSize; i++)
+		{
+			const auto vertex = newCache[i];
+			const auto cachePosition = i < ForsythCacheSize ? static_cast<uint32_t>(i) : InvalidIndex;
+
+			const auto score = vertexScorer.getScore(cachePosition, valences[vertex]);
+			const auto scoreDelta = score - vertexScores[vertex];
+
+			vertexScores[vertex] = score;
+
+			const auto* vertexTriangles = &adjacency[adjacencyOffsets[vertex]];
+
+			for (size_t j = 0; j < valences[vertex]; j++)
+			{
+				const auto triangleIndex = vertexTriangles[j];
+
+				triangleScores[triangleIndex] += scoreDelta;
+
+				// Only triangles using cached vertices are candidates
+				if (cachePosition != InvalidIndex && triangleScores[triangleIndex] > bestScore)
+				{
+					bestScore = triangleScores[triangleIndex];
+					bestTriangle = triangleIndex;
+				}
+			}
+		}
+
+		cacheSize = std::min(newCacheSize, ForsythCacheSize);
+		std::copy(newCache.begin(), newCache.begin() + cacheSize, cache.begin());
+	}
+
+	std::swap(indices, newIndices);
+}
+
+void MeshOptimizer::optimizeOverdraw(const std::vector<ModelLoader::StaticVertex>& vertices, std::vector<uint32_t>& indices)
+{
+	const auto triangleCount = indices.size() / 3;
+
+	if (triangleCount == 0)
+		return;
+
+	const auto clusterStarts = getClusterStarts(indices, vertices.size(), DefaultCacheSize);
+	const auto clusterCount = clusterStarts.size();
+
+	if (clusterCount < 2)
+		return;
+
+	// Area weighted centroid & normal of each cluster
+	std::vector<Vector3f> clusterCentroids(clusterCount);
+	std::vector<Vector3f> clusterNormals(clusterCount);
+
+	Vector3f meshCentroid;
+	float meshArea = 0.0f;
+
+	for (size_t clusterIndex = 0; clusterIndex < clusterCount; clusterIndex++)
+	{
+		const auto firstTriangle = clusterStarts[clusterIndex];
+		const auto lastTriangle = clusterIndex + 1 < clusterCount ? clusterStarts[clusterIndex + 1] : triangleCount;
+
+		Vector3f centroid;
+		Vector3f normal;
+		float clusterArea = 0.0f;
+
+		for (size_t triangleIndex = firstTriangle; triangleIndex < lastTriangle; triangleIndex++)
+		{
+			const auto& p1 = vertices[indices[triangleIndex * 3 + 0]].position;
+			const auto& p2 = vertices[indices[triangleIndex * 3 + 1]].position;
+			const auto& p3 = vertices[indices[triangleIndex * 3 + 2]].position;
+
+			const auto triangleNormal = cross(p2 - p1, p3 - p1);
+			const auto area = triangleNormal.getNorm();
+
+			centroid += (p1 + p2 + p3) * (area / 3.0f);
+			normal += triangleNormal;
+			clusterArea += area;
+		}
+
+		meshCentroid += centroid;
+		meshArea += clusterArea;
+
+		clusterCentroids[clusterIndex] = clusterArea > 0.0f ? centroid / clusterArea : centroid;
+		clusterNormals[clusterIndex] = normal.getSquaredNorm() > 0.0f ? normal.getNormalized() : normal;
+	}
+
+	if (meshArea > 0.0f)
+		meshCentroid /= meshArea;
+
+	// Clusters facing away from the mesh center are more likely to occlude the others : draw them first
+	std::vector<float> sortKeys(clusterCount);
+	for (size_t clusterIndex = 0; clusterIndex < clusterCount; clusterIndex++)
+		sortKeys[clusterIndex] = (clusterCentroids[clusterIndex] - meshCentroid).dot(clusterNormals[clusterIndex]);
+
+	std::vector<size_t> clusterOrder(clusterCount);
+	std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](size_t a, size_t b)
+		{
+			return sortKeys[a] > sortKeys[b];
+		});
+
+	std::vector<uint32_t> newIndices;
+	newIndices.reserve(indices.size());
+
+	for (const auto& clusterIndex : clusterOrder)
+	{
+		const auto firstTriangle = clusterStarts[clusterIndex];
+		const auto lastTriangle = clusterIndex + 1 < clusterCount ? clusterStarts[clusterIndex + 1] : triangleCount;
+
+		newIndices.insert(newIndices.end(), indices.begin() + firstTriangle * 3, indices.begin() + lastTriangle * 3);
+	}
+
+	std::swap(indices, newIndices);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<ModelLoader::StaticVertex>& vertices, std::vector<uint32_t>& indices)
+{
+	std::vector<uint32_t> remap(vertices.size(), InvalidIndex);
+
+	std::vector<ModelLoader::StaticVertex> newVertices;
+	newVertices.reserve(vertices.size());
+
+	for (auto& index : indices)
+	{
+		auto& newIndex = remap[index];
+
+		if (newIndex == InvalidIndex)
+		{
+			newIndex = static_cast<uint32_t>(newVertices.size());
+
+			newVertices.emplace_back(vertices[index]);
+		}
+
+		index = newIndex;
+	}
+
+	std::swap(vertices, newVertices);
+}
+
+void MeshOptimizer::optimize(std::vector<ModelLoader::StaticVertex>& vertices, std::vector<uint32_t>& indices)
+{
+	optimizeVertexCache(indices, vertices.size());
+
+	optimizeOverdraw(vertices, indices);
+
+	optimizeVertexFetch(vertices, indices);
+}
+
+std::vector<Meshlet> MeshOptimizer::buildMeshlets(const std::vector<ModelLoader::StaticVertex>& vertices, std::vector<uint32_t>& indices, size_t maxVertexCount, size_t maxTriangleCount)
+{
+	ATEMA_ASSERT(maxVertexCount >= 3 && maxTriangleCount > 0, "Meshlets must be able to hold a triangle");
+
+	std::vector<Meshlet> meshlets;
+
+	const auto triangleCount = indices.size() / 3;
+
+	if (triangleCount == 0)
+		return meshlets;
+
+	std::vector<uint32_t> adjacencyOffsets;
+	std::vector<uint32_t> adjacency;
+	buildTriangleAdjacency(indices, vertices.size(), adjacencyOffsets, adjacency);
+
+	std::vector<bool> emittedTriangles(triangleCount, false);
+	size_t emittedCount = 0;
+	size_t nextSeed = 0;
+
+	// Last meshlet using each vertex
+	std::vector<uint32_t> vertexMeshlets(vertices.size(), InvalidIndex);
+
+	// Triangles adjacent to the current meshlet (may contain duplicates & emitted triangles)
+	std::vector<uint32_t> candidates;
+
+	std::vector<uint32_t> newIndices;
+	newIndices.reserve(indices.size());
+
+	while (emittedCount < triangleCount)
+	{
+		const auto meshletIndex = static_cast<uint32_t>(meshlets.size());
+
+		auto& meshlet = meshlets.emplace_back();
+		meshlet.firstIndex = static_cast<uint32_t>(newIndices.size());
+
+		size_t meshletVertexCount = 0;
+		size_t meshletTriangleCount = 0;
+
+		candidates.clear();
+
+		const auto getNewVertexCount = [&](uint32_t triangle)
+		{
+			size_t newVertexCount = 0;
+
+			for (size_t corner = 0; corner < 3; corner++)
+			{
+				if (vertexMeshlets[indices[triangle * 3 + corner]] != meshletIndex)
+					newVertexCount++;
+			}
+
+			return newVertexCount;
+		};
+
+		while (meshletTriangleCount < maxTriangleCount)
+		{
+			// Take the adjacent triangle adding the fewest vertices
+			auto bestTriangle = InvalidIndex;
+			size_t bestNewVertexCount = 4;
+
+			size_t candidateIndex = 0;
+			while (candidateIndex < candidates.size())
+			{
+				const auto triangle = candidates[candidateIndex];
+
+				if (emittedTriangles[triangle])
+				{
+					candidates[candidateIndex] = candidates.back();
+					candidates.pop_back();
+					continue;
+				}
+
+				candidateIndex++;
+
+				const auto newVertexCount = getNewVertexCount(triangle);
+
+				if (newVertexCount < bestNewVertexCount)
+				{
+					bestTriangle = triangle;
+					bestNewVertexCount = newVertexCount;
+
+					if (newVertexCount == 0)
+						break;
+				}
+			}
+
+			// No connected triangle left : continue with the next one in the index order, which is usually close
+			if (bestTriangle == InvalidIndex)
+			{
+				while (nextSeed < triangleCount && emittedTriangles[nextSeed])
+					nextSeed++;
+
+				if (nextSeed == triangleCount)
+					break;
+
+				bestTriangle = static_cast<uint32_t>(nextSeed);
+				bestNewVertexCount = getNewVertexCount(bestTriangle);
+			}
+
+			if (meshletVertexCount + bestNewVertexCount > maxVertexCount)
+				break;
+
+			emittedTriangles[bestTriangle] = true;
+			emittedCount++;
+			meshletTriangleCount++;
+
+			for (size_t corner = 0; corner < 3; corner++)
+			{
+				const auto index = indices[bestTriangle * 3 + corner];
+
+				newIndices.emplace_back(index);
+
+				if (vertexMeshlets[index] == meshletIndex)
+					continue;
+
+				vertexMeshlets[index] = meshletIndex;
+				meshletVertexCount++;
+
+				for (auto i = adjacencyOffsets[index]; i < adjacencyOffsets[index + 1]; i++)
+				{
+					if (!emittedTriangles[adjacency[i]])
+						candidates.emplace_back(adjacency[i]);
+				}
+			}
+		}
+
+		meshlet.indexCount = static_cast<uint32_t>(newIndices.size()) - meshlet.firstIndex;
+	}
+
+	std::swap(indices, newIndices);
+
+	for (auto& meshlet : meshlets)
+		computeMeshletBounds(meshlet, vertices, indices.data() + meshlet.firstIndex);
+
+	return meshlets;
+}
+
+std::vector<uint32_t> MeshOptimizer::simplify(const std::vector<ModelLoader::StaticVertex>& vertices, const std::vector<uint32_t>& indices, size_t targetIndexCount, float maxError, float& error)
+{
+	error = 0.0f;
+
+	std::vector<uint32_t> result = indices;
+
+	if (result.size() <= targetIndexCount)
+		return result;
+
+	const auto vertexCount = vertices.size();
+
+	// Positions are mapped to the unit box, for the quadrics precision
+	AABBf aabb;
+	for (const auto& index : indices)
+		aabb.extend(vertices[index].position);
+
+	const auto size = aabb.getSize();
+	const float scale = std::max({ size.x, size.y, size.z });
+
+	if (scale <= 0.0f)
+		return result;
+
+	std::vector<Vector3f> positions(vertexCount);
+	for (size_t i = 0; i < vertexCount; i++)
+		positions[i] = (vertices[i].position - aabb.min) / scale;
+
+	const float maxSquaredError = (maxError / scale) * (maxError / scale);
+
+	std::vector<Quadric> quadrics(vertexCount);
+
+	for (size_t i = 0; i < result.size(); i += 3)
+	{
+		const auto& p1 = positions[result[i + 0]];
+		const auto& p2 = positions[result[i + 1]];
+		const auto& p3 = positions[result[i + 2]];
+
+		auto normal = cross(p2 - p1, p3 - p1);
+		const auto area = normal.getNorm();
+
+		if (area <= 0.0f)
+			continue;
+
+		normal /= area;
+
+		Quadric quadric;
+		quadric.addPlane(normal, -normal.dot(p1), area);
+
+		for (size_t corner = 0; corner < 3; corner++)
+			quadrics[result[i + corner]] += quadric;
+	}
+
+	// Vertices on edges not shared by exactly 2 triangles are locked
+	// This keeps the borders, the attribute seams (split vertices) & the non manifold parts
+	std::vector<bool> lockedVertices(vertexCount, false);
+	{
+		std::vector<uint64_t> edges;
+		edges.reserve(result.size());
+
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (size_t corner = 0; corner < 3; corner++)
+			{
+				const uint64_t a = result[i + corner];
+				const uint64_t b = result[i + (corner + 1) % 3];
+
+				edges.emplace_back(std::min(a, b) << 32 | std::max(a, b));
+			}
+		}
+
+		std::sort(edges.begin(), edges.end());
+
+		for (size_t first = 0; first < edges.size();)
+		{
+			auto last = first + 1;
+			while (last < edges.size() && edges[last] == edges[first])
+				last++;
+
+			if (last - first != 2)
+			{
+				lockedVertices[static_cast<uint32_t>(edges[first] >> 32)] = true;
+				lockedVertices[static_cast<uint32_t>(edges[first] & 0xFFFFFFFF)] = true;
+			}
+
+			first = last;
+		}
+	}
+
+	std::vector<uint32_t> remap(vertexCount);
+	std::vector<bool> modifiedVertices(vertexCount);
+	std::vector<uint32_t> adjacencyOffsets;
+	std::vector<uint32_t> adjacency;
+	std::vector<Collapse> collapses;
+
+	float maxCollapseError = 0.0f;
+
+	// Each pass applies the cheapest collapses not touching the same triangles, then removes the degenerate triangles
+	while (result.size() > targetIndexCount)
+	{
+		buildTriangleAdjacency(result, vertexCount, adjacencyOffsets, adjacency);
+
+		// Edges collapse onto one of their vertices, in both directions
+		// Unlocked edges are shared by 2 triangles with opposite windings : only the ascending one is kept
+		collapses.clear();
+
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (size_t corner = 0; corner < 3; corner++)
+			{
+				const auto a = result[i + corner];
+				const auto b = result[i + (corner + 1) % 3];
+
+				if (a > b)
+					continue;
+
+				for (const auto& [from, to] : { std::make_pair(a, b), std::make_pair(b, a) })
+				{
+					if (lockedVertices[from])
+						continue;
+
+					auto quadric = quadrics[from];
+					quadric += quadrics[to];
+
+					collapses.push_back({ from, to, quadric.getError(positions[to]) });
+				}
+			}
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b)
+			{
+				return a.error < b.error;
+			});
+
+		std::iota(remap.begin(), remap.end(), 0);
+		std::fill(modifiedVertices.begin(), modifiedVertices.end(), false);
+
+		const auto targetRemovedCount = (result.size() - targetIndexCount + 2) / 3;
+		size_t removedCount = 0;
+
+		for (const auto& collapse : collapses)
+		{
+			if (collapse.error > maxSquaredError || removedCount >= targetRemovedCount)
+				break;
+
+			const auto from = collapse.from;
+			const auto to = collapse.to;
+
+			if (modifiedVertices[from] || modifiedVertices[to])
+				continue;
+
+			if (isCollapseInvalid(positions, result, adjacencyOffsets, adjacency, from, to))
+				continue;
+
+			remap[from] = to;
+			quadrics[to] += quadrics[from];
+			maxCollapseError = std::max(maxCollapseError, collapse.error);
+
+			// Triangles around 'from' must not change again during this pass
+			for (auto i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1]; i++)
+			{
+				const auto* triangle = &result[adjacency[i] * 3];
+
+				if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+					removedCount++;
+
+				for (size_t corner = 0; corner < 3; corner++)
+					modifiedVertices[triangle[corner]] = true;
+			}
+		}
+
+		if (removedCount == 0)
+			break;
+
+		size_t indexCount = 0;
+
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const auto a = remap[result[i + 0]];
+			const auto b = remap[result[i + 1]];
+			const auto c = remap[result[i + 2]];
+
+			// Zero area triangles can't be seen, whether they come from the collapses or from the input
+			if (a == b || b == c || c == a || isTriangleDegenerate(positions[a], positions[b], positions[c]))
+				continue;
+
+			result[indexCount++] = a;
+			result[indexCount++] = b;
+			result[indexCount++] = c;
+		}
+
+		result.resize(indexCount);
+	}
+
+	error = std::sqrt(maxCollapseError) * scale;
+
+	return result;
+}
+
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::getVertexCacheStatistics(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize)
+{
+	VertexCacheStatistics statistics;
+
+	const auto triangleCount = indices.size() / 3;
+
+	if (triangleCount == 0)
+		return statistics;
+
+	std::vector<size_t> cacheTimestamps(vertexCount, 0);
+	size_t timestamp = cacheSize + 1;
+
+	std::vector<bool> referencedVertices(vertexCount, false);
+	size_t referencedCount = 0;
+	size_t missCount = 0;
+
+	for (const auto& index : indices)
+	{
+		if (timestamp - cacheTimestamps[index] > cacheSize)
+		{
+			cacheTimestamps[index] = timestamp++;
+			missCount++;
+		}
+
+		if (!referencedVertices[index])
+		{
+			referencedVertices[index] = true;
+			referencedCount++;
+		}
+	}
+
+	statistics.acmr = static_cast<float>(missCount) / static_cast<float>(triangleCount);
+	statistics.atvr = static_cast<float>(missCount) / static_cast<float>(referencedCount);
+
+	return statistics;
+}
@@ -0,0 +1,736 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Atema/Graphics/Loaders/ModelCache.hpp>
+#include <Atema/Core/Error.hpp>
+#include <Atema/Core/MappedFile.hpp>
+#include <Atema/Graphics/MaterialData.hpp>
+#include <Atema/Graphics/Mesh.hpp>
+#include <Atema/Graphics/Model.hpp>
+#include <Atema/Graphics/VertexBuffer.hpp>
+#include <Atema/Renderer/CommandBuffer.hpp>
+#include <Atema/Renderer/CommandPool.hpp>
+#include <Atema/Renderer/Renderer.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace at;
+
+namespace
+{
+	// Stable across platforms, unlike the default hash
+	using FileHasher = Hasher<FNV1a<Hash64>>;
+
+	constexpr uint32_t FileMagic = 0x4C444D41; // 'AMDL'
+	// Must be increased when the file layout or the loader output changes
+	constexpr uint32_t FileVersion = 8;
+
+	// Size of the chunks read to hash the source file
+	constexpr size_t HashChunkSize = 1 << 20;
+
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		Hash64 key;
+		uint32_t vertexByteSize;
+		uint32_t materialCount;
+		uint32_t meshCount;
+	};
+
+	// Followed by the vertices, the indices, the meshlets & the LODs
+	struct MeshHeader
+	{
+		uint32_t materialID;
+		uint32_t indexType;
+		uint64_t vertexCount;
+		uint64_t indexCount;
+		uint64_t meshletCount;
+		uint64_t lodCount;
+		float aabbMin[3];
+		float aabbMax[3];
+		float positionOffset[3];
+		float positionScale;
+		float texCoordsOffset[2];
+		float texCoordsScale[2];
+		float texCoordsDensity;
+	};
+
+	struct MeshletData
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float center[3];
+		float radius;
+		float coneAxis[3];
+		float coneCutoff;
+	};
+
+	struct LodData
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		uint32_t firstMeshlet;
+		uint32_t meshletCount;
+		float error;
+	};
+
+	enum class ValueType : uint8_t
+	{
+		Int,
+		UInt,
+		Float,
+		Double,
+		Color,
+		String,
+		Texture
+	};
+
+	template <typename T>
+	void write(std::ofstream& file, const T& value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	void write(std::ofstream& file, const std::string& str)
+	{
+		write(file, static_cast<uint32_t>(str.size()));
+		file.write(str.data(), static_cast<std::streamsize>(str.size()));
+	}
+
+	void write(std::ofstream& file, const MaterialData::Value& value)
+	{
+		if (value.is<int32_t>())
+		{
+			write(file, ValueType::Int);
+			write(file, value.get<int32_t>());
+		}
+		else if (value.is<uint32_t>())
+		{
+			write(file, ValueType::UInt);
+			write(file, value.get<uint32_t>());
+		}
+		else if (value.is<float>())
+		{
+			write(file, ValueType::Float);
+			write(file, value.get<float>());
+		}
+		else if (value.is<double>())
+		{
+			write(file, ValueType::Double);
+			write(file, value.get<double>());
+		}
+		else if (value.is<Color>())
+		{
+			const auto& color = value.get<Color>();
+
+			write(file, ValueType::Color);
+			write(file, color.r);
+			write(file, color.g);
+			write(file, color.b);
+			write(file, color.a);
+		}
+		else if (value.is<std::string>())
+		{
+			write(file, ValueType::String);
+			write(file, value.get<std::string>());
+		}
+		else if (value.is<MaterialData::Texture>())
+		{
+			write(file, ValueType::Texture);
+			write(file, value.get<MaterialData::Texture>().path.u8string());
+		}
+		else
+		{
+			ATEMA_ERROR("Invalid material value");
+		}
+	}
+
+	// Reads the mapped file, which has no alignment guarantee
+	// Every method returns false if the file is incomplete
+	class FileReader
+	{
+	public:
+		FileReader(const MappedFile& file) :
+			m_data(static_cast<const uint8_t*>(file.getData())),
+			m_end(m_data + file.getSize())
+		{
+		}
+
+		bool read(void* data, size_t byteSize)
+		{
+			if (!skip(byteSize))
+				return false;
+
+			std::memcpy(data, m_data - byteSize, byteSize);
+
+			return true;
+		}
+
+		template <typename T>
+		bool read(T& value)
+		{
+			return read(&value, sizeof(T));
+		}
+
+		bool read(std::string& str)
+		{
+			uint32_t size;
+			if (!read(size) || !skip(size))
+				return false;
+
+			str.assign(reinterpret_cast<const char*>(m_data - size), size);
+
+			return true;
+		}
+
+		bool read(MaterialData::Value& value)
+		{
+			ValueType type;
+			if (!read(type))
+				return false;
+
+			switch (type)
+			{
+				case ValueType::Int: return readValue<int32_t>(value);
+				case ValueType::UInt: return readValue<uint32_t>(value);
+				case ValueType::Float: return readValue<float>(value);
+				case ValueType::Double: return readValue<double>(value);
+				case ValueType::Color:
+				{
+					Color color;
+					if (!read(color.r) || !read(color.g) || !read(color.b) || !read(color.a))
+						return false;
+
+					value = color;
+
+					return true;
+				}
+				case ValueType::String: return readValue<std::string>(value);
+				case ValueType::Texture:
+				{
+					std::string path;
+					if (!read(path))
+						return false;
+
+					value = MaterialData::Texture(std::filesystem::u8path(path));
+
+					return true;
+				}
+				default:
+					return false;
+			}
+		}
+
+		// Returns a pointer to the mapped data, then skips it
+		const uint8_t* map(size_t byteSize)
+		{
+			if (!skip(byteSize))
+				return nullptr;
+
+			return m_data - byteSize;
+		}
+
+	private:
+		bool skip(size_t byteSize)
+		{
+			if (static_cast<size_t>(m_end - m_data) < byteSize)
+				return false;
+
+			m_data += byteSize;
+
+			return true;
+		}
+
+		template <typename T>
+		bool readValue(MaterialData::Value& value)
+		{
+			T typedValue;
+			if (!read(typedValue))
+				return false;
+
+			value = std::move(typedValue);
+
+			return true;
+		}
+
+		const uint8_t* m_data;
+		const uint8_t* m_end;
+	};
+
+	// Hash the file content by chunks, to avoid loading big models at once
+	void hashContent(Hash64& key, std::ifstream& file)
+	{
+		std::vector<char> chunk(HashChunkSize);
+
+		while (file)
+		{
+			file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+
+			const auto readSize = static_cast<size_t>(file.gcount());
+
+			if (readSize > 0)
+				FileHasher::hashCombine(key, FileHasher::hash(chunk.data(), readSize));
+		}
+	}
+
+	// Missing files are hashed too, so creating them later invalidates the cache
+	void hashDependencyContent(Hash64& key, const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		FileHasher::hashCombine(key, FileHasher::hash(path.u8string()), file.is_open());
+
+		if (file.is_open())
+			hashContent(key, file);
+	}
+
+	// Textures are not part of the cached data, their timestamp is enough to detect a change
+	void hashDependencyTimestamp(Hash64& key, const std::filesystem::path& path)
+	{
+		std::error_code errorCode;
+		const auto time = std::filesystem::last_write_time(path, errorCode);
+
+		const int64_t timestamp = errorCode ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+
+		FileHasher::hashCombine(key, FileHasher::hash(path.u8string()), timestamp);
+	}
+
+	std::vector<std::string> getTokens(const std::string& line)
+	{
+		std::vector<std::string> tokens;
+
+		std::istringstream stream(line);
+		std::string token;
+
+		while (stream >> token)
+			tokens.emplace_back(std::move(token));
+
+		return tokens;
+	}
+
+	bool isTextureStatement(const std::string& keyword)
+	{
+		return keyword.rfind("map_", 0) == 0 || keyword == "bump" || keyword == "disp" || keyword == "norm" || keyword == "refl";
+	}
+
+	// OBJ files reference MTL material libraries (relative to the OBJ file), which reference the textures (relative to textureDir)
+	// Same resolution as ObjLoader
+	void hashObjDependencies(Hash64& key, const std::filesystem::path& sourcePath, const std::filesystem::path& textureDir)
+	{
+		std::vector<std::filesystem::path> materialLibraries;
+
+		{
+			std::ifstream file(sourcePath);
+			std::string line;
+
+			while (std::getline(file, line))
+			{
+				if (line.rfind("mtllib", 0) != 0)
+					continue;
+
+				const auto tokens = getTokens(line);
+
+				for (size_t i = 1; i < tokens.size(); i++)
+					materialLibraries.emplace_back(sourcePath.parent_path() / std::filesystem::u8path(tokens[i]));
+			}
+		}
+
+		for (const auto& materialLibrary : materialLibraries)
+		{
+			hashDependencyContent(key, materialLibrary);
+
+			std::ifstream file(materialLibrary);
+			std::string line;
+
+			while (std::getline(file, line))
+			{
+				const auto tokens = getTokens(line);
+
+				// Texture options come first, the file name is the last token
+				if (tokens.size() >= 2 && isTextureStatement(tokens[0]))
+					hashDependencyTimestamp(key, textureDir / std::filesystem::u8path(tokens.back()));
+			}
+		}
+	}
+
+	void writeModel(std::ofstream& file, Hash64 key, const Model& model, const std::vector<ModelLoader::MeshData>& meshData)
+	{
+		const auto& meshes = model.getMeshes();
+		const auto& materials = model.getMaterialData();
+
+		const auto vertexByteSize = meshes.empty() ? 0 : meshes[0]->getVertexBuffer()->getFormat().getByteSize();
+
+		FileHeader fileHeader;
+		fileHeader.magic = FileMagic;
+		fileHeader.version = FileVersion;
+		fileHeader.key = key;
+		fileHeader.vertexByteSize = static_cast<uint32_t>(vertexByteSize);
+		fileHeader.materialCount = static_cast<uint32_t>(materials.size());
+		fileHeader.meshCount = static_cast<uint32_t>(meshes.size());
+
+		write(file, fileHeader);
+
+		// Materials only store parameters, textures are referenced by path
+		for (const auto& material : materials)
+		{
+			const auto& parameters = material->getParameters();
+
+			write(file, static_cast<uint32_t>(parameters.size()));
+
+			for (const auto& parameter : parameters)
+			{
+				write(file, parameter.name);
+				write(file, parameter.value);
+			}
+		}
+
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			const auto& mesh = *meshes[i];
+			const auto& data = meshData[i];
+			const auto& aabb = mesh.getAABB();
+
+			const size_t indexByteSize = data.indexType == IndexType::U32 ? sizeof(uint32_t) : sizeof(uint16_t);
+
+			MeshHeader meshHeader;
+			meshHeader.materialID = static_cast<uint32_t>(mesh.getMaterialID());
+			meshHeader.indexType = static_cast<uint32_t>(data.indexType);
+			meshHeader.vertexCount = data.vertices.size() / vertexByteSize;
+			meshHeader.indexCount = data.indices.size() / indexByteSize;
+			meshHeader.meshletCount = data.meshlets.size();
+			meshHeader.lodCount = data.lods.size();
+
+			for (size_t axis = 0; axis < 3; axis++)
+			{
+				meshHeader.aabbMin[axis] = aabb.min[axis];
+				meshHeader.aabbMax[axis] = aabb.max[axis];
+				meshHeader.positionOffset[axis] = data.quantization.positionOffset[axis];
+			}
+
+			meshHeader.positionScale = data.quantization.positionScale;
+			meshHeader.texCoordsDensity = data.texCoordsDensity;
+
+			for (size_t axis = 0; axis < 2; axis++)
+			{
+				meshHeader.texCoordsOffset[axis] = data.quantization.texCoordsOffset[axis];
+				meshHeader.texCoordsScale[axis] = data.quantization.texCoordsScale[axis];
+			}
+
+			write(file, meshHeader);
+
+			file.write(reinterpret_cast<const char*>(data.vertices.data()), static_cast<std::streamsize>(data.vertices.size()));
+			file.write(reinterpret_cast<const char*>(data.indices.data()), static_cast<std::streamsize>(data.indices.size()));
+
+			for (const auto& meshlet : data.meshlets)
+			{
+				MeshletData meshletData;
+				meshletData.firstIndex = meshlet.firstIndex;
+				meshletData.indexCount = meshlet.indexCount;
+				meshletData.radius = meshlet.boundingSphere.radius;
+				meshletData.coneCutoff = meshlet.coneCutoff;
+
+				for (size_t axis = 0; axis < 3; axis++)
+				{
+					meshletData.center[axis] = meshlet.boundingSphere.center[axis];
+					meshletData.coneAxis[axis] = meshlet.coneAxis[axis];
+				}
+
+				write(file, meshletData);
+			}
+
+			for (const auto& lod : data.lods)
+			{
+				LodData lodData;
+				lodData.firstIndex = lod.firstIndex;
+				lodData.indexCount = lod.indexCount;
+				lodData.firstMeshlet = lod.firstMeshlet;
+				lodData.meshletCount = lod.meshletCount;
+				lodData.error = lod.error;
+
+				write(file, lodData);
+			}
+		}
+	}
+}
+
+Hash64 ModelCache::getKey(const std::filesystem::path& sourcePath, const ModelLoader::Settings& settings)
+{
+	std::ifstream file(sourcePath, std::ios::binary);
+
+	if (!file.is_open())
+		ATEMA_ERROR("Failed to open file '" + sourcePath.string() + "'");
+
+	Hash64 key = 0;
+
+	hashContent(key, file);
+
+	if (sourcePath.extension() == ".obj")
+		hashObjDependencies(key, sourcePath, settings.textureDir.empty() ? sourcePath.parent_path() : settings.textureDir);
+
+	for (const auto& component : settings.getVertexFormat().getComponents())
+	{
+		FileHasher::hashCombine(key, static_cast<uint32_t>(component.type), static_cast<uint32_t>(component.format));
+		FileHasher::hashCombine(key, static_cast<uint64_t>(component.getByteOffset()));
+	}
+
+	FileHasher::hashCombine(key, settings.flipTexCoords, settings.optimizeMesh, settings.buildMeshlets);
+	FileHasher::hashCombine(key, static_cast<uint64_t>(settings.lodCount), settings.lodTriangleRatio);
+
+	// Index type is only part of the key when forced, otherwise it only depends on the source
+	if (settings.indexType.has_value())
+		FileHasher::hashCombine(key, static_cast<uint32_t>(settings.indexType.value()));
+
+	if (settings.vertexTransformation.has_value())
+	{
+		const auto& transform = settings.vertexTransformation.value();
+
+		for (size_t i = 0; i < 4; i++)
+			FileHasher::hashCombine(key, transform[i].x, transform[i].y, transform[i].z, transform[i].w);
+	}
+
+	FileHasher::hashCombine(key, FileHasher::hash(settings.textureDir.u8string()));
+
+	return key;
+}
+
+void ModelCache::save(const std::filesystem::path& path, Hash64 key, const Model& model, const std::vector<ModelLoader::MeshData>& meshData)
+{
+	ATEMA_ASSERT(model.getMeshes().size() == meshData.size(), "Mesh data doesn't match the model");
+
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path());
+
+	// The file is written under a temporary name then renamed, so a crash never leaves a partial file
+	// Temporary names must be unique, other threads may save the same model
+	std::stringstream tempName;
+	tempName << path.filename().string() << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+
+	const auto tempPath = path.parent_path() / tempName.str();
+
+	bool written = false;
+
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open())
+			ATEMA_ERROR("Failed to open file '" + tempPath.string() + "'");
+
+		try
+		{
+			writeModel(file, key, model, meshData);
+		}
+		catch (...)
+		{
+			file.close();
+
+			std::error_code errorCode;
+			std::filesystem::remove(tempPath, errorCode);
+
+			throw;
+		}
+
+		file.close();
+
+		written = !file.fail();
+	}
+
+	std::error_code errorCode;
+
+	if (written)
+		std::filesystem::rename(tempPath, path, errorCode);
+
+	if (!written || errorCode)
+	{
+		std::filesystem::remove(tempPath, errorCode);
+
+		ATEMA_ERROR("Failed to write file '" + path.string() + "'");
+	}
+}
+
+Ptr<Model> ModelCache::load(const std::filesystem::path& path, Hash64 key, const ModelLoader::Settings& settings)
+{
+	MappedFile file(path);
+
+	if (!file.isOpen())
+		return nullptr;
+
+	FileReader reader(file);
+
+	FileHeader fileHeader;
+
+	if (!reader.read(fileHeader))
+		return nullptr;
+
+	const auto vertexByteSize = settings.getVertexFormat().getByteSize();
+
+	if (fileHeader.magic != FileMagic || fileHeader.version != FileVersion || fileHeader.key != key)
+		return nullptr;
+
+	if (fileHeader.meshCount > 0 && fileHeader.vertexByteSize != vertexByteSize)
+		return nullptr;
+
+	auto model = std::make_shared<Model>();
+
+	for (uint32_t i = 0; i < fileHeader.materialCount; i++)
+	{
+		uint32_t parameterCount;
+		if (!reader.read(parameterCount))
+			return nullptr;
+
+		auto materialData = std::make_shared<MaterialData>();
+
+		for (uint32_t p = 0; p < parameterCount; p++)
+		{
+			MaterialData::Parameter parameter;
+			if (!reader.read(parameter.name) || !reader.read(parameter.value))
+				return nullptr;
+
+			materialData->set(parameter);
+		}
+
+		model->addMaterialData(materialData);
+	}
+
+	// Validate every mesh before creating any buffer, so an incomplete file has no side effect
+	struct MeshView
+	{
+		MeshHeader header;
+		const uint8_t* vertices;
+		const uint8_t* indices;
+		const uint8_t* meshlets;
+		const uint8_t* lods;
+	};
+
+	std::vector<MeshView> meshViews(fileHeader.meshCount);
+
+	for (auto& meshView : meshViews)
+	{
+		if (!reader.read(meshView.header))
+			return nullptr;
+
+		const auto indexType = static_cast<IndexType>(meshView.header.indexType);
+		const size_t indexByteSize = indexType == IndexType::U32 ? sizeof(uint32_t) : sizeof(uint16_t);
+
+		meshView.vertices = reader.map(meshView.header.vertexCount * vertexByteSize);
+		meshView.indices = reader.map(meshView.header.indexCount * indexByteSize);
+		meshView.meshlets = reader.map(meshView.header.meshletCount * sizeof(MeshletData));
+		meshView.lods = reader.map(meshView.header.lodCount * sizeof(LodData));
+
+		if (!meshView.vertices || !meshView.indices || !meshView.meshlets || !meshView.lods)
+			return nullptr;
+	}
+
+	// Same as the loaders : all the meshes are loaded with the same command buffer
+	ModelLoader::Settings newSettings = settings;
+
+	std::list<Ptr<Buffer>> stagingBuffers;
+	if (!settings.commandBuffer)
+	{
+		auto commandPool = Renderer::instance().getCommandPool(QueueType::Graphics);
+
+		newSettings.commandBuffer = commandPool->createBuffer({ true });
+
+		newSettings.commandBuffer->begin();
+
+		newSettings.stagingBuffers = &stagingBuffers;
+	}
+
+	for (const auto& meshView : meshViews)
+	{
+		const auto& header = meshView.header;
+
+		AABBf aabb;
+		aabb.min = { header.aabbMin[0], header.aabbMin[1], header.aabbMin[2] };
+		aabb.max = { header.aabbMax[0], header.aabbMax[1], header.aabbMax[2] };
+
+		VertexQuantization quantization;
+		quantization.positionOffset = { header.positionOffset[0], header.positionOffset[1], header.positionOffset[2] };
+		quantization.positionScale = header.positionScale;
+		quantization.texCoordsOffset = { header.texCoordsOffset[0], header.texCoordsOffset[1] };
+		quantization.texCoordsScale = { header.texCoordsScale[0], header.texCoordsScale[1] };
+
+		auto mesh = ModelLoader::loadMesh(
+			meshView.vertices, static_cast<size_t>(header.vertexCount),
+			meshView.indices, static_cast<size_t>(header.indexCount), static_cast<IndexType>(header.indexType),
+			aabb, quantization, newSettings);
+
+		mesh->setMaterialID(header.materialID);
+		mesh->setTexCoordsDensity(header.texCoordsDensity);
+
+		if (header.meshletCount > 0)
+		{
+			std::vector<Meshlet> meshlets(static_cast<size_t>(header.meshletCount));
+
+			for (size_t i = 0; i < meshlets.size(); i++)
+			{
+				// The mapped data has no alignment guarantee
+				MeshletData meshletData;
+				std::memcpy(&meshletData, meshView.meshlets + i * sizeof(MeshletData), sizeof(MeshletData));
+
+				auto& meshlet = meshlets[i];
+				meshlet.firstIndex = meshletData.firstIndex;
+				meshlet.indexCount = meshletData.indexCount;
+				meshlet.boundingSphere.set({ meshletData.center[0], meshletData.center[1], meshletData.center[2] }, meshletData.radius);
+				meshlet.coneAxis = { meshletData.coneAxis[0], meshletData.coneAxis[1], meshletData.coneAxis[2] };
+				meshlet.coneCutoff = meshletData.coneCutoff;
+			}
+
+			mesh->setMeshlets(meshlets);
+		}
+
+		// Before adding the mesh to the model, which counts its triangles
+		if (header.lodCount > 0)
+		{
+			std::vector<MeshLod> lods(static_cast<size_t>(header.lodCount));
+
+			for (size_t i = 0; i < lods.size(); i++)
+			{
+				LodData lodData;
+				std::memcpy(&lodData, meshView.lods + i * sizeof(LodData), sizeof(LodData));
+
+				auto& lod = lods[i];
+				lod.firstIndex = lodData.firstIndex;
+				lod.indexCount = lodData.indexCount;
+				lod.firstMeshlet = lodData.firstMeshlet;
+				lod.meshletCount = lodData.meshletCount;
+				lod.error = lodData.error;
+			}
+
+			mesh->setLods(lods);
+		}
+
+		model->addMesh(std::move(mesh));
+	}
+
+	if (!settings.commandBuffer)
+	{
+		newSettings.commandBuffer->end();
+
+		Renderer::instance().submitAndWait({ newSettings.commandBuffer });
+	}
+
+	return model;
+}
@@ -21,96 +21,150 @@
 
 #include <Atema/Graphics/IndexBuffer.hpp>
 #include <Atema/Graphics/Mesh.hpp>
+#include <Atema/Graphics/Loaders/MeshOptimizer.hpp>
 #include <Atema/Graphics/Loaders/ModelLoader.hpp>
 #include <Atema/Graphics/VertexFormat.hpp>
 #include <Atema/Graphics/VertexBuffer.hpp>
 #include <Atema/Math/Math.hpp>
 #include <Atema/Renderer/Renderer.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
 using namespace at;
 
 namespace
 {
-	void vec2fToRG32f(MemoryMapper& src, size_t srcOffset, MemoryMapper& dst, size_t dstOffset, size_t size)
+	// A LOD must remove at least 10% of the indices of the previous one
+	constexpr float MaxLodIndexRatio = 0.9f;
+
+	// Converters from the source float elements to the destination element types
+	struct ToFloat
 	{
-		for (size_t i = 0; i < size; i++)
-			dst.map<Vector2f>(i, dstOffset) = src.map<Vector2f>(i, srcOffset);
-	}
+		using Type = float;
+		static Type convert(float value) { return value; }
+	};
 
-	void vec2fToRG64f(MemoryMapper& src, size_t srcOffset, MemoryMapper& dst, size_t dstOffset, size_t size)
+	struct ToDouble
 	{
-		for (size_t i = 0; i < size; i++)
-		{
-			const auto& vec = src.map<Vector2f>(i, srcOffset);
-			dst.map<Vector2d>(i, dstOffset) = { vec.x, vec.y };
-		}
-	}
+		using Type = double;
+		static Type convert(float value) { return static_cast<double>(value); }
+	};
 
-	void vec3fToRGB32f (MemoryMapper& src, size_t srcOffset, MemoryMapper& dst, size_t dstOffset, size_t size)
+	// Subnormal values are flushed to zero
+	struct ToHalf
 	{
-		for (size_t i = 0; i < size; i++)
-			dst.map<Vector3f>(i, dstOffset) = src.map<Vector3f>(i, srcOffset);
-	}
+		using Type = uint16_t;
+		static Type convert(float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(float));
+
+			const uint32_t sign = (bits >> 16) & 0x8000;
+			const uint32_t absBits = bits & 0x7FFFFFFF;
+
+			// NaN
+			if (absBits > (255u << 23))
+				return static_cast<Type>(sign | 0x7E00);
+
+			// Overflow (infinity)
+			if (absBits >= (143u << 23))
+				return static_cast<Type>(sign | 0x7C00);
+
+			// Underflow
+			if (absBits < (113u << 23))
+				return static_cast<Type>(sign);
 
-	void vec3fToRGBA32f(MemoryMapper& src, size_t srcOffset, MemoryMapper& dst, size_t dstOffset, size_t size, float w)
+			// Rebias the exponent (127 -> 15) and round the mantissa to nearest
+			return static_cast<Type>(sign | ((absBits - (112u << 23) + (1u << 12)) >> 13));
+		}
+	};
+
+	template <typename T>
+	struct ToUnorm
 	{
-		for (size_t i = 0; i < size; i++)
+		using Type = T;
+		static Type convert(float value)
 		{
-			const auto& vec = src.map<Vector3f>(i, srcOffset);
-			dst.map<Vector4f>(i, dstOffset) = { vec.x, vec.y, vec.z, w };
+			return static_cast<Type>(std::round(std::clamp(value, 0.0f, 1.0f) * static_cast<float>(std::numeric_limits<T>::max())));
 		}
-	}
+	};
 
-	void vec3fToRGB64f(MemoryMapper& src, size_t srcOffset, MemoryMapper& dst, size_t dstOffset, size_t size)
+	template <typename T>
+	struct ToSnorm
 	{
-		for (size_t i = 0; i < size; i++)
+		using Type = T;
+		static Type convert(float value)
 		{
-			const auto& vec = src.map<Vector3f>(i, srcOffset);
-			dst.map<Vector3d>(i, dstOffset) = { vec.x, vec.y, vec.z };
+			return static_cast<Type>(std::round(std::clamp(value, -1.0f, 1.0f) * static_cast<float>(std::numeric_limits<T>::max())));
 		}
-	}
+	};
 
-	void vec3fToRGBA64f(MemoryMapper& src, size_t srcOffset, MemoryMapper& dst, size_t dstOffset, size_t size, double w)
+	// Source elements are floats, missing destination elements are filled with w
+	template <typename Converter>
+	void convertComponent(MemoryMapper& src, size_t srcOffset, size_t srcSize, MemoryMapper& dst, size_t dstOffset, size_t dstSize, size_t count, float w)
 	{
-		for (size_t i = 0; i < size; i++)
+		for (size_t i = 0; i < count; i++)
 		{
-			const auto& vec = src.map<Vector3f>(i, srcOffset);
-			dst.map<Vector4d>(i, dstOffset) = { static_cast<double>(vec.x), static_cast<double>(vec.y), static_cast<double>(vec.z), w };
+			const auto* srcElements = &src.map<float>(i, srcOffset);
+			auto* dstElements = &dst.map<typename Converter::Type>(i, dstOffset);
+
+			for (size_t j = 0; j < dstSize; j++)
+				dstElements[j] = Converter::convert(j < srcSize ? srcElements[j] : w);
 		}
 	}
 
-	void copyComponent(VertexInputFormat format, MemoryMapper& src, size_t srcOffset, MemoryMapper& dst, size_t dstOffset, size_t size, double w = 0.0)
+	void copyComponent(const VertexComponent& component, MemoryMapper& src, size_t srcOffset, size_t srcSize, MemoryMapper& dst, size_t count, float w = 0.0f)
 	{
-		switch (format)
+		const auto dstOffset = component.getByteOffset();
+		const auto dstSize = component.getElementSize();
+
+		switch (component.format)
 		{
 			case VertexInputFormat::RG32_SFLOAT:
+			case VertexInputFormat::RGB32_SFLOAT:
+			case VertexInputFormat::RGBA32_SFLOAT:
 			{
-				vec2fToRG32f(src, srcOffset, dst, dstOffset, size);
+				convertComponent<ToFloat>(src, srcOffset, srcSize, dst, dstOffset, dstSize, count, w);
 				break;
 			}
-			case VertexInputFormat::RGB32_SFLOAT:
+			case VertexInputFormat::RG64_SFLOAT:
+			case VertexInputFormat::RGB64_SFLOAT:
+			case VertexInputFormat::RGBA64_SFLOAT:
 			{
-				vec3fToRGB32f(src, srcOffset, dst, dstOffset, size);
+				convertComponent<ToDouble>(src, srcOffset, srcSize, dst, dstOffset, dstSize, count, w);
 				break;
 			}
-			case VertexInputFormat::RGBA32_SFLOAT:
+			case VertexInputFormat::RG16_SFLOAT:
+			case VertexInputFormat::RGB16_SFLOAT:
+			case VertexInputFormat::RGBA16_SFLOAT:
 			{
-				vec3fToRGBA32f(src, srcOffset, dst, dstOffset, size, static_cast<float>(w));
+				convertComponent<ToHalf>(src, srcOffset, srcSize, dst, dstOffset, dstSize, count, w);
 				break;
 			}
-			case VertexInputFormat::RG64_SFLOAT:
+			case VertexInputFormat::RG16_UNORM:
+			case VertexInputFormat::RGBA16_UNORM:
 			{
-				vec2fToRG64f(src, srcOffset, dst, dstOffset, size);
+				convertComponent<ToUnorm<uint16_t>>(src, srcOffset, srcSize, dst, dstOffset, dstSize, count, w);
 				break;
 			}
-			case VertexInputFormat::RGB64_SFLOAT:
+			case VertexInputFormat::RG16_SNORM:
+			case VertexInputFormat::RGBA16_SNORM:
 			{
-				vec3fToRGB64f(src, srcOffset, dst, dstOffset, size);
+				convertComponent<ToSnorm<int16_t>>(src, srcOffset, srcSize, dst, dstOffset, dstSize, count, w);
 				break;
 			}
-			case VertexInputFormat::RGBA64_SFLOAT:
+			case VertexInputFormat::RGBA8_UNORM:
+			{
+				convertComponent<ToUnorm<uint8_t>>(src, srcOffset, srcSize, dst, dstOffset, dstSize, count, w);
+				break;
+			}
+			case VertexInputFormat::RGBA8_SNORM:
 			{
-				vec3fToRGBA64f(src, srcOffset, dst, dstOffset, size, w);
+				convertComponent<ToSnorm<int8_t>>(src, srcOffset, srcSize, dst, dstOffset, dstSize, count, w);
 				break;
 			}
 			default:
@@ -119,6 +173,160 @@ namespace
 			}
 		}
 	}
+
+	bool isSignedNormalized(VertexInputFormat format)
+	{
+		return format == VertexInputFormat::RG16_SNORM || format == VertexInputFormat::RGBA16_SNORM || format == VertexInputFormat::RGBA8_SNORM;
+	}
+
+	// Octahedral encoding of a unit vector, in [-1,1]
+	Vector2f encodeOctahedral(const Vector3f& vector)
+	{
+		const float length = std::abs(vector.x) + std::abs(vector.y) + std::abs(vector.z);
+
+		if (length <= 0.0f)
+			return {};
+
+		Vector2f result(vector.x / length, vector.y / length);
+
+		// Fold the lower hemisphere over the diagonals
+		if (vector.z < 0.0f)
+		{
+			const Vector2f folded(1.0f - std::abs(result.y), 1.0f - std::abs(result.x));
+
+			result.x = result.x >= 0.0f ? folded.x : -folded.x;
+			result.y = result.y >= 0.0f ? folded.y : -folded.y;
+		}
+
+		return result;
+	}
+
+	// Mixes the vertex 32-bits words 2 by 2 (much faster than hashing each byte)
+	uint64_t hashVertex(const ModelLoader::StaticVertex& vertex)
+	{
+		constexpr size_t WordCount = sizeof(ModelLoader::StaticVertex) / sizeof(uint32_t);
+
+		static_assert(sizeof(ModelLoader::StaticVertex) % sizeof(uint32_t) == 0, "StaticVertex must only contain 32-bits words");
+
+		uint32_t words[WordCount];
+		std::memcpy(words, &vertex, sizeof(ModelLoader::StaticVertex));
+
+		uint64_t hash = 0x9E3779B97F4A7C15ULL;
+
+		for (size_t i = 0; i < WordCount; i += 2)
+		{
+			uint64_t value = words[i];
+
+			if (i + 1 < WordCount)
+				value |= static_cast<uint64_t>(words[i + 1]) << 32;
+
+			hash = (hash ^ value) * 0xBF58476D1CE4E5B9ULL;
+			hash ^= hash >> 31;
+		}
+
+		// Final avalanche (MurmurHash3 fmix64)
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ULL;
+		hash ^= hash >> 33;
+
+		return hash;
+	}
+
+	// MikkTSpace helpers (see ModelLoader::generateTangents)
+	constexpr uint32_t NoIndex = std::numeric_limits<uint32_t>::max();
+
+	// Same test as MikkTSpace : only exact zeros are rejected
+	bool isNotZero(float value)
+	{
+		return std::abs(value) > std::numeric_limits<float>::min();
+	}
+
+	bool isNotZero(const Vector3f& vector)
+	{
+		return isNotZero(vector.x) || isNotZero(vector.y) || isNotZero(vector.z);
+	}
+
+	Vector3f normalizeSafe(const Vector3f& vector)
+	{
+		return isNotZero(vector) ? vector.getNormalized() : vector;
+	}
+
+	// Projects a vector on the plane orthogonal to the normal
+	Vector3f project(const Vector3f& vector, const Vector3f& normal)
+	{
+		return normalizeSafe(vector - normal * normal.dot(vector));
+	}
+
+	// Tangent space of a triangle, before being shared with the neighbour triangles
+	struct TangentTriangle
+	{
+		Vector3f tangent;
+		Vector3f bitangent;
+		// The UVs keep the winding of the positions (not mirrored)
+		bool orientationPreserving = false;
+		// Triangles without valid UVs join the group of any neighbour, taking its orientation
+		bool groupWithAny = true;
+	};
+
+	// Returns the triangle sharing each edge (corner to next corner) in the opposite direction, or NoIndex
+	std::vector<uint32_t> buildTriangleNeighbours(const std::vector<uint32_t>& weldedIndices)
+	{
+		struct Edge
+		{
+			uint64_t key;
+			uint32_t corner;
+			bool reversed;
+		};
+
+		std::vector<Edge> edges;
+		edges.reserve(weldedIndices.size());
+
+		for (size_t corner = 0; corner < weldedIndices.size(); corner++)
+		{
+			const uint64_t a = weldedIndices[corner];
+			const uint64_t b = weldedIndices[corner - corner % 3 + (corner + 1) % 3];
+
+			edges.push_back({ std::min(a, b) << 32 | std::max(a, b), static_cast<uint32_t>(corner), a > b });
+		}
+
+		std::sort(edges.begin(), edges.end(), [](const Edge& edge1, const Edge& edge2)
+			{
+				return edge1.key < edge2.key || (edge1.key == edge2.key && edge1.corner < edge2.corner);
+			});
+
+		std::vector<uint32_t> neighbours(weldedIndices.size(), NoIndex);
+
+		for (size_t first = 0; first < edges.size();)
+		{
+			auto last = first + 1;
+			while (last < edges.size() && edges[last].key == edges[first].key)
+				last++;
+
+			// Each edge is paired with the first free edge going in the opposite direction
+			for (auto i = first; i < last; i++)
+			{
+				if (neighbours[edges[i].corner] != NoIndex)
+					continue;
+
+				for (auto j = i + 1; j < last; j++)
+				{
+					if (edges[j].reversed == edges[i].reversed || neighbours[edges[j].corner] != NoIndex)
+						continue;
+
+					neighbours[edges[i].corner] = edges[j].corner / 3;
+					neighbours[edges[j].corner] = edges[i].corner / 3;
+
+					break;
+				}
+			}
+
+			first = last;
+		}
+
+		return neighbours;
+	}
 }
 
 //-----
@@ -138,6 +346,7 @@ bool ModelLoader::StaticVertex::operator==(const StaticVertex& other) const
 // ModelLoader::Settings
 ModelLoader::Settings::Settings(const VertexFormat& vertexFormat) :
 	stagingBuffers(nullptr),
+	meshData(nullptr),
 	m_vertexFormat(vertexFormat)
 {
 	ensureVertexFormatValid();
@@ -150,7 +359,7 @@ void ModelLoader::Settings::ensureVertexFormatValid() const
 		if (m_vertexFormat.hasComponent(VertexComponentType::Position))
 		{
 			const auto& component = m_vertexFormat.getComponent(VertexComponentType::Position);
-			ATEMA_ASSERT(component.isFloatingPoint() && component.getElementSize() >= 3, "Position component must have at least 3 floating point elements");
+			ATEMA_ASSERT((component.isFloatingPoint() || isSignedNormalized(component.format)) && component.getElementSize() >= 3, "Position component must have at least 3 floating point or snorm elements");
 		}
 		else
 		{
@@ -160,19 +369,19 @@ void ModelLoader::Settings::ensureVertexFormatValid() const
 		if (m_vertexFormat.hasComponent(VertexComponentType::TexCoords))
 		{
 			const auto& component = m_vertexFormat.getComponent(VertexComponentType::TexCoords);
-			ATEMA_ASSERT(component.isFloatingPoint() && component.getElementSize() == 2, "TexCoords component must have 2 floating point elements");
+			ATEMA_ASSERT((component.isFloatingPoint() || component.isNormalized()) && component.getElementSize() == 2, "TexCoords component must have 2 floating point or normalized elements");
 		}
 
 		if (m_vertexFormat.hasComponent(VertexComponentType::Normal))
 		{
 			const auto& component = m_vertexFormat.getComponent(VertexComponentType::Normal);
-			ATEMA_ASSERT(component.isFloatingPoint() && component.getElementSize() >= 3, "Normal component must have at least 3 floating point elements");
+			ATEMA_ASSERT((component.isFloatingPoint() && component.getElementSize() >= 3) || isSignedNormalized(component.format), "Normal component must have at least 3 floating point elements or be snorm");
 		}
 
 		if (m_vertexFormat.hasComponent(VertexComponentType::Tangent))
 		{
 			const auto& component = m_vertexFormat.getComponent(VertexComponentType::Tangent);
-			ATEMA_ASSERT(component.isFloatingPoint() && component.getElementSize() >= 3, "Tangent component must have at least 3 floating point elements");
+			ATEMA_ASSERT((component.isFloatingPoint() && component.getElementSize() >= 3) || isSignedNormalized(component.format), "Tangent component must have at least 3 floating point elements or be snorm");
 		}
 
 		if (m_vertexFormat.hasComponent(VertexComponentType::Bitangent))
@@ -196,90 +405,247 @@ const VertexFormat& ModelLoader::Settings::getVertexFormat() const
 // ModelLoader
 void ModelLoader::generateTangents(std::vector<StaticVertex>& vertices, std::vector<uint32_t>& indices)
 {
-	std::vector<StaticVertex> newVertices;
-	std::vector<uint32_t> newIndices;
+	// This follows MikkTSpace (genTangSpaceDefault), so normal maps baked with it are matched :
+	// - vertices are identified by their position, UVs & normal only
+	// - each triangle tangent is projected on the vertex normal plane, then weighted by the projected corner angle
+	// - corners are only shared within fans of adjacent triangles with the same UV orientation
+	// - the bitangent is sign * cross(normal, tangent)
 
-	newVertices.reserve(indices.size());
-	newIndices.reserve(indices.size());
+	// Degenerate triangles (without any area) are removed
+	std::vector<uint32_t> triangleIndices;
+	triangleIndices.reserve(indices.size());
 
-	const auto triangleCount = indices.size() / 3;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		const auto& p1 = vertices[indices[i + 0]].position;
+		const auto& p2 = vertices[indices[i + 1]].position;
+		const auto& p3 = vertices[indices[i + 2]].position;
 
-	uint32_t newIndex = 0;
-	for (size_t triangleIndex = 0; triangleIndex < triangleCount; triangleIndex++)
+		if (cross(p2 - p1, p3 - p1).getSquaredNorm() == 0.0f)
+			continue;
+
+		triangleIndices.insert(triangleIndices.end(), { indices[i + 0], indices[i + 1], indices[i + 2] });
+	}
+
+	const auto cornerCount = triangleIndices.size();
+	const auto triangleCount = cornerCount / 3;
+
+	// Welded vertices : the previous tangent space must not split them
+	std::vector<StaticVertex> weldedVertices = vertices;
+	std::vector<uint32_t> weldedIndices = triangleIndices;
+
+	for (auto& vertex : weldedVertices)
+	{
+		vertex.tangent = Vector3f();
+		vertex.bitangent = Vector3f();
+	}
+
+	removeDuplicates(weldedVertices, weldedIndices);
+
+	// Unit normals, from the faces for vertices without a valid normal
+	std::vector<Vector3f> normals(weldedVertices.size());
+	std::vector<Vector3f> faceNormals(weldedVertices.size());
+
+	for (size_t i = 0; i < cornerCount; i += 3)
 	{
-		const auto firstVertexIndex = triangleIndex * 3;
+		const auto& p1 = weldedVertices[weldedIndices[i + 0]].position;
+		const auto& p2 = weldedVertices[weldedIndices[i + 1]].position;
+		const auto& p3 = weldedVertices[weldedIndices[i + 2]].position;
+
+		const auto faceNormal = cross(p2 - p1, p3 - p1);
 
-		auto& v1 = vertices[indices[firstVertexIndex]];
-		auto& v2 = vertices[indices[firstVertexIndex + 1]];
-		auto& v3 = vertices[indices[firstVertexIndex + 2]];
+		for (size_t corner = 0; corner < 3; corner++)
+			faceNormals[weldedIndices[i + corner]] += faceNormal;
+	}
 
-		auto edge1 = v2.position - v1.position;
-		auto edge2 = v3.position - v1.position;
+	for (size_t i = 0; i < weldedVertices.size(); i++)
+	{
+		const auto& normal = weldedVertices[i].normal;
 
-		auto deltaUV1 = v2.texCoords - v1.texCoords;
-		auto deltaUV2 = v3.texCoords - v1.texCoords;
+		normals[i] = normal.getSquaredNorm() > Math::Epsilon<float> ? normal.getNormalized() : normalizeSafe(faceNormals[i]);
+	}
 
-		Matrix3x2f edgeMatrix;
-		edgeMatrix[0] = { edge1.x, edge2.x };
-		edgeMatrix[1] = { edge1.y, edge2.y };
-		edgeMatrix[2] = { edge1.z, edge2.z };
+	// Tangent space of each triangle
+	std::vector<TangentTriangle> triangles(triangleCount);
 
-		Matrix2f deltaUVMatrix;
-		deltaUVMatrix[0] = { deltaUV1.x, deltaUV2.x };
-		deltaUVMatrix[1] = { deltaUV1.y, deltaUV2.y };
+	for (size_t triangleIndex = 0; triangleIndex < triangleCount; triangleIndex++)
+	{
+		const auto* triangle = &weldedIndices[triangleIndex * 3];
 
-		Vector3f tangent;
-		Vector3f bitangent;
+		const auto& v1 = weldedVertices[triangle[0]];
+		const auto& v2 = weldedVertices[triangle[1]];
+		const auto& v3 = weldedVertices[triangle[2]];
 
-		// Deduce tangent space from position & UVs
-		if (deltaUVMatrix.isInvertible())
+		const auto edge1 = v2.position - v1.position;
+		const auto edge2 = v3.position - v1.position;
+
+		const auto deltaUV1 = v2.texCoords - v1.texCoords;
+		const auto deltaUV2 = v3.texCoords - v1.texCoords;
+
+		// Twice the signed UV area
+		const auto determinant = deltaUV1.x * deltaUV2.y - deltaUV1.y * deltaUV2.x;
+
+		auto& tangentTriangle = triangles[triangleIndex];
+		tangentTriangle.tangent = edge1 * deltaUV2.y - edge2 * deltaUV1.y;
+		tangentTriangle.bitangent = edge2 * deltaUV1.x - edge1 * deltaUV2.x;
+		tangentTriangle.orientationPreserving = determinant > 0.0f;
+
+		if (isNotZero(determinant))
 		{
-			auto tbMatrix = deltaUVMatrix.inverse() * edgeMatrix;
+			const auto sign = tangentTriangle.orientationPreserving ? 1.0f : -1.0f;
+
+			const auto tangentLength = tangentTriangle.tangent.getNorm();
+			const auto bitangentLength = tangentTriangle.bitangent.getNorm();
+
+			if (isNotZero(tangentLength))
+				tangentTriangle.tangent *= sign / tangentLength;
 
-			tangent = { tbMatrix[0].x, tbMatrix[1].x, tbMatrix[2].x };
-			bitangent = { tbMatrix[0].y, tbMatrix[1].y, tbMatrix[2].y };
+			if (isNotZero(bitangentLength))
+				tangentTriangle.bitangent *= sign / bitangentLength;
 
-			tangent.normalize();
-			bitangent.normalize();
+			const auto area = std::abs(determinant);
+
+			if (isNotZero(tangentLength / area) && isNotZero(bitangentLength / area))
+				tangentTriangle.groupWithAny = false;
 		}
-		// We can't use UVs, take the first edge as the tangent
-		else
+	}
+
+	// Groups : corners sharing a vertex in a fan of adjacent triangles with the same orientation
+	const auto neighbours = buildTriangleNeighbours(weldedIndices);
+
+	std::vector<uint32_t> cornerGroups(cornerCount, NoIndex);
+	std::vector<uint32_t> groupVertices;
+	std::vector<bool> groupOrientations;
+	std::vector<uint32_t> pendingTriangles;
+
+	const auto findCorner = [&](size_t triangleIndex, uint32_t vertexIndex)
+	{
+		const auto* triangle = &weldedIndices[triangleIndex * 3];
+
+		return triangle[0] == vertexIndex ? 0 : (triangle[1] == vertexIndex ? 1 : 2);
+	};
+
+	for (size_t triangleIndex = 0; triangleIndex < triangleCount; triangleIndex++)
+	{
+		if (triangles[triangleIndex].groupWithAny)
+			continue;
+
+		for (size_t corner = 0; corner < 3; corner++)
 		{
-			tangent = edge1.getNormalized();
-			bitangent = cross(v1.normal, tangent);
-		}
+			if (cornerGroups[triangleIndex * 3 + corner] != NoIndex)
+				continue;
+
+			const auto group = static_cast<uint32_t>(groupVertices.size());
+			const auto vertexIndex = weldedIndices[triangleIndex * 3 + corner];
+			const auto orientation = triangles[triangleIndex].orientationPreserving;
+
+			groupVertices.emplace_back(vertexIndex);
+			groupOrientations.push_back(orientation);
+
+			pendingTriangles.clear();
+			pendingTriangles.emplace_back(static_cast<uint32_t>(triangleIndex));
 
-		// Ensure this is a valid orthogonal basis
-		const auto& normalRef = v1.normal;
+			while (!pendingTriangles.empty())
+			{
+				const auto current = pendingTriangles.back();
+				pendingTriangles.pop_back();
+
+				const auto currentCorner = findCorner(current, vertexIndex);
+				const auto cornerIndex = current * 3 + currentCorner;
+
+				if (cornerGroups[cornerIndex] != NoIndex)
+					continue;
+
+				auto& currentTriangle = triangles[current];
+
+				const auto* currentGroups = &cornerGroups[current * 3];
+
+				if (currentTriangle.groupWithAny && currentGroups[0] == NoIndex && currentGroups[1] == NoIndex && currentGroups[2] == NoIndex)
+					currentTriangle.orientationPreserving = orientation;
 
-		const auto normal = cross(tangent, bitangent);
+				if (currentTriangle.orientationPreserving != orientation)
+					continue;
 
-		// If not, flip the tangent
-		if (normalRef.dot(normal) <= -Math::Epsilon<float>)
-			tangent *= -1.0f;
+				cornerGroups[cornerIndex] = group;
 
-		// Remove invalid triangles
-		if (tangent.getSquaredNorm() < 0.1f || bitangent.getSquaredNorm() < 0.1f)
+				// Both edges using the vertex
+				for (const auto edgeCorner : { cornerIndex, current * 3 + (currentCorner + 2) % 3 })
+				{
+					if (neighbours[edgeCorner] != NoIndex)
+						pendingTriangles.emplace_back(neighbours[edgeCorner]);
+				}
+			}
+		}
+	}
+
+	// Corners of triangles without valid UVs that could not join any group are on their own
+	for (size_t cornerIndex = 0; cornerIndex < cornerCount; cornerIndex++)
+	{
+		if (cornerGroups[cornerIndex] != NoIndex)
 			continue;
 
-		v1.tangent = tangent;
-		v1.bitangent = bitangent;
+		cornerGroups[cornerIndex] = static_cast<uint32_t>(groupVertices.size());
+
+		groupVertices.emplace_back(weldedIndices[cornerIndex]);
+		groupOrientations.push_back(triangles[cornerIndex / 3].orientationPreserving);
+	}
+
+	// Accumulate the projected triangle tangents, weighted by the projected corner angles
+	const auto groupCount = groupVertices.size();
+
+	std::vector<Vector3f> groupTangents(groupCount);
+
+	for (size_t cornerIndex = 0; cornerIndex < cornerCount; cornerIndex++)
+	{
+		const auto corner = cornerIndex % 3;
+		const auto* triangle = &weldedIndices[cornerIndex - corner];
+
+		const auto& normal = normals[triangle[corner]];
+		const auto& position = weldedVertices[triangle[corner]].position;
 
-		v2.tangent = tangent;
-		v2.bitangent = bitangent;
+		const auto edge1 = project(weldedVertices[triangle[(corner + 2) % 3]].position - position, normal);
+		const auto edge2 = project(weldedVertices[triangle[(corner + 1) % 3]].position - position, normal);
 
-		v3.tangent = tangent;
-		v3.bitangent = bitangent;
+		const auto angle = std::acos(std::clamp(edge1.dot(edge2), -1.0f, 1.0f));
 
-		newIndices.emplace_back(newIndex++);
-		newVertices.emplace_back(v1);
-		newIndices.emplace_back(newIndex++);
-		newVertices.emplace_back(v2);
-		newIndices.emplace_back(newIndex++);
-		newVertices.emplace_back(v3);
+		groupTangents[cornerGroups[cornerIndex]] += project(triangles[cornerIndex / 3].tangent, normal) * angle;
 	}
 
-	removeDuplicates(newVertices, newIndices);
+	// One vertex per source vertex and group
+	std::vector<StaticVertex> newVertices;
+	std::vector<uint32_t> newIndices;
+	std::unordered_map<uint64_t, uint32_t> newVertexIndices;
+
+	newVertices.reserve(vertices.size());
+	newIndices.reserve(cornerCount);
+	newVertexIndices.reserve(vertices.size());
+
+	for (size_t cornerIndex = 0; cornerIndex < cornerCount; cornerIndex++)
+	{
+		const auto sourceIndex = triangleIndices[cornerIndex];
+		const auto group = cornerGroups[cornerIndex];
+
+		const auto key = static_cast<uint64_t>(group) << 32 | sourceIndex;
+
+		const auto [it, inserted] = newVertexIndices.emplace(key, static_cast<uint32_t>(newVertices.size()));
+
+		if (inserted)
+		{
+			const auto& normal = normals[groupVertices[group]];
+
+			auto tangent = normalizeSafe(groupTangents[group]);
+
+			// No valid UVs around this vertex, take any vector orthogonal to the normal
+			if (!isNotZero(tangent))
+				tangent = (std::abs(normal.x) < 0.9f ? cross(normal, Vector3f(1.0f, 0.0f, 0.0f)) : cross(normal, Vector3f(0.0f, 1.0f, 0.0f))).getNormalized();
+
+			auto& newVertex = newVertices.emplace_back(vertices[sourceIndex]);
+			newVertex.tangent = tangent;
+			newVertex.bitangent = cross(normal, tangent) * (groupOrientations[group] ? 1.0f : -1.0f);
+		}
+
+		newIndices.emplace_back(it->second);
+	}
 
 	std::swap(vertices, newVertices);
 	std::swap(indices, newIndices);
@@ -287,30 +653,64 @@ void ModelLoader::generateTangents(std::vector<StaticVertex>& vertices, std::vec
 
 void ModelLoader::removeDuplicates(std::vector<StaticVertex>& vertices, std::vector<uint32_t>& indices)
 {
-	std::unordered_map<StaticVertex, uint32_t, DefaultStdHasher> uniqueVertices{};
+	constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+	// Open addressing table (linear probing), with a load factor below 0.5
+	size_t slotCount = 16;
+	while (slotCount < vertices.size() * 2)
+		slotCount *= 2;
+
+	const size_t slotMask = slotCount - 1;
+
+	std::vector<uint32_t> slotIndices(slotCount, InvalidIndex);
+	std::vector<uint64_t> slotHashes(slotCount);
 
 	std::vector<StaticVertex> newVertices;
-	std::vector<uint32_t> newIndices;
+	std::vector<uint32_t> remap(vertices.size());
+
+	newVertices.reserve(vertices.size());
 
-	for (auto& vertex : vertices)
+	for (size_t i = 0; i < vertices.size(); i++)
 	{
-		if (uniqueVertices.count(vertex) == 0)
-		{
-			const auto vertexIndex = static_cast<uint32_t>(newVertices.size());
+		const auto& vertex = vertices[i];
 
-			newIndices.push_back(vertexIndex);
-			newVertices.push_back(vertex);
+		const auto hash = hashVertex(vertex);
 
-			uniqueVertices[vertex] = vertexIndex;
-		}
-		else
+		size_t slot = static_cast<size_t>(hash) & slotMask;
+
+		while (true)
 		{
-			newIndices.push_back(uniqueVertices[vertex]);
+			const auto slotIndex = slotIndices[slot];
+
+			if (slotIndex == InvalidIndex)
+			{
+				const auto vertexIndex = static_cast<uint32_t>(newVertices.size());
+
+				slotIndices[slot] = vertexIndex;
+				slotHashes[slot] = hash;
+
+				newVertices.emplace_back(vertex);
+
+				remap[i] = vertexIndex;
+
+				break;
+			}
+			
+			if (slotHashes[slot] == hash && std::memcmp(&newVertices[slotIndex], &vertex, sizeof(StaticVertex)) == 0)
+			{
+				remap[i] = slotIndex;
+
+				break;
+			}
+
+			slot = (slot + 1) & slotMask;
 		}
 	}
 
+	for (auto& index : indices)
+		index = remap[index];
+
 	std::swap(vertices, newVertices);
-	std::swap(indices, newIndices);
 }
 
 Ptr<Mesh> ModelLoader::loadMesh(std::vector<StaticVertex>& vertices, std::vector<uint32_t>& indices, const Settings& settings)
@@ -326,38 +726,34 @@ Ptr<Mesh> ModelLoader::loadMesh(std::vector<StaticVertex>& vertices, std::vector
 	// Process vertices & indices
 
 	// Transform vertices if needed
-	if (settings.vertexTransformation.has_value())
+	if (settings.vertexTransformation.has_value() && !vertices.empty())
 	{
 		const auto& transform = settings.vertexTransformation.value();
 
-		for (auto& vertex : vertices)
-			vertex.position = transform.transformPosition(vertex.position);
+		transform.transformPositions(&vertices[0].position, vertices.size(), sizeof(StaticVertex));
 
 		if (hasNormal)
 		{
+			transform.transformVectors(&vertices[0].normal, vertices.size(), sizeof(StaticVertex));
+
 			for (auto& vertex : vertices)
-			{
-				vertex.normal = transform.transformVector(vertex.normal);
 				vertex.normal.normalize();
-			}
 		}
 
 		if (hasTangent)
 		{
+			transform.transformVectors(&vertices[0].tangent, vertices.size(), sizeof(StaticVertex));
+
 			for (auto& vertex : vertices)
-			{
-				vertex.tangent = transform.transformVector(vertex.tangent);
 				vertex.tangent.normalize();
-			}
 		}
 
 		if (hasBitangent)
 		{
+			transform.transformVectors(&vertices[0].bitangent, vertices.size(), sizeof(StaticVertex));
+
 			for (auto& vertex : vertices)
-			{
-				vertex.bitangent = transform.transformVector(vertex.bitangent);
 				vertex.bitangent.normalize();
-			}
 		}
 	}
 
@@ -367,92 +763,300 @@ Ptr<Mesh> ModelLoader::loadMesh(std::vector<StaticVertex>& vertices, std::vector
 			vertex.texCoords.y = 1.0f - vertex.texCoords.y;
 	}
 
+	if (settings.optimizeMesh)
+		MeshOptimizer::optimize(vertices, indices);
+
 	//-----
-	// Build staging vertex buffer
+	// LODs & meshlets
+	// Every LOD is a simplification of the previous one, sharing the same vertices, and is appended to the index buffer
+	// Meshlets are built for each LOD separately
 
-	const bool vertexBufferMappable = settings.vertexBufferUsages & BufferUsage::Map;
-	const auto vertexCount = vertices.size();
+	std::vector<MeshLod> lods;
+	std::vector<Meshlet> meshlets;
 
-	VertexBuffer::Settings vertexBufferSettings;
-	vertexBufferSettings.size = vertexCount;
-	vertexBufferSettings.vertexFormat = settings.getVertexFormat();
+	if (settings.lodCount > 1 || settings.buildMeshlets)
+	{
+		std::vector<std::vector<uint32_t>> lodIndices;
+		std::vector<float> lodErrors;
 
-	// If the buffer is mappable, the staging buffer will be the final buffer
-	if (vertexBufferMappable)
-		vertexBufferSettings.usages = settings.vertexBufferUsages;
-	// If not, create a staging buffer
-	else
-		vertexBufferSettings.usages = BufferUsage::TransferSrc | BufferUsage::Map;
+		lodIndices.emplace_back(std::move(indices));
+		lodErrors.emplace_back(0.0f);
 
-	auto stagingVertexBuffer = std::make_shared<VertexBuffer>(vertexBufferSettings);
+		for (size_t lodIndex = 1; lodIndex < settings.lodCount; lodIndex++)
+		{
+			const auto& previousIndices = lodIndices.back();
 
-	auto& dstFormat = vertexBufferSettings.vertexFormat;
-	auto dstData = stagingVertexBuffer->map();
+			const auto targetTriangleCount = static_cast<size_t>(static_cast<float>(previousIndices.size() / 3) * settings.lodTriangleRatio);
 
-	MemoryMapper srcMemoryMapper(vertices.data(), 0, sizeof(StaticVertex));
-	MemoryMapper dstMemoryMapper(dstData, 0, dstFormat.getByteSize());
+			float error;
+			auto simplifiedIndices = MeshOptimizer::simplify(vertices, previousIndices, targetTriangleCount * 3, std::numeric_limits<float>::max(), error);
+
+			// The mesh can't be simplified enough anymore (mostly made of borders & seams)
+			if (simplifiedIndices.empty() || static_cast<float>(simplifiedIndices.size()) > static_cast<float>(previousIndices.size()) * MaxLodIndexRatio)
+				break;
+
+			if (settings.optimizeMesh)
+				MeshOptimizer::optimizeVertexCache(simplifiedIndices, vertices.size());
+
+			// Each LOD is simplified from the previous one, so the errors add up
+			lodErrors.emplace_back(lodErrors.back() + error);
+			lodIndices.emplace_back(std::move(simplifiedIndices));
+		}
+
+		indices.clear();
+
+		for (size_t lodIndex = 0; lodIndex < lodIndices.size(); lodIndex++)
+		{
+			auto& currentIndices = lodIndices[lodIndex];
+
+			MeshLod lod;
+			lod.firstIndex = static_cast<uint32_t>(indices.size());
+			lod.indexCount = static_cast<uint32_t>(currentIndices.size());
+			lod.error = lodErrors[lodIndex];
+
+			if (settings.buildMeshlets)
+			{
+				auto lodMeshlets = MeshOptimizer::buildMeshlets(vertices, currentIndices);
 
-	copyComponent(
-		format.getComponent(VertexComponentType::Position).format,
-		srcMemoryMapper, offsetof(StaticVertex, position),
-		dstMemoryMapper, dstFormat.getComponent(VertexComponentType::Position).getByteOffset(),
-		vertexCount, 1.0);
+				for (auto& meshlet : lodMeshlets)
+					meshlet.firstIndex += lod.firstIndex;
+
+				lod.firstMeshlet = static_cast<uint32_t>(meshlets.size());
+				lod.meshletCount = static_cast<uint32_t>(lodMeshlets.size());
+
+				meshlets.insert(meshlets.end(), lodMeshlets.begin(), lodMeshlets.end());
+			}
+
+			indices.insert(indices.end(), currentIndices.begin(), currentIndices.end());
+
+			lods.emplace_back(lod);
+		}
+
+		// A single LOD is the whole mesh
+		if (lods.size() == 1)
+			lods.clear();
+
+		// Meshlets & LODs replaced the triangle order : vertices are reordered again for the fetch locality
+		if (settings.optimizeMesh)
+			MeshOptimizer::optimizeVertexFetch(vertices, indices);
+	}
+
+	//-----
+	// AABB
+	// Computed before the quantization, which modifies the positions
+
+	AABBf aabb;
+
+	for (const auto& vertex : vertices)
+		aabb.extend(vertex.position);
+
+	//-----
+	// Texture coordinates density
+	// Ratio between the UV area & the surface area of the first LOD, used to estimate the texture resolution an object needs
+
+	float texCoordsDensity = 0.0f;
 
 	if (hasTexCoords)
 	{
-		copyComponent(
-			format.getComponent(VertexComponentType::TexCoords).format,
-			srcMemoryMapper, offsetof(StaticVertex, texCoords),
-			dstMemoryMapper, dstFormat.getComponent(VertexComponentType::TexCoords).getByteOffset(),
-			vertexCount);
+		const size_t lodIndexCount = lods.empty() ? indices.size() : lods[0].indexCount;
+
+		float area = 0.0f;
+		float texCoordsArea = 0.0f;
+
+		for (size_t i = 0; i + 2 < lodIndexCount; i += 3)
+		{
+			const auto& v0 = vertices[indices[i + 0]];
+			const auto& v1 = vertices[indices[i + 1]];
+			const auto& v2 = vertices[indices[i + 2]];
+
+			area += cross(v1.position - v0.position, v2.position - v0.position).getNorm();
+
+			const auto uv1 = v1.texCoords - v0.texCoords;
+			const auto uv2 = v2.texCoords - v0.texCoords;
+
+			texCoordsArea += std::abs(uv1.x * uv2.y - uv1.y * uv2.x);
+		}
+
+		if (area > 0.0f && texCoordsArea > 0.0f)
+			texCoordsDensity = std::sqrt(texCoordsArea / area);
 	}
 
-	if (hasNormal)
+	//-----
+	// Quantization
+	// Components stored as normalized integers are encoded in place, in the range of their format
+
+	VertexQuantization quantization;
+
+	const auto& positionComponent = format.getComponent(VertexComponentType::Position);
+
+	if (positionComponent.isNormalized() && !vertices.empty())
 	{
-		copyComponent(
-			format.getComponent(VertexComponentType::Normal).format,
-			srcMemoryMapper, offsetof(StaticVertex, normal),
-			dstMemoryMapper, dstFormat.getComponent(VertexComponentType::Normal).getByteOffset(),
-			vertexCount);
+		// Uniform scale around the AABB center, so normals & tangents stay valid once dequantized
+		const auto halfSize = (aabb.max - aabb.min) / 2.0f;
+		const auto maxHalfSize = std::max({ halfSize.x, halfSize.y, halfSize.z });
+
+		quantization.positionOffset = (aabb.min + aabb.max) / 2.0f;
+		quantization.positionScale = maxHalfSize > 0.0f ? maxHalfSize : 1.0f;
+
+		for (auto& vertex : vertices)
+			vertex.position = (vertex.position - quantization.positionOffset) / quantization.positionScale;
 	}
 
-	if (hasTangent)
+	if (hasTexCoords && format.getComponent(VertexComponentType::TexCoords).isNormalized() && !vertices.empty())
 	{
-		copyComponent(
-			format.getComponent(VertexComponentType::Tangent).format,
-			srcMemoryMapper, offsetof(StaticVertex, tangent),
-			dstMemoryMapper, dstFormat.getComponent(VertexComponentType::Tangent).getByteOffset(),
-			vertexCount);
+		Vector2f min = vertices[0].texCoords;
+		Vector2f max = vertices[0].texCoords;
+
+		for (const auto& vertex : vertices)
+		{
+			for (size_t i = 0; i < 2; i++)
+			{
+				min[i] = std::min(min[i], vertex.texCoords[i]);
+				max[i] = std::max(max[i], vertex.texCoords[i]);
+			}
+		}
+
+		// Unsigned formats store [0,1], signed formats store [-1,1]
+		const float low = isSignedNormalized(format.getComponent(VertexComponentType::TexCoords).format) ? -1.0f : 0.0f;
+
+		for (size_t i = 0; i < 2; i++)
+		{
+			const float range = max[i] - min[i];
+
+			quantization.texCoordsScale[i] = range > 0.0f ? range / (1.0f - low) : 1.0f;
+			quantization.texCoordsOffset[i] = min[i] - low * quantization.texCoordsScale[i];
+		}
+
+		for (auto& vertex : vertices)
+		{
+			for (size_t i = 0; i < 2; i++)
+				vertex.texCoords[i] = (vertex.texCoords[i] - quantization.texCoordsOffset[i]) / quantization.texCoordsScale[i];
+		}
 	}
 
-	if (hasBitangent)
+	// The tangent sign is computed from the original normal, so the tangent is encoded first
+	// XY : octahedral tangent, Z : bitangent sign (bitangent = sign * cross(normal, tangent))
+	if (hasTangent && format.getComponent(VertexComponentType::Tangent).isNormalized())
 	{
-		copyComponent(
-			format.getComponent(VertexComponentType::Bitangent).format,
-			srcMemoryMapper, offsetof(StaticVertex, bitangent),
-			dstMemoryMapper, dstFormat.getComponent(VertexComponentType::Bitangent).getByteOffset(),
-			vertexCount);
+		for (auto& vertex : vertices)
+		{
+			const float sign = cross(vertex.normal, vertex.tangent).dot(vertex.bitangent) < 0.0f ? -1.0f : 1.0f;
+			const auto encoded = encodeOctahedral(vertex.tangent);
+
+			vertex.tangent = { encoded.x, encoded.y, sign };
+		}
 	}
 
-	stagingVertexBuffer->unmap();
+	// XY : octahedral normal
+	if (hasNormal && format.getComponent(VertexComponentType::Normal).isNormalized())
+	{
+		for (auto& vertex : vertices)
+		{
+			const auto encoded = encodeOctahedral(vertex.normal);
+
+			vertex.normal = { encoded.x, encoded.y, 0.0f };
+		}
+	}
 
 	//-----
-	// Build staging index buffer
+	// Pack vertices & indices in their final layout
+	// Components are scattered, so this is done in system memory : staging memory may be write-combined and is only written sequentially
 
-	const bool indexBufferMappable = settings.indexBufferUsages & BufferUsage::Map;
+	MeshData localMeshData;
+	auto& meshData = settings.meshData ? settings.meshData->emplace_back() : localMeshData;
 
-	IndexBuffer::Settings indexBufferSettings;
-	indexBufferSettings.size = indices.size();
+	const auto vertexCount = vertices.size();
+
+	meshData.vertices.resize(vertexCount * format.getByteSize());
+	meshData.quantization = quantization;
+	meshData.meshlets = std::move(meshlets);
+	meshData.lods = std::move(lods);
+	meshData.texCoordsDensity = texCoordsDensity;
+
+	MemoryMapper srcMemoryMapper(vertices.data(), 0, sizeof(StaticVertex));
+	MemoryMapper dstMemoryMapper(meshData.vertices.data(), 0, format.getByteSize());
+
+	copyComponent(positionComponent, srcMemoryMapper, offsetof(StaticVertex, position), 3, dstMemoryMapper, vertexCount, 1.0f);
+
+	if (hasTexCoords)
+		copyComponent(format.getComponent(VertexComponentType::TexCoords), srcMemoryMapper, offsetof(StaticVertex, texCoords), 2, dstMemoryMapper, vertexCount);
+
+	if (hasNormal)
+		copyComponent(format.getComponent(VertexComponentType::Normal), srcMemoryMapper, offsetof(StaticVertex, normal), 3, dstMemoryMapper, vertexCount);
+
+	if (hasTangent)
+		copyComponent(format.getComponent(VertexComponentType::Tangent), srcMemoryMapper, offsetof(StaticVertex, tangent), 3, dstMemoryMapper, vertexCount);
+
+	if (hasBitangent)
+		copyComponent(format.getComponent(VertexComponentType::Bitangent), srcMemoryMapper, offsetof(StaticVertex, bitangent), 3, dstMemoryMapper, vertexCount);
 
 	// Index type defaulted to the smaller integer size
-	indexBufferSettings.indexType = IndexType::U16;
+	meshData.indexType = IndexType::U16;
 
 	// If the user specified an index type, take this one
 	if (settings.indexType.has_value())
-		indexBufferSettings.indexType = settings.indexType.value();
+		meshData.indexType = settings.indexType.value();
 	// The user didn't specify any type, ensure U16 is enough to index vertices, if not, take U32
-	else if (vertices.size() >= std::numeric_limits<uint16_t>::max())
-		indexBufferSettings.indexType = IndexType::U32;
+	else if (vertexCount >= std::numeric_limits<uint16_t>::max())
+		meshData.indexType = IndexType::U32;
+
+	if (meshData.indexType == IndexType::U32)
+	{
+		meshData.indices.resize(indices.size() * sizeof(uint32_t));
+
+		memcpy(meshData.indices.data(), indices.data(), meshData.indices.size());
+	}
+	else
+	{
+		meshData.indices.resize(indices.size() * sizeof(uint16_t));
+
+		MemoryMapper mapper(meshData.indices.data(), 0, sizeof(uint16_t));
+
+		for (size_t i = 0; i < indices.size(); i++)
+			mapper.map<uint16_t>(i) = static_cast<uint16_t>(indices[i]);
+	}
+
+	auto mesh = loadMesh(meshData.vertices.data(), vertexCount, meshData.indices.data(), indices.size(), meshData.indexType, aabb, quantization, settings);
+
+	mesh->setMeshlets(meshData.meshlets);
+	mesh->setLods(meshData.lods);
+	mesh->setTexCoordsDensity(meshData.texCoordsDensity);
+
+	return mesh;
+}
+
+Ptr<Mesh> ModelLoader::loadMesh(const void* vertexData, size_t vertexCount, const void* indexData, size_t indexCount, IndexType indexType, const AABBf& aabb, const VertexQuantization& quantization, const Settings& settings)
+{
+	//-----
+	// Build staging vertex buffer
+
+	const bool vertexBufferMappable = settings.vertexBufferUsages & BufferUsage::Map;
+
+	VertexBuffer::Settings vertexBufferSettings;
+	vertexBufferSettings.size = vertexCount;
+	vertexBufferSettings.vertexFormat = settings.getVertexFormat();
+
+	// If the buffer is mappable, the staging buffer will be the final buffer
+	if (vertexBufferMappable)
+		vertexBufferSettings.usages = settings.vertexBufferUsages;
+	// If not, create a staging buffer
+	else
+		vertexBufferSettings.usages = BufferUsage::TransferSrc | BufferUsage::Map;
+
+	auto stagingVertexBuffer = std::make_shared<VertexBuffer>(vertexBufferSettings);
+
+	memcpy(stagingVertexBuffer->map(), vertexData, stagingVertexBuffer->getByteSize());
+
+	stagingVertexBuffer->unmap();
+
+	//-----
+	// Build staging index buffer
+
+	const bool indexBufferMappable = settings.indexBufferUsages & BufferUsage::Map;
+
+	IndexBuffer::Settings indexBufferSettings;
+	indexBufferSettings.size = indexCount;
+	indexBufferSettings.indexType = indexType;
 
 	// If the buffer is mappable, the staging buffer will be the final buffer
 	if (indexBufferMappable)
@@ -463,19 +1067,7 @@ Ptr<Mesh> ModelLoader::loadMesh(std::vector<StaticVertex>& vertices, std::vector
 
 	auto stagingIndexBuffer = std::make_shared<IndexBuffer>(indexBufferSettings);
 
-	auto bufferData = stagingIndexBuffer->map();
-
-	if (indexBufferSettings.indexType == IndexType::U32)
-	{
-		memcpy(bufferData, indices.data(), indices.size() * sizeof(uint32_t));
-	}
-	else
-	{
-		MemoryMapper mapper(bufferData, 0, sizeof(uint16_t));
-
-		for (size_t i = 0; i < indices.size(); i++)
-			mapper.map<uint16_t>(i) = static_cast<uint16_t>(indices[i]);
-	}
+	memcpy(stagingIndexBuffer->map(), indexData, stagingIndexBuffer->getByteSize());
 
 	stagingIndexBuffer->unmap();
 
@@ -553,14 +1145,6 @@ Ptr<Mesh> ModelLoader::loadMesh(std::vector<StaticVertex>& vertices, std::vector
 		}
 	}
 
-	//-----
-	// AABB
-
-	AABBf aabb;
-
-	for (const auto& vertex : vertices)
-		aabb.extend(vertex.position);
-
 	//-----
 	// Build mesh
 
@@ -569,6 +1153,7 @@ Ptr<Mesh> ModelLoader::loadMesh(std::vector<StaticVertex>& vertices, std::vector
 	mesh->setVertexBuffer(vertexBuffer);
 	mesh->setIndexBuffer(indexBuffer);
 	mesh->setAABB(aabb);
+	mesh->setVertexQuantization(quantization);
 
 	return mesh;
 }
@@ -20,10 +20,12 @@
 */
 
 #include <Atema/Graphics/Loaders/ObjLoader.hpp>
+#include <Atema/Core/TaskManager.hpp>
 #include <Atema/Graphics/Graphics.hpp>
 #include <Atema/Graphics/MaterialData.hpp>
 #include <Atema/Graphics/Mesh.hpp>
 #include <Atema/Graphics/Model.hpp>
+#include <Atema/Graphics/Loaders/MeshOptimizer.hpp>
 #include <Atema/Graphics/Loaders/ModelLoader.hpp>
 #include <Atema/Graphics/VertexFormat.hpp>
 #include <Atema/Renderer/Renderer.hpp>
@@ -72,6 +74,9 @@ Ptr<Model> ObjLoader::load(const std::filesystem::path& path, const ModelLoader:
 	if (newSettings.vertexTransformation.has_value())
 		newSettings.vertexTransformation.reset();
 
+	// Meshes are optimized in parallel below
+	newSettings.optimizeMesh = false;
+
 	// If the user didn't provide a command buffer, we will create one
 	// This way we can use it to load all the meshes at once
 	std::list<Ptr<Buffer>> stagingBuffers;
@@ -139,19 +144,36 @@ Ptr<Model> ObjLoader::load(const std::filesystem::path& path, const ModelLoader:
 		}
 	}
 
+	// Quantized vertices must be decoded by the shaders (see DefaultMaterials)
+	if (format.getComponent(VertexComponentType::Position).isNormalized())
+	{
+		for (auto& materialData : model->getMaterialData())
+			materialData->set(MaterialData::QuantizedVertex, 1u);
+	}
+
 	// Load meshes
 	const bool hasNormal = format.hasComponent(VertexComponentType::Normal);
 	const bool hasTangent = format.hasComponent(VertexComponentType::Tangent);
 	const bool hasBitangent = format.hasComponent(VertexComponentType::Bitangent);
 
+	// Split each shape into meshes (one per material)
+	struct MeshRange
+	{
+		const tinyobj::shape_t* shape;
+		size_t firstIndex;
+		size_t vertexCount;
+		size_t materialID;
+	};
+
+	std::vector<MeshRange> meshRanges;
+
 	for (const auto& shape : shapes)
 	{
 		size_t currentVertexCount = 0;
 		// If the material is not defined we'll consider the first one by default
 		int currentMaterialID = shape.mesh.material_ids[0] == -1 ? 0 : shape.mesh.material_ids[0];
 
-		std::vector<size_t> meshVertexCounts;
-		std::vector<size_t> meshMaterialIDs;
+		size_t firstIndex = 0;
 
 		for (size_t i = 0; i < shape.mesh.material_ids.size(); i++)
 		{
@@ -160,8 +182,9 @@ Ptr<Model> ObjLoader::load(const std::filesystem::path& path, const ModelLoader:
 
 			if (materialID != currentMaterialID)
 			{
-				meshVertexCounts.emplace_back(currentVertexCount);
-				meshMaterialIDs.emplace_back(currentMaterialID);
+				meshRanges.push_back({ &shape, firstIndex, currentVertexCount, static_cast<size_t>(currentMaterialID) });
+
+				firstIndex += currentVertexCount;
 
 				currentMaterialID = materialID;
 				currentVertexCount = 0;
@@ -170,26 +193,31 @@ Ptr<Model> ObjLoader::load(const std::filesystem::path& path, const ModelLoader:
 			currentVertexCount += 3;
 		}
 
-		meshVertexCounts.emplace_back(currentVertexCount);
-		meshMaterialIDs.emplace_back(currentMaterialID);
+		meshRanges.push_back({ &shape, firstIndex, currentVertexCount, static_cast<size_t>(currentMaterialID) });
+	}
 
-		size_t firstIndex = 0;
-		for (size_t m = 0; m < meshVertexCounts.size(); m++)
+	// Process the meshes in parallel (deduplication & tangents generation are the most expensive steps)
+	std::vector<std::vector<ModelLoader::StaticVertex>> meshVertices(meshRanges.size());
+	std::vector<std::vector<uint32_t>> meshIndices(meshRanges.size());
+
+	TaskManager::instance().parallelFor(meshRanges.size(), [&](size_t meshIndex)
 		{
-			const size_t vertexCount = meshVertexCounts[m];
-			const auto materialID = meshMaterialIDs[m];
+			const auto& meshRange = meshRanges[meshIndex];
+			const auto& shape = *meshRange.shape;
+			const auto vertexCount = meshRange.vertexCount;
 
-			std::vector<ModelLoader::StaticVertex> vertices;
+			auto& vertices = meshVertices[meshIndex];
 			vertices.reserve(vertexCount);
 
 			// Generate identity index data
-			std::vector<uint32_t> indices(vertexCount);
+			auto& indices = meshIndices[meshIndex];
+			indices.resize(vertexCount);
 			for (uint32_t i = 0; i < vertexCount; i++)
 				indices[i] = i;
 
 			// Generate vertex data
-			const auto lastIndex = firstIndex + vertexCount;
-			for (size_t i = firstIndex; i < lastIndex; i++)
+			const auto lastIndex = meshRange.firstIndex + vertexCount;
+			for (size_t i = meshRange.firstIndex; i < lastIndex; i++)
 			{
 				const auto& index = shape.mesh.indices[i];
 				auto& vertex = vertices.emplace_back();
@@ -228,37 +256,43 @@ Ptr<Model> ObjLoader::load(const std::filesystem::path& path, const ModelLoader:
 			// We will generate tangents & bitangents from position
 			// So there is no need to make the ModelLoader to transform everything later
 			// Just transform the basic data so everything will be correctly computed
-			if (settings.vertexTransformation.has_value())
+			if (settings.vertexTransformation.has_value() && !vertices.empty())
 			{
 				const auto& transform = settings.vertexTransformation.value();
 
-				for (auto& vertex : vertices)
-					vertex.position = transform.transformPosition(vertex.position);
+				transform.transformPositions(&vertices[0].position, vertices.size(), sizeof(ModelLoader::StaticVertex));
 
 				if (hasNormal)
 				{
+					transform.transformVectors(&vertices[0].normal, vertices.size(), sizeof(ModelLoader::StaticVertex));
+
 					for (auto& vertex : vertices)
-					{
-						vertex.normal = transform.transformVector(vertex.normal);
 						vertex.normal.normalize();
-					}
 				}
 			}
-			
-			// Generate tangeants & bitangeants if needed
+
+			// Ensure there are no duplicate vertices
+			ModelLoader::removeDuplicates(vertices, indices);
+
+			// Generate tangeants & bitangeants on the indexed mesh if needed
 			if (hasTangent || hasBitangent)
 				ModelLoader::generateTangents(vertices, indices);
-			// Otherwise, just ensure there are no duplicate vertices
-			else
-				ModelLoader::removeDuplicates(vertices, indices);
-			
-			auto mesh = ModelLoader::loadMesh(vertices, indices, newSettings);
-			mesh->setMaterialID(materialID);
 
-			model->addMesh(std::move(mesh));
+			if (settings.optimizeMesh)
+				MeshOptimizer::optimize(vertices, indices);
+		});
 
-			firstIndex += vertexCount;
-		}
+	// Meshes are recorded in the command buffer sequentially
+	for (size_t meshIndex = 0; meshIndex < meshRanges.size(); meshIndex++)
+	{
+		auto mesh = ModelLoader::loadMesh(meshVertices[meshIndex], meshIndices[meshIndex], newSettings);
+		mesh->setMaterialID(meshRanges[meshIndex].materialID);
+
+		model->addMesh(std::move(mesh));
+
+		// Release the memory as soon as possible
+		meshVertices[meshIndex] = {};
+		meshIndices[meshIndex] = {};
 	}
 
 	if (!settings.commandBuffer)
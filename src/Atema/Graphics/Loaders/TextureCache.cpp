@@ -0,0 +1,201 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Graphics/Loaders/TextureCache.hpp>
+#include <Atema/Core/Error.hpp>
+#include <Atema/Renderer/Utils.hpp>
+
+#include <fstream>
+#include <sstream>
+
+using namespace at;
+
+namespace
+{
+	// Stable across platforms, unlike the default hash
+	using FileHasher = Hasher<FNV1a<Hash64>>;
+
+	constexpr uint32_t FileMagic = 0x58455441; // 'ATEX'
+	constexpr uint32_t FileVersion = 1;
+
+	// Size of the chunks read to hash the source file
+	constexpr size_t HashChunkSize = 1 << 20;
+
+	// Followed by every mip level, one after the other
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		Hash64 key;
+		uint32_t format;
+		uint32_t width;
+		uint32_t height;
+		uint32_t mipLevels;
+	};
+
+	// Fills the offsets of the levels and returns the total byte size
+	size_t getMipOffsets(const FileHeader& header, std::vector<size_t>& mipOffsets)
+	{
+		const auto format = static_cast<ImageFormat>(header.format);
+
+		size_t byteSize = 0;
+
+		mipOffsets.resize(header.mipLevels);
+
+		for (uint32_t mipLevel = 0; mipLevel < header.mipLevels; mipLevel++)
+		{
+			mipOffsets[mipLevel] = byteSize;
+
+			byteSize += getByteSize(format, std::max(header.width >> mipLevel, 1u), std::max(header.height >> mipLevel, 1u));
+		}
+
+		return byteSize;
+	}
+
+	bool readHeader(std::ifstream& file, Hash64 key, FileHeader& fileHeader)
+	{
+		if (!file.is_open())
+			return false;
+
+		if (!file.read(reinterpret_cast<char*>(&fileHeader), sizeof(FileHeader)))
+			return false;
+
+		if (fileHeader.magic != FileMagic || fileHeader.version != FileVersion || fileHeader.key != key)
+			return false;
+
+		return fileHeader.format < static_cast<uint32_t>(ImageFormat::_COUNT) && fileHeader.width > 0 && fileHeader.height > 0 && fileHeader.mipLevels > 0;
+	}
+}
+
+Hash64 TextureCache::getKey(const std::filesystem::path& sourcePath, ImageLoader::Compression compression, const ImageLoader::Settings& settings)
+{
+	std::ifstream file(sourcePath, std::ios::binary);
+
+	if (!file.is_open())
+		ATEMA_ERROR("Failed to open file '" + sourcePath.string() + "'");
+
+	Hash64 key = 0;
+
+	// Hash the file content by chunks, to avoid loading big images at once
+	std::vector<char> chunk(HashChunkSize);
+
+	while (file)
+	{
+		file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+
+		const auto readSize = static_cast<size_t>(file.gcount());
+
+		if (readSize > 0)
+			FileHasher::hashCombine(key, FileHasher::hash(chunk.data(), readSize));
+	}
+
+	FileHasher::hashCombine(key, static_cast<uint32_t>(compression), settings.mipLevels, static_cast<uint32_t>(settings.mipFilter), settings.srgb);
+
+	return key;
+}
+
+std::filesystem::path TextureCache::getPath(const std::filesystem::path& cacheDirectory, const std::filesystem::path& sourcePath)
+{
+	// Textures from different directories often share the same name
+	std::ostringstream fileName;
+	fileName << sourcePath.stem().string() << "_" << std::hex << FileHasher::hash(sourcePath.lexically_normal().u8string()) << ".attex";
+
+	return cacheDirectory / fileName.str();
+}
+
+void TextureCache::save(const std::filesystem::path& path, Hash64 key, const ImageLoader::MipChain& mipChain)
+{
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path());
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+		ATEMA_ERROR("Failed to open file '" + path.string() + "'");
+
+	FileHeader fileHeader;
+	fileHeader.magic = FileMagic;
+	fileHeader.version = FileVersion;
+	fileHeader.key = key;
+	fileHeader.format = static_cast<uint32_t>(mipChain.format);
+	fileHeader.width = mipChain.width;
+	fileHeader.height = mipChain.height;
+	fileHeader.mipLevels = static_cast<uint32_t>(mipChain.mipOffsets.size());
+
+	file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(FileHeader));
+
+	file.write(reinterpret_cast<const char*>(mipChain.data.data()), static_cast<std::streamsize>(mipChain.data.size()));
+
+	if (!file)
+		ATEMA_ERROR("Failed to write file '" + path.string() + "'");
+}
+
+bool TextureCache::loadInfo(const std::filesystem::path& path, Hash64 key, Info& info)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	FileHeader fileHeader;
+
+	if (!readHeader(file, key, fileHeader))
+		return false;
+
+	info.format = static_cast<ImageFormat>(fileHeader.format);
+	info.width = fileHeader.width;
+	info.height = fileHeader.height;
+	info.mipLevels = fileHeader.mipLevels;
+
+	return true;
+}
+
+bool TextureCache::load(const std::filesystem::path& path, Hash64 key, ImageLoader::MipChain& mipChain, uint32_t firstMipLevel)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	FileHeader fileHeader;
+
+	if (!readHeader(file, key, fileHeader) || firstMipLevel >= fileHeader.mipLevels)
+		return false;
+
+	std::vector<size_t> mipOffsets;
+	const auto byteSize = getMipOffsets(fileHeader, mipOffsets);
+
+	// Skip the levels before firstMipLevel
+	const auto firstOffset = mipOffsets[firstMipLevel];
+
+	if (firstOffset > 0 && !file.seekg(static_cast<std::streamoff>(firstOffset), std::ios::cur))
+		return false;
+
+	ImageLoader::MipChain newMipChain;
+	newMipChain.format = static_cast<ImageFormat>(fileHeader.format);
+	newMipChain.width = std::max(fileHeader.width >> firstMipLevel, 1u);
+	newMipChain.height = std::max(fileHeader.height >> firstMipLevel, 1u);
+	newMipChain.data.resize(byteSize - firstOffset);
+
+	for (uint32_t mipLevel = firstMipLevel; mipLevel < fileHeader.mipLevels; mipLevel++)
+		newMipChain.mipOffsets.emplace_back(mipOffsets[mipLevel] - firstOffset);
+
+	if (!file.read(reinterpret_cast<char*>(newMipChain.data.data()), static_cast<std::streamsize>(newMipChain.data.size())))
+		return false;
+
+	mipChain = std::move(newMipChain);
+
+	return true;
+}
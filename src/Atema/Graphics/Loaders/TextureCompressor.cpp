@@ -0,0 +1,924 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Graphics/Loaders/TextureCompressor.hpp>
+#include <Atema/Core/Error.hpp>
+#include <Atema/Core/TaskManager.hpp>
+#include <Atema/Math/Math.hpp>
+#include <Atema/Math/Simd.hpp>
+#include <Atema/Renderer/Utils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace at;
+
+namespace
+{
+	constexpr uint32_t BlockSize = 4;
+	constexpr size_t BlockPixelCount = BlockSize * BlockSize;
+
+	// Pixels of a 4x4 block, always expanded to RGBA
+	using Block = std::array<std::array<uint8_t, 4>, BlockPixelCount>;
+
+	// Power iterations used to find the principal axis of a block
+	constexpr size_t AxisIterationCount = 8;
+
+	// BC7 interpolation weights of 4 bit indices
+	constexpr std::array<uint32_t, 16> BC7Weights = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	size_t getChannelCount(ImageLoader::Format format)
+	{
+		return static_cast<size_t>(format) + 1;
+	}
+
+	// Writes bits from the least significant one, like the BC7 layout expects
+	struct BitWriter
+	{
+		uint8_t* data;
+		size_t position = 0;
+
+		void write(uint32_t value, size_t bitCount)
+		{
+			for (size_t i = 0; i < bitCount; i++, position++)
+			{
+				if ((value >> i) & 1)
+					data[position / 8] |= static_cast<uint8_t>(1 << (position % 8));
+			}
+		}
+	};
+
+	// Fits a segment on the first N channels of the block, along the principal axis of the pixels
+	// The segment is slightly inset : the extreme pixels are rarer than the ones in the middle
+	template <size_t N>
+	void fitEndpoints(const Block& block, std::array<float, N>& endpoint0, std::array<float, N>& endpoint1)
+	{
+		std::array<float, N> mean{};
+		std::array<float, N> minValue;
+		std::array<float, N> maxValue;
+
+		minValue.fill(255.0f);
+		maxValue.fill(0.0f);
+
+		for (const auto& pixel : block)
+		{
+			for (size_t c = 0; c < N; c++)
+			{
+				const auto value = static_cast<float>(pixel[c]);
+
+				mean[c] += value;
+				minValue[c] = std::min(minValue[c], value);
+				maxValue[c] = std::max(maxValue[c], value);
+			}
+		}
+
+		for (auto& value : mean)
+			value /= static_cast<float>(BlockPixelCount);
+
+		std::array<std::array<float, N>, N> covariance{};
+
+		for (const auto& pixel : block)
+		{
+			std::array<float, N> delta;
+			for (size_t c = 0; c < N; c++)
+				delta[c] = static_cast<float>(pixel[c]) - mean[c];
+
+			for (size_t i = 0; i < N; i++)
+			{
+				for (size_t j = 0; j < N; j++)
+					covariance[i][j] += delta[i] * delta[j];
+			}
+		}
+
+		// Power iteration, starting from the bounding box diagonal
+		std::array<float, N> axis;
+		for (size_t c = 0; c < N; c++)
+			axis[c] = maxValue[c] - minValue[c];
+
+		for (size_t iteration = 0; iteration < AxisIterationCount; iteration++)
+		{
+			std::array<float, N> nextAxis{};
+			float maxComponent = 0.0f;
+
+			for (size_t i = 0; i < N; i++)
+			{
+				for (size_t j = 0; j < N; j++)
+					nextAxis[i] += covariance[i][j] * axis[j];
+
+				maxComponent = std::max(maxComponent, std::abs(nextAxis[i]));
+			}
+
+			if (maxComponent <= 0.0f)
+				break;
+
+			for (size_t i = 0; i < N; i++)
+				axis[i] = nextAxis[i] / maxComponent;
+		}
+
+		float squaredNorm = 0.0f;
+		for (const auto& value : axis)
+			squaredNorm += value * value;
+
+		// Uniform block
+		if (squaredNorm <= 0.0f)
+		{
+			endpoint0 = mean;
+			endpoint1 = mean;
+			return;
+		}
+
+		const auto norm = std::sqrt(squaredNorm);
+		for (auto& value : axis)
+			value /= norm;
+
+		float minT = 0.0f;
+		float maxT = 0.0f;
+
+		for (const auto& pixel : block)
+		{
+			float t = 0.0f;
+			for (size_t c = 0; c < N; c++)
+				t += (static_cast<float>(pixel[c]) - mean[c]) * axis[c];
+
+			minT = std::min(minT, t);
+			maxT = std::max(maxT, t);
+		}
+
+		const auto inset = (maxT - minT) / 16.0f;
+		minT += inset;
+		maxT -= inset;
+
+		for (size_t c = 0; c < N; c++)
+		{
+			endpoint0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+			endpoint1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+		}
+	}
+
+	uint16_t packRGB565(const std::array<float, 3>& color)
+	{
+		const auto r = static_cast<uint16_t>(std::round(color[0] * 31.0f / 255.0f));
+		const auto g = static_cast<uint16_t>(std::round(color[1] * 63.0f / 255.0f));
+		const auto b = static_cast<uint16_t>(std::round(color[2] * 31.0f / 255.0f));
+
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	std::array<int, 3> unpackRGB565(uint16_t color)
+	{
+		const int r = (color >> 11) & 31;
+		const int g = (color >> 5) & 63;
+		const int b = color & 31;
+
+		return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+	}
+
+	// BC1 color block, always in the 4 color mode (also used by BC3)
+	void encodeColorBlock(const Block& block, uint8_t* output)
+	{
+		std::array<float, 3> endpoint0;
+		std::array<float, 3> endpoint1;
+		fitEndpoints<3>(block, endpoint0, endpoint1);
+
+		auto color0 = packRGB565(endpoint0);
+		auto color1 = packRGB565(endpoint1);
+
+		// color0 > color1 selects the 4 color mode
+		if (color0 < color1)
+			std::swap(color0, color1);
+
+		uint32_t indices = 0;
+
+		// Equal colors : every index is 0
+		if (color0 != color1)
+		{
+			const auto c0 = unpackRGB565(color0);
+			const auto c1 = unpackRGB565(color1);
+
+			std::array<std::array<int, 3>, 4> palette;
+			for (size_t c = 0; c < 3; c++)
+			{
+				palette[0][c] = c0[c];
+				palette[1][c] = c1[c];
+				palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+				palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+			}
+
+			for (size_t i = 0; i < BlockPixelCount; i++)
+			{
+				uint32_t bestIndex = 0;
+				int bestError = std::numeric_limits<int>::max();
+
+				for (uint32_t index = 0; index < 4; index++)
+				{
+					int error = 0;
+					for (size_t c = 0; c < 3; c++)
+					{
+						const int delta = static_cast<int>(block[i][c]) - palette[index][c];
+						error += delta * delta;
+					}
+
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = index;
+					}
+				}
+
+				indices |= bestIndex << (2 * i);
+			}
+		}
+
+		output[0] = static_cast<uint8_t>(color0 & 0xFF);
+		output[1] = static_cast<uint8_t>(color0 >> 8);
+		output[2] = static_cast<uint8_t>(color1 & 0xFF);
+		output[3] = static_cast<uint8_t>(color1 >> 8);
+
+		for (size_t i = 0; i < 4; i++)
+			output[4 + i] = static_cast<uint8_t>((indices >> (8 * i)) & 0xFF);
+	}
+
+	// BC4 block of one channel, in the 8 value mode (also used by BC3 & BC5)
+	void encodeChannelBlock(const Block& block, size_t channel, uint8_t* output)
+	{
+		int minValue = 255;
+		int maxValue = 0;
+
+		for (const auto& pixel : block)
+		{
+			minValue = std::min(minValue, static_cast<int>(pixel[channel]));
+			maxValue = std::max(maxValue, static_cast<int>(pixel[channel]));
+		}
+
+		output[0] = static_cast<uint8_t>(maxValue);
+		output[1] = static_cast<uint8_t>(minValue);
+
+		uint64_t indices = 0;
+
+		// Equal values : every index is 0
+		if (maxValue > minValue)
+		{
+			std::array<int, 8> palette;
+			palette[0] = maxValue;
+			palette[1] = minValue;
+
+			for (int i = 2; i < 8; i++)
+				palette[i] = ((8 - i) * maxValue + (i - 1) * minValue) / 7;
+
+			for (size_t i = 0; i < BlockPixelCount; i++)
+			{
+				uint64_t bestIndex = 0;
+				int bestError = std::numeric_limits<int>::max();
+
+				for (uint64_t index = 0; index < 8; index++)
+				{
+					const int error = std::abs(static_cast<int>(block[i][channel]) - palette[index]);
+
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = index;
+					}
+				}
+
+				indices |= bestIndex << (3 * i);
+			}
+		}
+
+		for (size_t i = 0; i < 6; i++)
+			output[2 + i] = static_cast<uint8_t>((indices >> (8 * i)) & 0xFF);
+	}
+
+	// 7 bit endpoint with a p-bit shared by its channels, keeping the p-bit with the smallest error
+	void quantizeBC7Endpoint(const std::array<float, 4>& endpoint, std::array<uint32_t, 4>& quantized, uint32_t& pBit)
+	{
+		float bestError = std::numeric_limits<float>::max();
+
+		for (uint32_t p = 0; p < 2; p++)
+		{
+			std::array<uint32_t, 4> values;
+			float error = 0.0f;
+
+			for (size_t c = 0; c < 4; c++)
+			{
+				values[c] = static_cast<uint32_t>(std::clamp(std::round((endpoint[c] - static_cast<float>(p)) / 2.0f), 0.0f, 127.0f));
+
+				const auto delta = static_cast<float>((values[c] << 1) | p) - endpoint[c];
+				error += delta * delta;
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				quantized = values;
+				pBit = p;
+			}
+		}
+	}
+
+	// BC7 block in mode 6 : a single RGBA segment with 4 bit indices
+	void encodeBC7Block(const Block& block, uint8_t* output)
+	{
+		std::array<float, 4> endpoint0;
+		std::array<float, 4> endpoint1;
+		fitEndpoints<4>(block, endpoint0, endpoint1);
+
+		std::array<uint32_t, 4> quantized0;
+		std::array<uint32_t, 4> quantized1;
+		uint32_t pBit0;
+		uint32_t pBit1;
+		quantizeBC7Endpoint(endpoint0, quantized0, pBit0);
+		quantizeBC7Endpoint(endpoint1, quantized1, pBit1);
+
+		std::array<std::array<int, 4>, 16> palette;
+		for (size_t c = 0; c < 4; c++)
+		{
+			const auto value0 = (quantized0[c] << 1) | pBit0;
+			const auto value1 = (quantized1[c] << 1) | pBit1;
+
+			for (size_t index = 0; index < 16; index++)
+				palette[index][c] = static_cast<int>(((64 - BC7Weights[index]) * value0 + BC7Weights[index] * value1 + 32) >> 6);
+		}
+
+		std::array<uint32_t, BlockPixelCount> indices;
+
+		for (size_t i = 0; i < BlockPixelCount; i++)
+		{
+			int bestError = std::numeric_limits<int>::max();
+
+			for (uint32_t index = 0; index < 16; index++)
+			{
+				int error = 0;
+				for (size_t c = 0; c < 4; c++)
+				{
+					const int delta = static_cast<int>(block[i][c]) - palette[index][c];
+					error += delta * delta;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					indices[i] = index;
+				}
+			}
+		}
+
+		// The most significant bit of the first index is implicitly 0 : swap the endpoints if needed
+		if (indices[0] & 8)
+		{
+			std::swap(quantized0, quantized1);
+			std::swap(pBit0, pBit1);
+
+			for (auto& index : indices)
+				index = 15 - index;
+		}
+
+		std::memset(output, 0, 16);
+
+		BitWriter writer{ output };
+
+		// Mode 6
+		writer.write(1 << 6, 7);
+
+		for (size_t c = 0; c < 4; c++)
+		{
+			writer.write(quantized0[c], 7);
+			writer.write(quantized1[c], 7);
+		}
+
+		writer.write(pBit0, 1);
+		writer.write(pBit1, 1);
+
+		writer.write(indices[0], 3);
+
+		for (size_t i = 1; i < BlockPixelCount; i++)
+			writer.write(indices[i], 4);
+	}
+
+	// Pixels outside of the image are clamped to the edges
+	void loadBlock(const uint8_t* pixels, uint32_t width, uint32_t height, size_t channelCount, uint32_t blockX, uint32_t blockY, Block& block)
+	{
+		for (uint32_t y = 0; y < BlockSize; y++)
+		{
+			const auto pixelY = std::min(blockY * BlockSize + y, height - 1);
+
+			for (uint32_t x = 0; x < BlockSize; x++)
+			{
+				const auto pixelX = std::min(blockX * BlockSize + x, width - 1);
+				const auto pixel = pixels + (static_cast<size_t>(pixelY) * width + pixelX) * channelCount;
+
+				auto& blockPixel = block[y * BlockSize + x];
+				blockPixel = { 0, 0, 0, 255 };
+
+				for (size_t c = 0; c < channelCount; c++)
+					blockPixel[c] = pixel[c];
+			}
+		}
+	}
+
+	void encodeLevel(const uint8_t* pixels, uint32_t width, uint32_t height, size_t channelCount, ImageFormat format, uint8_t* output)
+	{
+		const uint32_t blockCountX = (width + BlockSize - 1) / BlockSize;
+		const uint32_t blockCountY = (height + BlockSize - 1) / BlockSize;
+		const size_t blockByteSize = getBlockByteSize(format);
+
+		// Rows of blocks are independent
+		TaskManager::instance().parallelFor(blockCountY, [&](size_t blockY)
+			{
+				Block block;
+
+				for (uint32_t blockX = 0; blockX < blockCountX; blockX++)
+				{
+					loadBlock(pixels, width, height, channelCount, blockX, static_cast<uint32_t>(blockY), block);
+
+					auto blockOutput = output + (blockY * blockCountX + blockX) * blockByteSize;
+
+					switch (format)
+					{
+						case ImageFormat::BC1_RGB_UNORM:
+						{
+							encodeColorBlock(block, blockOutput);
+							break;
+						}
+						case ImageFormat::BC3_UNORM:
+						{
+							encodeChannelBlock(block, 3, blockOutput);
+							encodeColorBlock(block, blockOutput + 8);
+							break;
+						}
+						case ImageFormat::BC4_UNORM:
+						{
+							encodeChannelBlock(block, 0, blockOutput);
+							break;
+						}
+						case ImageFormat::BC5_UNORM:
+						{
+							encodeChannelBlock(block, 0, blockOutput);
+							encodeChannelBlock(block, 1, blockOutput + 8);
+							break;
+						}
+						case ImageFormat::BC7_UNORM:
+						{
+							encodeBC7Block(block, blockOutput);
+							break;
+						}
+						default:
+						{
+							ATEMA_ERROR("Unsupported compressed format");
+						}
+					}
+				}
+			});
+	}
+
+	// Support of the Kaiser filter, in destination pixels
+	constexpr float KaiserRadius = 3.0f;
+	constexpr float KaiserAlpha = 4.0f;
+
+	// Entries of the linear to sRGB table, enough for the darkest 8 bit values
+	constexpr size_t SRGBTableSize = 16384;
+
+	float srgbToLinear(float value)
+	{
+		return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	float linearToSRGB(float value)
+	{
+		return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	// Conversions between 8 bit values & [0,1] floats, decoded to linear space for sRGB channels
+	struct ChannelTables
+	{
+		std::array<float, 256> unormToFloat;
+		std::array<float, 256> srgbToFloat;
+		std::vector<uint8_t> floatToSRGB;
+
+		ChannelTables() :
+			floatToSRGB(SRGBTableSize)
+		{
+			for (size_t i = 0; i < 256; i++)
+			{
+				unormToFloat[i] = static_cast<float>(i) / 255.0f;
+				srgbToFloat[i] = srgbToLinear(unormToFloat[i]);
+			}
+
+			for (size_t i = 0; i < SRGBTableSize; i++)
+			{
+				const auto value = linearToSRGB(static_cast<float>(i) / static_cast<float>(SRGBTableSize - 1));
+
+				floatToSRGB[i] = static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+		}
+	};
+
+	const ChannelTables& getChannelTables()
+	{
+		static const ChannelTables s_tables;
+
+		return s_tables;
+	}
+
+	// Grey & grey-alpha images keep their alpha in the last channel
+	size_t getSRGBChannelCount(size_t channelCount, bool srgb)
+	{
+		if (!srgb)
+			return 0;
+
+		return channelCount == 2 ? 1 : std::min(channelCount, static_cast<size_t>(3));
+	}
+
+	// Modified Bessel function of the first kind, order 0
+	float getBesselI0(float value)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+
+		for (int i = 1; i < 16; i++)
+		{
+			const float factor = value / (2.0f * static_cast<float>(i));
+
+			term *= factor * factor;
+			sum += term;
+		}
+
+		return sum;
+	}
+
+	float getKaiserWeight(float distance)
+	{
+		if (std::abs(distance) >= KaiserRadius)
+			return 0.0f;
+
+		const float x = Math::Pi<float> * distance;
+		const float sinc = distance == 0.0f ? 1.0f : std::sin(x) / x;
+		const float t = distance / KaiserRadius;
+
+		return sinc * getBesselI0(KaiserAlpha * std::sqrt(1.0f - t * t)) / getBesselI0(KaiserAlpha);
+	}
+
+	// Source pixels (clamped to the image) & normalized weights of every destination pixel, along one axis
+	struct FilterTaps
+	{
+		size_t tapCount = 0;
+		std::vector<uint32_t> indices;
+		std::vector<float> weights;
+	};
+
+	FilterTaps getFilterTaps(ImageLoader::MipFilter mipFilter, uint32_t size, uint32_t newSize)
+	{
+		FilterTaps taps;
+
+		// Pairs of pixels, the last one of odd sizes is clamped
+		if (mipFilter == ImageLoader::MipFilter::Box)
+		{
+			taps.tapCount = 2;
+
+			for (uint32_t i = 0; i < newSize; i++)
+			{
+				taps.indices.emplace_back(std::min(2 * i, size - 1));
+				taps.indices.emplace_back(std::min(2 * i + 1, size - 1));
+				taps.weights.emplace_back(0.5f);
+				taps.weights.emplace_back(0.5f);
+			}
+
+			return taps;
+		}
+
+		// The kernel is stretched by the scale factor, to handle odd sizes
+		const float scale = static_cast<float>(size) / static_cast<float>(newSize);
+
+		taps.tapCount = static_cast<size_t>(std::ceil(2.0f * KaiserRadius * scale)) + 2;
+		taps.indices.resize(newSize * taps.tapCount);
+		taps.weights.resize(newSize * taps.tapCount);
+
+		for (uint32_t i = 0; i < newSize; i++)
+		{
+			const float center = (static_cast<float>(i) + 0.5f) * scale;
+			const auto first = static_cast<int64_t>(std::floor(center - 0.5f - KaiserRadius * scale));
+
+			auto indices = taps.indices.data() + i * taps.tapCount;
+			auto weights = taps.weights.data() + i * taps.tapCount;
+			float weightSum = 0.0f;
+
+			for (size_t tap = 0; tap < taps.tapCount; tap++)
+			{
+				const auto index = first + static_cast<int64_t>(tap);
+
+				indices[tap] = static_cast<uint32_t>(std::clamp<int64_t>(index, 0, static_cast<int64_t>(size) - 1));
+				weights[tap] = getKaiserWeight((static_cast<float>(index) + 0.5f - center) / scale);
+
+				weightSum += weights[tap];
+			}
+
+			for (size_t tap = 0; tap < taps.tapCount; tap++)
+				weights[tap] /= weightSum;
+		}
+
+		return taps;
+	}
+
+	// Box filter of linear 8 bit values with exact integer sums, the last row & column of odd sizes are clamped
+	template <size_t ChannelCount>
+	void downsampleBox(const uint8_t* row0, const uint8_t* row1, uint8_t* newRow, uint32_t width, uint16_t* sums)
+	{
+		const size_t rowSize = width * ChannelCount;
+		size_t i = 0;
+
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		for (; i + 16 <= rowSize; i += 16)
+			Simd::addWiden16(row0 + i, row1 + i, sums + i);
+#endif
+
+		for (; i < rowSize; i++)
+			sums[i] = static_cast<uint16_t>(row0[i] + row1[i]);
+
+		// Pairs of columns, a single column is counted twice
+		const uint32_t pairCount = width / 2;
+
+		for (uint32_t x = 0; x < pairCount; x++)
+		{
+			const auto sum = sums + 2 * x * ChannelCount;
+
+			for (size_t c = 0; c < ChannelCount; c++)
+				newRow[x * ChannelCount + c] = static_cast<uint8_t>((sum[c] + sum[c + ChannelCount] + 2) / 4);
+		}
+
+		if (pairCount == 0)
+		{
+			for (size_t c = 0; c < ChannelCount; c++)
+				newRow[c] = static_cast<uint8_t>((2 * sums[c] + 2) / 4);
+		}
+	}
+
+	// destination += source * weight
+	void accumulate(float* destination, const float* source, float weight, size_t count)
+	{
+		size_t i = 0;
+
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+		const auto simdWeight = Simd::set(weight);
+
+		for (; i + Simd::FloatSize <= count; i += Simd::FloatSize)
+			Simd::store(destination + i, Simd::add(Simd::load(destination + i), Simd::mul(Simd::load(source + i), simdWeight)));
+#endif
+
+		for (; i < count; i++)
+			destination[i] += source[i] * weight;
+	}
+
+	// Horizontal pass of a row whose pixels have channelCount interleaved floats
+	void filterRow(const float* row, float* newRow, uint32_t newWidth, size_t channelCount, const FilterTaps& taps)
+	{
+		for (size_t x = 0; x < newWidth; x++)
+		{
+			const auto indices = taps.indices.data() + x * taps.tapCount;
+			const auto weights = taps.weights.data() + x * taps.tapCount;
+			auto newPixel = newRow + x * channelCount;
+
+#if ATEMA_SIMD != ATEMA_SIMD_NONE
+			// One pixel per register
+			if (channelCount == 4)
+			{
+				auto sum = Simd::set4(0.0f);
+
+				for (size_t tap = 0; tap < taps.tapCount; tap++)
+					sum = Simd::add4(sum, Simd::mul4(Simd::load4(row + indices[tap] * 4), Simd::set4(weights[tap])));
+
+				Simd::store4(newPixel, sum);
+
+				continue;
+			}
+#endif
+
+			for (size_t c = 0; c < channelCount; c++)
+				newPixel[c] = 0.0f;
+
+			for (size_t tap = 0; tap < taps.tapCount; tap++)
+			{
+				const auto pixel = row + indices[tap] * channelCount;
+
+				for (size_t c = 0; c < channelCount; c++)
+					newPixel[c] += pixel[c] * weights[tap];
+			}
+		}
+	}
+}
+
+ImageFormat TextureCompressor::getFormat(ImageLoader::Compression compression, ImageLoader::Format format)
+{
+	switch (compression)
+	{
+		case ImageLoader::Compression::None:
+		{
+			switch (format)
+			{
+				case ImageLoader::Format::R: return ImageFormat::R8_UNORM;
+				case ImageLoader::Format::RG: return ImageFormat::RG8_UNORM;
+				default: return ImageFormat::RGBA8_UNORM;
+			}
+		}
+		case ImageLoader::Compression::Compact:
+		{
+			switch (format)
+			{
+				case ImageLoader::Format::R: return ImageFormat::BC4_UNORM;
+				case ImageLoader::Format::RG: return ImageFormat::BC5_UNORM;
+				case ImageLoader::Format::RGB: return ImageFormat::BC1_RGB_UNORM;
+				default: return ImageFormat::BC3_UNORM;
+			}
+		}
+		case ImageLoader::Compression::HighQuality:
+		{
+			switch (format)
+			{
+				case ImageLoader::Format::R: return ImageFormat::BC4_UNORM;
+				case ImageLoader::Format::RG: return ImageFormat::BC5_UNORM;
+				default: return ImageFormat::BC7_UNORM;
+			}
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid compression");
+		}
+	}
+
+	return ImageFormat::RGBA8_UNORM;
+}
+
+ImageLoader::MipChain TextureCompressor::compress(const uint8_t* data, uint32_t width, uint32_t height, ImageLoader::Format format, ImageLoader::Compression compression, uint32_t mipLevels, ImageLoader::MipFilter mipFilter, bool srgb)
+{
+	ATEMA_ASSERT(data, "Invalid pixel data");
+	ATEMA_ASSERT(width > 0 && height > 0, "Invalid image size");
+
+	const auto channelCount = getChannelCount(format);
+
+	ImageLoader::MipChain mipChain;
+	mipChain.format = getFormat(compression, format);
+	mipChain.width = width;
+	mipChain.height = height;
+
+	// Same as ImageLoader
+	const uint32_t levelCount = mipLevels == 0 ? static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1 : mipLevels;
+
+	// Uncompressed RGB images are expanded to RGBA
+	const size_t outputChannelCount = getComponentCount(mipChain.format);
+
+	std::vector<uint8_t> pixels(data, data + static_cast<size_t>(width) * height * channelCount);
+	uint32_t levelWidth = width;
+	uint32_t levelHeight = height;
+
+	for (uint32_t mipLevel = 0; mipLevel < levelCount; mipLevel++)
+	{
+		if (mipLevel > 0)
+		{
+			pixels = downsample(pixels.data(), levelWidth, levelHeight, format, mipFilter, srgb);
+
+			levelWidth = std::max(levelWidth / 2, 1u);
+			levelHeight = std::max(levelHeight / 2, 1u);
+		}
+
+		const auto offset = mipChain.data.size();
+
+		mipChain.mipOffsets.emplace_back(offset);
+		mipChain.data.resize(offset + getByteSize(mipChain.format, levelWidth, levelHeight));
+
+		auto output = mipChain.data.data() + offset;
+
+		if (compression != ImageLoader::Compression::None)
+		{
+			encodeLevel(pixels.data(), levelWidth, levelHeight, channelCount, mipChain.format, output);
+		}
+		else if (outputChannelCount == channelCount)
+		{
+			std::memcpy(output, pixels.data(), pixels.size());
+		}
+		else
+		{
+			const size_t pixelCount = static_cast<size_t>(levelWidth) * levelHeight;
+
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				for (size_t c = 0; c < outputChannelCount; c++)
+					output[i * outputChannelCount + c] = c < channelCount ? pixels[i * channelCount + c] : 255;
+			}
+		}
+	}
+
+	return mipChain;
+}
+
+std::vector<uint8_t> TextureCompressor::downsample(const uint8_t* data, uint32_t width, uint32_t height, ImageLoader::Format format, ImageLoader::MipFilter mipFilter, bool srgb)
+{
+	ATEMA_ASSERT(data, "Invalid pixel data");
+	ATEMA_ASSERT(width > 0 && height > 0, "Invalid image size");
+
+	const auto channelCount = getChannelCount(format);
+	const auto srgbChannelCount = getSRGBChannelCount(channelCount, srgb);
+	const auto& tables = getChannelTables();
+
+	const auto newWidth = std::max(width / 2, 1u);
+	const auto newHeight = std::max(height / 2, 1u);
+	const size_t rowSize = width * channelCount;
+	const size_t newRowSize = newWidth * channelCount;
+
+	const auto horizontalTaps = getFilterTaps(mipFilter, width, newWidth);
+	const auto verticalTaps = getFilterTaps(mipFilter, height, newHeight);
+
+	std::array<const float*, 4> decodeTables;
+	for (size_t c = 0; c < channelCount; c++)
+		decodeTables[c] = c < srgbChannelCount ? tables.srgbToFloat.data() : tables.unormToFloat.data();
+
+	std::vector<uint8_t> newPixels(newRowSize * newHeight);
+
+	if (mipFilter == ImageLoader::MipFilter::Box && srgbChannelCount == 0)
+	{
+		TaskManager::instance().parallelFor(newHeight, [&](size_t y)
+			{
+				std::vector<uint16_t> sums(rowSize);
+
+				const auto row0 = data + std::min(2 * y, static_cast<size_t>(height - 1)) * rowSize;
+				const auto row1 = data + std::min(2 * y + 1, static_cast<size_t>(height - 1)) * rowSize;
+
+				auto newRow = newPixels.data() + y * newRowSize;
+
+				switch (channelCount)
+				{
+					case 1: downsampleBox<1>(row0, row1, newRow, width, sums.data()); break;
+					case 2: downsampleBox<2>(row0, row1, newRow, width, sums.data()); break;
+					case 3: downsampleBox<3>(row0, row1, newRow, width, sums.data()); break;
+					default: downsampleBox<4>(row0, row1, newRow, width, sums.data()); break;
+				}
+			});
+
+		return newPixels;
+	}
+
+	// Vertical pass first : it works on whole rows, the widest SIMD registers can be used
+	TaskManager::instance().parallelFor(newHeight, [&](size_t y)
+		{
+			std::vector<float> decodedRow(rowSize);
+			std::vector<float> filteredRow(rowSize, 0.0f);
+			std::vector<float> newRow(newRowSize);
+
+			for (size_t tap = 0; tap < verticalTaps.tapCount; tap++)
+			{
+				const auto weight = verticalTaps.weights[y * verticalTaps.tapCount + tap];
+
+				if (weight == 0.0f)
+					continue;
+
+				const auto row = data + verticalTaps.indices[y * verticalTaps.tapCount + tap] * rowSize;
+
+				for (size_t i = 0; i < rowSize; i += channelCount)
+				{
+					for (size_t c = 0; c < channelCount; c++)
+						decodedRow[i + c] = decodeTables[c][row[i + c]];
+				}
+
+				accumulate(filteredRow.data(), decodedRow.data(), weight, rowSize);
+			}
+
+			filterRow(filteredRow.data(), newRow.data(), newWidth, channelCount, horizontalTaps);
+
+			// Kaiser's negative lobes may overshoot
+			auto newPixelRow = newPixels.data() + y * newRowSize;
+
+			for (size_t i = 0; i < newRowSize; i += channelCount)
+			{
+				for (size_t c = 0; c < channelCount; c++)
+				{
+					const auto value = std::clamp(newRow[i + c], 0.0f, 1.0f);
+
+					if (c < srgbChannelCount)
+						newPixelRow[i + c] = tables.floatToSRGB[static_cast<size_t>(value * static_cast<float>(SRGBTableSize - 1) + 0.5f)];
+					else
+						newPixelRow[i + c] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+				}
+			}
+		});
+
+	return newPixels;
+}
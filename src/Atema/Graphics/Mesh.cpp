@@ -25,9 +25,34 @@
 
 using namespace at;
 
+// VertexQuantization
+Matrix4f VertexQuantization::getPositionMatrix() const
+{
+	auto matrix = Matrix4f::createIdentity();
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		matrix[i][i] = positionScale;
+		matrix[3][i] = positionOffset[i];
+	}
+
+	return matrix;
+}
+
+// Meshlet
+bool Meshlet::isBackFacing(const Vector3f& viewPosition) const noexcept
+{
+	const auto direction = boundingSphere.center - viewPosition;
+
+	// The whole sphere must be behind the planes of every triangle
+	return direction.dot(coneAxis) >= coneCutoff * direction.getNorm() + boundingSphere.radius;
+}
+
+// Mesh
 Mesh::Mesh() :
 	m_materialID(0),
-	m_triangleCount(0)
+	m_triangleCount(0),
+	m_texCoordsDensity(0.0f)
 {
 }
 
@@ -60,6 +85,29 @@ void Mesh::setMaterialID(size_t materialID)
 	m_materialID = materialID;
 }
 
+void Mesh::setVertexQuantization(const VertexQuantization& quantization)
+{
+	m_vertexQuantization = quantization;
+}
+
+void Mesh::setMeshlets(const std::vector<Meshlet>& meshlets)
+{
+	m_meshlets = meshlets;
+}
+
+void Mesh::setLods(const std::vector<MeshLod>& lods)
+{
+	m_lods = lods;
+
+	if (!m_lods.empty())
+		m_triangleCount = m_lods[0].indexCount / 3;
+}
+
+void Mesh::setTexCoordsDensity(float density)
+{
+	m_texCoordsDensity = density;
+}
+
 const Ptr<VertexBuffer>& Mesh::getVertexBuffer() const noexcept
 {
 	return m_vertexBuffer;
@@ -85,6 +133,26 @@ size_t Mesh::getTriangleCount() const noexcept
 	return m_triangleCount;
 }
 
+const VertexQuantization& Mesh::getVertexQuantization() const noexcept
+{
+	return m_vertexQuantization;
+}
+
+const std::vector<Meshlet>& Mesh::getMeshlets() const noexcept
+{
+	return m_meshlets;
+}
+
+const std::vector<MeshLod>& Mesh::getLods() const noexcept
+{
+	return m_lods;
+}
+
+float Mesh::getTexCoordsDensity() const noexcept
+{
+	return m_texCoordsDensity;
+}
+
 Mesh& Mesh::operator=(Mesh&& other) noexcept
 {
 	m_vertexBuffer = std::move(other.m_vertexBuffer);
@@ -94,5 +162,15 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept
 
 	m_materialID = other.m_materialID;
 
+	m_triangleCount = other.m_triangleCount;
+
+	m_vertexQuantization = other.m_vertexQuantization;
+
+	m_meshlets = std::move(other.m_meshlets);
+
+	m_lods = std::move(other.m_lods);
+
+	m_texCoordsDensity = other.m_texCoordsDensity;
+
 	return *this;
 }
@@ -96,7 +96,7 @@ void DebugRendererPass::beginFrame()
 	{
 		const auto& renderable = renderObject->getRenderable();
 		const auto& aabb = renderable.getAABB();
-		const auto& matrix = renderable.getTransform().getMatrix();
+		const auto& matrix = renderable.getMatrix();
 
 		// Axis Aligned Bounding Box
 		m_debugRenderer->draw(aabb, Color::Green);
@@ -28,23 +28,12 @@
 #include <Atema/Graphics/IndexBuffer.hpp>
 #include <Atema/Core/TaskManager.hpp>
 #include <Atema/Graphics/Graphics.hpp>
+#include <Atema/Graphics/TextureStreamer.hpp>
 
 using namespace at;
 
 namespace
 {
-	inline IntersectionType getFrustumIntersection(const Frustumf& frustum, const AABBf& aabb)
-	{
-		const auto sphere = aabb.getBoundingSphere();
-
-		const auto sphereIntersection = frustum.getIntersectionType(sphere);
-
-		if (sphereIntersection != IntersectionType::Intersection)
-			return sphereIntersection;
-
-		return frustum.getIntersectionType(aabb);
-	}
-
 	inline uint32_t getRenderPriority(const RenderElement& renderElement)
 	{
 		if (!renderElement.renderMaterialInstance)
@@ -59,7 +48,12 @@ namespace
 }
 
 GBufferPass::GBufferPass(RenderResourceManager& resourceManager, size_t threadCount) :
-	m_resourceManager(&resourceManager)
+	m_resourceManager(&resourceManager),
+	m_lodThreshold(1.0f),
+	m_lodMaxError(0.0f),
+	m_lodDistanceDependent(true),
+	m_pixelsPerUnit(0.0f),
+	m_textureStreaming(false)
 {
 	const auto& taskManager = TaskManager::instance();
 	const auto maxThreadCount = taskManager.getSize();
@@ -193,21 +187,54 @@ void GBufferPass::beginFrame()
 
 	frustumCull();
 
+	// Materials still compiling their pipeline are skipped instead of stalling the frame
+	const auto isPending = [](const RenderElement& renderElement)
+	{
+		return renderElement.renderMaterialInstance && !renderElement.renderMaterialInstance->getRenderMaterial().isReady();
+	};
+
+	m_renderElements.erase(std::remove_if(m_renderElements.begin(), m_renderElements.end(), isPending), m_renderElements.end());
+
 	sortElements();
 }
 
 void GBufferPass::endFrame()
 {
+	m_visibleRenderObjects.clear();
+	m_renderObjectIntersections.clear();
 	m_renderElements.clear();
 }
 
+void GBufferPass::setLodThreshold(float pixels)
+{
+	m_lodThreshold = pixels;
+}
+
 void GBufferPass::frustumCull()
 {
-	const auto& renderObjects = getRenderScene().getRenderObjects();
+	const auto& camera = getRenderScene().getCamera();
+	const auto& frustum = camera.getFrustum();
+
+	// A world error e at distance d covers e * proj[1][1] * height / (2 * d) pixels with a perspective projection
+	// An orthographic projection doesn't divide by the distance (w stays 1)
+	const auto& projection = camera.getProjectionMatrix();
+	const auto pixelsPerUnit = std::abs(projection[1][1]) * static_cast<float>(camera.getScissor().size.y) / 2.0f;
+
+	m_lodDistanceDependent = projection[3][3] == 0.0f;
+	m_lodMaxError = pixelsPerUnit > 0.0f ? m_lodThreshold / pixelsPerUnit : 0.0f;
+	m_pixelsPerUnit = pixelsPerUnit;
+	m_textureStreaming = TextureStreamer::instance().isEnabled();
+
+	// Keep only visible render objects using the scene hierarchy
+	getRenderScene().getRenderObjectHierarchy().query(frustum, [this](const RenderObject* renderObject, IntersectionType intersectionType)
+		{
+			m_visibleRenderObjects.emplace_back(renderObject);
+			m_renderObjectIntersections.emplace_back(intersectionType);
+		});
 
 	if (m_threadCount == 1)
 	{
-		frustumCullElements(m_renderElements, 0, renderObjects.size());
+		frustumCullElements(m_renderElements, 0, m_visibleRenderObjects.size());
 	}
 	else
 	{
@@ -219,13 +246,13 @@ void GBufferPass::frustumCull()
 		tasks.reserve(m_threadCount);
 
 		size_t firstIndex = 0;
-		size_t size = renderObjects.size() / m_threadCount;
+		size_t size = m_visibleRenderObjects.size() / m_threadCount;
 
 		for (size_t taskIndex = 0; taskIndex < m_threadCount; taskIndex++)
 		{
 			if (taskIndex == m_threadCount - 1)
 			{
-				const auto remainingSize = renderObjects.size() - m_threadCount * size;
+				const auto remainingSize = m_visibleRenderObjects.size() - m_threadCount * size;
 
 				size += remainingSize;
 			}
@@ -258,65 +285,104 @@ void GBufferPass::frustumCullElements(std::vector<RenderElement>& renderElements
 	if (!count)
 		return;
 
-	const auto& renderObjects = getRenderScene().getRenderObjects();
-
-	const auto& frustum = getRenderScene().getCamera().getFrustum();
-
-	std::vector<const RenderObject*> visibleRenderObjects;
-	std::vector<IntersectionType> renderObjectIntersections;
-
-	// Keep only visible renderables using frustum culling
-	visibleRenderObjects.reserve(count);
-	renderObjectIntersections.reserve(count);
+	const auto& camera = getRenderScene().getCamera();
+	const auto& frustum = camera.getFrustum();
+	const auto& cameraPosition = camera.getPosition();
 
 	size_t renderElementsSize = 0;
 
 	for (size_t i = index; i < index + count; i++)
-	{
-		const auto& renderObject = *renderObjects[i];
-
-		const auto intersectionType = getFrustumIntersection(frustum, renderObject.getRenderable().getAABB());
-
-		if (intersectionType != IntersectionType::Outside)
-		{
-			visibleRenderObjects.emplace_back(&renderObject);
-			renderObjectIntersections.emplace_back(intersectionType);
-
-			renderElementsSize += renderObject.getRenderElementsSize();
-		}
-	}
+		renderElementsSize += m_visibleRenderObjects[i]->getRenderElementsSize();
 
 	// Cull individual elements if needed
 	renderElements.reserve(renderElementsSize);
 
+	// Elements of intersecting renderables are gathered to be tested all at once
 	std::vector<RenderElement> tmpRenderElements;
+	std::vector<const Matrix4f*> tmpMatrices;
+	AABBBatchf tmpAABBs;
+	std::vector<IntersectionType> intersectionTypes;
+
+	std::vector<RenderElement> containedRenderElements;
 
-	for (size_t i = 0; i < visibleRenderObjects.size(); i++)
+	for (size_t i = index; i < index + count; i++)
 	{
-		const auto& renderObject = *visibleRenderObjects[i];
+		const auto& renderObject = *m_visibleRenderObjects[i];
+
+		const auto& matrix = renderObject.getRenderable().getMatrix();
 
-		// Renderable is fully contained : every element also is
-		if (renderObjectIntersections[i] == IntersectionType::Inside)
+		// Renderable is fully contained : every element also is, only back-facing meshlets can be culled
+		if (m_renderObjectIntersections[i] == IntersectionType::Inside)
 		{
-			renderObject.getRenderElements(renderElements);
+			containedRenderElements.clear();
+
+			renderObject.getRenderElements(containedRenderElements);
+
+			for (auto& renderElement : containedRenderElements)
+			{
+				selectLod(renderElement, matrix);
+				requestTextures(renderElement, matrix);
+
+				renderElement.cullMeshlets(renderElements, matrix, nullptr, &cameraPosition);
+			}
 		}
 		// Renderable is intersecting with the frustum : test every element
 		else
 		{
-			tmpRenderElements.clear();
-			tmpRenderElements.reserve(renderObject.getRenderElementsSize());
+			const auto firstElement = tmpRenderElements.size();
 
 			renderObject.getRenderElements(tmpRenderElements);
 
-			const auto& matrix = renderObject.getRenderable().getTransform().getMatrix();
-
-			for (auto& renderElement : tmpRenderElements)
+			for (size_t j = firstElement; j < tmpRenderElements.size(); j++)
 			{
-				if (getFrustumIntersection(frustum, matrix * renderElement.aabb) != IntersectionType::Outside)
-					renderElements.emplace_back(std::move(renderElement));
+				tmpAABBs.add(matrix * tmpRenderElements[j].aabb);
+				tmpMatrices.emplace_back(&matrix);
 			}
 		}
 	}
+
+	frustum.getIntersectionTypes(tmpAABBs, intersectionTypes);
+
+	for (size_t i = 0; i < tmpRenderElements.size(); i++)
+	{
+		const auto intersectionType = intersectionTypes[i];
+
+		if (intersectionType == IntersectionType::Outside)
+			continue;
+
+		// Meshlets of intersecting elements are also tested against the frustum
+		const auto elementFrustum = intersectionType == IntersectionType::Intersection ? &frustum : nullptr;
+
+		selectLod(tmpRenderElements[i], *tmpMatrices[i]);
+		requestTextures(tmpRenderElements[i], *tmpMatrices[i]);
+
+		tmpRenderElements[i].cullMeshlets(renderElements, *tmpMatrices[i], elementFrustum, &cameraPosition);
+	}
+}
+
+void GBufferPass::selectLod(RenderElement& renderElement, const Matrix4f& matrix) const
+{
+	if (renderElement.lodCount <= 1)
+		return;
+
+	if (m_lodDistanceDependent)
+		renderElement.setLod(renderElement.getLodIndex(matrix, getRenderScene().getCamera().getPosition(), m_lodMaxError));
+	else
+		renderElement.setLod(renderElement.getLodIndex(matrix, m_lodMaxError));
+}
+
+void GBufferPass::requestTextures(const RenderElement& renderElement, const Matrix4f& matrix) const
+{
+	if (!m_textureStreaming || !renderElement.renderMaterialInstance)
+		return;
+
+	float textureSize;
+	if (m_lodDistanceDependent)
+		textureSize = renderElement.getTextureSize(matrix, getRenderScene().getCamera().getPosition(), m_pixelsPerUnit);
+	else
+		textureSize = renderElement.getTextureSize(matrix, m_pixelsPerUnit);
+
+	TextureStreamer::instance().request(renderElement.renderMaterialInstance->getMaterialInstance(), textureSize);
 }
 
 void GBufferPass::sortElements()
@@ -392,6 +458,6 @@ void GBufferPass::drawElements(CommandBuffer& commandBuffer, size_t index, size_
 
 		commandBuffer.bindIndexBuffer(*indexBuffer->getBuffer(), indexBuffer->getIndexType());
 
-		commandBuffer.drawIndexed(static_cast<uint32_t>(indexBuffer->getSize()));
+		commandBuffer.drawIndexed(renderElement.indexCount, 1, renderElement.firstIndex);
 	}
 }
@@ -780,129 +780,48 @@ void LightPass::createShaders()
 
 void LightPass::frustumCull()
 {
-	const auto& renderLights = getRenderScene().getRenderLights();
-
-	std::vector<std::vector<const RenderLight*>> visibleLights;
-
-	if (m_threadCount == 1)
-	{
-		visibleLights.resize(1);
-
-		frustumCullElements(0, renderLights.size(), visibleLights[0]);
-	}
-	else
-	{
-		auto& taskManager = TaskManager::instance();
-
-		visibleLights.resize(m_threadCount);
+	const auto& renderScene = getRenderScene();
 
-		std::vector<Ptr<Task>> tasks;
-		tasks.reserve(m_threadCount);
+	const auto& frustum = renderScene.getCamera().getFrustum();
 
-		size_t firstIndex = 0;
-		size_t size = renderLights.size() / m_threadCount;
+	// Global lights affect the whole scene
+	for (const auto& renderLight : renderScene.getGlobalRenderLights())
+		m_directionalLights.emplace_back(renderLight);
 
-		for (size_t taskIndex = 0; taskIndex < m_threadCount; taskIndex++)
+	// Bounded lights are stored in the scene hierarchy using their bounding sphere's AABB
+	// When this AABB intersects the frustum, test the bounding sphere itself
+	renderScene.getRenderLightHierarchy().query(frustum, [this, &frustum](const RenderLight* renderLight, IntersectionType intersectionType)
 		{
-			if (taskIndex == m_threadCount - 1)
-			{
-				const auto remainingSize = renderLights.size() - m_threadCount * size;
-
-				size += remainingSize;
-			}
+			const auto& light = renderLight->getLight();
 
-			auto task = taskManager.createTask([this, taskIndex, firstIndex, size, &visibleLights](size_t threadIndex)
-				{
-					frustumCullElements(firstIndex, size, visibleLights[taskIndex]);
-				});
-
-			tasks.push_back(task);
-
-			firstIndex += size;
-		}
-
-		for (auto& task : tasks)
-			task->wait();
-
-		for (auto& lights : visibleLights)
-		{
-			for (auto& light : lights)
+			switch (light.getType())
 			{
-				switch (light->getLight().getType())
+				case LightType::Point:
 				{
-					case LightType::Directional:
-					{
-						m_directionalLights.emplace_back(light);
-						break;
-					}
-					case LightType::Point:
-					{
-						m_pointLights.emplace_back(light);
-						break;
-					}
-					case LightType::Spot:
-					{
-						m_spotLights.emplace_back(light);
-						break;
-					}
-					default:
-					{
-						ATEMA_ERROR("Unhandled LightType");
-					}
-				};
-			}
-		}
-	}
-}
+					const auto& pointLight = static_cast<const PointLight&>(light);
+					const Spheref boundingSphere(pointLight.getPosition(), pointLight.getRadius());
 
-void LightPass::frustumCullElements(size_t index, size_t count, std::vector<const RenderLight*>& visibleLights) const
-{
-	if (!count)
-		return;
-
-	const auto& renderLights = getRenderScene().getRenderLights();
-
-	const auto& frustum = getRenderScene().getCamera().getFrustum();
-
-	visibleLights.reserve(count);
+					if (intersectionType == IntersectionType::Inside || frustum.getIntersectionType(boundingSphere) != IntersectionType::Outside)
+						m_pointLights.emplace_back(renderLight);
 
-	for (size_t i = index; i < index + count; i++)
-	{
-		const auto& renderLight = *renderLights[i];
-
-		switch (renderLight.getLight().getType())
-		{
-			case LightType::Directional:
-			{
-				visibleLights.emplace_back(&renderLight);
-				break;
-			}
-			case LightType::Point:
-			{
-				const auto& pointLight = static_cast<const PointLight&>(renderLight.getLight());
-				Sphere<float> boundingSphere(pointLight.getPosition(), pointLight.getRadius());
-
-				if (frustum.getIntersectionType(boundingSphere) != IntersectionType::Outside)
-					visibleLights.emplace_back(&renderLight);
-
-				break;
-			}
-			case LightType::Spot:
-			{
-				const auto& spotLight = static_cast<const SpotLight&>(renderLight.getLight());
-				Sphere<float> boundingSphere(spotLight.getPosition(), spotLight.getRange());
+					break;
+				}
+				case LightType::Spot:
+				{
+					const auto& spotLight = static_cast<const SpotLight&>(light);
+					const Spheref boundingSphere(spotLight.getPosition(), spotLight.getRange());
 
-				if (frustum.getIntersectionType(boundingSphere) != IntersectionType::Outside)
-					visibleLights.emplace_back(&renderLight);
+					if (intersectionType == IntersectionType::Inside || frustum.getIntersectionType(boundingSphere) != IntersectionType::Outside)
+						m_spotLights.emplace_back(renderLight);
 
-				break;
-			}
-			default:
-			{
-				ATEMA_ERROR("Unhandled LightType");
+					break;
+				}
+				default:
+				{
+					ATEMA_ERROR("Unhandled LightType");
+				}
 			}
-		}
-	}
+		});
 }
 
 void LightPass::drawElements(CommandBuffer& commandBuffer, bool applyPostProcess,
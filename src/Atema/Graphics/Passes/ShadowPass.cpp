@@ -22,6 +22,7 @@
 #include <Atema/Graphics/Passes/ShadowPass.hpp>
 #include <Atema/Graphics/FrameGraphBuilder.hpp>
 #include <Atema/Graphics/RenderScene.hpp>
+#include <Atema/Graphics/VertexBuffer.hpp>
 #include <Atema/Graphics/VertexTypes.hpp>
 #include <Atema/Graphics/Graphics.hpp>
 #include <Atema/Graphics/FrameGraphContext.hpp>
@@ -67,18 +68,6 @@ namespace
 		}
 	};
 
-	inline IntersectionType getFrustumIntersection(const Frustumf& frustum, const AABBf& aabb)
-	{
-		const auto sphere = aabb.getBoundingSphere();
-
-		const auto sphereIntersection = frustum.getIntersectionType(sphere);
-
-		if (sphereIntersection != IntersectionType::Intersection)
-			return sphereIntersection;
-
-		return frustum.getIntersectionType(aabb);
-	}
-
 	constexpr char* ShaderName = "AtemaShadowPass";
 
 	const char ShaderCode[] = R"(
@@ -103,12 +92,9 @@ external
 input
 {
 	[location(0)] vec3f inPosition;
-	[location(1)] vec3f inNormal;
-	[location(2)] vec3f inTangent;
-	[location(3)] vec3f inBitangent;
-	[location(4)] vec2f inTexCoords;
 }
 
+// Quantized positions are decoded by the model matrix
 [entry(vertex)]
 void main()
 {
@@ -134,7 +120,8 @@ void main()
 }
 
 ShadowPass::ShadowPass(RenderResourceManager& resourceManager, size_t threadCount) :
-	m_resourceManager(&resourceManager)
+	m_resourceManager(&resourceManager),
+	m_lodError(0.0f)
 {
 	const auto& taskManager = TaskManager::instance();
 	const auto maxThreadCount = taskManager.getSize();
@@ -160,12 +147,15 @@ ShadowPass::ShadowPass(RenderResourceManager& resourceManager, size_t threadCoun
 	pipelineSettings.vertexShader = graphics.getShader(*graphics.getUberShaderFromString(std::string(ShaderName), AstShaderStage::Vertex));
 	pipelineSettings.fragmentShader = graphics.getShader(*graphics.getUberShaderFromString(std::string(ShaderName), AstShaderStage::Fragment));
 	pipelineSettings.descriptorSetLayouts = { m_setLayout, graphics.getObjectLayout()};
-	//TODO: Change vertex input depending on what mesh is drawn
-	pipelineSettings.state.vertexInput.inputs = Vertex_XYZ_UV_NTB::getVertexInput();
 	pipelineSettings.state.rasterization.depthClamp = true;
 
+	// Only the position is used, but the vertex input must match the whole vertex layout
+	pipelineSettings.state.vertexInput.inputs = Vertex_XYZ_UV_NTB::getVertexInput();
 	m_pipeline = GraphicsPipeline::create(pipelineSettings);
 
+	pipelineSettings.state.vertexInput.inputs = Vertex_XYZ_UV_NT_Quantized::getVertexInput();
+	m_quantizedPipeline = GraphicsPipeline::create(pipelineSettings);
+
 	ShadowLayoutData layoutData(StructLayout::Default);
 
 	Buffer::Settings bufferSettings;
@@ -221,6 +211,11 @@ void ShadowPass::setFrustum(const Frustumf& frustum)
 	m_frustum = frustum;
 }
 
+void ShadowPass::setLodError(float maxError)
+{
+	m_lodError = maxError;
+}
+
 void ShadowPass::execute(FrameGraphContext& context, const Settings& settings)
 {
 	const auto& renderScene = getRenderScene();
@@ -293,16 +288,26 @@ void ShadowPass::beginFrame()
 
 void ShadowPass::endFrame()
 {
+	m_visibleRenderObjects.clear();
+	m_renderObjectIntersections.clear();
 	m_renderElements.clear();
 }
 
 void ShadowPass::frustumCull()
 {
-	const auto& renderObjects = getRenderScene().getRenderObjects();
+	// Keep only visible shadow casters using the scene hierarchy
+	getRenderScene().getRenderObjectHierarchy().query(m_frustum, [this](const RenderObject* renderObject, IntersectionType intersectionType)
+		{
+			if (renderObject->getRenderable().castShadows())
+			{
+				m_visibleRenderObjects.emplace_back(renderObject);
+				m_renderObjectIntersections.emplace_back(intersectionType);
+			}
+		});
 
 	if (m_threadCount == 1)
 	{
-		frustumCullElements(m_renderElements, 0, renderObjects.size());
+		frustumCullElements(m_renderElements, 0, m_visibleRenderObjects.size());
 	}
 	else
 	{
@@ -314,13 +319,13 @@ void ShadowPass::frustumCull()
 		tasks.reserve(m_threadCount);
 
 		size_t firstIndex = 0;
-		size_t size = renderObjects.size() / m_threadCount;
+		size_t size = m_visibleRenderObjects.size() / m_threadCount;
 
 		for (size_t taskIndex = 0; taskIndex < m_threadCount; taskIndex++)
 		{
 			if (taskIndex == m_threadCount - 1)
 			{
-				const auto remainingSize = renderObjects.size() - m_threadCount * size;
+				const auto remainingSize = m_visibleRenderObjects.size() - m_threadCount * size;
 
 				size += remainingSize;
 			}
@@ -353,43 +358,42 @@ void ShadowPass::frustumCullElements(std::vector<RenderElement>& renderElements,
 	if (!count)
 		return;
 
-	const auto& renderObjects = getRenderScene().getRenderObjects();
+	size_t renderElementsSize = 0;
 
-	std::vector<const RenderObject*> visibleRenderObjects;
-	std::vector<IntersectionType> renderObjectIntersections;
+	for (size_t i = index; i < index + count; i++)
+		renderElementsSize += m_visibleRenderObjects[i]->getRenderElementsSize();
 
-	// Keep only visible renderables using frustum culling
-	visibleRenderObjects.reserve(count);
-	renderObjectIntersections.reserve(count);
+	renderElements.reserve(renderElementsSize);
 
-	size_t renderElementsSize = 0;
+	std::vector<RenderElement> objectRenderElements;
 
 	for (size_t i = index; i < index + count; i++)
 	{
-		const auto& renderObject = *renderObjects[i];
-		const auto& renderable = renderObject.getRenderable();
+		const auto& renderObject = *m_visibleRenderObjects[i];
 
-		if (!renderable.castShadows())
-			continue;
+		objectRenderElements.clear();
 
-		const auto intersectionType = getFrustumIntersection(m_frustum, renderable.getAABB());
+		renderObject.getRenderElements(objectRenderElements);
 
-		if (intersectionType != IntersectionType::Outside)
-		{
-			visibleRenderObjects.emplace_back(&renderObject);
-			renderObjectIntersections.emplace_back(intersectionType);
+		const auto& matrix = renderObject.getRenderable().getMatrix();
 
-			renderElementsSize += renderObject.getRenderElementsSize();
-		}
-	}
+		// The projection is orthographic : the error of a LOD in the shadow map doesn't depend on the distance
+		for (auto& renderElement : objectRenderElements)
+			renderElement.setLod(renderElement.getLodIndex(matrix, m_lodError));
 
-	renderElements.reserve(renderElementsSize);
-
-	for (size_t i = 0; i < visibleRenderObjects.size(); i++)
-	{
-		const auto& renderObject = *visibleRenderObjects[i];
-
-		renderObject.getRenderElements(renderElements);
+		// Shadow casters fully contained in the frustum are drawn entirely
+		if (m_renderObjectIntersections[i] == IntersectionType::Inside)
+		{
+			for (auto& renderElement : objectRenderElements)
+				renderElements.emplace_back(std::move(renderElement));
+		}
+		// Otherwise only the meshlets in the frustum are kept
+		// Back faces may cast shadows, so meshlets are never culled using their orientation
+		else
+		{
+			for (const auto& renderElement : objectRenderElements)
+				renderElement.cullMeshlets(renderElements, matrix, &m_frustum, nullptr);
+		}
 	}
 }
 
@@ -401,7 +405,9 @@ void ShadowPass::drawElements(CommandBuffer& commandBuffer, size_t index, size_t
 	Viewport viewport;
 	viewport.size = { shadowMapSize, shadowMapSize };
 
-	commandBuffer.bindPipeline(*m_pipeline);
+	const GraphicsPipeline* currentPipeline = m_pipeline.get();
+
+	commandBuffer.bindPipeline(*currentPipeline);
 
 	commandBuffer.setViewport(viewport);
 
@@ -413,6 +419,17 @@ void ShadowPass::drawElements(CommandBuffer& commandBuffer, size_t index, size_t
 	{
 		const auto& renderElement = m_renderElements[i];
 
+		// Pipelines share the same layout, so the bound descriptor sets stay valid
+		const auto& positionComponent = renderElement.vertexBuffer->getFormat().getComponent(VertexComponentType::Position);
+		const GraphicsPipeline* pipeline = positionComponent.isNormalized() ? m_quantizedPipeline.get() : m_pipeline.get();
+
+		if (pipeline != currentPipeline)
+		{
+			commandBuffer.bindPipeline(*pipeline);
+
+			currentPipeline = pipeline;
+		}
+
 		if (renderElement.transformDescriptorSet)
 			commandBuffer.bindDescriptorSet(ObjectSetIndex, *renderElement.transformDescriptorSet);
 
@@ -420,6 +437,6 @@ void ShadowPass::drawElements(CommandBuffer& commandBuffer, size_t index, size_t
 
 		commandBuffer.bindIndexBuffer(*renderElement.indexBuffer->getBuffer(), renderElement.indexBuffer->getIndexType());
 
-		commandBuffer.drawIndexed(static_cast<uint32_t>(renderElement.indexBuffer->getSize()));
+		commandBuffer.drawIndexed(renderElement.indexCount, 1, renderElement.firstIndex);
 	}
 }
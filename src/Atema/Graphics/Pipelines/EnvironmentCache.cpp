@@ -0,0 +1,399 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Graphics/Pipelines/EnvironmentCache.hpp>
+#include <Atema/Core/Error.hpp>
+#include <Atema/Renderer/Buffer.hpp>
+#include <Atema/Renderer/CommandBuffer.hpp>
+#include <Atema/Renderer/CommandPool.hpp>
+#include <Atema/Renderer/Renderer.hpp>
+#include <Atema/Renderer/Utils.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace at;
+
+namespace
+{
+	// Stable across platforms, unlike the default hash
+	using FileHasher = Hasher<FNV1a<Hash64>>;
+
+	constexpr uint32_t FileMagic = 0x564E4541; // 'AENV'
+	constexpr uint32_t FileVersion = 1;
+
+	// Size of the chunks read to hash the source file
+	constexpr size_t HashChunkSize = 1 << 20;
+
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		Hash64 key;
+		uint32_t cubemapCount;
+	};
+
+	struct CubemapHeader
+	{
+		uint32_t format;
+		uint32_t size;
+		uint32_t layers;
+		uint32_t mipLevels;
+	};
+
+	uint32_t getArrayLayers(const CubemapHeader& header)
+	{
+		return header.layers * 6;
+	}
+
+	// Mip levels are stored one after the other, each one containing all its array layers
+	size_t getByteSize(const CubemapHeader& header)
+	{
+		const size_t pixelByteSize = at::getByteSize(static_cast<ImageFormat>(header.format));
+
+		size_t byteSize = 0;
+
+		for (uint32_t mipLevel = 0; mipLevel < header.mipLevels; mipLevel++)
+		{
+			const size_t mipSize = std::max(header.size >> mipLevel, 1u);
+
+			byteSize += mipSize * mipSize * pixelByteSize * getArrayLayers(header);
+		}
+
+		return byteSize;
+	}
+
+	// Files may be corrupted even with a matching key : headers are checked before anything is allocated
+	bool isHeaderValid(const CubemapHeader& header, size_t remainingByteSize)
+	{
+		if (header.format >= static_cast<uint32_t>(ImageFormat::_COUNT) || Renderer::isCompressedImageFormat(static_cast<ImageFormat>(header.format)))
+			return false;
+
+		if (header.size == 0 || header.layers == 0 || header.mipLevels == 0)
+			return false;
+
+		uint32_t maxMipLevels = 1;
+		while ((header.size >> maxMipLevels) > 0)
+			maxMipLevels++;
+
+		if (header.mipLevels > maxMipLevels)
+			return false;
+
+		// Same size as getByteSize, without overflowing
+		const uint64_t pixelByteSize = at::getByteSize(static_cast<ImageFormat>(header.format));
+		const uint64_t arrayLayers = static_cast<uint64_t>(header.layers) * 6;
+
+		uint64_t byteSize = 0;
+
+		for (uint32_t mipLevel = 0; mipLevel < header.mipLevels; mipLevel++)
+		{
+			const uint64_t mipSize = std::max(header.size >> mipLevel, 1u);
+
+			if (mipSize > remainingByteSize / mipSize)
+				return false;
+
+			const uint64_t pixelCount = mipSize * mipSize;
+
+			if (pixelCount > remainingByteSize / pixelByteSize / arrayLayers)
+				return false;
+
+			byteSize += pixelCount * pixelByteSize * arrayLayers;
+
+			if (byteSize > remainingByteSize)
+				return false;
+		}
+
+		return true;
+	}
+
+	template <typename Function>
+	void forEachLayer(const CubemapHeader& header, Function&& function)
+	{
+		const size_t pixelByteSize = at::getByteSize(static_cast<ImageFormat>(header.format));
+
+		size_t offset = 0;
+
+		for (uint32_t mipLevel = 0; mipLevel < header.mipLevels; mipLevel++)
+		{
+			const size_t mipSize = std::max(header.size >> mipLevel, 1u);
+
+			for (uint32_t layer = 0; layer < getArrayLayers(header); layer++)
+			{
+				function(offset, mipLevel, layer);
+
+				offset += mipSize * mipSize * pixelByteSize;
+			}
+		}
+	}
+
+	Ptr<CommandBuffer> beginCommands()
+	{
+		auto commandBuffer = Renderer::instance().getCommandPool(QueueType::Graphics)->createBuffer({ true });
+
+		commandBuffer->begin();
+
+		return commandBuffer;
+	}
+
+	void submitCommands(const Ptr<CommandBuffer>& commandBuffer)
+	{
+		commandBuffer->end();
+
+		Renderer::instance().submitAndWait({ commandBuffer });
+	}
+}
+
+Hash64 EnvironmentCache::getKey(const std::filesystem::path& sourcePath, const std::vector<Image::Settings>& outputSettings)
+{
+	std::ifstream file(sourcePath, std::ios::binary);
+
+	if (!file.is_open())
+		ATEMA_ERROR("Failed to open file '" + sourcePath.string() + "'");
+
+	Hash64 key = 0;
+
+	// Hash the file content by chunks, to avoid loading big images at once
+	std::vector<char> chunk(HashChunkSize);
+
+	while (file)
+	{
+		file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+
+		const auto readSize = static_cast<size_t>(file.gcount());
+
+		if (readSize > 0)
+			FileHasher::hashCombine(key, FileHasher::hash(chunk.data(), readSize));
+	}
+
+	for (const auto& settings : outputSettings)
+	{
+		FileHasher::hashCombine(key, settings.width, settings.height, settings.mipLevels);
+		FileHasher::hashCombine(key, static_cast<uint32_t>(settings.format));
+	}
+
+	return key;
+}
+
+void EnvironmentCache::save(const std::filesystem::path& path, Hash64 key, const std::vector<Ptr<Image>>& cubemaps)
+{
+	std::vector<CubemapHeader> headers;
+	std::vector<Ptr<Buffer>> buffers;
+
+	headers.reserve(cubemaps.size());
+	buffers.reserve(cubemaps.size());
+
+	// Read back every mip level & layer
+	auto commandBuffer = beginCommands();
+
+	for (const auto& cubemap : cubemaps)
+	{
+		ATEMA_ASSERT(cubemap && cubemap->getType() == ImageType::CubeMap, "Invalid cubemap");
+
+		auto& header = headers.emplace_back();
+		header.format = static_cast<uint32_t>(cubemap->getFormat());
+		header.size = cubemap->getSize().x;
+		header.layers = cubemap->getLayers();
+		header.mipLevels = cubemap->getMipLevels();
+
+		auto& buffer = buffers.emplace_back(Buffer::create({ BufferUsage::TransferDst | BufferUsage::Map, getByteSize(header) }));
+
+		commandBuffer->imageBarrier(*cubemap,
+			PipelineStage::FragmentShader, PipelineStage::Transfer,
+			MemoryAccess::ShaderRead, MemoryAccess::TransferRead,
+			ImageLayout::ShaderRead, ImageLayout::TransferSrc);
+
+		forEachLayer(header, [&](size_t offset, uint32_t mipLevel, uint32_t layer)
+			{
+				commandBuffer->copyImageToBuffer(*cubemap, ImageLayout::TransferSrc, *buffer, offset, mipLevel, layer);
+			});
+
+		commandBuffer->imageBarrier(*cubemap,
+			PipelineStage::Transfer, PipelineStage::FragmentShader,
+			MemoryAccess::TransferRead, MemoryAccess::ShaderRead,
+			ImageLayout::TransferSrc, ImageLayout::ShaderRead);
+	}
+
+	submitCommands(commandBuffer);
+
+	// Write the file under a temporary name then rename it, so a crash never leaves a partial file
+	// Temporary names must be unique, other threads may save the same environment
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path());
+
+	std::stringstream tempName;
+	tempName << path.filename().string() << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+
+	const auto tempPath = path.parent_path() / tempName.str();
+
+	bool written = false;
+
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open())
+			ATEMA_ERROR("Failed to open file '" + tempPath.string() + "'");
+
+		try
+		{
+			FileHeader fileHeader;
+			fileHeader.magic = FileMagic;
+			fileHeader.version = FileVersion;
+			fileHeader.key = key;
+			fileHeader.cubemapCount = static_cast<uint32_t>(cubemaps.size());
+
+			file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(FileHeader));
+
+			for (size_t i = 0; i < headers.size(); i++)
+			{
+				file.write(reinterpret_cast<const char*>(&headers[i]), sizeof(CubemapHeader));
+
+				const void* data = buffers[i]->map();
+
+				file.write(static_cast<const char*>(data), static_cast<std::streamsize>(buffers[i]->getByteSize()));
+
+				buffers[i]->unmap();
+			}
+		}
+		catch (...)
+		{
+			file.close();
+
+			std::error_code errorCode;
+			std::filesystem::remove(tempPath, errorCode);
+
+			throw;
+		}
+
+		file.close();
+
+		written = !file.fail();
+	}
+
+	std::error_code errorCode;
+
+	if (written)
+		std::filesystem::rename(tempPath, path, errorCode);
+
+	if (!written || errorCode)
+	{
+		std::filesystem::remove(tempPath, errorCode);
+
+		ATEMA_ERROR("Failed to write file '" + path.string() + "'");
+	}
+}
+
+bool EnvironmentCache::load(const std::filesystem::path& path, Hash64 key, std::vector<Ptr<Image>>& cubemaps, Flags<ImageUsage> usages)
+{
+	std::error_code errorCode;
+
+	const auto fileSize = std::filesystem::file_size(path, errorCode);
+
+	if (errorCode || fileSize < sizeof(FileHeader))
+		return false;
+
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	FileHeader fileHeader;
+
+	if (!file.read(reinterpret_cast<char*>(&fileHeader), sizeof(FileHeader)))
+		return false;
+
+	if (fileHeader.magic != FileMagic || fileHeader.version != FileVersion || fileHeader.key != key)
+		return false;
+
+	auto remainingByteSize = static_cast<size_t>(fileSize) - sizeof(FileHeader);
+
+	if (fileHeader.cubemapCount > remainingByteSize / sizeof(CubemapHeader))
+		return false;
+
+	// Read everything before recording any command, so an incomplete file has no side effect
+	std::vector<CubemapHeader> headers(fileHeader.cubemapCount);
+	std::vector<Ptr<Buffer>> stagingBuffers;
+
+	stagingBuffers.reserve(headers.size());
+
+	for (auto& header : headers)
+	{
+		if (remainingByteSize < sizeof(CubemapHeader) || !file.read(reinterpret_cast<char*>(&header), sizeof(CubemapHeader)))
+			return false;
+
+		remainingByteSize -= sizeof(CubemapHeader);
+
+		if (!isHeaderValid(header, remainingByteSize))
+			return false;
+
+		remainingByteSize -= getByteSize(header);
+
+		// Read the data straight into the staging buffer, without any intermediate copy
+		auto& stagingBuffer = stagingBuffers.emplace_back(Buffer::create({ BufferUsage::TransferSrc | BufferUsage::Map, getByteSize(header) }));
+
+		void* data = stagingBuffer->map();
+
+		file.read(static_cast<char*>(data), static_cast<std::streamsize>(stagingBuffer->getByteSize()));
+
+		stagingBuffer->unmap();
+
+		if (!file)
+			return false;
+	}
+
+	// Upload every mip level & layer
+	std::vector<Ptr<Image>> images;
+	images.reserve(headers.size());
+
+	auto commandBuffer = beginCommands();
+
+	for (size_t i = 0; i < headers.size(); i++)
+	{
+		const auto& header = headers[i];
+		const auto& stagingBuffer = stagingBuffers[i];
+
+		Image::Settings imageSettings;
+		imageSettings.format = static_cast<ImageFormat>(header.format);
+		imageSettings.type = ImageType::CubeMap;
+		imageSettings.width = header.size;
+		imageSettings.height = header.size;
+		imageSettings.layers = header.layers;
+		imageSettings.mipLevels = header.mipLevels;
+		imageSettings.usages = usages | ImageUsage::TransferDst;
+
+		auto& image = images.emplace_back(Image::create(imageSettings));
+
+		commandBuffer->imageBarrier(*image, ImageBarrier::InitializeTransferDst);
+
+		forEachLayer(header, [&](size_t offset, uint32_t mipLevel, uint32_t layer)
+			{
+				commandBuffer->copyBufferToImage(*stagingBuffer, *image, ImageLayout::TransferDst, offset, mipLevel, layer);
+			});
+
+		commandBuffer->imageBarrier(*image, ImageBarrier::TransferDstToFragmentShaderRead);
+	}
+
+	submitCommands(commandBuffer);
+
+	cubemaps = std::move(images);
+
+	return true;
+}
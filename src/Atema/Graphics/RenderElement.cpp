@@ -21,13 +21,186 @@
 
 #include <Atema/Graphics/RenderElement.hpp>
 
+#include <algorithm>
+#include <limits>
+
 using namespace at;
 
+namespace
+{
+	// Gaps of culled meshlets shorter than this are drawn anyway : an additional draw call costs more
+	constexpr uint32_t MinCulledMeshletCount = 4;
+
+	// Largest scale applied by the matrix to a vector
+	float getMaxScale(const Matrix4f& matrix)
+	{
+		float scale = 0.0f;
+		for (size_t i = 0; i < 3; i++)
+			scale = std::max(scale, Vector3f(matrix[i].x, matrix[i].y, matrix[i].z).getNorm());
+
+		return scale;
+	}
+}
+
 RenderElement::RenderElement() :
 	vertexBuffer(nullptr),
 	indexBuffer(nullptr),
+	firstIndex(0),
+	indexCount(0),
+	meshlets(nullptr),
+	meshletCount(0),
+	lods(nullptr),
+	lodCount(0),
+	lodIndex(0),
+	texCoordsDensity(0.0f),
 	renderMaterialInstance(nullptr),
 	transformSetIndex(0),
 	transformDescriptorSet(nullptr)
 {
 }
+
+uint32_t RenderElement::getLodIndex(const Matrix4f& matrix, float maxError) const
+{
+	if (lodCount <= 1)
+		return 0;
+
+	const auto scale = getMaxScale(matrix);
+
+	// LODs errors are increasing
+	uint32_t index = 0;
+	while (index + 1 < lodCount && lods[index + 1].error * scale <= maxError)
+		index++;
+
+	return index;
+}
+
+uint32_t RenderElement::getLodIndex(const Matrix4f& matrix, const Vector3f& viewPosition, float maxErrorPerDistance) const
+{
+	if (lodCount <= 1)
+		return 0;
+
+	// Closest point of the AABB, the view being inside giving a null distance
+	const auto worldAABB = matrix * aabb;
+
+	Vector3f delta;
+	for (size_t i = 0; i < 3; i++)
+		delta[i] = std::max({ worldAABB.min[i] - viewPosition[i], 0.0f, viewPosition[i] - worldAABB.max[i] });
+
+	return getLodIndex(matrix, delta.getNorm() * maxErrorPerDistance);
+}
+
+void RenderElement::setLod(uint32_t index)
+{
+	if (index == lodIndex || index >= lodCount)
+		return;
+
+	const auto& currentLod = lods[lodIndex];
+	const auto& newLod = lods[index];
+
+	firstIndex = newLod.firstIndex;
+	indexCount = newLod.indexCount;
+
+	if (meshlets)
+	{
+		meshlets += static_cast<ptrdiff_t>(newLod.firstMeshlet) - static_cast<ptrdiff_t>(currentLod.firstMeshlet);
+		meshletCount = newLod.meshletCount;
+	}
+
+	lodIndex = index;
+}
+
+float RenderElement::getTextureSize(const Matrix4f& matrix, float pixelsPerUnit) const
+{
+	const auto density = texCoordsDensity * getMaxScale(matrix);
+
+	// Without any information, the whole texture is considered visible
+	if (density <= 0.0f)
+		return std::numeric_limits<float>::max();
+
+	// A pixel covers 1 / pixelsPerUnit world units, i.e. density / pixelsPerUnit UV units
+	return pixelsPerUnit / density;
+}
+
+float RenderElement::getTextureSize(const Matrix4f& matrix, const Vector3f& viewPosition, float pixelsPerUnit) const
+{
+	const auto worldAABB = matrix * aabb;
+
+	Vector3f delta;
+	for (size_t i = 0; i < 3; i++)
+		delta[i] = std::max({ worldAABB.min[i] - viewPosition[i], 0.0f, viewPosition[i] - worldAABB.max[i] });
+
+	const auto distance = delta.getNorm();
+
+	if (distance <= 0.0f)
+		return std::numeric_limits<float>::max();
+
+	return getTextureSize(matrix, pixelsPerUnit / distance);
+}
+
+void RenderElement::cullMeshlets(std::vector<RenderElement>& renderElements, const Matrix4f& matrix, const Frustumf* frustum, const Vector3f* viewPosition) const
+{
+	// Back faces may be visible if the pipeline doesn't discard them
+	const bool cullBackFaces = viewPosition && renderMaterialInstance && renderMaterialInstance->getRenderMaterial().isBackFaceCulled();
+
+	if (meshletCount <= 1 || (!frustum && !cullBackFaces))
+	{
+		renderElements.emplace_back(*this);
+		return;
+	}
+
+	// Normal cones are tested in mesh space, which stays valid with any scale
+	Vector3f localViewPosition;
+	if (cullBackFaces)
+		localViewPosition = matrix.createInverse().transformPosition(*viewPosition);
+
+	// Bounding spheres are transformed with the largest scale of the matrix
+	const auto radiusScale = getMaxScale(matrix);
+
+	// Visible range of meshlets
+	bool hasRange = false;
+	uint32_t rangeFirst = 0;
+	uint32_t rangeLast = 0;
+
+	const auto addRange = [this, &renderElements, &rangeFirst, &rangeLast]()
+	{
+		auto& renderElement = renderElements.emplace_back(*this);
+
+		renderElement.firstIndex = meshlets[rangeFirst].firstIndex;
+		renderElement.indexCount = meshlets[rangeLast].firstIndex + meshlets[rangeLast].indexCount - renderElement.firstIndex;
+		renderElement.meshlets = meshlets + rangeFirst;
+		renderElement.meshletCount = rangeLast - rangeFirst + 1;
+	};
+
+	for (uint32_t i = 0; i < meshletCount; i++)
+	{
+		const auto& meshlet = meshlets[i];
+
+		if (cullBackFaces && meshlet.isBackFacing(localViewPosition))
+			continue;
+
+		if (frustum)
+		{
+			const Spheref sphere(matrix.transformPosition(meshlet.boundingSphere.center), meshlet.boundingSphere.radius * radiusScale);
+
+			if (!frustum->intersects(sphere))
+				continue;
+		}
+
+		if (hasRange && i - rangeLast - 1 < MinCulledMeshletCount)
+		{
+			rangeLast = i;
+		}
+		else
+		{
+			if (hasRange)
+				addRange();
+
+			rangeFirst = i;
+			rangeLast = i;
+			hasRange = true;
+		}
+	}
+
+	if (hasRange)
+		addRange();
+}
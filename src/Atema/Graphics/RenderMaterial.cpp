@@ -144,6 +144,7 @@ RenderMaterial::RenderMaterial(RenderResourceManager& resourceManager, const Set
 	RenderResource(resourceManager),
 	m_material(settings.material),
 	m_id(settings.id),
+	m_backFaceCulled(settings.pipelineState.rasterization.cullMode & CullMode::Back),
 	m_needUpdate(true)
 {
 	auto& graphics = Graphics::instance();
@@ -159,8 +160,16 @@ RenderMaterial::RenderMaterial(RenderResourceManager& resourceManager, const Set
 	// Override vertex input
 	//TODO: Take multiple vertex buffers into account
 	pipelineSettings.state.vertexInput.inputs.clear();
-	for (const auto& input : vertexReflection.getInputs())
-		pipelineSettings.state.vertexInput.inputs.emplace_back(0, input.location, getVertexFormat(input.type));
+	if (settings.vertexFormat.has_value())
+	{
+		for (const auto& component : settings.vertexFormat->getComponents())
+			pipelineSettings.state.vertexInput.inputs.emplace_back(component.binding, component.location, component.format);
+	}
+	else
+	{
+		for (const auto& input : vertexReflection.getInputs())
+			pipelineSettings.state.vertexInput.inputs.emplace_back(0, input.location, getVertexFormat(input.type));
+	}
 
 	// DescriptorSetLayouts
 
@@ -171,7 +180,7 @@ RenderMaterial::RenderMaterial(RenderResourceManager& resourceManager, const Set
 	{
 		auto& binding = bindings[external.set][external.binding];
 
-		binding.type = getDefaultDescriptorType(external.type);
+		binding.type = getDefaultDescriptorType(external);
 		binding.count = getDescriptorBindingCount(external.type);
 		binding.binding = external.binding;
 		binding.shaderStages = ShaderStage::Vertex;
@@ -189,7 +198,7 @@ RenderMaterial::RenderMaterial(RenderResourceManager& resourceManager, const Set
 		{
 			auto& binding = set[external.binding];
 
-			binding.type = getDefaultDescriptorType(external.type);
+			binding.type = getDefaultDescriptorType(external);
 			binding.count = getDescriptorBindingCount(external.type);
 			binding.binding = external.binding;
 			binding.shaderStages = ShaderStage::Fragment;
@@ -201,7 +210,7 @@ RenderMaterial::RenderMaterial(RenderResourceManager& resourceManager, const Set
 		{
 			auto& binding = it->second;
 
-			if (binding.type != getDefaultDescriptorType(external.type))
+			if (binding.type != getDefaultDescriptorType(external))
 				ATEMA_ERROR("DescriptorSetBinding (set " + std::to_string(external.set) + ", binding " + std::to_string(external.binding) + ") type must be the same in vertex & fragment shaders");
 
 			if (binding.count != getDescriptorBindingCount(external.type))
@@ -235,10 +244,24 @@ RenderMaterial::RenderMaterial(RenderResourceManager& resourceManager, const Set
 		m_descriptorSetLayouts[setIndex] = std::move(descriptorSetLayout);
 	}
 
-	pipelineSettings.vertexShader = graphics.getShader(*graphics.getUberShader(*uberShader, AstShaderStage::Vertex));
-	pipelineSettings.fragmentShader = graphics.getShader(*graphics.getUberShader(*uberShader, AstShaderStage::Fragment));
+	auto vertexUberShader = graphics.getUberShader(*uberShader, AstShaderStage::Vertex);
+	auto fragmentUberShader = graphics.getUberShader(*uberShader, AstShaderStage::Fragment);
+
+	if (settings.asyncPipeline)
+	{
+		m_pipelineSettings = std::move(pipelineSettings);
+		m_vertexUberShader = std::move(vertexUberShader);
+		m_fragmentUberShader = std::move(fragmentUberShader);
+
+		updatePipeline();
+	}
+	else
+	{
+		pipelineSettings.vertexShader = graphics.getShader(*vertexUberShader);
+		pipelineSettings.fragmentShader = graphics.getShader(*fragmentUberShader);
 
-	m_pipeline = graphics.getGraphicsPipeline(pipelineSettings);
+		m_pipeline = graphics.getGraphicsPipeline(pipelineSettings);
+	}
 
 	m_connectionGuard.connect(m_material->onParameterUpdated, [this]()
 		{
@@ -256,8 +279,20 @@ RenderMaterial::ID RenderMaterial::getID() const noexcept
 	return m_id;
 }
 
+bool RenderMaterial::isReady() const noexcept
+{
+	return m_pipeline != nullptr;
+}
+
+bool RenderMaterial::isBackFaceCulled() const noexcept
+{
+	return m_backFaceCulled;
+}
+
 void RenderMaterial::bindTo(CommandBuffer& commandBuffer) const
 {
+	ATEMA_ASSERT(m_pipeline, "RenderMaterial pipeline is not ready");
+
 	commandBuffer.bindPipeline(*m_pipeline);
 
 	for (size_t set = 0; set < m_descriptorSets.size(); set++)
@@ -308,6 +343,9 @@ Ptr<DescriptorSet> RenderMaterial::createSet(size_t setIndex) const
 
 void RenderMaterial::updateResources()
 {
+	if (!m_pipeline)
+		updatePipeline();
+
 	if (m_needUpdate)
 	{
 		updateBindings(*this, m_material->getParameters(), m_parameters, m_descriptorSets, getResourceManager());
@@ -316,6 +354,30 @@ void RenderMaterial::updateResources()
 	}
 }
 
+void RenderMaterial::updatePipeline()
+{
+	auto& graphics = Graphics::instance();
+
+	// Both stages are compiled in parallel, then the pipeline is created once they are available
+	if (!m_pipelineSettings.vertexShader)
+		m_pipelineSettings.vertexShader = graphics.getShaderAsync(*m_vertexUberShader);
+
+	if (!m_pipelineSettings.fragmentShader)
+		m_pipelineSettings.fragmentShader = graphics.getShaderAsync(*m_fragmentUberShader);
+
+	if (!m_pipelineSettings.vertexShader || !m_pipelineSettings.fragmentShader)
+		return;
+
+	m_pipeline = graphics.getGraphicsPipelineAsync(m_pipelineSettings);
+
+	if (m_pipeline)
+	{
+		m_pipelineSettings = GraphicsPipeline::Settings();
+		m_vertexUberShader.reset();
+		m_fragmentUberShader.reset();
+	}
+}
+
 // RenderMaterialInstance
 RenderMaterialInstance::RenderMaterialInstance(const RenderMaterial& renderMaterial, const MaterialInstance& materialInstance, RenderMaterial::ID id) :
 	RenderResource(renderMaterial.getResourceManager()),
@@ -347,6 +409,11 @@ const RenderMaterial& RenderMaterialInstance::getRenderMaterial() const noexcept
 	return *m_renderMaterial;
 }
 
+const MaterialInstance& RenderMaterialInstance::getMaterialInstance() const noexcept
+{
+	return *m_materialInstance;
+}
+
 void RenderMaterialInstance::bindTo(CommandBuffer& commandBuffer) const
 {
 	for (size_t set = 0; set < m_descriptorSets.size(); set++)
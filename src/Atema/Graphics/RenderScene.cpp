@@ -22,10 +22,43 @@
 #include <Atema/Graphics/RenderScene.hpp>
 #include <Atema/Graphics/AbstractFrameRenderer.hpp>
 #include <Atema/Graphics/Material.hpp>
+#include <Atema/Graphics/PointLight.hpp>
+#include <Atema/Graphics/SpotLight.hpp>
 #include <Atema/Core/Benchmark.hpp>
 
 using namespace at;
 
+namespace
+{
+	// Returns false if the light has no bounded volume of influence
+	bool getLightAABB(const Light& light, AABBf& aabb)
+	{
+		switch (light.getType())
+		{
+			case LightType::Point:
+			{
+				const auto& pointLight = static_cast<const PointLight&>(light);
+
+				aabb = Spheref(pointLight.getPosition(), pointLight.getRadius()).getAABB();
+
+				return true;
+			}
+			case LightType::Spot:
+			{
+				const auto& spotLight = static_cast<const SpotLight&>(light);
+
+				aabb = Spheref(spotLight.getPosition(), spotLight.getRange()).getAABB();
+
+				return true;
+			}
+			default:
+				break;
+		}
+
+		return false;
+	}
+}
+
 RenderScene::RenderScene(RenderResourceManager& resourceManager, AbstractFrameRenderer& frameRenderer) :
 	RenderResource(resourceManager),
 	m_frameRenderer(&frameRenderer),
@@ -55,65 +88,108 @@ void RenderScene::setSkyBox(Ptr<SkyBox> skyBox)
 
 void RenderScene::addLight(Light& light)
 {
-	if (m_renderLightIndices.find(&light) == m_renderLightIndices.end())
+	if (m_renderLightData.find(&light) == m_renderLightData.end())
 	{
-		m_renderLights.emplace_back(std::make_shared<RenderLight>(getResourceManager(), light));
-		m_renderLightIndices[&light] = m_renderLights.size() - 1;
+		auto& renderLight = m_renderLights.emplace_back(std::make_shared<RenderLight>(getResourceManager(), light));
+
+		auto& data = m_renderLightData[&light];
+		data.index = m_renderLights.size() - 1;
+		data.handle = BoundingVolumeHierarchy<const RenderLight*>::InvalidHandle;
+
+		AABBf aabb;
+		if (getLightAABB(light, aabb))
+		{
+			data.handle = m_renderLightHierarchy.add(renderLight.get(), aabb);
+
+			data.connection = light.onLightDataUpdated.connect([this, &light, handle = data.handle]()
+				{
+					AABBf aabb;
+					getLightAABB(light, aabb);
+
+					m_renderLightHierarchy.update(handle, aabb);
+				});
+		}
+		else
+		{
+			m_globalRenderLights.emplace_back(renderLight.get());
+		}
 	}
 }
 
 void RenderScene::addRenderable(Renderable& renderable)
 {
-	if (m_renderObjectIndices.find(&renderable) == m_renderObjectIndices.end())
+	if (m_renderObjectData.find(&renderable) == m_renderObjectData.end())
 	{
-		m_renderObjects.emplace_back(renderable.createRenderObject(*this));
-		m_renderObjectIndices[&renderable] = m_renderObjects.size() - 1;
+		auto& renderObject = m_renderObjects.emplace_back(renderable.createRenderObject(*this));
+
+		auto& data = m_renderObjectData[&renderable];
+		data.index = m_renderObjects.size() - 1;
+		data.handle = m_renderObjectHierarchy.add(renderObject.get(), renderable.getAABB());
+		data.connection = renderable.onAABBUpdate.connect([this, &renderable, handle = data.handle]()
+			{
+				m_renderObjectHierarchy.update(handle, renderable.getAABB());
+			});
 	}
 }
 
 void RenderScene::removeLight(const Light& light)
 {
-	const auto it = m_renderLightIndices.find(&light);
+	const auto it = m_renderLightData.find(&light);
 
-	if (it != m_renderLightIndices.end())
+	if (it != m_renderLightData.end())
 	{
-		const size_t currentIndex = it->second;
+		const size_t currentIndex = it->second.index;
 
 		auto& current = m_renderLights[currentIndex];
 		auto& last = m_renderLights.back();
 
 		auto& lastLight = last->getLight();
 
+		if (it->second.handle != BoundingVolumeHierarchy<const RenderLight*>::InvalidHandle)
+		{
+			m_renderLightHierarchy.remove(it->second.handle);
+
+			it->second.connection.disconnect();
+		}
+		else
+		{
+			m_globalRenderLights.erase(std::find(m_globalRenderLights.begin(), m_globalRenderLights.end(), current.get()));
+		}
+
 		destroyAfterUse(std::move(current));
 
 		std::swap(current, last);
 		m_renderLights.resize(m_renderLights.size() - 1);
 
-		m_renderLightIndices[&lastLight] = currentIndex;
-		m_renderLightIndices.erase(it);
+		m_renderLightData[&lastLight].index = currentIndex;
+		m_renderLightData.erase(it);
 	}
 }
 
 void RenderScene::removeRenderable(const Renderable& renderable)
 {
-	const auto it = m_renderObjectIndices.find(&renderable);
+	const auto it = m_renderObjectData.find(&renderable);
 
-	if (it != m_renderObjectIndices.end())
+	if (it != m_renderObjectData.end())
 	{
-		const size_t currentIndex = it->second;
+		const size_t currentIndex = it->second.index;
 
 		auto& current = m_renderObjects[currentIndex];
 		auto& last = m_renderObjects.back();
 
 		auto& lastRenderable = last->getRenderable();
 
+		m_renderObjectHierarchy.remove(it->second.handle);
+
+		it->second.connection.disconnect();
+
 		destroyAfterUse(std::move(current));
 
 		std::swap(current, last);
 		m_renderObjects.resize(m_renderObjects.size() - 1);
 
-		m_renderObjectIndices[&lastRenderable] = currentIndex;
-		m_renderObjectIndices.erase(it);
+		m_renderObjectData[&lastRenderable].index = currentIndex;
+		m_renderObjectData.erase(it);
 	}
 }
 
@@ -122,6 +198,8 @@ void RenderScene::clear()
 	clearLights();
 	clearRenderables();
 
+	m_transformHierarchy.clear();
+
 	for (auto& [id, renderData] : m_renderMaterials)
 		renderData.connection.disconnect();
 	m_renderMaterials.clear();
@@ -133,7 +211,12 @@ void RenderScene::clear()
 
 void RenderScene::clearLights()
 {
-	m_renderLightIndices.clear();
+	for (auto& [light, data] : m_renderLightData)
+		data.connection.disconnect();
+
+	m_renderLightData.clear();
+	m_renderLightHierarchy.clear();
+	m_globalRenderLights.clear();
 
 	for (auto& resource : m_renderLights)
 		destroyAfterUse(std::move(resource));
@@ -143,7 +226,11 @@ void RenderScene::clearLights()
 
 void RenderScene::clearRenderables()
 {
-	m_renderObjectIndices.clear();
+	for (auto& [renderable, data] : m_renderObjectData)
+		data.connection.disconnect();
+
+	m_renderObjectData.clear();
+	m_renderObjectHierarchy.clear();
 
 	for (auto& resource : m_renderObjects)
 		destroyAfterUse(std::move(resource));
@@ -157,6 +244,28 @@ void RenderScene::recompileMaterials()
 	m_renderMaterials.clear();
 }
 
+void RenderScene::updateHierarchies(size_t threadCount)
+{
+	// Callbacks may update renderables & lights, so this must be done first
+	{
+		ATEMA_BENCHMARK("Transforms");
+
+		m_transformHierarchy.update(threadCount);
+	}
+
+	{
+		ATEMA_BENCHMARK("Objects hierarchy");
+
+		m_renderObjectHierarchy.build(threadCount);
+	}
+
+	{
+		ATEMA_BENCHMARK("Lights hierarchy");
+
+		m_renderLightHierarchy.build(threadCount);
+	}
+}
+
 const Camera& RenderScene::getCamera() const noexcept
 {
 	return *m_camera;
@@ -249,6 +358,31 @@ const std::vector<Ptr<RenderLight>>& RenderScene::getRenderLights() const noexce
 	return m_renderLights;
 }
 
+TransformHierarchy& RenderScene::getTransformHierarchy() noexcept
+{
+	return m_transformHierarchy;
+}
+
+const TransformHierarchy& RenderScene::getTransformHierarchy() const noexcept
+{
+	return m_transformHierarchy;
+}
+
+const BoundingVolumeHierarchy<const RenderObject*>& RenderScene::getRenderObjectHierarchy() const noexcept
+{
+	return m_renderObjectHierarchy;
+}
+
+const BoundingVolumeHierarchy<const RenderLight*>& RenderScene::getRenderLightHierarchy() const noexcept
+{
+	return m_renderLightHierarchy;
+}
+
+const std::vector<const RenderLight*>& RenderScene::getGlobalRenderLights() const noexcept
+{
+	return m_globalRenderLights;
+}
+
 void RenderScene::updateResources()
 {
 	{
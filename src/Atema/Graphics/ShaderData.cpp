@@ -106,6 +106,7 @@ TransformData::Layout::Layout(StructLayout structLayout)
 	BufferLayout bufferLayout(structLayout);
 
 	modelOffset = bufferLayout.addMatrix(BufferElementType::Float, 4, 4);
+	texCoordsQuantizationOffset = bufferLayout.add(BufferElementType::Float4);
 
 	initialize(bufferLayout);
 }
@@ -127,6 +128,7 @@ void TransformData::copyTo(void* dstData, StructLayout structLayout) const
 	const auto& layout = getLayout(structLayout);
 
 	mapMemory<Matrix4f>(dstData, layout.modelOffset) = model;
+	mapMemory<Vector4f>(dstData, layout.texCoordsQuantizationOffset) = texCoordsQuantization;
 }
 
 // ShadowData
@@ -295,7 +297,7 @@ void LightData::copyTo(void* dstData, StructLayout structLayout) const
 			const float radius = range * std::tan(angle / 2.0f);
 
 			const Vector3f& translation = spotLight->getPosition();
-			const Vector3f rotation = Quaternionf(Vector3f(0.0f, 0.0f, -1.0f), spotLight->getDirection()).toEulerAngles();
+			const Quaternionf rotation(Vector3f(0.0f, 0.0f, -1.0f), spotLight->getDirection());
 			const Vector3f scale(radius, radius, range);
 
 			transform = Transform(translation, rotation, scale).getMatrix();
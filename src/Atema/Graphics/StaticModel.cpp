@@ -25,6 +25,11 @@
 
 using namespace at;
 
+StaticModel::StaticModel() :
+	m_matrix(Matrix4f::createIdentity())
+{
+}
+
 Ptr<RenderObject> StaticModel::createRenderObject(RenderScene& renderScene)
 {
 	return std::make_shared<StaticRenderModel>(renderScene, *this);
@@ -48,23 +53,28 @@ void StaticModel::setModel(const Ptr<Model>& model)
 	onModelUpdate();
 }
 
-void StaticModel::setTransform(const Transform& transform)
+void StaticModel::setMatrix(const Matrix4f& matrix)
 {
-	m_transform = transform;
+	m_matrix = matrix;
 
 	updateAABB();
 
 	onTransformUpdate();
 }
 
+void StaticModel::setTransform(const Transform& transform)
+{
+	setMatrix(transform.getMatrix());
+}
+
 const Ptr<Model>& StaticModel::getModel() const noexcept
 {
 	return m_model;
 }
 
-const Transform& StaticModel::getTransform() const noexcept
+const Matrix4f& StaticModel::getMatrix() const noexcept
 {
-	return m_transform;
+	return m_matrix;
 }
 
 const AABBf& StaticModel::getAABB() const noexcept
@@ -77,5 +87,7 @@ void StaticModel::updateAABB()
 	if (!m_model)
 		return;
 
-	m_aabb = m_transform.getMatrix() * m_model->getAABB();
+	m_aabb = m_matrix * m_model->getAABB();
+
+	onAABBUpdate();
 }
@@ -33,12 +33,6 @@ StaticRenderModel::StaticRenderModel(RenderScene& renderScene, StaticModel& stat
 	m_modelValid(false),
 	m_transformValid(false)
 {
-	Buffer::Settings bufferSettings;
-	bufferSettings.usages = BufferUsage::Uniform | BufferUsage::TransferDst;
-	bufferSettings.byteSize = TransformData::getLayout().getByteSize();
-
-	m_transformBuffer = getResourceManager().createBuffer(bufferSettings);
-
 	m_connectionGuard.connect(staticModel.onModelUpdate, [this]()
 		{
 			m_modelValid = false;
@@ -63,34 +57,23 @@ size_t StaticRenderModel::getRenderElementsSize() const noexcept
 
 void StaticRenderModel::updateResources()
 {
-	if (!m_transformValid)
-	{
-		void* data = getResourceManager().mapBuffer(*m_transformBuffer);
-
-		mapMemory<Matrix4f>(data, 0) = m_staticModel->getTransform().getMatrix();
-
-		m_transformValid = true;
-	}
-	
 	if (!m_modelValid)
 	{
 		auto& renderScene = getRenderScene();
 		auto& model = *m_staticModel->getModel();
 
-		// Destroy previous descriptor sets
+		// Destroy previous transforms
 		for (auto& descriptorSet : m_transformDescriptorSets)
 			destroyAfterUse(std::move(descriptorSet));
 
-		// Update RenderMaterialInstances
-		std::vector<uint32_t> transformSetIndices;
-		transformSetIndices.reserve(model.getMaterialInstances().size());
+		for (auto& transformBuffer : m_transformBuffers)
+			destroyAfterUse(std::move(transformBuffer));
 
+		// Update RenderMaterialInstances
 		m_renderMaterialInstances.clear();
-		m_transformDescriptorSets.clear();
 		for (auto& materialInstance : model.getMaterialInstances())
 		{
 			auto& renderMaterialInstance = renderScene.getRenderMaterialInstance(*materialInstance);
-			const auto& renderMaterial = renderMaterialInstance.getRenderMaterial();
 
 			m_connectionGuard.connect(renderMaterialInstance.onDestroy, [this]()
 				{
@@ -98,32 +81,83 @@ void StaticRenderModel::updateResources()
 				});
 
 			m_renderMaterialInstances.emplace_back(&renderMaterialInstance);
-
-			const auto& transformBinding = renderMaterial.getBinding("TransformData");
-			auto descriptorSet = renderMaterial.createSet(transformBinding.set);
-			descriptorSet->update(transformBinding.binding, m_transformBuffer->getBuffer(), m_transformBuffer->getOffset(), m_transformBuffer->getSize());
-
-			m_transformDescriptorSets.emplace_back(std::move(descriptorSet));
-			transformSetIndices.emplace_back(transformBinding.set);
 		}
 
-		// Update RenderElements
+		// Update RenderElements & their transforms
+		Buffer::Settings bufferSettings;
+		bufferSettings.usages = BufferUsage::Uniform | BufferUsage::TransferDst;
+		bufferSettings.byteSize = TransformData::getLayout().getByteSize();
+
 		m_renderElements.clear();
+		m_vertexQuantizations.clear();
+		m_transformBuffers.clear();
+		m_transformDescriptorSets.clear();
 		for (const auto& mesh : model.getMeshes())
 		{
 			if (mesh->getMaterialID() >= m_renderMaterialInstances.size())
 				continue;
 
+			const auto& renderMaterialInstance = *m_renderMaterialInstances[mesh->getMaterialID()];
+			const auto& renderMaterial = renderMaterialInstance.getRenderMaterial();
+
+			auto transformBuffer = getResourceManager().createBuffer(bufferSettings);
+
+			const auto& transformBinding = renderMaterial.getBinding("TransformData");
+			auto descriptorSet = renderMaterial.createSet(transformBinding.set);
+			descriptorSet->update(transformBinding.binding, transformBuffer->getBuffer(), transformBuffer->getOffset(), transformBuffer->getSize());
+
 			auto& renderElement = m_renderElements.emplace_back();
 
 			renderElement.aabb = mesh->getAABB();
 			renderElement.vertexBuffer = mesh->getVertexBuffer().get();
 			renderElement.indexBuffer = mesh->getIndexBuffer().get();
-			renderElement.renderMaterialInstance = m_renderMaterialInstances[mesh->getMaterialID()];
-			renderElement.transformSetIndex = transformSetIndices[mesh->getMaterialID()];
-			renderElement.transformDescriptorSet = m_transformDescriptorSets[mesh->getMaterialID()].get();
+			renderElement.firstIndex = 0;
+			renderElement.indexCount = static_cast<uint32_t>(mesh->getIndexBuffer()->getSize());
+			renderElement.meshlets = mesh->getMeshlets().data();
+			renderElement.meshletCount = static_cast<uint32_t>(mesh->getMeshlets().size());
+
+			// The passes select the LOD, the finest one is drawn by default
+			const auto& lods = mesh->getLods();
+			if (!lods.empty())
+			{
+				renderElement.indexCount = lods[0].indexCount;
+				renderElement.lods = lods.data();
+				renderElement.lodCount = static_cast<uint32_t>(lods.size());
+
+				if (!mesh->getMeshlets().empty())
+					renderElement.meshletCount = lods[0].meshletCount;
+			}
+			renderElement.texCoordsDensity = mesh->getTexCoordsDensity();
+			renderElement.renderMaterialInstance = &renderMaterialInstance;
+			renderElement.transformSetIndex = transformBinding.set;
+			renderElement.transformDescriptorSet = descriptorSet.get();
+
+			m_vertexQuantizations.emplace_back(mesh->getVertexQuantization());
+			m_transformBuffers.emplace_back(std::move(transformBuffer));
+			m_transformDescriptorSets.emplace_back(std::move(descriptorSet));
 		}
 
 		m_modelValid = true;
+
+		// The new transforms need to be written
+		m_transformValid = false;
+	}
+
+	if (!m_transformValid)
+	{
+		const auto& matrix = m_staticModel->getMatrix();
+
+		for (size_t i = 0; i < m_transformBuffers.size(); i++)
+		{
+			const auto& quantization = m_vertexQuantizations[i];
+
+			TransformData transformData;
+			transformData.model = matrix * quantization.getPositionMatrix();
+			transformData.texCoordsQuantization = { quantization.texCoordsScale.x, quantization.texCoordsScale.y, quantization.texCoordsOffset.x, quantization.texCoordsOffset.y };
+
+			transformData.copyTo(getResourceManager().mapBuffer(*m_transformBuffers[i]));
+		}
+
+		m_transformValid = true;
 	}
 }
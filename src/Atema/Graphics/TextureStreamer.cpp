@@ -0,0 +1,473 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Graphics/TextureStreamer.hpp>
+#include <Atema/Graphics/AssetLoader.hpp>
+#include <Atema/Graphics/Graphics.hpp>
+#include <Atema/Graphics/Material.hpp>
+#include <Atema/Graphics/Loaders/DefaultImageLoader.hpp>
+#include <Atema/Renderer/Utils.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace at;
+
+namespace
+{
+	constexpr size_t DefaultBudget = 256 * 1024 * 1024;
+	constexpr uint32_t DefaultResidentSize = 64;
+
+	// Loads running at the same time, so the closest textures are not delayed by the whole scene
+	constexpr size_t MaxLoadingCount = 8;
+
+	StdHash getTextureHash(const std::filesystem::path& path, const ImageLoader::Settings& settings)
+	{
+		StdHash hash = 0;
+
+		DefaultStdHasher::hashCombine(hash, path);
+		DefaultStdHasher::hashCombine(hash, settings.mipLevels);
+		DefaultStdHasher::hashCombine(hash, settings.usages);
+		DefaultStdHasher::hashCombine(hash, settings.compression);
+		DefaultStdHasher::hashCombine(hash, settings.mipFilter);
+		DefaultStdHasher::hashCombine(hash, settings.srgb);
+		DefaultStdHasher::hashCombine(hash, settings.cacheDirectory);
+
+		return hash;
+	}
+
+	// Images are uploaded by the streamer itself
+	ImageLoader::Settings getLoaderSettings(const ImageLoader::Settings& settings)
+	{
+		ImageLoader::Settings loaderSettings = settings;
+		loaderSettings.commandBuffer = nullptr;
+		loaderSettings.stagingBuffers = nullptr;
+
+		return loaderSettings;
+	}
+}
+
+TextureStreamer::TextureStreamer() :
+	m_enabled(false),
+	m_budget(DefaultBudget),
+	m_residentSize(DefaultResidentSize),
+	m_streamedByteSize(0),
+	m_loadingByteSize(0),
+	m_loadingCount(0),
+	m_updateIndex(0)
+{
+}
+
+TextureStreamer::~TextureStreamer()
+{
+}
+
+TextureStreamer& TextureStreamer::instance()
+{
+	static TextureStreamer s_instance;
+
+	return s_instance;
+}
+
+void TextureStreamer::setEnabled(bool enabled)
+{
+	m_enabled = enabled;
+}
+
+bool TextureStreamer::isEnabled() const noexcept
+{
+	return m_enabled;
+}
+
+void TextureStreamer::setBudget(size_t byteSize)
+{
+	std::lock_guard lockGuard(m_mutex);
+
+	m_budget = byteSize;
+}
+
+size_t TextureStreamer::getBudget() const noexcept
+{
+	return m_budget;
+}
+
+void TextureStreamer::setResidentSize(uint32_t size)
+{
+	std::lock_guard lockGuard(m_mutex);
+
+	m_residentSize = std::max(size, 1u);
+}
+
+uint32_t TextureStreamer::getResidentSize() const noexcept
+{
+	return m_residentSize;
+}
+
+size_t TextureStreamer::getStreamedByteSize() const
+{
+	std::lock_guard lockGuard(m_mutex);
+
+	return m_streamedByteSize + m_loadingByteSize;
+}
+
+void TextureStreamer::setParameter(MaterialInstance& materialInstance, const std::string& name, const std::filesystem::path& path, const Ptr<Sampler>& sampler, const ImageLoader::Settings& settings)
+{
+	const auto hash = getTextureHash(path, settings);
+
+	Ptr<Texture> texture;
+
+	{
+		std::lock_guard lockGuard(m_mutex);
+
+		const auto it = m_textures.find(hash);
+
+		if (it != m_textures.end())
+			texture = it->second;
+	}
+
+	// Resident levels are loaded without locking, so other threads can register textures meanwhile
+	if (!texture)
+	{
+		texture = createTexture(path, settings);
+
+		if (!texture)
+		{
+			materialInstance.setParameter(name, Graphics::instance().getImage(path, settings), sampler);
+
+			return;
+		}
+
+		texture->hash = hash;
+	}
+
+	std::lock_guard lockGuard(m_mutex);
+
+	// Replace the texture previously set for this parameter, if any
+	removeUsages(&materialInstance, &name);
+
+	// Another thread may have registered the same texture in the meantime
+	texture = m_textures.emplace(hash, texture).first->second;
+
+	auto& instance = m_instances[&materialInstance];
+
+	if (instance.textures.empty())
+	{
+		instance.connectionGuard.connect(materialInstance.onDestroy, [this, &materialInstance]()
+			{
+				std::lock_guard lockGuard(m_mutex);
+
+				removeUsages(&materialInstance, nullptr);
+			});
+	}
+
+	instance.textures.emplace_back(texture);
+
+	texture->usages.push_back({ &materialInstance, name, sampler });
+
+	materialInstance.setParameter(name, texture->image, sampler);
+}
+
+void TextureStreamer::request(const MaterialInstance& materialInstance, float textureSize)
+{
+	std::lock_guard lockGuard(m_mutex);
+
+	const auto it = m_instances.find(&materialInstance);
+
+	if (it == m_instances.end())
+		return;
+
+	for (auto& texture : it->second.textures)
+		texture->requestedSize = std::max(texture->requestedSize, textureSize);
+}
+
+void TextureStreamer::update()
+{
+	std::lock_guard lockGuard(m_mutex);
+
+	m_updateIndex++;
+
+	// Textures needing finer levels than their current ones
+	std::vector<Ptr<Texture>> loadedTextures;
+
+	for (auto& [hash, texture] : m_textures)
+	{
+		if (texture->requestedSize <= 0.0f)
+			continue;
+
+		texture->requestedMipLevel = getMipLevel(*texture, texture->requestedSize);
+		texture->requestedSize = 0.0f;
+		texture->lastRequest = m_updateIndex;
+
+		if (!texture->loading && texture->requestedMipLevel < texture->mipLevel)
+			loadedTextures.emplace_back(texture);
+	}
+
+	if (loadedTextures.empty() || m_loadingCount >= MaxLoadingCount)
+		return;
+
+	// Textures missing the most levels first
+	std::sort(loadedTextures.begin(), loadedTextures.end(), [](const Ptr<Texture>& a, const Ptr<Texture>& b)
+		{
+			return a->mipLevel - a->requestedMipLevel > b->mipLevel - b->requestedMipLevel;
+		});
+
+	// Streamed textures that may be evicted : the ones having finer levels than requested first, then the least recently requested
+	std::vector<Texture*> evictedTextures;
+
+	for (auto& [hash, texture] : m_textures)
+	{
+		const bool isOverResident = texture->mipLevel < texture->requestedMipLevel;
+
+		if (texture->byteSize > 0 && !texture->loading && (isOverResident || texture->lastRequest < m_updateIndex))
+			evictedTextures.emplace_back(texture.get());
+	}
+
+	std::sort(evictedTextures.begin(), evictedTextures.end(), [](const Texture* a, const Texture* b)
+		{
+			const bool aOverResident = a->mipLevel < a->requestedMipLevel;
+			const bool bOverResident = b->mipLevel < b->requestedMipLevel;
+
+			if (aOverResident != bOverResident)
+				return aOverResident;
+
+			return a->lastRequest < b->lastRequest;
+		});
+
+	size_t evictionIndex = 0;
+
+	for (auto& texture : loadedTextures)
+	{
+		if (m_loadingCount >= MaxLoadingCount)
+			break;
+
+		// The current streamed image is released once the new one is loaded
+		const auto getUsedByteSize = [this, &texture]()
+		{
+			return m_streamedByteSize + m_loadingByteSize - texture->byteSize;
+		};
+
+		auto mipLevel = texture->requestedMipLevel;
+		auto byteSize = getByteSize(*texture, mipLevel);
+
+		while (getUsedByteSize() + byteSize > m_budget && evictionIndex < evictedTextures.size())
+			evict(*evictedTextures[evictionIndex++]);
+
+		// Still not enough memory : take the finest levels that fit in the budget
+		while (mipLevel < texture->mipLevel && getUsedByteSize() + byteSize > m_budget)
+			byteSize = getByteSize(*texture, ++mipLevel);
+
+		if (mipLevel < texture->mipLevel)
+			load(texture, mipLevel, byteSize);
+	}
+}
+
+void TextureStreamer::clear()
+{
+	std::lock_guard lockGuard(m_mutex);
+
+	// Pending loads won't find their texture anymore
+	m_instances.clear();
+	m_textures.clear();
+
+	m_streamedByteSize = 0;
+	m_loadingByteSize = 0;
+	m_loadingCount = 0;
+}
+
+Ptr<TextureStreamer::Texture> TextureStreamer::createTexture(const std::filesystem::path& path, const ImageLoader::Settings& settings) const
+{
+	if (settings.type != ImageType::Image2D || settings.cacheDirectory.empty())
+		return nullptr;
+
+	auto texture = std::make_shared<Texture>();
+	texture->path = path;
+	texture->settings = getLoaderSettings(settings);
+
+	if (!DefaultImageLoader::loadMipChainInfo(path, settings, texture->info))
+		return nullptr;
+
+	// Coarsest levels fitting in the resident size
+	const auto& info = texture->info;
+
+	while (texture->residentMipLevel + 1 < info.mipLevels && std::max(info.width >> texture->residentMipLevel, info.height >> texture->residentMipLevel) > m_residentSize)
+		texture->residentMipLevel++;
+
+	ImageLoader::MipChain mipChain;
+
+	if (!DefaultImageLoader::loadMipChain(path, settings, mipChain, texture->residentMipLevel))
+		return nullptr;
+
+	texture->residentImage = ImageLoader::loadImage(mipChain, texture->settings);
+	texture->image = texture->residentImage;
+	texture->mipLevel = texture->residentMipLevel;
+	texture->requestedMipLevel = texture->residentMipLevel;
+
+	return texture;
+}
+
+uint32_t TextureStreamer::getMipLevel(const Texture& texture, float textureSize) const
+{
+	const auto size = static_cast<float>(std::max(texture.info.width, texture.info.height));
+
+	if (textureSize >= size)
+		return 0;
+
+	// Coarsest level still having at least one texel per pixel
+	const auto mipLevel = static_cast<uint32_t>(std::floor(std::log2(size / textureSize)));
+
+	return std::min(mipLevel, texture.residentMipLevel);
+}
+
+size_t TextureStreamer::getByteSize(const Texture& texture, uint32_t mipLevel) const
+{
+	const auto& info = texture.info;
+
+	size_t byteSize = 0;
+
+	for (uint32_t i = mipLevel; i < info.mipLevels; i++)
+		byteSize += at::getByteSize(info.format, std::max(info.width >> i, 1u), std::max(info.height >> i, 1u));
+
+	return byteSize;
+}
+
+void TextureStreamer::setImage(Texture& texture, const Ptr<Image>& image, uint32_t mipLevel, size_t byteSize)
+{
+	m_streamedByteSize = m_streamedByteSize - texture.byteSize + byteSize;
+
+	texture.image = image;
+	texture.mipLevel = mipLevel;
+	texture.byteSize = byteSize;
+
+	// Render material instances destroy the previous image once the frames using it are finished
+	for (auto& usage : texture.usages)
+		usage.materialInstance->setParameter(usage.name, image, usage.sampler);
+}
+
+void TextureStreamer::evict(Texture& texture)
+{
+	setImage(texture, texture.residentImage, texture.residentMipLevel, 0);
+}
+
+void TextureStreamer::load(const Ptr<Texture>& texture, uint32_t mipLevel, size_t byteSize)
+{
+	texture->loading = true;
+	texture->loadingByteSize = byteSize;
+
+	m_loadingByteSize += byteSize;
+	m_loadingCount++;
+
+	const auto path = texture->path;
+	const auto settings = texture->settings;
+
+	AssetLoader::instance().load<Image>([path, settings, mipLevel](AssetLoader::UploadContext& context) -> Ptr<Image>
+		{
+			ImageLoader::MipChain mipChain;
+
+			// The cache may have been removed, the texture then keeps its current levels
+			if (!DefaultImageLoader::loadMipChain(path, settings, mipChain, mipLevel))
+				return nullptr;
+
+			ImageLoader::Settings loaderSettings = settings;
+			loaderSettings.commandBuffer = context.commandBuffer;
+			loaderSettings.stagingBuffers = &context.stagingBuffers;
+
+			return ImageLoader::loadImage(mipChain, loaderSettings);
+		},
+		[this, weakTexture = WPtr<Texture>(texture), mipLevel](const Ptr<Image>& image)
+		{
+			onLoad(weakTexture, image, mipLevel);
+		});
+}
+
+void TextureStreamer::onLoad(const WPtr<Texture>& weakTexture, const Ptr<Image>& image, uint32_t mipLevel)
+{
+	std::lock_guard lockGuard(m_mutex);
+
+	// The texture was released while loading, along with its memory
+	auto texture = weakTexture.lock();
+
+	if (!texture || !texture->loading)
+		return;
+
+	texture->loading = false;
+
+	m_loadingByteSize -= texture->loadingByteSize;
+	m_loadingCount--;
+
+	if (image)
+		setImage(*texture, image, mipLevel, texture->loadingByteSize);
+
+	texture->loadingByteSize = 0;
+}
+
+void TextureStreamer::removeUsages(const MaterialInstance* materialInstance, const std::string* name)
+{
+	const auto instanceIt = m_instances.find(materialInstance);
+
+	if (instanceIt == m_instances.end())
+		return;
+
+	auto& textures = instanceIt->second.textures;
+
+	for (auto& texture : textures)
+	{
+		auto& usages = texture->usages;
+
+		usages.erase(std::remove_if(usages.begin(), usages.end(), [materialInstance, name](const Usage& usage)
+			{
+				return usage.materialInstance == materialInstance && (!name || usage.name == *name);
+			}), usages.end());
+
+		// Nobody uses this texture anymore : release it along with its memory
+		// It goes back to its resident levels, in case it is registered again right away
+		if (usages.empty() && m_textures.erase(texture->hash) > 0)
+		{
+			m_streamedByteSize -= texture->byteSize;
+
+			if (texture->loading)
+			{
+				m_loadingByteSize -= texture->loadingByteSize;
+				m_loadingCount--;
+			}
+
+			texture->image = texture->residentImage;
+			texture->mipLevel = texture->residentMipLevel;
+			texture->byteSize = 0;
+			texture->loading = false;
+			texture->loadingByteSize = 0;
+		}
+	}
+
+	// Keep the textures still used by this instance
+	textures.erase(std::remove_if(textures.begin(), textures.end(), [materialInstance](const Ptr<Texture>& texture)
+		{
+			for (const auto& usage : texture->usages)
+			{
+				if (usage.materialInstance == materialInstance)
+					return false;
+			}
+
+			return true;
+		}), textures.end());
+
+	if (textures.empty())
+		m_instances.erase(instanceIt);
+}
@@ -0,0 +1,372 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Graphics/TransformHierarchy.hpp>
+#include <Atema/Core/Error.hpp>
+#include <Atema/Core/TaskManager.hpp>
+
+#include <algorithm>
+
+using namespace at;
+
+namespace
+{
+	bool isSameTransform(const Transform& transform1, const Transform& transform2)
+	{
+		const auto& rotation1 = transform1.getRotation();
+		const auto& rotation2 = transform2.getRotation();
+
+		return transform1.getTranslation() == transform2.getTranslation()
+			&& transform1.getScale() == transform2.getScale()
+			&& rotation1.w == rotation2.w && rotation1.x == rotation2.x && rotation1.y == rotation2.y && rotation1.z == rotation2.z;
+	}
+}
+
+TransformHierarchy::TransformHierarchy() :
+	m_size(0),
+	m_sort(false)
+{
+}
+
+TransformHierarchy::Handle TransformHierarchy::add(const Transform& transform, Handle parent, Callback callback)
+{
+	ATEMA_ASSERT(parent == InvalidHandle || (parent < m_nodes.size() && m_nodes[parent].valid), "Invalid parent handle");
+
+	const auto handle = m_idManager.get();
+
+	if (handle >= m_nodes.size())
+		m_nodes.resize(handle + 1);
+
+	auto& node = m_nodes[handle];
+	node = Node();
+	node.index = m_handles.size();
+	node.valid = true;
+
+	// New nodes are appended until the next sort
+	m_handles.emplace_back(handle);
+	m_parentIndices.emplace_back(InvalidIndex);
+	m_transforms.emplace_back(transform);
+	m_matrices.emplace_back(transform.getMatrix());
+	m_callbacks.emplace_back(std::move(callback));
+	m_dirty.emplace_back(1);
+
+	if (parent != InvalidHandle)
+		attach(handle, parent);
+
+	m_size++;
+
+	m_sort = true;
+
+	return handle;
+}
+
+void TransformHierarchy::remove(Handle handle)
+{
+	ATEMA_ASSERT(handle < m_nodes.size() && m_nodes[handle].valid, "Invalid handle");
+
+	detach(handle);
+
+	removeNode(handle);
+
+	m_sort = true;
+}
+
+void TransformHierarchy::clear()
+{
+	m_idManager = IdManager<Handle>();
+	m_nodes.clear();
+	m_size = 0;
+	m_handles.clear();
+	m_parentIndices.clear();
+	m_transforms.clear();
+	m_matrices.clear();
+	m_callbacks.clear();
+	m_dirty.clear();
+	m_levelOffsets.clear();
+	m_sort = false;
+}
+
+void TransformHierarchy::setParent(Handle handle, Handle parent)
+{
+	ATEMA_ASSERT(handle < m_nodes.size() && m_nodes[handle].valid, "Invalid handle");
+	ATEMA_ASSERT(parent == InvalidHandle || (parent < m_nodes.size() && m_nodes[parent].valid), "Invalid parent handle");
+
+	if (m_nodes[handle].parent == parent)
+		return;
+
+	detach(handle);
+
+	if (parent != InvalidHandle)
+		attach(handle, parent);
+
+	m_dirty[m_nodes[handle].index] = 1;
+
+	m_sort = true;
+}
+
+void TransformHierarchy::setTransform(Handle handle, const Transform& transform)
+{
+	ATEMA_ASSERT(handle < m_nodes.size() && m_nodes[handle].valid, "Invalid handle");
+
+	const auto index = m_nodes[handle].index;
+
+	// Callers may set every transform each frame : only moved nodes are updated
+	if (isSameTransform(m_transforms[index], transform))
+		return;
+
+	m_transforms[index] = transform;
+	m_dirty[index] = 1;
+}
+
+void TransformHierarchy::setCallback(Handle handle, Callback callback)
+{
+	ATEMA_ASSERT(handle < m_nodes.size() && m_nodes[handle].valid, "Invalid handle");
+
+	m_callbacks[m_nodes[handle].index] = std::move(callback);
+}
+
+TransformHierarchy::Handle TransformHierarchy::getParent(Handle handle) const
+{
+	ATEMA_ASSERT(handle < m_nodes.size() && m_nodes[handle].valid, "Invalid handle");
+
+	return m_nodes[handle].parent;
+}
+
+const Transform& TransformHierarchy::getTransform(Handle handle) const
+{
+	ATEMA_ASSERT(handle < m_nodes.size() && m_nodes[handle].valid, "Invalid handle");
+
+	return m_transforms[m_nodes[handle].index];
+}
+
+const Matrix4f& TransformHierarchy::getMatrix(Handle handle) const
+{
+	ATEMA_ASSERT(handle < m_nodes.size() && m_nodes[handle].valid, "Invalid handle");
+
+	return m_matrices[m_nodes[handle].index];
+}
+
+size_t TransformHierarchy::getSize() const noexcept
+{
+	return m_size;
+}
+
+void TransformHierarchy::update(size_t threadCount)
+{
+	if (m_sort)
+		sort();
+
+	auto& taskManager = TaskManager::instance();
+
+	const auto maxThreadCount = taskManager.getSize();
+	if (threadCount == 0 || threadCount > maxThreadCount)
+		threadCount = maxThreadCount;
+
+	std::vector<Ptr<Task>> tasks;
+	tasks.reserve(threadCount);
+
+	// Each level only reads the matrices and dirty flags of the previous one
+	for (size_t level = 0; level + 1 < m_levelOffsets.size(); level++)
+	{
+		const auto levelBegin = m_levelOffsets[level];
+		const auto levelSize = m_levelOffsets[level + 1] - levelBegin;
+
+		const auto taskCount = std::min(threadCount, levelSize / ParallelUpdateThreshold);
+
+		if (taskCount <= 1)
+		{
+			updateRange(levelBegin, levelBegin + levelSize);
+
+			continue;
+		}
+
+		const auto taskSize = levelSize / taskCount;
+
+		for (size_t taskIndex = 0; taskIndex < taskCount; taskIndex++)
+		{
+			const auto begin = levelBegin + taskIndex * taskSize;
+			const auto end = taskIndex == taskCount - 1 ? levelBegin + levelSize : begin + taskSize;
+
+			tasks.emplace_back(taskManager.createTask([this, begin, end](size_t threadIndex)
+				{
+					updateRange(begin, end);
+				}));
+		}
+
+		for (auto& task : tasks)
+			task->wait();
+
+		tasks.clear();
+	}
+
+	std::fill(m_dirty.begin(), m_dirty.end(), static_cast<uint8_t>(0));
+}
+
+void TransformHierarchy::attach(Handle handle, Handle parent)
+{
+#ifndef ATEMA_DISABLE_ASSERT
+	for (auto ancestor = parent; ancestor != InvalidHandle; ancestor = m_nodes[ancestor].parent)
+		ATEMA_ASSERT(ancestor != handle, "A node can't be its own ancestor");
+#endif
+
+	auto& node = m_nodes[handle];
+	auto& parentNode = m_nodes[parent];
+
+	node.parent = parent;
+	node.nextSibling = parentNode.firstChild;
+	parentNode.firstChild = handle;
+}
+
+void TransformHierarchy::detach(Handle handle)
+{
+	auto& node = m_nodes[handle];
+
+	if (node.parent == InvalidHandle)
+		return;
+
+	auto* link = &m_nodes[node.parent].firstChild;
+
+	while (*link != handle)
+		link = &m_nodes[*link].nextSibling;
+
+	*link = node.nextSibling;
+
+	node.parent = InvalidHandle;
+	node.nextSibling = InvalidHandle;
+}
+
+void TransformHierarchy::removeNode(Handle handle)
+{
+	auto child = m_nodes[handle].firstChild;
+
+	while (child != InvalidHandle)
+	{
+		const auto nextSibling = m_nodes[child].nextSibling;
+
+		removeNode(child);
+
+		child = nextSibling;
+	}
+
+	const auto index = m_nodes[handle].index;
+
+	// The slot is discarded during the next sort
+	m_handles[index] = InvalidHandle;
+	m_callbacks[index] = nullptr;
+
+	m_nodes[handle] = Node();
+
+	m_idManager.release(handle);
+
+	m_size--;
+}
+
+void TransformHierarchy::sort()
+{
+	m_sort = false;
+
+	// Breadth-first traversal from every root
+	std::vector<Handle> handles;
+	handles.reserve(m_size);
+
+	for (Handle handle = 0; handle < m_nodes.size(); handle++)
+	{
+		const auto& node = m_nodes[handle];
+
+		if (node.valid && node.parent == InvalidHandle)
+			handles.emplace_back(handle);
+	}
+
+	m_levelOffsets.clear();
+	m_levelOffsets.emplace_back(0);
+
+	size_t levelBegin = 0;
+
+	while (levelBegin < handles.size())
+	{
+		const auto levelEnd = handles.size();
+
+		m_levelOffsets.emplace_back(levelEnd);
+
+		for (size_t i = levelBegin; i < levelEnd; i++)
+		{
+			for (auto child = m_nodes[handles[i]].firstChild; child != InvalidHandle; child = m_nodes[child].nextSibling)
+				handles.emplace_back(child);
+		}
+
+		levelBegin = levelEnd;
+	}
+
+	if (handles.empty())
+		m_levelOffsets.clear();
+
+	// Move node data to its new location
+	std::vector<size_t> parentIndices(handles.size());
+	std::vector<Transform> transforms(handles.size());
+	std::vector<Matrix4f> matrices(handles.size());
+	std::vector<Callback> callbacks(handles.size());
+	std::vector<uint8_t> dirty(handles.size());
+
+	for (size_t index = 0; index < handles.size(); index++)
+	{
+		auto& node = m_nodes[handles[index]];
+
+		const auto previousIndex = node.index;
+
+		// Parents come first, so their index is already up to date
+		parentIndices[index] = node.parent == InvalidHandle ? InvalidIndex : m_nodes[node.parent].index;
+		transforms[index] = std::move(m_transforms[previousIndex]);
+		matrices[index] = m_matrices[previousIndex];
+		callbacks[index] = std::move(m_callbacks[previousIndex]);
+		dirty[index] = m_dirty[previousIndex];
+
+		node.index = index;
+	}
+
+	m_handles = std::move(handles);
+	m_parentIndices = std::move(parentIndices);
+	m_transforms = std::move(transforms);
+	m_matrices = std::move(matrices);
+	m_callbacks = std::move(callbacks);
+	m_dirty = std::move(dirty);
+}
+
+void TransformHierarchy::updateRange(size_t begin, size_t end)
+{
+	for (size_t index = begin; index < end; index++)
+	{
+		const auto parentIndex = m_parentIndices[index];
+
+		if (parentIndex != InvalidIndex && m_dirty[parentIndex])
+			m_dirty[index] = 1;
+
+		if (!m_dirty[index])
+			continue;
+
+		if (parentIndex == InvalidIndex)
+			m_matrices[index] = m_transforms[index].getMatrix();
+		else
+			m_matrices[index] = m_matrices[parentIndex] * m_transforms[index].getMatrix();
+
+		if (m_callbacks[index])
+			m_callbacks[index](m_matrices[index]);
+	}
+}
@@ -198,6 +198,15 @@ VertexFormat VertexFormat::create(DefaultVertexFormat defaultFormat)
 				VertexComponent(VertexComponentType::Bitangent, 0, 4, VertexInputFormat::RGB32_SFLOAT)
 				});
 		}
+		case DefaultVertexFormat::XYZ_UV_NT_Quantized:
+		{
+			return std::vector<VertexComponent>({
+				VertexComponent(VertexComponentType::Position, 0, 0, VertexInputFormat::RGBA16_SNORM),
+				VertexComponent(VertexComponentType::TexCoords, 0, 1, VertexInputFormat::RG16_UNORM),
+				VertexComponent(VertexComponentType::Normal, 0, 2, VertexInputFormat::RG16_SNORM),
+				VertexComponent(VertexComponentType::Tangent, 0, 3, VertexInputFormat::RGBA8_SNORM)
+				});
+		}
 		default:
 			break;
 	}
@@ -225,3 +225,16 @@ const std::vector<VertexInput>& Vertex_XYZ_UV_NTB::getVertexInput()
 
 	return s_vertexInput;
 }
+
+const std::vector<VertexInput>& Vertex_XYZ_UV_NT_Quantized::getVertexInput()
+{
+	static const std::vector<VertexInput> s_vertexInput =
+	{
+		{ 0, 0, VertexInputFormat::RGBA16_SNORM },
+		{ 0, 1, VertexInputFormat::RG16_UNORM },
+		{ 0, 2, VertexInputFormat::RG16_SNORM },
+		{ 0, 3, VertexInputFormat::RGBA8_SNORM }
+	};
+
+	return s_vertexInput;
+}
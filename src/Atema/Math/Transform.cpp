@@ -24,18 +24,23 @@
 using namespace at;
 
 Transform::Transform() :
+	m_rotation(Quaternionf::createIdentity()),
 	m_scale(1.0f, 1.0f, 1.0f),
-	m_transformValid(false),
-	m_transform(1.0f)
+	m_matrix(Matrix4f::createIdentity())
 {
 }
 
-Transform::Transform(const Vector3f& translation, const Vector3f& rotation, const Vector3f& scale) :
+Transform::Transform(const Vector3f& translation, const Quaternionf& rotation, const Vector3f& scale) :
 	Transform()
 {
 	set(translation, rotation, scale);
 }
 
+Transform::Transform(const Vector3f& translation, const Vector3f& rotation, const Vector3f& scale) :
+	Transform(translation, Quaternionf(rotation), scale)
+{
+}
+
 Transform::~Transform()
 {
 }
@@ -47,13 +52,18 @@ Transform& Transform::translate(const Vector3f& translation)
 	return *this;
 }
 
-Transform& Transform::rotate(const Vector3f& rotation)
+Transform& Transform::rotate(const Quaternionf& rotation)
 {
-	setRotation(m_rotation + rotation);
+	setRotation(rotation * m_rotation);
 
 	return *this;
 }
 
+Transform& Transform::rotate(const Vector3f& rotation)
+{
+	return rotate(Quaternionf(rotation));
+}
+
 Transform& Transform::scale(const Vector3f& scale)
 {
 	setScale(m_scale + scale);
@@ -61,34 +71,46 @@ Transform& Transform::scale(const Vector3f& scale)
 	return *this;
 }
 
-void Transform::set(const Vector3f& translation, const Vector3f& rotation, const Vector3f& scale)
+void Transform::set(const Vector3f& translation, const Quaternionf& rotation, const Vector3f& scale)
 {
 	m_translation = translation;
-	m_rotation = rotation;
+	m_rotation = rotation.getNormalized();
 	m_scale = scale;
 
-	m_transformValid = false;
+	updateMatrix();
+}
+
+void Transform::set(const Vector3f& translation, const Vector3f& rotation, const Vector3f& scale)
+{
+	set(translation, Quaternionf(rotation), scale);
 }
 
 void Transform::setTranslation(const Vector3f& translation)
 {
 	m_translation = translation;
 
-	m_transformValid = false;
+	for (size_t i = 0; i < 3; i++)
+		m_matrix[3][i] = m_translation[i];
 }
 
-void Transform::setRotation(const Vector3f& rotation)
+void Transform::setRotation(const Quaternionf& rotation)
 {
-	m_rotation = rotation;
+	// Repeated rotations accumulate floating point errors
+	m_rotation = rotation.getNormalized();
 
-	m_transformValid = false;
+	updateMatrix();
+}
+
+void Transform::setRotation(const Vector3f& rotation)
+{
+	setRotation(Quaternionf(rotation));
 }
 
 void Transform::setScale(const Vector3f& scale)
 {
 	m_scale = scale;
 
-	m_transformValid = false;
+	updateMatrix();
 }
 
 const Vector3f& Transform::getTranslation() const noexcept
@@ -96,7 +118,7 @@ const Vector3f& Transform::getTranslation() const noexcept
 	return m_translation;
 }
 
-const Vector3f& Transform::getRotation() const noexcept
+const Quaternionf& Transform::getRotation() const noexcept
 {
 	return m_rotation;
 }
@@ -108,18 +130,16 @@ const Vector3f& Transform::getScale() const noexcept
 
 const Matrix4f& Transform::getMatrix() const noexcept
 {
-	if (!m_transformValid)
+	return m_matrix;
+}
+
+void Transform::updateMatrix()
+{
+	m_matrix = Matrix4f::createRotation(m_rotation);
+
+	for (size_t i = 0; i < 3; i++)
 	{
-		m_transform = Matrix4f::createRotation(m_rotation);
-		
-		for (size_t i = 0; i < 3; i++)
-		{
-			m_transform[i] *= m_scale[i];
-			m_transform[3][i] = m_translation[i];
-		}
-		
-		m_transformValid = true;
+		m_matrix[i] *= m_scale[i];
+		m_matrix[3][i] = m_translation[i];
 	}
-
-	return m_transform;
 }
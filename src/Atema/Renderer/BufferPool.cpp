@@ -22,6 +22,8 @@
 #include <Atema/Renderer/BufferPool.hpp>
 #include <Atema/Renderer/Renderer.hpp>
 
+#include <algorithm>
+
 using namespace at;
 
 // BufferAllocation
@@ -67,8 +69,18 @@ BufferPool::BufferPool(Flags<BufferUsage> usages, size_t pageSize, bool releaseO
 	AllocationPool(pageSize, releaseOnClear),
 	m_usages(usages)
 {
+	const auto& limits = Renderer::instance().getLimits();
+
+	size_t alignment = 0;
+
 	if (m_usages & BufferUsage::Uniform)
-		initialize(Renderer::instance().getLimits().minUniformBufferOffsetAlignment);
+		alignment = std::max(alignment, static_cast<size_t>(limits.minUniformBufferOffsetAlignment));
+
+	if (m_usages & BufferUsage::Storage)
+		alignment = std::max(alignment, static_cast<size_t>(limits.minStorageBufferOffsetAlignment));
+
+	if (alignment > 0)
+		initialize(alignment);
 }
 
 Flags<BufferUsage> BufferPool::getUsages() const noexcept
@@ -134,6 +134,36 @@ bool Renderer::isStencilImageFormat(ImageFormat format)
 	return false;
 }
 
+bool Renderer::isCompressedImageFormat(ImageFormat format)
+{
+	switch (format)
+	{
+		case ImageFormat::BC1_RGB_UNORM:
+		case ImageFormat::BC1_RGB_SRGB:
+		case ImageFormat::BC1_RGBA_UNORM:
+		case ImageFormat::BC1_RGBA_SRGB:
+		case ImageFormat::BC3_UNORM:
+		case ImageFormat::BC3_SRGB:
+		case ImageFormat::BC4_UNORM:
+		case ImageFormat::BC4_SNORM:
+		case ImageFormat::BC5_UNORM:
+		case ImageFormat::BC5_SNORM:
+		case ImageFormat::BC6H_UFLOAT:
+		case ImageFormat::BC6H_SFLOAT:
+		case ImageFormat::BC7_UNORM:
+		case ImageFormat::BC7_SRGB:
+		{
+			return true;
+		}
+		default:
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
 const Hash Renderer::getID() const noexcept
 {
 	return m_hashType;
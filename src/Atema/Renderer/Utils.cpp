@@ -21,6 +21,7 @@
 
 #include <Atema/Renderer/Utils.hpp>
 #include <Atema/Core/Error.hpp>
+#include <Atema/Renderer/Renderer.hpp>
 
 using namespace at;
 
@@ -93,6 +94,10 @@ DescriptorType at::getDefaultDescriptorType(const AstType& astVariableType)
 	{
 		return DescriptorType::CombinedImageSampler;
 	}
+	else if (astVariableType.is<AstStorageImageType>())
+	{
+		return DescriptorType::StorageImage;
+	}
 	else if (astVariableType.isOneOf<AstPrimitiveType, AstVectorType, AstMatrixType, AstStructType>())
 	{
 		return DescriptorType::UniformBuffer;
@@ -113,6 +118,10 @@ DescriptorType at::getDefaultDescriptorType(const AstArrayType::ComponentType& a
 	{
 		return DescriptorType::CombinedImageSampler;
 	}
+	else if (astVariableType.is<AstStorageImageType>())
+	{
+		return DescriptorType::StorageImage;
+	}
 	else if (astVariableType.isOneOf<AstPrimitiveType, AstVectorType, AstMatrixType, AstStructType>())
 	{
 		return DescriptorType::UniformBuffer;
@@ -123,6 +132,14 @@ DescriptorType at::getDefaultDescriptorType(const AstArrayType::ComponentType& a
 	return DescriptorType::UniformBuffer;
 }
 
+DescriptorType at::getDefaultDescriptorType(const AstExternal& astExternal)
+{
+	if (astExternal.structLayout == StructLayout::Std430)
+		return DescriptorType::StorageBuffer;
+
+	return getDefaultDescriptorType(astExternal.type);
+}
+
 uint32_t at::getDescriptorBindingCount(const AstType& astVariableType)
 {
 	if (astVariableType.is<AstArrayType>())
@@ -277,6 +294,49 @@ size_t at::getByteSize(ImageFormat format)
 	return 0;
 }
 
+size_t at::getByteSize(ImageFormat format, uint32_t width, uint32_t height)
+{
+	if (Renderer::isCompressedImageFormat(format))
+	{
+		// Partial blocks are stored entirely
+		const size_t blockCountX = (static_cast<size_t>(width) + 3) / 4;
+		const size_t blockCountY = (static_cast<size_t>(height) + 3) / 4;
+
+		return blockCountX * blockCountY * getBlockByteSize(format);
+	}
+
+	return static_cast<size_t>(width) * static_cast<size_t>(height) * getByteSize(format);
+}
+
+size_t at::getBlockByteSize(ImageFormat format)
+{
+	switch (format)
+	{
+		case ImageFormat::BC1_RGB_UNORM:
+		case ImageFormat::BC1_RGB_SRGB:
+		case ImageFormat::BC1_RGBA_UNORM:
+		case ImageFormat::BC1_RGBA_SRGB:
+		case ImageFormat::BC4_UNORM:
+		case ImageFormat::BC4_SNORM:
+			return 8;
+		case ImageFormat::BC3_UNORM:
+		case ImageFormat::BC3_SRGB:
+		case ImageFormat::BC5_UNORM:
+		case ImageFormat::BC5_SNORM:
+		case ImageFormat::BC6H_UFLOAT:
+		case ImageFormat::BC6H_SFLOAT:
+		case ImageFormat::BC7_UNORM:
+		case ImageFormat::BC7_SRGB:
+			return 16;
+		default:
+		{
+			ATEMA_ERROR("Invalid image format");
+		}
+	}
+
+	return 0;
+}
+
 size_t at::getComponentCount(ImageFormat format)
 {
 	switch (format)
@@ -304,6 +364,8 @@ size_t at::getComponentCount(ImageFormat format)
 		case ImageFormat::R64_SFLOAT:
 		case ImageFormat::D16_UNORM:
 		case ImageFormat::D32_SFLOAT:
+		case ImageFormat::BC4_UNORM:
+		case ImageFormat::BC4_SNORM:
 			return 1;
 		case ImageFormat::RG8_UNORM:
 		case ImageFormat::RG8_SNORM:
@@ -328,6 +390,8 @@ size_t at::getComponentCount(ImageFormat format)
 		case ImageFormat::D16_UNORM_S8_UINT:
 		case ImageFormat::D24_UNORM_S8_UINT:
 		case ImageFormat::D32_SFLOAT_S8_UINT:
+		case ImageFormat::BC5_UNORM:
+		case ImageFormat::BC5_SNORM:
 			return 2;
 		case ImageFormat::RGB8_UNORM:
 		case ImageFormat::RGB8_SNORM:
@@ -356,6 +420,10 @@ size_t at::getComponentCount(ImageFormat format)
 		case ImageFormat::RGB64_UINT:
 		case ImageFormat::RGB64_SINT:
 		case ImageFormat::RGB64_SFLOAT:
+		case ImageFormat::BC1_RGB_UNORM:
+		case ImageFormat::BC1_RGB_SRGB:
+		case ImageFormat::BC6H_UFLOAT:
+		case ImageFormat::BC6H_SFLOAT:
 			return 3;
 		case ImageFormat::RGBA8_UNORM:
 		case ImageFormat::RGBA8_SNORM:
@@ -384,6 +452,12 @@ size_t at::getComponentCount(ImageFormat format)
 		case ImageFormat::RGBA64_UINT:
 		case ImageFormat::RGBA64_SINT:
 		case ImageFormat::RGBA64_SFLOAT:
+		case ImageFormat::BC1_RGBA_UNORM:
+		case ImageFormat::BC1_RGBA_SRGB:
+		case ImageFormat::BC3_UNORM:
+		case ImageFormat::BC3_SRGB:
+		case ImageFormat::BC7_UNORM:
+		case ImageFormat::BC7_SRGB:
 			return 4;
 		default:
 		{
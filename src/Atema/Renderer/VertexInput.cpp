@@ -57,6 +57,8 @@ size_t VertexInput::getByteSize() const
 		}
 		case VertexInputFormat::RGBA8_UINT:
 		case VertexInputFormat::RGBA8_SINT:
+		case VertexInputFormat::RGBA8_UNORM:
+		case VertexInputFormat::RGBA8_SNORM:
 		{
 			return 4;
 		}
@@ -68,6 +70,8 @@ size_t VertexInput::getByteSize() const
 		}
 		case VertexInputFormat::RG16_UINT:
 		case VertexInputFormat::RG16_SINT:
+		case VertexInputFormat::RG16_UNORM:
+		case VertexInputFormat::RG16_SNORM:
 		case VertexInputFormat::RG16_SFLOAT:
 		{
 			return 4;
@@ -80,6 +84,8 @@ size_t VertexInput::getByteSize() const
 		}
 		case VertexInputFormat::RGBA16_UINT:
 		case VertexInputFormat::RGBA16_SINT:
+		case VertexInputFormat::RGBA16_UNORM:
+		case VertexInputFormat::RGBA16_SNORM:
 		case VertexInputFormat::RGBA16_SFLOAT:
 		{
 			return 8;
@@ -161,6 +167,8 @@ size_t VertexInput::getElementSize() const
 		case VertexInputFormat::RG8_SINT:
 		case VertexInputFormat::RG16_UINT:
 		case VertexInputFormat::RG16_SINT:
+		case VertexInputFormat::RG16_UNORM:
+		case VertexInputFormat::RG16_SNORM:
 		case VertexInputFormat::RG16_SFLOAT:
 		case VertexInputFormat::RG32_UINT:
 		case VertexInputFormat::RG32_SINT:
@@ -183,8 +191,12 @@ size_t VertexInput::getElementSize() const
 			return 3;
 		case VertexInputFormat::RGBA8_UINT:
 		case VertexInputFormat::RGBA8_SINT:
+		case VertexInputFormat::RGBA8_UNORM:
+		case VertexInputFormat::RGBA8_SNORM:
 		case VertexInputFormat::RGBA16_UINT:
 		case VertexInputFormat::RGBA16_SINT:
+		case VertexInputFormat::RGBA16_UNORM:
+		case VertexInputFormat::RGBA16_SNORM:
 		case VertexInputFormat::RGBA16_SFLOAT:
 		case VertexInputFormat::RGBA32_UINT:
 		case VertexInputFormat::RGBA32_SINT:
@@ -226,3 +238,19 @@ bool VertexInput::isFloatingPoint() const
 
 	return false;
 }
+
+bool VertexInput::isNormalized() const
+{
+	switch (format)
+	{
+		case VertexInputFormat::RGBA8_UNORM:
+		case VertexInputFormat::RGBA8_SNORM:
+		case VertexInputFormat::RG16_UNORM:
+		case VertexInputFormat::RG16_SNORM:
+		case VertexInputFormat::RGBA16_UNORM:
+		case VertexInputFormat::RGBA16_SNORM:
+			return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,189 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Shader/Ast/AstAllocator.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+using namespace at;
+
+namespace
+{
+	constexpr size_t SizeClassCount = AstAllocator::MaxBlockSize / AstAllocator::BlockAlignment;
+
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	size_t getSizeClass(size_t size)
+	{
+		return (size + AstAllocator::BlockAlignment - 1) / AstAllocator::BlockAlignment - 1;
+	}
+
+	size_t getBlockSize(size_t sizeClass)
+	{
+		return (sizeClass + 1) * AstAllocator::BlockAlignment;
+	}
+
+	// Free blocks given back by exited threads
+	struct GlobalPool
+	{
+		std::mutex mutex;
+		std::atomic<size_t> freeListCount{ 0 };
+		FreeBlock* freeLists[SizeClassCount] = {};
+	};
+
+	// Never destroyed : nodes owned by static objects may be released after the other statics
+	GlobalPool& getGlobalPool()
+	{
+		static GlobalPool* s_pool = new GlobalPool();
+
+		return *s_pool;
+	}
+
+	// Trivially destructible, so it remains usable during static destruction
+	struct ThreadCache
+	{
+		FreeBlock* freeLists[SizeClassCount];
+		char* page;
+		size_t pageRemainingSize;
+	};
+
+	thread_local ThreadCache t_cache = {};
+
+	struct ThreadCacheReleaser
+	{
+		~ThreadCacheReleaser()
+		{
+			auto& pool = getGlobalPool();
+
+			std::lock_guard<std::mutex> lock(pool.mutex);
+
+			for (size_t sizeClass = 0; sizeClass < SizeClassCount; sizeClass++)
+			{
+				auto first = t_cache.freeLists[sizeClass];
+
+				if (!first)
+					continue;
+
+				auto last = first;
+				while (last->next)
+					last = last->next;
+
+				if (!pool.freeLists[sizeClass])
+					pool.freeListCount++;
+
+				last->next = pool.freeLists[sizeClass];
+				pool.freeLists[sizeClass] = first;
+
+				t_cache.freeLists[sizeClass] = nullptr;
+			}
+		}
+	};
+
+	ThreadCache& getThreadCache()
+	{
+		thread_local ThreadCacheReleaser t_releaser;
+
+		return t_cache;
+	}
+
+	FreeBlock* acquireGlobalFreeList(size_t sizeClass)
+	{
+		auto& pool = getGlobalPool();
+
+		if (pool.freeListCount.load(std::memory_order_relaxed) == 0)
+			return nullptr;
+
+		std::lock_guard<std::mutex> lock(pool.mutex);
+
+		auto freeList = pool.freeLists[sizeClass];
+
+		if (freeList)
+		{
+			pool.freeLists[sizeClass] = nullptr;
+			pool.freeListCount--;
+		}
+
+		return freeList;
+	}
+}
+
+void* AstAllocator::allocate(size_t size)
+{
+	if (size > MaxBlockSize)
+		return ::operator new(size);
+
+	auto& cache = getThreadCache();
+
+	const auto sizeClass = getSizeClass(size);
+
+	auto& freeList = cache.freeLists[sizeClass];
+
+	if (!freeList)
+		freeList = acquireGlobalFreeList(sizeClass);
+
+	// Recycle a released block
+	if (freeList)
+	{
+		auto block = freeList;
+		freeList = block->next;
+
+		return block;
+	}
+
+	// Carve a new block from the current page (the end of a full page is lost)
+	const auto blockSize = getBlockSize(sizeClass);
+
+	if (cache.pageRemainingSize < blockSize)
+	{
+		cache.page = static_cast<char*>(::operator new(PageSize));
+		cache.pageRemainingSize = PageSize;
+	}
+
+	auto block = cache.page;
+
+	cache.page += blockSize;
+	cache.pageRemainingSize -= blockSize;
+
+	return block;
+}
+
+void AstAllocator::release(void* ptr, size_t size) noexcept
+{
+	if (!ptr)
+		return;
+
+	if (size > MaxBlockSize)
+	{
+		::operator delete(ptr);
+		return;
+	}
+
+	auto& freeList = getThreadCache().freeLists[getSizeClass(size)];
+
+	auto block = static_cast<FreeBlock*>(ptr);
+	block->next = freeList;
+	freeList = block;
+}
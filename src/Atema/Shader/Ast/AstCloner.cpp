@@ -223,6 +223,7 @@ UPtr<EntryFunctionDeclarationStatement> AstCloner::clone(const EntryFunctionDecl
 	auto cloneStatement = std::make_unique<EntryFunctionDeclarationStatement>();
 
 	cloneStatement->stage = statement.stage;
+	cloneStatement->workgroupSize = statement.workgroupSize;
 	cloneStatement->name = statement.name;
 	cloneStatement->returnType = statement.returnType;
 	cloneStatement->arguments = statement.arguments;
@@ -0,0 +1,1026 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Shader/Ast/AstOptimizer.hpp>
+#include <Atema/Shader/Ast/AstEvaluator.hpp>
+#include <Atema/Shader/Ast/AstRecursiveVisitor.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace at;
+
+namespace
+{
+	// Collects the functions, variables & structs an AST node refers to
+	class DependencyCollector : public AstConstRecursiveVisitor
+	{
+	public:
+		using AstConstRecursiveVisitor::visit;
+
+		void visit(const VariableDeclarationStatement& statement) override
+		{
+			addType(statement.type);
+
+			AstConstRecursiveVisitor::visit(statement);
+		}
+
+		void visit(const StructDeclarationStatement& statement) override
+		{
+			for (auto& member : statement.members)
+				addType(member.type);
+		}
+
+		void visit(const InputDeclarationStatement& statement) override
+		{
+			for (auto& variable : statement.variables)
+				addType(variable.type);
+		}
+
+		void visit(const OutputDeclarationStatement& statement) override
+		{
+			for (auto& variable : statement.variables)
+				addType(variable.type);
+		}
+
+		void visit(const ExternalDeclarationStatement& statement) override
+		{
+			for (auto& variable : statement.variables)
+				addType(variable.type);
+		}
+
+		void visit(const FunctionDeclarationStatement& statement) override
+		{
+			addType(statement.returnType);
+
+			for (auto& argument : statement.arguments)
+				addType(argument.type);
+
+			AstConstRecursiveVisitor::visit(statement);
+		}
+
+		void visit(const EntryFunctionDeclarationStatement& statement) override
+		{
+			visit(static_cast<const FunctionDeclarationStatement&>(statement));
+		}
+
+		void visit(const ReturnStatement& statement) override
+		{
+			if (statement.expression)
+				statement.expression->accept(*this);
+		}
+
+		void visit(const VariableExpression& expression) override
+		{
+			variables.emplace(expression.identifier);
+		}
+
+		void visit(const FunctionCallExpression& expression) override
+		{
+			functions.emplace(expression.identifier);
+
+			AstConstRecursiveVisitor::visit(expression);
+		}
+
+		void visit(const CastExpression& expression) override
+		{
+			addType(expression.type);
+
+			AstConstRecursiveVisitor::visit(expression);
+		}
+
+		std::unordered_set<std::string> functions;
+		std::unordered_set<std::string> variables;
+		std::unordered_set<std::string> structs;
+
+	private:
+		void addType(const AstType& type)
+		{
+			if (type.is<AstStructType>())
+				structs.emplace(type.get<AstStructType>().name);
+			else if (type.is<AstArrayType>() && type.get<AstArrayType>().componentType.is<AstStructType>())
+				structs.emplace(type.get<AstArrayType>().componentType.get<AstStructType>().name);
+		}
+	};
+
+	// Checks if evaluating an expression may modify something (assignments, user function calls, ...)
+	class SideEffectChecker : public AstConstRecursiveVisitor
+	{
+	public:
+		using AstConstRecursiveVisitor::visit;
+
+		void visit(const AssignmentExpression& expression) override
+		{
+			hasSideEffects = true;
+		}
+
+		void visit(const UnaryExpression& expression) override
+		{
+			switch (expression.op)
+			{
+				case UnaryOperator::IncrementPrefix:
+				case UnaryOperator::IncrementPostfix:
+				case UnaryOperator::DecrementPrefix:
+				case UnaryOperator::DecrementPostfix:
+				{
+					hasSideEffects = true;
+					break;
+				}
+				default:
+				{
+					AstConstRecursiveVisitor::visit(expression);
+					break;
+				}
+			}
+		}
+
+		void visit(const FunctionCallExpression& expression) override
+		{
+			hasSideEffects = true;
+		}
+
+		void visit(const BuiltInFunctionCallExpression& expression) override
+		{
+			switch (expression.function)
+			{
+				case BuiltInFunction::SetVertexPosition:
+				case BuiltInFunction::Barrier:
+				case BuiltInFunction::ImageStore:
+				{
+					hasSideEffects = true;
+					break;
+				}
+				default:
+				{
+					AstConstRecursiveVisitor::visit(expression);
+					break;
+				}
+			}
+		}
+
+		bool hasSideEffects = false;
+	};
+
+	bool hasSideEffects(const Expression& expression)
+	{
+		SideEffectChecker checker;
+
+		expression.accept(checker);
+
+		return checker.hasSideEffects;
+	}
+
+	bool isTerminator(const Statement& statement)
+	{
+		switch (statement.getType())
+		{
+			case Statement::Type::Break:
+			case Statement::Type::Continue:
+			case Statement::Type::Return:
+			case Statement::Type::Discard:
+				return true;
+			default:
+				break;
+		}
+
+		return false;
+	}
+
+	UPtr<Expression> createConstantExpression(const ConstantValue& value)
+	{
+		auto constant = std::make_unique<ConstantExpression>();
+		constant->value = value;
+
+		return std::move(constant);
+	}
+
+	// Removes the local variables never referenced, returns true if any was removed
+	bool removeVariables(Statement& statement, const std::unordered_set<std::string>& usedVariables)
+	{
+		bool removed = false;
+
+		switch (statement.getType())
+		{
+			case Statement::Type::Sequence:
+			{
+				auto& statements = static_cast<SequenceStatement&>(statement).statements;
+
+				for (auto it = statements.begin(); it != statements.end();)
+				{
+					auto& subStatement = **it;
+
+					if (subStatement.getType() == Statement::Type::VariableDeclaration)
+					{
+						const auto& variable = static_cast<VariableDeclarationStatement&>(subStatement);
+
+						if (usedVariables.count(variable.name) == 0 && (!variable.value || !hasSideEffects(*variable.value)))
+						{
+							it = statements.erase(it);
+							removed = true;
+							continue;
+						}
+					}
+
+					removed |= removeVariables(subStatement, usedVariables);
+
+					++it;
+				}
+
+				break;
+			}
+			case Statement::Type::Conditional:
+			{
+				auto& conditional = static_cast<ConditionalStatement&>(statement);
+
+				for (auto& branch : conditional.branches)
+					removed |= removeVariables(*branch.statement, usedVariables);
+
+				if (conditional.elseStatement)
+					removed |= removeVariables(*conditional.elseStatement, usedVariables);
+
+				break;
+			}
+			case Statement::Type::ForLoop:
+			{
+				removed = removeVariables(*static_cast<ForLoopStatement&>(statement).statement, usedVariables);
+				break;
+			}
+			case Statement::Type::WhileLoop:
+			{
+				removed = removeVariables(*static_cast<WhileLoopStatement&>(statement).statement, usedVariables);
+				break;
+			}
+			case Statement::Type::DoWhileLoop:
+			{
+				removed = removeVariables(*static_cast<DoWhileLoopStatement&>(statement).statement, usedVariables);
+				break;
+			}
+			case Statement::Type::Optional:
+			{
+				removed = removeVariables(*static_cast<OptionalStatement&>(statement).statement, usedVariables);
+				break;
+			}
+			default:
+				break;
+		}
+
+		return removed;
+	}
+}
+
+AstOptimizer::AstOptimizer()
+{
+}
+
+AstOptimizer::~AstOptimizer()
+{
+}
+
+void AstOptimizer::optimize(SequenceStatement& ast)
+{
+	// Global scope
+	pushScope();
+
+	processSequence(ast);
+
+	popScope();
+
+	removeUnusedDeclarations(ast);
+}
+
+void AstOptimizer::process(UPtr<Statement>& statement)
+{
+	switch (statement->getType())
+	{
+		case Statement::Type::Conditional:
+		{
+			auto& conditional = static_cast<ConditionalStatement&>(*statement);
+
+			std::vector<ConditionalStatement::Branch> branches;
+			UPtr<Statement> elseStatement;
+
+			for (auto& branch : conditional.branches)
+			{
+				process(branch.condition);
+
+				AstEvaluator evaluator;
+				const auto optionalValue = evaluator.evaluateCondition(*branch.condition);
+
+				// Always false : ignore the branch
+				if (optionalValue.has_value() && !optionalValue.value())
+					continue;
+
+				processBody(branch.statement);
+
+				// Always true : this is the new else statement, the remaining branches are never reached
+				if (optionalValue.has_value())
+				{
+					elseStatement = std::move(branch.statement);
+					break;
+				}
+
+				branches.emplace_back(std::move(branch));
+			}
+
+			if (!elseStatement && conditional.elseStatement)
+			{
+				elseStatement = std::move(conditional.elseStatement);
+
+				process(elseStatement);
+			}
+
+			// No condition left : only the else statement remains (if any)
+			if (branches.empty())
+			{
+				statement = std::move(elseStatement);
+				return;
+			}
+
+			conditional.branches = std::move(branches);
+			conditional.elseStatement = std::move(elseStatement);
+
+			break;
+		}
+		case Statement::Type::ForLoop:
+		{
+			auto& forLoop = static_cast<ForLoopStatement&>(*statement);
+
+			// The initialization belongs to the loop scope
+			pushScope();
+
+			if (forLoop.initialization)
+				process(forLoop.initialization);
+
+			if (forLoop.condition)
+				process(forLoop.condition);
+
+			if (forLoop.increase)
+				process(forLoop.increase);
+
+			processBody(forLoop.statement);
+
+			popScope();
+
+			if (forLoop.condition)
+			{
+				AstEvaluator evaluator;
+				const auto optionalValue = evaluator.evaluateCondition(*forLoop.condition);
+
+				// The loop is never executed : it can be removed if the initialization has no side effects
+				if (optionalValue.has_value() && !optionalValue.value())
+				{
+					const auto initialization = forLoop.initialization.get();
+
+					if (!initialization)
+					{
+						statement.reset();
+						return;
+					}
+
+					if (initialization->getType() == Statement::Type::VariableDeclaration)
+					{
+						const auto& value = static_cast<const VariableDeclarationStatement*>(initialization)->value;
+
+						if (!value || !hasSideEffects(*value))
+						{
+							statement.reset();
+							return;
+						}
+					}
+				}
+			}
+
+			break;
+		}
+		case Statement::Type::WhileLoop:
+		{
+			auto& whileLoop = static_cast<WhileLoopStatement&>(*statement);
+
+			process(whileLoop.condition);
+
+			AstEvaluator evaluator;
+			const auto optionalValue = evaluator.evaluateCondition(*whileLoop.condition);
+
+			// The loop is never executed
+			if (optionalValue.has_value() && !optionalValue.value())
+			{
+				statement.reset();
+				return;
+			}
+
+			processBody(whileLoop.statement);
+
+			break;
+		}
+		case Statement::Type::DoWhileLoop:
+		{
+			auto& doWhileLoop = static_cast<DoWhileLoopStatement&>(*statement);
+
+			processBody(doWhileLoop.statement);
+			process(doWhileLoop.condition);
+
+			break;
+		}
+		case Statement::Type::VariableDeclaration:
+		{
+			auto& variable = static_cast<VariableDeclarationStatement&>(*statement);
+
+			std::optional<ConstantValue> value;
+
+			if (variable.value)
+			{
+				process(variable.value);
+
+				// Only const variables can be propagated
+				if (variable.qualifiers & VariableQualifier::Const)
+				{
+					AstEvaluator evaluator;
+					value = evaluator.evaluate(*variable.value);
+				}
+			}
+
+			declareVariable(variable.name, value);
+
+			break;
+		}
+		case Statement::Type::InputDeclaration:
+		{
+			for (auto& variable : static_cast<InputDeclarationStatement&>(*statement).variables)
+				declareVariable(variable.name, std::nullopt);
+
+			break;
+		}
+		case Statement::Type::OutputDeclaration:
+		{
+			for (auto& variable : static_cast<OutputDeclarationStatement&>(*statement).variables)
+				declareVariable(variable.name, std::nullopt);
+
+			break;
+		}
+		case Statement::Type::ExternalDeclaration:
+		{
+			for (auto& variable : static_cast<ExternalDeclarationStatement&>(*statement).variables)
+				declareVariable(variable.name, std::nullopt);
+
+			break;
+		}
+		case Statement::Type::OptionDeclaration:
+		{
+			// Options that weren't preprocessed are not constants
+			for (auto& variable : static_cast<OptionDeclarationStatement&>(*statement).variables)
+				declareVariable(variable.name, std::nullopt);
+
+			break;
+		}
+		case Statement::Type::FunctionDeclaration:
+		case Statement::Type::EntryFunctionDeclaration:
+		{
+			processFunction(static_cast<FunctionDeclarationStatement&>(*statement));
+
+			break;
+		}
+		case Statement::Type::Expression:
+		{
+			auto& expression = static_cast<ExpressionStatement&>(*statement).expression;
+
+			process(expression);
+
+			// The result is not used : only side effects matter
+			if (!hasSideEffects(*expression))
+			{
+				statement.reset();
+				return;
+			}
+
+			break;
+		}
+		case Statement::Type::Return:
+		{
+			auto& returnStatement = static_cast<ReturnStatement&>(*statement);
+
+			if (returnStatement.expression)
+				process(returnStatement.expression);
+
+			break;
+		}
+		case Statement::Type::Sequence:
+		{
+			auto& sequence = static_cast<SequenceStatement&>(*statement);
+
+			pushScope();
+
+			processSequence(sequence);
+
+			popScope();
+
+			if (sequence.statements.empty())
+			{
+				statement.reset();
+				return;
+			}
+
+			break;
+		}
+		case Statement::Type::Optional:
+		{
+			auto& optional = static_cast<OptionalStatement&>(*statement);
+
+			process(optional.condition);
+
+			AstEvaluator evaluator;
+			const auto optionalValue = evaluator.evaluateCondition(*optional.condition);
+
+			if (optionalValue.has_value())
+			{
+				// Always true : replace optional by the child statement
+				if (optionalValue.value())
+				{
+					statement = std::move(optional.statement);
+					process(statement);
+				}
+				// Always false : discard the statement
+				else
+				{
+					statement.reset();
+				}
+
+				return;
+			}
+
+			process(optional.statement);
+
+			if (!optional.statement)
+				statement.reset();
+
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+void AstOptimizer::process(UPtr<Expression>& expression)
+{
+	switch (expression->getType())
+	{
+		case Expression::Type::Constant:
+			return;
+		case Expression::Type::Variable:
+		{
+			const auto value = findConstant(static_cast<VariableExpression&>(*expression).identifier);
+
+			if (value)
+				expression = createConstantExpression(*value);
+
+			return;
+		}
+		case Expression::Type::AccessIndex:
+		{
+			auto& accessIndex = static_cast<AccessIndexExpression&>(*expression);
+
+			process(accessIndex.expression);
+			process(accessIndex.index);
+
+			return;
+		}
+		case Expression::Type::AccessIdentifier:
+		{
+			process(static_cast<AccessIdentifierExpression&>(*expression).expression);
+
+			return;
+		}
+		case Expression::Type::Assignment:
+		{
+			auto& assignment = static_cast<AssignmentExpression&>(*expression);
+
+			processAssigned(assignment.left);
+			process(assignment.right);
+
+			return;
+		}
+		case Expression::Type::Unary:
+		{
+			auto& unary = static_cast<UnaryExpression&>(*expression);
+
+			switch (unary.op)
+			{
+				case UnaryOperator::IncrementPrefix:
+				case UnaryOperator::IncrementPostfix:
+				case UnaryOperator::DecrementPrefix:
+				case UnaryOperator::DecrementPostfix:
+				{
+					processAssigned(unary.operand);
+					return;
+				}
+				default:
+				{
+					process(unary.operand);
+					break;
+				}
+			}
+
+			break;
+		}
+		case Expression::Type::Binary:
+		{
+			auto& binary = static_cast<BinaryExpression&>(*expression);
+
+			process(binary.left);
+			process(binary.right);
+
+			break;
+		}
+		case Expression::Type::FunctionCall:
+		{
+			for (auto& argument : static_cast<FunctionCallExpression&>(*expression).arguments)
+				process(argument);
+
+			return;
+		}
+		case Expression::Type::BuiltInFunctionCall:
+		{
+			for (auto& argument : static_cast<BuiltInFunctionCallExpression&>(*expression).arguments)
+				process(argument);
+
+			return;
+		}
+		case Expression::Type::Cast:
+		{
+			for (auto& component : static_cast<CastExpression&>(*expression).components)
+				process(component);
+
+			return;
+		}
+		case Expression::Type::Swizzle:
+		{
+			process(static_cast<SwizzleExpression&>(*expression).expression);
+
+			return;
+		}
+		case Expression::Type::Ternary:
+		{
+			auto& ternary = static_cast<TernaryExpression&>(*expression);
+
+			process(ternary.condition);
+
+			AstEvaluator evaluator;
+			const auto optionalValue = evaluator.evaluateCondition(*ternary.condition);
+
+			// Only the selected value is kept when the condition is known
+			if (optionalValue.has_value())
+			{
+				expression = std::move(optionalValue.value() ? ternary.trueValue : ternary.falseValue);
+				process(expression);
+				return;
+			}
+
+			process(ternary.trueValue);
+			process(ternary.falseValue);
+
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid expression type");
+		}
+	}
+
+	// Operands were folded, the operation may now be evaluated
+	AstEvaluator evaluator;
+	const auto value = evaluator.evaluate(*expression);
+
+	if (value.has_value())
+		expression = createConstantExpression(value.value());
+}
+
+void AstOptimizer::processAssigned(UPtr<Expression>& expression)
+{
+	switch (expression->getType())
+	{
+		case Expression::Type::AccessIndex:
+		{
+			auto& accessIndex = static_cast<AccessIndexExpression&>(*expression);
+
+			processAssigned(accessIndex.expression);
+			process(accessIndex.index);
+
+			break;
+		}
+		case Expression::Type::AccessIdentifier:
+		{
+			processAssigned(static_cast<AccessIdentifierExpression&>(*expression).expression);
+
+			break;
+		}
+		case Expression::Type::Swizzle:
+		{
+			processAssigned(static_cast<SwizzleExpression&>(*expression).expression);
+
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+void AstOptimizer::processBody(UPtr<Statement>& statement)
+{
+	process(statement);
+
+	if (!statement)
+		statement = std::make_unique<SequenceStatement>();
+}
+
+void AstOptimizer::processSequence(SequenceStatement& sequence)
+{
+	auto& statements = sequence.statements;
+
+	for (size_t i = 0; i < statements.size(); i++)
+	{
+		process(statements[i]);
+
+		if (!statements[i])
+			continue;
+
+		// Following statements can't be reached
+		if (isTerminator(*statements[i]))
+		{
+			statements.resize(i + 1);
+			break;
+		}
+	}
+
+	statements.erase(std::remove(statements.begin(), statements.end(), nullptr), statements.end());
+}
+
+void AstOptimizer::processFunction(FunctionDeclarationStatement& statement)
+{
+	// Forward declaration
+	if (!statement.sequence)
+		return;
+
+	pushScope();
+
+	for (auto& argument : statement.arguments)
+		declareVariable(argument.name, std::nullopt);
+
+	// The function body can't be removed even if it becomes empty
+	processSequence(*statement.sequence);
+
+	popScope();
+
+	removeUnusedVariables(*statement.sequence);
+}
+
+void AstOptimizer::removeUnusedVariables(SequenceStatement& sequence)
+{
+	// Removing a variable may make the variables used in its value unused too
+	bool removed = true;
+
+	while (removed)
+	{
+		DependencyCollector collector;
+
+		sequence.accept(collector);
+
+		removed = removeVariables(sequence, collector.variables);
+	}
+}
+
+void AstOptimizer::removeUnusedDeclarations(SequenceStatement& ast)
+{
+	struct Declaration
+	{
+		std::unordered_set<std::string> functions;
+		std::unordered_set<std::string> variables;
+		std::unordered_set<std::string> structs;
+	};
+
+	std::unordered_map<std::string, Declaration> functions;
+	std::unordered_map<std::string, Declaration> variables;
+	std::unordered_map<std::string, Declaration> structs;
+
+	DependencyCollector roots;
+	bool hasEntry = false;
+
+	const auto addDeclaration = [](std::unordered_map<std::string, Declaration>& declarations, const std::string& name, const Statement& statement)
+	{
+		DependencyCollector collector;
+
+		statement.accept(collector);
+
+		auto& declaration = declarations[name];
+		declaration.functions.insert(collector.functions.begin(), collector.functions.end());
+		declaration.variables.insert(collector.variables.begin(), collector.variables.end());
+		declaration.structs.insert(collector.structs.begin(), collector.structs.end());
+	};
+
+	// Register the top level declarations (included libraries may create nested sequences)
+	std::vector<const SequenceStatement*> sequences = { &ast };
+
+	while (!sequences.empty())
+	{
+		const auto sequence = sequences.back();
+		sequences.pop_back();
+
+		for (const auto& statement : sequence->statements)
+		{
+			switch (statement->getType())
+			{
+				case Statement::Type::Sequence:
+				{
+					sequences.emplace_back(static_cast<const SequenceStatement*>(statement.get()));
+					break;
+				}
+				case Statement::Type::FunctionDeclaration:
+				{
+					addDeclaration(functions, static_cast<const FunctionDeclarationStatement&>(*statement).name, *statement);
+					break;
+				}
+				case Statement::Type::StructDeclaration:
+				{
+					addDeclaration(structs, static_cast<const StructDeclarationStatement&>(*statement).name, *statement);
+					break;
+				}
+				case Statement::Type::VariableDeclaration:
+				{
+					addDeclaration(variables, static_cast<const VariableDeclarationStatement&>(*statement).name, *statement);
+					break;
+				}
+				case Statement::Type::ExternalDeclaration:
+				{
+					for (const auto& variable : static_cast<const ExternalDeclarationStatement&>(*statement).variables)
+					{
+						auto& declaration = variables[variable.name];
+
+						if (variable.type.is<AstStructType>())
+							declaration.structs.emplace(variable.type.get<AstStructType>().name);
+						else if (variable.type.is<AstArrayType>() && variable.type.get<AstArrayType>().componentType.is<AstStructType>())
+							declaration.structs.emplace(variable.type.get<AstArrayType>().componentType.get<AstStructType>().name);
+					}
+
+					break;
+				}
+				case Statement::Type::EntryFunctionDeclaration:
+				{
+					hasEntry = true;
+					statement->accept(roots);
+					break;
+				}
+				// Anything else is always kept
+				default:
+				{
+					statement->accept(roots);
+					break;
+				}
+			}
+		}
+	}
+
+	// Libraries don't have any entry point : keep everything
+	if (!hasEntry)
+		return;
+
+	// Propagate dependencies from the roots
+	std::unordered_set<std::string> usedFunctions;
+	std::unordered_set<std::string> usedVariables;
+	std::unordered_set<std::string> usedStructs;
+
+	std::vector<const Declaration*> pendingDeclarations;
+
+	const auto use = [&](const std::unordered_set<std::string>& names, std::unordered_set<std::string>& usedNames, const std::unordered_map<std::string, Declaration>& declarations)
+	{
+		for (const auto& name : names)
+		{
+			const auto it = declarations.find(name);
+
+			// Local variables, builtins, ...
+			if (it == declarations.end())
+				continue;
+
+			if (usedNames.emplace(name).second)
+				pendingDeclarations.emplace_back(&it->second);
+		}
+	};
+
+	use(roots.functions, usedFunctions, functions);
+	use(roots.variables, usedVariables, variables);
+	use(roots.structs, usedStructs, structs);
+
+	while (!pendingDeclarations.empty())
+	{
+		const auto declaration = pendingDeclarations.back();
+		pendingDeclarations.pop_back();
+
+		use(declaration->functions, usedFunctions, functions);
+		use(declaration->variables, usedVariables, variables);
+		use(declaration->structs, usedStructs, structs);
+	}
+
+	// Remove the declarations that are never used
+	std::vector<SequenceStatement*> mutableSequences = { &ast };
+
+	while (!mutableSequences.empty())
+	{
+		auto& statements = mutableSequences.back()->statements;
+		mutableSequences.pop_back();
+
+		for (auto& statement : statements)
+		{
+			switch (statement->getType())
+			{
+				case Statement::Type::Sequence:
+				{
+					mutableSequences.emplace_back(static_cast<SequenceStatement*>(statement.get()));
+					break;
+				}
+				case Statement::Type::FunctionDeclaration:
+				{
+					if (usedFunctions.count(static_cast<FunctionDeclarationStatement&>(*statement).name) == 0)
+						statement.reset();
+
+					break;
+				}
+				case Statement::Type::StructDeclaration:
+				{
+					if (usedStructs.count(static_cast<StructDeclarationStatement&>(*statement).name) == 0)
+						statement.reset();
+
+					break;
+				}
+				case Statement::Type::VariableDeclaration:
+				{
+					if (usedVariables.count(static_cast<VariableDeclarationStatement&>(*statement).name) == 0)
+						statement.reset();
+
+					break;
+				}
+				case Statement::Type::ExternalDeclaration:
+				{
+					auto& externalVariables = static_cast<ExternalDeclarationStatement&>(*statement).variables;
+
+					externalVariables.erase(std::remove_if(externalVariables.begin(), externalVariables.end(), [&](const ExternalDeclarationStatement::Variable& variable)
+						{
+							return usedVariables.count(variable.name) == 0;
+						}), externalVariables.end());
+
+					if (externalVariables.empty())
+						statement.reset();
+
+					break;
+				}
+				default:
+					break;
+			}
+		}
+
+		statements.erase(std::remove(statements.begin(), statements.end(), nullptr), statements.end());
+	}
+}
+
+void AstOptimizer::pushScope()
+{
+	m_scopes.emplace_back();
+}
+
+void AstOptimizer::popScope()
+{
+	m_scopes.pop_back();
+}
+
+void AstOptimizer::declareVariable(const std::string& name, std::optional<ConstantValue> value)
+{
+	m_scopes.back()[name] = std::move(value);
+}
+
+const ConstantValue* AstOptimizer::findConstant(const std::string& name) const
+{
+	// Inner scopes first
+	for (auto it = m_scopes.rbegin(); it != m_scopes.rend(); ++it)
+	{
+		const auto variableIt = it->find(name);
+
+		if (variableIt != it->end())
+			return variableIt->second.has_value() ? &variableIt->second.value() : nullptr;
+	}
+
+	return nullptr;
+}
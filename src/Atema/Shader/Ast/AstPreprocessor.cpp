@@ -425,6 +425,7 @@ UPtr<Statement> AstPreprocessor::process(const EntryFunctionDeclarationStatement
 	auto functionDeclaration = std::make_unique<EntryFunctionDeclarationStatement>();
 
 	functionDeclaration->stage = statement.stage;
+	functionDeclaration->workgroupSize = statement.workgroupSize;
 	functionDeclaration->name = statement.name;
 	functionDeclaration->returnType = statement.returnType;
 	functionDeclaration->arguments = statement.arguments;
@@ -649,23 +650,24 @@ UPtr<Expression> AstPreprocessor::process(const SwizzleExpression& expression)
 
 UPtr<Expression> AstPreprocessor::process(const TernaryExpression& expression)
 {
-	auto ternary = std::make_unique<TernaryExpression>();
-	ternary->condition = m_cloner.clone(expression.condition);
-	ternary->trueValue = process(*expression.trueValue);
-	ternary->falseValue = process(*expression.falseValue);
-
-	const auto condition = process(*expression.condition);
+	auto condition = process(*expression.condition);
 
+	// Only the selected branch needs to be processed when the condition is known
 	auto optionalBool = evaluateCondition(*condition);
 
 	if (optionalBool)
 	{
 		if (optionalBool.value())
-			return createConstantIfPossible(std::move(ternary->trueValue));
+			return createConstantIfPossible(process(*expression.trueValue));
 		else
-			return createConstantIfPossible(std::move(ternary->falseValue));
+			return createConstantIfPossible(process(*expression.falseValue));
 	}
 
+	auto ternary = std::make_unique<TernaryExpression>();
+	ternary->condition = std::move(condition);
+	ternary->trueValue = process(*expression.trueValue);
+	ternary->falseValue = process(*expression.falseValue);
+
 	return createConstantIfPossible(std::move(ternary));
 }
 
@@ -683,7 +685,7 @@ std::optional<bool> AstPreprocessor::evaluateCondition(Expression& expression)
 	return evaluator.evaluateCondition(expression);
 }
 
-std::optional<ConstantValue> at::AstPreprocessor::getOptionValue(const std::string& optionName)
+std::optional<ConstantValue> at::AstPreprocessor::getOptionValue(const std::string& optionName) const
 {
 	// Check for overridden options first
 	auto optionIt = m_options.find(optionName);
@@ -91,7 +91,7 @@ AstReflection AstReflector::getReflection(AstShaderStage stage)
 		const auto set = evaluator.evaluate(*variable.setIndex);
 		const auto binding = evaluator.evaluate(*variable.bindingIndex);
 
-		reflection.addExternal({ variable.name, variable.type, getUintValue(set), getUintValue(binding) });
+		reflection.addExternal({ variable.name, variable.type, getUintValue(set), getUintValue(binding), variable.structLayout });
 	}
 
 	// Structs
@@ -0,0 +1,1074 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Shader/Ast/AstSerializer.hpp>
+
+#include <cstring>
+#include <type_traits>
+
+using namespace at;
+
+namespace
+{
+	// 0 is reserved for null nodes
+	constexpr uint8_t NullNode = 0;
+
+	enum class TypeTag : uint8_t
+	{
+		Void,
+		Primitive,
+		Array,
+		Vector,
+		Matrix,
+		Sampler,
+		StorageImage,
+		Struct
+	};
+
+	template <typename T>
+	uint8_t getNodeTag(const T& node)
+	{
+		return static_cast<uint8_t>(static_cast<uint8_t>(node.getType()) + 1);
+	}
+}
+
+//-----
+// AstSerializer
+AstSerializer::AstSerializer()
+{
+}
+
+AstSerializer::~AstSerializer()
+{
+}
+
+void AstSerializer::serialize(const Statement& statement)
+{
+	write(&statement);
+}
+
+const std::vector<uint8_t>& AstSerializer::getData() const noexcept
+{
+	return m_data;
+}
+
+void AstSerializer::clear()
+{
+	m_data.clear();
+}
+
+void AstSerializer::write(const Statement* statement)
+{
+	if (!statement)
+	{
+		writeValue(NullNode);
+		return;
+	}
+
+	writeValue(getNodeTag(*statement));
+
+	switch (statement->getType())
+	{
+#define ATEMA_MACROLIST_SHADERASTSTATEMENT(at_statement) case Statement::Type::at_statement: \
+	{ \
+		write(static_cast<const at_statement ## Statement&>(*statement)); \
+		break; \
+	}
+#include <Atema/Shader/Ast/StatementMacroList.hpp>
+
+		default:
+		{
+			ATEMA_ERROR("Invalid Statement type");
+		}
+	}
+}
+
+void AstSerializer::write(const Expression* expression)
+{
+	if (!expression)
+	{
+		writeValue(NullNode);
+		return;
+	}
+
+	writeValue(getNodeTag(*expression));
+
+	switch (expression->getType())
+	{
+#define ATEMA_MACROLIST_SHADERASTEXPRESSION(at_expression) case Expression::Type::at_expression: \
+	{ \
+		write(static_cast<const at_expression ## Expression&>(*expression)); \
+		break; \
+	}
+#include <Atema/Shader/Ast/ExpressionMacroList.hpp>
+
+		default:
+		{
+			ATEMA_ERROR("Invalid Expression type");
+		}
+	}
+}
+
+void AstSerializer::write(const ConditionalStatement& statement)
+{
+	writeSize(statement.branches.size());
+
+	for (const auto& branch : statement.branches)
+	{
+		write(branch.condition.get());
+		write(branch.statement.get());
+	}
+
+	write(statement.elseStatement.get());
+}
+
+void AstSerializer::write(const ForLoopStatement& statement)
+{
+	write(statement.initialization.get());
+	write(statement.condition.get());
+	write(statement.increase.get());
+	write(statement.statement.get());
+}
+
+void AstSerializer::write(const WhileLoopStatement& statement)
+{
+	write(statement.condition.get());
+	write(statement.statement.get());
+}
+
+void AstSerializer::write(const DoWhileLoopStatement& statement)
+{
+	write(statement.condition.get());
+	write(statement.statement.get());
+}
+
+void AstSerializer::write(const VariableDeclarationStatement& statement)
+{
+	write(statement.name);
+	writeValue(statement.qualifiers.getValue());
+	write(statement.type);
+	write(statement.value.get());
+}
+
+void AstSerializer::write(const StructDeclarationStatement& statement)
+{
+	write(statement.name);
+	writeSize(statement.members.size());
+
+	for (const auto& member : statement.members)
+	{
+		write(member.name);
+		write(member.type);
+		write(member.condition.get());
+	}
+}
+
+void AstSerializer::write(const InputDeclarationStatement& statement)
+{
+	writeValue(statement.stage);
+	writeSize(statement.variables.size());
+
+	for (const auto& variable : statement.variables)
+	{
+		write(variable.name);
+		write(variable.type);
+		write(variable.location.get());
+		write(variable.condition.get());
+	}
+}
+
+void AstSerializer::write(const OutputDeclarationStatement& statement)
+{
+	writeValue(statement.stage);
+	writeSize(statement.variables.size());
+
+	for (const auto& variable : statement.variables)
+	{
+		write(variable.name);
+		write(variable.type);
+		write(variable.location.get());
+		write(variable.condition.get());
+	}
+}
+
+void AstSerializer::write(const ExternalDeclarationStatement& statement)
+{
+	writeSize(statement.variables.size());
+
+	for (const auto& variable : statement.variables)
+	{
+		write(variable.name);
+		write(variable.type);
+		write(variable.setIndex.get());
+		write(variable.bindingIndex.get());
+		writeValue(variable.structLayout);
+		write(variable.condition.get());
+	}
+}
+
+void AstSerializer::write(const OptionDeclarationStatement& statement)
+{
+	writeSize(statement.variables.size());
+
+	for (const auto& variable : statement.variables)
+	{
+		write(variable.name);
+		write(variable.type);
+		write(variable.value.get());
+	}
+}
+
+void AstSerializer::write(const FunctionDeclarationStatement& statement)
+{
+	write(statement, false);
+}
+
+void AstSerializer::write(const EntryFunctionDeclarationStatement& statement)
+{
+	write(statement, true);
+}
+
+void AstSerializer::write(const ExpressionStatement& statement)
+{
+	write(statement.expression.get());
+}
+
+void AstSerializer::write(const BreakStatement& statement)
+{
+}
+
+void AstSerializer::write(const ContinueStatement& statement)
+{
+}
+
+void AstSerializer::write(const ReturnStatement& statement)
+{
+	write(statement.expression.get());
+}
+
+void AstSerializer::write(const DiscardStatement& statement)
+{
+}
+
+void AstSerializer::write(const SequenceStatement& statement)
+{
+	writeSize(statement.statements.size());
+
+	for (const auto& subStatement : statement.statements)
+		write(subStatement.get());
+}
+
+void AstSerializer::write(const OptionalStatement& statement)
+{
+	write(statement.condition.get());
+	write(statement.statement.get());
+}
+
+void AstSerializer::write(const IncludeStatement& statement)
+{
+	writeSize(statement.libraries.size());
+
+	for (const auto& library : statement.libraries)
+		write(library);
+}
+
+void AstSerializer::write(const ConstantExpression& expression)
+{
+	write(expression.value);
+}
+
+void AstSerializer::write(const VariableExpression& expression)
+{
+	write(expression.identifier);
+}
+
+void AstSerializer::write(const AccessIndexExpression& expression)
+{
+	write(expression.expression.get());
+	write(expression.index.get());
+}
+
+void AstSerializer::write(const AccessIdentifierExpression& expression)
+{
+	write(expression.expression.get());
+	write(expression.identifier);
+}
+
+void AstSerializer::write(const AssignmentExpression& expression)
+{
+	write(expression.left.get());
+	write(expression.right.get());
+}
+
+void AstSerializer::write(const UnaryExpression& expression)
+{
+	writeValue(expression.op);
+	write(expression.operand.get());
+}
+
+void AstSerializer::write(const BinaryExpression& expression)
+{
+	writeValue(expression.op);
+	write(expression.left.get());
+	write(expression.right.get());
+}
+
+void AstSerializer::write(const FunctionCallExpression& expression)
+{
+	write(expression.identifier);
+	writeSize(expression.arguments.size());
+
+	for (const auto& argument : expression.arguments)
+		write(argument.get());
+}
+
+void AstSerializer::write(const BuiltInFunctionCallExpression& expression)
+{
+	writeValue(expression.function);
+	writeSize(expression.arguments.size());
+
+	for (const auto& argument : expression.arguments)
+		write(argument.get());
+}
+
+void AstSerializer::write(const CastExpression& expression)
+{
+	write(expression.type);
+	writeSize(expression.components.size());
+
+	for (const auto& component : expression.components)
+		write(component.get());
+}
+
+void AstSerializer::write(const SwizzleExpression& expression)
+{
+	write(expression.expression.get());
+	writeSize(expression.components.size());
+
+	for (const auto& component : expression.components)
+		writeSize(component);
+}
+
+void AstSerializer::write(const TernaryExpression& expression)
+{
+	write(expression.condition.get());
+	write(expression.trueValue.get());
+	write(expression.falseValue.get());
+}
+
+void AstSerializer::write(const FunctionDeclarationStatement& statement, bool isEntry)
+{
+	write(statement.name);
+	write(statement.returnType);
+	writeSize(statement.arguments.size());
+
+	for (const auto& argument : statement.arguments)
+	{
+		write(argument.name);
+		write(argument.type);
+	}
+
+	write(statement.sequence.get());
+
+	if (isEntry)
+	{
+		const auto& entryStatement = static_cast<const EntryFunctionDeclarationStatement&>(statement);
+
+		writeValue(entryStatement.stage);
+		writeValue(entryStatement.workgroupSize.x);
+		writeValue(entryStatement.workgroupSize.y);
+		writeValue(entryStatement.workgroupSize.z);
+	}
+}
+
+void AstSerializer::write(const AstType& type)
+{
+	if (type.is<AstVoidType>())
+	{
+		writeValue(TypeTag::Void);
+	}
+	else if (type.is<AstArrayType>())
+	{
+		const auto& arrayType = type.get<AstArrayType>();
+
+		writeValue(TypeTag::Array);
+		write(arrayType.componentType);
+		writeValue(arrayType.sizeType);
+		writeSize(arrayType.size);
+		write(arrayType.optionName);
+	}
+	else if (!writeSharedType(type))
+	{
+		ATEMA_ERROR("Invalid type");
+	}
+}
+
+void AstSerializer::write(const AstArrayType::ComponentType& type)
+{
+	if (!writeSharedType(type))
+		ATEMA_ERROR("Invalid array component type");
+}
+
+void AstSerializer::write(const ConstantValue& value)
+{
+	const bool isValid =
+		writeConstant<bool>(value, ConstantType::Bool) ||
+		writeConstant<int32_t>(value, ConstantType::Int) ||
+		writeConstant<uint32_t>(value, ConstantType::UInt) ||
+		writeConstant<float>(value, ConstantType::Float) ||
+		writeConstant<Vector2i>(value, ConstantType::Vector2i) ||
+		writeConstant<Vector2u>(value, ConstantType::Vector2u) ||
+		writeConstant<Vector2f>(value, ConstantType::Vector2f) ||
+		writeConstant<Vector3i>(value, ConstantType::Vector3i) ||
+		writeConstant<Vector3u>(value, ConstantType::Vector3u) ||
+		writeConstant<Vector3f>(value, ConstantType::Vector3f) ||
+		writeConstant<Vector4i>(value, ConstantType::Vector4i) ||
+		writeConstant<Vector4u>(value, ConstantType::Vector4u) ||
+		writeConstant<Vector4f>(value, ConstantType::Vector4f);
+
+	if (!isValid)
+		ATEMA_ERROR("Invalid constant type");
+}
+
+void AstSerializer::write(const std::string& str)
+{
+	writeSize(str.size());
+
+	const auto offset = m_data.size();
+
+	m_data.resize(offset + str.size());
+
+	std::memcpy(m_data.data() + offset, str.data(), str.size());
+}
+
+template <typename T>
+void AstSerializer::writeValue(T value)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written directly");
+
+	const auto offset = m_data.size();
+
+	m_data.resize(offset + sizeof(T));
+
+	std::memcpy(m_data.data() + offset, &value, sizeof(T));
+}
+
+// Vectors are written component by component, they are not trivially copyable
+template <size_t N, typename T>
+void AstSerializer::writeValue(const Vector<N, T>& value)
+{
+	for (size_t i = 0; i < N; i++)
+		writeValue(value[i]);
+}
+
+void AstSerializer::writeSize(size_t size)
+{
+	writeValue(static_cast<uint32_t>(size));
+}
+
+// Types shared by AstType & AstArrayType::ComponentType
+template <typename T>
+bool AstSerializer::writeSharedType(const T& type)
+{
+	if (type.template is<AstPrimitiveType>())
+	{
+		writeValue(TypeTag::Primitive);
+		writeValue(type.template get<AstPrimitiveType>());
+	}
+	else if (type.template is<AstVectorType>())
+	{
+		const auto& vectorType = type.template get<AstVectorType>();
+
+		writeValue(TypeTag::Vector);
+		writeValue(vectorType.primitiveType);
+		writeSize(vectorType.componentCount);
+	}
+	else if (type.template is<AstMatrixType>())
+	{
+		const auto& matrixType = type.template get<AstMatrixType>();
+
+		writeValue(TypeTag::Matrix);
+		writeValue(matrixType.primitiveType);
+		writeSize(matrixType.rowCount);
+		writeSize(matrixType.columnCount);
+	}
+	else if (type.template is<AstSamplerType>())
+	{
+		const auto& samplerType = type.template get<AstSamplerType>();
+
+		writeValue(TypeTag::Sampler);
+		writeValue(samplerType.imageType);
+		writeValue(samplerType.primitiveType);
+	}
+	else if (type.template is<AstStorageImageType>())
+	{
+		const auto& imageType = type.template get<AstStorageImageType>();
+
+		writeValue(TypeTag::StorageImage);
+		writeValue(imageType.imageType);
+		writeValue(imageType.primitiveType);
+		writeValue(imageType.format);
+	}
+	else if (type.template is<AstStructType>())
+	{
+		writeValue(TypeTag::Struct);
+		write(type.template get<AstStructType>().name);
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+template <typename T>
+bool AstSerializer::writeConstant(const ConstantValue& value, ConstantType constantType)
+{
+	if (!value.is<T>())
+		return false;
+
+	writeValue(constantType);
+	writeValue(value.get<T>());
+
+	return true;
+}
+
+//-----
+// AstDeserializer
+AstDeserializer::AstDeserializer(const void* data, size_t byteSize) :
+	m_data(static_cast<const uint8_t*>(data)),
+	m_end(static_cast<const uint8_t*>(data) + byteSize)
+{
+}
+
+AstDeserializer::~AstDeserializer()
+{
+}
+
+UPtr<Statement> AstDeserializer::deserialize()
+{
+	return readStatement();
+}
+
+size_t AstDeserializer::getRemainingSize() const noexcept
+{
+	return static_cast<size_t>(m_end - m_data);
+}
+
+UPtr<Statement> AstDeserializer::readStatement()
+{
+	const auto tag = readValue<uint8_t>();
+
+	if (tag == NullNode)
+		return {};
+
+	switch (static_cast<Statement::Type>(tag - 1))
+	{
+#define ATEMA_MACROLIST_SHADERASTSTATEMENT(at_statement) case Statement::Type::at_statement: \
+	{ \
+		auto statement = std::make_unique<at_statement ## Statement>(); \
+		read(*statement); \
+		return std::move(statement); \
+	}
+#include <Atema/Shader/Ast/StatementMacroList.hpp>
+
+		default:
+		{
+			ATEMA_ERROR("Invalid Statement type");
+		}
+	}
+
+	return {};
+}
+
+UPtr<Expression> AstDeserializer::readExpression()
+{
+	const auto tag = readValue<uint8_t>();
+
+	if (tag == NullNode)
+		return {};
+
+	switch (static_cast<Expression::Type>(tag - 1))
+	{
+#define ATEMA_MACROLIST_SHADERASTEXPRESSION(at_expression) case Expression::Type::at_expression: \
+	{ \
+		auto expression = std::make_unique<at_expression ## Expression>(); \
+		read(*expression); \
+		return std::move(expression); \
+	}
+#include <Atema/Shader/Ast/ExpressionMacroList.hpp>
+
+		default:
+		{
+			ATEMA_ERROR("Invalid Expression type");
+		}
+	}
+
+	return {};
+}
+
+template <typename T>
+UPtr<T> AstDeserializer::readStatement()
+{
+	auto statement = readStatement();
+
+	if (!statement)
+		return {};
+
+	if (statement->getType() != T().getType())
+		ATEMA_ERROR("Unexpected Statement type");
+
+	return UPtr<T>(static_cast<T*>(statement.release()));
+}
+
+void AstDeserializer::read(ConditionalStatement& statement)
+{
+	statement.branches.resize(readSize());
+
+	for (auto& branch : statement.branches)
+	{
+		branch.condition = readExpression();
+		branch.statement = readStatement();
+	}
+
+	statement.elseStatement = readStatement();
+}
+
+void AstDeserializer::read(ForLoopStatement& statement)
+{
+	statement.initialization = readStatement();
+	statement.condition = readExpression();
+	statement.increase = readExpression();
+	statement.statement = readStatement();
+}
+
+void AstDeserializer::read(WhileLoopStatement& statement)
+{
+	statement.condition = readExpression();
+	statement.statement = readStatement();
+}
+
+void AstDeserializer::read(DoWhileLoopStatement& statement)
+{
+	statement.condition = readExpression();
+	statement.statement = readStatement();
+}
+
+void AstDeserializer::read(VariableDeclarationStatement& statement)
+{
+	statement.name = readString();
+	statement.qualifiers = Flags<VariableQualifier>(readValue<int>());
+	statement.type = readType();
+	statement.value = readExpression();
+}
+
+void AstDeserializer::read(StructDeclarationStatement& statement)
+{
+	statement.name = readString();
+	statement.members.resize(readSize());
+
+	for (auto& member : statement.members)
+	{
+		member.name = readString();
+		member.type = readType();
+		member.condition = readExpression();
+	}
+}
+
+void AstDeserializer::read(InputDeclarationStatement& statement)
+{
+	statement.stage = readValue<AstShaderStage>();
+	statement.variables.resize(readSize());
+
+	for (auto& variable : statement.variables)
+	{
+		variable.name = readString();
+		variable.type = readType();
+		variable.location = readExpression();
+		variable.condition = readExpression();
+	}
+}
+
+void AstDeserializer::read(OutputDeclarationStatement& statement)
+{
+	statement.stage = readValue<AstShaderStage>();
+	statement.variables.resize(readSize());
+
+	for (auto& variable : statement.variables)
+	{
+		variable.name = readString();
+		variable.type = readType();
+		variable.location = readExpression();
+		variable.condition = readExpression();
+	}
+}
+
+void AstDeserializer::read(ExternalDeclarationStatement& statement)
+{
+	statement.variables.resize(readSize());
+
+	for (auto& variable : statement.variables)
+	{
+		variable.name = readString();
+		variable.type = readType();
+		variable.setIndex = readExpression();
+		variable.bindingIndex = readExpression();
+		variable.structLayout = readValue<StructLayout>();
+		variable.condition = readExpression();
+	}
+}
+
+void AstDeserializer::read(OptionDeclarationStatement& statement)
+{
+	statement.variables.resize(readSize());
+
+	for (auto& variable : statement.variables)
+	{
+		variable.name = readString();
+		variable.type = readType();
+		variable.value = readExpression();
+	}
+}
+
+void AstDeserializer::read(FunctionDeclarationStatement& statement)
+{
+	readFunction(statement);
+}
+
+void AstDeserializer::read(EntryFunctionDeclarationStatement& statement)
+{
+	readFunction(statement);
+
+	statement.stage = readValue<AstShaderStage>();
+	statement.workgroupSize.x = readValue<uint32_t>();
+	statement.workgroupSize.y = readValue<uint32_t>();
+	statement.workgroupSize.z = readValue<uint32_t>();
+}
+
+void AstDeserializer::read(ExpressionStatement& statement)
+{
+	statement.expression = readExpression();
+}
+
+void AstDeserializer::read(BreakStatement& statement)
+{
+}
+
+void AstDeserializer::read(ContinueStatement& statement)
+{
+}
+
+void AstDeserializer::read(ReturnStatement& statement)
+{
+	statement.expression = readExpression();
+}
+
+void AstDeserializer::read(DiscardStatement& statement)
+{
+}
+
+void AstDeserializer::read(SequenceStatement& statement)
+{
+	statement.statements.resize(readSize());
+
+	for (auto& subStatement : statement.statements)
+		subStatement = readStatement();
+}
+
+void AstDeserializer::read(OptionalStatement& statement)
+{
+	statement.condition = readExpression();
+	statement.statement = readStatement();
+}
+
+void AstDeserializer::read(IncludeStatement& statement)
+{
+	statement.libraries.resize(readSize());
+
+	for (auto& library : statement.libraries)
+		library = readString();
+}
+
+void AstDeserializer::read(ConstantExpression& expression)
+{
+	expression.value = readConstant();
+}
+
+void AstDeserializer::read(VariableExpression& expression)
+{
+	expression.identifier = readString();
+}
+
+void AstDeserializer::read(AccessIndexExpression& expression)
+{
+	expression.expression = readExpression();
+	expression.index = readExpression();
+}
+
+void AstDeserializer::read(AccessIdentifierExpression& expression)
+{
+	expression.expression = readExpression();
+	expression.identifier = readString();
+}
+
+void AstDeserializer::read(AssignmentExpression& expression)
+{
+	expression.left = readExpression();
+	expression.right = readExpression();
+}
+
+void AstDeserializer::read(UnaryExpression& expression)
+{
+	expression.op = readValue<UnaryOperator>();
+	expression.operand = readExpression();
+}
+
+void AstDeserializer::read(BinaryExpression& expression)
+{
+	expression.op = readValue<BinaryOperator>();
+	expression.left = readExpression();
+	expression.right = readExpression();
+}
+
+void AstDeserializer::read(FunctionCallExpression& expression)
+{
+	expression.identifier = readString();
+	expression.arguments.resize(readSize());
+
+	for (auto& argument : expression.arguments)
+		argument = readExpression();
+}
+
+void AstDeserializer::read(BuiltInFunctionCallExpression& expression)
+{
+	expression.function = readValue<BuiltInFunction>();
+	expression.arguments.resize(readSize());
+
+	for (auto& argument : expression.arguments)
+		argument = readExpression();
+}
+
+void AstDeserializer::read(CastExpression& expression)
+{
+	expression.type = readType();
+	expression.components.resize(readSize());
+
+	for (auto& component : expression.components)
+		component = readExpression();
+}
+
+void AstDeserializer::read(SwizzleExpression& expression)
+{
+	expression.expression = readExpression();
+	expression.components.resize(readSize());
+
+	for (auto& component : expression.components)
+		component = readSize();
+}
+
+void AstDeserializer::read(TernaryExpression& expression)
+{
+	expression.condition = readExpression();
+	expression.trueValue = readExpression();
+	expression.falseValue = readExpression();
+}
+
+void AstDeserializer::readFunction(FunctionDeclarationStatement& statement)
+{
+	statement.name = readString();
+	statement.returnType = readType();
+	statement.arguments.resize(readSize());
+
+	for (auto& argument : statement.arguments)
+	{
+		argument.name = readString();
+		argument.type = readType();
+	}
+
+	statement.sequence = readStatement<SequenceStatement>();
+}
+
+AstType AstDeserializer::readType()
+{
+	const auto tag = readValue<uint8_t>();
+
+	switch (static_cast<TypeTag>(tag))
+	{
+		case TypeTag::Void:
+		{
+			return AstVoidType();
+		}
+		case TypeTag::Array:
+		{
+			AstArrayType arrayType;
+			arrayType.componentType = readComponentType();
+			arrayType.sizeType = readValue<AstArrayType::SizeType>();
+			arrayType.size = readSize();
+			arrayType.optionName = readString();
+
+			return arrayType;
+		}
+		default:
+			break;
+	}
+
+	return readSharedType<AstType>(tag);
+}
+
+AstArrayType::ComponentType AstDeserializer::readComponentType()
+{
+	return readSharedType<AstArrayType::ComponentType>(readValue<uint8_t>());
+}
+
+template <typename T>
+T AstDeserializer::readSharedType(uint8_t tag)
+{
+	switch (static_cast<TypeTag>(tag))
+	{
+		case TypeTag::Primitive:
+		{
+			return readValue<AstPrimitiveType>();
+		}
+		case TypeTag::Vector:
+		{
+			AstVectorType vectorType;
+			vectorType.primitiveType = readValue<AstPrimitiveType>();
+			vectorType.componentCount = readSize();
+
+			return vectorType;
+		}
+		case TypeTag::Matrix:
+		{
+			AstMatrixType matrixType;
+			matrixType.primitiveType = readValue<AstPrimitiveType>();
+			matrixType.rowCount = readSize();
+			matrixType.columnCount = readSize();
+
+			return matrixType;
+		}
+		case TypeTag::Sampler:
+		{
+			AstSamplerType samplerType;
+			samplerType.imageType = readValue<AstImageType>();
+			samplerType.primitiveType = readValue<AstPrimitiveType>();
+
+			return samplerType;
+		}
+		case TypeTag::StorageImage:
+		{
+			AstStorageImageType imageType;
+			imageType.imageType = readValue<AstImageType>();
+			imageType.primitiveType = readValue<AstPrimitiveType>();
+			imageType.format = readValue<AstImageFormat>();
+
+			return imageType;
+		}
+		case TypeTag::Struct:
+		{
+			AstStructType structType;
+			structType.name = readString();
+
+			return structType;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid type");
+		}
+	}
+
+	return {};
+}
+
+ConstantValue AstDeserializer::readConstant()
+{
+	switch (readValue<ConstantType>())
+	{
+		case ConstantType::Bool: return readValue<bool>();
+		case ConstantType::Int: return readValue<int32_t>();
+		case ConstantType::UInt: return readValue<uint32_t>();
+		case ConstantType::Float: return readValue<float>();
+		case ConstantType::Vector2i: return readVector<2, int32_t>();
+		case ConstantType::Vector2u: return readVector<2, uint32_t>();
+		case ConstantType::Vector2f: return readVector<2, float>();
+		case ConstantType::Vector3i: return readVector<3, int32_t>();
+		case ConstantType::Vector3u: return readVector<3, uint32_t>();
+		case ConstantType::Vector3f: return readVector<3, float>();
+		case ConstantType::Vector4i: return readVector<4, int32_t>();
+		case ConstantType::Vector4u: return readVector<4, uint32_t>();
+		case ConstantType::Vector4f: return readVector<4, float>();
+		default:
+		{
+			ATEMA_ERROR("Invalid constant type");
+		}
+	}
+
+	return {};
+}
+
+std::string AstDeserializer::readString()
+{
+	const auto size = readSize();
+
+	std::string str(size, '\0');
+
+	readBytes(str.data(), size);
+
+	return str;
+}
+
+template <typename T>
+T AstDeserializer::readValue()
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read directly");
+
+	T value;
+
+	readBytes(&value, sizeof(T));
+
+	return value;
+}
+
+template <size_t N, typename T>
+Vector<N, T> AstDeserializer::readVector()
+{
+	Vector<N, T> value;
+
+	for (size_t i = 0; i < N; i++)
+		value[i] = readValue<T>();
+
+	return value;
+}
+
+size_t AstDeserializer::readSize()
+{
+	return static_cast<size_t>(readValue<uint32_t>());
+}
+
+void AstDeserializer::readBytes(void* data, size_t byteSize)
+{
+	if (getRemainingSize() < byteSize)
+		ATEMA_ERROR("Unexpected end of AST data");
+
+	std::memcpy(data, m_data, byteSize);
+
+	m_data += byteSize;
+}
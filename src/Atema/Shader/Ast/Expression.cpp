@@ -32,6 +32,16 @@ Expression::~Expression()
 {
 }
 
+void* Expression::operator new(size_t size)
+{
+	return AstAllocator::allocate(size);
+}
+
+void Expression::operator delete(void* ptr, size_t size) noexcept
+{
+	AstAllocator::release(ptr, size);
+}
+
 #define ATEMA_MACROLIST_SHADERASTEXPRESSION(at_expression) \
 	Expression::Type at_expression ## Expression::getType() const noexcept \
 	{ \
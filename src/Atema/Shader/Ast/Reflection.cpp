@@ -62,10 +62,11 @@ AstExternal::AstExternal() :
 {
 }
 
-AstExternal::AstExternal(const std::string& name, const AstType& type, uint32_t set, uint32_t binding) :
+AstExternal::AstExternal(const std::string& name, const AstType& type, uint32_t set, uint32_t binding, StructLayout structLayout) :
 	AstVariable(name, type),
 	set(set),
-	binding(binding)
+	binding(binding),
+	structLayout(structLayout)
 {
 }
 
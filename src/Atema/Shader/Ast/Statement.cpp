@@ -33,6 +33,16 @@ Statement::~Statement()
 {
 }
 
+void* Statement::operator new(size_t size)
+{
+	return AstAllocator::allocate(size);
+}
+
+void Statement::operator delete(void* ptr, size_t size) noexcept
+{
+	AstAllocator::release(ptr, size);
+}
+
 #define ATEMA_MACROLIST_SHADERASTSTATEMENT(at_statement) \
 	Statement::Type at_statement ## Statement::getType() const noexcept \
 	{ \
@@ -24,6 +24,9 @@
 #include <Atema/Shader/Atsl/AtslUtils.hpp>
 #include <Atema/Core/Error.hpp>
 
+#include <charconv>
+#include <cstring>
+
 using namespace at;
 
 namespace
@@ -137,86 +140,71 @@ namespace
 		return c == '\n';
 	}
 
-	bool isBooleanValue(const std::string& str)
-	{
-		return str == "false" || str == "true";
-	}
+	constexpr size_t IdentifierPageSize = 4096;
+
+	// Rough average of source bytes per token, used to reserve the token array
+	constexpr size_t BytesPerToken = 4;
+}
 
-	bool getBooleanValue(const std::string& str)
+AtslParser::AtslParser() :
+	m_identifierPageOffset(0),
+	m_identifierPageSize(0)
+{
+	// Keywords and boolean values are stored in static memory, they don't need to be interned
+	for (auto keyword = static_cast<int>(AtslKeyword::Input); keyword <= static_cast<int>(AtslKeyword::Discard); keyword++)
 	{
-		if (str == "false")
-			return false;
+		const auto atslKeyword = static_cast<AtslKeyword>(keyword);
 
-		return true;
+		m_words.emplace(atsl::getKeyword(atslKeyword), AtslToken(atslKeyword));
 	}
-}
 
-AtslParser::AtslParser()
-{
+	m_words.emplace("true", AtslToken(true));
+	m_words.emplace("false", AtslToken(false));
 }
 
 AtslParser::~AtslParser()
 {
 }
 
-std::vector<AtslToken> AtslParser::createTokens(const std::string& code)
+std::vector<AtslToken> AtslParser::createTokens(std::string_view code)
 {
-	// Initialize variables
-	m_code = code;
-	
-	m_currentLine = 1;
-	m_currentColumn = 1;
+	std::vector<AtslToken> tokens;
+	tokens.reserve(code.size() / BytesPerToken);
 
-	m_currentIndex = 0;
+	const size_t size = code.size();
+	size_t index = 0;
 
-	// Create tokens
-	std::vector<AtslToken> tokens;
+	size_t line = 1;
+	size_t lineStart = 0;
 
-	while (hasNext())
+	while (index < size)
 	{
-		const auto line = m_currentLine;
-		const auto column = m_currentColumn;
-
-		const auto c = getNext();
+		const size_t tokenStart = index;
+		const auto c = code[index++];
 
 		// Space
 		if (isSpace(c))
 		{
-			m_currentColumn++;
-
 			continue;
 		}
 		// New line
 		else if (isNewLine(c))
 		{
-			m_currentLine++;
-			m_currentColumn = 0; // Will be incremented by the next char
+			line++;
+			lineStart = index;
 
 			continue;
 		}
 		// Symbols
 		else if (isSymbol(c))
 		{
-			if (isCommentSymbol(c) && hasNext())
+			// Check if this is a comment : if it is, go to the next line
+			if (isCommentSymbol(c) && index < size && isCommentSymbol(code[index]))
 			{
-				// Check if this is a comment : if it is, go to the next line
-				if (isCommentSymbol(getNext()))
-				{
-					while (hasNext())
-					{
-						if (isNewLine(getNext()))
-							break;
-					}
-
-					m_currentLine++;
-					m_currentColumn = 0; // Will be incremented by the next char
+				while (index < size && !isNewLine(code[index]))
+					index++;
 
-					continue;
-				}
-				else
-				{
-					gotoLastChar();
-				}
+				continue;
 			}
 
 			tokens.emplace_back(atsl::getSymbol(c));
@@ -224,45 +212,15 @@ std::vector<AtslToken> AtslParser::createTokens(const std::string& code)
 		// Alphabetic
 		else if (isAlphabetic(c))
 		{
-			AtslIdentifier identifier;
-			identifier += c;
-
 			// Get full word
-			while (hasNext())
-			{
-				const auto n = getNext();
-
-				if (isAlphaNumeric(n))
-				{
-					identifier += n;
-				}
-				else
-				{
-					// The char was not part of the word : get back !
-					gotoLastChar();
-					break;
-				}
-			}
+			while (index < size && isAlphaNumeric(code[index]))
+				index++;
 
-			if (isBooleanValue(identifier))
-			{
-				tokens.emplace_back(getBooleanValue(identifier));
-			}
-			else if (atsl::isKeyword(identifier))
-			{
-				tokens.emplace_back(atsl::getKeyword(identifier));
-			}
-			else
-			{
-				tokens.emplace_back(identifier);
-			}
+			tokens.emplace_back(getWordToken(code.substr(tokenStart, index - tokenStart)));
 		}
 		// Numbers
 		else if (isDigit(c))
 		{
-			std::string strValue;
-			strValue += c;
-
 			AtslNumberSuffix numberSuffix = AtslNumberSuffix::Unspecified;
 
 			bool isFloat = false;
@@ -271,36 +229,29 @@ std::vector<AtslToken> AtslParser::createTokens(const std::string& code)
 			// Check if this is an hexadecimal number
 			bool isHex = false;
 			int base = 10;
-			if (c == '0')
+			size_t valueStart = tokenStart;
+			if (c == '0' && index < size && (code[index] == 'x' || code[index] == 'X'))
 			{
-				const auto n = getNext();
-
-				if (n == 'x' || n == 'X')
-				{
-					isHex = true;
-					base = 16;
-					strValue += n;
-				}
-				else
-				{
-					gotoLastChar();
-				}
+				isHex = true;
+				base = 16;
+				index++;
+				valueStart = index;
 			}
 
 			// Get full number
-			while (hasNext())
+			while (index < size)
 			{
-				const auto n = getNext();
+				const auto n = code[index];
 
 				if (isDigit(n))
 				{
-					strValue += n;
+					index++;
 				}
 				else if (!isFloatExponent)
 				{
 					if (isHex && isHexadecimal(n))
 					{
-						strValue += n;
+						index++;
 					}
 					else if (n == '.')
 					{
@@ -311,72 +262,70 @@ std::vector<AtslToken> AtslParser::createTokens(const std::string& code)
 
 						// Check if it was already a float
 						if (isFloat)
-						{
-							// The char was not part of the number : get back !
-							gotoLastChar();
 							break;
-						}
 
-						strValue += n;
+						index++;
 
 						isFloat = true;
 					}
 					else if (n == 'e' || n == 'E')
 					{
-						strValue += n;
+						index++;
 
 						isFloat = true;
 						isFloatExponent = true; // For now we only look for digits
 
-						const char sign = getNext();
-
-						if (sign == '-' || sign == '+')
-							strValue += sign;
-						else
-							gotoLastChar();
-					}
-					else if (isNumberSuffix(n))
-					{
-						numberSuffix = getNumberSuffix(n);
-
-						break;
+						if (index < size && (code[index] == '-' || code[index] == '+'))
+							index++;
 					}
 					else
 					{
-						// The char was not part of the number : get back !
-						gotoLastChar();
 						break;
 					}
 				}
-				else if (isNumberSuffix(n))
-				{
-					numberSuffix = getNumberSuffix(n);
-
-					break;
-				}
 				else
 				{
-					// The char was not part of the number : get back !
-					gotoLastChar();
 					break;
 				}
 			}
 
+			const size_t valueEnd = index;
+
+			// The suffix is not part of the value
+			if (index < size && isNumberSuffix(code[index]))
+				numberSuffix = getNumberSuffix(code[index++]);
+
+			const char* valueBegin = code.data() + valueStart;
+			const char* valueLast = code.data() + valueEnd;
+
 			if (isFloat || numberSuffix == AtslNumberSuffix::Float)
 			{
-				tokens.emplace_back(std::stof(strValue));
-			}
-			else if (numberSuffix == AtslNumberSuffix::Unsigned)
-			{
-				tokens.emplace_back(static_cast<uint32_t>(std::stoll(strValue, nullptr, base)));
+				float value = 0.0f;
+
+				if (std::from_chars(valueBegin, valueLast, value).ec != std::errc())
+				{
+					ATEMA_ERROR("Invalid float value");
+				}
+
+				tokens.emplace_back(value);
 			}
 			else
 			{
-				tokens.emplace_back(static_cast<int32_t>(std::stoll(strValue, nullptr, base)));
+				int64_t value = 0;
+
+				if (std::from_chars(valueBegin, valueLast, value, base).ec != std::errc())
+				{
+					ATEMA_ERROR("Invalid integer value");
+				}
+
+				if (numberSuffix == AtslNumberSuffix::Unsigned)
+					tokens.emplace_back(static_cast<uint32_t>(value));
+				else
+					tokens.emplace_back(static_cast<int32_t>(value));
 			}
 		}
 		// End of file
-		else if (!hasNext())
+		else if (index >= size)
 		{
 			break;
 		}
@@ -390,28 +339,41 @@ std::vector<AtslToken> AtslParser::createTokens(const std::string& code)
 
 		auto& token = tokens.back();
 		token.line = line;
-		token.column = static_cast<size_t>(column);
+		token.column = tokenStart - lineStart + 1;
 	}
 
 	return tokens;
 }
 
-bool AtslParser::hasNext() const
+const AtslToken& AtslParser::getWordToken(std::string_view word)
 {
-	return m_currentIndex < m_code.size();
-}
+	const auto it = m_words.find(word);
 
-char AtslParser::getNext()
-{
-	ATEMA_ASSERT(hasNext(), "No next character available");
+	if (it != m_words.end())
+		return it->second;
 
-	m_currentColumn++;
+	const auto identifier = storeIdentifier(word);
 
-	return m_code[m_currentIndex++];
+	return m_words.emplace(identifier, AtslToken(identifier)).first->second;
 }
 
-void AtslParser::gotoLastChar()
+std::string_view AtslParser::storeIdentifier(std::string_view identifier)
 {
-	m_currentIndex--;
-	m_currentColumn--;
+	const size_t size = identifier.size();
+
+	if (m_identifierPageOffset + size > m_identifierPageSize)
+	{
+		m_identifierPageSize = std::max(IdentifierPageSize, size);
+		m_identifierPageOffset = 0;
+
+		m_identifierPages.emplace_back(new char[m_identifierPageSize]);
+	}
+
+	char* data = m_identifierPages.back().get() + m_identifierPageOffset;
+
+	std::memcpy(data, identifier.data(), size);
+
+	m_identifierPageOffset += size;
+
+	return { data, size };
 }
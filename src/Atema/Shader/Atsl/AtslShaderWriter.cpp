@@ -139,6 +139,8 @@ void AtslShaderWriter::visit(const VariableDeclarationStatement& statement)
 {
 	if (statement.qualifiers & VariableQualifier::Const)
 		m_ostream << "const ";
+	else if (statement.qualifiers & VariableQualifier::Shared)
+		m_ostream << "shared ";
 
 	writeVariableDeclaration(statement.type, statement.name, statement.value.get());
 }
@@ -178,7 +180,7 @@ void AtslShaderWriter::visit(const InputDeclarationStatement& statement)
 	// Write block declaration attributes
 	const std::vector<Attribute> blockAttributes =
 	{
-		{"stage", AtslIdentifier(atsl::getShaderStageStr(statement.stage))}
+		{"stage", atsl::getShaderStageStr(statement.stage)}
 	};
 
 	writeAttributes(blockAttributes);
@@ -231,7 +233,7 @@ void AtslShaderWriter::visit(const OutputDeclarationStatement& statement)
 	// Write block declaration attributes
 	const std::vector<Attribute> blockAttributes =
 	{
-		{"stage", AtslIdentifier(atsl::getShaderStageStr(statement.stage))}
+		{"stage", atsl::getShaderStageStr(statement.stage)}
 	};
 
 	writeAttributes(blockAttributes);
@@ -307,6 +309,22 @@ void AtslShaderWriter::visit(const ExternalDeclarationStatement& statement)
 			variableAttributes.emplace_back(std::move(layoutAttribute));
 		}
 
+		auto format = AstImageFormat::Unknown;
+
+		if (variable.type.is<AstStorageImageType>())
+			format = variable.type.get<AstStorageImageType>().format;
+		else if (variable.type.is<AstArrayType>() && variable.type.get<AstArrayType>().componentType.is<AstStorageImageType>())
+			format = variable.type.get<AstArrayType>().componentType.get<AstStorageImageType>().format;
+
+		if (format != AstImageFormat::Unknown)
+		{
+			Attribute formatAttribute;
+			formatAttribute.name = "format";
+			formatAttribute.value = atsl::getImageFormatStr(format);
+
+			variableAttributes.emplace_back(std::move(formatAttribute));
+		}
+
 		if (variable.condition)
 		{
 			Attribute layoutAttribute;
@@ -393,11 +411,22 @@ void AtslShaderWriter::visit(const FunctionDeclarationStatement& statement)
 
 void AtslShaderWriter::visit(const EntryFunctionDeclarationStatement& statement)
 {
-	const std::vector<Attribute> attributes =
+	std::vector<Attribute> attributes =
 	{
-		{"entry", AtslIdentifier(atsl::getShaderStageStr(statement.stage))}
+		{"entry", atsl::getShaderStageStr(statement.stage)}
 	};
 
+	if (statement.stage == AstShaderStage::Compute)
+	{
+		const auto& size = statement.workgroupSize;
+
+		Attribute workgroupAttribute;
+		workgroupAttribute.name = "workgroup";
+		workgroupAttribute.value = "vec3u(" + std::to_string(size.x) + ", " + std::to_string(size.y) + ", " + std::to_string(size.z) + ")";
+
+		attributes.emplace_back(std::move(workgroupAttribute));
+	}
+
 	writeAttributes(attributes);
 
 	newLine();
@@ -986,9 +1015,9 @@ void AtslShaderWriter::writeAttributes(const std::vector<Attribute>& attributes)
 		{
 			m_ostream << attribute.value.get<AtslBasicValue>();
 		}
-		else if (attribute.value.is<AtslIdentifier>())
+		else if (attribute.value.is<std::string>())
 		{
-			m_ostream << attribute.value.get<AtslIdentifier>();
+			m_ostream << attribute.value.get<std::string>();
 		}
 		else if (attribute.value.is<Ptr<Expression>>())
 		{
@@ -1020,12 +1049,8 @@ void AtslShaderWriter::writeVariableDeclaration(AstType type, std::string name,
 
 	if (type.is<AstArrayType>())
 	{
-		const auto& arrayType = type.get<AstArrayType>();
-
-		if (arrayType.sizeType == AstArrayType::SizeType::Implicit)
-			ATEMA_ERROR("Array size must be specified");
-
-		m_ostream << "[" << atsl::getArraySizeStr(arrayType) << "]";
+		// Implicit sizes are valid for initialized variables and storage buffer runtime arrays
+		m_ostream << "[" << atsl::getArraySizeStr(type.get<AstArrayType>()) << "]";
 	}
 
 	if (value)
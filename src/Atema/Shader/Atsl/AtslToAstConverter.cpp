@@ -55,6 +55,46 @@ namespace
 
 		return token.value.get<T>();
 	}
+
+	uint32_t getWorkgroupDimension(const Expression& expression)
+	{
+		if (expression.getType() == Expression::Type::Constant)
+		{
+			const auto& value = static_cast<const ConstantExpression&>(expression).value;
+
+			if (value.is<int32_t>() && value.get<int32_t>() > 0)
+				return static_cast<uint32_t>(value.get<int32_t>());
+			else if (value.is<uint32_t>() && value.get<uint32_t>() > 0)
+				return value.get<uint32_t>();
+		}
+
+		ATEMA_ERROR("Workgroup size must be defined by positive integer literals");
+
+		return 1;
+	}
+
+	// Accepts a single dimension or a vector : workgroup(64), workgroup(vec2u(8, 8)), workgroup(vec3u(4, 4, 4))
+	Vector3u getWorkgroupSize(const Expression& expression)
+	{
+		Vector3u size = { 1, 1, 1 };
+
+		if (expression.getType() == Expression::Type::Cast)
+		{
+			const auto& components = static_cast<const CastExpression&>(expression).components;
+
+			if (components.empty() || components.size() > 3)
+				ATEMA_ERROR("Workgroup size must have between 1 and 3 dimensions");
+
+			for (size_t i = 0; i < components.size(); i++)
+				size[i] = getWorkgroupDimension(*components[i]);
+		}
+		else
+		{
+			size.x = getWorkgroupDimension(expression);
+		}
+
+		return size;
+	}
 }
 
 AtslToAstConverter::AtslToAstConverter():
@@ -287,6 +327,7 @@ UPtr<SequenceStatement> AtslToAstConverter::createAst(const std::vector<AtslToke
 						break;
 					}
 					case AtslKeyword::Const:
+					case AtslKeyword::Shared:
 					{
 						addStatement(parseVariableDeclaration());
 
@@ -383,18 +424,18 @@ const AtslToAstConverter::Attribute& AtslToAstConverter::getAttribute(const Atsl
 	return m_attributes.at(identifier);
 }
 
-const AtslIdentifier& AtslToAstConverter::expectAttributeIdentifier(const AtslIdentifier& name) const
+const std::string& AtslToAstConverter::expectAttributeIdentifier(const AtslIdentifier& name) const
 {
 	if (!hasAttribute(name))
 	{
-		ATEMA_ERROR("Expected '" + name + "' attribute");
+		ATEMA_ERROR("Expected '" + std::string(name) + "' attribute");
 	}
 
 	const auto& attribute = getAttribute(name);
 
 	if (attribute->getType() != Expression::Type::Variable)
 	{
-		ATEMA_ERROR("Invalid '" + name + "' attribute : expected identifier");
+		ATEMA_ERROR("Invalid '" + std::string(name) + "' attribute : expected identifier");
 	}
 
 	return static_cast<VariableExpression&>(*attribute).identifier;
@@ -553,7 +594,7 @@ UPtr<Expression> AtslToAstConverter::parsePrimaryExpression()
 			// - cast
 			case AtslTokenType::Identifier:
 			{
-				auto& identifier = token.value.get<AtslIdentifier>();
+				const std::string identifier(token.value.get<AtslIdentifier>());
 
 				// The identifier must be the first thing we get in this loop
 				if (expression)
@@ -1043,6 +1084,13 @@ AtslToAstConverter::VariableData AtslToAstConverter::parseVariableDeclarationDat
 
 		iterate();
 	}
+	// Or a variable shared by a compute workgroup
+	else if (get().is(AtslKeyword::Shared))
+	{
+		variable.qualifiers |= VariableQualifier::Shared;
+
+		iterate();
+	}
 
 	// Get type
 	variable.type = parseType();
@@ -1087,6 +1135,8 @@ AtslToAstConverter::VariableData AtslToAstConverter::parseVariableDeclarationDat
 			arrayType.componentType = type.get<AstMatrixType>();
 		else if (type.is<AstSamplerType>())
 			arrayType.componentType = type.get<AstSamplerType>();
+		else if (type.is<AstStorageImageType>())
+			arrayType.componentType = type.get<AstStorageImageType>();
 		else if (type.is<AstStructType>())
 			arrayType.componentType = type.get<AstStructType>();
 		else
@@ -1201,6 +1251,19 @@ UPtr<Statement> AtslToAstConverter::parseVariableBlock()
 				if (hasAttribute("layout"))
 					variable.structLayout = atsl::getStructLayout(expectAttributeIdentifier("layout"));
 
+				// Storage images need their format to be read
+				if (hasAttribute("format"))
+				{
+					const auto format = atsl::getImageFormat(expectAttributeIdentifier("format"));
+
+					if (variable.type.is<AstStorageImageType>())
+						variable.type.get<AstStorageImageType>().format = format;
+					else if (variable.type.is<AstArrayType>() && variable.type.get<AstArrayType>().componentType.is<AstStorageImageType>())
+						variable.type.get<AstArrayType>().componentType.get<AstStorageImageType>().format = format;
+					else
+						ATEMA_ERROR("Only storage images can define a format");
+				}
+
 				statementPtr->variables.push_back(variable);
 			};
 			
@@ -1654,6 +1717,14 @@ UPtr<FunctionDeclarationStatement> AtslToAstConverter::parseFunctionDeclaration(
 
 		entryFunctionStatement->stage = atsl::getShaderStage(expectAttributeIdentifier("entry"));
 
+		if (hasAttribute("workgroup"))
+		{
+			if (entryFunctionStatement->stage != AstShaderStage::Compute)
+				ATEMA_ERROR("Workgroup size can only be defined for compute shaders");
+
+			entryFunctionStatement->workgroupSize = getWorkgroupSize(*getAttribute("workgroup"));
+		}
+
 		statement = std::move(entryFunctionStatement);
 	}
 	// Generic function
@@ -1772,7 +1843,7 @@ AstType AtslToAstConverter::parseType()
 {
 	ATEMA_ASSERT(get().type == AtslTokenType::Identifier, "Expected variable type");
 
-	const auto type = atsl::getType(expectType<AtslIdentifier>(iterate()));
+	const auto type = atsl::getType(std::string(expectType<AtslIdentifier>(iterate())));
 
 	// Array type
 	if (get().is(AtslSymbol::LeftBracket))
@@ -1807,6 +1878,8 @@ AstType AtslToAstConverter::parseType()
 			arrayType.componentType = type.get<AstMatrixType>();
 		else if (type.is<AstSamplerType>())
 			arrayType.componentType = type.get<AstSamplerType>();
+		else if (type.is<AstStorageImageType>())
+			arrayType.componentType = type.get<AstStorageImageType>();
 		else if (type.is<AstStructType>())
 			arrayType.componentType = type.get<AstStructType>();
 		else
@@ -1831,7 +1904,7 @@ UPtr<VariableExpression> AtslToAstConverter::parseVariable()
 
 UPtr<Expression> AtslToAstConverter::parseFunctionCall()
 {
-	auto& identifier = iterate().value.get<AtslIdentifier>();
+	const std::string identifier(iterate().value.get<AtslIdentifier>());
 
 	if (atsl::isBuiltInFunction(identifier))
 	{
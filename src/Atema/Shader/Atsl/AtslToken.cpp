@@ -41,7 +41,7 @@ AtslToken::AtslToken(AtslKeyword keyword) :
 {
 }
 
-AtslToken::AtslToken(const AtslIdentifier& identifier) :
+AtslToken::AtslToken(AtslIdentifier identifier) :
 	type(AtslTokenType::Identifier),
 	value(identifier),
 	line(0),
@@ -91,7 +91,7 @@ bool AtslToken::is(AtslKeyword keyword) const noexcept
 	return value.is<AtslKeyword>() && value.get<AtslKeyword>() == keyword;
 }
 
-bool AtslToken::is(const AtslIdentifier& identifier) const noexcept
+bool AtslToken::is(AtslIdentifier identifier) const noexcept
 {
 	return value.is<AtslIdentifier>() && value.get<AtslIdentifier>() == identifier;
 }
@@ -150,7 +150,7 @@ std::string AtslToken::toString() const
 		}
 		case AtslTokenType::Identifier:
 		{
-			return value.get<AtslIdentifier>();
+			return std::string(value.get<AtslIdentifier>());
 		}
 		case AtslTokenType::Value:
 		{
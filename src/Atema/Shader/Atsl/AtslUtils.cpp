@@ -39,6 +39,7 @@ namespace
 		{ AtslKeyword::Optional, "optional" },
 		{ AtslKeyword::Include, "include" },
 		{ AtslKeyword::Const, "const" },
+		{ AtslKeyword::Shared, "shared" },
 		{ AtslKeyword::If, "if" },
 		{ AtslKeyword::Else, "else" },
 		{ AtslKeyword::For, "for" },
@@ -60,6 +61,7 @@ namespace
 		{ "optional", AtslKeyword::Optional },
 		{ "include", AtslKeyword::Include },
 		{ "const", AtslKeyword::Const },
+		{ "shared", AtslKeyword::Shared },
 		{ "if", AtslKeyword::If },
 		{ "else", AtslKeyword::Else },
 		{ "for", AtslKeyword::For },
@@ -83,6 +85,12 @@ namespace
 		{ BuiltInFunction::Sample, "sample" },
 		{ BuiltInFunction::SetVertexPosition, "setVertexPosition" },
 		{ BuiltInFunction::GetFragmentCoordinates, "getFragmentCoordinates" },
+		{ BuiltInFunction::GetGlobalInvocationId, "getGlobalInvocationId" },
+		{ BuiltInFunction::GetLocalInvocationId, "getLocalInvocationId" },
+		{ BuiltInFunction::GetWorkgroupId, "getWorkgroupId" },
+		{ BuiltInFunction::Barrier, "barrier" },
+		{ BuiltInFunction::ImageLoad, "imageLoad" },
+		{ BuiltInFunction::ImageStore, "imageStore" },
 	};
 
 	std::unordered_map<std::string, BuiltInFunction> s_strToBuiltInFunction =
@@ -96,6 +104,28 @@ namespace
 		{ "sample", BuiltInFunction::Sample },
 		{ "setVertexPosition", BuiltInFunction::SetVertexPosition },
 		{ "getFragmentCoordinates", BuiltInFunction::GetFragmentCoordinates },
+		{ "getGlobalInvocationId", BuiltInFunction::GetGlobalInvocationId },
+		{ "getLocalInvocationId", BuiltInFunction::GetLocalInvocationId },
+		{ "getWorkgroupId", BuiltInFunction::GetWorkgroupId },
+		{ "barrier", BuiltInFunction::Barrier },
+		{ "imageLoad", BuiltInFunction::ImageLoad },
+		{ "imageStore", BuiltInFunction::ImageStore },
+	};
+
+	std::unordered_map<AstImageFormat, std::string> s_imageFormatToStr =
+	{
+		{ AstImageFormat::Rgba8, "rgba8" },
+		{ AstImageFormat::Rgba8Snorm, "rgba8_snorm" },
+		{ AstImageFormat::Rgba16f, "rgba16f" },
+		{ AstImageFormat::Rgba32f, "rgba32f" },
+		{ AstImageFormat::Rg16f, "rg16f" },
+		{ AstImageFormat::Rg32f, "rg32f" },
+		{ AstImageFormat::R16f, "r16f" },
+		{ AstImageFormat::R32f, "r32f" },
+		{ AstImageFormat::Rgba32i, "rgba32i" },
+		{ AstImageFormat::Rgba32ui, "rgba32ui" },
+		{ AstImageFormat::R32i, "r32i" },
+		{ AstImageFormat::R32ui, "r32ui" }
 	};
 
 	size_t getComponentCount(char c)
@@ -264,6 +294,17 @@ namespace
 		return typeStr + getPrimitiveSuffix(type.primitiveType);
 	}
 
+	std::string getTypeStr(const AstStorageImageType& type)
+	{
+		// Same naming as samplers, but arrays also keep their primitive suffix
+		auto typeStr = "image" + getTypeStr(AstSamplerType{ type.imageType, type.primitiveType }).substr(7);
+
+		if (type.imageType == AstImageType::TextureArray1D || type.imageType == AstImageType::TextureArray2D)
+			typeStr += getPrimitiveSuffix(type.primitiveType);
+
+		return typeStr;
+	}
+
 	std::string getTypeStr(const AstStructType& type)
 	{
 		return type.name;
@@ -399,7 +440,11 @@ bool atsl::isType(const std::string& typeStr)
 		"sampler2Di", "sampler2Du", "sampler2Df",
 		"sampler3Di", "sampler3Du", "sampler3Df",
 		"sampler4Di", "sampler4Du", "sampler4Df",
-		"samplerCubei", "samplerCubeu", "samplerCubef"
+		"samplerCubei", "samplerCubeu", "samplerCubef",
+		"image1Di", "image1Du", "image1Df",
+		"image2Di", "image2Du", "image2Df",
+		"image3Di", "image3Du", "image3Df",
+		"imageCubei", "imageCubeu", "imageCubef"
 	};
 
 	return s_types.find(typeStr) != s_types.end();
@@ -462,6 +507,15 @@ AstType atsl::getType(const std::string& typeStr)
 		return type;
 	}
 
+	if (!typeStr.compare(0, 5, "image") && typeStr.size() >= 7)
+	{
+		AstStorageImageType type;
+		type.imageType = getSamplerImageType(typeStr.substr(5, typeStr.size() - 6));
+		type.primitiveType = getSamplerPrimitiveType(typeStr.back());
+
+		return type;
+	}
+
 	return AstStructType{ typeStr };
 }
 
@@ -479,6 +533,8 @@ std::string atsl::getTypeStr(const AstType& type)
 		return ::getTypeStr(type.get<AstMatrixType>());
 	else if (type.is<AstSamplerType>())
 		return ::getTypeStr(type.get<AstSamplerType>());
+	else if (type.is<AstStorageImageType>())
+		return ::getTypeStr(type.get<AstStorageImageType>());
 	else if (type.is<AstStructType>())
 		return ::getTypeStr(type.get<AstStructType>());
 
@@ -497,6 +553,8 @@ std::string atsl::getTypeStr(const AstArrayType::ComponentType& type)
 		return ::getTypeStr(type.get<AstMatrixType>());
 	else if (type.is<AstSamplerType>())
 		return ::getTypeStr(type.get<AstSamplerType>());
+	else if (type.is<AstStorageImageType>())
+		return ::getTypeStr(type.get<AstStorageImageType>());
 	else if (type.is<AstStructType>())
 		return ::getTypeStr(type.get<AstStructType>());
 
@@ -570,6 +628,8 @@ AstShaderStage atsl::getShaderStage(const std::string& stage)
 		return AstShaderStage::Vertex;
 	else if (stage == "fragment")
 		return AstShaderStage::Fragment;
+	else if (stage == "compute")
+		return AstShaderStage::Compute;
 
 	ATEMA_ERROR("Invalid shader stage '" + stage + "'");
 
@@ -582,6 +642,7 @@ std::string atsl::getShaderStageStr(AstShaderStage stage)
 	{
 		case AstShaderStage::Vertex: return "vertex";
 		case AstShaderStage::Fragment: return "fragment";
+		case AstShaderStage::Compute: return "compute";
 		default:
 		{
 			ATEMA_ERROR("Invalid shader stage");
@@ -595,6 +656,8 @@ StructLayout atsl::getStructLayout(const std::string& str)
 {
 	if (str == "std140")
 		return StructLayout::Std140;
+	else if (str == "std430")
+		return StructLayout::Std430;
 
 	ATEMA_ERROR("Invalid struct layout '" + str + "'");
 
@@ -606,6 +669,7 @@ std::string atsl::getStructLayoutStr(StructLayout structLayout)
 	switch (structLayout)
 	{
 		case StructLayout::Std140: return "std140";
+		case StructLayout::Std430: return "std430";
 		default:
 		{
 			ATEMA_ERROR("Invalid struct layout");
@@ -615,6 +679,31 @@ std::string atsl::getStructLayoutStr(StructLayout structLayout)
 	return "";
 }
 
+AstImageFormat atsl::getImageFormat(const std::string& str)
+{
+	for (const auto& [format, formatStr] : s_imageFormatToStr)
+	{
+		if (formatStr == str)
+			return format;
+	}
+
+	ATEMA_ERROR("Invalid image format '" + str + "'");
+
+	return AstImageFormat::Unknown;
+}
+
+std::string atsl::getImageFormatStr(AstImageFormat format)
+{
+	const auto it = s_imageFormatToStr.find(format);
+
+	if (it == s_imageFormatToStr.end())
+	{
+		ATEMA_ERROR("Invalid image format");
+	}
+
+	return it->second;
+}
+
 bool atsl::isExpressionDelimiter(AtslSymbol symbol)
 {
 	switch (symbol)
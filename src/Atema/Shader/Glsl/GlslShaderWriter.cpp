@@ -34,6 +34,7 @@ namespace
 		{
 			case AstShaderStage::Vertex: return "VS";
 			case AstShaderStage::Fragment: return "FS";
+			case AstShaderStage::Compute: return "CS";
 			default:
 			{
 				ATEMA_ERROR("Invalid shader stage");
@@ -49,7 +50,8 @@ GlslShaderWriter::GlslShaderWriter(std::ostream& ostream, Settings settings) :
 	m_stage(settings.stage),
 	m_ostream(ostream),
 	m_settings(settings),
-	m_indent(0)
+	m_indent(0),
+	m_isInStorageBlock(false)
 {
 }
 
@@ -163,12 +165,29 @@ void GlslShaderWriter::visit(const VariableDeclarationStatement& statement)
 {
 	if (statement.qualifiers & VariableQualifier::Const)
 		m_ostream << "const ";
+	else if (statement.qualifiers & VariableQualifier::Shared)
+		m_ostream << "shared ";
 
 	writeVariableDeclaration(statement.type, statement.name, statement.value.get());
 }
 
 void GlslShaderWriter::visit(const StructDeclarationStatement& statement)
 {
+	// Save struct declaration for uniform interface block declaration
+	{
+		AstCloner cloner;
+		m_structDeclarations[statement.name] = cloner.clone(statement);
+	}
+
+	// Structs ending with a runtime array can only be declared as storage blocks
+	if (!statement.members.empty())
+	{
+		const auto& lastType = statement.members.back().type;
+
+		if (lastType.is<AstArrayType>() && lastType.get<AstArrayType>().sizeType == AstArrayType::SizeType::Implicit)
+			return;
+	}
+
 	m_ostream << "struct " << statement.name;
 
 	beginBlock();
@@ -199,12 +218,6 @@ void GlslShaderWriter::visit(const StructDeclarationStatement& statement)
 	endBlock();
 
 	addDelimiter();
-
-	// Save struct declaration for uniform interface block declaration
-	{
-		AstCloner cloner;
-		m_structDeclarations[statement.name] = cloner.clone(statement);
-	}
 }
 
 void GlslShaderWriter::visit(const InputDeclarationStatement& statement)
@@ -304,7 +317,23 @@ void GlslShaderWriter::visit(const ExternalDeclarationStatement& statement)
 			newLine();
 		}
 
-		if (variable.type.is<AstStructType>())
+		if (variable.type.is<AstStructType>() && variable.structLayout == StructLayout::Std430)
+		{
+			writeLayout(variable.setIndex, variable.bindingIndex, variable.structLayout);
+
+			m_ostream << " buffer ";
+
+			m_isInStorageBlock = true;
+
+			writeInterfaceBlock(variable.type.get<AstStructType>().name, variable.name, "B");
+
+			m_isInStorageBlock = false;
+
+			// Add line except for last element
+			if (&variable != &statement.variables.back())
+				newLine();
+		}
+		else if (variable.type.is<AstStructType>())
 		{
 			writeLayout(variable.setIndex, variable.bindingIndex, variable.structLayout);
 
@@ -316,6 +345,14 @@ void GlslShaderWriter::visit(const ExternalDeclarationStatement& statement)
 			if (&variable != &statement.variables.back())
 				newLine();
 		}
+		else if (variable.type.is<AstStorageImageType>() && variable.type.get<AstStorageImageType>().format != AstImageFormat::Unknown)
+		{
+			writeLayout(variable.setIndex, variable.bindingIndex, variable.type.get<AstStorageImageType>().format);
+
+			m_ostream << " uniform ";
+
+			writeVariableDeclaration(variable.type, variable.name);
+		}
 		else
 		{
 			writeLayout(variable.setIndex, variable.bindingIndex);
@@ -396,6 +433,16 @@ void GlslShaderWriter::visit(const FunctionDeclarationStatement& statement)
 
 void GlslShaderWriter::visit(const EntryFunctionDeclarationStatement& statement)
 {
+	if (statement.stage == AstShaderStage::Compute)
+	{
+		const auto& size = statement.workgroupSize;
+
+		m_ostream << "layout(local_size_x = " << size.x << ", local_size_y = " << size.y << ", local_size_z = " << size.z << ") in;";
+
+		newLine();
+		newLine();
+	}
+
 	m_ostream << "void main()";
 
 	beginBlock();
@@ -858,6 +905,18 @@ void GlslShaderWriter::visit(const BuiltInFunctionCallExpression& expression)
 	{
 		m_ostream << "gl_FragCoord";
 	}
+	else if (expression.function == BuiltInFunction::GetGlobalInvocationId)
+	{
+		m_ostream << "gl_GlobalInvocationID";
+	}
+	else if (expression.function == BuiltInFunction::GetLocalInvocationId)
+	{
+		m_ostream << "gl_LocalInvocationID";
+	}
+	else if (expression.function == BuiltInFunction::GetWorkgroupId)
+	{
+		m_ostream << "gl_WorkGroupID";
+	}
 	// Classic function calls
 	else
 	{
@@ -900,6 +959,21 @@ void GlslShaderWriter::visit(const BuiltInFunctionCallExpression& expression)
 				functionName = "texture";
 				break;
 			}
+			case BuiltInFunction::Barrier:
+			{
+				functionName = "barrier";
+				break;
+			}
+			case BuiltInFunction::ImageLoad:
+			{
+				functionName = "imageLoad";
+				break;
+			}
+			case BuiltInFunction::ImageStore:
+			{
+				functionName = "imageStore";
+				break;
+			}
 			default:
 			{
 				ATEMA_ERROR("Invalid built-in function");
@@ -1045,6 +1119,15 @@ void GlslShaderWriter::writeHeader()
 	if (version < 410)
 		extensions.push_back("GL_ARB_separate_shader_objects"); // layout(location = XXX)
 
+	if (m_stage == AstShaderStage::Compute && version < 430)
+	{
+		extensions.push_back("GL_ARB_compute_shader");
+		extensions.push_back("GL_ARB_shader_storage_buffer_object");
+
+		if (version < 420)
+			extensions.push_back("GL_ARB_shader_image_load_store");
+	}
+
 	for (auto& extension : extensions)
 	{
 		m_ostream << "#extension " << extension << " : require";
@@ -1092,6 +1175,19 @@ void GlslShaderWriter::writeLayout(const Ptr<Expression>& set, const Ptr<Express
 	m_ostream << ", " << glsl::getStructLayoutStr(structLayout) << ")";
 }
 
+void GlslShaderWriter::writeLayout(const Ptr<Expression>& set, const Ptr<Expression>& binding, AstImageFormat format)
+{
+	m_ostream << "layout(set = ";
+
+	set->accept(*this);
+
+	m_ostream << ", binding = ";
+
+	binding->accept(*this);
+
+	m_ostream << ", " << glsl::getImageFormatStr(format) << ")";
+}
+
 void GlslShaderWriter::writeType(AstType type)
 {
 	m_ostream << glsl::getTypeStr(type);
@@ -1115,7 +1211,7 @@ void GlslShaderWriter::writeVariableDeclaration(AstType type, std::string name,
 	{
 		const auto& arrayType = type.get<AstArrayType>();
 
-		if (arrayType.sizeType == AstArrayType::SizeType::Implicit)
+		if (arrayType.sizeType == AstArrayType::SizeType::Implicit && !m_isInStorageBlock)
 			ATEMA_ERROR("Array size must be specified");
 
 		m_ostream << "[" << glsl::getArraySizeStr(arrayType) << "]";
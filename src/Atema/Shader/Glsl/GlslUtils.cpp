@@ -124,6 +124,14 @@ namespace
 		return getPrimitivePrefix(type.primitiveType) + typeStr;
 	}
 
+	std::string getTypeStr(const AstStorageImageType& type)
+	{
+		// Same naming as samplers, but the primitive prefix is kept for arrays
+		auto typeStr = getTypeStr(AstSamplerType{ type.imageType, AstPrimitiveType::Float });
+
+		return getPrimitivePrefix(type.primitiveType) + "image" + typeStr.substr(7);
+	}
+
 	std::string getTypeStr(const AstStructType& type)
 	{
 		return type.name;
@@ -149,6 +157,8 @@ std::string glsl::getTypeStr(const AstType& type)
 		return ::getTypeStr(type.get<AstMatrixType>());
 	else if (type.is<AstSamplerType>())
 		return ::getTypeStr(type.get<AstSamplerType>());
+	else if (type.is<AstStorageImageType>())
+		return ::getTypeStr(type.get<AstStorageImageType>());
 	else if (type.is<AstStructType>())
 		return ::getTypeStr(type.get<AstStructType>());
 
@@ -167,6 +177,8 @@ std::string glsl::getTypeStr(const AstArrayType::ComponentType& type)
 		return ::getTypeStr(type.get<AstMatrixType>());
 	else if (type.is<AstSamplerType>())
 		return ::getTypeStr(type.get<AstSamplerType>());
+	else if (type.is<AstStorageImageType>())
+		return ::getTypeStr(type.get<AstStorageImageType>());
 	else if (type.is<AstStructType>())
 		return ::getTypeStr(type.get<AstStructType>());
 
@@ -210,6 +222,7 @@ std::string glsl::getStructLayoutStr(StructLayout structLayout)
 	switch (structLayout)
 	{
 		case StructLayout::Std140: return "std140";
+		case StructLayout::Std430: return "std430";
 		default:
 		{
 			ATEMA_ERROR("Invalid struct layout");
@@ -218,3 +231,28 @@ std::string glsl::getStructLayoutStr(StructLayout structLayout)
 
 	return "";
 }
+
+std::string glsl::getImageFormatStr(AstImageFormat format)
+{
+	switch (format)
+	{
+		case AstImageFormat::Rgba8: return "rgba8";
+		case AstImageFormat::Rgba8Snorm: return "rgba8_snorm";
+		case AstImageFormat::Rgba16f: return "rgba16f";
+		case AstImageFormat::Rgba32f: return "rgba32f";
+		case AstImageFormat::Rg16f: return "rg16f";
+		case AstImageFormat::Rg32f: return "rg32f";
+		case AstImageFormat::R16f: return "r16f";
+		case AstImageFormat::R32f: return "r32f";
+		case AstImageFormat::Rgba32i: return "rgba32i";
+		case AstImageFormat::Rgba32ui: return "rgba32ui";
+		case AstImageFormat::R32i: return "r32i";
+		case AstImageFormat::R32ui: return "r32ui";
+		default:
+		{
+			ATEMA_ERROR("Invalid image format");
+		}
+	}
+
+	return "";
+}
@@ -0,0 +1,262 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Atema/Shader/ShaderLibraryBundle.hpp>
+#include <Atema/Core/Error.hpp>
+#include <Atema/Shader/Ast/AstSerializer.hpp>
+
+#include <cstring>
+#include <fstream>
+
+using namespace at;
+
+namespace
+{
+	// Stable across platforms, unlike the default hash
+	using FileHasher = Hasher<FNV1a<Hash64>>;
+
+	constexpr uint32_t FileMagic = 0x424C5341; // 'ASLB'
+	constexpr uint32_t FileVersion = 1;
+
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t astVersion;
+		uint32_t entryCount;
+	};
+
+	// Followed by the name & the serialized AST
+	struct EntryHeader
+	{
+		Hash64 key;
+		uint32_t nameSize;
+		uint32_t dataSize;
+	};
+
+	// The mapped data has no alignment guarantee
+	template <typename T>
+	bool readHeader(const uint8_t*& data, const uint8_t* end, T& header)
+	{
+		if (static_cast<size_t>(end - data) < sizeof(T))
+			return false;
+
+		std::memcpy(&header, data, sizeof(T));
+		data += sizeof(T);
+
+		return true;
+	}
+
+	const std::string EmptyName;
+}
+
+ShaderLibraryBundle::ShaderLibraryBundle()
+{
+}
+
+ShaderLibraryBundle::~ShaderLibraryBundle()
+{
+}
+
+Hash64 ShaderLibraryBundle::getKey(const std::string& atslCode)
+{
+	return FileHasher::hash(atslCode.data(), atslCode.size());
+}
+
+bool ShaderLibraryBundle::load(const std::filesystem::path& path)
+{
+	clear();
+
+	auto file = std::make_unique<MappedFile>(path);
+
+	if (!file->isOpen())
+		return false;
+
+	const auto begin = static_cast<const uint8_t*>(file->getData());
+	const auto end = begin + file->getSize();
+	auto data = begin;
+
+	FileHeader fileHeader;
+
+	if (!readHeader(data, end, fileHeader))
+		return false;
+
+	if (fileHeader.magic != FileMagic || fileHeader.version != FileVersion || fileHeader.astVersion != AstSerializer::Version)
+		return false;
+
+	// Only the entry table is read here, ASTs are deserialized on demand
+	m_keys.reserve(fileHeader.entryCount);
+	m_entries.reserve(fileHeader.entryCount);
+
+	for (uint32_t i = 0; i < fileHeader.entryCount; i++)
+	{
+		EntryHeader entryHeader;
+
+		if (!readHeader(data, end, entryHeader) ||
+			static_cast<size_t>(end - data) < static_cast<size_t>(entryHeader.nameSize) + entryHeader.dataSize)
+		{
+			clear();
+			return false;
+		}
+
+		auto& entry = m_entries[entryHeader.key];
+		entry.name.assign(reinterpret_cast<const char*>(data), entryHeader.nameSize);
+		data += entryHeader.nameSize;
+
+		entry.data = data;
+		entry.byteSize = entryHeader.dataSize;
+		data += entryHeader.dataSize;
+
+		m_keys.emplace_back(entryHeader.key);
+	}
+
+	m_file = std::move(file);
+
+	return true;
+}
+
+void ShaderLibraryBundle::save(const std::filesystem::path& path) const
+{
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path());
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+		ATEMA_ERROR("Failed to open file '" + path.string() + "'");
+
+	FileHeader fileHeader;
+	fileHeader.magic = FileMagic;
+	fileHeader.version = FileVersion;
+	fileHeader.astVersion = AstSerializer::Version;
+	fileHeader.entryCount = static_cast<uint32_t>(m_keys.size());
+
+	file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(FileHeader));
+
+	for (const auto& key : m_keys)
+	{
+		const auto& entry = m_entries.at(key);
+
+		EntryHeader entryHeader;
+		entryHeader.key = key;
+		entryHeader.nameSize = static_cast<uint32_t>(entry.name.size());
+		entryHeader.dataSize = static_cast<uint32_t>(entry.byteSize);
+
+		file.write(reinterpret_cast<const char*>(&entryHeader), sizeof(EntryHeader));
+		file.write(entry.name.data(), static_cast<std::streamsize>(entry.name.size()));
+		file.write(reinterpret_cast<const char*>(entry.data), static_cast<std::streamsize>(entry.byteSize));
+	}
+
+	if (!file)
+		ATEMA_ERROR("Failed to write file '" + path.string() + "'");
+}
+
+void ShaderLibraryBundle::add(Hash64 key, const std::string& name, const SequenceStatement& ast)
+{
+	AstSerializer serializer;
+	serializer.serialize(ast);
+
+	auto it = m_entries.find(key);
+
+	if (it == m_entries.end())
+	{
+		it = m_entries.emplace(key, Entry()).first;
+
+		m_keys.emplace_back(key);
+	}
+
+	// Entries are never moved by the map, so the data pointer stays valid
+	auto& entry = it->second;
+	entry.name = name;
+	entry.ownedData = serializer.getData();
+	entry.data = entry.ownedData.data();
+	entry.byteSize = entry.ownedData.size();
+}
+
+void ShaderLibraryBundle::add(const ShaderLibraryBundle& other)
+{
+	for (const auto& key : other.m_keys)
+	{
+		const auto& otherEntry = other.m_entries.at(key);
+
+		auto it = m_entries.find(key);
+
+		if (it == m_entries.end())
+		{
+			it = m_entries.emplace(key, Entry()).first;
+
+			m_keys.emplace_back(key);
+		}
+
+		auto& entry = it->second;
+		entry.name = otherEntry.name;
+		entry.ownedData.assign(otherEntry.data, otherEntry.data + otherEntry.byteSize);
+		entry.data = entry.ownedData.data();
+		entry.byteSize = entry.ownedData.size();
+	}
+}
+
+bool ShaderLibraryBundle::contains(Hash64 key) const
+{
+	return m_entries.find(key) != m_entries.end();
+}
+
+UPtr<SequenceStatement> ShaderLibraryBundle::getAst(Hash64 key) const
+{
+	const auto it = m_entries.find(key);
+
+	if (it == m_entries.end())
+		return nullptr;
+
+	const auto& entry = it->second;
+
+	AstDeserializer deserializer(entry.data, entry.byteSize);
+
+	auto statement = deserializer.deserialize();
+
+	if (!statement || statement->getType() != Statement::Type::Sequence || deserializer.getRemainingSize() != 0)
+		ATEMA_ERROR("Invalid AST for shader '" + entry.name + "'");
+
+	return UPtr<SequenceStatement>(static_cast<SequenceStatement*>(statement.release()));
+}
+
+const std::string& ShaderLibraryBundle::getName(Hash64 key) const
+{
+	const auto it = m_entries.find(key);
+
+	if (it == m_entries.end())
+		return EmptyName;
+
+	return it->second.name;
+}
+
+size_t ShaderLibraryBundle::getSize() const noexcept
+{
+	return m_keys.size();
+}
+
+void ShaderLibraryBundle::clear()
+{
+	m_keys.clear();
+	m_entries.clear();
+	m_file.reset();
+}
@@ -0,0 +1,354 @@
+/*
+	Copyright 2023 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Shader/Spirv/SpirvShaderCache.hpp>
+#include <Atema/Core/Timer.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace at;
+
+namespace
+{
+	constexpr uint32_t SpirvMagicNumber = 0x07230203;
+
+	constexpr size_t DefaultMaxSize = 64 * 1024 * 1024;
+
+	const std::string EntryExtension = ".spv";
+	const std::string TemporaryExtension = ".tmp";
+
+	constexpr size_t KeyLength = sizeof(Hash64) * 2;
+}
+
+SpirvShaderCache::SpirvShaderCache() :
+	m_maxSize(DefaultMaxSize),
+	m_size(0),
+	m_tempFileCount(0)
+{
+}
+
+SpirvShaderCache& SpirvShaderCache::instance()
+{
+	static SpirvShaderCache s_instance;
+
+	return s_instance;
+}
+
+void SpirvShaderCache::setDirectory(const std::filesystem::path& directory)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_directory = directory;
+	m_entries.clear();
+	m_size = 0;
+
+	if (m_directory.empty())
+		return;
+
+	std::filesystem::create_directories(m_directory);
+
+	scanDirectory();
+
+	evict();
+}
+
+void SpirvShaderCache::setMaxSize(size_t byteSize)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_maxSize = byteSize;
+
+	evict();
+}
+
+std::filesystem::path SpirvShaderCache::getDirectory() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_directory;
+}
+
+size_t SpirvShaderCache::getMaxSize() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_maxSize;
+}
+
+size_t SpirvShaderCache::getSize() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_size;
+}
+
+bool SpirvShaderCache::isEnabled() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return !m_directory.empty();
+}
+
+bool SpirvShaderCache::load(Hash64 key, std::vector<uint32_t>& spirv)
+{
+	Timer timer;
+
+	std::filesystem::path path;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_directory.empty() || m_entries.find(key) == m_entries.end())
+		{
+			m_statistics.misses++;
+
+			return false;
+		}
+
+		path = getPath(key);
+	}
+
+	// Read the file without locking, other threads may load or compile meanwhile
+	bool valid = false;
+
+	std::error_code errorCode;
+	const auto byteSize = static_cast<size_t>(std::filesystem::file_size(path, errorCode));
+
+	if (!errorCode && byteSize > 0 && byteSize % sizeof(uint32_t) == 0)
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		spirv.resize(byteSize / sizeof(uint32_t));
+
+		file.read(reinterpret_cast<char*>(spirv.data()), static_cast<std::streamsize>(byteSize));
+
+		valid = file && spirv[0] == SpirvMagicNumber;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	const auto it = m_entries.find(key);
+
+	if (!valid)
+	{
+		spirv.clear();
+
+		// The entry was removed or corrupted : forget it
+		if (it != m_entries.end())
+		{
+			m_size -= it->second.size;
+			m_entries.erase(it);
+		}
+
+		std::filesystem::remove(path, errorCode);
+
+		m_statistics.misses++;
+
+		return false;
+	}
+
+	// Keep track of the last use, across runs too
+	const auto now = std::filesystem::file_time_type::clock::now();
+
+	if (it != m_entries.end())
+		it->second.lastUse = now;
+
+	std::filesystem::last_write_time(path, now, errorCode);
+
+	m_statistics.hits++;
+	m_statistics.loadTime += timer.getStep();
+
+	return true;
+}
+
+void SpirvShaderCache::save(Hash64 key, const std::vector<uint32_t>& spirv, const TimeStep& compileTime)
+{
+	std::filesystem::path path;
+	std::filesystem::path tempPath;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_statistics.compileTime += compileTime;
+
+		if (m_directory.empty() || spirv.empty())
+			return;
+
+		path = getPath(key);
+
+		// Temporary names must be unique, other threads (or processes) may write the same entry
+		std::stringstream tempName;
+		tempName << path.filename().string() << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "." << m_tempFileCount++ << TemporaryExtension;
+
+		tempPath = m_directory / tempName.str();
+	}
+
+	const auto byteSize = spirv.size() * sizeof(uint32_t);
+
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open())
+			return;
+
+		file.write(reinterpret_cast<const char*>(spirv.data()), static_cast<std::streamsize>(byteSize));
+
+		if (!file)
+		{
+			file.close();
+
+			std::error_code errorCode;
+			std::filesystem::remove(tempPath, errorCode);
+
+			return;
+		}
+	}
+
+	// Renaming is atomic : readers either see the complete entry or nothing
+	std::error_code errorCode;
+	std::filesystem::rename(tempPath, path, errorCode);
+
+	// Another writer won the race (some platforms can't replace an existing file)
+	if (errorCode)
+	{
+		std::filesystem::remove(tempPath, errorCode);
+
+		if (!std::filesystem::exists(path, errorCode))
+			return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto& entry = m_entries[key];
+
+	m_size -= entry.size;
+	m_size += byteSize;
+
+	entry.size = byteSize;
+	entry.lastUse = std::filesystem::file_time_type::clock::now();
+
+	evict();
+}
+
+void SpirvShaderCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::error_code errorCode;
+
+	for (const auto& [key, entry] : m_entries)
+		std::filesystem::remove(getPath(key), errorCode);
+
+	m_entries.clear();
+	m_size = 0;
+}
+
+SpirvShaderCache::Statistics SpirvShaderCache::getStatistics() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_statistics;
+}
+
+void SpirvShaderCache::resetStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_statistics = Statistics();
+}
+
+std::filesystem::path SpirvShaderCache::getPath(Hash64 key) const
+{
+	std::stringstream name;
+	name << std::hex << std::setw(KeyLength) << std::setfill('0') << key << EntryExtension;
+
+	return m_directory / name.str();
+}
+
+void SpirvShaderCache::scanDirectory()
+{
+	std::error_code errorCode;
+
+	for (const auto& directoryEntry : std::filesystem::directory_iterator(m_directory, errorCode))
+	{
+		if (!directoryEntry.is_regular_file(errorCode))
+			continue;
+
+		const auto& path = directoryEntry.path();
+		const auto extension = path.extension().string();
+
+		// Leftovers of an interrupted write
+		if (extension == TemporaryExtension)
+		{
+			std::filesystem::remove(path, errorCode);
+
+			continue;
+		}
+
+		const auto stem = path.stem().string();
+
+		if (extension != EntryExtension || stem.size() != KeyLength || stem.find_first_not_of("0123456789abcdef") != std::string::npos)
+			continue;
+
+		const auto key = static_cast<Hash64>(std::stoull(stem, nullptr, 16));
+
+		auto& entry = m_entries[key];
+		entry.size = static_cast<size_t>(directoryEntry.file_size(errorCode));
+		entry.lastUse = directoryEntry.last_write_time(errorCode);
+
+		m_size += entry.size;
+	}
+}
+
+void SpirvShaderCache::evict()
+{
+	if (m_maxSize == 0 || m_size <= m_maxSize)
+		return;
+
+	std::vector<std::pair<std::filesystem::file_time_type, Hash64>> entries;
+	entries.reserve(m_entries.size());
+
+	for (const auto& [key, entry] : m_entries)
+		entries.emplace_back(entry.lastUse, key);
+
+	std::sort(entries.begin(), entries.end());
+
+	std::error_code errorCode;
+
+	for (const auto& [lastUse, key] : entries)
+	{
+		if (m_size <= m_maxSize)
+			break;
+
+		const auto it = m_entries.find(key);
+
+		std::filesystem::remove(getPath(key), errorCode);
+
+		m_size -= it->second.size;
+		m_entries.erase(it);
+
+		m_statistics.evictions++;
+	}
+}
@@ -19,141 +19,783 @@
 	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+
 #include <Atema/Shader/Spirv/SpirvShaderWriter.hpp>
+#include <Atema/Shader/Ast/AstEvaluator.hpp>
+#include <Atema/Shader/Ast/AstReflector.hpp>
 
-#include <glslang/Public/ShaderLang.h>
-#include <glslang/SPIRV/GlslangToSpv.h>
+#include <algorithm>
+#include <cstring>
 
 using namespace at;
 
 namespace
 {
-	EShLanguage getEShLanguage(AstShaderStage stage)
+	// Subset of the SPIR-V specification used by the writer (unified1 headers are not available on every platform)
+	namespace spv
+	{
+		constexpr uint32_t MagicNumber = 0x07230203;
+		constexpr uint32_t Version = 0x00010000;
+
+		enum Op : uint32_t
+		{
+			OpUndef = 1,
+			OpName = 5,
+			OpMemberName = 6,
+			OpExtInstImport = 11,
+			OpExtInst = 12,
+			OpMemoryModel = 14,
+			OpEntryPoint = 15,
+			OpExecutionMode = 16,
+			OpCapability = 17,
+			OpTypeVoid = 19,
+			OpTypeBool = 20,
+			OpTypeInt = 21,
+			OpTypeFloat = 22,
+			OpTypeVector = 23,
+			OpTypeMatrix = 24,
+			OpTypeImage = 25,
+			OpTypeSampledImage = 27,
+			OpTypeArray = 28,
+			OpTypeRuntimeArray = 29,
+			OpTypeStruct = 30,
+			OpTypePointer = 32,
+			OpTypeFunction = 33,
+			OpConstantTrue = 41,
+			OpConstantFalse = 42,
+			OpConstant = 43,
+			OpConstantComposite = 44,
+			OpFunction = 54,
+			OpFunctionParameter = 55,
+			OpFunctionEnd = 56,
+			OpFunctionCall = 57,
+			OpVariable = 59,
+			OpLoad = 61,
+			OpStore = 62,
+			OpAccessChain = 65,
+			OpDecorate = 71,
+			OpMemberDecorate = 72,
+			OpVectorExtractDynamic = 77,
+			OpVectorShuffle = 79,
+			OpCompositeConstruct = 80,
+			OpCompositeExtract = 81,
+			OpTranspose = 84,
+			OpImageSampleImplicitLod = 87,
+			OpImageSampleExplicitLod = 88,
+			OpImageRead = 98,
+			OpImageWrite = 99,
+			OpImage = 100,
+			OpImageQuerySizeLod = 103,
+			OpConvertFToU = 109,
+			OpConvertFToS = 110,
+			OpConvertSToF = 111,
+			OpConvertUToF = 112,
+			OpBitcast = 124,
+			OpSNegate = 126,
+			OpFNegate = 127,
+			OpIAdd = 128,
+			OpFAdd = 129,
+			OpISub = 130,
+			OpFSub = 131,
+			OpIMul = 132,
+			OpFMul = 133,
+			OpUDiv = 134,
+			OpSDiv = 135,
+			OpFDiv = 136,
+			OpUMod = 137,
+			OpSMod = 139,
+			OpFMod = 141,
+			OpVectorTimesScalar = 142,
+			OpMatrixTimesScalar = 143,
+			OpVectorTimesMatrix = 144,
+			OpMatrixTimesVector = 145,
+			OpMatrixTimesMatrix = 146,
+			OpDot = 148,
+			OpAny = 154,
+			OpAll = 155,
+			OpLogicalEqual = 164,
+			OpLogicalNotEqual = 165,
+			OpLogicalOr = 166,
+			OpLogicalAnd = 167,
+			OpLogicalNot = 168,
+			OpSelect = 169,
+			OpIEqual = 170,
+			OpINotEqual = 171,
+			OpUGreaterThan = 172,
+			OpSGreaterThan = 173,
+			OpUGreaterThanEqual = 174,
+			OpSGreaterThanEqual = 175,
+			OpULessThan = 176,
+			OpSLessThan = 177,
+			OpULessThanEqual = 178,
+			OpSLessThanEqual = 179,
+			OpFOrdEqual = 180,
+			OpFUnordNotEqual = 183,
+			OpFOrdLessThan = 184,
+			OpFOrdGreaterThan = 186,
+			OpFOrdLessThanEqual = 188,
+			OpFOrdGreaterThanEqual = 190,
+			OpShiftRightLogical = 194,
+			OpShiftRightArithmetic = 195,
+			OpShiftLeftLogical = 196,
+			OpBitwiseOr = 197,
+			OpBitwiseXor = 198,
+			OpBitwiseAnd = 199,
+			OpNot = 200,
+			OpDPdx = 207,
+			OpDPdy = 208,
+			OpFwidth = 209,
+			OpControlBarrier = 224,
+			OpPhi = 245,
+			OpLoopMerge = 246,
+			OpSelectionMerge = 247,
+			OpLabel = 248,
+			OpBranch = 249,
+			OpBranchConditional = 250,
+			OpKill = 252,
+			OpReturn = 253,
+			OpReturnValue = 254,
+			OpUnreachable = 255
+		};
+
+		enum Capability : uint32_t
+		{
+			CapabilityShader = 1,
+			CapabilitySampled1D = 43,
+			CapabilityImage1D = 44,
+			CapabilityStorageImageExtendedFormats = 49,
+			CapabilityImageQuery = 50,
+			CapabilityStorageImageReadWithoutFormat = 55,
+			CapabilityStorageImageWriteWithoutFormat = 56
+		};
+
+		enum StorageClass : uint32_t
+		{
+			StorageClassUniformConstant = 0,
+			StorageClassInput = 1,
+			StorageClassUniform = 2,
+			StorageClassOutput = 3,
+			StorageClassWorkgroup = 4,
+			StorageClassPrivate = 6,
+			StorageClassFunction = 7
+		};
+
+		enum Decoration : uint32_t
+		{
+			DecorationBlock = 2,
+			DecorationBufferBlock = 3,
+			DecorationColMajor = 5,
+			DecorationArrayStride = 6,
+			DecorationMatrixStride = 7,
+			DecorationBuiltIn = 11,
+			DecorationFlat = 14,
+			DecorationLocation = 30,
+			DecorationBinding = 33,
+			DecorationDescriptorSet = 34,
+			DecorationOffset = 35
+		};
+
+		enum BuiltIn : uint32_t
+		{
+			BuiltInPosition = 0,
+			BuiltInFragCoord = 15,
+			BuiltInWorkgroupId = 26,
+			BuiltInLocalInvocationId = 27,
+			BuiltInGlobalInvocationId = 28
+		};
+
+		enum Dim : uint32_t
+		{
+			Dim1D = 0,
+			Dim2D = 1,
+			Dim3D = 2,
+			DimCube = 3
+		};
+
+		enum ExecutionModel : uint32_t
+		{
+			ExecutionModelVertex = 0,
+			ExecutionModelFragment = 4,
+			ExecutionModelGLCompute = 5
+		};
+
+		enum ImageFormat : uint32_t
+		{
+			ImageFormatUnknown = 0,
+			ImageFormatRgba32f = 1,
+			ImageFormatRgba16f = 2,
+			ImageFormatR32f = 3,
+			ImageFormatRgba8 = 4,
+			ImageFormatRgba8Snorm = 5,
+			ImageFormatRg32f = 6,
+			ImageFormatRg16f = 7,
+			ImageFormatR16f = 9,
+			ImageFormatRgba32i = 21,
+			ImageFormatR32i = 24,
+			ImageFormatRgba32ui = 30,
+			ImageFormatR32ui = 33
+		};
+
+		constexpr uint32_t AddressingModelLogical = 0;
+		constexpr uint32_t MemoryModelGLSL450 = 1;
+		constexpr uint32_t ExecutionModeOriginUpperLeft = 7;
+		constexpr uint32_t ExecutionModeLocalSize = 17;
+		constexpr uint32_t ScopeWorkgroup = 2;
+		constexpr uint32_t MemorySemanticsAcquireRelease = 0x8;
+		constexpr uint32_t MemorySemanticsWorkgroupMemory = 0x100;
+		constexpr uint32_t ImageOperandsBias = 0x1;
+		constexpr uint32_t ImageOperandsLod = 0x2;
+	}
+
+	// GLSL.std.450 extended instructions
+	namespace glsl450
+	{
+		enum Instruction : uint32_t
+		{
+			Round = 1,
+			RoundEven = 2,
+			Trunc = 3,
+			FAbs = 4,
+			SAbs = 5,
+			FSign = 6,
+			SSign = 7,
+			Floor = 8,
+			Ceil = 9,
+			Fract = 10,
+			Radians = 11,
+			Degrees = 12,
+			Sin = 13,
+			Cos = 14,
+			Tan = 15,
+			Asin = 16,
+			Acos = 17,
+			Atan = 18,
+			Sinh = 19,
+			Cosh = 20,
+			Tanh = 21,
+			Asinh = 22,
+			Acosh = 23,
+			Atanh = 24,
+			Atan2 = 25,
+			Pow = 26,
+			Exp = 27,
+			Log = 28,
+			Exp2 = 29,
+			Log2 = 30,
+			Sqrt = 31,
+			InverseSqrt = 32,
+			Determinant = 33,
+			MatrixInverse = 34,
+			FMin = 37,
+			UMin = 38,
+			SMin = 39,
+			FMax = 40,
+			UMax = 41,
+			SMax = 42,
+			FClamp = 43,
+			UClamp = 44,
+			SClamp = 45,
+			FMix = 46,
+			Step = 48,
+			SmoothStep = 49,
+			Fma = 50,
+			Length = 66,
+			Distance = 67,
+			Cross = 68,
+			Normalize = 69,
+			FaceForward = 70,
+			Reflect = 71,
+			Refract = 72
+		};
+	}
+
+	// GLSL built-in functions applied on each component, with their signed & unsigned integer variants if they exist
+	struct ComponentWiseFunction
+	{
+		uint32_t floatInstruction;
+		uint32_t intInstruction;
+		uint32_t uintInstruction;
+	};
+
+	const std::unordered_map<std::string, ComponentWiseFunction> s_componentWiseFunctions =
+	{
+		{ "abs", { glsl450::FAbs, glsl450::SAbs, 0 } },
+		{ "sign", { glsl450::FSign, glsl450::SSign, 0 } },
+		{ "floor", { glsl450::Floor, 0, 0 } },
+		{ "ceil", { glsl450::Ceil, 0, 0 } },
+		{ "fract", { glsl450::Fract, 0, 0 } },
+		{ "round", { glsl450::Round, 0, 0 } },
+		{ "roundEven", { glsl450::RoundEven, 0, 0 } },
+		{ "trunc", { glsl450::Trunc, 0, 0 } },
+		{ "radians", { glsl450::Radians, 0, 0 } },
+		{ "degrees", { glsl450::Degrees, 0, 0 } },
+		{ "sin", { glsl450::Sin, 0, 0 } },
+		{ "cos", { glsl450::Cos, 0, 0 } },
+		{ "tan", { glsl450::Tan, 0, 0 } },
+		{ "asin", { glsl450::Asin, 0, 0 } },
+		{ "acos", { glsl450::Acos, 0, 0 } },
+		{ "sinh", { glsl450::Sinh, 0, 0 } },
+		{ "cosh", { glsl450::Cosh, 0, 0 } },
+		{ "tanh", { glsl450::Tanh, 0, 0 } },
+		{ "asinh", { glsl450::Asinh, 0, 0 } },
+		{ "acosh", { glsl450::Acosh, 0, 0 } },
+		{ "atanh", { glsl450::Atanh, 0, 0 } },
+		{ "pow", { glsl450::Pow, 0, 0 } },
+		{ "exp", { glsl450::Exp, 0, 0 } },
+		{ "log", { glsl450::Log, 0, 0 } },
+		{ "exp2", { glsl450::Exp2, 0, 0 } },
+		{ "log2", { glsl450::Log2, 0, 0 } },
+		{ "sqrt", { glsl450::Sqrt, 0, 0 } },
+		{ "inversesqrt", { glsl450::InverseSqrt, 0, 0 } },
+		{ "min", { glsl450::FMin, glsl450::SMin, glsl450::UMin } },
+		{ "max", { glsl450::FMax, glsl450::SMax, glsl450::UMax } },
+		{ "clamp", { glsl450::FClamp, glsl450::SClamp, glsl450::UClamp } },
+		{ "mix", { glsl450::FMix, 0, 0 } },
+		{ "step", { glsl450::Step, 0, 0 } },
+		{ "smoothstep", { glsl450::SmoothStep, 0, 0 } },
+		{ "fma", { glsl450::Fma, 0, 0 } }
+	};
+
+	std::optional<AstType> getGlslType(const std::string& name)
+	{
+		// GLSL type names may be used in ATSL sources (vec3, mat4, ...)
+		if (name.size() < 4)
+			return std::nullopt;
+
+		AstPrimitiveType primitiveType = AstPrimitiveType::Float;
+		size_t offset = 0;
+
+		switch (name[0])
+		{
+			case 'i':
+			{
+				primitiveType = AstPrimitiveType::Int;
+				offset = 1;
+				break;
+			}
+			case 'u':
+			{
+				primitiveType = AstPrimitiveType::UInt;
+				offset = 1;
+				break;
+			}
+			case 'b':
+			{
+				primitiveType = AstPrimitiveType::Bool;
+				offset = 1;
+				break;
+			}
+			default:
+				break;
+		}
+
+		const auto base = name.substr(offset);
+
+		if (base.size() == 4 && !base.compare(0, 3, "vec") && base[3] >= '2' && base[3] <= '4')
+			return AstVectorType{ primitiveType, static_cast<size_t>(base[3] - '0') };
+
+		if (offset == 0 && !base.compare(0, 3, "mat") && base[3] >= '2' && base[3] <= '4')
+		{
+			const size_t columnCount = static_cast<size_t>(base[3] - '0');
+
+			if (base.size() == 4)
+				return AstMatrixType{ AstPrimitiveType::Float, columnCount, columnCount };
+
+			if (base.size() == 6 && base[4] == 'x' && base[5] >= '2' && base[5] <= '4')
+				return AstMatrixType{ AstPrimitiveType::Float, static_cast<size_t>(base[5] - '0'), columnCount };
+		}
+
+		return std::nullopt;
+	}
+
+	AstType getType(const AstArrayType::ComponentType& type)
+	{
+		if (type.is<AstPrimitiveType>())
+			return type.get<AstPrimitiveType>();
+		else if (type.is<AstVectorType>())
+			return type.get<AstVectorType>();
+		else if (type.is<AstMatrixType>())
+			return type.get<AstMatrixType>();
+		else if (type.is<AstSamplerType>())
+			return type.get<AstSamplerType>();
+		else if (type.is<AstStorageImageType>())
+			return type.get<AstStorageImageType>();
+		else if (type.is<AstStructType>())
+			return type.get<AstStructType>();
+
+		ATEMA_ERROR("Invalid array component type");
+
+		return AstVoidType();
+	}
+
+	AstArrayType::ComponentType getComponentType(const AstType& type)
+	{
+		if (type.is<AstPrimitiveType>())
+			return type.get<AstPrimitiveType>();
+		else if (type.is<AstVectorType>())
+			return type.get<AstVectorType>();
+		else if (type.is<AstMatrixType>())
+			return type.get<AstMatrixType>();
+		else if (type.is<AstSamplerType>())
+			return type.get<AstSamplerType>();
+		else if (type.is<AstStorageImageType>())
+			return type.get<AstStorageImageType>();
+		else if (type.is<AstStructType>())
+			return type.get<AstStructType>();
+
+		ATEMA_ERROR("Invalid array component type");
+
+		return AstPrimitiveType::Float;
+	}
+
+	AstType getConstantType(const ConstantValue& value)
+	{
+		if (value.is<bool>())
+			return AstPrimitiveType::Bool;
+		else if (value.is<int32_t>())
+			return AstPrimitiveType::Int;
+		else if (value.is<uint32_t>())
+			return AstPrimitiveType::UInt;
+		else if (value.is<float>())
+			return AstPrimitiveType::Float;
+		else if (value.is<Vector2i>())
+			return AstVectorType{ AstPrimitiveType::Int, 2 };
+		else if (value.is<Vector2u>())
+			return AstVectorType{ AstPrimitiveType::UInt, 2 };
+		else if (value.is<Vector2f>())
+			return AstVectorType{ AstPrimitiveType::Float, 2 };
+		else if (value.is<Vector3i>())
+			return AstVectorType{ AstPrimitiveType::Int, 3 };
+		else if (value.is<Vector3u>())
+			return AstVectorType{ AstPrimitiveType::UInt, 3 };
+		else if (value.is<Vector3f>())
+			return AstVectorType{ AstPrimitiveType::Float, 3 };
+		else if (value.is<Vector4i>())
+			return AstVectorType{ AstPrimitiveType::Int, 4 };
+		else if (value.is<Vector4u>())
+			return AstVectorType{ AstPrimitiveType::UInt, 4 };
+		else if (value.is<Vector4f>())
+			return AstVectorType{ AstPrimitiveType::Float, 4 };
+
+		ATEMA_ERROR("Invalid constant type");
+
+		return AstVoidType();
+	}
+
+	bool isNumeric(const AstType& type)
+	{
+		return type.is<AstPrimitiveType>() || type.is<AstVectorType>();
+	}
+
+	bool isBool(const AstType& type)
+	{
+		return (type.is<AstPrimitiveType>() && type.get<AstPrimitiveType>() == AstPrimitiveType::Bool)
+			|| (type.is<AstVectorType>() && type.get<AstVectorType>().primitiveType == AstPrimitiveType::Bool);
+	}
+
+	// Samplers & storage images can only be accessed through pointers to external variables
+	bool isOpaque(const AstType& type)
+	{
+		if (type.is<AstArrayType>())
+		{
+			const auto& componentType = type.get<AstArrayType>().componentType;
+
+			return componentType.is<AstSamplerType>() || componentType.is<AstStorageImageType>();
+		}
+
+		return type.is<AstSamplerType>() || type.is<AstStorageImageType>();
+	}
+
+	AstPrimitiveType getPrimitiveType(const AstType& type)
+	{
+		if (type.is<AstPrimitiveType>())
+			return type.get<AstPrimitiveType>();
+		else if (type.is<AstVectorType>())
+			return type.get<AstVectorType>().primitiveType;
+		else if (type.is<AstMatrixType>())
+			return type.get<AstMatrixType>().primitiveType;
+
+		ATEMA_ERROR("Type is not numeric");
+
+		return AstPrimitiveType::Float;
+	}
+
+	size_t getComponentCount(const AstType& type)
+	{
+		if (type.is<AstVectorType>())
+			return type.get<AstVectorType>().componentCount;
+
+		return 1;
+	}
+
+	AstType getNumericType(AstPrimitiveType primitiveType, size_t componentCount)
+	{
+		if (componentCount == 1)
+			return primitiveType;
+
+		return AstVectorType{ primitiveType, componentCount };
+	}
+
+	// Implicit conversions follow GLSL rules : int -> uint -> float
+	AstPrimitiveType getCommonPrimitiveType(AstPrimitiveType type1, AstPrimitiveType type2)
+	{
+		if (type1 == type2)
+			return type1;
+
+		if (type1 == AstPrimitiveType::Float || type2 == AstPrimitiveType::Float)
+			return AstPrimitiveType::Float;
+
+		if (type1 == AstPrimitiveType::UInt || type2 == AstPrimitiveType::UInt)
+			return AstPrimitiveType::UInt;
+
+		return AstPrimitiveType::Int;
+	}
+
+	size_t getArraySize(const AstArrayType& type)
+	{
+		if (type.sizeType != AstArrayType::SizeType::Constant)
+			ATEMA_ERROR("Array size must be specified");
+
+		return type.size;
+	}
+
+	std::string getTypeKey(const AstType& type);
+
+	std::string getPrimitiveKey(AstPrimitiveType type)
+	{
+		switch (type)
+		{
+			case AstPrimitiveType::Bool: return "b";
+			case AstPrimitiveType::Int: return "i";
+			case AstPrimitiveType::UInt: return "u";
+			case AstPrimitiveType::Float: return "f";
+			default:
+			{
+				ATEMA_ERROR("Invalid primitive type");
+			}
+		}
+
+		return "";
+	}
+
+	std::string getTypeKey(const AstType& type)
+	{
+		if (type.is<AstVoidType>())
+		{
+			return "void";
+		}
+		else if (type.is<AstPrimitiveType>())
+		{
+			return getPrimitiveKey(type.get<AstPrimitiveType>());
+		}
+		else if (type.is<AstVectorType>())
+		{
+			const auto& vectorType = type.get<AstVectorType>();
+
+			return "vec" + std::to_string(vectorType.componentCount) + getPrimitiveKey(vectorType.primitiveType);
+		}
+		else if (type.is<AstMatrixType>())
+		{
+			const auto& matrixType = type.get<AstMatrixType>();
+
+			return "mat" + std::to_string(matrixType.columnCount) + "x" + std::to_string(matrixType.rowCount) + getPrimitiveKey(matrixType.primitiveType);
+		}
+		else if (type.is<AstSamplerType>())
+		{
+			const auto& samplerType = type.get<AstSamplerType>();
+
+			return "sampler" + std::to_string(static_cast<int>(samplerType.imageType)) + getPrimitiveKey(samplerType.primitiveType);
+		}
+		else if (type.is<AstStorageImageType>())
+		{
+			const auto& imageType = type.get<AstStorageImageType>();
+
+			return "image" + std::to_string(static_cast<int>(imageType.imageType)) + getPrimitiveKey(imageType.primitiveType) + "#" + std::to_string(static_cast<int>(imageType.format));
+		}
+		else if (type.is<AstStructType>())
+		{
+			return "struct " + type.get<AstStructType>().name;
+		}
+		else if (type.is<AstArrayType>())
+		{
+			const auto& arrayType = type.get<AstArrayType>();
+
+			// Runtime arrays don't have a size
+			if (arrayType.sizeType == AstArrayType::SizeType::Implicit)
+				return getTypeKey(getType(arrayType.componentType)) + "[]";
+
+			return getTypeKey(getType(arrayType.componentType)) + "[" + std::to_string(getArraySize(arrayType)) + "]";
+		}
+
+		ATEMA_ERROR("Invalid type");
+
+		return "";
+	}
+
+	bool isSameType(const AstType& type1, const AstType& type2)
+	{
+		return getTypeKey(type1) == getTypeKey(type2);
+	}
+
+	uint32_t getExecutionModel(AstShaderStage stage)
 	{
 		switch (stage)
 		{
-			case AstShaderStage::Vertex: return EShLangVertex;
-			case AstShaderStage::Fragment: return EShLangFragment;
+			case AstShaderStage::Vertex: return spv::ExecutionModelVertex;
+			case AstShaderStage::Fragment: return spv::ExecutionModelFragment;
+			case AstShaderStage::Compute: return spv::ExecutionModelGLCompute;
+			default:
+			{
+				ATEMA_ERROR("Invalid shader stage");
+			}
+		}
+
+		return spv::ExecutionModelVertex;
+	}
+
+	uint32_t getImageFormat(AstImageFormat format)
+	{
+		switch (format)
+		{
+			case AstImageFormat::Unknown: return spv::ImageFormatUnknown;
+			case AstImageFormat::Rgba8: return spv::ImageFormatRgba8;
+			case AstImageFormat::Rgba8Snorm: return spv::ImageFormatRgba8Snorm;
+			case AstImageFormat::Rgba16f: return spv::ImageFormatRgba16f;
+			case AstImageFormat::Rgba32f: return spv::ImageFormatRgba32f;
+			case AstImageFormat::Rg16f: return spv::ImageFormatRg16f;
+			case AstImageFormat::Rg32f: return spv::ImageFormatRg32f;
+			case AstImageFormat::R16f: return spv::ImageFormatR16f;
+			case AstImageFormat::R32f: return spv::ImageFormatR32f;
+			case AstImageFormat::Rgba32i: return spv::ImageFormatRgba32i;
+			case AstImageFormat::Rgba32ui: return spv::ImageFormatRgba32ui;
+			case AstImageFormat::R32i: return spv::ImageFormatR32i;
+			case AstImageFormat::R32ui: return spv::ImageFormatR32ui;
+			default:
+			{
+				ATEMA_ERROR("Invalid image format");
+			}
+		}
+
+		return spv::ImageFormatUnknown;
+	}
+
+	bool findEntryStage(const Statement& statement, AstShaderStage& stage)
+	{
+		if (statement.getType() == Statement::Type::EntryFunctionDeclaration)
+		{
+			stage = static_cast<const EntryFunctionDeclarationStatement&>(statement).stage;
+
+			return true;
+		}
+
+		if (statement.getType() == Statement::Type::Sequence)
+		{
+			for (const auto& subStatement : static_cast<const SequenceStatement&>(statement).statements)
+			{
+				if (findEntryStage(*subStatement, stage))
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Expressions that may modify variables must not be evaluated speculatively
+	bool hasSideEffects(const Expression& expression)
+	{
+		switch (expression.getType())
+		{
+			case Expression::Type::Constant:
+			case Expression::Type::Variable:
+				return false;
+			case Expression::Type::AccessIndex:
+			{
+				const auto& access = static_cast<const AccessIndexExpression&>(expression);
+
+				return hasSideEffects(*access.expression) || hasSideEffects(*access.index);
+			}
+			case Expression::Type::AccessIdentifier:
+				return hasSideEffects(*static_cast<const AccessIdentifierExpression&>(expression).expression);
+			case Expression::Type::Unary:
+			{
+				const auto& unary = static_cast<const UnaryExpression&>(expression);
+
+				switch (unary.op)
+				{
+					case UnaryOperator::Positive:
+					case UnaryOperator::Negative:
+					case UnaryOperator::LogicalNot:
+						return hasSideEffects(*unary.operand);
+					default:
+						return true;
+				}
+			}
+			case Expression::Type::Binary:
+			{
+				const auto& binary = static_cast<const BinaryExpression&>(expression);
+
+				return hasSideEffects(*binary.left) || hasSideEffects(*binary.right);
+			}
+			case Expression::Type::Cast:
+			{
+				for (const auto& component : static_cast<const CastExpression&>(expression).components)
+				{
+					if (hasSideEffects(*component))
+						return true;
+				}
+
+				return false;
+			}
+			case Expression::Type::Swizzle:
+				return hasSideEffects(*static_cast<const SwizzleExpression&>(expression).expression);
+			case Expression::Type::Ternary:
+			{
+				const auto& ternary = static_cast<const TernaryExpression&>(expression);
+
+				return hasSideEffects(*ternary.condition) || hasSideEffects(*ternary.trueValue) || hasSideEffects(*ternary.falseValue);
+			}
 			default:
+				return true;
+		}
+	}
+
+	std::vector<uint32_t> getSwizzleComponents(const std::string& identifier)
+	{
+		std::vector<uint32_t> components;
+
+		if (identifier.empty() || identifier.size() > 4)
+			return components;
+
+		for (const auto c : identifier)
+		{
+			switch (c)
 			{
-				ATEMA_ERROR("Invalid AstShaderStage");
-			}
-		}
-
-		return EShLangVertex;
-	}
-
-	TBuiltInResource getDefaultResources()
-	{
-		TBuiltInResource resources;
-
-		resources.maxLights = 32;
-		resources.maxClipPlanes = 6;
-		resources.maxTextureUnits = 32;
-		resources.maxTextureCoords = 32;
-		resources.maxVertexAttribs = 64;
-		resources.maxVertexUniformComponents = 4096;
-		resources.maxVaryingFloats = 64;
-		resources.maxVertexTextureImageUnits = 32;
-		resources.maxCombinedTextureImageUnits = 80;
-		resources.maxTextureImageUnits = 32;
-		resources.maxFragmentUniformComponents = 4096;
-		resources.maxDrawBuffers = 32;
-		resources.maxVertexUniformVectors = 128;
-		resources.maxVaryingVectors = 8;
-		resources.maxFragmentUniformVectors = 16;
-		resources.maxVertexOutputVectors = 16;
-		resources.maxFragmentInputVectors = 15;
-		resources.minProgramTexelOffset = -8;
-		resources.maxProgramTexelOffset = 7;
-		resources.maxClipDistances = 8;
-		resources.maxComputeWorkGroupCountX = 65535;
-		resources.maxComputeWorkGroupCountY = 65535;
-		resources.maxComputeWorkGroupCountZ = 65535;
-		resources.maxComputeWorkGroupSizeX = 1024;
-		resources.maxComputeWorkGroupSizeY = 1024;
-		resources.maxComputeWorkGroupSizeZ = 64;
-		resources.maxComputeUniformComponents = 1024;
-		resources.maxComputeTextureImageUnits = 16;
-		resources.maxComputeImageUniforms = 8;
-		resources.maxComputeAtomicCounters = 8;
-		resources.maxComputeAtomicCounterBuffers = 1;
-		resources.maxVaryingComponents = 60;
-		resources.maxVertexOutputComponents = 64;
-		resources.maxGeometryInputComponents = 64;
-		resources.maxGeometryOutputComponents = 128;
-		resources.maxFragmentInputComponents = 128;
-		resources.maxImageUnits = 8;
-		resources.maxCombinedImageUnitsAndFragmentOutputs = 8;
-		resources.maxCombinedShaderOutputResources = 8;
-		resources.maxImageSamples = 0;
-		resources.maxVertexImageUniforms = 0;
-		resources.maxTessControlImageUniforms = 0;
-		resources.maxTessEvaluationImageUniforms = 0;
-		resources.maxGeometryImageUniforms = 0;
-		resources.maxFragmentImageUniforms = 8;
-		resources.maxCombinedImageUniforms = 8;
-		resources.maxGeometryTextureImageUnits = 16;
-		resources.maxGeometryOutputVertices = 256;
-		resources.maxGeometryTotalOutputComponents = 1024;
-		resources.maxGeometryUniformComponents = 1024;
-		resources.maxGeometryVaryingComponents = 64;
-		resources.maxTessControlInputComponents = 128;
-		resources.maxTessControlOutputComponents = 128;
-		resources.maxTessControlTextureImageUnits = 16;
-		resources.maxTessControlUniformComponents = 1024;
-		resources.maxTessControlTotalOutputComponents = 4096;
-		resources.maxTessEvaluationInputComponents = 128;
-		resources.maxTessEvaluationOutputComponents = 128;
-		resources.maxTessEvaluationTextureImageUnits = 16;
-		resources.maxTessEvaluationUniformComponents = 1024;
-		resources.maxTessPatchComponents = 120;
-		resources.maxPatchVertices = 32;
-		resources.maxTessGenLevel = 64;
-		resources.maxViewports = 16;
-		resources.maxVertexAtomicCounters = 0;
-		resources.maxTessControlAtomicCounters = 0;
-		resources.maxTessEvaluationAtomicCounters = 0;
-		resources.maxGeometryAtomicCounters = 0;
-		resources.maxFragmentAtomicCounters = 8;
-		resources.maxCombinedAtomicCounters = 8;
-		resources.maxAtomicCounterBindings = 1;
-		resources.maxVertexAtomicCounterBuffers = 0;
-		resources.maxTessControlAtomicCounterBuffers = 0;
-		resources.maxTessEvaluationAtomicCounterBuffers = 0;
-		resources.maxGeometryAtomicCounterBuffers = 0;
-		resources.maxFragmentAtomicCounterBuffers = 1;
-		resources.maxCombinedAtomicCounterBuffers = 1;
-		resources.maxAtomicCounterBufferSize = 16384;
-		resources.maxTransformFeedbackBuffers = 4;
-		resources.maxTransformFeedbackInterleavedComponents = 64;
-		resources.maxCullDistances = 8;
-		resources.maxCombinedClipAndCullDistances = 8;
-		resources.maxSamples = 4;
-		resources.maxMeshOutputVerticesNV = 256;
-		resources.maxMeshOutputPrimitivesNV = 512;
-		resources.maxMeshWorkGroupSizeX_NV = 32;
-		resources.maxMeshWorkGroupSizeY_NV = 1;
-		resources.maxMeshWorkGroupSizeZ_NV = 1;
-		resources.maxTaskWorkGroupSizeX_NV = 32;
-		resources.maxTaskWorkGroupSizeY_NV = 1;
-		resources.maxTaskWorkGroupSizeZ_NV = 1;
-		resources.maxMeshViewCountNV = 4;
-
-		resources.limits.nonInductiveForLoops = true;
-		resources.limits.whileLoops = true;
-		resources.limits.doWhileLoops = true;
-		resources.limits.generalUniformIndexing = true;
-		resources.limits.generalAttributeMatrixVectorIndexing = true;
-		resources.limits.generalVaryingIndexing = true;
-		resources.limits.generalSamplerIndexing = true;
-		resources.limits.generalVariableIndexing = true;
-		resources.limits.generalConstantMatrixVectorIndexing = true;
-
-		return resources;
-	}
-
-	const TBuiltInResource defaultBuiltInResource = getDefaultResources();
+				case 'x': case 'r': case 's': components.emplace_back(0); break;
+				case 'y': case 'g': case 't': components.emplace_back(1); break;
+				case 'z': case 'b': case 'p': components.emplace_back(2); break;
+				case 'w': case 'a': case 'q': components.emplace_back(3); break;
+				default: return {};
+			}
+		}
+
+		return components;
+	}
+
+	void writeString(std::vector<uint32_t>& words, const std::string& str)
+	{
+		// Null terminated, padded to a word boundary
+		const size_t wordCount = str.size() / 4 + 1;
+		const size_t offset = words.size();
+
+		words.resize(offset + wordCount, 0);
+
+		std::memcpy(words.data() + offset, str.data(), str.size());
+	}
+
+	size_t alignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
 }
 
 SpirvShaderWriter::SpirvShaderWriter() :
@@ -162,11 +804,19 @@ SpirvShaderWriter::SpirvShaderWriter() :
 }
 
 SpirvShaderWriter::SpirvShaderWriter(const Settings& settings) :
-	GlslShaderWriter(m_glslStream, { settings.stage }),
+	m_isSequenceProcessed(false),
 	m_requestedStage(settings.stage),
 	m_entryFound(false),
-	m_stage(AstShaderStage::Vertex)
+	m_stage(AstShaderStage::Vertex),
+	m_workgroupSize(1, 1, 1),
+	m_idBound(1),
+	m_glslInstructionSetId(0),
+	m_entryFunctionId(0),
+	m_globalInitializationId(0),
+	m_function(&m_globalInitialization),
+	m_isInFunction(false)
 {
+	m_preprocessor.setLibraryManager(nullptr);
 }
 
 SpirvShaderWriter::~SpirvShaderWriter()
@@ -175,111 +825,3863 @@ SpirvShaderWriter::~SpirvShaderWriter()
 
 void SpirvShaderWriter::compile(std::vector<uint32_t>& spirv)
 {
-	compileSpirv(spirv);
-}
+	if (!m_entryFound)
+		ATEMA_ERROR("A shader entry must be defined");
 
-void SpirvShaderWriter::compile(std::ostream& ostream)
-{
-	std::vector<uint32_t> spirv;
+	for (const auto& [name, overloads] : m_functions)
+	{
+		for (const auto& function : overloads)
+		{
+			if (function.isCalled && !function.isDefined)
+				ATEMA_ERROR("Function '" + name + "' is called but never defined");
+		}
+	}
 
-	compileSpirv(spirv);
+	spirv.clear();
+	spirv.reserve(m_names.size() + m_annotations.size() + m_declarations.size() + m_functionDefinitions.size() + m_globalInitialization.body.size() + 64);
 
-	const auto codeData = reinterpret_cast<char*>(spirv.data());
-	const auto codeSize = spirv.size() * sizeof(uint32_t);
+	// Header
+	spirv.emplace_back(spv::MagicNumber);
+	spirv.emplace_back(spv::Version);
+	spirv.emplace_back(0); // Generator
+	spirv.emplace_back(m_idBound);
+	spirv.emplace_back(0); // Schema
 
-	for (size_t i = 0; i < codeSize; i++)
-		ostream << codeData[i];
-}
+	for (const auto& capability : m_capabilities)
+		writeInstruction(spirv, spv::OpCapability, { capability });
 
-void SpirvShaderWriter::visit(const EntryFunctionDeclarationStatement& statement)
-{
-	if (m_requestedStage.has_value())
+	if (m_glslInstructionSetId)
 	{
-		if (statement.stage == m_requestedStage.value())
-		{
-			if (m_entryFound)
-				ATEMA_ERROR("Only one shader entry must be defined");
+		std::vector<uint32_t> operands = { m_glslInstructionSetId };
+		writeString(operands, "GLSL.std.450");
 
-			m_stage = statement.stage;
-			m_entryFound = true;
-		}
+		writeInstruction(spirv, spv::OpExtInstImport, operands);
 	}
-	else
+
+	writeInstruction(spirv, spv::OpMemoryModel, { spv::AddressingModelLogical, spv::MemoryModelGLSL450 });
+
+	// Entry point
 	{
-		if (!m_entryFound)
-		{
-			m_stage = statement.stage;
-			m_entryFound = true;
-		}
-		else
-		{
-			ATEMA_ERROR("Only one shader entry must be defined");
-		}
+		std::vector<uint32_t> operands = { getExecutionModel(m_stage), m_entryFunctionId };
+		writeString(operands, "main");
+		operands.insert(operands.end(), m_interfaceIds.begin(), m_interfaceIds.end());
+
+		writeInstruction(spirv, spv::OpEntryPoint, operands);
+
+		if (m_stage == AstShaderStage::Fragment)
+			writeInstruction(spirv, spv::OpExecutionMode, { m_entryFunctionId, spv::ExecutionModeOriginUpperLeft });
+		else if (m_stage == AstShaderStage::Compute)
+			writeInstruction(spirv, spv::OpExecutionMode, { m_entryFunctionId, spv::ExecutionModeLocalSize, m_workgroupSize.x, m_workgroupSize.y, m_workgroupSize.z });
 	}
 
-	GlslShaderWriter::visit(statement);
+	spirv.insert(spirv.end(), m_names.begin(), m_names.end());
+	spirv.insert(spirv.end(), m_annotations.begin(), m_annotations.end());
+	spirv.insert(spirv.end(), m_declarations.begin(), m_declarations.end());
+
+	// The global initialization function is complete only once the whole AST was processed
+	writeFunction(spirv, m_globalInitialization);
+	writeInstruction(spirv, spv::OpReturn, {});
+	writeInstruction(spirv, spv::OpFunctionEnd, {});
+
+	spirv.insert(spirv.end(), m_functionDefinitions.begin(), m_functionDefinitions.end());
 }
 
-void SpirvShaderWriter::compileSpirv(std::vector<uint32_t>& spirv)
+void SpirvShaderWriter::compile(std::ostream& ostream)
 {
-	if (!m_entryFound)
+	std::vector<uint32_t> spirv;
+
+	compile(spirv);
+
+	ostream.write(reinterpret_cast<const char*>(spirv.data()), static_cast<std::streamsize>(spirv.size() * sizeof(uint32_t)));
+}
+
+void SpirvShaderWriter::beginModule(const SequenceStatement& statement)
+{
+	if (m_requestedStage.has_value())
+		m_stage = m_requestedStage.value();
+	else if (!findEntryStage(statement, m_stage))
 		ATEMA_ERROR("A shader entry must be defined");
 
-	glslang::InitializeProcess();
+	addCapability(spv::CapabilityShader);
 
-	const auto eShLanguage = getEShLanguage(m_stage);
+	m_scopes.clear();
+	pushScope();
 
-	// Create shader
-	glslang::TShader shader(eShLanguage);
+	// Global variables initialization function
+	m_globalInitializationId = createId();
 
-	const auto str = m_glslStream.str();
-	const auto cstr = str.c_str();
-	const int length = static_cast<int>(str.length());
+	const auto voidTypeId = getTypeId(AstVoidType());
 
-	shader.setStringsWithLengths(&cstr, &length, 1);
+	writeInstruction(m_globalInitialization.header, spv::OpFunction, { voidTypeId, m_globalInitializationId, 0, getFunctionTypeId(voidTypeId, {}) });
+	writeName(m_globalInitializationId, "_globalInitialization");
 
-	shader.setEnvInput(glslang::EShSourceGlsl, eShLanguage, glslang::EShClientVulkan, 100);
-	shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
-	shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_1);
+	m_function = &m_globalInitialization;
+	m_function->returnType = AstVoidType();
 
-	auto success = shader.parse(&defaultBuiltInResource, 100, ECoreProfile, false, false, EShMsgDefault);
+	beginBlock(createId());
+}
 
-	// Compilation failed
-	if (!success)
-	{
-		const auto infoLog = shader.getInfoLog();
+uint32_t SpirvShaderWriter::createId()
+{
+	return m_idBound++;
+}
 
-		ATEMA_ERROR("Compilation failed :\n" + std::string(infoLog));
-	}
+void SpirvShaderWriter::addCapability(uint32_t capability)
+{
+	m_capabilities.emplace(capability);
+}
 
-	// Create program
-	glslang::TProgram program;
+uint32_t SpirvShaderWriter::getGlslInstructionSetId()
+{
+	if (!m_glslInstructionSetId)
+		m_glslInstructionSetId = createId();
 
-	program.addShader(&shader);
+	return m_glslInstructionSetId;
+}
 
-	success = program.link(EShMsgDefault);
+void SpirvShaderWriter::writeInstruction(std::vector<uint32_t>& section, uint32_t opCode, const std::vector<uint32_t>& operands)
+{
+	const auto wordCount = static_cast<uint32_t>(operands.size() + 1);
 
-	// Linking failed
-	if (!success)
-	{
-		const auto infoLog = program.getInfoLog();
+	section.emplace_back((wordCount << 16) | opCode);
+	section.insert(section.end(), operands.begin(), operands.end());
+}
 
-		ATEMA_ERROR("Linking failed :\n" + std::string(infoLog));
-	}
+void SpirvShaderWriter::writeName(uint32_t id, const std::string& name)
+{
+	std::vector<uint32_t> operands = { id };
+	writeString(operands, name);
+
+	writeInstruction(m_names, spv::OpName, operands);
+}
+
+void SpirvShaderWriter::writeMemberName(uint32_t id, uint32_t memberIndex, const std::string& name)
+{
+	std::vector<uint32_t> operands = { id, memberIndex };
+	writeString(operands, name);
+
+	writeInstruction(m_names, spv::OpMemberName, operands);
+}
+
+void SpirvShaderWriter::writeDecoration(uint32_t id, uint32_t decoration, const std::vector<uint32_t>& operands)
+{
+	std::vector<uint32_t> allOperands = { id, decoration };
+	allOperands.insert(allOperands.end(), operands.begin(), operands.end());
+
+	writeInstruction(m_annotations, spv::OpDecorate, allOperands);
+}
+
+void SpirvShaderWriter::writeMemberDecoration(uint32_t id, uint32_t memberIndex, uint32_t decoration, const std::vector<uint32_t>& operands)
+{
+	std::vector<uint32_t> allOperands = { id, memberIndex, decoration };
+	allOperands.insert(allOperands.end(), operands.begin(), operands.end());
+
+	writeInstruction(m_annotations, spv::OpMemberDecorate, allOperands);
+}
+
+void SpirvShaderWriter::writeFunction(std::vector<uint32_t>& section, const FunctionContext& function)
+{
+	// Variables are declared right after the label of the first block (OpLabel is 2 words long)
+	const auto firstBlock = function.body.begin() + 2;
+
+	section.insert(section.end(), function.header.begin(), function.header.end());
+	section.insert(section.end(), function.body.begin(), firstBlock);
+	section.insert(section.end(), function.variables.begin(), function.variables.end());
+	section.insert(section.end(), firstBlock, function.body.end());
+}
+
+void SpirvShaderWriter::write(uint32_t opCode, const std::vector<uint32_t>& operands)
+{
+	writeInstruction(m_function->body, opCode, operands);
+}
+
+uint32_t SpirvShaderWriter::writeResult(uint32_t opCode, uint32_t typeId, const std::vector<uint32_t>& operands)
+{
+	const auto id = createId();
+
+	std::vector<uint32_t> allOperands = { typeId, id };
+	allOperands.insert(allOperands.end(), operands.begin(), operands.end());
+
+	write(opCode, allOperands);
+
+	return id;
+}
+
+void SpirvShaderWriter::beginBlock(uint32_t label)
+{
+	write(spv::OpLabel, { label });
+
+	m_function->currentLabel = label;
+	m_function->isTerminated = false;
+}
+
+void SpirvShaderWriter::writeBranch(uint32_t label)
+{
+	writeTerminator(spv::OpBranch, { label });
+}
+
+void SpirvShaderWriter::writeTerminator(uint32_t opCode, const std::vector<uint32_t>& operands)
+{
+	write(opCode, operands);
+
+	m_function->isTerminated = true;
+}
+
+bool SpirvShaderWriter::isReachable() const
+{
+	return !m_function->isTerminated;
+}
+
+AstType SpirvShaderWriter::resolveType(const AstType& type) const
+{
+	if (type.is<AstStructType>())
+	{
+		const auto& name = type.get<AstStructType>().name;
+
+		if (m_structs.find(name) == m_structs.end())
+		{
+			auto glslType = getGlslType(name);
+
+			if (glslType.has_value())
+				return glslType.value();
+		}
+	}
+	else if (type.is<AstArrayType>())
+	{
+		auto arrayType = type.get<AstArrayType>();
+
+		if (arrayType.componentType.is<AstStructType>())
+			arrayType.componentType = getComponentType(resolveType(arrayType.componentType.get<AstStructType>()));
+
+		if (arrayType.sizeType == AstArrayType::SizeType::Option)
+		{
+			const auto optionIt = m_options.find(arrayType.optionName);
+
+			if (optionIt == m_options.end())
+				ATEMA_ERROR("Option '" + arrayType.optionName + "' is not defined");
+
+			const auto& value = optionIt->second;
+
+			if (value.is<int32_t>())
+				arrayType.size = static_cast<size_t>(value.get<int32_t>());
+			else if (value.is<uint32_t>())
+				arrayType.size = static_cast<size_t>(value.get<uint32_t>());
+			else
+				ATEMA_ERROR("Array size must be an integer");
+
+			arrayType.sizeType = AstArrayType::SizeType::Constant;
+		}
+
+		return arrayType;
+	}
+
+	return type;
+}
+
+const SpirvShaderWriter::StructData& SpirvShaderWriter::getStruct(const std::string& name) const
+{
+	const auto it = m_structs.find(name);
+
+	if (it == m_structs.end())
+		ATEMA_ERROR("Struct '" + name + "' is not defined");
+
+	return it->second;
+}
+
+uint32_t SpirvShaderWriter::getTypeId(const AstType& type, TypeLayout layout)
+{
+	// Booleans can't be stored in externally visible memory, GLSL uses 32 bits integers instead
+	if (layout != TypeLayout::None && isBool(type))
+		return getTypeId(getNumericType(AstPrimitiveType::UInt, getComponentCount(type)));
+
+	// Only aggregates depend on the layout
+	if (!type.is<AstStructType>() && !type.is<AstArrayType>())
+		layout = TypeLayout::None;
+
+	auto key = getTypeKey(type);
+
+	if (layout != TypeLayout::None)
+		key += "#" + std::to_string(static_cast<int>(layout));
+
+	const auto it = m_typeIds.find(key);
+
+	if (it != m_typeIds.end())
+		return it->second;
+
+	uint32_t id = 0;
+
+	if (type.is<AstVoidType>())
+	{
+		id = createId();
+
+		writeInstruction(m_declarations, spv::OpTypeVoid, { id });
+	}
+	else if (type.is<AstPrimitiveType>())
+	{
+		id = createId();
+
+		switch (type.get<AstPrimitiveType>())
+		{
+			case AstPrimitiveType::Bool:
+			{
+				writeInstruction(m_declarations, spv::OpTypeBool, { id });
+				break;
+			}
+			case AstPrimitiveType::Int:
+			{
+				writeInstruction(m_declarations, spv::OpTypeInt, { id, 32, 1 });
+				break;
+			}
+			case AstPrimitiveType::UInt:
+			{
+				writeInstruction(m_declarations, spv::OpTypeInt, { id, 32, 0 });
+				break;
+			}
+			case AstPrimitiveType::Float:
+			{
+				writeInstruction(m_declarations, spv::OpTypeFloat, { id, 32 });
+				break;
+			}
+			default:
+			{
+				ATEMA_ERROR("Invalid primitive type");
+			}
+		}
+	}
+	else if (type.is<AstVectorType>())
+	{
+		const auto& vectorType = type.get<AstVectorType>();
+
+		const auto componentTypeId = getTypeId(vectorType.primitiveType);
+
+		id = createId();
+
+		writeInstruction(m_declarations, spv::OpTypeVector, { id, componentTypeId, static_cast<uint32_t>(vectorType.componentCount) });
+	}
+	else if (type.is<AstMatrixType>())
+	{
+		const auto& matrixType = type.get<AstMatrixType>();
+
+		if (matrixType.primitiveType != AstPrimitiveType::Float)
+			ATEMA_ERROR("Only floating point matrices are supported");
+
+		const auto columnTypeId = getTypeId(AstVectorType{ AstPrimitiveType::Float, matrixType.rowCount });
+
+		id = createId();
+
+		writeInstruction(m_declarations, spv::OpTypeMatrix, { id, columnTypeId, static_cast<uint32_t>(matrixType.columnCount) });
+	}
+	else if (type.is<AstSamplerType>())
+	{
+		const auto& samplerType = type.get<AstSamplerType>();
+
+		const auto imageTypeId = getImageTypeId(samplerType.imageType, samplerType.primitiveType);
+
+		id = createId();
+
+		writeInstruction(m_declarations, spv::OpTypeSampledImage, { id, imageTypeId });
+	}
+	else if (type.is<AstStorageImageType>())
+	{
+		const auto& imageType = type.get<AstStorageImageType>();
+
+		// Storage images are image types used without a sampler
+		id = getImageTypeId(imageType.imageType, imageType.primitiveType, imageType.format);
+	}
+	else if (type.is<AstStructType>())
+	{
+		const auto& name = type.get<AstStructType>().name;
+		const auto& structData = getStruct(name);
+
+		const auto memberLayout = getMemberLayout(layout);
+
+		std::vector<uint32_t> operands;
+		operands.reserve(structData.members.size() + 1);
+		operands.emplace_back(0);
+
+		for (const auto& member : structData.members)
+			operands.emplace_back(getTypeId(member.type, memberLayout));
+
+		id = createId();
+		operands[0] = id;
+
+		writeInstruction(m_declarations, spv::OpTypeStruct, operands);
+
+		writeName(id, name);
+
+		for (uint32_t i = 0; i < structData.members.size(); i++)
+			writeMemberName(id, i, structData.members[i].name);
+
+		if (memberLayout != TypeLayout::None)
+		{
+			size_t offset = 0;
+
+			for (uint32_t i = 0; i < structData.members.size(); i++)
+			{
+				const auto& memberType = structData.members[i].type;
+
+				offset = alignUp(offset, getLayoutAlignment(memberType, memberLayout));
+
+				writeMemberDecoration(id, i, spv::DecorationOffset, { static_cast<uint32_t>(offset) });
+
+				std::optional<AstMatrixType> matrixType;
+
+				if (memberType.is<AstMatrixType>())
+					matrixType = memberType.get<AstMatrixType>();
+				else if (memberType.is<AstArrayType>() && memberType.get<AstArrayType>().componentType.is<AstMatrixType>())
+					matrixType = memberType.get<AstArrayType>().componentType.get<AstMatrixType>();
+
+				if (matrixType.has_value())
+				{
+					// Matrices are stored as arrays of column vectors
+					const auto matrixStride = getLayoutAlignment(matrixType.value(), memberLayout);
+
+					writeMemberDecoration(id, i, spv::DecorationColMajor);
+					writeMemberDecoration(id, i, spv::DecorationMatrixStride, { static_cast<uint32_t>(matrixStride) });
+				}
+
+				offset += getLayoutSize(memberType, memberLayout);
+			}
+		}
+
+		if (layout == TypeLayout::Std140Block || layout == TypeLayout::InterfaceBlock)
+			writeDecoration(id, spv::DecorationBlock);
+		// SPIR-V 1.0 storage buffers are uniform blocks that can be written
+		else if (layout == TypeLayout::Std430Block)
+			writeDecoration(id, spv::DecorationBufferBlock);
+	}
+	else if (type.is<AstArrayType>())
+	{
+		const auto& arrayType = type.get<AstArrayType>();
+
+		const auto elementLayout = getMemberLayout(layout);
+		const auto elementTypeId = getTypeId(getType(arrayType.componentType), elementLayout);
+
+		// Storage buffers can end with an array whose size is only known at runtime
+		if (elementLayout == TypeLayout::Std430 && arrayType.sizeType == AstArrayType::SizeType::Implicit)
+		{
+			id = createId();
+
+			writeInstruction(m_declarations, spv::OpTypeRuntimeArray, { id, elementTypeId });
+		}
+		else
+		{
+			const auto sizeId = getUIntConstantId(static_cast<uint32_t>(getArraySize(arrayType)));
+
+			id = createId();
+
+			writeInstruction(m_declarations, spv::OpTypeArray, { id, elementTypeId, sizeId });
+		}
+
+		if (elementLayout != TypeLayout::None)
+			writeDecoration(id, spv::DecorationArrayStride, { static_cast<uint32_t>(getLayoutArrayStride(arrayType, elementLayout)) });
+	}
+	else
+	{
+		ATEMA_ERROR("Invalid type");
+	}
+
+	m_typeIds[key] = id;
+
+	return id;
+}
+
+uint32_t SpirvShaderWriter::getImageTypeId(AstImageType imageType, AstPrimitiveType primitiveType, std::optional<AstImageFormat> storageFormat)
+{
+	auto key = "image" + std::to_string(static_cast<int>(imageType)) + getPrimitiveKey(primitiveType);
+
+	if (storageFormat.has_value())
+		key += "#" + std::to_string(static_cast<int>(storageFormat.value()));
+
+	const auto it = m_typeIds.find(key);
+
+	if (it != m_typeIds.end())
+		return it->second;
+
+	uint32_t dim = spv::Dim2D;
+	uint32_t arrayed = 0;
+
+	switch (imageType)
+	{
+		case AstImageType::Texture1D:
+		{
+			dim = spv::Dim1D;
+			break;
+		}
+		case AstImageType::Texture2D:
+		{
+			dim = spv::Dim2D;
+			break;
+		}
+		case AstImageType::Texture3D:
+		{
+			dim = spv::Dim3D;
+			break;
+		}
+		case AstImageType::Cubemap:
+		{
+			dim = spv::DimCube;
+			break;
+		}
+		case AstImageType::TextureArray1D:
+		{
+			dim = spv::Dim1D;
+			arrayed = 1;
+			break;
+		}
+		case AstImageType::TextureArray2D:
+		{
+			dim = spv::Dim2D;
+			arrayed = 1;
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid image type");
+		}
+	}
+
+	if (dim == spv::Dim1D)
+		addCapability(storageFormat.has_value() ? spv::CapabilityImage1D : spv::CapabilitySampled1D);
+
+	// Sampled : 1 (used with a sampler) or 2 (storage image)
+	uint32_t sampled = 1;
+	uint32_t format = spv::ImageFormatUnknown;
+
+	if (storageFormat.has_value())
+	{
+		sampled = 2;
+		format = getImageFormat(storageFormat.value());
+
+		switch (storageFormat.value())
+		{
+			case AstImageFormat::Rg16f:
+			case AstImageFormat::Rg32f:
+			case AstImageFormat::R16f:
+			{
+				addCapability(spv::CapabilityStorageImageExtendedFormats);
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	const auto sampledTypeId = getTypeId(primitiveType);
+
+	const auto id = createId();
+
+	// Depth : 0 (not a depth image), MS : 0 (single-sampled)
+	writeInstruction(m_declarations, spv::OpTypeImage, { id, sampledTypeId, dim, 0, arrayed, 0, sampled, format });
+
+	m_typeIds[key] = id;
+
+	return id;
+}
+
+uint32_t SpirvShaderWriter::getPointerTypeId(uint32_t storageClass, uint32_t typeId)
+{
+	const auto key = "ptr" + std::to_string(storageClass) + ":" + std::to_string(typeId);
+
+	const auto it = m_typeIds.find(key);
+
+	if (it != m_typeIds.end())
+		return it->second;
+
+	const auto id = createId();
+
+	writeInstruction(m_declarations, spv::OpTypePointer, { id, storageClass, typeId });
+
+	m_typeIds[key] = id;
+
+	return id;
+}
+
+uint32_t SpirvShaderWriter::getFunctionTypeId(uint32_t returnTypeId, const std::vector<uint32_t>& argumentTypeIds)
+{
+	std::string key = "fn" + std::to_string(returnTypeId);
+
+	for (const auto& argumentTypeId : argumentTypeIds)
+		key += ":" + std::to_string(argumentTypeId);
+
+	const auto it = m_typeIds.find(key);
+
+	if (it != m_typeIds.end())
+		return it->second;
+
+	const auto id = createId();
+
+	std::vector<uint32_t> operands = { id, returnTypeId };
+	operands.insert(operands.end(), argumentTypeIds.begin(), argumentTypeIds.end());
+
+	writeInstruction(m_declarations, spv::OpTypeFunction, operands);
+
+	m_typeIds[key] = id;
+
+	return id;
+}
+
+SpirvShaderWriter::TypeLayout SpirvShaderWriter::getMemberLayout(TypeLayout layout)
+{
+	switch (layout)
+	{
+		case TypeLayout::Std140:
+		case TypeLayout::Std140Block:
+			return TypeLayout::Std140;
+		case TypeLayout::Std430:
+		case TypeLayout::Std430Block:
+			return TypeLayout::Std430;
+		default:
+			break;
+	}
+
+	return TypeLayout::None;
+}
+
+size_t SpirvShaderWriter::getLayoutAlignment(const AstType& type, TypeLayout layout) const
+{
+	// Std140 rounds the alignment of arrays, structs & matrix columns up to the alignment of a vec4
+	const size_t minAggregateAlignment = (layout == TypeLayout::Std140) ? 16 : 1;
+
+	if (type.is<AstPrimitiveType>())
+	{
+		return 4;
+	}
+	else if (type.is<AstVectorType>())
+	{
+		return type.get<AstVectorType>().componentCount == 2 ? 8 : 16;
+	}
+	else if (type.is<AstMatrixType>())
+	{
+		// Matrices are stored as arrays of column vectors
+		const AstVectorType columnType = { AstPrimitiveType::Float, type.get<AstMatrixType>().rowCount };
+
+		return alignUp(getLayoutAlignment(columnType, layout), minAggregateAlignment);
+	}
+	else if (type.is<AstArrayType>())
+	{
+		return alignUp(getLayoutAlignment(getType(type.get<AstArrayType>().componentType), layout), minAggregateAlignment);
+	}
+	else if (type.is<AstStructType>())
+	{
+		size_t alignment = minAggregateAlignment;
+
+		for (const auto& member : getStruct(type.get<AstStructType>().name).members)
+			alignment = std::max(alignment, getLayoutAlignment(member.type, layout));
+
+		return alignment;
+	}
+
+	ATEMA_ERROR("Type can't be used in a uniform or storage block");
+
+	return 0;
+}
+
+size_t SpirvShaderWriter::getLayoutSize(const AstType& type, TypeLayout layout) const
+{
+	if (type.is<AstPrimitiveType>())
+	{
+		return 4;
+	}
+	else if (type.is<AstVectorType>())
+	{
+		return 4 * type.get<AstVectorType>().componentCount;
+	}
+	else if (type.is<AstMatrixType>())
+	{
+		return getLayoutAlignment(type, layout) * type.get<AstMatrixType>().columnCount;
+	}
+	else if (type.is<AstArrayType>())
+	{
+		const auto& arrayType = type.get<AstArrayType>();
+
+		// Runtime arrays are the last member of storage blocks and don't contribute to the size
+		if (layout == TypeLayout::Std430 && arrayType.sizeType == AstArrayType::SizeType::Implicit)
+			return 0;
+
+		return getLayoutArrayStride(arrayType, layout) * getArraySize(arrayType);
+	}
+	else if (type.is<AstStructType>())
+	{
+		size_t size = 0;
+
+		for (const auto& member : getStruct(type.get<AstStructType>().name).members)
+			size = alignUp(size, getLayoutAlignment(member.type, layout)) + getLayoutSize(member.type, layout);
+
+		return alignUp(size, getLayoutAlignment(type, layout));
+	}
+
+	ATEMA_ERROR("Type can't be used in a uniform or storage block");
+
+	return 0;
+}
+
+size_t SpirvShaderWriter::getLayoutArrayStride(const AstArrayType& type, TypeLayout layout) const
+{
+	const auto elementType = getType(type.componentType);
+
+	return alignUp(getLayoutSize(elementType, layout), getLayoutAlignment(type, layout));
+}
+
+uint32_t SpirvShaderWriter::getConstantId(const ConstantValue& value)
+{
+	if (value.is<bool>())
+		return getBoolConstantId(value.get<bool>());
+	else if (value.is<int32_t>())
+		return getIntConstantId(value.get<int32_t>());
+	else if (value.is<uint32_t>())
+		return getUIntConstantId(value.get<uint32_t>());
+	else if (value.is<float>())
+		return getFloatConstantId(value.get<float>());
+
+	const auto getVectorId = [this](const auto& vector, size_t size, AstPrimitiveType primitiveType)
+	{
+		std::vector<uint32_t> components;
+
+		for (size_t i = 0; i < size; i++)
+			components.emplace_back(getConstantId(vector[i]));
+
+		return composite(AstVectorType{ primitiveType, size }, components).id;
+	};
+
+	if (value.is<Vector2i>())
+		return getVectorId(value.get<Vector2i>(), 2, AstPrimitiveType::Int);
+	else if (value.is<Vector2u>())
+		return getVectorId(value.get<Vector2u>(), 2, AstPrimitiveType::UInt);
+	else if (value.is<Vector2f>())
+		return getVectorId(value.get<Vector2f>(), 2, AstPrimitiveType::Float);
+	else if (value.is<Vector3i>())
+		return getVectorId(value.get<Vector3i>(), 3, AstPrimitiveType::Int);
+	else if (value.is<Vector3u>())
+		return getVectorId(value.get<Vector3u>(), 3, AstPrimitiveType::UInt);
+	else if (value.is<Vector3f>())
+		return getVectorId(value.get<Vector3f>(), 3, AstPrimitiveType::Float);
+	else if (value.is<Vector4i>())
+		return getVectorId(value.get<Vector4i>(), 4, AstPrimitiveType::Int);
+	else if (value.is<Vector4u>())
+		return getVectorId(value.get<Vector4u>(), 4, AstPrimitiveType::UInt);
+	else if (value.is<Vector4f>())
+		return getVectorId(value.get<Vector4f>(), 4, AstPrimitiveType::Float);
+
+	ATEMA_ERROR("Invalid constant type");
+
+	return 0;
+}
+
+uint32_t SpirvShaderWriter::getScalarConstantId(AstPrimitiveType type, uint32_t bits)
+{
+	const auto key = getPrimitiveKey(type) + std::to_string(bits);
+
+	const auto it = m_constantIds.find(key);
+
+	if (it != m_constantIds.end())
+		return it->second;
+
+	const auto typeId = getTypeId(type);
+
+	const auto id = createId();
+
+	writeInstruction(m_declarations, spv::OpConstant, { typeId, id, bits });
+
+	m_constantIds[key] = id;
+
+	return id;
+}
+
+uint32_t SpirvShaderWriter::getBoolConstantId(bool value)
+{
+	const auto key = value ? "true" : "false";
+
+	const auto it = m_constantIds.find(key);
+
+	if (it != m_constantIds.end())
+		return it->second;
+
+	const auto typeId = getTypeId(AstPrimitiveType::Bool);
+
+	const auto id = createId();
+
+	writeInstruction(m_declarations, value ? spv::OpConstantTrue : spv::OpConstantFalse, { typeId, id });
+
+	m_constantIds[key] = id;
+	m_scalarConstants[id] = value;
+
+	return id;
+}
+
+uint32_t SpirvShaderWriter::getIntConstantId(int32_t value)
+{
+	const auto id = getScalarConstantId(AstPrimitiveType::Int, static_cast<uint32_t>(value));
+
+	m_scalarConstants[id] = value;
+
+	return id;
+}
+
+uint32_t SpirvShaderWriter::getUIntConstantId(uint32_t value)
+{
+	const auto id = getScalarConstantId(AstPrimitiveType::UInt, value);
+
+	m_scalarConstants[id] = value;
+
+	return id;
+}
+
+uint32_t SpirvShaderWriter::getFloatConstantId(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(uint32_t));
+
+	const auto id = getScalarConstantId(AstPrimitiveType::Float, bits);
+
+	m_scalarConstants[id] = value;
+
+	return id;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::getScalarConstant(AstPrimitiveType type, int value)
+{
+	Value result;
+	result.type = type;
+
+	switch (type)
+	{
+		case AstPrimitiveType::Bool:
+		{
+			result.id = getBoolConstantId(value != 0);
+			break;
+		}
+		case AstPrimitiveType::Int:
+		{
+			result.id = getIntConstantId(static_cast<int32_t>(value));
+			break;
+		}
+		case AstPrimitiveType::UInt:
+		{
+			result.id = getUIntConstantId(static_cast<uint32_t>(value));
+			break;
+		}
+		case AstPrimitiveType::Float:
+		{
+			result.id = getFloatConstantId(static_cast<float>(value));
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid primitive type");
+		}
+	}
+
+	return result;
+}
+
+std::optional<ConstantValue> SpirvShaderWriter::evaluateConstant(const Expression& expression)
+{
+	// Options were registered in the preprocessor, so they are replaced by their values
+	auto processedExpression = m_preprocessor.process(expression);
+
+	AstEvaluator evaluator;
+
+	return evaluator.evaluate(*processedExpression);
+}
+
+bool SpirvShaderWriter::evaluateCondition(const Expression* condition)
+{
+	if (!condition)
+		return true;
+
+	auto processedExpression = m_preprocessor.process(*condition);
+
+	AstEvaluator evaluator;
+
+	const auto value = evaluator.evaluateCondition(*processedExpression);
+
+	if (!value.has_value())
+		ATEMA_ERROR("Optional condition must only depend on options");
+
+	return value.value();
+}
+
+uint32_t SpirvShaderWriter::evaluateDecorationIndex(const Expression& expression)
+{
+	const auto value = evaluateConstant(expression);
+
+	if (value.has_value())
+	{
+		if (value->is<int32_t>() && value->get<int32_t>() >= 0)
+			return static_cast<uint32_t>(value->get<int32_t>());
+		else if (value->is<uint32_t>())
+			return value->get<uint32_t>();
+	}
+
+	ATEMA_ERROR("Location, set & binding indices must be positive constant integers");
+
+	return 0;
+}
+
+void SpirvShaderWriter::visit(const ConditionalStatement& statement)
+{
+	if (statement.branches.empty())
+	{
+		if (statement.elseStatement)
+			statement.elseStatement->accept(*this);
+
+		return;
+	}
+
+	writeConditional(statement, 0);
+}
+
+void SpirvShaderWriter::visit(const ForLoopStatement& statement)
+{
+	pushScope();
+
+	if (statement.initialization)
+		statement.initialization->accept(*this);
+
+	writeLoop(statement.condition.get(), statement.increase.get(), *statement.statement, false);
+
+	popScope();
+}
+
+void SpirvShaderWriter::visit(const WhileLoopStatement& statement)
+{
+	writeLoop(statement.condition.get(), nullptr, *statement.statement, false);
+}
+
+void SpirvShaderWriter::visit(const DoWhileLoopStatement& statement)
+{
+	writeLoop(statement.condition.get(), nullptr, *statement.statement, true);
+}
+
+void SpirvShaderWriter::visit(const VariableDeclarationStatement& statement)
+{
+	auto type = resolveType(statement.type);
+
+	Value value;
+
+	if (statement.value)
+	{
+		value = evaluateValue(*statement.value);
+
+		// Implicit array size : get it from the value
+		if (type.is<AstArrayType>() && type.get<AstArrayType>().sizeType == AstArrayType::SizeType::Implicit)
+		{
+			if (!value.type.is<AstArrayType>())
+				ATEMA_ERROR("Array variable '" + statement.name + "' must be initialized with an array");
+
+			auto& arrayType = type.get<AstArrayType>();
+			arrayType.sizeType = AstArrayType::SizeType::Constant;
+			arrayType.size = getArraySize(value.type.get<AstArrayType>());
+		}
+	}
+
+	// Global variables are private to each invocation and initialized at the beginning of the entry function
+	auto storageClass = m_isInFunction ? spv::StorageClassFunction : spv::StorageClassPrivate;
+
+	// Unless they are shared by a compute workgroup
+	if (statement.qualifiers & VariableQualifier::Shared)
+	{
+		if (m_isInFunction)
+			ATEMA_ERROR("Shared variable '" + statement.name + "' must be global");
+
+		if (m_stage != AstShaderStage::Compute)
+			ATEMA_ERROR("Shared variables are only available in compute shaders");
+
+		if (statement.value)
+			ATEMA_ERROR("Shared variable '" + statement.name + "' can't be initialized");
+
+		storageClass = spv::StorageClassWorkgroup;
+	}
+
+	const auto variable = createVariable(statement.name, type, storageClass);
+
+	if (statement.value)
+		store(variable, value);
+
+	addVariable(statement.name, variable);
+}
+
+void SpirvShaderWriter::visit(const StructDeclarationStatement& statement)
+{
+	if (m_structs.find(statement.name) != m_structs.end())
+		ATEMA_ERROR("Struct '" + statement.name + "' is already defined");
+
+	StructData structData;
+
+	for (const auto& member : statement.members)
+	{
+		if (!evaluateCondition(member.condition.get()))
+			continue;
+
+		auto& newMember = structData.members.emplace_back();
+		newMember.name = member.name;
+		newMember.type = resolveType(member.type);
+	}
+
+	if (structData.members.empty())
+		ATEMA_ERROR("Struct '" + statement.name + "' must have at least one member");
+
+	m_structs[statement.name] = std::move(structData);
+}
+
+void SpirvShaderWriter::visit(const InputDeclarationStatement& statement)
+{
+	if (statement.stage != m_stage)
+		return;
+
+	for (const auto& variable : statement.variables)
+	{
+		if (!evaluateCondition(variable.condition.get()))
+			continue;
+
+		const auto type = resolveType(variable.type);
+		const auto layout = type.is<AstStructType>() ? TypeLayout::InterfaceBlock : TypeLayout::None;
+
+		const auto value = createVariable(variable.name, type, spv::StorageClassInput, layout);
+
+		writeDecoration(value.id, spv::DecorationLocation, { evaluateDecorationIndex(*variable.location) });
+
+		// Integers can't be interpolated
+		if (m_stage == AstShaderStage::Fragment && isNumeric(type) && getPrimitiveType(type) != AstPrimitiveType::Float)
+			writeDecoration(value.id, spv::DecorationFlat);
+
+		m_interfaceIds.emplace_back(value.id);
+
+		addVariable(variable.name, value);
+	}
+}
+
+void SpirvShaderWriter::visit(const OutputDeclarationStatement& statement)
+{
+	if (statement.stage != m_stage)
+		return;
+
+	for (const auto& variable : statement.variables)
+	{
+		if (!evaluateCondition(variable.condition.get()))
+			continue;
+
+		const auto type = resolveType(variable.type);
+		const auto layout = type.is<AstStructType>() ? TypeLayout::InterfaceBlock : TypeLayout::None;
+
+		const auto value = createVariable(variable.name, type, spv::StorageClassOutput, layout);
+
+		writeDecoration(value.id, spv::DecorationLocation, { evaluateDecorationIndex(*variable.location) });
+
+		m_interfaceIds.emplace_back(value.id);
+
+		addVariable(variable.name, value);
+	}
+}
+
+void SpirvShaderWriter::visit(const ExternalDeclarationStatement& statement)
+{
+	for (const auto& variable : statement.variables)
+	{
+		if (!evaluateCondition(variable.condition.get()))
+			continue;
+
+		const auto type = resolveType(variable.type);
+
+		Value value;
+
+		if (type.is<AstStructType>())
+		{
+			switch (variable.structLayout)
+			{
+				case StructLayout::Std140:
+				{
+					value = createVariable(variable.name, type, spv::StorageClassUniform, TypeLayout::Std140Block);
+					break;
+				}
+				case StructLayout::Std430:
+				{
+					value = createVariable(variable.name, type, spv::StorageClassUniform, TypeLayout::Std430Block);
+					break;
+				}
+				default:
+				{
+					ATEMA_ERROR("Unsupported struct layout");
+				}
+			}
+		}
+		else if (isOpaque(type))
+		{
+			value = createVariable(variable.name, type, spv::StorageClassUniformConstant);
+		}
+		else
+		{
+			ATEMA_ERROR("External variable '" + variable.name + "' must be a struct, a sampler or an image");
+		}
+
+		writeDecoration(value.id, spv::DecorationDescriptorSet, { evaluateDecorationIndex(*variable.setIndex) });
+		writeDecoration(value.id, spv::DecorationBinding, { evaluateDecorationIndex(*variable.bindingIndex) });
+
+		addVariable(variable.name, value);
+	}
+}
+
+void SpirvShaderWriter::visit(const OptionDeclarationStatement& statement)
+{
+	for (const auto& variable : statement.variables)
+	{
+		if (!variable.value)
+			ATEMA_ERROR("Option '" + variable.name + "' must have a value");
+
+		const auto value = evaluateConstant(*variable.value);
+
+		if (!value.has_value())
+			ATEMA_ERROR("Option '" + variable.name + "' must be a constant");
+
+		// Options behave like preprocessor definitions : the type of the value is kept
+		m_options[variable.name] = value.value();
+		m_preprocessor.setOption(variable.name, value.value());
+
+		Value constant;
+		constant.type = getConstantType(value.value());
+		constant.id = getConstantId(value.value());
+
+		addVariable(variable.name, constant);
+	}
+}
+
+void SpirvShaderWriter::visit(const FunctionDeclarationStatement& statement)
+{
+	auto& function = declareFunction(statement);
+
+	// Declaration only
+	if (!statement.sequence)
+		return;
+
+	if (function.isDefined)
+		ATEMA_ERROR("Function '" + statement.name + "' is already defined");
+
+	function.isDefined = true;
+
+	FunctionContext context;
+	context.returnType = function.returnType;
+
+	m_function = &context;
+	m_isInFunction = true;
+
+	std::vector<uint32_t> argumentTypeIds;
+
+	for (const auto& argumentType : function.argumentTypes)
+	{
+		if (isOpaque(argumentType))
+			argumentTypeIds.emplace_back(getPointerTypeId(spv::StorageClassUniformConstant, getTypeId(argumentType)));
+		else
+			argumentTypeIds.emplace_back(getTypeId(argumentType));
+	}
+
+	const auto returnTypeId = getTypeId(function.returnType);
+
+	writeInstruction(context.header, spv::OpFunction, { returnTypeId, function.id, 0, getFunctionTypeId(returnTypeId, argumentTypeIds) });
+	writeName(function.id, statement.name);
+
+	pushScope();
+
+	std::vector<uint32_t> argumentIds;
+
+	for (size_t i = 0; i < statement.arguments.size(); i++)
+	{
+		const auto argumentId = createId();
+
+		writeInstruction(context.header, spv::OpFunctionParameter, { argumentTypeIds[i], argumentId });
+
+		argumentIds.emplace_back(argumentId);
+	}
+
+	beginBlock(createId());
+
+	for (size_t i = 0; i < statement.arguments.size(); i++)
+	{
+		const auto& argumentName = statement.arguments[i].name;
+		const auto& argumentType = function.argumentTypes[i];
+
+		// Samplers & images are passed by pointer
+		if (isOpaque(argumentType))
+		{
+			Value argument;
+			argument.type = argumentType;
+			argument.id = argumentIds[i];
+			argument.isPointer = true;
+			argument.storageClass = spv::StorageClassUniformConstant;
+
+			writeName(argument.id, argumentName);
+
+			addVariable(argumentName, argument);
+		}
+		// Other arguments are copied in local variables, because they can be modified by the function
+		else
+		{
+			Value argument;
+			argument.type = argumentType;
+			argument.id = argumentIds[i];
+
+			const auto variable = createVariable(argumentName, argumentType, spv::StorageClassFunction);
+
+			store(variable, argument);
+
+			addVariable(argumentName, variable);
+		}
+	}
+
+	statement.sequence->accept(*this);
+
+	if (isReachable())
+	{
+		if (function.returnType.is<AstVoidType>())
+			writeTerminator(spv::OpReturn);
+		else
+			writeTerminator(spv::OpUnreachable);
+	}
+
+	popScope();
+
+	writeFunction(m_functionDefinitions, context);
+	writeInstruction(m_functionDefinitions, spv::OpFunctionEnd, {});
+
+	m_function = &m_globalInitialization;
+	m_isInFunction = false;
+}
+
+void SpirvShaderWriter::visit(const EntryFunctionDeclarationStatement& statement)
+{
+	if (statement.stage != m_stage)
+		return;
+
+	if (m_entryFound)
+		ATEMA_ERROR("Only one shader entry must be defined");
+
+	if (!statement.sequence)
+		ATEMA_ERROR("Shader entry must be defined");
+
+	m_entryFound = true;
+	m_entryFunctionId = createId();
+	m_workgroupSize = statement.workgroupSize;
+
+	FunctionContext context;
+	context.returnType = AstVoidType();
+
+	m_function = &context;
+	m_isInFunction = true;
+
+	const auto voidTypeId = getTypeId(AstVoidType());
+
+	writeInstruction(context.header, spv::OpFunction, { voidTypeId, m_entryFunctionId, 0, getFunctionTypeId(voidTypeId, {}) });
+	writeName(m_entryFunctionId, "main");
+
+	beginBlock(createId());
+
+	writeResult(spv::OpFunctionCall, voidTypeId, { m_globalInitializationId });
+
+	pushScope();
+
+	statement.sequence->accept(*this);
+
+	if (isReachable())
+		writeTerminator(spv::OpReturn);
+
+	popScope();
+
+	writeFunction(m_functionDefinitions, context);
+	writeInstruction(m_functionDefinitions, spv::OpFunctionEnd, {});
+
+	m_function = &m_globalInitialization;
+	m_isInFunction = false;
+}
+
+void SpirvShaderWriter::visit(const ExpressionStatement& statement)
+{
+	evaluate(*statement.expression);
+}
+
+void SpirvShaderWriter::visit(const BreakStatement& statement)
+{
+	if (m_loops.empty())
+		ATEMA_ERROR("Break statement must be inside a loop");
+
+	auto& loop = m_loops.back();
+	loop.isBreakReached = true;
+
+	writeBranch(loop.mergeLabel);
+}
+
+void SpirvShaderWriter::visit(const ContinueStatement& statement)
+{
+	if (m_loops.empty())
+		ATEMA_ERROR("Continue statement must be inside a loop");
+
+	auto& loop = m_loops.back();
+	loop.isContinueReached = true;
+
+	writeBranch(loop.continueLabel);
+}
+
+void SpirvShaderWriter::visit(const ReturnStatement& statement)
+{
+	if (!m_isInFunction)
+		ATEMA_ERROR("Return statement must be inside a function");
+
+	if (statement.expression)
+	{
+		const auto value = convert(evaluate(*statement.expression), m_function->returnType);
+
+		writeTerminator(spv::OpReturnValue, { value.id });
+	}
+	else
+	{
+		writeTerminator(spv::OpReturn);
+	}
+}
+
+void SpirvShaderWriter::visit(const DiscardStatement& statement)
+{
+	if (m_stage != AstShaderStage::Fragment)
+		ATEMA_ERROR("Discard is only available in fragment shaders");
+
+	writeTerminator(spv::OpKill);
+}
+
+void SpirvShaderWriter::visit(const SequenceStatement& statement)
+{
+	if (!m_isSequenceProcessed)
+	{
+		m_isSequenceProcessed = true;
+
+		if (m_requestedStage.has_value())
+		{
+			// Extract desired stage from current sequence (when first calling this method)
+			AstReflector reflector;
+
+			statement.accept(reflector);
+
+			const auto processedStage = reflector.getAst(m_requestedStage.value());
+
+			beginModule(*processedStage);
+
+			processedStage->accept(*this);
+		}
+		else
+		{
+			beginModule(statement);
+
+			statement.accept(*this);
+		}
+
+		m_isSequenceProcessed = false;
+	}
+	else
+	{
+		if (m_isInFunction)
+			pushScope();
+
+		for (const auto& subStatement : statement.statements)
+		{
+			// Following statements can't be reached
+			if (!isReachable())
+				break;
+
+			subStatement->accept(*this);
+		}
+
+		if (m_isInFunction)
+			popScope();
+	}
+}
+
+void SpirvShaderWriter::visit(const OptionalStatement& statement)
+{
+	if (evaluateCondition(statement.condition.get()))
+		statement.statement->accept(*this);
+}
+
+void SpirvShaderWriter::visit(const IncludeStatement& statement)
+{
+	ATEMA_ERROR("SPIR-V writer does not support include statements, AST should have been preprocessed");
+}
+
+void SpirvShaderWriter::writeConditional(const ConditionalStatement& statement, size_t branchIndex)
+{
+	const auto& branch = statement.branches[branchIndex];
+
+	const bool hasElse = branchIndex + 1 < statement.branches.size() || statement.elseStatement;
+
+	const auto condition = evaluateBool(*branch.condition);
+
+	const auto trueLabel = createId();
+	const auto falseLabel = hasElse ? createId() : 0;
+	const auto mergeLabel = createId();
+
+	write(spv::OpSelectionMerge, { mergeLabel, 0 });
+	writeTerminator(spv::OpBranchConditional, { condition, trueLabel, hasElse ? falseLabel : mergeLabel });
+
+	bool isMergeReached = !hasElse;
+
+	beginBlock(trueLabel);
+
+	branch.statement->accept(*this);
+
+	if (isReachable())
+	{
+		writeBranch(mergeLabel);
+		isMergeReached = true;
+	}
+
+	if (hasElse)
+	{
+		beginBlock(falseLabel);
+
+		if (branchIndex + 1 < statement.branches.size())
+			writeConditional(statement, branchIndex + 1);
+		else
+			statement.elseStatement->accept(*this);
+
+		if (isReachable())
+		{
+			writeBranch(mergeLabel);
+			isMergeReached = true;
+		}
+	}
+
+	beginBlock(mergeLabel);
+
+	if (!isMergeReached)
+		writeTerminator(spv::OpUnreachable);
+}
+
+void SpirvShaderWriter::writeLoop(const Expression* condition, const Expression* increase, const Statement& statement, bool isDoWhile)
+{
+	const auto headerLabel = createId();
+	const auto bodyLabel = createId();
+	const auto continueLabel = createId();
+	const auto mergeLabel = createId();
+
+	writeBranch(headerLabel);
+
+	beginBlock(headerLabel);
+
+	write(spv::OpLoopMerge, { mergeLabel, continueLabel, 0 });
+
+	bool isMergeReached = false;
+
+	if (!isDoWhile && condition)
+	{
+		const auto conditionLabel = createId();
+
+		writeBranch(conditionLabel);
+
+		beginBlock(conditionLabel);
+
+		const auto conditionId = evaluateBool(*condition);
+
+		writeTerminator(spv::OpBranchConditional, { conditionId, bodyLabel, mergeLabel });
+
+		isMergeReached = true;
+	}
+	else
+	{
+		writeBranch(bodyLabel);
+	}
+
+	beginBlock(bodyLabel);
+
+	m_loops.emplace_back();
+	m_loops.back().mergeLabel = mergeLabel;
+	m_loops.back().continueLabel = continueLabel;
+
+	statement.accept(*this);
+
+	if (isReachable())
+	{
+		writeBranch(continueLabel);
+		m_loops.back().isContinueReached = true;
+	}
+
+	const auto loop = m_loops.back();
+	m_loops.pop_back();
+
+	isMergeReached |= loop.isBreakReached;
+
+	beginBlock(continueLabel);
+
+	// An unreachable continue target must only branch back to the header
+	if (!loop.isContinueReached)
+	{
+		writeBranch(headerLabel);
+	}
+	else if (isDoWhile && condition)
+	{
+		const auto conditionId = evaluateBool(*condition);
+
+		writeTerminator(spv::OpBranchConditional, { conditionId, headerLabel, mergeLabel });
+
+		isMergeReached = true;
+	}
+	else
+	{
+		if (increase)
+			evaluate(*increase);
+
+		writeBranch(headerLabel);
+	}
+
+	beginBlock(mergeLabel);
+
+	if (!isMergeReached)
+		writeTerminator(spv::OpUnreachable);
+}
+
+void SpirvShaderWriter::visit(const ConstantExpression& expression)
+{
+	m_value = Value();
+	m_value.type = getConstantType(expression.value);
+	m_value.id = getConstantId(expression.value);
+}
+
+void SpirvShaderWriter::visit(const VariableExpression& expression)
+{
+	m_value = getVariable(expression.identifier);
+}
+
+void SpirvShaderWriter::visit(const AccessIndexExpression& expression)
+{
+	const auto value = evaluate(*expression.expression);
+	const auto index = evaluateValue(*expression.index);
+
+	m_value = accessIndex(value, index);
+}
+
+void SpirvShaderWriter::visit(const AccessIdentifierExpression& expression)
+{
+	const auto value = evaluate(*expression.expression);
+
+	m_value = accessMember(value, expression.identifier);
+}
+
+void SpirvShaderWriter::visit(const AssignmentExpression& expression)
+{
+	const auto pointer = evaluate(*expression.left);
+
+	if (!pointer.isPointer)
+		ATEMA_ERROR("Left operand of an assignment must be a variable");
+
+	const auto value = convert(evaluateValue(*expression.right), pointer.type);
+
+	store(pointer, value);
+
+	m_value = value;
+}
+
+void SpirvShaderWriter::visit(const UnaryExpression& expression)
+{
+	switch (expression.op)
+	{
+		case UnaryOperator::IncrementPrefix:
+		case UnaryOperator::IncrementPostfix:
+		case UnaryOperator::DecrementPrefix:
+		case UnaryOperator::DecrementPostfix:
+		{
+			const auto pointer = evaluate(*expression.operand);
+
+			if (!pointer.isPointer)
+				ATEMA_ERROR("Operand of an increment or a decrement must be a variable");
+
+			const auto value = load(pointer);
+
+			const bool isIncrement = expression.op == UnaryOperator::IncrementPrefix || expression.op == UnaryOperator::IncrementPostfix;
+			const bool isPrefix = expression.op == UnaryOperator::IncrementPrefix || expression.op == UnaryOperator::DecrementPrefix;
+
+			const auto one = getScalarConstant(getPrimitiveType(value.type), 1);
+
+			const auto result = arithmetic(isIncrement ? BinaryOperator::Add : BinaryOperator::Subtract, value, one);
+
+			store(pointer, result);
+
+			m_value = isPrefix ? result : value;
+
+			break;
+		}
+		case UnaryOperator::Positive:
+		{
+			m_value = evaluateValue(*expression.operand);
+
+			break;
+		}
+		case UnaryOperator::Negative:
+		{
+			const auto value = evaluateValue(*expression.operand);
+
+			if (value.type.is<AstMatrixType>())
+			{
+				m_value = matrixArithmetic(BinaryOperator::Multiply, value, getScalarConstant(AstPrimitiveType::Float, -1));
+			}
+			else
+			{
+				const auto primitiveType = getPrimitiveType(value.type);
+
+				if (primitiveType == AstPrimitiveType::Bool)
+					ATEMA_ERROR("Boolean values can't be negated");
+
+				m_value = Value();
+				m_value.type = value.type;
+				m_value.id = writeResult(primitiveType == AstPrimitiveType::Float ? spv::OpFNegate : spv::OpSNegate, getTypeId(value.type), { value.id });
+			}
+
+			break;
+		}
+		case UnaryOperator::LogicalNot:
+		{
+			const auto value = evaluateValue(*expression.operand);
+
+			if (!isBool(value.type))
+				ATEMA_ERROR("Logical not operand must be a boolean");
+
+			m_value = Value();
+			m_value.type = value.type;
+			m_value.id = writeResult(spv::OpLogicalNot, getTypeId(value.type), { value.id });
+
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid unary operator");
+		}
+	}
+}
+
+void SpirvShaderWriter::visit(const BinaryExpression& expression)
+{
+	switch (expression.op)
+	{
+		case BinaryOperator::And:
+		case BinaryOperator::Or:
+		{
+			m_value = logical(expression.op, *expression.left, *expression.right);
+			return;
+		}
+		default:
+			break;
+	}
+
+	const auto left = evaluateValue(*expression.left);
+	const auto right = evaluateValue(*expression.right);
+
+	switch (expression.op)
+	{
+		case BinaryOperator::Add:
+		case BinaryOperator::Subtract:
+		case BinaryOperator::Multiply:
+		case BinaryOperator::Divide:
+		case BinaryOperator::Modulo:
+		{
+			m_value = arithmetic(expression.op, left, right);
+			break;
+		}
+		case BinaryOperator::BitwiseAnd:
+		case BinaryOperator::BitwiseOr:
+		case BinaryOperator::BitwiseXor:
+		case BinaryOperator::BitwiseLeftShift:
+		case BinaryOperator::BitwiseRightShift:
+		{
+			m_value = bitwise(expression.op, left, right);
+			break;
+		}
+		case BinaryOperator::Equal:
+		case BinaryOperator::NotEqual:
+		{
+			auto result = comparison(expression.op, left, right);
+
+			// Vectors are equal if all their components are equal
+			if (result.type.is<AstVectorType>())
+			{
+				result.id = writeResult(expression.op == BinaryOperator::Equal ? spv::OpAll : spv::OpAny, getTypeId(AstPrimitiveType::Bool), { result.id });
+				result.type = AstPrimitiveType::Bool;
+			}
+
+			m_value = result;
+			break;
+		}
+		case BinaryOperator::Less:
+		case BinaryOperator::Greater:
+		case BinaryOperator::LessOrEqual:
+		case BinaryOperator::GreaterOrEqual:
+		{
+			if (!left.type.is<AstPrimitiveType>() || !right.type.is<AstPrimitiveType>())
+				ATEMA_ERROR("Relational operators only apply to scalars");
+
+			m_value = comparison(expression.op, left, right);
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid binary operator");
+		}
+	}
+}
+
+void SpirvShaderWriter::visit(const FunctionCallExpression& expression)
+{
+	std::vector<Value> arguments;
+	arguments.reserve(expression.arguments.size());
+
+	for (const auto& argument : expression.arguments)
+		arguments.emplace_back(evaluate(*argument));
+
+	m_value = callFunction(expression.identifier, arguments);
+}
+
+void SpirvShaderWriter::visit(const BuiltInFunctionCallExpression& expression)
+{
+	std::vector<Value> arguments;
+	arguments.reserve(expression.arguments.size());
+
+	for (const auto& argument : expression.arguments)
+		arguments.emplace_back(evaluate(*argument));
+
+	switch (expression.function)
+	{
+		case BuiltInFunction::Min:
+		{
+			m_value = callBuiltInFunction("min", arguments);
+			break;
+		}
+		case BuiltInFunction::Max:
+		{
+			m_value = callBuiltInFunction("max", arguments);
+			break;
+		}
+		case BuiltInFunction::Cross:
+		{
+			m_value = callBuiltInFunction("cross", arguments);
+			break;
+		}
+		case BuiltInFunction::Dot:
+		{
+			m_value = callBuiltInFunction("dot", arguments);
+			break;
+		}
+		case BuiltInFunction::Norm:
+		{
+			m_value = callBuiltInFunction("length", arguments);
+			break;
+		}
+		case BuiltInFunction::Normalize:
+		{
+			m_value = callBuiltInFunction("normalize", arguments);
+			break;
+		}
+		case BuiltInFunction::Sample:
+		{
+			m_value = callBuiltInFunction("texture", arguments);
+			break;
+		}
+		case BuiltInFunction::SetVertexPosition:
+		{
+			if (m_stage != AstShaderStage::Vertex)
+				ATEMA_ERROR("Vertex position can only be set in vertex shaders");
+
+			if (arguments.size() != 1)
+				ATEMA_ERROR("SetVertexPosition expects 1 argument");
+
+			const AstType positionType = AstVectorType{ AstPrimitiveType::Float, 4 };
+
+			store(getBuiltInVariable(spv::BuiltInPosition, positionType, spv::StorageClassOutput, "gl_Position"), arguments[0]);
+
+			m_value = Value();
+			m_value.type = AstVoidType();
+
+			break;
+		}
+		case BuiltInFunction::GetFragmentCoordinates:
+		{
+			if (m_stage != AstShaderStage::Fragment)
+				ATEMA_ERROR("Fragment coordinates are only available in fragment shaders");
+
+			const AstType coordinatesType = AstVectorType{ AstPrimitiveType::Float, 4 };
+
+			m_value = load(getBuiltInVariable(spv::BuiltInFragCoord, coordinatesType, spv::StorageClassInput, "gl_FragCoord"));
+
+			break;
+		}
+		case BuiltInFunction::GetGlobalInvocationId:
+		case BuiltInFunction::GetLocalInvocationId:
+		case BuiltInFunction::GetWorkgroupId:
+		{
+			if (m_stage != AstShaderStage::Compute)
+				ATEMA_ERROR("Invocation ids are only available in compute shaders");
+
+			const AstType idType = AstVectorType{ AstPrimitiveType::UInt, 3 };
+
+			if (expression.function == BuiltInFunction::GetGlobalInvocationId)
+				m_value = load(getBuiltInVariable(spv::BuiltInGlobalInvocationId, idType, spv::StorageClassInput, "gl_GlobalInvocationID"));
+			else if (expression.function == BuiltInFunction::GetLocalInvocationId)
+				m_value = load(getBuiltInVariable(spv::BuiltInLocalInvocationId, idType, spv::StorageClassInput, "gl_LocalInvocationID"));
+			else
+				m_value = load(getBuiltInVariable(spv::BuiltInWorkgroupId, idType, spv::StorageClassInput, "gl_WorkGroupID"));
+
+			break;
+		}
+		case BuiltInFunction::Barrier:
+		{
+			m_value = callBuiltInFunction("barrier", arguments);
+			break;
+		}
+		case BuiltInFunction::ImageLoad:
+		{
+			m_value = callBuiltInFunction("imageLoad", arguments);
+			break;
+		}
+		case BuiltInFunction::ImageStore:
+		{
+			m_value = callBuiltInFunction("imageStore", arguments);
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid built-in function");
+		}
+	}
+}
+
+void SpirvShaderWriter::visit(const CastExpression& expression)
+{
+	std::vector<Value> arguments;
+	arguments.reserve(expression.components.size());
+
+	for (const auto& component : expression.components)
+		arguments.emplace_back(evaluateValue(*component));
+
+	m_value = construct(resolveType(expression.type), arguments);
+}
+
+void SpirvShaderWriter::visit(const SwizzleExpression& expression)
+{
+	const auto value = evaluate(*expression.expression);
+
+	std::vector<uint32_t> components;
+	components.reserve(expression.components.size());
+
+	for (const auto& component : expression.components)
+		components.emplace_back(static_cast<uint32_t>(component));
+
+	m_value = swizzle(value, components);
+}
+
+void SpirvShaderWriter::visit(const TernaryExpression& expression)
+{
+	const auto condition = evaluateBool(*expression.condition);
+
+	m_value = select(condition, *expression.trueValue, *expression.falseValue);
+}
+
+void SpirvShaderWriter::pushScope()
+{
+	m_scopes.emplace_back();
+}
+
+void SpirvShaderWriter::popScope()
+{
+	m_scopes.pop_back();
+}
+
+void SpirvShaderWriter::addVariable(const std::string& name, const Value& value)
+{
+	auto& scope = m_scopes.back();
+
+	if (scope.find(name) != scope.end())
+		ATEMA_ERROR("Variable '" + name + "' is already defined");
+
+	scope[name] = value;
+}
+
+const SpirvShaderWriter::Value& SpirvShaderWriter::getVariable(const std::string& name) const
+{
+	for (auto it = m_scopes.rbegin(); it != m_scopes.rend(); it++)
+	{
+		const auto variableIt = it->find(name);
+
+		if (variableIt != it->end())
+			return variableIt->second;
+	}
+
+	ATEMA_ERROR("Variable '" + name + "' is not defined");
+
+	return m_scopes.back().begin()->second;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::createVariable(const std::string& name, const AstType& type, uint32_t storageClass, TypeLayout layout)
+{
+	const auto pointerTypeId = getPointerTypeId(storageClass, getTypeId(type, layout));
+
+	Value value;
+	value.type = type;
+	value.id = createId();
+	value.layout = layout;
+	value.isPointer = true;
+	value.storageClass = storageClass;
+
+	// Function variables must be declared at the beginning of the function
+	if (storageClass == spv::StorageClassFunction)
+		writeInstruction(m_function->variables, spv::OpVariable, { pointerTypeId, value.id, storageClass });
+	else
+		writeInstruction(m_declarations, spv::OpVariable, { pointerTypeId, value.id, storageClass });
+
+	if (!name.empty())
+		writeName(value.id, name);
+
+	return value;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::createTemporary(const Value& value)
+{
+	const auto variable = createVariable("", value.type, spv::StorageClassFunction);
+
+	store(variable, value);
+
+	return variable;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::getBuiltInVariable(uint32_t builtIn, const AstType& type, uint32_t storageClass, const std::string& name)
+{
+	const auto it = m_builtInVariables.find(builtIn);
+
+	if (it != m_builtInVariables.end())
+		return it->second;
+
+	const auto variable = createVariable(name, type, storageClass);
+
+	writeDecoration(variable.id, spv::DecorationBuiltIn, { builtIn });
+
+	m_interfaceIds.emplace_back(variable.id);
+
+	m_builtInVariables[builtIn] = variable;
+
+	return variable;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::evaluate(const Expression& expression)
+{
+	expression.accept(*this);
+
+	return m_value;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::evaluateValue(const Expression& expression)
+{
+	return load(evaluate(expression));
+}
+
+uint32_t SpirvShaderWriter::evaluateBool(const Expression& expression)
+{
+	const auto value = evaluateValue(expression);
+
+	if (!value.type.is<AstPrimitiveType>())
+		ATEMA_ERROR("Condition must be a scalar");
+
+	return convert(value, AstPrimitiveType::Bool).id;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::load(const Value& value)
+{
+	if (!value.isPointer)
+		return value;
+
+	Value result;
+	result.type = value.type;
+	result.layout = value.layout;
+
+	// Swizzled pointer : load the whole vector then extract the components
+	if (!value.components.empty())
+	{
+		const AstType vectorType = getNumericType(getPrimitiveType(value.type), value.vectorSize);
+
+		const auto vectorId = writeResult(spv::OpLoad, getTypeId(vectorType, value.layout), { value.id });
+
+		std::vector<uint32_t> operands = { vectorId, vectorId };
+		operands.insert(operands.end(), value.components.begin(), value.components.end());
+
+		result.id = writeResult(spv::OpVectorShuffle, getTypeId(value.type, value.layout), operands);
+	}
+	else
+	{
+		result.id = writeResult(spv::OpLoad, getTypeId(value.type, value.layout), { value.id });
+	}
+
+	return removeLayout(result);
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::removeLayout(const Value& value)
+{
+	if (value.layout == TypeLayout::None)
+		return value;
+
+	Value result;
+	result.type = value.type;
+
+	if (isBool(value.type))
+	{
+		const auto componentCount = getComponentCount(value.type);
+		const auto zero = splat(getScalarConstant(AstPrimitiveType::UInt, 0), componentCount);
+
+		result.id = writeResult(spv::OpINotEqual, getTypeId(value.type), { value.id, zero.id });
+	}
+	else if (value.type.is<AstStructType>())
+	{
+		// Members may have a different layout, the struct must be rebuilt
+		const auto memberLayout = getMemberLayout(value.layout);
+
+		const auto& structData = getStruct(value.type.get<AstStructType>().name);
+
+		std::vector<uint32_t> constituents;
+
+		for (uint32_t i = 0; i < structData.members.size(); i++)
+		{
+			Value member;
+			member.type = structData.members[i].type;
+			member.layout = memberLayout;
+			member.id = writeResult(spv::OpCompositeExtract, getTypeId(member.type, memberLayout), { value.id, i });
+
+			constituents.emplace_back(removeLayout(member).id);
+		}
+
+		result = composite(value.type, constituents);
+	}
+	else if (value.type.is<AstArrayType>())
+	{
+		const auto& arrayType = value.type.get<AstArrayType>();
+		const auto elementType = getType(arrayType.componentType);
+		const auto elementLayout = getMemberLayout(value.layout);
+		const auto elementTypeId = getTypeId(elementType, elementLayout);
+
+		std::vector<uint32_t> constituents;
+
+		for (uint32_t i = 0; i < getArraySize(arrayType); i++)
+		{
+			Value element;
+			element.type = elementType;
+			element.layout = elementLayout;
+			element.id = writeResult(spv::OpCompositeExtract, elementTypeId, { value.id, i });
+
+			constituents.emplace_back(removeLayout(element).id);
+		}
+
+		result = composite(value.type, constituents);
+	}
+	else
+	{
+		result.id = value.id;
+	}
+
+	return result;
+}
+
+void SpirvShaderWriter::store(const Value& pointer, const Value& value)
+{
+	if (!pointer.isPointer)
+		ATEMA_ERROR("Can't assign a value to an expression");
+
+	switch (pointer.storageClass)
+	{
+		case spv::StorageClassUniformConstant:
+		case spv::StorageClassInput:
+		{
+			ATEMA_ERROR("Can't assign a value to a read-only variable");
+		}
+		// Only storage buffers can be written
+		case spv::StorageClassUniform:
+		{
+			if (getMemberLayout(pointer.layout) != TypeLayout::Std430)
+				ATEMA_ERROR("Can't assign a value to a read-only variable");
+
+			break;
+		}
+		default:
+			break;
+	}
+
+	const auto convertedValue = convert(load(value), pointer.type);
+
+	// Swizzled pointer : load the whole vector, replace the components then store the vector
+	if (!pointer.components.empty())
+	{
+		const AstType vectorType = getNumericType(getPrimitiveType(pointer.type), pointer.vectorSize);
+		const auto vectorTypeId = getTypeId(vectorType);
+
+		const auto vectorId = writeResult(spv::OpLoad, vectorTypeId, { pointer.id });
+
+		std::vector<uint32_t> operands = { vectorId, convertedValue.id };
+
+		for (uint32_t i = 0; i < pointer.vectorSize; i++)
+		{
+			const auto it = std::find(pointer.components.begin(), pointer.components.end(), i);
+
+			if (it == pointer.components.end())
+				operands.emplace_back(i);
+			else
+				operands.emplace_back(static_cast<uint32_t>(pointer.vectorSize + (it - pointer.components.begin())));
+		}
+
+		const auto resultId = writeResult(spv::OpVectorShuffle, vectorTypeId, operands);
+
+		write(spv::OpStore, { pointer.id, resultId });
+	}
+	// Interface blocks don't share the logical type, aggregates are stored member by member
+	else if (pointer.layout != TypeLayout::None && pointer.type.is<AstStructType>())
+	{
+		const auto& structData = getStruct(pointer.type.get<AstStructType>().name);
+
+		for (uint32_t i = 0; i < structData.members.size(); i++)
+		{
+			const auto& memberType = structData.members[i].type;
+
+			store(access(pointer, i, 0, memberType), extract(convertedValue, { i }, memberType));
+		}
+	}
+	else if (pointer.layout != TypeLayout::None && pointer.type.is<AstArrayType>())
+	{
+		const auto& arrayType = pointer.type.get<AstArrayType>();
+		const auto elementType = getType(arrayType.componentType);
+
+		for (uint32_t i = 0; i < getArraySize(arrayType); i++)
+			store(access(pointer, i, 0, elementType), extract(convertedValue, { i }, elementType));
+	}
+	else
+	{
+		write(spv::OpStore, { pointer.id, convertedValue.id });
+	}
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::convert(const Value& value, const AstType& type)
+{
+	const auto source = load(value);
+
+	if (isSameType(source.type, type))
+		return source;
+
+	const bool isSourceNumeric = isNumeric(source.type);
+
+	if (isSourceNumeric && isNumeric(type))
+	{
+		const auto sourceCount = getComponentCount(source.type);
+		const auto targetCount = getComponentCount(type);
+
+		const auto convertedValue = convert(source, getPrimitiveType(type));
+
+		if (sourceCount == targetCount)
+			return convertedValue;
+
+		if (sourceCount == 1)
+			return splat(convertedValue, targetCount);
+	}
+	else if (source.type.is<AstArrayType>() && type.is<AstArrayType>())
+	{
+		// Arrays only differ by their element type (implicit conversion of constructors)
+		const auto& sourceArray = source.type.get<AstArrayType>();
+		const auto& targetArray = type.get<AstArrayType>();
+
+		const auto size = getArraySize(sourceArray);
+
+		if (size == getArraySize(targetArray))
+		{
+			const auto sourceElementType = getType(sourceArray.componentType);
+			const auto targetElementType = getType(targetArray.componentType);
+
+			std::vector<uint32_t> constituents;
+
+			for (uint32_t i = 0; i < size; i++)
+				constituents.emplace_back(convert(extract(source, { i }, sourceElementType), targetElementType).id);
+
+			return composite(type, constituents);
+		}
+	}
+
+	ATEMA_ERROR("Can't convert '" + getTypeKey(source.type) + "' to '" + getTypeKey(type) + "'");
+
+	return source;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::convert(const Value& value, AstPrimitiveType primitiveType)
+{
+	const auto source = load(value);
+
+	const auto sourcePrimitiveType = getPrimitiveType(source.type);
+
+	if (sourcePrimitiveType == primitiveType)
+		return source;
+
+	if (source.type.is<AstMatrixType>())
+		ATEMA_ERROR("Matrices can't be converted");
+
+	const auto componentCount = getComponentCount(source.type);
+
+	// Scalar constants are folded
+	const auto constantIt = m_scalarConstants.find(source.id);
+
+	if (componentCount == 1 && constantIt != m_scalarConstants.end())
+	{
+		const auto& constant = constantIt->second;
+
+		Value result;
+		result.type = primitiveType;
+
+		if (primitiveType == AstPrimitiveType::Bool)
+		{
+			bool boolValue = false;
+
+			if (constant.is<int32_t>())
+				boolValue = constant.get<int32_t>() != 0;
+			else if (constant.is<uint32_t>())
+				boolValue = constant.get<uint32_t>() != 0;
+			else if (constant.is<float>())
+				boolValue = constant.get<float>() != 0.0f;
+
+			result.id = getBoolConstantId(boolValue);
+		}
+		else if (primitiveType == AstPrimitiveType::Int)
+		{
+			int32_t intValue = 0;
+
+			if (constant.is<bool>())
+				intValue = constant.get<bool>() ? 1 : 0;
+			else if (constant.is<uint32_t>())
+				intValue = static_cast<int32_t>(constant.get<uint32_t>());
+			else if (constant.is<float>())
+				intValue = static_cast<int32_t>(constant.get<float>());
+
+			result.id = getIntConstantId(intValue);
+		}
+		else if (primitiveType == AstPrimitiveType::UInt)
+		{
+			uint32_t uintValue = 0;
+
+			if (constant.is<bool>())
+				uintValue = constant.get<bool>() ? 1 : 0;
+			else if (constant.is<int32_t>())
+				uintValue = static_cast<uint32_t>(constant.get<int32_t>());
+			else if (constant.is<float>())
+				uintValue = static_cast<uint32_t>(constant.get<float>());
+
+			result.id = getUIntConstantId(uintValue);
+		}
+		else
+		{
+			float floatValue = 0.0f;
+
+			if (constant.is<bool>())
+				floatValue = constant.get<bool>() ? 1.0f : 0.0f;
+			else if (constant.is<int32_t>())
+				floatValue = static_cast<float>(constant.get<int32_t>());
+			else if (constant.is<uint32_t>())
+				floatValue = static_cast<float>(constant.get<uint32_t>());
+
+			result.id = getFloatConstantId(floatValue);
+		}
+
+		return result;
+	}
+
+	Value result;
+	result.type = getNumericType(primitiveType, componentCount);
+
+	const auto typeId = getTypeId(result.type);
+
+	if (sourcePrimitiveType == AstPrimitiveType::Bool)
+	{
+		const auto one = splat(getScalarConstant(primitiveType, 1), componentCount);
+		const auto zero = splat(getScalarConstant(primitiveType, 0), componentCount);
+
+		result.id = writeResult(spv::OpSelect, typeId, { source.id, one.id, zero.id });
+	}
+	else if (primitiveType == AstPrimitiveType::Bool)
+	{
+		const auto zero = splat(getScalarConstant(sourcePrimitiveType, 0), componentCount);
+
+		const auto opCode = sourcePrimitiveType == AstPrimitiveType::Float ? spv::OpFUnordNotEqual : spv::OpINotEqual;
+
+		result.id = writeResult(opCode, typeId, { source.id, zero.id });
+	}
+	else
+	{
+		uint32_t opCode = spv::OpBitcast;
+
+		if (primitiveType == AstPrimitiveType::Float)
+			opCode = sourcePrimitiveType == AstPrimitiveType::Int ? spv::OpConvertSToF : spv::OpConvertUToF;
+		else if (sourcePrimitiveType == AstPrimitiveType::Float)
+			opCode = primitiveType == AstPrimitiveType::Int ? spv::OpConvertFToS : spv::OpConvertFToU;
+
+		result.id = writeResult(opCode, typeId, { source.id });
+	}
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::splat(const Value& value, size_t componentCount)
+{
+	if (componentCount == 1)
+		return value;
+
+	const std::vector<uint32_t> constituents(componentCount, value.id);
+
+	return composite(AstVectorType{ getPrimitiveType(value.type), componentCount }, constituents);
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::composite(const AstType& type, const std::vector<uint32_t>& constituents)
+{
+	Value result;
+	result.type = type;
+
+	const auto typeId = getTypeId(type);
+
+	bool isConstant = true;
+
+	for (const auto& constituent : constituents)
+	{
+		if (m_scalarConstants.find(constituent) == m_scalarConstants.end() && m_compositeConstants.find(constituent) == m_compositeConstants.end())
+		{
+			isConstant = false;
+			break;
+		}
+	}
+
+	// Constant composites are declared once at module level
+	if (isConstant)
+	{
+		auto key = "composite" + std::to_string(typeId);
+
+		for (const auto& constituent : constituents)
+			key += ":" + std::to_string(constituent);
+
+		const auto it = m_constantIds.find(key);
+
+		if (it != m_constantIds.end())
+		{
+			result.id = it->second;
+		}
+		else
+		{
+			result.id = createId();
+
+			std::vector<uint32_t> operands = { typeId, result.id };
+			operands.insert(operands.end(), constituents.begin(), constituents.end());
+
+			writeInstruction(m_declarations, spv::OpConstantComposite, operands);
+
+			m_constantIds[key] = result.id;
+			m_compositeConstants.emplace(result.id);
+		}
+	}
+	else
+	{
+		result.id = writeResult(spv::OpCompositeConstruct, typeId, constituents);
+	}
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::extract(const Value& value, const std::vector<uint32_t>& indices, const AstType& type)
+{
+	const auto source = load(value);
+
+	std::vector<uint32_t> operands = { source.id };
+	operands.insert(operands.end(), indices.begin(), indices.end());
+
+	Value result;
+	result.type = type;
+	result.id = writeResult(spv::OpCompositeExtract, getTypeId(type), operands);
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::construct(const AstType& type, const std::vector<Value>& arguments)
+{
+	std::vector<Value> values;
+	values.reserve(arguments.size());
+
+	for (const auto& argument : arguments)
+		values.emplace_back(load(argument));
+
+	if (type.is<AstPrimitiveType>())
+	{
+		if (values.size() != 1 || !isNumeric(values[0].type))
+			ATEMA_ERROR("Scalar constructor expects 1 scalar or vector argument");
+
+		auto value = values[0];
+
+		if (value.type.is<AstVectorType>())
+			value = extract(value, { 0 }, getPrimitiveType(value.type));
+
+		return convert(value, type.get<AstPrimitiveType>());
+	}
+	else if (type.is<AstVectorType>())
+	{
+		const auto& vectorType = type.get<AstVectorType>();
+
+		if (values.size() == 1 && values[0].type.is<AstPrimitiveType>())
+			return splat(convert(values[0], vectorType.primitiveType), vectorType.componentCount);
+
+		// Vector truncation
+		if (values.size() == 1 && values[0].type.is<AstVectorType>() && getComponentCount(values[0].type) > vectorType.componentCount)
+		{
+			std::vector<uint32_t> components;
+
+			for (uint32_t i = 0; i < vectorType.componentCount; i++)
+				components.emplace_back(i);
+
+			return swizzle(convert(values[0], vectorType.primitiveType), components);
+		}
+
+		// Vectors are concatenated
+		std::vector<uint32_t> constituents;
+		size_t componentCount = 0;
+
+		for (const auto& value : values)
+		{
+			if (!isNumeric(value.type))
+				ATEMA_ERROR("Vector constructor expects scalar or vector arguments");
+
+			constituents.emplace_back(convert(value, vectorType.primitiveType).id);
+
+			componentCount += getComponentCount(value.type);
+		}
+
+		if (componentCount != vectorType.componentCount)
+			ATEMA_ERROR("Vector constructor arguments don't match the component count");
+
+		return composite(type, constituents);
+	}
+	else if (type.is<AstMatrixType>())
+	{
+		const auto& matrixType = type.get<AstMatrixType>();
+
+		const AstType columnType = AstVectorType{ AstPrimitiveType::Float, matrixType.rowCount };
+
+		const auto zero = getFloatConstantId(0.0f);
+		const auto one = getFloatConstantId(1.0f);
+
+		std::vector<uint32_t> columns;
+
+		// Diagonal matrix
+		if (values.size() == 1 && values[0].type.is<AstPrimitiveType>())
+		{
+			const auto diagonal = convert(values[0], AstPrimitiveType::Float).id;
+
+			for (uint32_t column = 0; column < matrixType.columnCount; column++)
+			{
+				std::vector<uint32_t> components;
+
+				for (uint32_t row = 0; row < matrixType.rowCount; row++)
+					components.emplace_back(row == column ? diagonal : zero);
+
+				columns.emplace_back(composite(columnType, components).id);
+			}
+		}
+		// Matrix resize : missing components are taken from the identity
+		else if (values.size() == 1 && values[0].type.is<AstMatrixType>())
+		{
+			const auto& sourceType = values[0].type.get<AstMatrixType>();
+			const AstType sourceColumnType = AstVectorType{ AstPrimitiveType::Float, sourceType.rowCount };
+
+			for (uint32_t column = 0; column < matrixType.columnCount; column++)
+			{
+				std::vector<uint32_t> components;
+
+				if (column < sourceType.columnCount)
+				{
+					const auto sourceColumn = extract(values[0], { column }, sourceColumnType);
+
+					for (uint32_t row = 0; row < matrixType.rowCount; row++)
+					{
+						if (row < sourceType.rowCount)
+							components.emplace_back(extract(sourceColumn, { row }, AstPrimitiveType::Float).id);
+						else
+							components.emplace_back(row == column ? one : zero);
+					}
+				}
+				else
+				{
+					for (uint32_t row = 0; row < matrixType.rowCount; row++)
+						components.emplace_back(row == column ? one : zero);
+				}
+
+				columns.emplace_back(composite(columnType, components).id);
+			}
+		}
+		else
+		{
+			bool isColumnList = values.size() == matrixType.columnCount;
+
+			for (const auto& value : values)
+			{
+				if (!value.type.is<AstVectorType>() || getComponentCount(value.type) != matrixType.rowCount)
+				{
+					isColumnList = false;
+					break;
+				}
+			}
+
+			if (isColumnList)
+			{
+				for (const auto& value : values)
+					columns.emplace_back(convert(value, AstPrimitiveType::Float).id);
+			}
+			// Column major list of scalars & vectors
+			else
+			{
+				std::vector<uint32_t> components;
+
+				for (const auto& value : values)
+				{
+					if (!isNumeric(value.type))
+						ATEMA_ERROR("Matrix constructor expects scalar, vector or matrix arguments");
+
+					const auto floatValue = convert(value, AstPrimitiveType::Float);
+
+					if (floatValue.type.is<AstVectorType>())
+					{
+						for (uint32_t i = 0; i < getComponentCount(floatValue.type); i++)
+							components.emplace_back(extract(floatValue, { i }, AstPrimitiveType::Float).id);
+					}
+					else
+					{
+						components.emplace_back(floatValue.id);
+					}
+				}
+
+				if (components.size() != matrixType.rowCount * matrixType.columnCount)
+					ATEMA_ERROR("Matrix constructor arguments don't match the component count");
+
+				for (size_t column = 0; column < matrixType.columnCount; column++)
+				{
+					const auto begin = components.begin() + column * matrixType.rowCount;
+
+					columns.emplace_back(composite(columnType, std::vector<uint32_t>(begin, begin + matrixType.rowCount)).id);
+				}
+			}
+		}
+
+		return composite(type, columns);
+	}
+	else if (type.is<AstStructType>())
+	{
+		const auto& structData = getStruct(type.get<AstStructType>().name);
+
+		if (values.size() != structData.members.size())
+			ATEMA_ERROR("Struct constructor arguments don't match the members");
+
+		std::vector<uint32_t> constituents;
+
+		for (size_t i = 0; i < values.size(); i++)
+			constituents.emplace_back(convert(values[i], structData.members[i].type).id);
+
+		return composite(type, constituents);
+	}
+	else if (type.is<AstArrayType>())
+	{
+		auto arrayType = type.get<AstArrayType>();
+
+		if (arrayType.sizeType == AstArrayType::SizeType::Implicit)
+		{
+			arrayType.sizeType = AstArrayType::SizeType::Constant;
+			arrayType.size = values.size();
+		}
+
+		if (values.size() != getArraySize(arrayType))
+			ATEMA_ERROR("Array constructor arguments don't match the array size");
+
+		const auto elementType = getType(arrayType.componentType);
+
+		std::vector<uint32_t> constituents;
+
+		for (const auto& value : values)
+			constituents.emplace_back(convert(value, elementType).id);
+
+		return composite(arrayType, constituents);
+	}
+
+	ATEMA_ERROR("Invalid constructor type");
+
+	return Value();
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::access(const Value& value, size_t index, uint32_t indexId, const AstType& type)
+{
+	// Swizzled pointers can't be accessed with an access chain
+	if (value.isPointer && value.components.empty())
+	{
+		const auto layout = getMemberLayout(value.layout);
+
+		if (!indexId)
+			indexId = getIntConstantId(static_cast<int32_t>(index));
+
+		Value result;
+		result.type = type;
+		result.layout = layout;
+		result.isPointer = true;
+		result.storageClass = value.storageClass;
+		result.id = writeResult(spv::OpAccessChain, getPointerTypeId(value.storageClass, getTypeId(type, layout)), { value.id, indexId });
+
+		return result;
+	}
+
+	const auto source = load(value);
+
+	if (!indexId)
+		return extract(source, { static_cast<uint32_t>(index) }, type);
+
+	if (source.type.is<AstVectorType>())
+	{
+		Value result;
+		result.type = type;
+		result.id = writeResult(spv::OpVectorExtractDynamic, getTypeId(type), { source.id, indexId });
+
+		return result;
+	}
+
+	// Dynamic indexing of other composites requires a variable
+	return load(access(createTemporary(source), 0, indexId, type));
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::accessMember(const Value& value, const std::string& identifier)
+{
+	if (value.type.is<AstStructType>())
+	{
+		const auto& structData = getStruct(value.type.get<AstStructType>().name);
+
+		for (size_t i = 0; i < structData.members.size(); i++)
+		{
+			if (structData.members[i].name == identifier)
+				return access(value, i, 0, structData.members[i].type);
+		}
+
+		ATEMA_ERROR("Struct '" + value.type.get<AstStructType>().name + "' has no member '" + identifier + "'");
+	}
+	else if (isNumeric(value.type))
+	{
+		// Vector components are parsed as identifiers
+		const auto components = getSwizzleComponents(identifier);
+
+		if (!components.empty())
+			return swizzle(value, components);
+	}
+
+	ATEMA_ERROR("Invalid member '" + identifier + "'");
+
+	return Value();
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::accessIndex(const Value& value, const Value& index)
+{
+	const auto indexValue = load(index);
+
+	if (!indexValue.type.is<AstPrimitiveType>() || (getPrimitiveType(indexValue.type) != AstPrimitiveType::Int && getPrimitiveType(indexValue.type) != AstPrimitiveType::UInt))
+		ATEMA_ERROR("Index must be an integer");
+
+	AstType elementType;
+
+	if (value.type.is<AstArrayType>())
+		elementType = getType(value.type.get<AstArrayType>().componentType);
+	else if (value.type.is<AstVectorType>())
+		elementType = value.type.get<AstVectorType>().primitiveType;
+	else if (value.type.is<AstMatrixType>())
+		elementType = AstVectorType{ AstPrimitiveType::Float, value.type.get<AstMatrixType>().rowCount };
+	else
+		ATEMA_ERROR("Only arrays, vectors & matrices can be indexed");
+
+	// Constant indices can be used as literals
+	const auto constantIt = m_scalarConstants.find(indexValue.id);
+
+	if (constantIt != m_scalarConstants.end() && !value.isPointer)
+	{
+		const auto& constant = constantIt->second;
+
+		const auto constantIndex = constant.is<int32_t>() ? static_cast<size_t>(constant.get<int32_t>()) : static_cast<size_t>(constant.get<uint32_t>());
+
+		return access(value, constantIndex, 0, elementType);
+	}
+
+	return access(value, 0, indexValue.id, elementType);
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::swizzle(const Value& value, const std::vector<uint32_t>& components)
+{
+	const auto primitiveType = getPrimitiveType(value.type);
+	const auto componentCount = getComponentCount(value.type);
+
+	for (const auto& component : components)
+	{
+		if (component >= componentCount)
+			ATEMA_ERROR("Invalid swizzle component");
+	}
+
+	// Scalars only have one component
+	if (value.type.is<AstPrimitiveType>())
+		return splat(load(value), components.size());
+
+	const auto type = getNumericType(primitiveType, components.size());
+
+	if (value.isPointer)
+	{
+		Value base = value;
+		std::vector<uint32_t> baseComponents = components;
+
+		// Swizzle of a swizzle
+		if (!value.components.empty())
+		{
+			for (auto& component : baseComponents)
+				component = value.components[component];
+
+			base.type = getNumericType(primitiveType, value.vectorSize);
+			base.components.clear();
+			base.vectorSize = 0;
+		}
+
+		if (baseComponents.size() == 1)
+			return access(base, baseComponents[0], 0, type);
+
+		Value result = base;
+		result.type = type;
+		result.components = baseComponents;
+		result.vectorSize = getComponentCount(base.type);
+
+		return result;
+	}
+
+	if (components.size() == 1)
+		return extract(value, { components[0] }, type);
+
+	std::vector<uint32_t> operands = { value.id, value.id };
+	operands.insert(operands.end(), components.begin(), components.end());
+
+	Value result;
+	result.type = type;
+	result.id = writeResult(spv::OpVectorShuffle, getTypeId(type), operands);
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::arithmetic(BinaryOperator op, Value left, Value right)
+{
+	left = load(left);
+	right = load(right);
+
+	if (left.type.is<AstMatrixType>() || right.type.is<AstMatrixType>())
+		return matrixArithmetic(op, left, right);
+
+	if (!isNumeric(left.type) || !isNumeric(right.type))
+		ATEMA_ERROR("Arithmetic operands must be scalars or vectors");
+
+	const auto primitiveType = getCommonPrimitiveType(getPrimitiveType(left.type), getPrimitiveType(right.type));
+
+	if (primitiveType == AstPrimitiveType::Bool)
+		ATEMA_ERROR("Arithmetic operands can't be booleans");
+
+	left = convert(left, primitiveType);
+	right = convert(right, primitiveType);
+
+	const auto leftCount = getComponentCount(left.type);
+	const auto rightCount = getComponentCount(right.type);
+
+	if (leftCount != rightCount && leftCount != 1 && rightCount != 1)
+		ATEMA_ERROR("Arithmetic operands must have the same component count");
+
+	Value result;
+	result.type = getNumericType(primitiveType, std::max(leftCount, rightCount));
+
+	const auto typeId = getTypeId(result.type);
+
+	if (leftCount != rightCount)
+	{
+		// Dedicated instruction for float vectors scaling
+		if (op == BinaryOperator::Multiply && primitiveType == AstPrimitiveType::Float)
+		{
+			if (leftCount == 1)
+				std::swap(left, right);
+
+			result.id = writeResult(spv::OpVectorTimesScalar, typeId, { left.id, right.id });
+
+			return result;
+		}
+
+		if (leftCount == 1)
+			left = splat(left, rightCount);
+		else
+			right = splat(right, leftCount);
+	}
+
+	const bool isFloat = primitiveType == AstPrimitiveType::Float;
+	const bool isSigned = primitiveType == AstPrimitiveType::Int;
+
+	uint32_t opCode = 0;
+
+	switch (op)
+	{
+		case BinaryOperator::Add:
+		{
+			opCode = isFloat ? spv::OpFAdd : spv::OpIAdd;
+			break;
+		}
+		case BinaryOperator::Subtract:
+		{
+			opCode = isFloat ? spv::OpFSub : spv::OpISub;
+			break;
+		}
+		case BinaryOperator::Multiply:
+		{
+			opCode = isFloat ? spv::OpFMul : spv::OpIMul;
+			break;
+		}
+		case BinaryOperator::Divide:
+		{
+			opCode = isFloat ? spv::OpFDiv : (isSigned ? spv::OpSDiv : spv::OpUDiv);
+			break;
+		}
+		case BinaryOperator::Modulo:
+		{
+			opCode = isFloat ? spv::OpFMod : (isSigned ? spv::OpSMod : spv::OpUMod);
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid arithmetic operator");
+		}
+	}
+
+	result.id = writeResult(opCode, typeId, { left.id, right.id });
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::matrixArithmetic(BinaryOperator op, Value left, Value right)
+{
+	left = load(left);
+	right = load(right);
+
+	if (!left.type.is<AstMatrixType>() && getPrimitiveType(left.type) != AstPrimitiveType::Float)
+		left = convert(left, AstPrimitiveType::Float);
+
+	if (!right.type.is<AstMatrixType>() && getPrimitiveType(right.type) != AstPrimitiveType::Float)
+		right = convert(right, AstPrimitiveType::Float);
+
+	Value result;
+
+	if (op == BinaryOperator::Multiply)
+	{
+		if (left.type.is<AstMatrixType>() && right.type.is<AstMatrixType>())
+		{
+			const auto& leftType = left.type.get<AstMatrixType>();
+			const auto& rightType = right.type.get<AstMatrixType>();
+
+			if (leftType.columnCount != rightType.rowCount)
+				ATEMA_ERROR("Matrix dimensions don't match");
+
+			result.type = AstMatrixType{ AstPrimitiveType::Float, leftType.rowCount, rightType.columnCount };
+			result.id = writeResult(spv::OpMatrixTimesMatrix, getTypeId(result.type), { left.id, right.id });
+		}
+		else if (left.type.is<AstMatrixType>() && right.type.is<AstVectorType>())
+		{
+			const auto& matrixType = left.type.get<AstMatrixType>();
+
+			if (matrixType.columnCount != getComponentCount(right.type))
+				ATEMA_ERROR("Matrix & vector dimensions don't match");
+
+			result.type = AstVectorType{ AstPrimitiveType::Float, matrixType.rowCount };
+			result.id = writeResult(spv::OpMatrixTimesVector, getTypeId(result.type), { left.id, right.id });
+		}
+		else if (left.type.is<AstVectorType>() && right.type.is<AstMatrixType>())
+		{
+			const auto& matrixType = right.type.get<AstMatrixType>();
+
+			if (matrixType.rowCount != getComponentCount(left.type))
+				ATEMA_ERROR("Vector & matrix dimensions don't match");
+
+			result.type = AstVectorType{ AstPrimitiveType::Float, matrixType.columnCount };
+			result.id = writeResult(spv::OpVectorTimesMatrix, getTypeId(result.type), { left.id, right.id });
+		}
+		else
+		{
+			if (!left.type.is<AstMatrixType>())
+				std::swap(left, right);
+
+			if (!right.type.is<AstPrimitiveType>())
+				ATEMA_ERROR("Invalid matrix multiplication operand");
+
+			result.type = left.type;
+			result.id = writeResult(spv::OpMatrixTimesScalar, getTypeId(result.type), { left.id, right.id });
+		}
+
+		return result;
+	}
+
+	uint32_t opCode = 0;
+
+	switch (op)
+	{
+		case BinaryOperator::Add:
+		{
+			opCode = spv::OpFAdd;
+			break;
+		}
+		case BinaryOperator::Subtract:
+		{
+			opCode = spv::OpFSub;
+			break;
+		}
+		case BinaryOperator::Divide:
+		{
+			opCode = spv::OpFDiv;
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid matrix operator");
+		}
+	}
+
+	// Component-wise operations are applied on each column
+	const bool isLeftMatrix = left.type.is<AstMatrixType>();
+	const auto& matrixType = isLeftMatrix ? left.type.get<AstMatrixType>() : right.type.get<AstMatrixType>();
+
+	const AstType columnType = AstVectorType{ AstPrimitiveType::Float, matrixType.rowCount };
+	const auto columnTypeId = getTypeId(columnType);
+
+	const auto getColumn = [&](const Value& value, uint32_t column)
+	{
+		if (value.type.is<AstMatrixType>())
+		{
+			if (!isSameType(value.type, matrixType))
+				ATEMA_ERROR("Matrix dimensions don't match");
+
+			return extract(value, { column }, columnType).id;
+		}
+
+		if (!value.type.is<AstPrimitiveType>())
+			ATEMA_ERROR("Invalid matrix operand");
+
+		return splat(value, matrixType.rowCount).id;
+	};
+
+	std::vector<uint32_t> columns;
+
+	for (uint32_t column = 0; column < matrixType.columnCount; column++)
+		columns.emplace_back(writeResult(opCode, columnTypeId, { getColumn(left, column), getColumn(right, column) }));
+
+	return composite(matrixType, columns);
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::comparison(BinaryOperator op, Value left, Value right)
+{
+	left = load(left);
+	right = load(right);
+
+	if (!isNumeric(left.type) || !isNumeric(right.type))
+		ATEMA_ERROR("Comparison operands must be scalars or vectors");
+
+	const auto leftPrimitiveType = getPrimitiveType(left.type);
+	const auto rightPrimitiveType = getPrimitiveType(right.type);
+
+	AstPrimitiveType primitiveType = leftPrimitiveType;
+
+	if (leftPrimitiveType == AstPrimitiveType::Bool || rightPrimitiveType == AstPrimitiveType::Bool)
+	{
+		if (leftPrimitiveType != rightPrimitiveType)
+			ATEMA_ERROR("Booleans can only be compared to booleans");
+
+		if (op != BinaryOperator::Equal && op != BinaryOperator::NotEqual)
+			ATEMA_ERROR("Booleans can only be compared for equality");
+	}
+	else
+	{
+		primitiveType = getCommonPrimitiveType(leftPrimitiveType, rightPrimitiveType);
+
+		left = convert(left, primitiveType);
+		right = convert(right, primitiveType);
+	}
+
+	const auto leftCount = getComponentCount(left.type);
+	const auto rightCount = getComponentCount(right.type);
+
+	if (leftCount != rightCount)
+	{
+		if (leftCount == 1)
+			left = splat(left, rightCount);
+		else if (rightCount == 1)
+			right = splat(right, leftCount);
+		else
+			ATEMA_ERROR("Comparison operands must have the same component count");
+	}
+
+	uint32_t opCode = 0;
+
+	switch (primitiveType)
+	{
+		case AstPrimitiveType::Bool:
+		{
+			opCode = op == BinaryOperator::Equal ? spv::OpLogicalEqual : spv::OpLogicalNotEqual;
+			break;
+		}
+		case AstPrimitiveType::Int:
+		case AstPrimitiveType::UInt:
+		{
+			const bool isSigned = primitiveType == AstPrimitiveType::Int;
+
+			switch (op)
+			{
+				case BinaryOperator::Less: opCode = isSigned ? spv::OpSLessThan : spv::OpULessThan; break;
+				case BinaryOperator::Greater: opCode = isSigned ? spv::OpSGreaterThan : spv::OpUGreaterThan; break;
+				case BinaryOperator::Equal: opCode = spv::OpIEqual; break;
+				case BinaryOperator::NotEqual: opCode = spv::OpINotEqual; break;
+				case BinaryOperator::LessOrEqual: opCode = isSigned ? spv::OpSLessThanEqual : spv::OpULessThanEqual; break;
+				case BinaryOperator::GreaterOrEqual: opCode = isSigned ? spv::OpSGreaterThanEqual : spv::OpUGreaterThanEqual; break;
+				default:
+				{
+					ATEMA_ERROR("Invalid comparison operator");
+				}
+			}
+
+			break;
+		}
+		case AstPrimitiveType::Float:
+		{
+			switch (op)
+			{
+				case BinaryOperator::Less: opCode = spv::OpFOrdLessThan; break;
+				case BinaryOperator::Greater: opCode = spv::OpFOrdGreaterThan; break;
+				case BinaryOperator::Equal: opCode = spv::OpFOrdEqual; break;
+				// GLSL : NaN != x is true
+				case BinaryOperator::NotEqual: opCode = spv::OpFUnordNotEqual; break;
+				case BinaryOperator::LessOrEqual: opCode = spv::OpFOrdLessThanEqual; break;
+				case BinaryOperator::GreaterOrEqual: opCode = spv::OpFOrdGreaterThanEqual; break;
+				default:
+				{
+					ATEMA_ERROR("Invalid comparison operator");
+				}
+			}
+
+			break;
+		}
+		default:
+		{
+			ATEMA_ERROR("Invalid primitive type");
+		}
+	}
+
+	Value result;
+	result.type = getNumericType(AstPrimitiveType::Bool, std::max(leftCount, rightCount));
+	result.id = writeResult(opCode, getTypeId(result.type), { left.id, right.id });
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::bitwise(BinaryOperator op, Value left, Value right)
+{
+	left = load(left);
+	right = load(right);
+
+	if (!isNumeric(left.type) || !isNumeric(right.type))
+		ATEMA_ERROR("Bitwise operands must be scalars or vectors");
+
+	const auto leftPrimitiveType = getPrimitiveType(left.type);
+	const auto rightPrimitiveType = getPrimitiveType(right.type);
+
+	const auto isInteger = [](AstPrimitiveType type)
+	{
+		return type == AstPrimitiveType::Int || type == AstPrimitiveType::UInt;
+	};
+
+	if (!isInteger(leftPrimitiveType) || !isInteger(rightPrimitiveType))
+		ATEMA_ERROR("Bitwise operands must be integers");
+
+	const bool isShift = op == BinaryOperator::BitwiseLeftShift || op == BinaryOperator::BitwiseRightShift;
+
+	// Shift operands may have different types, the result has the type of the base
+	const auto primitiveType = isShift ? leftPrimitiveType : getCommonPrimitiveType(leftPrimitiveType, rightPrimitiveType);
+
+	if (!isShift)
+	{
+		left = convert(left, primitiveType);
+		right = convert(right, primitiveType);
+	}
+
+	const auto leftCount = getComponentCount(left.type);
+	const auto rightCount = getComponentCount(right.type);
+
+	if (leftCount != rightCount)
+	{
+		if (leftCount == 1 && !isShift)
+			left = splat(left, rightCount);
+		else if (rightCount == 1)
+			right = splat(right, leftCount);
+		else
+			ATEMA_ERROR("Bitwise operands must have the same component count");
+	}
+
+	uint32_t opCode = 0;
+
+	switch (op)
+	{
+		case BinaryOperator::BitwiseAnd: opCode = spv::OpBitwiseAnd; break;
+		case BinaryOperator::BitwiseOr: opCode = spv::OpBitwiseOr; break;
+		case BinaryOperator::BitwiseXor: opCode = spv::OpBitwiseXor; break;
+		case BinaryOperator::BitwiseLeftShift: opCode = spv::OpShiftLeftLogical; break;
+		case BinaryOperator::BitwiseRightShift: opCode = primitiveType == AstPrimitiveType::Int ? spv::OpShiftRightArithmetic : spv::OpShiftRightLogical; break;
+		default:
+		{
+			ATEMA_ERROR("Invalid bitwise operator");
+		}
+	}
+
+	Value result;
+	result.type = getNumericType(primitiveType, getComponentCount(left.type));
+	result.id = writeResult(opCode, getTypeId(result.type), { left.id, right.id });
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::logical(BinaryOperator op, const Expression& left, const Expression& right)
+{
+	const bool isAnd = op == BinaryOperator::And;
+
+	const auto leftId = evaluateBool(left);
+	const auto boolTypeId = getTypeId(AstPrimitiveType::Bool);
+
+	Value result;
+	result.type = AstPrimitiveType::Bool;
+
+	// Both operands can be evaluated without branching
+	if (!hasSideEffects(right))
+	{
+		const auto rightId = evaluateBool(right);
+
+		result.id = writeResult(isAnd ? spv::OpLogicalAnd : spv::OpLogicalOr, boolTypeId, { leftId, rightId });
+
+		return result;
+	}
+
+	// Short-circuit evaluation
+	const auto leftLabel = m_function->currentLabel;
+	const auto rightLabel = createId();
+	const auto mergeLabel = createId();
+
+	write(spv::OpSelectionMerge, { mergeLabel, 0 });
+
+	if (isAnd)
+		writeTerminator(spv::OpBranchConditional, { leftId, rightLabel, mergeLabel });
+	else
+		writeTerminator(spv::OpBranchConditional, { leftId, mergeLabel, rightLabel });
+
+	beginBlock(rightLabel);
+
+	const auto rightId = evaluateBool(right);
+	const auto rightEndLabel = m_function->currentLabel;
+
+	writeBranch(mergeLabel);
+
+	beginBlock(mergeLabel);
+
+	result.id = writeResult(spv::OpPhi, boolTypeId, { getBoolConstantId(!isAnd), leftLabel, rightId, rightEndLabel });
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::select(uint32_t condition, const Expression& trueExpression, const Expression& falseExpression)
+{
+	// Both values can be evaluated without branching
+	if (!hasSideEffects(trueExpression) && !hasSideEffects(falseExpression))
+	{
+		auto trueValue = evaluateValue(trueExpression);
+		auto falseValue = evaluateValue(falseExpression);
+
+		if (isNumeric(trueValue.type) && isNumeric(falseValue.type))
+		{
+			const auto trueCount = getComponentCount(trueValue.type);
+			const auto falseCount = getComponentCount(falseValue.type);
+
+			const auto trueType = getPrimitiveType(trueValue.type);
+			const auto falseType = getPrimitiveType(falseValue.type);
+
+			const auto primitiveType = (trueType == AstPrimitiveType::Bool || falseType == AstPrimitiveType::Bool) ? trueType : getCommonPrimitiveType(trueType, falseType);
+
+			const auto type = getNumericType(primitiveType, std::max(trueCount, falseCount));
+
+			trueValue = convert(trueValue, type);
+			falseValue = convert(falseValue, type);
+
+			// SPIR-V 1.0 requires a condition component for each value component
+			const auto conditionId = splat(Value{ AstPrimitiveType::Bool, condition }, getComponentCount(type)).id;
+
+			Value result;
+			result.type = type;
+			result.id = writeResult(spv::OpSelect, getTypeId(type), { conditionId, trueValue.id, falseValue.id });
+
+			return result;
+		}
+
+		// Composites can't be selected before SPIR-V 1.4
+		const auto variable = createVariable("", trueValue.type, spv::StorageClassFunction);
+
+		const auto trueLabel = createId();
+		const auto falseLabel = createId();
+		const auto mergeLabel = createId();
+
+		write(spv::OpSelectionMerge, { mergeLabel, 0 });
+		writeTerminator(spv::OpBranchConditional, { condition, trueLabel, falseLabel });
+
+		beginBlock(trueLabel);
+		store(variable, trueValue);
+		writeBranch(mergeLabel);
+
+		beginBlock(falseLabel);
+		store(variable, falseValue);
+		writeBranch(mergeLabel);
+
+		beginBlock(mergeLabel);
+
+		return load(variable);
+	}
+
+	// Only the selected value must be evaluated : its type is given by the first one
+	const auto trueLabel = createId();
+	const auto falseLabel = createId();
+	const auto mergeLabel = createId();
+
+	write(spv::OpSelectionMerge, { mergeLabel, 0 });
+	writeTerminator(spv::OpBranchConditional, { condition, trueLabel, falseLabel });
+
+	beginBlock(trueLabel);
+
+	const auto trueValue = evaluateValue(trueExpression);
+	const auto trueEndLabel = m_function->currentLabel;
+
+	writeBranch(mergeLabel);
+
+	beginBlock(falseLabel);
+
+	const auto falseValue = convert(evaluateValue(falseExpression), trueValue.type);
+	const auto falseEndLabel = m_function->currentLabel;
+
+	writeBranch(mergeLabel);
+
+	beginBlock(mergeLabel);
+
+	Value result;
+	result.type = trueValue.type;
+	result.id = writeResult(spv::OpPhi, getTypeId(result.type), { trueValue.id, trueEndLabel, falseValue.id, falseEndLabel });
+
+	return result;
+}
+
+SpirvShaderWriter::FunctionData& SpirvShaderWriter::declareFunction(const FunctionDeclarationStatement& statement)
+{
+	if (m_isInFunction)
+		ATEMA_ERROR("Functions can't be declared inside other functions");
+
+	const auto returnType = resolveType(statement.returnType);
+
+	std::vector<AstType> argumentTypes;
+	argumentTypes.reserve(statement.arguments.size());
+
+	for (const auto& argument : statement.arguments)
+		argumentTypes.emplace_back(resolveType(argument.type));
+
+	auto& overloads = m_functions[statement.name];
+
+	for (auto& function : overloads)
+	{
+		if (function.argumentTypes.size() != argumentTypes.size())
+			continue;
+
+		bool isSameSignature = true;
+
+		for (size_t i = 0; i < argumentTypes.size(); i++)
+		{
+			if (!isSameType(function.argumentTypes[i], argumentTypes[i]))
+			{
+				isSameSignature = false;
+				break;
+			}
+		}
+
+		if (isSameSignature)
+		{
+			if (!isSameType(function.returnType, returnType))
+				ATEMA_ERROR("Function '" + statement.name + "' is declared with different return types");
+
+			return function;
+		}
+	}
+
+	auto& function = overloads.emplace_back();
+	function.id = createId();
+	function.returnType = returnType;
+	function.argumentTypes = std::move(argumentTypes);
+
+	return function;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::callFunction(const std::string& name, const std::vector<Value>& arguments)
+{
+	// User defined functions
+	const auto functionIt = m_functions.find(name);
+
+	if (functionIt != m_functions.end())
+	{
+		// Implicit conversions are allowed if no overload matches exactly
+		const auto getScore = [&](const FunctionData& function) -> int
+		{
+			if (function.argumentTypes.size() != arguments.size())
+				return -1;
+
+			int score = 0;
+
+			for (size_t i = 0; i < arguments.size(); i++)
+			{
+				const auto& argumentType = arguments[i].type;
+				const auto& parameterType = function.argumentTypes[i];
+
+				if (isSameType(argumentType, parameterType))
+					continue;
+
+				if (!isNumeric(argumentType) || !isNumeric(parameterType) || getComponentCount(argumentType) != getComponentCount(parameterType))
+					return -1;
+
+				const auto argumentPrimitiveType = getPrimitiveType(argumentType);
+				const auto parameterPrimitiveType = getPrimitiveType(parameterType);
+
+				if (argumentPrimitiveType == AstPrimitiveType::Bool || getCommonPrimitiveType(argumentPrimitiveType, parameterPrimitiveType) != parameterPrimitiveType)
+					return -1;
+
+				score++;
+			}
+
+			return score;
+		};
+
+		FunctionData* function = nullptr;
+		int bestScore = -1;
+
+		for (auto& overload : functionIt->second)
+		{
+			const auto score = getScore(overload);
+
+			if (score >= 0 && (bestScore < 0 || score < bestScore))
+			{
+				function = &overload;
+				bestScore = score;
+			}
+		}
+
+		if (!function)
+			ATEMA_ERROR("No overload of function '" + name + "' matches the arguments");
+
+		function->isCalled = true;
+
+		std::vector<uint32_t> operands = { function->id };
+
+		for (size_t i = 0; i < arguments.size(); i++)
+		{
+			const auto& parameterType = function->argumentTypes[i];
+
+			// Samplers & images are passed by pointer
+			if (isOpaque(parameterType))
+			{
+				if (!arguments[i].isPointer || arguments[i].storageClass != spv::StorageClassUniformConstant)
+					ATEMA_ERROR("Sampler & image arguments must be external variables");
+
+				operands.emplace_back(arguments[i].id);
+			}
+			else
+			{
+				operands.emplace_back(convert(arguments[i], parameterType).id);
+			}
+		}
+
+		Value result;
+		result.type = function->returnType;
+		result.id = writeResult(spv::OpFunctionCall, getTypeId(function->returnType), operands);
+
+		return result;
+	}
+
+	// Constructors
+	if (m_structs.find(name) != m_structs.end())
+		return construct(AstStructType{ name }, arguments);
+
+	const auto glslType = getGlslType(name);
+
+	if (glslType.has_value())
+		return construct(glslType.value(), arguments);
+
+	return callBuiltInFunction(name, arguments);
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::callBuiltInFunction(const std::string& name, const std::vector<Value>& arguments)
+{
+	const auto componentWiseIt = s_componentWiseFunctions.find(name);
+
+	if (componentWiseIt != s_componentWiseFunctions.end())
+	{
+		const auto& function = componentWiseIt->second;
+
+		return callComponentWise(name, arguments, function.floatInstruction, function.intInstruction, function.uintInstruction);
+	}
+
+	if (name == "texture")
+		return sample(arguments, false);
+
+	if (name == "textureLod")
+		return sample(arguments, true);
+
+	if (name == "textureSize")
+		return querySize(arguments);
+
+	if (name == "imageLoad")
+		return readImage(arguments);
+
+	if (name == "imageStore")
+		return writeImage(arguments);
+
+	if (name == "barrier")
+	{
+		if (!arguments.empty())
+			ATEMA_ERROR("Function 'barrier' expects no argument");
+
+		if (m_stage != AstShaderStage::Compute)
+			ATEMA_ERROR("Barriers are only available in compute shaders");
+
+		// Same semantics as GLSL : waits for the whole workgroup and makes shared memory writes visible
+		const auto scopeId = getUIntConstantId(spv::ScopeWorkgroup);
+		const auto semanticsId = getUIntConstantId(spv::MemorySemanticsAcquireRelease | spv::MemorySemanticsWorkgroupMemory);
+
+		write(spv::OpControlBarrier, { scopeId, scopeId, semanticsId });
+
+		Value result;
+		result.type = AstVoidType();
+
+		return result;
+	}
+
+	if (name == "atan")
+	{
+		if (arguments.size() == 2)
+			return callComponentWise(name, arguments, glsl450::Atan2, 0, 0);
+
+		return callComponentWise(name, arguments, glsl450::Atan, 0, 0);
+	}
+
+	if (name == "mod")
+	{
+		if (arguments.size() != 2)
+			ATEMA_ERROR("Function 'mod' expects 2 arguments");
+
+		return arithmetic(BinaryOperator::Modulo, arguments[0], arguments[1]);
+	}
+
+	std::vector<Value> values;
+	values.reserve(arguments.size());
+
+	for (const auto& argument : arguments)
+		values.emplace_back(load(argument));
+
+	const auto checkArgumentCount = [&](size_t count)
+	{
+		if (values.size() != count)
+			ATEMA_ERROR("Function '" + name + "' expects " + std::to_string(count) + " argument(s)");
+	};
+
+	// Converts the arguments to float vectors of the same size
+	const auto getFloatArguments = [&]()
+	{
+		size_t componentCount = 1;
+
+		for (const auto& value : values)
+		{
+			if (!isNumeric(value.type))
+				ATEMA_ERROR("Function '" + name + "' expects scalar or vector arguments");
+
+			componentCount = std::max(componentCount, getComponentCount(value.type));
+		}
+
+		std::vector<Value> floatValues;
+
+		for (const auto& value : values)
+			floatValues.emplace_back(convert(value, getNumericType(AstPrimitiveType::Float, componentCount)));
+
+		return floatValues;
+	};
+
+	if (name == "length")
+	{
+		checkArgumentCount(1);
+
+		return callExtendedInstruction(AstPrimitiveType::Float, glsl450::Length, getFloatArguments());
+	}
+
+	if (name == "distance")
+	{
+		checkArgumentCount(2);
+
+		return callExtendedInstruction(AstPrimitiveType::Float, glsl450::Distance, getFloatArguments());
+	}
+
+	if (name == "dot")
+	{
+		checkArgumentCount(2);
+
+		const auto floatValues = getFloatArguments();
+
+		Value result;
+		result.type = AstPrimitiveType::Float;
+
+		if (floatValues[0].type.is<AstPrimitiveType>())
+			result.id = writeResult(spv::OpFMul, getTypeId(result.type), { floatValues[0].id, floatValues[1].id });
+		else
+			result.id = writeResult(spv::OpDot, getTypeId(result.type), { floatValues[0].id, floatValues[1].id });
+
+		return result;
+	}
+
+	if (name == "cross")
+	{
+		checkArgumentCount(2);
+
+		const auto floatValues = getFloatArguments();
+
+		if (getComponentCount(floatValues[0].type) != 3)
+			ATEMA_ERROR("Function 'cross' expects 3 components vectors");
+
+		return callExtendedInstruction(floatValues[0].type, glsl450::Cross, floatValues);
+	}
+
+	if (name == "normalize")
+	{
+		checkArgumentCount(1);
+
+		const auto floatValues = getFloatArguments();
+
+		return callExtendedInstruction(floatValues[0].type, glsl450::Normalize, floatValues);
+	}
+
+	if (name == "reflect")
+	{
+		checkArgumentCount(2);
+
+		const auto floatValues = getFloatArguments();
+
+		return callExtendedInstruction(floatValues[0].type, glsl450::Reflect, floatValues);
+	}
+
+	if (name == "faceforward")
+	{
+		checkArgumentCount(3);
+
+		const auto floatValues = getFloatArguments();
+
+		return callExtendedInstruction(floatValues[0].type, glsl450::FaceForward, floatValues);
+	}
+
+	if (name == "refract")
+	{
+		checkArgumentCount(3);
+
+		const auto eta = convert(values[2], AstPrimitiveType::Float);
+
+		values.pop_back();
+
+		auto floatValues = getFloatArguments();
+		floatValues.emplace_back(eta);
+
+		return callExtendedInstruction(floatValues[0].type, glsl450::Refract, floatValues);
+	}
+
+	if (name == "determinant" || name == "inverse" || name == "transpose")
+	{
+		checkArgumentCount(1);
+
+		if (!values[0].type.is<AstMatrixType>())
+			ATEMA_ERROR("Function '" + name + "' expects a matrix");
+
+		const auto& matrixType = values[0].type.get<AstMatrixType>();
+
+		if (name == "transpose")
+		{
+			Value result;
+			result.type = AstMatrixType{ AstPrimitiveType::Float, matrixType.columnCount, matrixType.rowCount };
+			result.id = writeResult(spv::OpTranspose, getTypeId(result.type), { values[0].id });
+
+			return result;
+		}
+
+		if (matrixType.rowCount != matrixType.columnCount)
+			ATEMA_ERROR("Function '" + name + "' expects a square matrix");
+
+		if (name == "determinant")
+			return callExtendedInstruction(AstPrimitiveType::Float, glsl450::Determinant, values);
+
+		return callExtendedInstruction(values[0].type, glsl450::MatrixInverse, values);
+	}
+
+	if (name == "any" || name == "all" || name == "not")
+	{
+		checkArgumentCount(1);
+
+		if (!values[0].type.is<AstVectorType>() || !isBool(values[0].type))
+			ATEMA_ERROR("Function '" + name + "' expects a boolean vector");
+
+		Value result;
+
+		if (name == "not")
+		{
+			result.type = values[0].type;
+			result.id = writeResult(spv::OpLogicalNot, getTypeId(result.type), { values[0].id });
+		}
+		else
+		{
+			result.type = AstPrimitiveType::Bool;
+			result.id = writeResult(name == "any" ? spv::OpAny : spv::OpAll, getTypeId(result.type), { values[0].id });
+		}
+
+		return result;
+	}
+
+	if (name == "lessThan" || name == "lessThanEqual" || name == "greaterThan" || name == "greaterThanEqual" || name == "equal" || name == "notEqual")
+	{
+		checkArgumentCount(2);
+
+		BinaryOperator op = BinaryOperator::Equal;
+
+		if (name == "lessThan")
+			op = BinaryOperator::Less;
+		else if (name == "lessThanEqual")
+			op = BinaryOperator::LessOrEqual;
+		else if (name == "greaterThan")
+			op = BinaryOperator::Greater;
+		else if (name == "greaterThanEqual")
+			op = BinaryOperator::GreaterOrEqual;
+		else if (name == "notEqual")
+			op = BinaryOperator::NotEqual;
+
+		return comparison(op, values[0], values[1]);
+	}
+
+	if (name == "dFdx" || name == "dFdy" || name == "fwidth")
+	{
+		checkArgumentCount(1);
+
+		if (m_stage != AstShaderStage::Fragment)
+			ATEMA_ERROR("Derivatives are only available in fragment shaders");
+
+		const auto floatValues = getFloatArguments();
+
+		uint32_t opCode = spv::OpFwidth;
+
+		if (name == "dFdx")
+			opCode = spv::OpDPdx;
+		else if (name == "dFdy")
+			opCode = spv::OpDPdy;
+
+		Value result;
+		result.type = floatValues[0].type;
+		result.id = writeResult(opCode, getTypeId(result.type), { floatValues[0].id });
+
+		return result;
+	}
+
+	ATEMA_ERROR("Function '" + name + "' is not defined");
+
+	return Value();
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::callComponentWise(const std::string& name, std::vector<Value> arguments, uint32_t floatInstruction, uint32_t intInstruction, uint32_t uintInstruction)
+{
+	if (arguments.empty())
+		ATEMA_ERROR("Function '" + name + "' expects arguments");
+
+	AstPrimitiveType primitiveType = AstPrimitiveType::Int;
+	size_t componentCount = 1;
+
+	for (auto& argument : arguments)
+	{
+		argument = load(argument);
+
+		if (!isNumeric(argument.type) || isBool(argument.type))
+			ATEMA_ERROR("Function '" + name + "' expects numeric scalar or vector arguments");
+
+		primitiveType = getCommonPrimitiveType(primitiveType, getPrimitiveType(argument.type));
+		componentCount = std::max(componentCount, getComponentCount(argument.type));
+	}
+
+	// Integer variants don't always exist
+	uint32_t instruction = floatInstruction;
+
+	if (primitiveType == AstPrimitiveType::Int && intInstruction)
+		instruction = intInstruction;
+	else if (primitiveType == AstPrimitiveType::UInt && uintInstruction)
+		instruction = uintInstruction;
+	else
+		primitiveType = AstPrimitiveType::Float;
+
+	const auto type = getNumericType(primitiveType, componentCount);
+
+	for (auto& argument : arguments)
+		argument = convert(argument, type);
+
+	return callExtendedInstruction(type, instruction, arguments);
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::callExtendedInstruction(const AstType& type, uint32_t instruction, const std::vector<Value>& arguments)
+{
+	std::vector<uint32_t> operands = { getGlslInstructionSetId(), instruction };
+
+	for (const auto& argument : arguments)
+		operands.emplace_back(load(argument).id);
+
+	Value result;
+	result.type = type;
+	result.id = writeResult(spv::OpExtInst, getTypeId(type), operands);
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::sample(const std::vector<Value>& arguments, bool explicitLod)
+{
+	if (arguments.size() < 2 || arguments.size() > 3)
+		ATEMA_ERROR("Texture sampling expects 2 or 3 arguments");
+
+	if (explicitLod && arguments.size() != 3)
+		ATEMA_ERROR("Explicit LOD sampling expects 3 arguments");
+
+	const auto sampler = load(arguments[0]);
+
+	if (!sampler.type.is<AstSamplerType>())
+		ATEMA_ERROR("First sampling argument must be a sampler");
+
+	const auto& samplerType = sampler.type.get<AstSamplerType>();
+
+	const auto coordinates = convert(arguments[1], AstPrimitiveType::Float);
+
+	Value result;
+	result.type = AstVectorType{ samplerType.primitiveType, 4 };
+
+	const auto typeId = getTypeId(result.type);
+
+	if (explicitLod)
+	{
+		const auto lod = convert(arguments[2], AstPrimitiveType::Float);
+
+		result.id = writeResult(spv::OpImageSampleExplicitLod, typeId, { sampler.id, coordinates.id, spv::ImageOperandsLod, lod.id });
+	}
+	// Implicit LOD is only available in fragment shaders
+	else if (m_stage != AstShaderStage::Fragment)
+	{
+		result.id = writeResult(spv::OpImageSampleExplicitLod, typeId, { sampler.id, coordinates.id, spv::ImageOperandsLod, getFloatConstantId(0.0f) });
+	}
+	else if (arguments.size() == 3)
+	{
+		const auto bias = convert(arguments[2], AstPrimitiveType::Float);
+
+		result.id = writeResult(spv::OpImageSampleImplicitLod, typeId, { sampler.id, coordinates.id, spv::ImageOperandsBias, bias.id });
+	}
+	else
+	{
+		result.id = writeResult(spv::OpImageSampleImplicitLod, typeId, { sampler.id, coordinates.id });
+	}
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::querySize(const std::vector<Value>& arguments)
+{
+	if (arguments.empty() || arguments.size() > 2)
+		ATEMA_ERROR("Texture size query expects 1 or 2 arguments");
+
+	const auto sampler = load(arguments[0]);
+
+	if (!sampler.type.is<AstSamplerType>())
+		ATEMA_ERROR("First texture size argument must be a sampler");
+
+	const auto& samplerType = sampler.type.get<AstSamplerType>();
+
+	size_t componentCount = 2;
+
+	switch (samplerType.imageType)
+	{
+		case AstImageType::Texture1D:
+		{
+			componentCount = 1;
+			break;
+		}
+		case AstImageType::Texture3D:
+		case AstImageType::TextureArray2D:
+		{
+			componentCount = 3;
+			break;
+		}
+		default:
+			break;
+	}
+
+	addCapability(spv::CapabilityImageQuery);
+
+	const auto imageId = writeResult(spv::OpImage, getImageTypeId(samplerType.imageType, samplerType.primitiveType), { sampler.id });
+
+	const auto lodId = arguments.size() == 2 ? convert(arguments[1], AstPrimitiveType::Int).id : getIntConstantId(0);
+
+	Value result;
+	result.type = getNumericType(AstPrimitiveType::Int, componentCount);
+	result.id = writeResult(spv::OpImageQuerySizeLod, getTypeId(result.type), { imageId, lodId });
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::readImage(const std::vector<Value>& arguments)
+{
+	if (arguments.size() != 2)
+		ATEMA_ERROR("Image load expects 2 arguments");
+
+	const auto image = load(arguments[0]);
+
+	if (!image.type.is<AstStorageImageType>())
+		ATEMA_ERROR("First image load argument must be an image");
+
+	const auto& imageType = image.type.get<AstStorageImageType>();
+
+	if (imageType.format == AstImageFormat::Unknown)
+		addCapability(spv::CapabilityStorageImageReadWithoutFormat);
+
+	const auto coordinates = convert(arguments[1], AstPrimitiveType::Int);
+
+	Value result;
+	result.type = AstVectorType{ imageType.primitiveType, 4 };
+	result.id = writeResult(spv::OpImageRead, getTypeId(result.type), { image.id, coordinates.id });
+
+	return result;
+}
+
+SpirvShaderWriter::Value SpirvShaderWriter::writeImage(const std::vector<Value>& arguments)
+{
+	if (arguments.size() != 3)
+		ATEMA_ERROR("Image store expects 3 arguments");
+
+	const auto image = load(arguments[0]);
+
+	if (!image.type.is<AstStorageImageType>())
+		ATEMA_ERROR("First image store argument must be an image");
+
+	const auto& imageType = image.type.get<AstStorageImageType>();
 
-	const auto intermediate = program.getIntermediate(eShLanguage);
+	if (imageType.format == AstImageFormat::Unknown)
+		addCapability(spv::CapabilityStorageImageWriteWithoutFormat);
 
-	spv::SpvBuildLogger logger;
+	const auto coordinates = convert(arguments[1], AstPrimitiveType::Int);
+	const auto texel = convert(arguments[2], AstVectorType{ imageType.primitiveType, 4 });
 
-	glslang::SpvOptions spvOptions;
+	write(spv::OpImageWrite, { image.id, coordinates.id, texel.id });
 
-	spvOptions.generateDebugInfo = true;
-	spvOptions.stripDebugInfo = true;
-	spvOptions.disableOptimizer = false;
-	spvOptions.optimizeSize = true;
-	spvOptions.disassemble = false;
-	spvOptions.validate = false;
-	glslang::GlslangToSpv(*intermediate, spirv, &logger, &spvOptions);
+	Value result;
+	result.type = AstVoidType();
 
-	glslang::FinalizeProcess();
+	return result;
 }
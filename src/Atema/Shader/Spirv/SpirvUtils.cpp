@@ -0,0 +1,85 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/Shader/Spirv/SpirvUtils.hpp>
+#include <Atema/Core/Hash.hpp>
+#include <Atema/Core/Timer.hpp>
+#include <Atema/Shader/Ast/AstSerializer.hpp>
+#include <Atema/Shader/Spirv/SpirvShaderCache.hpp>
+#include <Atema/Shader/Spirv/SpirvShaderWriter.hpp>
+
+using namespace at;
+
+namespace
+{
+	// Must change every time the writer output changes, so previously cached modules are not used anymore
+	constexpr const char* CompilerSettings = "native|SPIR-V1.0|1";
+
+	// The serialized AST is a canonical representation of the shader
+	// It contains the entry function, so the stage is part of the key too
+	Hash64 getCacheKey(const Statement& ast)
+	{
+		using CacheHasher = Hasher<FNV1a<Hash64>>;
+
+		AstSerializer serializer;
+		serializer.serialize(ast);
+
+		const auto& data = serializer.getData();
+
+		Hash64 key = FNV1a<Hash64>::hash(data.data(), data.size());
+
+		CacheHasher::hashCombine(key, CacheHasher::hash(CompilerSettings));
+
+		return key;
+	}
+
+	void compileSpirv(const Statement& ast, std::vector<uint32_t>& code)
+	{
+		SpirvShaderWriter writer;
+
+		ast.accept(writer);
+
+		writer.compile(code);
+	}
+}
+
+void spirv::compile(const Statement& ast, std::vector<uint32_t>& code)
+{
+	auto& cache = SpirvShaderCache::instance();
+
+	if (!cache.isEnabled())
+	{
+		compileSpirv(ast, code);
+
+		return;
+	}
+
+	const auto cacheKey = getCacheKey(ast);
+
+	if (cache.load(cacheKey, code))
+		return;
+
+	Timer timer;
+
+	compileSpirv(ast, code);
+
+	cache.save(cacheKey, code, timer.getStep());
+}
@@ -20,18 +20,58 @@
 */
 
 #include <Atema/Shader/UberShader.hpp>
+#include <Atema/Shader/Ast/AstCloner.hpp>
+#include <Atema/Shader/Ast/AstOptimizer.hpp>
 #include <Atema/Shader/Ast/AstPreprocessor.hpp>
 
+#include <algorithm>
+#include <map>
+
 using namespace at;
 
+namespace
+{
+	// Collects the identifiers the preprocessor may replace by an option value, and the included libraries
+	// Array sizes are not preprocessed, so types are ignored
+	class OptionDependencyCollector : public AstConstRecursiveVisitor
+	{
+	public:
+		using AstConstRecursiveVisitor::visit;
+
+		void visit(const OptionDeclarationStatement& statement) override
+		{
+			for (auto& variable : statement.variables)
+				identifiers.emplace(variable.name);
+
+			AstConstRecursiveVisitor::visit(statement);
+		}
+
+		void visit(const IncludeStatement& statement) override
+		{
+			for (auto& library : statement.libraries)
+				libraries.emplace_back(library);
+		}
+
+		void visit(const VariableExpression& expression) override
+		{
+			identifiers.emplace(expression.identifier);
+		}
+
+		std::unordered_set<std::string> identifiers;
+		std::vector<std::string> libraries;
+	};
+}
+
 UberShader::UberShader(const Ptr<SequenceStatement>& ast) :
 	m_ast(ast),
+	m_dependenciesReady(false),
 	m_extractorReady(false)
 {
 }
 
 UberShader::UberShader(UPtr<SequenceStatement>&& ast) :
 	m_ast(std::move(ast)),
+	m_dependenciesReady(false),
 	m_extractorReady(false)
 {
 }
@@ -55,25 +95,131 @@ Ptr<UberShader> UberShader::createInstance(const std::vector<Option>& options, c
 		astPreprocessor.setOption(option.name, option.value);
 	}
 
+	initializeDependencies();
+
 	// Initialize shaders
-	auto processedAst = astPreprocessor.process(*m_ast);
+	auto sequence = std::make_unique<SequenceStatement>();
+
+	AstCloner cloner;
+
+	for (size_t i = 0; i < m_ast->statements.size(); i++)
+	{
+		const auto& statement = *m_ast->statements[i];
+		const auto& dependencies = m_dependencies[i];
+
+		UPtr<Statement> processedStatement;
 
-	if (!processedAst)
+		// Includes must always be processed : libraries are only added once per instance
+		if (!dependencies.libraries.empty())
+		{
+			processedStatement = astPreprocessor.process(statement);
+		}
+		else
+		{
+			// Options may be declared by included libraries : get the current values
+			std::vector<std::optional<ConstantValue>> optionValues;
+			optionValues.reserve(dependencies.identifiers.size());
+
+			for (const auto& identifier : dependencies.identifiers)
+				optionValues.emplace_back(astPreprocessor.getOptionValue(identifier));
+
+			// Reuse a statement already preprocessed with the same option values
+			const Statement* cachedStatement = nullptr;
+			bool isCached = false;
+
+			{
+				std::lock_guard<std::mutex> lock(m_instanceMutex);
+
+				for (const auto& processed : m_processedStatements[i])
+				{
+					if (processed.optionValues == optionValues)
+					{
+						cachedStatement = processed.statement.get();
+						isCached = true;
+						break;
+					}
+				}
+			}
+
+			if (isCached)
+			{
+				processedStatement = cloner.clone(cachedStatement);
+			}
+			else
+			{
+				processedStatement = astPreprocessor.process(statement);
+
+				ProcessedStatement processed;
+				processed.optionValues = std::move(optionValues);
+				processed.statement = cloner.clone(processedStatement.get());
+
+				std::lock_guard<std::mutex> lock(m_instanceMutex);
+
+				m_processedStatements[i].emplace_back(std::move(processed));
+			}
+		}
+
+		if (processedStatement)
+			sequence->statements.emplace_back(std::move(processedStatement));
+	}
+
+	if (sequence->statements.empty())
 		ATEMA_ERROR("An error occurred during shader preprocessing");
 
-	UPtr<SequenceStatement> sequence;
+	return std::make_shared<UberShader>(std::move(sequence));
+}
+
+std::vector<UberShader::Option> UberShader::getRelevantOptions(const std::vector<Option>& options, const ShaderLibraryManager* shaderLibraryManager) const
+{
+	initializeDependencies();
 
-	if (processedAst->getType() == Statement::Type::Sequence)
+	std::unordered_set<std::string> identifiers;
+	std::vector<std::string> libraries;
+
+	for (const auto& dependencies : m_dependencies)
 	{
-		sequence.reset(static_cast<SequenceStatement*>(processedAst.release()));
+		identifiers.insert(dependencies.identifiers.begin(), dependencies.identifiers.end());
+		libraries.insert(libraries.end(), dependencies.libraries.begin(), dependencies.libraries.end());
 	}
-	else
+
+	// Without library manager, include statements are not resolved
+	if (shaderLibraryManager)
 	{
-		sequence = std::make_unique<SequenceStatement>();
-		sequence->statements.emplace_back(std::move(processedAst));
+		std::unordered_set<std::string> visitedLibraries;
+
+		while (!libraries.empty())
+		{
+			const auto libraryName = std::move(libraries.back());
+			libraries.pop_back();
+
+			if (!visitedLibraries.emplace(libraryName).second || !shaderLibraryManager->hasLibrary(libraryName))
+				continue;
+
+			OptionDependencyCollector collector;
+
+			shaderLibraryManager->getLibrary(libraryName)->accept(collector);
+
+			identifiers.insert(collector.identifiers.begin(), collector.identifiers.end());
+			libraries.insert(libraries.end(), collector.libraries.begin(), collector.libraries.end());
+		}
 	}
 
-	return std::make_shared<UberShader>(std::move(sequence));
+	// The preprocessor keeps the last value of an option
+	std::map<std::string_view, const ConstantValue*> relevantOptions;
+
+	for (const auto& option : options)
+	{
+		if (identifiers.find(option.name) != identifiers.end())
+			relevantOptions[option.name] = &option.value;
+	}
+
+	std::vector<Option> result;
+	result.reserve(relevantOptions.size());
+
+	for (const auto& [name, value] : relevantOptions)
+		result.emplace_back(std::string(name), *value);
+
+	return result;
 }
 
 Ptr<UberShader> UberShader::extractStage(AstShaderStage stage) const
@@ -85,6 +231,10 @@ Ptr<UberShader> UberShader::extractStage(AstShaderStage stage) const
 	if (!ast)
 		ATEMA_ERROR("The required stage was not found");
 
+	// Fold constants & remove what became unused, before code generation
+	AstOptimizer optimizer;
+	optimizer.optimize(*ast);
+
 	return std::make_shared<UberShader>(std::move(ast));
 }
 
@@ -96,10 +246,13 @@ const AstReflection& UberShader::getReflection(AstShaderStage stage) const
 	if (it != m_stageReflections.end())
 		return it->second;
 
-	// If not, create stage reflection
-	initializeExtractor();
+	// If not, create stage reflection from the optimized stage, so externals that are never used don't get a binding
+	const auto stageShader = extractStage(stage);
+
+	AstReflector reflector;
+	stageShader->getAst()->accept(reflector);
 
-	m_stageReflections[stage] = m_astReflector.getReflection(stage);
+	m_stageReflections[stage] = reflector.getReflection(stage);
 
 	return m_stageReflections[stage];
 }
@@ -118,3 +271,27 @@ void UberShader::initializeExtractor() const
 
 	m_extractorReady = true;
 }
+
+void UberShader::initializeDependencies() const
+{
+	std::lock_guard<std::mutex> lock(m_instanceMutex);
+
+	if (m_dependenciesReady)
+		return;
+
+	m_dependencies.resize(m_ast->statements.size());
+	m_processedStatements.resize(m_ast->statements.size());
+
+	for (size_t i = 0; i < m_ast->statements.size(); i++)
+	{
+		OptionDependencyCollector collector;
+
+		m_ast->statements[i]->accept(collector);
+
+		auto& dependencies = m_dependencies[i];
+		dependencies.identifiers.assign(collector.identifiers.begin(), collector.identifiers.end());
+		dependencies.libraries = std::move(collector.libraries);
+	}
+
+	m_dependenciesReady = true;
+}
@@ -174,6 +174,21 @@ VkFormat Vulkan::getFormat(ImageFormat format)
 		case ImageFormat::D16_UNORM_S8_UINT: return VK_FORMAT_D16_UNORM_S8_UINT;
 		case ImageFormat::D24_UNORM_S8_UINT: return VK_FORMAT_D24_UNORM_S8_UINT;
 		case ImageFormat::D32_SFLOAT_S8_UINT: return VK_FORMAT_D32_SFLOAT_S8_UINT;
+		// Block-compressed color
+		case ImageFormat::BC1_RGB_UNORM: return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+		case ImageFormat::BC1_RGB_SRGB: return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+		case ImageFormat::BC1_RGBA_UNORM: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		case ImageFormat::BC1_RGBA_SRGB: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+		case ImageFormat::BC3_UNORM: return VK_FORMAT_BC3_UNORM_BLOCK;
+		case ImageFormat::BC3_SRGB: return VK_FORMAT_BC3_SRGB_BLOCK;
+		case ImageFormat::BC4_UNORM: return VK_FORMAT_BC4_UNORM_BLOCK;
+		case ImageFormat::BC4_SNORM: return VK_FORMAT_BC4_SNORM_BLOCK;
+		case ImageFormat::BC5_UNORM: return VK_FORMAT_BC5_UNORM_BLOCK;
+		case ImageFormat::BC5_SNORM: return VK_FORMAT_BC5_SNORM_BLOCK;
+		case ImageFormat::BC6H_UFLOAT: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+		case ImageFormat::BC6H_SFLOAT: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+		case ImageFormat::BC7_UNORM: return VK_FORMAT_BC7_UNORM_BLOCK;
+		case ImageFormat::BC7_SRGB: return VK_FORMAT_BC7_SRGB_BLOCK;
 		default:
 		{
 			ATEMA_ERROR("Invalid image format");
@@ -291,6 +306,21 @@ ImageFormat Vulkan::getFormat(VkFormat format)
 		case VK_FORMAT_D16_UNORM_S8_UINT: return ImageFormat::D16_UNORM_S8_UINT;
 		case VK_FORMAT_D24_UNORM_S8_UINT: return ImageFormat::D24_UNORM_S8_UINT;
 		case VK_FORMAT_D32_SFLOAT_S8_UINT: return ImageFormat::D32_SFLOAT_S8_UINT;
+		// Block-compressed color
+		case VK_FORMAT_BC1_RGB_UNORM_BLOCK: return ImageFormat::BC1_RGB_UNORM;
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK: return ImageFormat::BC1_RGB_SRGB;
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: return ImageFormat::BC1_RGBA_UNORM;
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK: return ImageFormat::BC1_RGBA_SRGB;
+		case VK_FORMAT_BC3_UNORM_BLOCK: return ImageFormat::BC3_UNORM;
+		case VK_FORMAT_BC3_SRGB_BLOCK: return ImageFormat::BC3_SRGB;
+		case VK_FORMAT_BC4_UNORM_BLOCK: return ImageFormat::BC4_UNORM;
+		case VK_FORMAT_BC4_SNORM_BLOCK: return ImageFormat::BC4_SNORM;
+		case VK_FORMAT_BC5_UNORM_BLOCK: return ImageFormat::BC5_UNORM;
+		case VK_FORMAT_BC5_SNORM_BLOCK: return ImageFormat::BC5_SNORM;
+		case VK_FORMAT_BC6H_UFLOAT_BLOCK: return ImageFormat::BC6H_UFLOAT;
+		case VK_FORMAT_BC6H_SFLOAT_BLOCK: return ImageFormat::BC6H_SFLOAT;
+		case VK_FORMAT_BC7_UNORM_BLOCK: return ImageFormat::BC7_UNORM;
+		case VK_FORMAT_BC7_SRGB_BLOCK: return ImageFormat::BC7_SRGB;
 		default:
 		{
 			ATEMA_ERROR("Invalid image format");
@@ -312,17 +342,23 @@ VkFormat Vulkan::getFormat(VertexInputFormat format)
 		case VertexInputFormat::RGB8_SINT: return VK_FORMAT_R8G8B8_SINT;
 		case VertexInputFormat::RGBA8_UINT: return VK_FORMAT_R8G8B8A8_UINT;
 		case VertexInputFormat::RGBA8_SINT: return VK_FORMAT_R8G8B8A8_SINT;
+		case VertexInputFormat::RGBA8_UNORM: return VK_FORMAT_R8G8B8A8_UNORM;
+		case VertexInputFormat::RGBA8_SNORM: return VK_FORMAT_R8G8B8A8_SNORM;
 		case VertexInputFormat::R16_UINT: return VK_FORMAT_R16_UINT;
 		case VertexInputFormat::R16_SINT: return VK_FORMAT_R16_SINT;
 		case VertexInputFormat::R16_SFLOAT: return VK_FORMAT_R16_SFLOAT;
 		case VertexInputFormat::RG16_UINT: return VK_FORMAT_R16G16_UINT;
 		case VertexInputFormat::RG16_SINT: return VK_FORMAT_R16G16_SINT;
+		case VertexInputFormat::RG16_UNORM: return VK_FORMAT_R16G16_UNORM;
+		case VertexInputFormat::RG16_SNORM: return VK_FORMAT_R16G16_SNORM;
 		case VertexInputFormat::RG16_SFLOAT: return VK_FORMAT_R16G16_SFLOAT;
 		case VertexInputFormat::RGB16_UINT: return VK_FORMAT_R16G16B16_UINT;
 		case VertexInputFormat::RGB16_SINT: return VK_FORMAT_R16G16B16_SINT;
 		case VertexInputFormat::RGB16_SFLOAT: return VK_FORMAT_R16G16B16_SFLOAT;
 		case VertexInputFormat::RGBA16_UINT: return VK_FORMAT_R16G16B16A16_UINT;
 		case VertexInputFormat::RGBA16_SINT: return VK_FORMAT_R16G16B16A16_SINT;
+		case VertexInputFormat::RGBA16_UNORM: return VK_FORMAT_R16G16B16A16_UNORM;
+		case VertexInputFormat::RGBA16_SNORM: return VK_FORMAT_R16G16B16A16_SNORM;
 		case VertexInputFormat::RGBA16_SFLOAT: return VK_FORMAT_R16G16B16A16_SFLOAT;
 		case VertexInputFormat::R32_UINT: return VK_FORMAT_R32_UINT;
 		case VertexInputFormat::R32_SINT: return VK_FORMAT_R32_SINT;
@@ -897,6 +933,9 @@ VkBufferUsageFlags Vulkan::getBufferUsages(Flags<BufferUsage> value)
 	if (value & BufferUsage::TransferDst)
 		flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
+	if (value & BufferUsage::Storage)
+		flags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
 	return flags;
 }
 
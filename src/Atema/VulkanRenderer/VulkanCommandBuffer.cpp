@@ -24,6 +24,7 @@
 #include <Atema/VulkanRenderer/VulkanBuffer.hpp>
 #include <Atema/VulkanRenderer/VulkanCommandBuffer.hpp>
 #include <Atema/VulkanRenderer/VulkanCommandPool.hpp>
+#include <Atema/VulkanRenderer/VulkanComputePipeline.hpp>
 #include <Atema/VulkanRenderer/VulkanDescriptorSet.hpp>
 #include <Atema/VulkanRenderer/VulkanFramebuffer.hpp>
 #include <Atema/VulkanRenderer/VulkanGraphicsPipeline.hpp>
@@ -58,6 +59,19 @@ namespace
 		
 		return (offset.x + offset.y * 4 * imageSize) * imageSize * pixelByteSize;
 	}
+
+	// Cubemaps contain 6 array layers per layer
+	uint32_t getArrayLayers(const Image& image)
+	{
+		return image.getType() == ImageType::CubeMap ? image.getLayers() * 6 : image.getLayers();
+	}
+
+	Vector2u getMipSize(const Image& image, uint32_t mipLevel)
+	{
+		const auto size = image.getSize();
+
+		return { std::max(size.x >> mipLevel, 1u), std::max(size.y >> mipLevel, 1u) };
+	}
 }
 
 VulkanCommandBuffer::VulkanCommandBuffer(VkCommandPool commandPool, QueueType queueType, uint32_t queueFamilyIndex, const CommandBuffer::Settings& settings) :
@@ -69,6 +83,7 @@ VulkanCommandBuffer::VulkanCommandBuffer(VkCommandPool commandPool, QueueType qu
 	m_singleUse(settings.singleUse),
 	m_isSecondary(settings.secondary),
 	m_secondaryBegan(false),
+	m_currentPipelineBindPoint(VK_PIPELINE_BIND_POINT_GRAPHICS),
 	m_currentPipelineLayout(VK_NULL_HANDLE),
 	m_currentRenderPass(nullptr),
 	m_currentSubpassIndex(0)
@@ -214,6 +229,22 @@ void VulkanCommandBuffer::bindPipeline(const GraphicsPipeline& pipeline)
 
 	m_device.vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineHandle);
 
+	m_currentPipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	m_currentPipelineLayout = vkPipeline.getLayoutHandle();
+}
+
+void VulkanCommandBuffer::bindPipeline(const ComputePipeline& pipeline)
+{
+	if (m_currentRenderPass)
+	{
+		ATEMA_ERROR("Compute pipelines can't be bound inside a RenderPass");
+	}
+
+	const auto& vkPipeline = static_cast<const VulkanComputePipeline&>(pipeline);
+
+	m_device.vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vkPipeline.getHandle());
+
+	m_currentPipelineBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
 	m_currentPipelineLayout = vkPipeline.getLayoutHandle();
 }
 
@@ -278,10 +309,10 @@ void VulkanCommandBuffer::copyBufferToImage(const Buffer& srcBuffer, Image& dstI
 	
 	ATEMA_ASSERT(layout == VK_IMAGE_LAYOUT_GENERAL || layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, "Invalid image layout");
 	ATEMA_ASSERT(dstMipLevel < dstImage.getMipLevels(), "Invalid mip level");
-	ATEMA_ASSERT(dstLayer < dstImage.getLayers(), "Invalid layer");
+	ATEMA_ASSERT(dstLayer < getArrayLayers(dstImage), "Invalid layer");
 	ATEMA_ASSERT(srcOffset < srcBuffer.getByteSize(), "Invalid buffer offset");
 
-	const auto size = vkImage.getSize();
+	const auto size = getMipSize(dstImage, dstMipLevel);
 	
 	VkBufferImageCopy region{};
 	region.bufferOffset = srcOffset;
@@ -358,6 +389,43 @@ void VulkanCommandBuffer::copyBufferToCubemap(const Buffer& srcBuffer, Image& ds
 	);
 }
 
+void VulkanCommandBuffer::copyImageToBuffer(const Image& srcImage, ImageLayout srcLayout, Buffer& dstBuffer, size_t dstOffset, uint32_t srcMipLevel, uint32_t srcLayer)
+{
+	const auto& vkImage = static_cast<const VulkanImage&>(srcImage);
+	const auto& vkBuffer = static_cast<const VulkanBuffer&>(dstBuffer);
+	const auto format = vkImage.getFormat();
+	const auto layout = Vulkan::getLayout(srcLayout, Renderer::isDepthImageFormat(format));
+
+	ATEMA_ASSERT(layout == VK_IMAGE_LAYOUT_GENERAL || layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, "Invalid image layout");
+	ATEMA_ASSERT(srcMipLevel < srcImage.getMipLevels(), "Invalid mip level");
+	ATEMA_ASSERT(srcLayer < getArrayLayers(srcImage), "Invalid layer");
+	ATEMA_ASSERT(dstOffset < dstBuffer.getByteSize(), "Invalid buffer offset");
+
+	const auto size = getMipSize(srcImage, srcMipLevel);
+
+	VkBufferImageCopy region{};
+	region.bufferOffset = dstOffset;
+	region.bufferRowLength = 0;
+	region.bufferImageHeight = 0;
+
+	region.imageSubresource.aspectMask = Vulkan::getAspect(vkImage.getFormat());
+	region.imageSubresource.mipLevel = srcMipLevel;
+	region.imageSubresource.baseArrayLayer = srcLayer;
+	region.imageSubresource.layerCount = 1;
+
+	region.imageOffset = { 0, 0, 0 };
+	region.imageExtent = { size.x, size.y, 1 };
+
+	m_device.vkCmdCopyImageToBuffer(
+		m_commandBuffer,
+		vkImage.getHandle(),
+		layout,
+		vkBuffer.getHandle(),
+		1,
+		&region
+	);
+}
+
 void VulkanCommandBuffer::copyImage(
 	const Image& srcImage, ImageLayout srcLayout, uint32_t srcLayer, uint32_t srcMipLevel,
 	Image& dstImage, ImageLayout dstLayout, uint32_t dstLayer, uint32_t dstMipLevel,
@@ -463,7 +531,7 @@ void VulkanCommandBuffer::bindDescriptorSet(uint32_t index, const DescriptorSet&
 
 	m_device.vkCmdBindDescriptorSets(
 		m_commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
+		m_currentPipelineBindPoint,
 		m_currentPipelineLayout,
 		index,
 		1,
@@ -482,6 +550,11 @@ void VulkanCommandBuffer::drawIndexed(uint32_t indexCount, uint32_t instanceCoun
 	m_device.vkCmdDrawIndexed(m_commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
+void VulkanCommandBuffer::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+	m_device.vkCmdDispatch(m_commandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
 void VulkanCommandBuffer::memoryBarrier(Flags<PipelineStage> srcPipelineStages, Flags<MemoryAccess> srcMemoryAccesses, Flags<PipelineStage> dstPipelineStages, Flags<MemoryAccess> dstMemoryAccesses)
 {
 	// Pipeline stages
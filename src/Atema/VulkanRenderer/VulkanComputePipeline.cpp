@@ -0,0 +1,114 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Atema/VulkanRenderer/VulkanComputePipeline.hpp>
+#include <Atema/VulkanRenderer/VulkanDescriptorSetLayout.hpp>
+#include <Atema/VulkanRenderer/VulkanRenderer.hpp>
+#include <Atema/VulkanRenderer/VulkanShader.hpp>
+#include <Atema/Core/Timer.hpp>
+
+using namespace at;
+
+VulkanComputePipeline::VulkanComputePipeline(const VulkanDevice& device, const ComputePipeline::Settings& settings) :
+	ComputePipeline(),
+	m_device(device),
+	m_computeShader(settings.computeShader),
+	m_pipelineLayout(VK_NULL_HANDLE),
+	m_pipeline(VK_NULL_HANDLE)
+{
+	//-----
+	// Shader
+	auto computeShader = std::static_pointer_cast<VulkanShader>(m_computeShader);
+
+	if (!computeShader)
+	{
+		ATEMA_ERROR("Invalid compute shader");
+	}
+
+	VkPipelineShaderStageCreateInfo shaderStageInfo{};
+	shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	shaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	shaderStageInfo.flags = 0;
+	shaderStageInfo.module = computeShader->getHandle();
+	shaderStageInfo.pName = "main";
+	shaderStageInfo.pSpecializationInfo = nullptr;
+	shaderStageInfo.pNext = nullptr;
+
+	//-----
+	// Pipeline layout
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+	std::vector<VkDescriptorSetLayout> descriptorSetLayouts;
+	{
+		for (auto& layout : settings.descriptorSetLayouts)
+		{
+			VkDescriptorSetLayout descriptorSetLayoutHandle = VK_NULL_HANDLE;
+
+			auto descriptorSetLayout = std::static_pointer_cast<VulkanDescriptorSetLayout>(layout);
+			if (descriptorSetLayout)
+				descriptorSetLayoutHandle = descriptorSetLayout->getHandle();
+
+			descriptorSetLayouts.emplace_back(descriptorSetLayoutHandle);
+		}
+
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+		pipelineLayoutInfo.pSetLayouts = descriptorSetLayouts.data();
+		pipelineLayoutInfo.pushConstantRangeCount = 0;
+		pipelineLayoutInfo.flags = 0;
+		pipelineLayoutInfo.pNext = nullptr;
+
+		ATEMA_VK_CHECK(m_device.vkCreatePipelineLayout(m_device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout));
+	}
+
+	//-----
+	// Pipeline
+	// Unlike graphics pipelines, compute pipelines don't depend on a render pass and can be created immediately
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage = shaderStageInfo;
+	pipelineInfo.layout = m_pipelineLayout;
+	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+	auto& pipelineCache = VulkanRenderer::instance().getPipelineCache();
+
+	Timer timer;
+
+	ATEMA_VK_CHECK(m_device.vkCreateComputePipelines(m_device, pipelineCache, 1, &pipelineInfo, nullptr, &m_pipeline));
+
+	pipelineCache.addPipeline(timer.getStep());
+}
+
+VulkanComputePipeline::~VulkanComputePipeline()
+{
+	ATEMA_VK_DESTROY(m_device, vkDestroyPipeline, m_pipeline);
+
+	ATEMA_VK_DESTROY(m_device, vkDestroyPipelineLayout, m_pipelineLayout);
+}
+
+VkPipeline VulkanComputePipeline::getHandle() const noexcept
+{
+	return m_pipeline;
+}
+
+VkPipelineLayout VulkanComputePipeline::getLayoutHandle() const noexcept
+{
+	return m_pipelineLayout;
+}
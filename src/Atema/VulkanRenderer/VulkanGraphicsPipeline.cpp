@@ -25,6 +25,7 @@
 #include <Atema/VulkanRenderer/VulkanRenderer.hpp>
 #include <Atema/VulkanRenderer/VulkanRenderPass.hpp>
 #include <Atema/VulkanRenderer/VulkanShader.hpp>
+#include <Atema/Core/Timer.hpp>
 
 using namespace at;
 
@@ -414,7 +415,13 @@ VkPipeline VulkanGraphicsPipeline::createPipeline(const VulkanRenderPass& render
 		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional
 		//pipelineInfo.basePipelineIndex = -1; // Optional
 
-		ATEMA_VK_CHECK(m_device.vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline));
+		auto& pipelineCache = VulkanRenderer::instance().getPipelineCache();
+
+		Timer timer;
+
+		ATEMA_VK_CHECK(m_device.vkCreateGraphicsPipelines(m_device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline));
+
+		pipelineCache.addPipeline(timer.getStep());
 	}
 
 	return pipeline;
@@ -0,0 +1,233 @@
+/*
+	Copyright 2022 Jordi SUBIRANA
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+	Software, and to permit persons to whom the Software is furnished to do so, subject
+	to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Atema/VulkanRenderer/VulkanPipelineCache.hpp>
+#include <Atema/VulkanRenderer/VulkanDevice.hpp>
+#include <Atema/VulkanRenderer/VulkanPhysicalDevice.hpp>
+#include <Atema/Core/Hash.hpp>
+
+#include <cstring>
+#include <fstream>
+
+using namespace at;
+
+namespace
+{
+	using DataHasher = Hasher<FNV1a<Hash64>>;
+
+	// 'AVPC'
+	constexpr uint32_t FileMagic = 0x43505641;
+	constexpr uint32_t FileVersion = 1;
+
+	// The data returned by vkGetPipelineCacheData already starts with a header identifying the device
+	// But the driver version is not part of it, and some drivers don't validate the data they receive
+	struct FileHeader
+	{
+		uint32_t magic = FileMagic;
+		uint32_t version = FileVersion;
+		uint32_t vendorID = 0;
+		uint32_t deviceID = 0;
+		uint32_t driverVersion = 0;
+		uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+		uint64_t dataSize = 0;
+		Hash64 dataHash = 0;
+	};
+
+	FileHeader createHeader(const VkPhysicalDeviceProperties& properties)
+	{
+		FileHeader header;
+		header.vendorID = properties.vendorID;
+		header.deviceID = properties.deviceID;
+		header.driverVersion = properties.driverVersion;
+		std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+		return header;
+	}
+
+	bool isCompatible(const FileHeader& header, const FileHeader& deviceHeader)
+	{
+		return header.magic == deviceHeader.magic
+			&& header.version == deviceHeader.version
+			&& header.vendorID == deviceHeader.vendorID
+			&& header.deviceID == deviceHeader.deviceID
+			&& header.driverVersion == deviceHeader.driverVersion
+			&& std::memcmp(header.pipelineCacheUUID, deviceHeader.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+}
+
+VulkanPipelineCache::VulkanPipelineCache(const VulkanDevice& device, const std::filesystem::path& path) :
+	m_device(device),
+	m_path(path),
+	m_pipelineCache(VK_NULL_HANDLE)
+{
+	const auto data = load();
+
+	m_statistics.loadedCacheSize = data.size();
+
+	VkPipelineCacheCreateInfo createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	createInfo.initialDataSize = data.size();
+	createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+	ATEMA_VK_CHECK(m_device.vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache));
+}
+
+VulkanPipelineCache::~VulkanPipelineCache()
+{
+	ATEMA_VK_DESTROY(m_device, vkDestroyPipelineCache, m_pipelineCache);
+}
+
+VkPipelineCache VulkanPipelineCache::getHandle() const noexcept
+{
+	return m_pipelineCache;
+}
+
+VulkanPipelineCache::operator VkPipelineCache() const noexcept
+{
+	return m_pipelineCache;
+}
+
+const std::filesystem::path& VulkanPipelineCache::getPath() const noexcept
+{
+	return m_path;
+}
+
+bool VulkanPipelineCache::save() const noexcept
+{
+	if (m_path.empty())
+		return true;
+
+	try
+	{
+		size_t dataSize = 0;
+		if (m_device.vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, nullptr) != VK_SUCCESS)
+			return false;
+
+		std::vector<uint8_t> data(dataSize);
+		if (m_device.vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, data.data()) != VK_SUCCESS)
+			return false;
+
+		data.resize(dataSize);
+
+		auto header = createHeader(m_device.getPhysicalDevice().getProperties());
+		header.dataSize = dataSize;
+		header.dataHash = DataHasher::hash(data.data(), data.size());
+
+		std::error_code errorCode;
+
+		if (m_path.has_parent_path())
+		{
+			std::filesystem::create_directories(m_path.parent_path(), errorCode);
+
+			if (errorCode)
+				return false;
+		}
+
+		auto tempPath = m_path;
+		tempPath += ".tmp";
+
+		bool written = false;
+
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+			if (file)
+			{
+				file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+				file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+				file.close();
+
+				written = !file.fail();
+			}
+		}
+
+		// The previous cache file is kept untouched
+		if (written)
+			std::filesystem::rename(tempPath, m_path, errorCode);
+
+		if (!written || errorCode)
+		{
+			std::filesystem::remove(tempPath, errorCode);
+
+			return false;
+		}
+	}
+	catch (...)
+	{
+		// Only allocation failures can get here
+		return false;
+	}
+
+	return true;
+}
+
+void VulkanPipelineCache::addPipeline(const TimeStep& creationTime)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_statistics.count++;
+	m_statistics.creationTime += creationTime;
+}
+
+Renderer::PipelineStatistics VulkanPipelineCache::getStatistics() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_statistics;
+}
+
+std::vector<uint8_t> VulkanPipelineCache::load()
+{
+	std::vector<uint8_t> data;
+
+	if (m_path.empty())
+		return data;
+
+	std::error_code errorCode;
+	const auto fileSize = std::filesystem::file_size(m_path, errorCode);
+
+	if (errorCode || fileSize < sizeof(FileHeader))
+		return data;
+
+	std::ifstream file(m_path, std::ios::binary);
+
+	if (!file)
+		return data;
+
+	FileHeader header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+
+	// A cache from another device or driver could be rejected or even crash some drivers : start from scratch
+	if (!file || !isCompatible(header, createHeader(m_device.getPhysicalDevice().getProperties())))
+		return data;
+
+	if (header.dataSize != fileSize - sizeof(FileHeader))
+		return data;
+
+	data.resize(static_cast<size_t>(header.dataSize));
+	file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+	if (!file || DataHasher::hash(data.data(), data.size()) != header.dataHash)
+		data.clear();
+
+	return data;
+}
@@ -28,6 +28,7 @@
 #include <Atema/VulkanRenderer/VulkanDescriptorSetLayout.hpp>
 #include <Atema/VulkanRenderer/VulkanDescriptorSet.hpp>
 #include <Atema/VulkanRenderer/VulkanGraphicsPipeline.hpp>
+#include <Atema/VulkanRenderer/VulkanComputePipeline.hpp>
 #include <Atema/VulkanRenderer/VulkanCommandPool.hpp>
 #include <Atema/VulkanRenderer/VulkanCommandBuffer.hpp>
 #include <Atema/VulkanRenderer/VulkanFence.hpp>
@@ -37,6 +38,7 @@
 #include <Atema/VulkanRenderer/UI/VulkanUiContext.hpp>
 #include <Atema/Core/TaskManager.hpp>
 
+#include <iostream>
 #include <set>
 #include <thread>
 
@@ -77,6 +79,12 @@ VulkanRenderer::~VulkanRenderer()
 {
 	waitForIdle();
 
+	// Throwing from a destructor would terminate the application : losing the cache only slows down the next start
+	if (m_pipelineCache && !m_pipelineCache->save())
+		std::cerr << "Unable to save the pipeline cache to '" << m_pipelineCache->getPath().string() << "'" << std::endl;
+
+	m_pipelineCache.reset();
+
 	m_device.reset();
 
 	m_instance.reset();
@@ -109,6 +117,8 @@ void VulkanRenderer::initialize()
 	pickPhysicalDevice();
 
 	createDevice();
+
+	m_pipelineCache = std::make_unique<VulkanPipelineCache>(*m_device, getSettings().pipelineCachePath);
 }
 
 void VulkanRenderer::waitForIdle()
@@ -116,6 +126,18 @@ void VulkanRenderer::waitForIdle()
 	m_device->waitForIdle();
 }
 
+void VulkanRenderer::savePipelineCache()
+{
+	// Explicit saves report failures, unlike the one done by the destructor
+	if (!m_pipelineCache->save())
+		ATEMA_ERROR("Unable to save the pipeline cache to '" + m_pipelineCache->getPath().string() + "'");
+}
+
+Renderer::PipelineStatistics VulkanRenderer::getPipelineStatistics() const
+{
+	return m_pipelineCache->getStatistics();
+}
+
 Ptr<CommandPool> VulkanRenderer::getCommandPool(QueueType queueType)
 {
 	return m_device->getDefaultCommandPool(queueType);
@@ -175,6 +197,13 @@ Ptr<GraphicsPipeline> VulkanRenderer::createGraphicsPipeline(const GraphicsPipel
 	return std::static_pointer_cast<GraphicsPipeline>(object);
 }
 
+Ptr<ComputePipeline> VulkanRenderer::createComputePipeline(const ComputePipeline::Settings& settings)
+{
+	auto object = std::make_shared<VulkanComputePipeline>(*m_device, settings);
+
+	return std::static_pointer_cast<ComputePipeline>(object);
+}
+
 Ptr<CommandPool> VulkanRenderer::createCommandPool(const CommandPool::Settings& settings)
 {
 	auto object = std::make_shared<VulkanCommandPool>(*m_device, settings);
@@ -241,6 +270,11 @@ const VulkanDevice& VulkanRenderer::getDevice() const noexcept
 	return *m_device;
 }
 
+VulkanPipelineCache& VulkanRenderer::getPipelineCache() const noexcept
+{
+	return *m_pipelineCache;
+}
+
 bool VulkanRenderer::checkValidationLayerSupport()
 {
 	// Used for debugging purpose
@@ -660,6 +694,8 @@ void VulkanRenderer::createDevice()
 	VkPhysicalDeviceFeatures deviceFeatures{};
 	deviceFeatures.samplerAnisotropy = VK_TRUE;
 	deviceFeatures.depthClamp = VK_TRUE;
+	// Block-compressed images are optional : unsupported formats don't report any usage, and loaders fall back to uncompressed ones
+	deviceFeatures.textureCompressionBC = m_physicalDevice->getFeatures().textureCompressionBC;
 	// Sample shading : set a number of samples for fragment shading
 	deviceFeatures.sampleRateShading = getSettings().sampleShading ? VK_TRUE : VK_FALSE;
 
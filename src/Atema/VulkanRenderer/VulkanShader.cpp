@@ -21,12 +21,58 @@
 
 #include <Atema/VulkanRenderer/VulkanShader.hpp>
 #include <Atema/VulkanRenderer/VulkanRenderer.hpp>
+#include <Atema/Core/Hash.hpp>
 #include <Atema/Shader/Atsl/AtslParser.hpp>
 #include <Atema/Shader/Atsl/AtslToAstConverter.hpp>
-#include <Atema/Shader/Spirv/SpirvShaderWriter.hpp>
+#include <Atema/Shader/Ast/AstSerializer.hpp>
+#include <Atema/Shader/Spirv/SpirvUtils.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 using namespace at;
 
+namespace
+{
+	// Files are named after the hash of their content, so each shader is only written once
+	void dumpAst(const Statement& ast, const std::filesystem::path& directory)
+	{
+		AstSerializer serializer;
+		serializer.serialize(ast);
+
+		const auto& data = serializer.getData();
+
+		std::stringstream fileName;
+		fileName << std::hex << std::setw(16) << std::setfill('0') << FNV1a<Hash64>::hash(data.data(), data.size()) << ".ast";
+
+		std::error_code errorCode;
+		std::filesystem::create_directories(directory, errorCode);
+
+		const auto path = directory / fileName.str();
+
+		if (std::filesystem::exists(path, errorCode))
+			return;
+
+		std::ofstream file(path, std::ios::binary);
+
+		if (!file)
+			ATEMA_ERROR("Can't write shader dump '" + path.string() + "'");
+
+		file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	}
+
+	void compileAst(const Statement& ast, std::vector<uint32_t>& code)
+	{
+		const auto& settings = Renderer::instance().getSettings();
+
+		if (!settings.shaderDumpPath.empty())
+			dumpAst(ast, settings.shaderDumpPath);
+
+		spirv::compile(ast, code);
+	}
+}
+
 VulkanShader::VulkanShader(const VulkanDevice& device, const Shader::Settings& settings) :
 	Shader(),
 	m_device(device),
@@ -41,13 +87,9 @@ VulkanShader::VulkanShader(const VulkanDevice& device, const Shader::Settings& s
 		{
 			const auto ast = static_cast<const Statement*>(settings.shaderData);
 
-			SpirvShaderWriter spvWriter;
-
-			ast->accept(spvWriter);
-
 			std::vector<uint32_t> code;
 
-			spvWriter.compile(code);
+			compileAst(*ast, code);
 
 			create(code.data(), code.size());
 
@@ -57,19 +99,15 @@ VulkanShader::VulkanShader(const VulkanDevice& device, const Shader::Settings& s
 		{
 			AtslParser atslParser;
 
-			const auto atslTokens = atslParser.createTokens(std::string(static_cast<const char*>(settings.shaderData), settings.shaderDataSize));
+			const auto atslTokens = atslParser.createTokens(std::string_view(static_cast<const char*>(settings.shaderData), settings.shaderDataSize));
 
 			AtslToAstConverter converter;
 
 			auto ast = converter.createAst(atslTokens);
 
-			SpirvShaderWriter spvWriter;
-
-			ast->accept(spvWriter);
-
 			std::vector<uint32_t> code;
 
-			spvWriter.compile(code);
+			compileAst(*ast, code);
 
 			create(code.data(), code.size());
 
@@ -0,0 +1,50 @@
+#include <Atema/Graphics/Graphics.hpp>
+#include <Atema/Shader/ShaderLibraryManager.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace at;
+
+// Precompiles the built-in shader libraries and the given ATSL files into a bundle
+// The bundle can then be loaded at startup with Graphics::loadShaderBundle to skip parsing
+// Usage : ShaderBundleCompiler <output> [files.atsl...]
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage : ShaderBundleCompiler <output> [files.atsl...]" << std::endl;
+		return 1;
+	}
+
+	auto& graphics = Graphics::instance();
+
+	ShaderLibraryManager libraryManager;
+	graphics.initializeShaderLibraries(libraryManager);
+
+	for (int i = 2; i < argc; i++)
+	{
+		const std::filesystem::path path = argv[i];
+
+		std::ifstream file(path);
+
+		if (!file)
+		{
+			std::cout << "Can't open " << path.string() << std::endl;
+			return 1;
+		}
+
+		std::stringstream stream;
+		stream << file.rdbuf();
+
+		// Same name as the one used when loading the file through Graphics
+		graphics.createShaderAst(path.string(), stream.str());
+	}
+
+	graphics.saveShaderBundle(argv[1]);
+
+	std::cout << "Shader bundle written to " << argv[1] << std::endl;
+
+	return 0;
+}
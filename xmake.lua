@@ -2,6 +2,7 @@
 -- CONFIGURATION --
 -------------------
 local addExamples = true
+local addTools = true
 
 -----------------
 -- ATEMA FILES --
@@ -13,6 +14,7 @@ local thirdPartyDir = atemaDir .. "thirdparty/"
 local thirdPartyIncludeDir = thirdPartyDir .. "include/"
 local targetDir = atemaDir .. "bin/$(plat)_$(arch)_$(mode)"
 local exampleDir = atemaDir .. "examples/"
+local toolDir = atemaDir .. "tools/"
 
 ------------------
 -- MODULES DATA --
@@ -39,8 +41,7 @@ local modules =
 	},
 	Shader =
 	{
-		dependencies = {"AtemaCore", "AtemaMath"},
-		packages = {"glslang"}
+		dependencies = {"AtemaCore", "AtemaMath"}
 	},
 	VulkanRenderer =
 	{
@@ -144,6 +145,74 @@ if (addExamples == true) then
 			
 		end
 		
+		-- glslang is only used as a reference to validate the native SPIR-V writer
+		if (exampleName == "ShaderValidation") then
+			
+			add_packages("glslang")
+			
+		end
+		
+		-- Assets precompiled by the tools must exist before the examples run
+		if (addTools == true) then
+			
+			for k, toolPath in pairs(os.dirs(toolDir .. "*")) do
+				
+				add_deps(toolPath:match(".*[\\/](.*)"))
+				
+			end
+			
+		end
+		
+		-- Add shared libs from packages to the install dir (xmake install -o installDir)
+		-- https://github.com/xmake-io/xmake/issues/961
+		on_install(function (target)
+			import("target.action.install")
+			install(target, {bindir = "bin", libdir = "lib"})
+		end)
+		
+	end
+	
+end
+
+-- Tools (run at build time, for example to precompile assets)
+if (addTools == true) then
+	
+	local toolDirs = os.dirs(toolDir .. "*")
+	
+	for k, toolPath in pairs(toolDirs) do
+		
+		local toolName = toolPath:match(".*[\\/](.*)")
+		
+		target(toolName)
+		
+		set_group("Tools")
+	
+		set_kind("binary")
+		
+		add_headerfiles(toolPath .. "/**.hpp")
+		add_headerfiles(toolPath .. "/**.inl")
+		
+		add_files(toolPath .. "/**.cpp")
+		
+		add_filegroups(toolName, {rootdir = toolPath})
+		
+		for moduleName, module in pairs(modules) do
+			
+			add_deps("Atema" .. moduleName)
+			
+		end
+		
+		-- Built-in shader libraries are precompiled next to the binaries, the Sandbox loads them when its own bundle is missing
+		if (toolName == "ShaderBundleCompiler") then
+			
+			after_build(function (target)
+				local oldEnvs = os.addenvs(target:pkgenvs() or {})
+				os.execv(target:targetfile(), {path.join(target:targetdir(), "Shaders.bundle")}, {curdir = target:targetdir()})
+				os.setenvs(oldEnvs)
+			end)
+			
+		end
+		
 		-- Add shared libs from packages to the install dir (xmake install -o installDir)
 		-- https://github.com/xmake-io/xmake/issues/961
 		on_install(function (target)